@@ -5831,23 +5831,23 @@ int ObJsonBaseFactory::get_json_base(ObIAllocator *allocator, const char *ptr, u
   } else if (expect_type != ObJsonInType::JSON_TREE && expect_type != ObJsonInType::JSON_BIN) { // check expect_type
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("param expect_type is invalid", K(ret), K(expect_type));
-  } else if (in_type == ObJsonInType::JSON_TREE) {
+  } else if (in_type == ObJsonInType::JSON_TREE && expect_type == ObJsonInType::JSON_TREE) {
     ObJsonNode *j_tree = NULL;
     if (OB_FAIL(ObJsonParser::get_tree(allocator, ptr, length, j_tree, parse_flag))) {
       LOG_WARN("fail to get json tree", K(ret), K(length), K(in_type), K(expect_type));
-    } else if (expect_type == ObJsonInType::JSON_TREE) {
+    } else {
       out = j_tree;
-    } else { // expect json bin
-      if (OB_ISNULL(buf = allocator->alloc(sizeof(ObJsonBin)))) {
-        ret = OB_ALLOCATE_MEMORY_FAILED;
-        LOG_WARN("fail to alloc memory", K(ret), K(in_type), K(expect_type), K(sizeof(ObJsonBin)));
+    }
+  } else if (in_type == ObJsonInType::JSON_TREE) { // expect json bin, parse text to bin without tree
+    if (OB_ISNULL(buf = allocator->alloc(sizeof(ObJsonBin)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory", K(ret), K(in_type), K(expect_type), K(sizeof(ObJsonBin)));
+    } else {
+      ObJsonBin *j_bin = new (buf) ObJsonBin(allocator);
+      if (OB_FAIL(j_bin->parse_text(ptr, length, parse_flag))) {
+        LOG_WARN("fail to parse text", K(ret), K(length), K(in_type), K(expect_type));
       } else {
-        ObJsonBin *j_bin = new (buf) ObJsonBin(allocator);
-        if (OB_FAIL(j_bin->parse_tree(j_tree))) {
-          LOG_WARN("fail to parse tree", K(ret), K(in_type), K(expect_type), K(*j_tree));
-        } else {
-          out = j_bin;
-        }
+        out = j_bin;
       }
     }
   } else if (in_type == ObJsonInType::JSON_BIN) {
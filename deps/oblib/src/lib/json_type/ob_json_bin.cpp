@@ -13,6 +13,7 @@
 #include "common/object/ob_obj_type.h"
 #include "ob_json_bin.h"
 #include "ob_json_tree.h"
+#include "ob_json_parse.h"
 
 namespace oceanbase {
 namespace common {
@@ -957,6 +958,21 @@ int ObJsonBin::parse_tree(ObJsonNode *json_tree)
   return ret;
 }
 
+int ObJsonBin::parse_text(const char *text, uint64_t length, uint32_t parse_flag)
+{
+  INIT_SUCC(ret);
+  result_.reuse();
+  if (OB_FAIL(ObJsonParser::get_bin(allocator_, text, length, result_, parse_flag))) {
+    LOG_WARN("failed to parse json text to binary", K(ret), K(length));
+    result_.reset();
+  } else {
+    curr_.assign_ptr(result_.ptr(), result_.length());
+    is_alloc_ = true;
+    ret = reset_iter();
+  }
+  return ret;
+}
+
 // binary do to tree base on iter position
 int ObJsonBin::to_tree(ObJsonNode *&json_tree)
 {
@@ -4730,5 +4746,535 @@ uint8_t ObJsonVar::get_var_type(int64_t var)
   }
   return static_cast<uint8_t>(lsize);
 }
+
+ObJsonBinBuilder::ObJsonBinBuilder(ObIAllocator *allocator)
+    : allocator_(allocator),
+      value_buf_(allocator),
+      key_buf_(allocator),
+      member_buf_(allocator),
+      stack_(allocator),
+      container_buf_(allocator),
+      key_offset_(0),
+      key_len_(0),
+      seq_(0),
+      has_key_(false),
+      has_root_(false)
+{
+}
+
+void ObJsonBinBuilder::reuse()
+{
+  value_buf_.reuse();
+  key_buf_.reuse();
+  member_buf_.reuse();
+  stack_.reuse();
+  container_buf_.reuse();
+  key_offset_ = 0;
+  key_len_ = 0;
+  seq_ = 0;
+  has_key_ = false;
+  has_root_ = false;
+}
+
+bool ObJsonBinBuilder::ObJBBuildMemberCompare::operator()(const ObJBBuildMember &left,
+                                                          const ObJBBuildMember &right) const
+{
+  // same order as ObJsonKeyCompare, first length then lexicographic order,
+  // members with the same key keep the order of insertion
+  bool is_less = false;
+  if (left.key_len_ != right.key_len_) {
+    is_less = left.key_len_ < right.key_len_;
+  } else {
+    int cmp = MEMCMP(keys_ + left.key_offset_, keys_ + right.key_offset_, left.key_len_);
+    is_less = (cmp != 0) ? (cmp < 0) : (left.seq_ < right.seq_);
+  }
+  return is_less;
+}
+
+int ObJsonBinBuilder::start_object()
+{
+  return start_container(ObJBVerType::J_OBJECT_V0);
+}
+
+int ObJsonBinBuilder::end_object(bool with_unique_key)
+{
+  return end_container(ObJBVerType::J_OBJECT_V0, with_unique_key);
+}
+
+int ObJsonBinBuilder::start_array()
+{
+  return start_container(ObJBVerType::J_ARRAY_V0);
+}
+
+int ObJsonBinBuilder::end_array()
+{
+  return end_container(ObJBVerType::J_ARRAY_V0, false);
+}
+
+int ObJsonBinBuilder::set_key(const char *key, uint64_t length)
+{
+  INIT_SUCC(ret);
+  uint64_t cur_depth = depth();
+  if (cur_depth == 0 || has_key_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected key", K(ret), K(cur_depth), K(has_key_));
+  } else {
+    const ObJBBuildFrame *frame = reinterpret_cast<const ObJBBuildFrame*>(
+                                  stack_.ptr() + (cur_depth - 1) * sizeof(ObJBBuildFrame));
+    if (frame->type_ != ObJBVerType::J_OBJECT_V0) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("key out of object", K(ret), K(frame->type_));
+    } else {
+      key_offset_ = key_buf_.length();
+      key_len_ = length;
+      if (length > 0 && OB_FAIL(key_buf_.append(key, length))) {
+        LOG_WARN("failed to append key", K(ret), K(length));
+      } else {
+        has_key_ = true;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::append_scalar_header(uint8_t type, uint64_t &value_offset)
+{
+  INIT_SUCC(ret);
+  value_offset = value_buf_.length();
+  if (depth() == 0) {
+    // root scalar is [type][value], string and opaque are already led by type
+    if (has_root_) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("json root is already built", K(ret));
+    } else if (!ObJsonVerType::is_opaque_or_string(static_cast<ObJBVerType>(type)) &&
+               OB_FAIL(value_buf_.append(reinterpret_cast<const char*>(&type), sizeof(uint8_t)))) {
+      LOG_WARN("failed to append root type", K(ret), K(type));
+    }
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::add_value(uint8_t type, uint64_t value_offset, uint8_t inline_size, uint64_t inline_val)
+{
+  INIT_SUCC(ret);
+  uint64_t cur_depth = depth();
+  if (cur_depth == 0) {
+    has_root_ = true;
+  } else {
+    const ObJBBuildFrame *frame = reinterpret_cast<const ObJBBuildFrame*>(
+                                  stack_.ptr() + (cur_depth - 1) * sizeof(ObJBBuildFrame));
+    bool is_object = (frame->type_ == ObJBVerType::J_OBJECT_V0);
+    if (is_object != has_key_) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("key and container mismatch", K(ret), K(is_object), K(has_key_));
+    } else {
+      ObJBBuildMember member;
+      member.key_offset_ = is_object ? key_offset_ : 0;
+      member.key_len_ = is_object ? key_len_ : 0;
+      member.value_offset_ = value_offset;
+      member.value_len_ = value_buf_.length() - value_offset;
+      member.inline_val_ = inline_val;
+      member.seq_ = seq_++;
+      member.type_ = type;
+      member.inline_size_ = inline_size;
+      if (OB_FAIL(member_buf_.append(reinterpret_cast<const char*>(&member), sizeof(ObJBBuildMember)))) {
+        LOG_WARN("failed to append member", K(ret), K(member_buf_.length()));
+      } else {
+        has_key_ = false;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::append_null()
+{
+  INIT_SUCC(ret);
+  uint64_t value_offset = 0;
+  uint8_t type = static_cast<uint8_t>(ObJsonBin::get_null_vertype());
+  if (OB_FAIL(append_scalar_header(type, value_offset))) {
+    LOG_WARN("failed to append null header", K(ret));
+  } else if (OB_FAIL(value_buf_.append("\0", sizeof(char)))) {
+    LOG_WARN("failed to append null", K(ret));
+  } else if (OB_FAIL(add_value(type, value_offset, JBLS_UINT8, 0))) {
+    LOG_WARN("failed to add null", K(ret));
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::append_boolean(bool value)
+{
+  INIT_SUCC(ret);
+  uint64_t value_offset = 0;
+  uint8_t type = static_cast<uint8_t>(ObJsonBin::get_boolean_vertype());
+  char val = static_cast<char>(value);
+  if (OB_FAIL(append_scalar_header(type, value_offset))) {
+    LOG_WARN("failed to append boolean header", K(ret));
+  } else if (OB_FAIL(value_buf_.append(&val, sizeof(char)))) {
+    LOG_WARN("failed to append boolean", K(ret));
+  } else if (OB_FAIL(add_value(type, value_offset, JBLS_UINT8, static_cast<uint64_t>(value)))) {
+    LOG_WARN("failed to add boolean", K(ret));
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::append_int(int64_t value)
+{
+  INIT_SUCC(ret);
+  uint64_t value_offset = 0;
+  uint8_t type = static_cast<uint8_t>(ObJsonBin::get_int_vertype());
+  char buf[MAX_VI64_LEN];
+  int64_t pos = 0;
+  if (OB_FAIL(append_scalar_header(type, value_offset))) {
+    LOG_WARN("failed to append int header", K(ret));
+  } else if (OB_FAIL(serialization::encode_vi64(buf, sizeof(buf), pos, value))) {
+    LOG_WARN("failed to serialize int", K(ret), K(value));
+  } else if (OB_FAIL(value_buf_.append(buf, pos))) {
+    LOG_WARN("failed to append int", K(ret), K(pos));
+  } else if (OB_FAIL(add_value(type, value_offset, ObJsonVar::get_var_type(value),
+                               ObJsonVar::var_int2uint(value)))) {
+    LOG_WARN("failed to add int", K(ret), K(value));
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::append_uint(uint64_t value)
+{
+  INIT_SUCC(ret);
+  uint64_t value_offset = 0;
+  uint8_t type = static_cast<uint8_t>(ObJsonBin::get_uint_vertype());
+  char buf[MAX_VI64_LEN];
+  int64_t pos = 0;
+  if (OB_FAIL(append_scalar_header(type, value_offset))) {
+    LOG_WARN("failed to append uint header", K(ret));
+  } else if (OB_FAIL(serialization::encode_vi64(buf, sizeof(buf), pos, static_cast<int64_t>(value)))) {
+    LOG_WARN("failed to serialize uint", K(ret), K(value));
+  } else if (OB_FAIL(value_buf_.append(buf, pos))) {
+    LOG_WARN("failed to append uint", K(ret), K(pos));
+  } else if (OB_FAIL(add_value(type, value_offset, ObJsonVar::get_var_type(value), value))) {
+    LOG_WARN("failed to add uint", K(ret), K(value));
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::append_double(double value)
+{
+  INIT_SUCC(ret);
+  uint64_t value_offset = 0;
+  uint8_t type = static_cast<uint8_t>(ObJsonBin::get_double_vertype());
+  if (isnan(value) || isinf(value)) {
+    ret = OB_INVALID_NUMERIC;
+    LOG_WARN("invalid double value", K(ret), K(value));
+  } else if (OB_FAIL(append_scalar_header(type, value_offset))) {
+    LOG_WARN("failed to append double header", K(ret));
+  } else if (OB_FAIL(value_buf_.append(reinterpret_cast<const char*>(&value), sizeof(double)))) {
+    LOG_WARN("failed to append double", K(ret));
+  } else if (OB_FAIL(add_value(type, value_offset, JBLS_MAX, 0))) {
+    LOG_WARN("failed to add double", K(ret), K(value));
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::append_string(const char *str, uint64_t length)
+{
+  INIT_SUCC(ret);
+  uint64_t value_offset = 0;
+  uint8_t type = static_cast<uint8_t>(ObJsonBin::get_string_vertype());
+  char buf[MAX_VI64_LEN];
+  int64_t pos = 0;
+  // [type][length][string]
+  if (OB_FAIL(append_scalar_header(type, value_offset))) {
+    LOG_WARN("failed to append string header", K(ret));
+  } else if (OB_FAIL(value_buf_.append(reinterpret_cast<const char*>(&type), sizeof(uint8_t)))) {
+    LOG_WARN("failed to append string type", K(ret));
+  } else if (OB_FAIL(serialization::encode_vi64(buf, sizeof(buf), pos, static_cast<int64_t>(length)))) {
+    LOG_WARN("failed to serialize string length", K(ret), K(length));
+  } else if (OB_FAIL(value_buf_.append(buf, pos))) {
+    LOG_WARN("failed to append string length", K(ret), K(pos));
+  } else if (length > 0 && OB_FAIL(value_buf_.append(str, length))) {
+    LOG_WARN("failed to append string", K(ret), K(length));
+  } else if (OB_FAIL(add_value(type, value_offset, JBLS_MAX, 0))) {
+    LOG_WARN("failed to add string", K(ret), K(length));
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::append_binary(ObJsonBin &value)
+{
+  INIT_SUCC(ret);
+  ObJsonNodeType j_type = value.json_type();
+  switch (j_type) {
+    case ObJsonNodeType::J_NULL: {
+      ret = append_null();
+      break;
+    }
+    case ObJsonNodeType::J_BOOLEAN: {
+      ret = append_boolean(value.get_boolean());
+      break;
+    }
+    case ObJsonNodeType::J_INT: {
+      ret = append_int(value.get_int());
+      break;
+    }
+    case ObJsonNodeType::J_UINT: {
+      ret = append_uint(value.get_uint());
+      break;
+    }
+    default: {
+      // container, string and opaque are copied as they are,
+      // other scalars are [type][value] and only value is kept in container
+      ObString raw;
+      uint64_t value_offset = value_buf_.length();
+      uint8_t type = static_cast<uint8_t>(j_type);
+      bool with_type = (j_type == ObJsonNodeType::J_OBJECT || j_type == ObJsonNodeType::J_ARRAY ||
+                        ObJsonVerType::is_opaque_or_string(j_type));
+      if (depth() == 0 && has_root_) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("json root is already built", K(ret));
+      } else if (OB_FAIL(value.raw_binary(raw, allocator_))) {
+        LOG_WARN("failed to get raw binary", K(ret), K(j_type));
+      } else if (raw.length() < 1) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("invalid raw binary", K(ret), K(raw.length()));
+      } else if ((j_type == ObJsonNodeType::J_OBJECT || j_type == ObJsonNodeType::J_ARRAY) &&
+                 reinterpret_cast<const ObJsonBinHeader*>(raw.ptr())->is_continuous_ == 0) {
+        // children updated out of place, rebuild as ObJsonBin::get_update_val_ptr
+        if (OB_FAIL(value.rebuild_at_iter(container_buf_))) {
+          LOG_WARN("failed to rebuild container", K(ret), K(j_type));
+        } else {
+          raw.assign_ptr(container_buf_.ptr(), container_buf_.length());
+        }
+      }
+
+      if (OB_FAIL(ret)) {
+      } else if (depth() == 0 || with_type) {
+        ret = value_buf_.append(raw.ptr(), raw.length());
+      } else {
+        ret = value_buf_.append(raw.ptr() + sizeof(uint8_t), raw.length() - sizeof(uint8_t));
+      }
+      if (OB_FAIL(ret)) {
+        LOG_WARN("failed to append raw binary", K(ret), K(j_type));
+      } else if (OB_FAIL(add_value(type, value_offset, JBLS_MAX, 0))) {
+        LOG_WARN("failed to add raw binary", K(ret), K(j_type));
+      }
+      break;
+    }
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::start_container(ObJBVerType type)
+{
+  INIT_SUCC(ret);
+  uint64_t cur_depth = depth();
+  ObJBBuildFrame frame;
+  frame.key_offset_ = has_key_ ? key_offset_ : 0;
+  frame.key_len_ = has_key_ ? key_len_ : 0;
+  frame.member_start_ = member_buf_.length();
+  frame.value_start_ = value_buf_.length();
+  frame.key_start_ = key_buf_.length();
+  frame.type_ = type;
+  if (cur_depth == 0 && has_root_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("json root is already built", K(ret));
+  } else if (OB_FAIL(stack_.append(reinterpret_cast<const char*>(&frame), sizeof(ObJBBuildFrame)))) {
+    LOG_WARN("failed to push frame", K(ret), K(cur_depth));
+  } else {
+    // key is restored for the container when it ends
+    has_key_ = false;
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::end_container(ObJBVerType type, bool with_unique_key)
+{
+  INIT_SUCC(ret);
+  uint64_t cur_depth = depth();
+  if (cur_depth == 0 || has_key_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected end of container", K(ret), K(cur_depth), K(has_key_));
+  } else {
+    ObJBBuildFrame frame = *reinterpret_cast<const ObJBBuildFrame*>(
+                           stack_.ptr() + (cur_depth - 1) * sizeof(ObJBBuildFrame));
+    ObJBBuildMember *members = reinterpret_cast<ObJBBuildMember*>(member_buf_.ptr() + frame.member_start_);
+    uint64_t count = (member_buf_.length() - frame.member_start_) / sizeof(ObJBBuildMember);
+    if (frame.type_ != type) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("container type mismatch", K(ret), K(frame.type_), K(type));
+    } else if (type == ObJBVerType::J_OBJECT_V0 && count > 1) {
+      std::sort(members, members + count, ObJBBuildMemberCompare(key_buf_.ptr()));
+      if (OB_FAIL(dedup_members(members, count, with_unique_key))) {
+        LOG_WARN("failed to dedup object members", K(ret), K(count));
+      }
+    }
+
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(encode_container(frame, members, count))) {
+      LOG_WARN("failed to encode container", K(ret), K(count));
+    } else if (OB_FAIL(member_buf_.set_length(frame.member_start_))) {
+      LOG_WARN("failed to pop members", K(ret));
+    } else if (OB_FAIL(value_buf_.set_length(frame.value_start_))) {
+      LOG_WARN("failed to pop values", K(ret));
+    } else if (OB_FAIL(key_buf_.set_length(frame.key_start_))) {
+      LOG_WARN("failed to pop keys", K(ret));
+    } else if (OB_FAIL(stack_.set_length(stack_.length() - sizeof(ObJBBuildFrame)))) {
+      LOG_WARN("failed to pop frame", K(ret));
+    } else {
+      uint64_t value_offset = value_buf_.length();
+      if (cur_depth > 1) {
+        const ObJBBuildFrame *parent = reinterpret_cast<const ObJBBuildFrame*>(
+                                       stack_.ptr() + (cur_depth - 2) * sizeof(ObJBBuildFrame));
+        has_key_ = (parent->type_ == ObJBVerType::J_OBJECT_V0);
+        key_offset_ = frame.key_offset_;
+        key_len_ = frame.key_len_;
+      }
+      if (OB_FAIL(value_buf_.append(container_buf_.ptr(), container_buf_.length()))) {
+        LOG_WARN("failed to append container", K(ret), K(container_buf_.length()));
+      } else if (OB_FAIL(add_value(static_cast<uint8_t>(type), value_offset, JBLS_MAX, 0))) {
+        LOG_WARN("failed to add container", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::dedup_members(ObJBBuildMember *members, uint64_t &count, bool with_unique_key) const
+{
+  INIT_SUCC(ret);
+  // members are sorted, for the same key only the last inserted one is kept
+  uint64_t kept = 0;
+  const char *keys = key_buf_.ptr();
+  for (uint64_t i = 0; OB_SUCC(ret) && i < count; i++) {
+    if (i + 1 < count && members[i].key_len_ == members[i + 1].key_len_ &&
+        MEMCMP(keys + members[i].key_offset_, keys + members[i + 1].key_offset_, members[i].key_len_) == 0) {
+      if (with_unique_key) {
+        ret = OB_ERR_DUPLICATE_KEY;
+        LOG_WARN("Found duplicate key inserted before!", K(ret),
+                 K(ObString(members[i].key_len_, keys + members[i].key_offset_)));
+      }
+    } else {
+      members[kept++] = members[i];
+    }
+  }
+  if (OB_SUCC(ret)) {
+    count = kept;
+  }
+  return ret;
+}
+
+uint64_t ObJsonBinBuilder::calc_container_size(const ObJBBuildMember *members, uint64_t count,
+                                               bool is_object, uint8_t entry_size) const
+{
+  uint64_t type_size = ObJsonVar::get_var_size(entry_size);
+  uint64_t size = OB_JSON_BIN_HEADER_LEN + ObJsonVar::get_var_size(ObJsonVar::get_var_type(count)) + type_size;
+  size += (type_size + sizeof(uint8_t)) * count;
+  if (is_object) {
+    size += type_size * 2 * count;
+  }
+  for (uint64_t i = 0; i < count; i++) {
+    size += members[i].key_len_;
+    if (members[i].inline_size_ > entry_size) {
+      size += members[i].value_len_;
+    }
+  }
+  return size;
+}
+
+// [header][count][size][key_entry][val_entry][key][val], same as ObJsonBin::serialize_json_object
+int ObJsonBinBuilder::encode_container(const ObJBBuildFrame &frame, const ObJBBuildMember *members, uint64_t count)
+{
+  INIT_SUCC(ret);
+  bool is_object = (frame.type_ == ObJBVerType::J_OBJECT_V0);
+  uint8_t entry_size = JBLS_UINT8;
+  uint64_t size = calc_container_size(members, count, is_object, entry_size);
+  while (entry_size < JBLS_UINT64 && ObJsonVar::get_var_type(size) > entry_size) {
+    entry_size++;
+    size = calc_container_size(members, count, is_object, entry_size);
+  }
+
+  ObJsonBinHeader header;
+  MEMSET(&header, 0, OB_JSON_BIN_HEADER_LEN);
+  header.type_ = frame.type_;
+  header.entry_size_ = entry_size;
+  header.obj_size_size_ = entry_size;
+  header.count_size_ = ObJsonVar::get_var_type(count);
+  header.is_continuous_ = 1;
+  uint64_t type_size = ObJsonVar::get_var_size(entry_size);
+  uint64_t entries_end = OB_JSON_BIN_HEADER_LEN + ObJsonVar::get_var_size(header.count_size_) + type_size
+                         + (type_size + sizeof(uint8_t)) * count + (is_object ? type_size * 2 * count : 0);
+  uint64_t key_offset = entries_end;
+  uint64_t value_offset = entries_end;
+  const char *keys = key_buf_.ptr();
+  const char *values = value_buf_.ptr();
+  container_buf_.reuse();
+  if (OB_FAIL(container_buf_.reserve(size))) {
+    LOG_WARN("failed to reserve container", K(ret), K(size));
+  } else if (OB_FAIL(container_buf_.append(reinterpret_cast<const char*>(&header), OB_JSON_BIN_HEADER_LEN))) {
+    LOG_WARN("failed to append header", K(ret));
+  } else if (OB_FAIL(ObJsonVar::append_var(count, header.count_size_, container_buf_))) {
+    LOG_WARN("failed to append count", K(ret), K(count));
+  } else if (OB_FAIL(ObJsonVar::append_var(size, header.obj_size_size_, container_buf_))) {
+    LOG_WARN("failed to append size", K(ret), K(size));
+  }
+  // key entries
+  for (uint64_t i = 0; OB_SUCC(ret) && is_object && i < count; i++) {
+    value_offset += members[i].key_len_;
+    if (OB_FAIL(ObJsonVar::append_var(key_offset, entry_size, container_buf_))) {
+      LOG_WARN("failed to append key offset", K(ret), K(key_offset));
+    } else if (OB_FAIL(ObJsonVar::append_var(members[i].key_len_, entry_size, container_buf_))) {
+      LOG_WARN("failed to append key length", K(ret), K(i));
+    } else {
+      key_offset += members[i].key_len_;
+    }
+  }
+  // value entries
+  for (uint64_t i = 0; OB_SUCC(ret) && i < count; i++) {
+    uint8_t type = members[i].type_;
+    if (members[i].inline_size_ <= entry_size) {
+      type |= OB_JSON_TYPE_INLINE_MASK;
+      ret = ObJsonVar::append_var(members[i].inline_val_, entry_size, container_buf_);
+    } else {
+      ret = ObJsonVar::append_var(value_offset, entry_size, container_buf_);
+      value_offset += members[i].value_len_;
+    }
+    if (OB_FAIL(ret)) {
+      LOG_WARN("failed to append value entry", K(ret), K(i));
+    } else if (OB_FAIL(container_buf_.append(reinterpret_cast<const char*>(&type), sizeof(uint8_t)))) {
+      LOG_WARN("failed to append value type", K(ret), K(i));
+    }
+  }
+  // keys
+  for (uint64_t i = 0; OB_SUCC(ret) && is_object && i < count; i++) {
+    if (members[i].key_len_ > 0 &&
+        OB_FAIL(container_buf_.append(keys + members[i].key_offset_, members[i].key_len_))) {
+      LOG_WARN("failed to append key", K(ret), K(i));
+    }
+  }
+  // values
+  for (uint64_t i = 0; OB_SUCC(ret) && i < count; i++) {
+    if (members[i].inline_size_ > entry_size && members[i].value_len_ > 0 &&
+        OB_FAIL(container_buf_.append(values + members[i].value_offset_, members[i].value_len_))) {
+      LOG_WARN("failed to append value", K(ret), K(i));
+    }
+  }
+  if (OB_SUCC(ret) && container_buf_.length() != size) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("container size mismatch", K(ret), K(size), K(container_buf_.length()));
+  }
+  return ret;
+}
+
+int ObJsonBinBuilder::get_result(ObString &result) const
+{
+  INIT_SUCC(ret);
+  if (depth() != 0 || !has_root_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("json binary is not finished", K(ret), K(depth()), K(has_root_));
+  } else {
+    result.assign_ptr(value_buf_.ptr(), value_buf_.length());
+  }
+  return ret;
+}
+
 } // namespace common
 } // namespace oceanbase
@@ -236,6 +236,14 @@ public:
   @return Returns OB_SUCCESS on success, error code otherwise.
   */
   int parse_tree(ObJsonNode *json_tree);
+  /*
+  parse json text to json bin in one pass, without json tree
+  @param[in] text        Json text
+  @param[in] length      Length of json text
+  @param[in] parse_flag  Flags of ObJsonParser
+  @return Returns OB_SUCCESS on success, error code otherwise.
+  */
+  int parse_text(const char *text, uint64_t length, uint32_t parse_flag = 0);
 
   /*
   parse json bin to json tree
@@ -552,6 +560,92 @@ public:
   static uint8_t get_var_type(int64_t var);
 };
 
+// Build json binary from sax events in one pass, without materializing a json tree.
+// Payloads of unfinished containers are kept in value_buf_ and their entries in member_buf_,
+// a container is encoded when it ends, with the smallest entry size that holds the whole
+// container, so no re-serialize is needed as ObJsonBin::serialize_json_object.
+class ObJsonBinBuilder
+{
+public:
+  explicit ObJsonBinBuilder(ObIAllocator *allocator);
+  ~ObJsonBinBuilder() {}
+  void reuse();
+
+  int start_object();
+  int end_object(bool with_unique_key = false);
+  int start_array();
+  int end_array();
+  // key of next value in current object, key is copied
+  int set_key(const char *key, uint64_t length);
+
+  int append_null();
+  int append_boolean(bool value);
+  int append_int(int64_t value);
+  int append_uint(uint64_t value);
+  int append_double(double value);
+  int append_string(const char *str, uint64_t length);
+  // append the value at iter position of json binary, such as a hit of path seek,
+  // value is rebuilt if it's a discontinuous container
+  int append_binary(ObJsonBin &value);
+
+  OB_INLINE uint64_t depth() const { return stack_.length() / sizeof(ObJBBuildFrame); }
+  // result is valid until the builder is reused or destroyed
+  int get_result(ObString &result) const;
+
+private:
+  static const int64_t MAX_VI64_LEN = 10; // max encoded length of vi64
+  // value entry of the container being built
+  struct ObJBBuildMember {
+    uint64_t key_offset_;   // offset in key_buf_
+    uint64_t key_len_;
+    uint64_t value_offset_; // offset in value_buf_
+    uint64_t value_len_;
+    uint64_t inline_val_;
+    uint64_t seq_;          // for duplicate keys, the last one wins
+    uint8_t type_;          // value entry type without inline mask
+    uint8_t inline_size_;   // min entry size to inline the value, JBLS_MAX if can not be inlined
+  };
+
+  struct ObJBBuildFrame {
+    uint64_t key_offset_;   // key of the container in its parent object
+    uint64_t key_len_;
+    uint64_t member_start_; // offset in member_buf_
+    uint64_t value_start_;  // offset in value_buf_
+    uint64_t key_start_;    // offset in key_buf_
+    uint8_t type_;          // J_OBJECT_V0 or J_ARRAY_V0
+  };
+
+  struct ObJBBuildMemberCompare {
+    explicit ObJBBuildMemberCompare(const char *keys) : keys_(keys) {}
+    bool operator()(const ObJBBuildMember &left, const ObJBBuildMember &right) const;
+    const char *keys_;
+  };
+
+  int start_container(ObJBVerType type);
+  int end_container(ObJBVerType type, bool with_unique_key);
+  int dedup_members(ObJBBuildMember *members, uint64_t &count, bool with_unique_key) const;
+  uint64_t calc_container_size(const ObJBBuildMember *members, uint64_t count,
+                               bool is_object, uint8_t entry_size) const;
+  int encode_container(const ObJBBuildFrame &frame, const ObJBBuildMember *members, uint64_t count);
+  // payload of the value is appended to value_buf_ from value_offset
+  int add_value(uint8_t type, uint64_t value_offset, uint8_t inline_size, uint64_t inline_val);
+  int append_scalar_header(uint8_t type, uint64_t &value_offset);
+
+private:
+  ObIAllocator *allocator_;
+  ObJsonBuffer value_buf_;
+  ObJsonBuffer key_buf_;
+  ObJsonBuffer member_buf_;
+  ObJsonBuffer stack_;
+  ObJsonBuffer container_buf_;
+  uint64_t key_offset_;
+  uint64_t key_len_;
+  uint64_t seq_;
+  bool has_key_;
+  bool has_root_;
+  DISALLOW_COPY_AND_ASSIGN(ObJsonBinBuilder);
+};
+
 } // namespace common
 } // namespace oceanbase
 #endif // OCEANBASE_SQL_OB_JSON_BIN
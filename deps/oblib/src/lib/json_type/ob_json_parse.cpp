@@ -132,6 +132,100 @@ int ObJsonParser::parse_json_text(ObIAllocator *allocator,
   return ret;
 }
 
+int ObJsonParser::get_bin(ObIAllocator *allocator, const ObString &text, ObString &j_bin,
+                          uint32_t parse_flag)
+{
+  return get_bin(allocator, text.ptr(), text.length(), j_bin, parse_flag);
+}
+
+int ObJsonParser::get_bin(ObIAllocator *allocator, const char *text, uint64_t length,
+                          ObString &j_bin, uint32_t parse_flag)
+{
+  INIT_SUCC(ret);
+  ObString built_bin;
+  ObRapidJsonBinHandler handler(allocator, HAS_FLAG(parse_flag, JSN_UNIQUE_FLAG));
+
+  if (OB_FAIL(parse_json_text_to_bin(allocator, text, length, handler, parse_flag))) {
+    LOG_WARN("fail to parse json text to bin", K(ret), K(length));
+  } else if (OB_FAIL(handler.get_built_bin(built_bin))) {
+    LOG_WARN("fail to get built json bin", K(ret));
+  } else if (OB_FAIL(ob_write_string(*allocator, built_bin, j_bin))) {
+    // buffers of handler are released with it
+    LOG_WARN("fail to copy json bin", K(ret), K(built_bin.length()));
+  }
+
+  return ret;
+}
+
+int ObJsonParser::get_bin(ObIAllocator *allocator, const char *text, uint64_t length,
+                          ObJsonBuffer &j_bin, uint32_t parse_flag)
+{
+  INIT_SUCC(ret);
+  ObString built_bin;
+  ObRapidJsonBinHandler handler(allocator, HAS_FLAG(parse_flag, JSN_UNIQUE_FLAG));
+
+  if (OB_FAIL(parse_json_text_to_bin(allocator, text, length, handler, parse_flag))) {
+    LOG_WARN("fail to parse json text to bin", K(ret), K(length));
+  } else if (OB_FAIL(handler.get_built_bin(built_bin))) {
+    LOG_WARN("fail to get built json bin", K(ret));
+  } else if (OB_FAIL(j_bin.append(built_bin.ptr(), built_bin.length()))) {
+    LOG_WARN("fail to append json bin", K(ret), K(built_bin.length()));
+  }
+
+  return ret;
+}
+
+// Same as parse_json_text, but values are written to json binary by ObRapidJsonBinHandler
+// as soon as they are parsed, json tree and serialization of it are skipped.
+int ObJsonParser::parse_json_text_to_bin(ObIAllocator *allocator, const char *text, uint64_t length,
+                                         ObRapidJsonBinHandler &handler, uint32_t parse_flag)
+{
+  INIT_SUCC(ret);
+
+  char *buf = NULL;
+  if (OB_ISNULL(allocator) || OB_ISNULL(text) || length == 0) {
+    ret = OB_ERR_NULL_VALUE;
+    LOG_WARN("param is null or json text length is 0", K(allocator), KP(text), K(length));
+  } else if (OB_ISNULL(buf = reinterpret_cast<char *>(allocator->alloc(length + 1)))) { // for '\0'
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc memory for json text", K(ret), K(length));
+  } else {
+    MEMCPY(buf, text, length);
+    buf[length] = '\0';
+    ObRapidJsonAllocator parse_allocator(allocator);
+    rapidjson::InsituStringStream ss(static_cast<char *>(buf));
+    ObRapidJsonReader reader(&parse_allocator);
+    rapidjson::ParseResult r;
+    try {
+      if (HAS_FLAG(parse_flag, JSN_RELAXED_FLAG)) {
+        r = reader.Parse<RELAXJSON_FLAG>(ss, handler);
+      } else if (HAS_FLAG(parse_flag, JSN_STRICT_FLAG)) {
+        r = reader.Parse<STRICTJSON_FLAG>(ss, handler);
+      } else {
+        r = reader.Parse<rapidjson::kParseInsituFlag>(ss, handler);
+      }
+    } catch (const std::bad_alloc &e) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory for json text", K(ret), K(length));
+    }
+
+    if (OB_FAIL(ret)) {
+    } else if (r.IsError()) {
+      if (handler.has_duplicate_key()) {
+        ret = OB_ERR_DUPLICATE_KEY;
+      } else {
+        ret = OB_ERR_INVALID_JSON_TEXT;
+      }
+      LOG_WARN("fail to parse json text", K(ret), K(r.Code()), K(reader.GetErrorOffset()),
+               KCSTRING(rapidjson::GetParseError_En(reader.GetParseErrorCode())));
+    }
+    // strings and keys are copied to binary, the text is not referenced any more
+    allocator->free(buf);
+  }
+
+  return ret;
+}
+
 bool ObJsonParser::is_json_doc_over_depth(uint64_t depth)
 {
   bool is_over = false;
@@ -571,6 +665,120 @@ bool ObRapidJsonHandler::Key(const char *str, rapidjson::SizeType length, bool c
 
   return is_continue;
 }
+bool ObRapidJsonBinHandler::Null()
+{
+  return OB_SUCCESS == builder_.append_null();
+}
+
+bool ObRapidJsonBinHandler::Bool(bool value)
+{
+  return OB_SUCCESS == builder_.append_boolean(value);
+}
+
+bool ObRapidJsonBinHandler::Int(int value)
+{
+  return OB_SUCCESS == builder_.append_int(value);
+}
+
+bool ObRapidJsonBinHandler::Uint(unsigned value)
+{
+  return OB_SUCCESS == builder_.append_int(value); // adapt mysql, use int
+}
+
+bool ObRapidJsonBinHandler::Int64(int64_t value)
+{
+  return OB_SUCCESS == builder_.append_int(value);
+}
+
+bool ObRapidJsonBinHandler::Uint64(uint64_t value)
+{
+  return OB_SUCCESS == builder_.append_uint(value);
+}
+
+bool ObRapidJsonBinHandler::Double(double value)
+{
+  bool is_continue = false;
+
+  if (!std::isfinite(value)) {
+    LOG_WARN_RET(OB_ERR_UNEXPECTED, "value is not finite", K(value));
+  } else {
+    is_continue = (OB_SUCCESS == builder_.append_double(value));
+  }
+
+  return is_continue;
+}
+
+// Never called, since we don't instantiate the parser with kParseNumbersAsStringsFlag.
+bool ObRapidJsonBinHandler::RawNumber(const char *, rapidjson::SizeType, bool copy)
+{
+  UNUSED(copy);
+
+  return false;
+}
+
+// string is written to binary at once, no need to deep-copy
+bool ObRapidJsonBinHandler::String(const char *str, rapidjson::SizeType length, bool copy)
+{
+  UNUSED(copy);
+
+  return OB_SUCCESS == builder_.append_string(str, length);
+}
+
+bool ObRapidJsonBinHandler::StartObject()
+{
+  bool is_continue = false;
+
+  if (ObJsonParser::is_json_doc_over_depth(builder_.depth())) {
+    LOG_WARN_RET(OB_ERR_UNEXPECTED, "current json doc is over depth", K(OB_ERR_JSON_OUT_OF_DEPTH));
+  } else {
+    is_continue = (OB_SUCCESS == builder_.start_object());
+  }
+
+  return is_continue;
+}
+
+bool ObRapidJsonBinHandler::EndObject(rapidjson::SizeType length)
+{
+  UNUSED(length);
+  INIT_SUCC(ret);
+
+  if (OB_FAIL(builder_.end_object(with_unique_key_))) {
+    LOG_WARN("fail to end json object", K(ret));
+    if (ret == OB_ERR_DUPLICATE_KEY) {
+      with_duplicate_key_ = true;
+    }
+  }
+
+  return OB_SUCC(ret);
+}
+
+bool ObRapidJsonBinHandler::StartArray()
+{
+  bool is_continue = false;
+
+  if (ObJsonParser::is_json_doc_over_depth(builder_.depth())) {
+    LOG_WARN_RET(OB_ERR_UNEXPECTED, "current json doc is over depth", K(OB_ERR_JSON_OUT_OF_DEPTH));
+  } else {
+    is_continue = (OB_SUCCESS == builder_.start_array());
+  }
+
+  return is_continue;
+}
+
+bool ObRapidJsonBinHandler::EndArray(rapidjson::SizeType length)
+{
+  UNUSED(length);
+
+  return OB_SUCCESS == builder_.end_array();
+}
+
+// key is copied by builder
+bool ObRapidJsonBinHandler::Key(const char *str, rapidjson::SizeType length, bool copy)
+{
+  UNUSED(copy);
+
+  return OB_SUCCESS == builder_.set_key(str, length);
+}
 #undef TEST_RELAXJSON_FLAG
 
 } // namespace common
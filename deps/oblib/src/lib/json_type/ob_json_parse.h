@@ -15,6 +15,7 @@
 #define OCEANBASE_SQL_OB_JSON_PARSE
 
 #include "ob_json_tree.h"
+#include "ob_json_bin.h"
 #include <rapidjson/error/en.h>
 #include <rapidjson/error/error.h>
 #include <rapidjson/memorystream.h>
@@ -29,6 +30,8 @@ namespace common {
     (flags) |= (specific);                      \
   }
 
+class ObRapidJsonBinHandler;
+
 class ObJsonParser final
 {
 public:
@@ -57,6 +60,20 @@ public:
                              const char *&syntaxerr, uint64_t *offset,
                              ObJsonNode *&j_tree, uint32_t parse_flag = 0);
 
+  // Parse json text to json binary in one pass with rapidjson, no json tree is built.
+  //
+  // @param [in]  allocator   Alloc memory for json text and json binary.
+  // @param [in]  text        The json documemt which need to parse.
+  // @param [out] j_bin       The json binary after successful parsing.
+  // @return Returns OB_SUCCESS on success, error code otherwise.
+  static int get_bin(ObIAllocator *allocator, const ObString &text,
+                     ObString &j_bin, uint32_t parse_flag = 0);
+  static int get_bin(ObIAllocator *allocator, const char *text, uint64_t length,
+                     ObString &j_bin, uint32_t parse_flag = 0);
+  // json binary is appended to j_bin
+  static int get_bin(ObIAllocator *allocator, const char *text, uint64_t length,
+                     ObJsonBuffer &j_bin, uint32_t parse_flag = 0);
+
   // The tree has a maximum depth of 100 layers
   static constexpr int JSON_DOCUMENT_MAX_DEPTH = 100;
 
@@ -74,6 +91,8 @@ public:
   static int check_json_syntax(const ObString &j_doc, ObIAllocator *allocator = NULL,
                                uint32_t parse_flag = 0);
 private:
+  static int parse_json_text_to_bin(ObIAllocator *allocator, const char *text, uint64_t length,
+                                    ObRapidJsonBinHandler &handler, uint32_t parse_flag);
   DISALLOW_COPY_AND_ASSIGN(ObJsonParser);
 };
 
@@ -190,6 +209,43 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObRapidJsonHandler);
 };
 
+// Write json binary directly while parsing, used by ObJsonParser::get_bin
+class ObRapidJsonBinHandler final : public rapidjson::BaseReaderHandler<>
+{
+public:
+  explicit ObRapidJsonBinHandler(ObIAllocator *allocator, bool with_unique_key = false)
+      : builder_(allocator),
+        with_unique_key_(with_unique_key),
+        with_duplicate_key_(false)
+  {
+  }
+  virtual ~ObRapidJsonBinHandler() {}
+
+  bool Null();
+  bool Bool(bool value);
+  bool Int(int value);
+  bool Uint(unsigned value);
+  bool Int64(int64_t value);
+  bool Uint64(uint64_t value);
+  bool Double(double value);
+  bool RawNumber(const char *, rapidjson::SizeType, bool copy);
+  bool String(const char *str, rapidjson::SizeType length, bool copy);
+  bool StartObject();
+  bool EndObject(rapidjson::SizeType length);
+  bool StartArray();
+  bool EndArray(rapidjson::SizeType length);
+  bool Key(const char *str, rapidjson::SizeType length, bool copy);
+  bool has_duplicate_key() { return with_duplicate_key_; }
+  // result is valid until the handler is destroyed
+  int get_built_bin(ObString &j_bin) const { return builder_.get_result(j_bin); }
+
+private:
+  ObJsonBinBuilder builder_;          // Keeps unfinished containers and the result.
+  bool with_unique_key_;              // Whether check unique key for object
+  bool with_duplicate_key_;           // Whether contain duplicate key for object
+  DISALLOW_COPY_AND_ASSIGN(ObRapidJsonBinHandler);
+};
+
 // for json_valid
 class ObJsonSyntaxCheckHandler final : public rapidjson::BaseReaderHandler<>
 {
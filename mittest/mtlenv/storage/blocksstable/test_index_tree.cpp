@@ -1208,6 +1208,96 @@ TEST_F(TestIndexTree, test_data_block_checksum)
   }
 }
 
+TEST_F(TestIndexTree, test_compress_pipeline)
+{
+  const int64_t test_row_num = 10000;
+  ObDatumRow row;
+  ObDatumRow multi_row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, TEST_COLUMN_CNT));
+  ASSERT_EQ(OB_SUCCESS, multi_row.init(allocator_, MAX_TEST_COLUMN_CNT));
+  ObSSTableMergeRes res[2];
+  const char *thread_cnts[2] = {"0", "2"};
+  for (int64_t round = 0; round < 2; ++round) {
+    GCONF._compaction_compress_thread_count.set_value(thread_cnts[round]);
+    ObDataStoreDesc index_desc;
+    ObSSTableIndexBuilder sstable_builder;
+    prepare_index_builder(index_desc, sstable_builder);
+    ObDataStoreDesc data_desc;
+    prepare_data_desc(data_desc, &sstable_builder);
+    ObMacroDataSeq data_seq(0);
+    ObMacroBlockWriter data_writer;
+    OK(data_writer.open(data_desc, data_seq));
+    ASSERT_EQ(round > 0, data_writer.compress_pipeline_.is_inited());
+    for (int64_t i = 0; i < test_row_num; ++i) {
+      OK(row_generate_.get_next_row(i, row));
+      convert_to_multi_version_row(row, table_schema_.get_rowkey_column_num(),
+          table_schema_.get_column_count(), SNAPSHOT_VERSION, DF_INSERT, multi_row);
+      OK(data_writer.append_row(multi_row));
+    }
+    OK(data_writer.close());
+    ASSERT_TRUE(data_writer.compress_pipeline_.is_empty());
+    OK(sstable_builder.close(data_desc.row_column_count_, res[round]));
+  }
+  GCONF._compaction_compress_thread_count.set_value("0");
+  // the workers are shared by the writers of the tenant
+  ASSERT_EQ(2, MTL(ObMicroBlockCompressService *)->get_thread_cnt());
+
+  // the blocks compressed by the workers are the same as the ones compressed by the writer
+  ASSERT_EQ(res[0].row_count_, res[1].row_count_);
+  ASSERT_EQ(res[0].data_blocks_cnt_, res[1].data_blocks_cnt_);
+  ASSERT_EQ(res[0].micro_block_cnt_, res[1].micro_block_cnt_);
+  ASSERT_EQ(res[0].occupy_size_, res[1].occupy_size_);
+  ASSERT_EQ(res[0].original_size_, res[1].original_size_);
+  ASSERT_EQ(res[0].data_checksum_, res[1].data_checksum_);
+  ASSERT_EQ(res[0].data_column_checksums_.count(), res[1].data_column_checksums_.count());
+  for (int64_t i = 0; i < res[0].data_column_checksums_.count(); ++i) {
+    ASSERT_EQ(res[0].data_column_checksums_.at(i), res[1].data_column_checksums_.at(i));
+  }
+}
+
+TEST_F(TestIndexTree, test_compress_pipeline_multi_writers)
+{
+  // several writers share the workers of the tenant, and one writer is reset
+  // while its blocks are still being compressed
+  const int64_t writer_cnt = 4;
+  const int64_t test_row_num = 2000;
+  GCONF._compaction_compress_thread_count.set_value("1");
+  ObDatumRow row;
+  ObDatumRow multi_row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, TEST_COLUMN_CNT));
+  ASSERT_EQ(OB_SUCCESS, multi_row.init(allocator_, MAX_TEST_COLUMN_CNT));
+  ObDataStoreDesc index_desc[writer_cnt];
+  ObSSTableIndexBuilder sstable_builder[writer_cnt];
+  ObDataStoreDesc data_desc[writer_cnt];
+  ObMacroBlockWriter data_writer[writer_cnt];
+  for (int64_t w = 0; w < writer_cnt; ++w) {
+    prepare_index_builder(index_desc[w], sstable_builder[w]);
+    prepare_data_desc(data_desc[w], &sstable_builder[w]);
+    ObMacroDataSeq data_seq(0);
+    OK(data_writer[w].open(data_desc[w], data_seq));
+    ASSERT_TRUE(data_writer[w].compress_pipeline_.is_inited());
+  }
+  for (int64_t i = 0; i < test_row_num; ++i) {
+    OK(row_generate_.get_next_row(i, row));
+    convert_to_multi_version_row(row, table_schema_.get_rowkey_column_num(),
+        table_schema_.get_column_count(), SNAPSHOT_VERSION, DF_INSERT, multi_row);
+    for (int64_t w = 0; w < writer_cnt; ++w) {
+      OK(data_writer[w].append_row(multi_row));
+    }
+  }
+  OK(data_writer[0].build_micro_block());
+  data_writer[0].reset();
+  ASSERT_FALSE(data_writer[0].compress_pipeline_.is_inited());
+  for (int64_t w = 1; w < writer_cnt; ++w) {
+    ObSSTableMergeRes res;
+    OK(data_writer[w].close());
+    OK(sstable_builder[w].close(data_desc[w].row_column_count_, res));
+    ASSERT_EQ(test_row_num, res.row_count_);
+  }
+  ASSERT_EQ(1, MTL(ObMicroBlockCompressService *)->get_thread_cnt());
+  GCONF._compaction_compress_thread_count.set_value("0");
+}
+
 TEST_F(TestIndexTree, test_reuse_macro_block)
 {
   int ret = OB_SUCCESS;
@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#define private public
+#define protected public
+
+#include "mtlenv/mock_tenant_module_env.h"
+#include "storage/lob/ob_lob_persistent_adaptor.h"
+#include "storage/lob/ob_lob_meta.h"
+#include "storage/lob/ob_lob_piece.h"
+#include "share/schema/ob_table_param.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace storage;
+using namespace share::schema;
+
+namespace unittest
+{
+
+#define CALL(func, ...) func(__VA_ARGS__); ASSERT_FALSE(HasFatalFailure());
+
+class TestLobPersistentAdaptor : public ::testing::Test
+{
+public:
+  static void SetUpTestCase()
+  {
+    EXPECT_EQ(OB_SUCCESS, MockTenantModuleEnv::get_instance().init());
+    EXPECT_EQ(OB_SUCCESS, omt::ObTenantConfigMgr::get_instance().add_tenant_config(MTL_ID()));
+  }
+  static void TearDownTestCase()
+  {
+    MockTenantModuleEnv::get_instance().destroy();
+  }
+  virtual void TearDown() override
+  {
+    set_block_cache(false);
+    allocator_.reset();
+  }
+
+  void set_block_cache(const bool enable)
+  {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+    ASSERT_TRUE(tenant_config.is_valid());
+    tenant_config->_enable_lob_meta_block_cache = enable;
+  }
+
+  // scan param of lob meta (piece) tablet, as scan_lob_meta and get_lob_data build it
+  void prepare_scan_param(ObPersistentLobApator &adaptor,
+                          const bool is_meta,
+                          ObTableScanParam &scan_param)
+  {
+    ObLobAccessParam param;
+    param.allocator_ = &allocator_;
+    param.timeout_ = ObTimeUtility::current_time() + 10 * 1000 * 1000;
+    const uint32_t col_num = is_meta ? ObLobMetaUtil::LOB_META_COLUMN_CNT
+                                     : ObLobPieceUtil::LOB_PIECE_COLUMN_CNT;
+    ASSERT_EQ(OB_SUCCESS, adaptor.build_common_scan_param(param, 1, col_num, scan_param));
+    ASSERT_EQ(OB_SUCCESS, adaptor.prepare_table_param(param, scan_param, is_meta));
+    ASSERT_TRUE(NULL != scan_param.table_param_);
+    ASSERT_EQ(col_num, scan_param.table_param_->get_output_projector().count());
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+};
+
+// the table param is built once for each of (meta, piece) * (mysql, oracle) and shared
+TEST_F(TestLobPersistentAdaptor, shared_table_param)
+{
+  ObPersistentLobApator adaptor;
+  const ObTableParam *params[ObPersistentLobApator::TABLE_PARAM_CNT] = { NULL };
+  for (int64_t i = 0; i < ObPersistentLobApator::TABLE_PARAM_CNT; ++i) {
+    const bool is_meta = i < 2;
+    lib::CompatModeGuard guard(1 == i % 2 ? lib::Worker::CompatMode::ORACLE
+                                          : lib::Worker::CompatMode::MYSQL);
+    ObTableScanParam scan_param;
+    CALL(prepare_scan_param, adaptor, is_meta, scan_param);
+    ASSERT_TRUE(NULL != adaptor.table_params_[i]);
+    ASSERT_EQ(&adaptor.table_params_[i]->table_param_, scan_param.table_param_);
+    for (int64_t j = 0; j < i; ++j) {
+      ASSERT_NE(params[j], scan_param.table_param_);
+    }
+    params[i] = scan_param.table_param_;
+  }
+  // built params are reused by later scans
+  for (int64_t i = 0; i < ObPersistentLobApator::TABLE_PARAM_CNT; ++i) {
+    const bool is_meta = i < 2;
+    lib::CompatModeGuard guard(1 == i % 2 ? lib::Worker::CompatMode::ORACLE
+                                          : lib::Worker::CompatMode::MYSQL);
+    ObTableScanParam scan_param;
+    CALL(prepare_scan_param, adaptor, is_meta, scan_param);
+    ASSERT_EQ(params[i], scan_param.table_param_);
+  }
+}
+
+// concurrent first scans publish only one table param
+TEST_F(TestLobPersistentAdaptor, concurrent_build)
+{
+  const int64_t THREAD_CNT = 8;
+  ObPersistentLobApator adaptor;
+  const uint64_t tenant_id = MTL_ID();
+  share::ObTenantBase *tenant_base = MTL_CTX();
+  const ObTableParam *params[THREAD_CNT] = { NULL };
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i < THREAD_CNT; ++i) {
+    threads.push_back(std::thread([&, i]() {
+      share::ObTenantEnv::set_tenant(tenant_base);
+      ObArenaAllocator allocator(ObMemAttr(tenant_id, "LobTest"));
+      ObLobAccessParam param;
+      param.allocator_ = &allocator;
+      ObTableScanParam scan_param;
+      if (OB_SUCCESS == adaptor.build_common_scan_param(param, 1,
+            ObLobMetaUtil::LOB_META_COLUMN_CNT, scan_param)
+          && OB_SUCCESS == adaptor.prepare_table_param(param, scan_param, true)) {
+        params[i] = scan_param.table_param_;
+      }
+    }));
+  }
+  for (int64_t i = 0; i < THREAD_CNT; ++i) {
+    threads[i].join();
+  }
+  ASSERT_TRUE(NULL != adaptor.table_params_[0]);
+  for (int64_t i = 0; i < THREAD_CNT; ++i) {
+    ASSERT_EQ(&adaptor.table_params_[0]->table_param_, params[i]);
+  }
+}
+
+// lob meta scans only use block cache when _enable_lob_meta_block_cache is on
+TEST_F(TestLobPersistentAdaptor, block_cache)
+{
+  ObPersistentLobApator adaptor;
+  {
+    ObTableScanParam scan_param;
+    CALL(prepare_scan_param, adaptor, true, scan_param);
+    ASSERT_FALSE(scan_param.scan_flag_.is_use_block_cache());
+    ASSERT_FALSE(scan_param.scan_flag_.is_use_row_cache());
+  }
+  CALL(set_block_cache, true);
+  {
+    ObTableScanParam scan_param;
+    CALL(prepare_scan_param, adaptor, true, scan_param);
+    ASSERT_TRUE(scan_param.scan_flag_.is_use_block_cache());
+    ASSERT_FALSE(scan_param.scan_flag_.is_use_row_cache());
+  }
+  {
+    ObTableScanParam scan_param;
+    CALL(prepare_scan_param, adaptor, false, scan_param);
+    ASSERT_TRUE(scan_param.scan_flag_.is_use_block_cache());
+  }
+}
+
+} // end unittest
+} // end oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -rf test_lob_persistent_adaptor.log*");
+  OB_LOGGER.set_file_name("test_lob_persistent_adaptor.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
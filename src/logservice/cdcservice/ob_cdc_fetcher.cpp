@@ -16,6 +16,10 @@
 #include "ob_cdc_fetcher.h"
 #include "ob_cdc_define.h"
 #include "storage/tx_storage/ob_ls_handle.h"
+#include "storage/tx/ob_tx_log.h"                 // ObTxLogBlock
+#include "storage/memtable/ob_memtable_mutator.h" // ObMemtableMutatorMeta
+#include "storage/memtable/ob_memtable_context.h" // ObTransRowFlag
+#include "logservice/ob_log_base_header.h"        // ObLogBaseHeader
 #include "logservice/restoreservice/ob_remote_log_source_allocator.h"
 
 namespace oceanbase
@@ -90,6 +94,8 @@ int ObCdcFetcher::fetch_log(const ObCdcLSFetchLogReq &req,
     LOG_WARN("invalid fetch_log req", KR(ret), K(req));
   } else if (OB_FAIL(frt.init(rpc_id, cur_tstamp, req.get_upper_limit_ts()))) {
     LOG_WARN("fetch runtime init error", KR(ret), K(rpc_id), K(req));
+  } else if (OB_FAIL(frt.init_pruned_tablets(req.get_pruned_tablets()))) {
+    LOG_WARN("fetch runtime init pruned tablets error", KR(ret), K(req));
   } else {
     const ObLSID &ls_id = req.get_ls_id();
     const LSN &start_lsn = req.get_start_lsn();
@@ -588,10 +594,18 @@ int ObCdcFetcher::ls_fetch_log_(const ObLSID &ls_id,
     // return code is unable to be used for determine whether logEntry is successfully fetched.
     // update the resp/frt/ctx when the logentry is successfully fetched
     if (OB_SUCC(ret) && fetch_log_succ) {
+      bool is_pruned = false;
       check_next_group_entry_(lsn, log_group_entry, fetched_log_count, resp, frt, reach_upper_limit, ctx);
       resp.set_progress(ctx.get_progress());
       if (frt.is_stopped()) {
         // Stop fetching log
+      } else if (OB_FAIL(prune_group_entry_(ls_id, lsn, log_group_entry, frt, resp, is_pruned))) {
+        LOG_WARN("prune_group_entry fail", KR(ret), K(ls_id), K(lsn), K(frt), K(resp));
+      } else if (is_pruned) {
+        // log fetched successfully but not filled
+        fetched_log_count++;
+
+        LOG_TRACE("LS prune a log", K(ls_id), K(lsn), K(fetched_log_count), K(frt));
       } else if (OB_FAIL(prefill_resp_with_group_entry_(ls_id, lsn, log_group_entry, resp))) {
         if (OB_BUF_NOT_ENOUGH == ret) {
           handle_when_buffer_full_(frt); // stop
@@ -714,6 +728,183 @@ void ObCdcFetcher::handle_when_buffer_full_(FetchRunTime &frt)
   frt.stop("BufferFull");
 }
 
+int ObCdcFetcher::prune_group_entry_(const ObLSID &ls_id,
+    const LSN &lsn,
+    const LogGroupEntry &log_group_entry,
+    const FetchRunTime &frt,
+    obrpc::ObCdcLSFetchLogResp &resp,
+    bool &is_pruned)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObCdcLSFetchLogResp::PrunedRedo, 16> redo_arr;
+  is_pruned = false;
+
+  // data of sys LS is always consumed by the client
+  if (! frt.has_pruned_tablets() || ls_id.is_sys_ls()) {
+    // do nothing
+  } else if (log_group_entry.get_header().is_padding_log()) {
+    is_pruned = true;
+  } else {
+    const char *buf = log_group_entry.get_data_buf();
+    const int64_t buf_len = log_group_entry.get_data_len();
+    const LSN data_lsn = lsn + log_group_entry.get_header().get_serialize_size();
+    int64_t pos = 0;
+    is_pruned = true;
+
+    while (OB_SUCC(ret) && is_pruned && pos < buf_len) {
+      LogEntry log_entry;
+      const LSN entry_lsn = data_lsn + pos;
+
+      if (OB_FAIL(log_entry.deserialize(buf, buf_len, pos))) {
+        LOG_WARN("LogEntry deserialize fail", KR(ret), K(ls_id), K(lsn), K(buf_len), K(pos));
+      } else if (OB_FAIL(check_log_entry_pruned_(entry_lsn, log_entry, frt, redo_arr, is_pruned))) {
+        LOG_WARN("check_log_entry_pruned_ fail", KR(ret), K(ls_id), K(entry_lsn));
+      }
+    }
+
+    if (OB_FAIL(ret)) {
+      // fill the LogGroupEntry as it is
+      is_pruned = false;
+      ret = OB_SUCCESS;
+    }
+  }
+
+  if (OB_SUCC(ret) && is_pruned) {
+    const int64_t entry_size = log_group_entry.get_serialize_size();
+    const int64_t submit_ts = log_group_entry.get_scn().get_val_for_logservice();
+
+    if (! resp.can_append_pruned_group(redo_arr.count())) {
+      is_pruned = false;
+    } else if (OB_FAIL(resp.append_pruned_group(lsn, entry_size, submit_ts, redo_arr))) {
+      LOG_WARN("append_pruned_group fail", KR(ret), K(ls_id), K(lsn), K(entry_size), K(resp));
+    } else {
+      ObCdcServiceMonitor::pruned_size(entry_size);
+      ObCdcServiceMonitor::pruned_log_count(1);
+    }
+  }
+
+  return ret;
+}
+
+int ObCdcFetcher::check_log_entry_pruned_(const LSN &lsn,
+    const LogEntry &log_entry,
+    const FetchRunTime &frt,
+    common::ObIArray<ObCdcLSFetchLogResp::PrunedRedo> &redo_arr,
+    bool &is_pruned)
+{
+  int ret = OB_SUCCESS;
+  const char *buf = log_entry.get_data_buf();
+  const int64_t buf_len = log_entry.get_data_len();
+  int64_t pos = 0;
+  ObLogBaseHeader log_base_header;
+  transaction::ObTxLogBlock tx_log_block;
+  transaction::ObTxLogBlockHeader tx_log_block_header;
+  int64_t redo_count = 0;
+  is_pruned = false;
+
+  if (OB_FAIL(log_base_header.deserialize(buf, buf_len, pos))) {
+    LOG_WARN("ObLogBaseHeader deserialize fail", KR(ret), K(lsn), K(buf_len));
+  } else if (ObLogBaseType::TRANS_SERVICE_LOG_BASE_TYPE != log_base_header.get_log_type()) {
+    // not a tx log
+  } else if (OB_FAIL(tx_log_block.init(buf, buf_len, pos, tx_log_block_header))) {
+    LOG_WARN("ObTxLogBlock init fail", KR(ret), K(lsn), K(buf_len), K(pos));
+  } else {
+    is_pruned = true;
+
+    while (OB_SUCC(ret) && is_pruned) {
+      transaction::ObTxLogHeader tx_log_header;
+
+      if (OB_FAIL(tx_log_block.get_next_log(tx_log_header))) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("get_next_log from tx_log_block fail", KR(ret), K(lsn), K(tx_log_block_header));
+        }
+      } else if (transaction::ObTxLogType::TX_REDO_LOG != tx_log_header.get_tx_log_type()) {
+        is_pruned = false;
+      } else {
+        transaction::ObTxRedoLogTempRef tmp_ref;
+        transaction::ObTxRedoLog redo_log(tmp_ref);
+
+        if (OB_FAIL(tx_log_block.deserialize_log_body(redo_log))) {
+          LOG_WARN("deserialize redo log body fail", KR(ret), K(lsn), K(tx_log_block_header));
+        } else if (OB_FAIL(check_mutator_pruned_(redo_log.get_replay_mutator_buf(),
+            redo_log.get_mutator_size(), frt, is_pruned))) {
+          LOG_WARN("check_mutator_pruned_ fail", KR(ret), K(lsn), K(tx_log_block_header));
+        } else {
+          redo_count++;
+        }
+      }
+    }
+
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    }
+
+    // the client expects at most one redo log in a LogEntry
+    if (OB_SUCC(ret) && is_pruned) {
+      if (1 != redo_count) {
+        is_pruned = false;
+      } else {
+        ObCdcLSFetchLogResp::PrunedRedo redo;
+        redo.tx_id_ = tx_log_block_header.get_tx_id().get_id();
+        redo.cluster_id_ = tx_log_block_header.get_org_cluster_id();
+        redo.lsn_ = lsn;
+
+        if (OB_FAIL(redo_arr.push_back(redo))) {
+          LOG_WARN("push back pruned redo fail", KR(ret), K(redo));
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+
+int ObCdcFetcher::check_mutator_pruned_(const char *buf,
+    const int64_t buf_len,
+    const FetchRunTime &frt,
+    bool &is_pruned)
+{
+  int ret = OB_SUCCESS;
+  memtable::ObMemtableMutatorMeta meta;
+  int64_t pos = 0;
+  is_pruned = false;
+
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid mutator", KR(ret), KP(buf), K(buf_len));
+  } else if (OB_FAIL(meta.deserialize(buf, buf_len, pos))) {
+    LOG_WARN("ObMemtableMutatorMeta deserialize fail", KR(ret), K(buf_len));
+  } else if (memtable::ObTransRowFlag::NORMAL_ROW != meta.get_flags()) {
+    // rows of encrypted or big row mutator can't be seen here
+  } else {
+    is_pruned = true;
+
+    while (OB_SUCC(ret) && is_pruned && pos < buf_len) {
+      memtable::ObMutatorRowHeader row_header;
+      int64_t row_pos = 0;
+      int32_t row_size = 0;
+
+      if (OB_FAIL(row_header.deserialize(buf, buf_len, pos))) {
+        LOG_WARN("ObMutatorRowHeader deserialize fail", KR(ret), K(buf_len), K(pos));
+      } else if (memtable::MutatorType::MUTATOR_ROW != row_header.mutator_type_
+          || ! frt.is_tablet_pruned(row_header.tablet_id_)) {
+        is_pruned = false;
+      } else if (FALSE_IT(row_pos = pos)) {
+      } else if (OB_FAIL(serialization::decode_i32(buf, buf_len, row_pos, &row_size))) {
+        LOG_WARN("decode row size fail", KR(ret), K(buf_len), K(pos));
+      } else if (OB_UNLIKELY(row_size <= 0 || pos + row_size > buf_len)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("invalid row size", KR(ret), K(row_size), K(buf_len), K(pos));
+      } else {
+        // a row starts with its size, which includes the size itself
+        pos += row_size;
+      }
+    }
+  }
+
+  return ret;
+}
+
 int ObCdcFetcher::handle_log_not_exist_(const ObLSID &ls_id,
     obrpc::ObCdcLSFetchLogResp &resp)
 {
@@ -1052,5 +1243,24 @@ int FetchRunTime::init(const ObLogRpcIDType rpc_id,
   return ret;
 }
 
+int FetchRunTime::init_pruned_tablets(const common::ObIArray<common::ObTabletID> &tablets)
+{
+  int ret = OB_SUCCESS;
+  pruned_tablets_.reuse();
+
+  if (OB_FAIL(pruned_tablets_.assign(tablets))) {
+    LOG_WARN("assign pruned tablets fail", KR(ret), "count", tablets.count());
+  } else {
+    std::sort(pruned_tablets_.begin(), pruned_tablets_.end());
+  }
+
+  return ret;
+}
+
+bool FetchRunTime::is_tablet_pruned(const common::ObTabletID &tablet_id) const
+{
+  return std::binary_search(pruned_tablets_.begin(), pruned_tablets_.end(), tablet_id);
+}
+
 } // namespace cdc
 } // namespace oceanbase
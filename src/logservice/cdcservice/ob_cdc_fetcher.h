@@ -156,6 +156,27 @@ private:
       LogGroupEntry &log_group_entry,
       obrpc::ObCdcLSFetchLogResp &resp);
   void handle_when_buffer_full_(FetchRunTime &frt);
+  // Skip the LogGroupEntry if all its LogEntries are redo of tablets pruned by the client (or it is a padding
+  // entry), and record it in resp instead of filling it. Transaction boundaries are kept since any other tx log
+  // (commit info, prepare, commit...) keeps the whole LogGroupEntry.
+  // Keep the LogGroupEntry if it can't be parsed.
+  int prune_group_entry_(const ObLSID &ls_id,
+      const LSN &lsn,
+      const LogGroupEntry &log_group_entry,
+      const FetchRunTime &frt,
+      obrpc::ObCdcLSFetchLogResp &resp,
+      bool &is_pruned);
+  // is_pruned is true if the LogEntry is a tx log block which only contains one redo log of pruned tablets
+  int check_log_entry_pruned_(const LSN &lsn,
+      const LogEntry &log_entry,
+      const FetchRunTime &frt,
+      common::ObIArray<obrpc::ObCdcLSFetchLogResp::PrunedRedo> &redo_arr,
+      bool &is_pruned);
+  // is_pruned is true if all rows of the mutator are normal rows of pruned tablets
+  int check_mutator_pruned_(const char *buf,
+      const int64_t buf_len,
+      const FetchRunTime &frt,
+      bool &is_pruned);
   // lsn of ls_id wantted does not exist on this server, feed this information back to CDC Connector,
   // CDC Connector needs to change search server.
   int handle_log_not_exist_(const ObLSID &ls_id,
@@ -206,6 +227,7 @@ struct FetchRunTime
   int init(const ObLogRpcIDType rpc_id,
       const int64_t rpc_start_tstamp,
       const int64_t upper_limit_ts = 0);
+  int init_pruned_tablets(const common::ObIArray<common::ObTabletID> &tablets);
 
   inline bool is_stopped() const { return is_stopped_; }
   inline void stop(const char *stop_reason)
@@ -220,13 +242,17 @@ struct FetchRunTime
     return delay_time > LS_FALL_BEHIND_THRESHOLD_TIME;
   }
 
+  inline bool has_pruned_tablets() const { return pruned_tablets_.count() > 0; }
+  bool is_tablet_pruned(const common::ObTabletID &tablet_id) const;
+
   TO_STRING_KV(K(rpc_id_),
       K(rpc_start_tstamp_),
       K(upper_limit_ts_),
       K(rpc_deadline_),
       K(is_stopped_),
       K(stop_reason_),
-      K(fetch_status_));
+      K(fetch_status_),
+      "pruned_tablet_count", pruned_tablets_.count());
 
   // In params: config related
   // The unique identifier of a round of RPC, currently uses a timestamp to distinguish
@@ -234,6 +260,8 @@ struct FetchRunTime
   int64_t rpc_start_tstamp_;
   int64_t upper_limit_ts_;
   int64_t rpc_deadline_;
+  // tablets whose redo the client doesn't consume, sorted
+  common::ObSEArray<common::ObTabletID, 16> pruned_tablets_;
 
   // Out params: control flow related
   bool is_stopped_;
@@ -249,7 +249,8 @@ OB_DEF_DESERIALIZE(ObCdcReqStartLSNByTsResp)
  *
  */
 OB_SERIALIZE_MEMBER(ObCdcLSFetchLogReq, rpc_ver_, ls_id_, start_lsn_,
-                    upper_limit_ts_, client_pid_, client_id_, progress_, flag_);
+                    upper_limit_ts_, client_pid_, client_id_, progress_, flag_,
+                    pruned_tablet_arr_);
 OB_SERIALIZE_MEMBER(ObCdcFetchStatus,
                     is_reach_max_lsn_,
                     is_reach_upper_limit_ts_,
@@ -259,6 +260,26 @@ OB_SERIALIZE_MEMBER(ObCdcFetchStatus,
                     log_fetch_time_,
                     ext_process_time_);
 
+void ObCdcLSFetchLogResp::PrunedGroup::reset()
+{
+  lsn_.reset();
+  size_ = 0;
+  submit_ts_ = OB_INVALID_TIMESTAMP;
+  buf_pos_ = 0;
+  redo_cnt_ = 0;
+}
+
+OB_SERIALIZE_MEMBER(ObCdcLSFetchLogResp::PrunedGroup, lsn_, size_, submit_ts_, buf_pos_, redo_cnt_);
+
+void ObCdcLSFetchLogResp::PrunedRedo::reset()
+{
+  tx_id_ = 0;
+  cluster_id_ = 0;
+  lsn_.reset();
+}
+
+OB_SERIALIZE_MEMBER(ObCdcLSFetchLogResp::PrunedRedo, tx_id_, cluster_id_, lsn_);
+
 OB_DEF_SERIALIZE(ObCdcLSFetchLogResp)
 {
   int ret = OB_SUCCESS;
@@ -275,7 +296,7 @@ OB_DEF_SERIALIZE(ObCdcLSFetchLogResp)
       pos += pos_;
     }
   }
-  LST_DO_CODE(OB_UNIS_ENCODE, server_progress_);
+  LST_DO_CODE(OB_UNIS_ENCODE, server_progress_, pruned_group_arr_, pruned_redo_arr_);
 
   return ret;
 }
@@ -291,7 +312,7 @@ OB_DEF_SERIALIZE_SIZE(ObCdcLSFetchLogResp)
                 log_num_, pos_);
     len += pos_;
 
-    LST_DO_CODE(OB_UNIS_ADD_LEN, server_progress_);
+    LST_DO_CODE(OB_UNIS_ADD_LEN, server_progress_, pruned_group_arr_, pruned_redo_arr_);
   } else {
     tmp_ret = OB_NOT_SUPPORTED;
     EXTLOG_LOG_RET(ERROR, tmp_ret, "get serialize size error, version not match",
@@ -319,7 +340,7 @@ OB_DEF_DESERIALIZE(ObCdcLSFetchLogResp)
       pos += pos_;
     }
 
-    LST_DO_CODE(OB_UNIS_DECODE, server_progress_);
+    LST_DO_CODE(OB_UNIS_DECODE, server_progress_, pruned_group_arr_, pruned_redo_arr_);
   } else {
     ret = OB_NOT_SUPPORTED;
     EXTLOG_LOG(ERROR, "deserialize error, version not match",
@@ -339,6 +360,7 @@ void ObCdcLSFetchLogReq::reset()
   client_id_.reset();
   progress_ = OB_INVALID_TIMESTAMP;
   flag_ = 0;
+  pruned_tablet_arr_.reset();
 }
 
 ObCdcLSFetchLogReq& ObCdcLSFetchLogReq::operator=(const ObCdcLSFetchLogReq &other)
@@ -396,6 +418,21 @@ int ObCdcLSFetchLogReq::set_upper_limit_ts(const int64_t ts)
   return ret;
 }
 
+int ObCdcLSFetchLogReq::set_pruned_tablets(const common::ObIArray<common::ObTabletID> &tablets)
+{
+  int ret = OB_SUCCESS;
+  const int64_t count = std::min(tablets.count(), MAX_PRUNED_TABLET_CNT);
+  pruned_tablet_arr_.reuse();
+
+  for (int64_t idx = 0; OB_SUCC(ret) && idx < count; idx++) {
+    if (OB_FAIL(pruned_tablet_arr_.push_back(tablets.at(idx)))) {
+      EXTLOG_LOG(WARN, "push back pruned tablet failed", K(ret), K(idx), K(count));
+    }
+  }
+
+  return ret;
+}
+
 /*
 int ObCdcRespBuf::append_log_group_entry(const LogGroupEntry &entry)
 {
@@ -448,6 +485,12 @@ int ObCdcLSFetchLogResp::assign(const ObCdcLSFetchLogResp &other)
     if (log_num_ > 0 && pos_ > 0) {
       (void)MEMCPY(log_entry_buf_, other.log_entry_buf_, pos_);
     }
+
+    if (OB_FAIL(pruned_group_arr_.assign(other.pruned_group_arr_))) {
+      EXTLOG_LOG(WARN, "assign pruned group array failed", K(ret));
+    } else if (OB_FAIL(pruned_redo_arr_.assign(other.pruned_redo_arr_))) {
+      EXTLOG_LOG(WARN, "assign pruned redo array failed", K(ret));
+    }
   }
 
   return ret;
@@ -466,6 +509,52 @@ void ObCdcLSFetchLogResp::reset()
   pos_ = 0;
   log_entry_buf_[0] = '\0';
   server_progress_ = OB_INVALID_TIMESTAMP;
+  pruned_group_arr_.reset();
+  pruned_redo_arr_.reset();
+}
+
+int ObCdcLSFetchLogResp::append_pruned_group(const LSN &lsn,
+    const int64_t size,
+    const int64_t submit_ts,
+    const common::ObIArray<PrunedRedo> &redo_arr)
+{
+  int ret = OB_SUCCESS;
+  PrunedGroup group;
+  group.lsn_ = lsn;
+  group.size_ = size;
+  group.submit_ts_ = submit_ts;
+  group.buf_pos_ = pos_;
+  group.redo_cnt_ = redo_arr.count();
+
+  if (OB_UNLIKELY(! lsn.is_valid() || size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    EXTLOG_LOG(WARN, "invalid pruned group", K(ret), K(lsn), K(size));
+  } else if (OB_UNLIKELY(! can_append_pruned_group(redo_arr.count()))) {
+    ret = OB_SIZE_OVERFLOW;
+  } else {
+    const int64_t redo_cnt = pruned_redo_arr_.count();
+
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < redo_arr.count(); idx++) {
+      if (OB_FAIL(pruned_redo_arr_.push_back(redo_arr.at(idx)))) {
+        EXTLOG_LOG(WARN, "push back pruned redo failed", K(ret), K(idx));
+      }
+    }
+
+    if (OB_SUCC(ret) && OB_FAIL(pruned_group_arr_.push_back(group))) {
+      EXTLOG_LOG(WARN, "push back pruned group failed", K(ret), K(group));
+    }
+
+    if (OB_FAIL(ret)) {
+      // keep the redo array in the order of groups
+      while (pruned_redo_arr_.count() > redo_cnt) {
+        pruned_redo_arr_.pop_back();
+      }
+    } else {
+      next_req_lsn_ = lsn + size;
+    }
+  }
+
+  return ret;
 }
 
 /*
@@ -18,6 +18,7 @@
 #include "logservice/palf/lsn.h"                // LSN
 #include "logservice/palf/log_group_entry.h"    // LogGroupEntry
 #include "logservice/palf/log_entry.h"          // LogEntry
+#include "common/ob_tablet_id.h"                // ObTabletID
 
 
 namespace oceanbase
@@ -201,6 +202,10 @@ private:
 class ObCdcLSFetchLogReq
 {
   static const int64_t CUR_RPC_VER = 1;
+public:
+  // Upper limit of tablets carried by one request, around 32KB.
+  static const int64_t MAX_PRUNED_TABLET_CNT = 4096;
+  typedef common::ObSEArray<common::ObTabletID, 16> TabletIDArray;
 public:
   ObCdcLSFetchLogReq() { reset(); }
   ~ObCdcLSFetchLogReq() {}
@@ -236,6 +241,10 @@ public:
   void set_flag(int8_t flag) { flag_ |= flag; }
   int8_t get_flag() const { return flag_; }
 
+  // Tablets whose data the client never consumes, at most MAX_PRUNED_TABLET_CNT of them are kept.
+  int set_pruned_tablets(const common::ObIArray<common::ObTabletID> &tablets);
+  const TabletIDArray &get_pruned_tablets() const { return pruned_tablet_arr_; }
+
   TO_STRING_KV(K_(rpc_ver),
       K_(ls_id),
       K_(start_lsn),
@@ -243,7 +252,8 @@ public:
       K_(client_pid),
       K_(client_id),
       K_(progress),
-      K_(flag));
+      K_(flag),
+      "pruned_tablet_count", pruned_tablet_arr_.count());
 
   OB_UNIS_VERSION(1);
 
@@ -262,6 +272,9 @@ private:
   // server B can hardly locate log in archive.
   int64_t progress_;
   int8_t flag_;
+  // The server skips LogGroupEntries which only carry redo of these tablets, see ObCdcLSFetchLogResp::PrunedGroup.
+  // An empty array means no pruning, which is also what servers and clients of older versions do.
+  TabletIDArray pruned_tablet_arr_;
 };
 
 // Statistics for LS
@@ -319,6 +332,38 @@ struct ObCdcFetchStatus
 class ObCdcLSFetchLogResp
 {
   static const int64_t CUR_RPC_VER = 1;
+public:
+  static const int64_t MAX_PRUNED_GROUP_CNT = 4096;
+  static const int64_t MAX_PRUNED_REDO_CNT = 16384;
+
+  // A LogGroupEntry skipped by the server because all its LogEntries are redo of pruned tablets (or it is
+  // a padding entry). It is not filled into log_entry_buf_, the client keeps the LSN continuity with it.
+  struct PrunedGroup
+  {
+    LSN lsn_;                 // start LSN of the LogGroupEntry
+    int64_t size_;            // serialize size of the LogGroupEntry
+    int64_t submit_ts_;       // scn of the LogGroupEntry
+    int64_t buf_pos_;         // position in log_entry_buf_ where the LogGroupEntry would have been filled
+    int64_t redo_cnt_;        // count of its redo in pruned_redo_arr_, which are stored in the order of groups
+
+    void reset();
+    TO_STRING_KV(K_(lsn), K_(size), K_(submit_ts), K_(buf_pos), K_(redo_cnt));
+    OB_UNIS_VERSION(1);
+  };
+  // A pruned redo LogEntry, the client still records it as fetched for the missing log check.
+  struct PrunedRedo
+  {
+    int64_t tx_id_;
+    int64_t cluster_id_;
+    LSN lsn_;                 // LSN of the LogEntry
+
+    void reset();
+    TO_STRING_KV(K_(tx_id), K_(cluster_id), K_(lsn));
+    OB_UNIS_VERSION(1);
+  };
+  typedef common::ObSEArray<PrunedGroup, 4> PrunedGroupArray;
+  typedef common::ObSEArray<PrunedRedo, 16> PrunedRedoArray;
+
 public:
   enum FeedbackType
   {
@@ -406,6 +451,19 @@ public:
     return pos_ >= 0 && pos_ <= FETCH_BUF_LEN;
   }
 
+  inline bool can_append_pruned_group(const int64_t redo_cnt) const
+  {
+    return pruned_group_arr_.count() < MAX_PRUNED_GROUP_CNT
+        && pruned_redo_arr_.count() + redo_cnt <= MAX_PRUNED_REDO_CNT;
+  }
+  // Record a LogGroupEntry skipped at current pos_, next_req_lsn_ is moved to the end of it.
+  int append_pruned_group(const LSN &lsn,
+      const int64_t size,
+      const int64_t submit_ts,
+      const common::ObIArray<PrunedRedo> &redo_arr);
+  const PrunedGroupArray &get_pruned_groups() const { return pruned_group_arr_; }
+  const PrunedRedoArray &get_pruned_redos() const { return pruned_redo_arr_; }
+
   TO_STRING_KV(
       K_(rpc_ver),
       K_(err),
@@ -415,7 +473,8 @@ public:
       K_(fetch_status),
       K_(next_req_lsn),
       K_(log_num),
-      K_(pos));
+      K_(pos),
+      "pruned_group_count", pruned_group_arr_.count());
   OB_UNIS_VERSION(1);
 
 private:
@@ -433,6 +492,8 @@ private:
   int64_t pos_;
   char log_entry_buf_[FETCH_BUF_LEN];
   int64_t server_progress_;
+  PrunedGroupArray pruned_group_arr_;
+  PrunedRedoArray pruned_redo_arr_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObCdcLSFetchLogResp);
@@ -31,6 +31,8 @@ int64_t ObCdcServiceMonitor::reach_max_log_pkey_count_;
 int64_t ObCdcServiceMonitor::need_fetch_pkey_count_;
 int64_t ObCdcServiceMonitor::scan_round_count_;
 int64_t ObCdcServiceMonitor::round_rate_;
+int64_t ObCdcServiceMonitor::pruned_size_;
+int64_t ObCdcServiceMonitor::pruned_log_count_;
 
 } // namespace cdc
 } // namespace oceanbase
@@ -40,6 +40,8 @@ public:
   inline static void need_fetch_pkey_count(const int64_t c) { (void)ATOMIC_AAF(&need_fetch_pkey_count_, c); }
   inline static void scan_round_count(const int64_t c) { (void)ATOMIC_AAF(&scan_round_count_, c); }
   inline static void round_rate(const int64_t rate) { (void)ATOMIC_AAF(&round_rate_, rate); }
+  inline static void pruned_size(const int64_t size) { (void)ATOMIC_AAF(&pruned_size_, size); }
+  inline static void pruned_log_count(const int64_t c) { (void)ATOMIC_AAF(&pruned_log_count_, c); }
 
   static void reset()
   {
@@ -58,6 +60,8 @@ public:
     ATOMIC_STORE(&need_fetch_pkey_count_, 0);
     ATOMIC_STORE(&scan_round_count_, 0);
     ATOMIC_STORE(&round_rate_, 0);
+    ATOMIC_STORE(&pruned_size_, 0);
+    ATOMIC_STORE(&pruned_log_count_, 0);
   }
 
   static void report()
@@ -70,12 +74,14 @@ public:
                 "l2s_time=%ld, svr_queue_time=%ld, fetch_time=%ld, "
                 "reach_upper_ts_pkey_count=%ld, "
                 "reach_max_log_pkey_count=%ld, need_fetch_pkey_count=%ld, "
-                "scan_round_count=%ld, round_rate=%ld",
+                "scan_round_count=%ld, round_rate=%ld, "
+                "pruned_size=%ld, pruned_log_count=%ld",
                 ATOMIC_LOAD(&locate_count_), ATOMIC_LOAD(&locate_time_),
                 ATOMIC_LOAD(&fetch_count_), ATOMIC_LOAD(&fetch_size_), ATOMIC_LOAD(&fetch_log_count_),
                 ATOMIC_LOAD(&l2s_time_), ATOMIC_LOAD(&svr_queue_time_), ATOMIC_LOAD(&fetch_time_),
                 ATOMIC_LOAD(&reach_upper_ts_pkey_count_), ATOMIC_LOAD(&reach_max_log_pkey_count_), ATOMIC_LOAD(&need_fetch_pkey_count_),
-                ATOMIC_LOAD(&scan_round_count_), round_rate);
+                ATOMIC_LOAD(&scan_round_count_), round_rate,
+                ATOMIC_LOAD(&pruned_size_), ATOMIC_LOAD(&pruned_log_count_));
 
     reset();
   }
@@ -102,6 +108,10 @@ private:
   static int64_t need_fetch_pkey_count_;
   static int64_t scan_round_count_;
   static int64_t round_rate_;
+
+  // LogGroupEntries skipped because they only carry redo of tablets pruned by the client
+  static int64_t pruned_size_; // bytes
+  static int64_t pruned_log_count_;
 };
 
 } // namespace cdc
@@ -27,6 +27,7 @@
 #include <fnmatch.h> // FNM_CASEFOLD
 #include <stdint.h>
 #include <map>
+#include <vector>
 #include "oblogmsg/LogRecord.h"
 typedef oceanbase::logmessage::ILogRecord ICDCRecord;
 
@@ -47,6 +48,54 @@ struct ObCDCError
 
 typedef void (* ERROR_CALLBACK) (const ObCDCError &err);
 
+/*
+ * Changes of one table in one transaction in binary columnar layout,
+ * output when enable_binary_columnar_output is enabled.
+ *
+ * Columns are in the order of the columns of the table meta of ICDCRecord. Each column has a new
+ * and an old image, filled the same way as new and old values of ICDCRecord, except that columns
+ * not in the log are not filled with their original default value.
+ * Bit i of a bitmap is (bitmap[i / 8] >> (i % 8)) & 1.
+ */
+class ICDCColumnarBatch
+{
+public:
+  enum ColumnType
+  {
+    COLUMN_INT64 = 0,   // int types, date, time, datetime and timestamp in internal representation
+    COLUMN_UINT64 = 1,  // unsigned int types, year, bit, enum and set
+    COLUMN_DOUBLE = 2,  // float and double
+    COLUMN_BYTES = 3,   // char, varchar, binary, varbinary and raw, in bytes of the column charset
+    COLUMN_TEXT = 4,    // other types, formatted as text the same as ICDCRecord
+  };
+
+  struct ColumnImage
+  {
+    const uint8_t *present_bitmap_; // set if the column is in the image of the row
+    const uint8_t *null_bitmap_;    // set if the value is NULL
+    const void *fixed_values_;      // int64_t/uint64_t/double array of COLUMN_INT64/UINT64/DOUBLE
+    const uint32_t *offsets_;       // value of row i is [offsets_[i], offsets_[i + 1]) of data_ for COLUMN_BYTES/TEXT
+    const char *data_;
+  };
+
+public:
+  virtual ~ICDCColumnarBatch() {}
+
+public:
+  virtual uint64_t get_table_id() const = 0;
+  virtual const char *get_db_name() const = 0;
+  virtual const char *get_table_name() const = 0;
+  virtual int64_t get_row_count() const = 0;
+  virtual int64_t get_column_count() const = 0;
+  // record type of rows: EINSERT, EUPDATE or EDELETE
+  virtual const int32_t *get_record_types() const = 0;
+  // sequence of rows in the transaction, over all batches of the transaction
+  virtual const int64_t *get_row_seqs() const = 0;
+  virtual const char *get_column_name(const int64_t column_idx) const = 0;
+  virtual ColumnType get_column_type(const int64_t column_idx) const = 0;
+  virtual int get_column_image(const int64_t column_idx, const bool is_old, ColumnImage &image) const = 0;
+};
+
 class IObCDCInstance
 {
 public:
@@ -114,6 +163,20 @@ public:
    */
   virtual void release_record(ICDCRecord *record) = 0;
 
+  /*
+   * get columnar batches of a transaction, valid until the record is released
+   * only for binary columnar output (enable_binary_columnar_output=1), in which DML records are
+   * not output and rows of the transaction are attached to its COMMIT record
+   * @param [in]  record        COMMIT record
+   * @param [out] batches       one batch for each table changed by the transaction
+   *
+   * @retval OB_SUCCESS         success
+   * @retval OB_NOT_SUPPORTED   binary columnar output is not enabled
+   * @retval other error code   fail
+   */
+  virtual int get_columnar_batches(ICDCRecord *record,
+      std::vector<const ICDCColumnarBatch *> &batches) = 0;
+
   /*
    * Launch libobcdc
    * @retval OB_SUCCESS on success
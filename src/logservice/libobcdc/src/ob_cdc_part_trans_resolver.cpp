@@ -226,6 +226,31 @@ int ObCDCPartTransResolver::read(
   return ret;
 }
 
+int ObCDCPartTransResolver::read_pruned_redo(
+    const int64_t tx_id,
+    const int64_t cluster_id,
+    const palf::LSN &lsn)
+{
+  int ret = OB_SUCCESS;
+  bool is_cluster_id_served = false;
+  PartTransTask *task = NULL;
+
+  if (OB_FAIL(cluster_id_filter_.check_is_served(cluster_id, is_cluster_id_served))) {
+    LOG_ERROR("check_cluster_id_served failed", KR(ret), K_(tls_id), K(lsn), K(cluster_id));
+  } else if (OB_UNLIKELY(!is_cluster_id_served)) {
+    LOG_DEBUG("[STAT] [FETCHER] [TRANS_NOT_SERVE]", K_(tls_id), K(is_cluster_id_served), K(lsn));
+  } else if (OB_FAIL(obtain_task_(transaction::ObTransID(tx_id), task, false/*is_resolving_miss_log*/))) {
+    LOG_ERROR("obtain_task_ fail", KR(ret), K_(tls_id), K(tx_id), K(lsn));
+  } else if (OB_FAIL(push_fetched_log_entry_(lsn, *task))) {
+    // redo of the log_entry is not needed, but the log_entry should be known to the check of missing redo
+    LOG_ERROR("push_fetched_log_entry failed", KR(ret), K_(tls_id), K(tx_id), K(lsn), KPC(task));
+  } else {
+    LOG_DEBUG("handle_pruned_redo", K_(tls_id), K(tx_id), K(lsn), KPC(task));
+  }
+
+  return ret;
+}
+
 int ObCDCPartTransResolver::dispatch(volatile bool &stop_flag, int64_t &pending_task_count)
 {
   int ret = OB_SUCCESS;
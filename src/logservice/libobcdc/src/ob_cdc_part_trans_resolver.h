@@ -157,6 +157,19 @@ public:
       MissingLogInfo &missing_log_info,
       TransStatInfo &tsi) = 0;
 
+  /// read redo log_entry pruned by server, which only contains data of filtered tablets
+  /// the log_entry is marked fetched for the trans without any redo pushed.
+  /// @param [in]   tx_id                 tx_id of the redo
+  /// @param [in]   cluster_id            org_cluster_id of the tx_log_block
+  /// @param [in]   lsn                   lsn of the log_entry
+  ///
+  /// @retval OB_SUCCESS          handle pruned redo success
+  /// @retval other_err_code      unexpected error
+  virtual int read_pruned_redo(
+      const int64_t tx_id,
+      const int64_t cluster_id,
+      const palf::LSN &lsn) = 0;
+
   /// dispatch ready PartTransTask. READY means:
   /// 1. Trans(DML/DDL) that already handle commit log and all redo of trans have persisted if working_mode is storage
   /// 2. all kinds of other type of PartTransTask(LS_HEARTBEAT/LS_OFFLINED/GLOBAL_HEARTBEAT)
@@ -216,6 +229,11 @@ public:
       MissingLogInfo &missing_log_info,
       TransStatInfo &tsi);
 
+  virtual int read_pruned_redo(
+      const int64_t tx_id,
+      const int64_t cluster_id,
+      const palf::LSN &lsn);
+
   virtual int dispatch(volatile bool &stop_flag, int64_t &pending_task_count);
 
   virtual int offline(volatile bool &stop_flag);
@@ -368,5 +368,46 @@ int TabletToTableInfo::remove_tablet_table_info(const common::ObTabletID &tablet
   return ret;
 }
 
+int TabletToTableInfo::get_index_tablets(
+    common::ObIArray<common::ObTabletID> &tablets,
+    const int64_t max_count) const
+{
+  int ret = OB_SUCCESS;
+  IndexTabletCollector collector(tablets, max_count);
+
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_ERROR("TabletIDToTableIDInfo is not inited", KR(ret), K_(is_inited));
+  } else if (OB_FAIL(const_cast<TabletToTableMap &>(tablet_to_table_map_).for_each(collector))) {
+    // OB_EAGAIN means the collector stops on max_count or on error
+    if (OB_EAGAIN == ret) {
+      ret = collector.ret_;
+    } else {
+      LOG_ERROR("tablet_to_table_map_ for_each failed", KR(ret), K_(tenant_id));
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+    LOG_ERROR("collect index tablets failed", KR(ret), K_(tenant_id), K(max_count));
+  }
+
+  return ret;
+}
+
+bool TabletToTableInfo::IndexTabletCollector::operator()(
+    const common::ObTabletID &tablet_id,
+    const ObCDCTableInfo &table_info)
+{
+  if (table_info.is_index_table()) {
+    if (tablets_.count() >= max_count_) {
+      // ignore the rest
+    } else if (OB_SUCCESS != (ret_ = tablets_.push_back(tablet_id))) {
+      LOG_ERROR_RET(ret_, "push_back index tablet failed", K(tablet_id), K(table_info));
+    }
+  }
+
+  return common::OB_SUCCESS == ret_ && tablets_.count() < max_count_;
+}
+
 } // namespace libobcdc
 } // namespace oceanbase
@@ -203,9 +203,30 @@ public:
   /// @retval OB_SUCCESS          remove success
   /// @retval other ERROR         remove fail
   int remove_tablet_table_info(const common::ObTabletID &tablet_id);
+
+  /// collect tablets of index tables, whose data is never output
+  ///
+  /// @param [out]  tablets       tablet_ids of index tables
+  /// @param [in]   max_count     max count of tablet_ids to collect, the rest are ignored
+  ///
+  /// @retval OB_SUCCESS          collect success
+  /// @retval other ERROR         unexpected error
+  int get_index_tablets(common::ObIArray<common::ObTabletID> &tablets, const int64_t max_count) const;
   // TODO: need support Tablet Transfer(wait OBServer imply)
 public:
   TO_STRING_KV(K_(tenant_id), K_(is_inited), "tablet_to_table_count", tablet_to_table_map_.count());
+private:
+  struct IndexTabletCollector
+  {
+    IndexTabletCollector(common::ObIArray<common::ObTabletID> &tablets, const int64_t max_count)
+      : ret_(common::OB_SUCCESS), tablets_(tablets), max_count_(max_count) {}
+    bool operator()(const common::ObTabletID &tablet_id, const ObCDCTableInfo &table_info);
+
+    int ret_;
+    common::ObIArray<common::ObTabletID> &tablets_;
+    int64_t max_count_;
+  };
+
 private:
   bool              is_inited_;
   uint64_t          tenant_id_;
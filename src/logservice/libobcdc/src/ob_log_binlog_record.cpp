@@ -18,6 +18,7 @@
 #include "ob_log_binlog_record.h"
 #include "ob_log_utils.h"
 #include "ob_log_instance.h"                  // TCTX
+#include "ob_log_columnar_batch.h"            // ObLogColumnarTransBatch
 
 using namespace oceanbase::common;
 
@@ -32,6 +33,8 @@ ObLogBR::ObLogBR() : ObLogResourceRecycleTask(ObLogResourceRecycleTask::BINLOG_R
                      data_(nullptr),
                      host_(nullptr),
                      stmt_task_(nullptr),
+                     columnar_row_(nullptr),
+                     columnar_trans_batch_(nullptr),
                      next_br_(nullptr),
                      valid_(true),
                      tenant_id_(OB_INVALID_TENANT_ID),
@@ -92,6 +95,11 @@ void ObLogBR::reset()
 
   host_ = nullptr;
   stmt_task_ = nullptr;
+  columnar_row_ = nullptr;
+  if (nullptr != columnar_trans_batch_) {
+    ObLogColumnarTransBatch::free(columnar_trans_batch_);
+    columnar_trans_batch_ = nullptr;
+  }
   next_br_ = nullptr;
   valid_ = true;
   tenant_id_ = OB_INVALID_TENANT_ID;
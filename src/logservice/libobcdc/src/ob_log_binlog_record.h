@@ -28,6 +28,8 @@ namespace oceanbase
 {
 namespace libobcdc
 {
+struct ObLogColumnarRow;
+class ObLogColumnarTransBatch;
 
 class ObLogBR : public ObLogResourceRecycleTask, public common::ObLink
 {
@@ -85,6 +87,12 @@ public:
   inline void *get_stmt_task() { return stmt_task_; }
   void set_stmt_task(void *stmt_task) { stmt_task_ = stmt_task; }
 
+  // binary columnar output: columnar row of DML record, columnar batches of COMMIT record
+  inline const ObLogColumnarRow *get_columnar_row() const { return columnar_row_; }
+  void set_columnar_row(const ObLogColumnarRow *columnar_row) { columnar_row_ = columnar_row; }
+  inline ObLogColumnarTransBatch *get_columnar_trans_batch() { return columnar_trans_batch_; }
+  void set_columnar_trans_batch(ObLogColumnarTransBatch *trans_batch) { columnar_trans_batch_ = trans_batch; }
+
   uint64_t get_tenant_id() const { return tenant_id_; }
   int64_t get_schema_version() const { return schema_version_; }
   uint64_t get_row_index() const { return row_index_; }
@@ -113,6 +121,8 @@ private:
   IBinlogRecord *data_;               ///< real BinlogRecord
   void          *host_;               ///< record corresponsding ObLogEntryTask
   void          *stmt_task_;          // StmtTask
+  const ObLogColumnarRow *columnar_row_;  // memory of the corresponding ObLogEntryTask
+  ObLogColumnarTransBatch *columnar_trans_batch_; // owned by the COMMIT record
   ObLogBR       *next_br_;
   bool          valid_;               ///< statement is valid or not
 
@@ -0,0 +1,624 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * Binary columnar output
+ */
+
+#define USING_LOG_PREFIX OBLOG
+
+#include "ob_log_columnar_batch.h"
+
+#include "lib/allocator/ob_malloc.h"    // ob_malloc
+#include "ob_log_binlog_record.h"       // ObLogBR
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace libobcdc
+{
+static const char *COLUMNAR_LABEL = "CDCColumnar";
+
+////////////////////////////////////// ObLogColumnarBuffer //////////////////////////////////////
+
+void ObLogColumnarBuffer::destroy()
+{
+  if (NULL != buf_) {
+    ob_free(buf_);
+    buf_ = NULL;
+  }
+  len_ = 0;
+  capacity_ = 0;
+}
+
+int ObLogColumnarBuffer::reserve_(const int64_t len)
+{
+  int ret = OB_SUCCESS;
+
+  if (len > capacity_) {
+    int64_t new_capacity = std::max(capacity_, MIN_CAPACITY);
+    char *new_buf = NULL;
+
+    while (new_capacity < len) {
+      new_capacity *= 2;
+    }
+
+    if (OB_ISNULL(new_buf = static_cast<char *>(ob_malloc(new_capacity, COLUMNAR_LABEL)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_ERROR("allocate memory for columnar buffer fail", KR(ret), K(new_capacity), K(len));
+    } else {
+      if (NULL != buf_) {
+        MEMCPY(new_buf, buf_, len_);
+        ob_free(buf_);
+      }
+      buf_ = new_buf;
+      capacity_ = new_capacity;
+    }
+  }
+
+  return ret;
+}
+
+int ObLogColumnarBuffer::append(const void *data, const int64_t len)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(len < 0) || OB_UNLIKELY(len > 0 && NULL == data)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("invalid argument", KR(ret), K(data), K(len));
+  } else if (len > 0) {
+    if (OB_FAIL(reserve_(len_ + len))) {
+      LOG_ERROR("reserve columnar buffer fail", KR(ret), K(len), KPC(this));
+    } else {
+      MEMCPY(buf_ + len_, data, len);
+      len_ += len;
+    }
+  }
+
+  return ret;
+}
+
+int ObLogColumnarBuffer::append_bit(const int64_t pos, const bool bit)
+{
+  int ret = OB_SUCCESS;
+  const int64_t byte_idx = pos / 8;
+
+  if (byte_idx >= len_) {
+    const uint8_t zero = 0;
+    if (OB_FAIL(append(&zero, sizeof(zero)))) {
+      LOG_ERROR("append bitmap byte fail", KR(ret), K(pos), KPC(this));
+    }
+  }
+
+  if (OB_SUCC(ret) && bit) {
+    buf_[byte_idx] = static_cast<char>(static_cast<uint8_t>(buf_[byte_idx]) | (1 << (pos % 8)));
+  }
+
+  return ret;
+}
+
+////////////////////////////////////// ObLogColumnarBatch //////////////////////////////////////
+
+void ObLogColumnarBatch::Image::destroy()
+{
+  present_bitmap_.destroy();
+  null_bitmap_.destroy();
+  fixed_values_.destroy();
+  offsets_.destroy();
+  data_.destroy();
+}
+
+void ObLogColumnarBatch::Column::destroy()
+{
+  if (NULL != name_) {
+    ob_free(name_);
+    name_ = NULL;
+  }
+  new_image_.destroy();
+  old_image_.destroy();
+}
+
+ObLogColumnarBatch::ObLogColumnarBatch() :
+    inited_(false),
+    table_id_(OB_INVALID_ID),
+    db_name_(NULL),
+    table_name_(NULL),
+    column_cnt_(0),
+    row_cnt_(0),
+    columns_(NULL),
+    record_types_(),
+    row_seqs_()
+{
+}
+
+ObLogColumnarBatch::~ObLogColumnarBatch()
+{
+  destroy();
+}
+
+ICDCColumnarBatch::ColumnType ObLogColumnarBatch::get_column_type(const ObObjType obj_type)
+{
+  ColumnType type = COLUMN_TEXT;
+
+  switch (ob_obj_type_class(obj_type)) {
+    case ObIntTC:
+    case ObDateTC:
+    case ObTimeTC:
+    case ObDateTimeTC:
+      type = COLUMN_INT64;
+      break;
+    case ObUIntTC:
+    case ObYearTC:
+    case ObBitTC:
+    case ObEnumSetTC:
+      type = COLUMN_UINT64;
+      break;
+    case ObFloatTC:
+    case ObDoubleTC:
+      type = COLUMN_DOUBLE;
+      break;
+    case ObStringTC:
+    case ObRawTC:
+      type = COLUMN_BYTES;
+      break;
+    default:
+      type = COLUMN_TEXT;
+      break;
+  }
+
+  return type;
+}
+
+int ObLogColumnarBatch::copy_str_(const char *src, char *&dst)
+{
+  int ret = OB_SUCCESS;
+  const int64_t len = (NULL == src) ? 0 : strlen(src);
+
+  if (OB_ISNULL(dst = static_cast<char *>(ob_malloc(len + 1, COLUMNAR_LABEL)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_ERROR("allocate memory for string fail", KR(ret), K(len));
+  } else {
+    if (len > 0) {
+      MEMCPY(dst, src, len);
+    }
+    dst[len] = '\0';
+  }
+
+  return ret;
+}
+
+int ObLogColumnarBatch::init(const ObLogColumnarRow &row,
+    const char *db_name,
+    const char *table_name,
+    ITableMeta *table_meta)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_ERROR("ObLogColumnarBatch init twice", KR(ret), KPC(this));
+  } else if (OB_UNLIKELY(row.column_cnt_ <= 0) || OB_ISNULL(row.column_types_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("invalid argument", KR(ret), K(row));
+  } else if (OB_FAIL(copy_str_(db_name, db_name_))) {
+    LOG_ERROR("copy db_name fail", KR(ret), KCSTRING(db_name));
+  } else if (OB_FAIL(copy_str_(table_name, table_name_))) {
+    LOG_ERROR("copy table_name fail", KR(ret), KCSTRING(table_name));
+  } else if (OB_FAIL(init_columns_(row, table_meta))) {
+    LOG_ERROR("init_columns_ fail", KR(ret), K(row));
+  } else {
+    table_id_ = row.table_id_;
+    row_cnt_ = 0;
+    inited_ = true;
+  }
+
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+
+  return ret;
+}
+
+int ObLogColumnarBatch::init_columns_(const ObLogColumnarRow &row, ITableMeta *table_meta)
+{
+  int ret = OB_SUCCESS;
+  const int64_t column_cnt = row.column_cnt_;
+  const int64_t alloc_size = column_cnt * sizeof(Column);
+  const uint32_t zero_offset = 0;
+
+  if (OB_ISNULL(columns_ = static_cast<Column *>(ob_malloc(alloc_size, COLUMNAR_LABEL)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_ERROR("allocate memory for columns fail", KR(ret), K(column_cnt));
+  } else {
+    for (int64_t idx = 0; idx < column_cnt; idx++) {
+      new (columns_ + idx) Column();
+      columns_[idx].type_ = row.column_types_[idx];
+      columns_[idx].name_ = NULL;
+    }
+    column_cnt_ = column_cnt;
+
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < column_cnt; idx++) {
+      Column &column = columns_[idx];
+      IColMeta *col_meta = (NULL == table_meta) ? NULL : table_meta->getCol(static_cast<int>(idx));
+
+      if (OB_FAIL(copy_str_(NULL == col_meta ? NULL : col_meta->getName(), column.name_))) {
+        LOG_ERROR("copy column name fail", KR(ret), K(idx));
+      } else if (COLUMN_BYTES == column.type_ || COLUMN_TEXT == column.type_) {
+        // offsets start with 0
+        if (OB_FAIL(column.new_image_.offsets_.append(&zero_offset, sizeof(zero_offset)))) {
+          LOG_ERROR("append offset fail", KR(ret), K(idx));
+        } else if (OB_FAIL(column.old_image_.offsets_.append(&zero_offset, sizeof(zero_offset)))) {
+          LOG_ERROR("append offset fail", KR(ret), K(idx));
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+
+void ObLogColumnarBatch::destroy()
+{
+  if (NULL != columns_) {
+    for (int64_t idx = 0; idx < column_cnt_; idx++) {
+      columns_[idx].destroy();
+      columns_[idx].~Column();
+    }
+    ob_free(columns_);
+    columns_ = NULL;
+  }
+  if (NULL != db_name_) {
+    ob_free(db_name_);
+    db_name_ = NULL;
+  }
+  if (NULL != table_name_) {
+    ob_free(table_name_);
+    table_name_ = NULL;
+  }
+  record_types_.destroy();
+  row_seqs_.destroy();
+  table_id_ = OB_INVALID_ID;
+  column_cnt_ = 0;
+  row_cnt_ = 0;
+  inited_ = false;
+}
+
+bool ObLogColumnarBatch::is_compatible(const ObLogColumnarRow &row) const
+{
+  bool bool_ret = inited_ && row.table_id_ == table_id_ && row.column_cnt_ == column_cnt_;
+
+  for (int64_t idx = 0; bool_ret && idx < column_cnt_; idx++) {
+    bool_ret = (row.column_types_[idx] == columns_[idx].type_);
+  }
+
+  return bool_ret;
+}
+
+int ObLogColumnarBatch::append(const ObLogColumnarRow &row, const int64_t row_seq)
+{
+  int ret = OB_SUCCESS;
+  const int32_t record_type = static_cast<int32_t>(row.record_type_);
+
+  if (OB_UNLIKELY(! inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_ERROR("ObLogColumnarBatch not init", KR(ret));
+  } else if (OB_UNLIKELY(! is_compatible(row))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("row is not compatible with batch", KR(ret), K(row), KPC(this));
+  } else if (OB_FAIL(record_types_.append(&record_type, sizeof(record_type)))) {
+    LOG_ERROR("append record type fail", KR(ret), K(row));
+  } else if (OB_FAIL(row_seqs_.append(&row_seq, sizeof(row_seq)))) {
+    LOG_ERROR("append row seq fail", KR(ret), K(row_seq));
+  } else {
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < column_cnt_; idx++) {
+      Column &column = columns_[idx];
+
+      if (OB_FAIL(append_value_(column.type_, row.new_values_[idx], column.new_image_))) {
+        LOG_ERROR("append new value fail", KR(ret), K(idx), K(row));
+      } else if (OB_FAIL(append_value_(column.type_, row.old_values_[idx], column.old_image_))) {
+        LOG_ERROR("append old value fail", KR(ret), K(idx), K(row));
+      }
+    }
+
+    if (OB_SUCC(ret)) {
+      row_cnt_++;
+    }
+  }
+
+  return ret;
+}
+
+int ObLogColumnarBatch::get_fixed_value_(const ColumnType type, const ObObj &obj, int64_t &value) const
+{
+  int ret = OB_SUCCESS;
+  value = 0;
+
+  switch (obj.get_type_class()) {
+    case ObIntTC:
+      value = obj.get_int();
+      break;
+    case ObDateTC:
+      value = obj.get_date();
+      break;
+    case ObTimeTC:
+      value = obj.get_time();
+      break;
+    case ObDateTimeTC:
+      value = obj.get_datetime();
+      break;
+    case ObUIntTC:
+      value = static_cast<int64_t>(obj.get_uint64());
+      break;
+    case ObYearTC:
+      value = static_cast<int64_t>(obj.get_year());
+      break;
+    case ObBitTC:
+    case ObEnumSetTC:
+      value = static_cast<int64_t>(obj.get_uint64());
+      break;
+    case ObFloatTC: {
+      const double double_value = static_cast<double>(obj.get_float());
+      MEMCPY(&value, &double_value, sizeof(value));
+      break;
+    }
+    case ObDoubleTC: {
+      const double double_value = obj.get_double();
+      MEMCPY(&value, &double_value, sizeof(value));
+      break;
+    }
+    default:
+      ret = OB_ERR_UNEXPECTED;
+      break;
+  }
+
+  if (OB_SUCC(ret) && type != get_column_type(obj.get_type())) {
+    ret = OB_ERR_UNEXPECTED;
+  }
+
+  if (OB_FAIL(ret)) {
+    LOG_ERROR("value does not match column type", KR(ret), K(type), K(obj));
+  }
+
+  return ret;
+}
+
+int ObLogColumnarBatch::append_value_(const ColumnType type, const ObLogColumnarValue &value, Image &image)
+{
+  int ret = OB_SUCCESS;
+  const bool is_present = value.is_present();
+  bool is_null = false;
+  int64_t fixed_value = 0;
+  ObString var_value;
+
+  if (is_present) {
+    if (COLUMN_TEXT == type) {
+      // text value is formatted by ObObj2strHelper, NULL value has no buffer
+      if (OB_ISNULL(value.str_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_ERROR("text value is not formatted", KR(ret), K(type));
+      } else if (NULL == value.str_->ptr()) {
+        is_null = true;
+      } else {
+        var_value = *value.str_;
+      }
+    } else if (OB_ISNULL(value.obj_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_ERROR("typed value is NULL", KR(ret), K(type));
+    } else if (value.obj_->is_null()) {
+      is_null = true;
+    } else if (COLUMN_BYTES == type) {
+      var_value = value.obj_->get_string();
+    } else if (OB_FAIL(get_fixed_value_(type, *value.obj_, fixed_value))) {
+      LOG_ERROR("get_fixed_value_ fail", KR(ret), K(type));
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(image.present_bitmap_.append_bit(row_cnt_, is_present))) {
+    LOG_ERROR("append present bit fail", KR(ret), K(row_cnt_));
+  } else if (OB_FAIL(image.null_bitmap_.append_bit(row_cnt_, is_null))) {
+    LOG_ERROR("append null bit fail", KR(ret), K(row_cnt_));
+  } else if (COLUMN_BYTES == type || COLUMN_TEXT == type) {
+    const int64_t end_offset = image.data_.get_length() + var_value.length();
+
+    if (OB_UNLIKELY(end_offset > UINT32_MAX)) {
+      ret = OB_SIZE_OVERFLOW;
+      LOG_ERROR("columnar data exceeds the offset limit", KR(ret), K(end_offset), KPC(this));
+    } else {
+      const uint32_t offset = static_cast<uint32_t>(end_offset);
+
+      if (OB_FAIL(image.data_.append(var_value.ptr(), var_value.length()))) {
+        LOG_ERROR("append data fail", KR(ret), K(var_value.length()));
+      } else if (OB_FAIL(image.offsets_.append(&offset, sizeof(offset)))) {
+        LOG_ERROR("append offset fail", KR(ret), K(offset));
+      }
+    }
+  } else if (OB_FAIL(image.fixed_values_.append(&fixed_value, sizeof(fixed_value)))) {
+    LOG_ERROR("append fixed value fail", KR(ret), K(fixed_value));
+  }
+
+  return ret;
+}
+
+const char *ObLogColumnarBatch::get_column_name(const int64_t column_idx) const
+{
+  const char *name = NULL;
+
+  if (column_idx >= 0 && column_idx < column_cnt_) {
+    name = columns_[column_idx].name_;
+  }
+
+  return name;
+}
+
+ICDCColumnarBatch::ColumnType ObLogColumnarBatch::get_column_type(const int64_t column_idx) const
+{
+  ColumnType type = COLUMN_TEXT;
+
+  if (column_idx >= 0 && column_idx < column_cnt_) {
+    type = columns_[column_idx].type_;
+  }
+
+  return type;
+}
+
+int ObLogColumnarBatch::get_column_image(const int64_t column_idx, const bool is_old, ColumnImage &image) const
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(! inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_ERROR("ObLogColumnarBatch not init", KR(ret));
+  } else if (OB_UNLIKELY(column_idx < 0 || column_idx >= column_cnt_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("invalid column idx", KR(ret), K(column_idx), KPC(this));
+  } else {
+    const Image &src = is_old ? columns_[column_idx].old_image_ : columns_[column_idx].new_image_;
+
+    image.present_bitmap_ = reinterpret_cast<const uint8_t *>(src.present_bitmap_.get_data());
+    image.null_bitmap_ = reinterpret_cast<const uint8_t *>(src.null_bitmap_.get_data());
+    image.fixed_values_ = src.fixed_values_.get_data();
+    image.offsets_ = reinterpret_cast<const uint32_t *>(src.offsets_.get_data());
+    image.data_ = src.data_.get_data();
+  }
+
+  return ret;
+}
+
+////////////////////////////////////// ObLogColumnarTransBatch //////////////////////////////////////
+
+ObLogColumnarTransBatch::ObLogColumnarTransBatch() :
+    batches_(),
+    last_batch_(NULL),
+    row_cnt_(0)
+{
+}
+
+ObLogColumnarTransBatch::~ObLogColumnarTransBatch()
+{
+  destroy();
+}
+
+int ObLogColumnarTransBatch::alloc(ObLogColumnarTransBatch *&trans_batch)
+{
+  int ret = OB_SUCCESS;
+  void *buf = NULL;
+
+  if (OB_ISNULL(buf = ob_malloc(sizeof(ObLogColumnarTransBatch), COLUMNAR_LABEL))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_ERROR("allocate memory for ObLogColumnarTransBatch fail", KR(ret));
+  } else {
+    trans_batch = new (buf) ObLogColumnarTransBatch();
+  }
+
+  return ret;
+}
+
+void ObLogColumnarTransBatch::free(ObLogColumnarTransBatch *trans_batch)
+{
+  if (NULL != trans_batch) {
+    trans_batch->~ObLogColumnarTransBatch();
+    ob_free(trans_batch);
+    trans_batch = NULL;
+  }
+}
+
+void ObLogColumnarTransBatch::destroy()
+{
+  for (int64_t idx = 0; idx < batches_.count(); idx++) {
+    ObLogColumnarBatch *batch = batches_.at(idx);
+
+    if (NULL != batch) {
+      batch->~ObLogColumnarBatch();
+      ob_free(batch);
+    }
+  }
+  batches_.reset();
+  last_batch_ = NULL;
+  row_cnt_ = 0;
+}
+
+int ObLogColumnarTransBatch::append(ObLogBR &br)
+{
+  int ret = OB_SUCCESS;
+  const ObLogColumnarRow *row = br.get_columnar_row();
+  ObLogColumnarBatch *batch = NULL;
+
+  if (OB_ISNULL(row)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("binlog record has no columnar row", KR(ret), K(br));
+  } else if (OB_FAIL(get_batch_(br, *row, batch))) {
+    LOG_ERROR("get_batch_ fail", KR(ret), KPC(row));
+  } else if (OB_FAIL(batch->append(*row, row_cnt_))) {
+    LOG_ERROR("append row into columnar batch fail", KR(ret), KPC(row), KPC(batch));
+  } else {
+    row_cnt_++;
+  }
+
+  return ret;
+}
+
+int ObLogColumnarTransBatch::get_batch_(ObLogBR &br, const ObLogColumnarRow &row, ObLogColumnarBatch *&batch)
+{
+  int ret = OB_SUCCESS;
+  batch = NULL;
+
+  // rows of a table are mostly continuous in a transaction
+  if (NULL != last_batch_ && last_batch_->is_compatible(row)) {
+    batch = last_batch_;
+  }
+
+  for (int64_t idx = batches_.count() - 1; NULL == batch && idx >= 0; idx--) {
+    if (batches_.at(idx)->is_compatible(row)) {
+      batch = batches_.at(idx);
+    }
+  }
+
+  if (NULL == batch) {
+    IBinlogRecord *br_data = br.get_data();
+    ITableMeta *table_meta = NULL;
+    void *buf = NULL;
+
+    if (OB_ISNULL(br_data)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_ERROR("binlog record data is NULL", KR(ret), K(br));
+    } else if (0 != br_data->getTableMeta(table_meta)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_ERROR("getTableMeta fail", KR(ret), K(br));
+    } else if (OB_ISNULL(buf = ob_malloc(sizeof(ObLogColumnarBatch), COLUMNAR_LABEL))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_ERROR("allocate memory for ObLogColumnarBatch fail", KR(ret));
+    } else {
+      batch = new (buf) ObLogColumnarBatch();
+
+      if (OB_FAIL(batch->init(row, br_data->dbname(), br_data->tbname(), table_meta))) {
+        LOG_ERROR("init columnar batch fail", KR(ret), K(row));
+      } else if (OB_FAIL(batches_.push_back(batch))) {
+        LOG_ERROR("push back columnar batch fail", KR(ret), K(row));
+      }
+
+      if (OB_FAIL(ret)) {
+        batch->~ObLogColumnarBatch();
+        ob_free(batch);
+        batch = NULL;
+      }
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    last_batch_ = batch;
+  }
+
+  return ret;
+}
+
+} // namespace libobcdc
+} // namespace oceanbase
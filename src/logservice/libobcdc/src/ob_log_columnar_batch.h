@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * Binary columnar output
+ * 1. Formatter builds ObLogColumnarRow of a DML binlog record, which references the typed values
+ *    of the row instead of strings converted by ObObj2strHelper
+ * 2. Committer appends rows of a transaction into ObLogColumnarTransBatch, one ObLogColumnarBatch
+ *    for each table, and attaches it to the COMMIT binlog record
+ */
+
+#ifndef OCEANBASE_LIBOBCDC_COLUMNAR_BATCH_H__
+#define OCEANBASE_LIBOBCDC_COLUMNAR_BATCH_H__
+
+#include "libobcdc.h"                     // ICDCColumnarBatch
+#include "ob_cdc_msg_convert.h"           // ITableMeta
+#include "common/object/ob_object.h"      // ObObj
+#include "lib/container/ob_se_array.h"    // ObSEArray
+#include "lib/string/ob_string.h"         // ObString
+#include "lib/utility/ob_print_utils.h"   // TO_STRING_KV
+
+namespace oceanbase
+{
+namespace libobcdc
+{
+class ObLogBR;
+
+// Value of a column in a row image
+// obj_ is set for columns of fixed width and bytes types, str_ is set for text types
+// Both are NULL if the column is not in the image
+struct ObLogColumnarValue
+{
+  const common::ObObj *obj_;
+  const common::ObString *str_;
+
+  bool is_present() const { return NULL != obj_ || NULL != str_; }
+};
+
+// Typed values of a DML row, memory is allocated from the redo log entry task of the row,
+// so that it is valid until the binlog record of the row is reverted
+struct ObLogColumnarRow
+{
+  uint64_t table_id_;
+  int record_type_;                                   // EINSERT, EUPDATE or EDELETE
+  int64_t column_cnt_;
+  ICDCColumnarBatch::ColumnType *column_types_;
+  ObLogColumnarValue *new_values_;
+  ObLogColumnarValue *old_values_;
+
+  TO_STRING_KV(K_(table_id), K_(record_type), K_(column_cnt));
+};
+
+// Growable buffer of a column image
+class ObLogColumnarBuffer
+{
+public:
+  ObLogColumnarBuffer() : buf_(NULL), len_(0), capacity_(0) {}
+  ~ObLogColumnarBuffer() { destroy(); }
+  void destroy();
+
+  int append(const void *data, const int64_t len);
+  // append a bit at bit position pos, bits are appended in order
+  int append_bit(const int64_t pos, const bool bit);
+
+  const char *get_data() const { return buf_; }
+  int64_t get_length() const { return len_; }
+
+  TO_STRING_KV(KP_(buf), K_(len), K_(capacity));
+
+private:
+  int reserve_(const int64_t len);
+
+private:
+  static const int64_t MIN_CAPACITY = 256;
+
+  char *buf_;
+  int64_t len_;
+  int64_t capacity_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObLogColumnarBuffer);
+};
+
+class ObLogColumnarBatch : public ICDCColumnarBatch
+{
+public:
+  ObLogColumnarBatch();
+  virtual ~ObLogColumnarBatch();
+
+public:
+  // column names are copied from table_meta, which may be NULL
+  int init(const ObLogColumnarRow &row,
+      const char *db_name,
+      const char *table_name,
+      ITableMeta *table_meta);
+  void destroy();
+
+  // rows of the same table may be in different batches if the table schema is changed in the transaction
+  bool is_compatible(const ObLogColumnarRow &row) const;
+  int append(const ObLogColumnarRow &row, const int64_t row_seq);
+
+  // Type of column in the batch, types without binary representation are output as text
+  static ColumnType get_column_type(const common::ObObjType obj_type);
+  static bool is_binary_type(const common::ObObjType obj_type) { return COLUMN_TEXT != get_column_type(obj_type); }
+
+public:
+  virtual uint64_t get_table_id() const { return table_id_; }
+  virtual const char *get_db_name() const { return db_name_; }
+  virtual const char *get_table_name() const { return table_name_; }
+  virtual int64_t get_row_count() const { return row_cnt_; }
+  virtual int64_t get_column_count() const { return column_cnt_; }
+  virtual const int32_t *get_record_types() const
+  { return reinterpret_cast<const int32_t *>(record_types_.get_data()); }
+  virtual const int64_t *get_row_seqs() const
+  { return reinterpret_cast<const int64_t *>(row_seqs_.get_data()); }
+  virtual const char *get_column_name(const int64_t column_idx) const;
+  virtual ColumnType get_column_type(const int64_t column_idx) const;
+  virtual int get_column_image(const int64_t column_idx, const bool is_old, ColumnImage &image) const;
+
+public:
+  TO_STRING_KV(K_(table_id), KCSTRING_(db_name), KCSTRING_(table_name), K_(column_cnt), K_(row_cnt));
+
+private:
+  struct Image
+  {
+    ObLogColumnarBuffer present_bitmap_;
+    ObLogColumnarBuffer null_bitmap_;
+    ObLogColumnarBuffer fixed_values_;
+    ObLogColumnarBuffer offsets_;
+    ObLogColumnarBuffer data_;
+
+    void destroy();
+  };
+
+  struct Column
+  {
+    ColumnType type_;
+    char *name_;
+    Image new_image_;
+    Image old_image_;
+
+    void destroy();
+  };
+
+private:
+  int init_columns_(const ObLogColumnarRow &row, ITableMeta *table_meta);
+  int append_value_(const ColumnType type, const ObLogColumnarValue &value, Image &image);
+  int get_fixed_value_(const ColumnType type, const common::ObObj &obj, int64_t &value) const;
+  static int copy_str_(const char *src, char *&dst);
+
+private:
+  bool inited_;
+  uint64_t table_id_;
+  char *db_name_;
+  char *table_name_;
+  int64_t column_cnt_;
+  int64_t row_cnt_;
+  Column *columns_;
+  ObLogColumnarBuffer record_types_;
+  ObLogColumnarBuffer row_seqs_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObLogColumnarBatch);
+};
+
+// Columnar batches of a transaction, owned by the COMMIT binlog record of the transaction
+class ObLogColumnarTransBatch
+{
+public:
+  ObLogColumnarTransBatch();
+  ~ObLogColumnarTransBatch();
+
+public:
+  static int alloc(ObLogColumnarTransBatch *&trans_batch);
+  static void free(ObLogColumnarTransBatch *trans_batch);
+
+  // append the columnar row of a DML binlog record
+  int append(ObLogBR &br);
+  int64_t get_batch_count() const { return batches_.count(); }
+  int64_t get_row_count() const { return row_cnt_; }
+  const ICDCColumnarBatch *get_batch(const int64_t idx) const { return batches_.at(idx); }
+  void destroy();
+
+  TO_STRING_KV(K_(row_cnt), "batch_count", batches_.count());
+
+private:
+  int get_batch_(ObLogBR &br, const ObLogColumnarRow &row, ObLogColumnarBatch *&batch);
+
+private:
+  common::ObSEArray<ObLogColumnarBatch *, 4> batches_;
+  ObLogColumnarBatch *last_batch_;
+  int64_t row_cnt_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObLogColumnarTransBatch);
+};
+
+} // namespace libobcdc
+} // namespace oceanbase
+#endif
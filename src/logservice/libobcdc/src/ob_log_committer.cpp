@@ -29,6 +29,7 @@
 #include "ob_log_binlog_record_pool.h"  // IObLogBRPool
 #include "ob_log_config.h"              // ObLogConfig
 #include "ob_log_tenant_mgr.h"          // IObLogTenantMgr
+#include "ob_log_columnar_batch.h"      // ObLogColumnarTransBatch
 
 #define _STAT(level, fmt, args...) _OBLOG_COMMITTER_LOG(level, "[STAT] [COMMITTER] " fmt, ##args)
 #define STAT(level, fmt, args...) OBLOG_COMMITTER_LOG(level, "[STAT] [COMMITTER] " fmt, ##args)
@@ -87,7 +88,8 @@ ObLogCommitter::ObLogCommitter() :
     global_heartbeat_info_queue_(),
     dml_part_trans_task_count_(0),
     ddl_part_trans_task_count_(0),
-    dml_trans_count_(0)
+    dml_trans_count_(0),
+    enable_binary_columnar_output_(false)
 {
 }
 
@@ -138,10 +140,11 @@ int ObLogCommitter::init(const int64_t start_seq,
     dml_part_trans_task_count_ = 0;
     ddl_part_trans_task_count_ = 0;
     dml_trans_count_ = 0;
+    enable_binary_columnar_output_ = (0 != TCONF.enable_binary_columnar_output);
     stop_flag_ = true;
     inited_ = true;
 
-    LOG_INFO("init committer succ", K(start_seq));
+    LOG_INFO("init committer succ", K(start_seq), K_(enable_binary_columnar_output));
   }
 
   return ret;
@@ -174,6 +177,7 @@ void ObLogCommitter::destroy()
   dml_part_trans_task_count_ = 0;
   ddl_part_trans_task_count_ = 0;
   dml_trans_count_ = 0;
+  enable_binary_columnar_output_ = false;
 }
 
 int ObLogCommitter::start()
@@ -1262,6 +1266,7 @@ int ObLogCommitter::commit_binlog_record_list_(TransCtx &trans_ctx,
   } else {
     ObLogBR *begin_br = NULL;
     ObLogBR *commit_br = NULL;
+    ObLogColumnarTransBatch *columnar_trans_batch = NULL;
     const uint64_t row_index = 0;
     const int64_t ddl_schema_version = 0;
 
@@ -1311,6 +1316,16 @@ int ObLogCommitter::commit_binlog_record_list_(TransCtx &trans_ctx,
           } else {
             LOG_ERROR("next_ready_br_task_ fail", KR(ret), KPC(br_task));
           }
+        } else if (enable_binary_columnar_output_) {
+          // rows are output in columnar batches attached to COMMIT
+          br_task->set_next(NULL);
+          if (OB_FAIL(commit_columnar_br_(br_task, columnar_trans_batch))) {
+            if (OB_IN_STOP_STATE != ret) {
+              LOG_ERROR("commit_columnar_br_ fail", KR(ret), K(br_task));
+            }
+          } else {
+            trans_ctx.inc_committed_br_count();
+          }
         } else {
           // Single br down, next reset to NULL
           br_task->set_next(NULL);
@@ -1326,6 +1341,12 @@ int ObLogCommitter::commit_binlog_record_list_(TransCtx &trans_ctx,
 
       // push commit br to commit
       if (OB_SUCC(ret)) {
+        if (NULL != columnar_trans_batch) {
+          // COMMIT owns the columnar batches
+          commit_br->set_columnar_trans_batch(columnar_trans_batch);
+          columnar_trans_batch = NULL;
+        }
+
         if (OB_FAIL(push_br_queue_(commit_br))) {
           if (OB_IN_STOP_STATE != ret) {
             LOG_ERROR("push_br_queue_ fail", KR(ret), K(commit_br));
@@ -1349,6 +1370,11 @@ int ObLogCommitter::commit_binlog_record_list_(TransCtx &trans_ctx,
       }
     }
 
+    if (NULL != columnar_trans_batch) {
+      ObLogColumnarTransBatch::free(columnar_trans_batch);
+      columnar_trans_batch = NULL;
+    }
+
     LOG_DEBUG("commit_binlog_record_list", KR(ret), K(trans_id), K(trans_id_str), K(trans_commit_version), K(cluster_id),
         K(tenant_id), K(ddl_schema_version), K(trace_id), K(unique_id),
         K(row_index), K(part_trans_task_count), K(trans_ctx));
@@ -1357,6 +1383,34 @@ int ObLogCommitter::commit_binlog_record_list_(TransCtx &trans_ctx,
   return ret;
 }
 
+int ObLogCommitter::commit_columnar_br_(ObLogBR *br, ObLogColumnarTransBatch *&trans_batch)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_ISNULL(br)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("invalid argument", KR(ret), K(br));
+  } else if (NULL == br->get_columnar_row()) {
+    // row without columns is not output
+  } else if (NULL == trans_batch && OB_FAIL(ObLogColumnarTransBatch::alloc(trans_batch))) {
+    LOG_ERROR("alloc columnar trans batch fail", KR(ret));
+  } else if (OB_FAIL(trans_batch->append(*br))) {
+    LOG_ERROR("append binlog record into columnar trans batch fail", KR(ret), KPC(br), KPC(trans_batch));
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(revert_binlog_record_(br))) {
+    // values are copied into the batch, the row can be recycled now
+    if (OB_IN_STOP_STATE != ret) {
+      LOG_ERROR("revert_binlog_record_ fail", KR(ret), K(br));
+    }
+  } else {
+    br = NULL;
+  }
+
+  return ret;
+}
+
 int ObLogCommitter::next_ready_br_task_(TransCtx &trans_ctx, ObLogBR *&br_task)
 {
   int ret = OB_SUCCESS;
@@ -73,6 +73,7 @@ class IObLogTransCtxMgr;
 class IObLogTransStatMgr;
 class DdlStmtTask;
 class IObLogBRPool;
+class ObLogColumnarTransBatch;
 
 class ObLogCommitter : public IObLogCommitter
 {
@@ -153,6 +154,8 @@ private:
       const uint64_t tenant_id,
       const int64_t trans_commit_version);
   int push_br_queue_(ObLogBR *br);
+  // binary columnar output: append DML binlog record into columnar batches of the transaction and revert it
+  int commit_columnar_br_(ObLogBR *br, ObLogColumnarTransBatch *&trans_batch);
   int handle_offline_checkpoint_task_(CheckpointTask &task);
   int recycle_task_directly_(PartTransTask &task, const bool can_async_recycle = true);
   int record_global_heartbeat_info_(PartTransTask &task);
@@ -250,6 +253,8 @@ private:
   int64_t                   ddl_part_trans_task_count_;
   int64_t                   dml_trans_count_;
 
+  bool                      enable_binary_columnar_output_;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(ObLogCommitter);
 };
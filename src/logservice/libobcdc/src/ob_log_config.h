@@ -172,6 +172,12 @@ public:
   DEF_INT(binlog_record_prealloc_count, OB_CLUSTER_PARAMETER, "100000", "[1,]", "binlog record pre-alloc count");
 
   DEF_STR(store_service_path, OB_CLUSTER_PARAMETER, "./storage", "store sevice path");
+  // Store service of stored transaction data
+  // 1. rocksdb by default
+  // 2. When configured on, data is appended to segment files and read back sequentially,
+  //    without key-value puts and compaction of rocksdb
+  T_DEF_BOOL(enable_file_store_service, OB_CLUSTER_PARAMETER, 0, "0:rocksdb, 1:append-only segment file");
+  DEF_CAP(file_store_segment_size, OB_CLUSTER_PARAMETER, "256MB", "[16MB,]", "segment file size of file store service");
 
   // Whether to do ob version compatibility check
   // default value '0:not_skip'
@@ -227,7 +233,16 @@ public:
   // libobcdc support multiple working mode, default is storage
   // 1. storage: transaction data is stored, can support large transactions
   // 2. memory: transaction data is not stored, it means better performance, but may can not support large transactions
+  // 3. auto: transaction data is kept in memory until its size exceeds auto_mode_redo_spill_threshold,
+  //    the following data of the transaction is stored, so that only large transactions are spilled
   DEF_STR(working_mode, OB_CLUSTER_PARAMETER, "storage", "libocdc working mode");
+  DEF_CAP(auto_mode_redo_spill_threshold, OB_CLUSTER_PARAMETER, "16MB", "[0,]",
+      "redo size of a transaction kept in memory in auto working mode");
+  // Whether to output DML in binary columnar layout, only supported in memory working mode
+  // 1. off by default, each DML is output as a record with values formatted as string
+  // 2. When configured on, DML of a transaction is output as ICDCColumnarBatch attached to its COMMIT record,
+  //    values of int, float, date/time and char types are output in binary without string conversion
+  T_DEF_BOOL(enable_binary_columnar_output, OB_CLUSTER_PARAMETER, 0, "0:disabled, 1:enabled");
   // libobcdc support multiple meta_data_refresh_mode, default is data_dict
   // 1. data_dict: through the log of meta data
   // 2. online: through the schema service
@@ -372,6 +387,13 @@ public:
   // No printing by default
   T_DEF_BOOL(print_rpc_handle_info, OB_CLUSTER_PARAMETER, 0, "0:disabled, 1:enabled");
   T_DEF_BOOL(print_stream_dispatch_info, OB_CLUSTER_PARAMETER, 0, "0:disabled, 1:enabled");
+  // Experimental: whether to carry tablets of index tables in fetch log requests, the server skips
+  // log groups that only contain redo of these tablets.
+  // Only redo of index tablets is pruned, tables filtered out by tb_white_list/tb_black_list
+  // are still fetched and dropped by the parser.
+  // Disabled by default
+  T_DEF_BOOL(enable_fetch_log_tablet_filter, OB_CLUSTER_PARAMETER, 0,
+      "experimental, 0:disabled, 1:enabled, only redo of index tablets is pruned by the server");
 
   // ------------------------------------------------------------------------
   // Print logstream heartbeat information
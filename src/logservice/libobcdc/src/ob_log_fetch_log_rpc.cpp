@@ -456,6 +456,7 @@ int FetchLogARpc::async_fetch_log(
     const palf::LSN &req_start_lsn,
     const int64_t client_progress,
     const int64_t upper_limit,
+    const common::ObIArray<common::ObTabletID> &pruned_tablets,
     bool &rpc_send_succeed)
 {
   int ret = OB_SUCCESS;
@@ -478,6 +479,9 @@ int FetchLogARpc::async_fetch_log(
     LOG_ERROR("RPC is flying, can not launch async fetch log request",
         K(cur_req_->rpc_is_flying()), KPC(cur_req_));
     ret = OB_INVALID_ERROR;
+  }
+  else if (OB_FAIL(cur_req_->req_.set_pruned_tablets(pruned_tablets))) {
+    LOG_ERROR("set pruned tablets fail", KR(ret), "pruned_tablet_count", pruned_tablets.count());
   }
     // Initiating asynchronous requests
   else if (OB_FAIL(launch_async_rpc_(*cur_req_, req_start_lsn, client_progress, upper_limit, false, rpc_send_succeed))) {
@@ -209,10 +209,12 @@ public:
   // 2. The success of the RPC is returned using the rpc_send_succeed parameter
   // 3. if the RPC fails, the result will be generated immediately, you can use next_result() to iterate through the results
   // 4. If the RPC succeeds, you need to wait for the asynchronous callback to set the result
+  // 5. pruned_tablets are kept by the request and carried by the following RPCs launched in callback
   int async_fetch_log(
       const palf::LSN &req_start_lsn,
       const int64_t client_progress,
       const int64_t upper_limit,
+      const common::ObIArray<common::ObTabletID> &pruned_tablets,
       bool &rpc_send_succeed);
 
   /// Discard the current request and wait for the end of the asynchronous RPC
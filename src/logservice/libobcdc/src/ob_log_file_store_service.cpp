@@ -0,0 +1,629 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX OBLOG_STORAGER
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "ob_log_file_store_service.h"
+#include "ob_log_utils.h"                   // SIZE_TO_STR
+#include "ob_log_config.h"                  // TCONF
+#include "lib/file/file_directory_utils.h"  // FileDirectoryUtils
+#include "lib/oblog/ob_log_module.h"        // LOG_*
+#include "lib/ob_errno.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace libobcdc
+{
+ObLogFileStoreService::ObLogFileStoreService() :
+    is_inited_(false),
+    is_stopped_(true),
+    path_(),
+    segment_size_(0),
+    default_cf_(NULL),
+    cf_list_lock_(),
+    next_cf_id_(0),
+    cf_list_()
+{
+}
+
+ObLogFileStoreService::~ObLogFileStoreService()
+{
+  destroy();
+}
+
+int ObLogFileStoreService::init(const std::string &path)
+{
+  int ret = OB_SUCCESS;
+  void *default_cf_handle = NULL;
+
+  if (OB_UNLIKELY(is_inited_)) {
+    LOG_ERROR("ObLogFileStoreService has inited twice");
+    ret = OB_INIT_TWICE;
+  } else if (OB_FAIL(init_dir_(path.c_str()))) {
+    LOG_ERROR("init_dir_ fail", KR(ret));
+  } else {
+    path_ = path;
+    segment_size_ = TCONF.file_store_segment_size.get();
+    is_stopped_ = false;
+
+    if (OB_FAIL(create_column_family("default", default_cf_handle))) {
+      LOG_ERROR("create default column family fail", KR(ret));
+    } else {
+      default_cf_ = static_cast<ColumnFamily *>(default_cf_handle);
+      is_inited_ = true;
+      LOG_INFO("ObLogFileStoreService init success", "path", path_.c_str(), K_(segment_size));
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::init_dir_(const char *dir_path)
+{
+  int ret = OB_SUCCESS;
+  bool is_exist = false;
+
+  if (OB_FAIL(FileDirectoryUtils::is_exists(dir_path, is_exist))) {
+    LOG_ERROR("FileDirectoryUtils is_exists fail", KR(ret), K(dir_path));
+  } else if (is_exist && OB_FAIL(FileDirectoryUtils::delete_directory_rec(dir_path))) {
+    LOG_ERROR("FileDirectoryUtils delete_directory_rec fail", KR(ret), K(dir_path));
+  } else if (OB_FAIL(FileDirectoryUtils::create_full_path(dir_path))) {
+    LOG_ERROR("FileDirectoryUtils create_full_path fail", KR(ret), K(dir_path));
+  } else {
+    // succ
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::close()
+{
+  mark_stop_flag();
+  LOG_INFO("file store service close succ");
+  return OB_SUCCESS;
+}
+
+void ObLogFileStoreService::destroy()
+{
+  if (is_inited_) {
+    LOG_INFO("file store service destroy begin");
+    close();
+
+    for (int64_t idx = 0; idx < cf_list_.size(); ++idx) {
+      ColumnFamily *cf = cf_list_[idx];
+
+      if (NULL != cf) {
+        clear_column_family_(*cf);
+        delete cf;
+      }
+    }
+
+    cf_list_.clear();
+    default_cf_ = NULL;
+    next_cf_id_ = 0;
+    segment_size_ = 0;
+    is_inited_ = false;
+    LOG_INFO("file store service destroy end");
+  }
+}
+
+int ObLogFileStoreService::put(const std::string &key, const ObSlice &value)
+{
+  return put(default_cf_, key, value);
+}
+
+int ObLogFileStoreService::put(void *cf_handle, const std::string &key, const ObSlice &value)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+  Segment *segment = NULL;
+  int64_t offset = 0;
+
+  if (OB_ISNULL(cf)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_ERR_UNEXPECTED;
+  } else if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else if (OB_FAIL(reserve_(*cf, value.buf_len_, 1, segment, offset))) {
+    LOG_ERROR("reserve_ fail", KR(ret), "cf", cf->name_.c_str(), "len", value.buf_len_);
+  } else if (OB_FAIL(write_(*segment, offset, value.buf_, value.buf_len_))) {
+    LOG_ERROR("write_ fail", KR(ret), "cf", cf->name_.c_str(), "key", key.c_str(), K(offset));
+    ObSpinLockGuard guard(cf->lock_);
+    release_segment_(*cf, segment);
+  } else {
+    Location location;
+    location.segment_ = segment;
+    location.offset_ = offset;
+    location.len_ = value.buf_len_;
+
+    ObSpinLockGuard guard(cf->lock_);
+    insert_location_(*cf, key, location);
+  }
+
+  return ret;
+}
+
+// values of the batch are appended contiguously
+int ObLogFileStoreService::batch_write(void *cf_handle,
+    const std::vector<std::string> &keys,
+    const std::vector<ObSlice> &values)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+  const int64_t value_cnt = values.size();
+  int64_t total_len = 0;
+  Segment *segment = NULL;
+  int64_t offset = 0;
+
+  for (int64_t idx = 0; idx < value_cnt; ++idx) {
+    total_len += values[idx].buf_len_;
+  }
+
+  if (OB_ISNULL(cf)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_ERR_UNEXPECTED;
+  } else if (OB_UNLIKELY(keys.size() != value_cnt)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("key count not match value count", KR(ret), "key_cnt", keys.size(), K(value_cnt));
+  } else if (0 == value_cnt) {
+    // do nothing
+  } else if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else if (OB_FAIL(reserve_(*cf, total_len, value_cnt, segment, offset))) {
+    LOG_ERROR("reserve_ fail", KR(ret), "cf", cf->name_.c_str(), K(total_len), K(value_cnt));
+  } else {
+    int64_t pos = offset;
+
+    for (int64_t idx = 0; OB_SUCC(ret) && !is_stopped() && idx < value_cnt; ++idx) {
+      if (OB_FAIL(write_(*segment, pos, values[idx].buf_, values[idx].buf_len_))) {
+        LOG_ERROR("write_ fail", KR(ret), "cf", cf->name_.c_str(), "key", keys[idx].c_str(), K(pos));
+      } else {
+        pos += values[idx].buf_len_;
+      }
+    }
+
+    if (OB_SUCC(ret) && is_stopped()) {
+      ret = OB_IN_STOP_STATE;
+    }
+
+    ObSpinLockGuard guard(cf->lock_);
+    if (OB_FAIL(ret)) {
+      release_segment_(*cf, segment, value_cnt);
+    } else {
+      Location location;
+      location.segment_ = segment;
+      location.offset_ = offset;
+
+      for (int64_t idx = 0; idx < value_cnt; ++idx) {
+        location.len_ = values[idx].buf_len_;
+        insert_location_(*cf, keys[idx], location);
+        location.offset_ += location.len_;
+      }
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::get(const std::string &key, std::string &value)
+{
+  return get(default_cf_, key, value);
+}
+
+int ObLogFileStoreService::get(void *cf_handle, const std::string &key, std::string &value)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+  Location location;
+  location.segment_ = NULL;
+
+  if (OB_ISNULL(cf)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_ERR_UNEXPECTED;
+  } else if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else {
+    ObSpinLockGuard guard(cf->lock_);
+    LocationMap::const_iterator iter = cf->locations_.find(key);
+
+    if (cf->locations_.end() == iter) {
+      ret = OB_ENTRY_NOT_EXIST;
+      LOG_ERROR("key not exist in file store", KR(ret), "cf", cf->name_.c_str(), "key", key.c_str());
+    } else {
+      location = iter->second;
+      // hold the segment until read finished
+      ++location.segment_->ref_cnt_;
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    value.resize(location.len_);
+
+    if (location.len_ > 0 && OB_FAIL(read_(*location.segment_, location.offset_, &value[0], location.len_))) {
+      LOG_ERROR("read_ fail", KR(ret), "cf", cf->name_.c_str(), "key", key.c_str(),
+          "offset", location.offset_, "len", location.len_);
+    }
+
+    ObSpinLockGuard guard(cf->lock_);
+    release_segment_(*cf, location.segment_);
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::del(const std::string &key)
+{
+  return del(default_cf_, key);
+}
+
+int ObLogFileStoreService::del(void *cf_handle, const std::string &key)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+
+  if (OB_ISNULL(cf)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("column_family_handle is NULL", KR(ret));
+  } else if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else {
+    ObSpinLockGuard guard(cf->lock_);
+    LocationMap::iterator iter = cf->locations_.find(key);
+
+    // same as rocksdb, delete a key not exist is not an error
+    if (cf->locations_.end() != iter) {
+      erase_location_(*cf, iter);
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::del_range(void *cf_handle, const std::string &begin_key, const std::string &end_key)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+
+  if (OB_ISNULL(cf)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_ERR_UNEXPECTED;
+  } else if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else {
+    ObSpinLockGuard guard(cf->lock_);
+    LocationMap::iterator iter = cf->locations_.lower_bound(begin_key);
+
+    while (cf->locations_.end() != iter && iter->first < end_key) {
+      erase_location_(*cf, iter);
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::create_column_family(const std::string& column_family_name,
+    void *&cf_handle)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = NULL;
+
+  if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else if (OB_ISNULL(cf = new(std::nothrow) ColumnFamily())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_ERROR("construct ColumnFamily fail", KR(ret), "column_family_name", column_family_name.c_str());
+  } else {
+    ObSpinLockGuard guard(cf_list_lock_);
+    cf->id_ = next_cf_id_++;
+    cf->name_ = column_family_name;
+    cf->active_segment_ = NULL;
+    cf->next_segment_id_ = 0;
+    cf->segment_count_ = 0;
+    cf->data_size_ = 0;
+    cf->is_dropped_ = false;
+    cf_list_.push_back(cf);
+    cf_handle = reinterpret_cast<void *>(cf);
+
+    LOG_INFO("file store create column family succ", "column_family_name", column_family_name.c_str(),
+        "cf_id", cf->id_, K(cf_handle));
+  }
+
+  return ret;
+}
+
+// values and segment files are removed at once, memory of column family is freed in destory_column_family
+int ObLogFileStoreService::drop_column_family(void *cf_handle)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+
+  if (OB_ISNULL(cf)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_INVALID_ARGUMENT;
+  } else if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else {
+    clear_column_family_(*cf);
+    LOG_INFO("file store drop column family succ", "column_family_name", cf->name_.c_str(), "cf_id", cf->id_);
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::destory_column_family(void *cf_handle)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+
+  if (OB_ISNULL(cf)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_INVALID_ARGUMENT;
+  } else if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else {
+    bool found = false;
+    {
+      ObSpinLockGuard guard(cf_list_lock_);
+      for (std::vector<ColumnFamily *>::iterator iter = cf_list_.begin(); ! found && iter != cf_list_.end(); ++iter) {
+        if (cf == *iter) {
+          cf_list_.erase(iter);
+          found = true;
+        }
+      }
+    }
+
+    if (OB_UNLIKELY(! found)) {
+      ret = OB_ENTRY_NOT_EXIST;
+      LOG_ERROR("column family not exist", KR(ret), K(cf_handle));
+    } else {
+      LOG_INFO("file store destroy column family succ", "column_family_name", cf->name_.c_str(), "cf_id", cf->id_);
+      clear_column_family_(*cf);
+      delete cf;
+      cf = NULL;
+    }
+  }
+
+  return ret;
+}
+
+void ObLogFileStoreService::get_mem_usage(const std::vector<uint64_t> ids,
+    const std::vector<void *> cf_handles)
+{
+  int64_t total_key_count = 0;
+  int64_t total_segment_count = 0;
+  int64_t total_data_size = 0;
+
+  for (int64_t idx = 0; !is_stopped() && idx < cf_handles.size(); ++idx) {
+    ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handles[idx]);
+
+    if (OB_ISNULL(cf)) {
+      LOG_ERROR_RET(OB_INVALID_ARGUMENT, "column_family_handle is NULL");
+    } else {
+      int64_t key_count = 0;
+      int64_t segment_count = 0;
+      int64_t data_size = 0;
+      {
+        ObSpinLockGuard guard(cf->lock_);
+        key_count = cf->locations_.size();
+        segment_count = cf->segment_count_;
+        data_size = cf->data_size_;
+      }
+
+      total_key_count += key_count;
+      total_segment_count += segment_count;
+      total_data_size += data_size;
+
+      LOG_INFO("[FILE_STORE] [USAGE]", "tenant_id", ids[idx], K(key_count), K(segment_count),
+          "data_size", SIZE_TO_STR(data_size));
+    }
+  } // for
+
+  LOG_INFO("[FILE_STORE] [TOTAL_USAGE]", K(total_key_count), K(total_segment_count),
+      "data_size", SIZE_TO_STR(total_data_size));
+}
+
+int ObLogFileStoreService::reserve_(ColumnFamily &cf,
+    const int64_t len,
+    const int64_t value_cnt,
+    Segment *&segment,
+    int64_t &offset)
+{
+  int ret = OB_SUCCESS;
+  ObSpinLockGuard guard(cf.lock_);
+  Segment *active_segment = cf.active_segment_;
+
+  if (OB_UNLIKELY(cf.is_dropped_)) {
+    ret = OB_STATE_NOT_MATCH;
+    LOG_ERROR("column family is dropped", KR(ret), "cf", cf.name_.c_str());
+  } else {
+    // a value larger than segment size is written into a segment alone
+    if (NULL != active_segment
+        && active_segment->write_pos_ > 0
+        && active_segment->write_pos_ + len > segment_size_) {
+      active_segment->is_sealed_ = true;
+      cf.active_segment_ = NULL;
+
+      if (0 == active_segment->ref_cnt_) {
+        remove_segment_(cf, active_segment);
+      }
+    }
+
+    if (NULL == cf.active_segment_ && OB_FAIL(open_segment_(cf, cf.active_segment_))) {
+      LOG_ERROR("open_segment_ fail", KR(ret), "cf", cf.name_.c_str());
+    } else {
+      segment = cf.active_segment_;
+      offset = segment->write_pos_;
+      segment->write_pos_ += len;
+      segment->ref_cnt_ += value_cnt;
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::open_segment_(ColumnFamily &cf, Segment *&segment)
+{
+  int ret = OB_SUCCESS;
+  std::string segment_path;
+  int fd = -1;
+  segment = NULL;
+  get_segment_path_(cf, cf.next_segment_id_, segment_path);
+
+  if (OB_UNLIKELY((fd = ::open(segment_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)) < 0)) {
+    ret = OB_IO_ERROR;
+    LOG_ERROR("open segment file fail", KR(ret), "path", segment_path.c_str(), K(errno));
+  } else if (OB_ISNULL(segment = new(std::nothrow) Segment())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_ERROR("construct Segment fail", KR(ret), "path", segment_path.c_str());
+    (void)::close(fd);
+    (void)::unlink(segment_path.c_str());
+  } else {
+    // values are read back in the order they are appended
+    (void)::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    segment->fd_ = fd;
+    segment->id_ = cf.next_segment_id_++;
+    segment->write_pos_ = 0;
+    segment->ref_cnt_ = 0;
+    segment->is_sealed_ = false;
+    ++cf.segment_count_;
+    LOG_DEBUG("open segment succ", "path", segment_path.c_str(), "segment_id", segment->id_);
+  }
+
+  return ret;
+}
+
+void ObLogFileStoreService::release_segment_(ColumnFamily &cf, Segment *segment, const int64_t cnt)
+{
+  if (NULL != segment) {
+    segment->ref_cnt_ -= cnt;
+
+    if (segment->is_sealed_ && 0 == segment->ref_cnt_) {
+      remove_segment_(cf, segment);
+    }
+  }
+}
+
+void ObLogFileStoreService::remove_segment_(ColumnFamily &cf, Segment *segment)
+{
+  if (NULL != segment) {
+    std::string segment_path;
+    get_segment_path_(cf, segment->id_, segment_path);
+    (void)::close(segment->fd_);
+    (void)::unlink(segment_path.c_str());
+    --cf.segment_count_;
+    LOG_DEBUG("remove segment succ", "path", segment_path.c_str(), "segment_id", segment->id_);
+    delete segment;
+  }
+}
+
+void ObLogFileStoreService::insert_location_(ColumnFamily &cf, const std::string &key, const Location &location)
+{
+  LocationMap::iterator iter = cf.locations_.find(key);
+
+  // value of a key is overwritten by put, same as rocksdb
+  if (cf.locations_.end() != iter) {
+    erase_location_(cf, iter);
+  }
+
+  cf.locations_.insert(std::make_pair(key, location));
+  cf.data_size_ += location.len_;
+}
+
+void ObLogFileStoreService::erase_location_(ColumnFamily &cf, LocationMap::iterator &iter)
+{
+  Segment *segment = iter->second.segment_;
+  cf.data_size_ -= iter->second.len_;
+  iter = cf.locations_.erase(iter);
+  release_segment_(cf, segment);
+}
+
+int ObLogFileStoreService::write_(const Segment &segment, const int64_t offset, const char *buf, const int64_t len)
+{
+  int ret = OB_SUCCESS;
+  int64_t write_len = 0;
+
+  while (OB_SUCC(ret) && write_len < len) {
+    const ssize_t size = ::pwrite(segment.fd_, buf + write_len, len - write_len, offset + write_len);
+
+    if (size < 0) {
+      if (EINTR != errno) {
+        ret = OB_IO_ERROR;
+        LOG_ERROR("pwrite segment fail", KR(ret), "segment_id", segment.id_, K(offset), K(len), K(errno));
+      }
+    } else {
+      write_len += size;
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::read_(const Segment &segment, const int64_t offset, char *buf, const int64_t len)
+{
+  int ret = OB_SUCCESS;
+  int64_t read_len = 0;
+
+  while (OB_SUCC(ret) && read_len < len) {
+    const ssize_t size = ::pread(segment.fd_, buf + read_len, len - read_len, offset + read_len);
+
+    if (size < 0) {
+      if (EINTR != errno) {
+        ret = OB_IO_ERROR;
+        LOG_ERROR("pread segment fail", KR(ret), "segment_id", segment.id_, K(offset), K(len), K(errno));
+      }
+    } else if (0 == size) {
+      ret = OB_IO_ERROR;
+      LOG_ERROR("pread segment reach end of file", KR(ret), "segment_id", segment.id_, K(offset), K(len), K(read_len));
+    } else {
+      read_len += size;
+    }
+  }
+
+  return ret;
+}
+
+void ObLogFileStoreService::get_segment_path_(const ColumnFamily &cf, const int64_t segment_id, std::string &path) const
+{
+  path.assign(path_);
+  path.append("/");
+  path.append(std::to_string(cf.id_));
+  path.append(".");
+  path.append(std::to_string(segment_id));
+}
+
+void ObLogFileStoreService::clear_column_family_(ColumnFamily &cf)
+{
+  ObSpinLockGuard guard(cf.lock_);
+  LocationMap::iterator iter = cf.locations_.begin();
+
+  while (cf.locations_.end() != iter) {
+    erase_location_(cf, iter);
+  }
+
+  if (NULL != cf.active_segment_) {
+    Segment *active_segment = cf.active_segment_;
+    active_segment->is_sealed_ = true;
+    cf.active_segment_ = NULL;
+
+    if (0 == active_segment->ref_cnt_) {
+      remove_segment_(cf, active_segment);
+    }
+  }
+
+  cf.is_dropped_ = true;
+}
+
+}
+}
@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * OBCDC Storage based on append-only spill files
+ *
+ * 1. Values of a column family are appended to segment files of the column family, and located by an
+ *    in-memory index, no compaction or write amplification as rocksdb
+ * 2. Redo of a transaction is appended in log order, so that it is read back sequentially when the
+ *    transaction is dispatched
+ * 3. A sealed segment file is removed once all values in it are deleted
+ */
+
+#ifndef OCEANBASE_LIBOBCDC_OB_LOG_FILE_STORE_SERVICE_H_
+#define OCEANBASE_LIBOBCDC_OB_LOG_FILE_STORE_SERVICE_H_
+
+#include <map>
+#include "ob_log_store_service.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/lock/ob_spin_lock.h"        // ObSpinLock
+
+namespace oceanbase
+{
+namespace libobcdc
+{
+class ObLogFileStoreService : public IObStoreService
+{
+public:
+  ObLogFileStoreService();
+  virtual ~ObLogFileStoreService();
+  int init(const std::string &path);
+  void destroy();
+
+public:
+  virtual int put(const std::string &key, const ObSlice &value);
+  virtual int put(void *cf_handle, const std::string &key, const ObSlice &value);
+
+  virtual int batch_write(void *cf_handle, const std::vector<std::string> &keys, const std::vector<ObSlice> &values);
+
+  virtual int get(const std::string &key, std::string &value);
+  virtual int get(void *cf_handle, const std::string &key, std::string &value);
+
+  virtual int del(const std::string &key);
+  virtual int del(void *cf_handle, const std::string &key);
+  virtual int del_range(void *cf_handle, const std::string &begin_key, const std::string &end_key);
+
+  virtual int create_column_family(const std::string& column_family_name,
+      void *&cf_handle);
+  virtual int drop_column_family(void *cf_handle);
+  virtual int destory_column_family(void *cf_handle);
+
+  virtual void mark_stop_flag() override { ATOMIC_SET(&is_stopped_, true); }
+  virtual int close() override;
+  virtual void get_mem_usage(const std::vector<uint64_t> ids,
+      const std::vector<void *> cf_handles);
+  OB_INLINE bool is_stopped() const { return ATOMIC_LOAD(&is_stopped_); }
+
+private:
+  struct Segment
+  {
+    int fd_;
+    int64_t id_;
+    int64_t write_pos_;
+    // values in the segment and writes or reads in progress
+    int64_t ref_cnt_;
+    // no more value is appended
+    bool is_sealed_;
+  };
+
+  struct Location
+  {
+    Segment *segment_;
+    int64_t offset_;
+    int64_t len_;
+  };
+
+  typedef std::map<std::string, Location> LocationMap;
+
+  struct ColumnFamily
+  {
+    int64_t id_;                // segment files are named by id of column family and segment
+    std::string name_;
+    common::ObSpinLock lock_;
+    Segment *active_segment_;
+    int64_t next_segment_id_;
+    int64_t segment_count_;
+    int64_t data_size_;
+    LocationMap locations_;
+    bool is_dropped_;
+  };
+
+private:
+  int init_dir_(const char *dir_path);
+  // reserve len bytes in the active segment for value_cnt values, rotate the segment if it's full
+  int reserve_(ColumnFamily &cf, const int64_t len, const int64_t value_cnt,
+      Segment *&segment, int64_t &offset);
+  int open_segment_(ColumnFamily &cf, Segment *&segment);
+  // NOTE: cf.lock_ should be held
+  void release_segment_(ColumnFamily &cf, Segment *segment, const int64_t cnt = 1);
+  void remove_segment_(ColumnFamily &cf, Segment *segment);
+  void insert_location_(ColumnFamily &cf, const std::string &key, const Location &location);
+  void erase_location_(ColumnFamily &cf, LocationMap::iterator &iter);
+  int write_(const Segment &segment, const int64_t offset, const char *buf, const int64_t len);
+  int read_(const Segment &segment, const int64_t offset, char *buf, const int64_t len);
+  void get_segment_path_(const ColumnFamily &cf, const int64_t segment_id, std::string &path) const;
+  // remove all values and segment files of the column family
+  void clear_column_family_(ColumnFamily &cf);
+
+private:
+  bool is_inited_;
+  bool is_stopped_;
+  std::string path_;
+  int64_t segment_size_;
+  ColumnFamily *default_cf_;
+  common::ObSpinLock cf_list_lock_;
+  int64_t next_cf_id_;
+  std::vector<ColumnFamily *> cf_list_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObLogFileStoreService);
+};
+
+}
+}
+
+#endif
@@ -36,6 +36,7 @@
 #include "ob_cdc_lob_aux_meta_storager.h"    // ObCDCLobAuxMetaStorager
 #include "ob_cdc_lob_aux_table_parse.h"    // ObCDCLobAuxMetaStorager
 #include "ob_cdc_udt.h"                  // ObCDCUdtValueBuilder
+#include "ob_log_columnar_batch.h"      // ObLogColumnarRow
 
 using namespace oceanbase::common;
 using namespace oceanbase::storage;
@@ -58,6 +59,9 @@ void ObLogFormatter::RowValue::reset()
   (void)memset(new_columns_, 0, sizeof(new_columns_));
   (void)memset(old_columns_, 0, sizeof(old_columns_));
   (void)memset(orig_default_value_, 0, sizeof(orig_default_value_));
+  (void)memset(new_objs_, 0, sizeof(new_objs_));
+  (void)memset(old_objs_, 0, sizeof(old_objs_));
+  tb_schema_info_ = NULL;
   (void)memset(is_rowkey_, 0, sizeof(is_rowkey_));
   (void)memset(is_changed_, 0, sizeof(is_changed_));
 }
@@ -73,6 +77,8 @@ int ObLogFormatter::RowValue::init(const int64_t column_num, const bool contain_
     (void)memset(new_columns_, 0, column_num * sizeof(new_columns_[0]));
     (void)memset(old_columns_, 0, column_num * sizeof(old_columns_[0]));
     (void)memset(orig_default_value_, 0, column_num * sizeof(orig_default_value_[0]));
+    (void)memset(new_objs_, 0, column_num * sizeof(new_objs_[0]));
+    (void)memset(old_objs_, 0, column_num * sizeof(old_objs_[0]));
     (void)memset(is_rowkey_, 0, column_num * sizeof(is_rowkey_[0]));
     (void)memset(is_changed_, 0, column_num * sizeof(is_changed_[0]));
   }
@@ -96,6 +102,7 @@ ObLogFormatter::ObLogFormatter() : inited_(false),
                                    hbase_util_(NULL),
                                    skip_hbase_mode_put_column_count_not_consistency_(false),
                                    enable_output_hidden_primary_key_(false),
+                                   enable_binary_columnar_output_(false),
                                    log_entry_task_count_(0),
                                    stmt_in_lob_merger_count_(0)
 
@@ -157,11 +164,12 @@ int ObLogFormatter::init(const int64_t thread_num,
     hbase_util_ = &hbase_util;
     skip_hbase_mode_put_column_count_not_consistency_ = skip_hbase_mode_put_column_count_not_consistency;
     enable_output_hidden_primary_key_ = enable_output_hidden_primary_key;
+    enable_binary_columnar_output_ = (0 != TCONF.enable_binary_columnar_output);
     log_entry_task_count_ = 0;
     stmt_in_lob_merger_count_ = 0;
     inited_ = true;
     LOG_INFO("Formatter init succ", K(working_mode_), "working_mode", print_working_mode(working_mode_),
-        K(thread_num), K(queue_size));
+        K(thread_num), K(queue_size), K_(enable_binary_columnar_output));
   }
 
   return ret;
@@ -189,6 +197,7 @@ void ObLogFormatter::destroy()
   hbase_util_ = NULL;
   skip_hbase_mode_put_column_count_not_consistency_ = false;
   enable_output_hidden_primary_key_ = false;
+  enable_binary_columnar_output_ = false;
   log_entry_task_count_ = 0;
   stmt_in_lob_merger_count_ = 0;
 }
@@ -755,6 +764,9 @@ int ObLogFormatter::format_row_(
         dml_stmt_task.get_dml_flag(),
         &table_schema))) {
       LOG_ERROR("build_binlog_record_ fail", KR(ret), K(br), K(row_value), K(new_column_cnt), K(dml_stmt_task));
+    } else if (enable_binary_columnar_output_ && br.is_valid()
+        && OB_FAIL(build_columnar_row_(br, row_value, dml_stmt_task))) {
+      LOG_ERROR("build_columnar_row_ fail", KR(ret), K(br), K(row_value), K(dml_stmt_task));
     } else {
       if (OB_NOT_NULL(br.get_data())
           && OB_UNLIKELY(SRC_FULL_RECORDED != br.get_data()->getSrcCategory())) {
@@ -1127,7 +1139,7 @@ int ObLogFormatter::build_row_value_(
               *tb_schema_info))) {
         LOG_ERROR("fill_rowkey_cols_ fail", KR(ret), K(rv), KPC(rowkey_cols),
             "stmt_task", *stmt_task, K(simple_table_schema));
-      } else if (OB_FAIL(fill_orig_default_value_(rv, simple_table_schema, *tb_schema_info,
+      } else if (! enable_binary_columnar_output_ && OB_FAIL(fill_orig_default_value_(rv, simple_table_schema, *tb_schema_info,
               stmt_task->get_redo_log_entry_task().get_allocator()))) {
         LOG_ERROR("fill_orig_default_value_ fail", KR(ret), K(rv), K(simple_table_schema));
       } else {
@@ -1144,6 +1156,7 @@ int ObLogFormatter::build_row_value_(
         } else {
           rv->new_column_array_ = new_column_array;
           rv->old_column_array_ = old_column_array;
+          rv->tb_schema_info_ = tb_schema_info;
         }
       }
     } else {
@@ -1280,6 +1293,7 @@ int ObLogFormatter::fill_normal_cols_(
         } else if (is_new_value) {
           if (! cv->is_out_row_) {
             rv->new_columns_[usr_column_idx] = &cv->string_value_;
+            rv->new_objs_[usr_column_idx] = &cv->value_;
           } else {
             ObString *new_col_str = nullptr;
             if (OB_FAIL(lob_ctx_cols.get_lob_column_value(column_id, true/*is_new_col*/, new_col_str))) {
@@ -1316,6 +1330,7 @@ int ObLogFormatter::fill_normal_cols_(
         } else {
           if (! cv->is_out_row_) {
             rv->old_columns_[usr_column_idx] = &cv->string_value_;
+            rv->old_objs_[usr_column_idx] = &cv->value_;
           } else {
             ObString *old_col_str = nullptr;
             if (OB_FAIL(lob_ctx_cols.get_lob_column_value(column_id, false/*is_new_col*/, old_col_str))) {
@@ -1406,6 +1421,7 @@ int ObLogFormatter::fill_rowkey_cols_(
         // If the primary key column has been modified, the value after the modification is used, otherwise the value before the modification is used
         if (NULL == rv->new_columns_[rowkey_index]) {
           rv->new_columns_[rowkey_index] = &(cv_node->string_value_);
+          rv->new_objs_[rowkey_index] = &(cv_node->value_);
         }
 
         rv->is_rowkey_[rowkey_index] = true;
@@ -1413,6 +1429,7 @@ int ObLogFormatter::fill_rowkey_cols_(
 
         if (rv->contain_old_column_ && NULL == rv->old_columns_[rowkey_index]) {
           rv->old_columns_[rowkey_index] = &(cv_node->string_value_);
+          rv->old_objs_[rowkey_index] = &(cv_node->value_);
         }
       }
     } // for
@@ -1617,29 +1634,112 @@ int ObLogFormatter::build_binlog_record_(
         }
       }
 
-      switch (current_dml_flag) {
-      case ObDmlFlag::DF_DELETE: {
-        ret = format_dml_delete_(br_data, rv);
-        break;
-      }
-      case ObDmlFlag::DF_INSERT: {
-        ret = format_dml_insert_(br_data, rv);
-        break;
-      }
-      case ObDmlFlag::DF_UPDATE: {
-        ret = format_dml_update_(br_data, rv);
-        break;
-      }
-      default: {
-        ret = OB_NOT_SUPPORTED;
-        LOG_ERROR("unknown DML type, not supported", K(current_dml_flag));
-        break;
-      }
+      if (enable_binary_columnar_output_) {
+        // values are output in columnar layout by build_columnar_row_, without filling binlog record
+      } else {
+        switch (current_dml_flag) {
+        case ObDmlFlag::DF_DELETE: {
+          ret = format_dml_delete_(br_data, rv);
+          break;
+        }
+        case ObDmlFlag::DF_INSERT: {
+          ret = format_dml_insert_(br_data, rv);
+          break;
+        }
+        case ObDmlFlag::DF_UPDATE: {
+          ret = format_dml_update_(br_data, rv);
+          break;
+        }
+        default: {
+          ret = OB_NOT_SUPPORTED;
+          LOG_ERROR("unknown DML type, not supported", K(current_dml_flag));
+          break;
+        }
+        }
+        if (OB_FAIL(ret)) {
+          LOG_ERROR("format dml failed", KR(ret), K(table_id), K(current_dml_flag), KPC(simple_table_schema));
+        }
       }
-      if (OB_FAIL(ret)) {
-        LOG_ERROR("format dml failed", KR(ret), K(table_id), K(current_dml_flag), KPC(simple_table_schema));
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFormatter::build_columnar_row_(
+    ObLogBR &br,
+    const RowValue &rv,
+    DmlStmtTask &dml_stmt_task)
+{
+  int ret = OB_SUCCESS;
+  int record_type = RecordType::EUNKNOWN;
+  const int64_t column_cnt = rv.column_num_;
+  const int64_t alloc_size = sizeof(ObLogColumnarRow)
+      + column_cnt * (2 * sizeof(ObLogColumnarValue) + sizeof(ICDCColumnarBatch::ColumnType));
+  char *buf = NULL;
+
+  if (OB_UNLIKELY(! inited_)) {
+    LOG_ERROR("ObLogFormatter has not been initialized");
+    ret = OB_NOT_INIT;
+  } else if (OB_ISNULL(rv.tb_schema_info_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("table schema info of row value is NULL", KR(ret), K(rv), K(dml_stmt_task));
+  } else if (OB_FAIL(br.get_record_type(record_type))) {
+    LOG_ERROR("get_record_type fail", KR(ret), K(br));
+  } else if (OB_ISNULL(buf = static_cast<char *>(dml_stmt_task.get_redo_log_entry_task().alloc(alloc_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_ERROR("allocate memory for columnar row fail", KR(ret), K(alloc_size), K(column_cnt));
+  } else {
+    ObLogColumnarRow *row = new (buf) ObLogColumnarRow();
+    const ObLogColumnarValue empty_value = {NULL, NULL};
+    row->table_id_ = dml_stmt_task.get_table_id();
+    row->record_type_ = record_type;
+    row->column_cnt_ = column_cnt;
+    row->new_values_ = reinterpret_cast<ObLogColumnarValue *>(buf + sizeof(ObLogColumnarRow));
+    row->old_values_ = row->new_values_ + column_cnt;
+    row->column_types_ = reinterpret_cast<ICDCColumnarBatch::ColumnType *>(row->old_values_ + column_cnt);
+
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < column_cnt; idx++) {
+      ColumnSchemaInfo *column_schema_info = NULL;
+
+      if (OB_FAIL(rv.tb_schema_info_->get_column_schema_info(idx, false/*is_column_stored_idx*/, column_schema_info))) {
+        LOG_ERROR("get_column_schema_info fail", KR(ret), K(idx), K(column_cnt), K(dml_stmt_task));
+      } else {
+        // keep the same with the types not converted to string by MutatorRow
+        const ICDCColumnarBatch::ColumnType type = column_schema_info->is_udt_column()
+            ? ICDCColumnarBatch::COLUMN_TEXT
+            : ObLogColumnarBatch::get_column_type(column_schema_info->get_meta_type().get_type());
+        const bool is_text = (ICDCColumnarBatch::COLUMN_TEXT == type);
+        ObLogColumnarValue new_value = empty_value;
+        ObLogColumnarValue old_value = empty_value;
+
+        if (is_text) {
+          new_value.str_ = rv.new_columns_[idx];
+          old_value.str_ = rv.old_columns_[idx];
+        } else {
+          new_value.obj_ = rv.new_objs_[idx];
+          old_value.obj_ = rv.old_objs_[idx];
+        }
+
+        row->column_types_[idx] = type;
+
+        // fill images the same as format_dml_insert_/format_dml_update_/format_dml_delete_
+        if (EINSERT == record_type) {
+          row->new_values_[idx] = new_value;
+          row->old_values_[idx] = empty_value;
+        } else if (EDELETE == record_type) {
+          row->new_values_[idx] = empty_value;
+          row->old_values_[idx] = rv.is_rowkey_[idx] ? new_value : old_value;
+        } else {
+          row->new_values_[idx] = new_value;
+          row->old_values_[idx] = old_value;
+        }
       }
     }
+
+    if (OB_SUCC(ret)) {
+      br.set_columnar_row(row);
+    }
   }
 
   return ret;
@@ -130,6 +130,10 @@ private:
     common::ObString *new_columns_[common::OB_MAX_COLUMN_NUMBER];
     common::ObString *old_columns_[common::OB_MAX_COLUMN_NUMBER];
     common::ObString *orig_default_value_[common::OB_MAX_COLUMN_NUMBER];
+    // typed values of in-row columns, used by binary columnar output
+    const common::ObObj *new_objs_[common::OB_MAX_COLUMN_NUMBER];
+    const common::ObObj *old_objs_[common::OB_MAX_COLUMN_NUMBER];
+    const TableSchemaInfo *tb_schema_info_;
 
     bool is_rowkey_[common::OB_MAX_COLUMN_NUMBER];
     bool is_changed_[common::OB_MAX_COLUMN_NUMBER];
@@ -258,6 +262,11 @@ private:
       const int64_t new_column_cnt,
       const blocksstable::ObDmlFlag &dml_flag,
       const TABLE_SCHEMA *simple_table_schema);
+  // Binary columnar output: build ObLogColumnarRow of binlog record with typed values of RowValue
+  int build_columnar_row_(
+      ObLogBR &br,
+      const RowValue &rv,
+      DmlStmtTask &dml_stmt_task);
   // HBase mode put
   // 1. hbase table
   // 2. update type
@@ -350,6 +359,7 @@ private:
   ObLogHbaseUtil             *hbase_util_;
   bool                       skip_hbase_mode_put_column_count_not_consistency_;
   bool                       enable_output_hidden_primary_key_;
+  bool                       enable_binary_columnar_output_;
   int64_t                    log_entry_task_count_;
   int64_t                    stmt_in_lob_merger_count_;
 
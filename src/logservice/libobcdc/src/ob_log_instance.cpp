@@ -56,6 +56,8 @@
 #include "ob_log_start_schema_matcher.h"  // ObLogStartSchemaMatcher
 #include "ob_log_tenant_mgr.h"            // IObLogTenantMgr
 #include "ob_log_rocksdb_store_service.h" // RocksDbStoreService
+#include "ob_log_file_store_service.h"   // ObLogFileStoreService
+#include "ob_log_columnar_batch.h"         // ObLogColumnarTransBatch
 
 #include "ob_log_trace_id.h"
 #include "share/ob_simple_mem_limit_getter.h"
@@ -165,6 +167,7 @@ ObLogInstance::ObLogInstance() :
     trans_task_pool_(),
     log_entry_task_pool_(NULL),
     store_service_(NULL),
+    is_file_store_service_(false),
     br_pool_(NULL),
     trans_ctx_mgr_(NULL),
     meta_manager_(NULL),
@@ -732,10 +735,16 @@ int ObLogInstance::init_components_(const uint64_t start_tstamp_ns)
   if (OB_UNLIKELY(! is_working_mode_valid(working_mode))) {
     ret = OB_INVALID_CONFIG;
     LOG_ERROR("working_mode is not valid", KR(ret), K(working_mode_str), "working_mode", print_working_mode(working_mode));
+  } else if (OB_UNLIKELY(0 != TCONF.enable_binary_columnar_output && ! is_memory_working_mode(working_mode))) {
+    // typed values are not persisted by storager, binary columnar output is only supported in memory working mode
+    ret = OB_INVALID_CONFIG;
+    LOG_ERROR("enable_binary_columnar_output is only supported in memory working mode", KR(ret),
+        K(working_mode_str), "working_mode", print_working_mode(working_mode));
   } else {
     working_mode_ = working_mode;
 
-    LOG_INFO("set working mode", K(working_mode_str), K(working_mode_), "working_mode", print_working_mode(working_mode_));
+    LOG_INFO("set working mode", K(working_mode_str), K(working_mode_), "working_mode", print_working_mode(working_mode_),
+        "auto_mode_redo_spill_threshold", TCONF.auto_mode_redo_spill_threshold.get());
   }
 
   if (OB_SUCC(ret)) {
@@ -837,7 +846,15 @@ int ObLogInstance::init_components_(const uint64_t start_tstamp_ns)
 
   INIT(log_entry_task_pool_, ObLogEntryTaskPool, TCONF.log_entry_task_prealloc_count);
 
-  INIT(store_service_, RocksDbStoreService, store_service_path);
+  if (OB_SUCC(ret)) {
+    is_file_store_service_ = (1 == TCONF.enable_file_store_service);
+  }
+
+  if (is_file_store_service_) {
+    INIT(store_service_, ObLogFileStoreService, store_service_path);
+  } else {
+    INIT(store_service_, RocksDbStoreService, store_service_path);
+  }
 
   INIT(br_pool_, ObLogBRPool, TCONF.binlog_record_prealloc_count);
 
@@ -929,6 +946,8 @@ int ObLogInstance::init_components_(const uint64_t start_tstamp_ns)
             enable_convert_timestamp_to_unix_timestamp, enable_backup_mode, *tenant_mgr_))) {
       LOG_ERROR("init obj2str_helper fail", KR(ret), K(enable_hbase_mode),
           K(enable_convert_timestamp_to_unix_timestamp), K(enable_backup_mode));
+    } else {
+      obj2str_helper_.set_enable_binary_columnar_output(0 != TCONF.enable_binary_columnar_output);
     }
   }
 
@@ -1204,7 +1223,12 @@ void ObLogInstance::destroy_components_()
   DESTROY(br_pool_, ObLogBRPool);
   DESTROY(storager_, ObLogStorager);
   DESTROY(reader_, ObLogReader);
-  DESTROY(store_service_, RocksDbStoreService);
+  if (is_file_store_service_) {
+    DESTROY(store_service_, ObLogFileStoreService);
+  } else {
+    DESTROY(store_service_, RocksDbStoreService);
+  }
+  is_file_store_service_ = false;
   if (is_data_dict_refresh_mode(refresh_mode_)) {
     ObLogMetaDataService::get_instance().destroy();
   }
@@ -1360,6 +1384,36 @@ void ObLogInstance::do_stop_(const char *stop_reason)
   }
 }
 
+int ObLogInstance::get_columnar_batches(IBinlogRecord *record,
+    std::vector<const ICDCColumnarBatch *> &batches)
+{
+  int ret = OB_SUCCESS;
+  ObLogBR *br = NULL;
+  batches.clear();
+
+  if (OB_UNLIKELY(! inited_)) {
+    LOG_ERROR("instance has not been initialized");
+    ret = OB_NOT_INIT;
+  } else if (OB_UNLIKELY(0 == TCONF.enable_binary_columnar_output)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("binary columnar output is not enabled", KR(ret));
+  } else if (OB_ISNULL(record) || OB_UNLIKELY(ECOMMIT != record->recordType())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("invalid argument, expect COMMIT record", KR(ret), K(record));
+  } else if (OB_ISNULL(br = reinterpret_cast<ObLogBR *>(record->getUserData()))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("binlog record user data is NULL", KR(ret), K(record));
+  } else {
+    const ObLogColumnarTransBatch *trans_batch = br->get_columnar_trans_batch();
+
+    for (int64_t idx = 0; NULL != trans_batch && idx < trans_batch->get_batch_count(); idx++) {
+      batches.push_back(trans_batch->get_batch(idx));
+    }
+  }
+
+  return ret;
+}
+
 int ObLogInstance::get_tenant_ids(std::vector<uint64_t> &tenant_ids)
 {
   int ret = OB_SUCCESS;
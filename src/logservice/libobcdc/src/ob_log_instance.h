@@ -138,6 +138,8 @@ public:
       uint64_t &tenant_id,
       const int64_t timeout_us);
   virtual void release_record(IBinlogRecord *record);
+  virtual int get_columnar_batches(IBinlogRecord *record,
+      std::vector<const ICDCColumnarBatch *> &batches);
   virtual int launch();
   virtual void stop();
   virtual int get_tenant_ids(std::vector<uint64_t> &tenant_ids);
@@ -330,6 +332,7 @@ public:
   PartTransTaskPool         trans_task_pool_;
   IObLogEntryTaskPool       *log_entry_task_pool_;
   IObStoreService           *store_service_;
+  bool                      is_file_store_service_;   // store_service_ is ObLogFileStoreService
   IObLogBRPool              *br_pool_;
   IObLogTransCtxMgr         *trans_ctx_mgr_;
   IObLogMetaManager         *meta_manager_;
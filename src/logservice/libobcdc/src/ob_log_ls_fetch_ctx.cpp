@@ -548,6 +548,56 @@ int LSFetchCtx::update_progress(
   return ret;
 }
 
+int LSFetchCtx::read_pruned_group(
+    const obrpc::ObCdcLSFetchLogResp::PrunedGroup &group,
+    const obrpc::ObCdcLSFetchLogResp::PrunedRedoArray &redo_arr,
+    const int64_t redo_start_idx)
+{
+  int ret = OB_SUCCESS;
+  const palf::LSN next_lsn = group.lsn_ + group.size_;
+
+  if (OB_ISNULL(part_trans_resolver_)) {
+    ret = OB_NOT_INIT;
+    LOG_ERROR("part trans resolver is not init", KR(ret), K_(tls_id));
+  } else if (OB_UNLIKELY(redo_start_idx < 0 || redo_start_idx + group.redo_cnt_ > redo_arr.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("invalid pruned redo range", KR(ret), K_(tls_id), K(group), K(redo_start_idx),
+        "redo_cnt", redo_arr.count());
+  }
+  // Verifying log continuity
+  else if (OB_UNLIKELY(progress_.get_next_lsn() != group.lsn_)) {
+    ret = OB_LOG_NOT_SYNC;
+    LOG_ERROR("log not sync", KR(ret), "next_log_lsn", progress_.get_next_lsn(),
+        "cur_log_lsn", group.lsn_, K(group));
+  } else {
+    for (int64_t idx = redo_start_idx; OB_SUCC(ret) && idx < redo_start_idx + group.redo_cnt_; ++idx) {
+      const obrpc::ObCdcLSFetchLogResp::PrunedRedo &redo = redo_arr.at(idx);
+
+      if (OB_FAIL(part_trans_resolver_->read_pruned_redo(redo.tx_id_, redo.cluster_id_, redo.lsn_))) {
+        LOG_ERROR("read_pruned_redo failed", KR(ret), K_(tls_id), K(redo), K(group));
+      }
+    }
+
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(progress_.update_log_progress(next_lsn, group.size_, group.submit_ts_))) {
+      LOG_ERROR("update log progress fail", KR(ret), K(next_lsn), K(group), K(progress_));
+    } else {
+      // The pruned group is absent in mem_storage_, restart the iterator from the next group.
+      // Accumulated checksum of the iterator is reset as well, as it cannot cover the pruned group.
+      mem_storage_.destroy();
+      group_iterator_.destroy();
+
+      if (OB_FAIL(init_group_iterator_(next_lsn))) {
+        LOG_ERROR("init_group_iterator_ failed", KR(ret), K_(tls_id), K(next_lsn));
+      } else {
+        LOG_DEBUG("read pruned group and update progress success", K_(tls_id), K(group), K_(progress));
+      }
+    }
+  }
+
+  return ret;
+}
+
 int LSFetchCtx::handle_offline_ls_log_(const palf::LogEntry &log_entry,
     volatile bool &stop_flag)
 {
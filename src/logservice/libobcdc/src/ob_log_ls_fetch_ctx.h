@@ -35,6 +35,7 @@
 #include "ob_log_part_trans_dispatcher.h"     // PartTransDispatchInfo
 #include "ob_log_ls_define.h"                 // TenantLSID
 #include "ob_log_fetcher_start_parameters.h"  // ObLogFetcherStartParameters
+#include "logservice/cdcservice/ob_cdc_req.h"  // ObCdcLSFetchLogResp
 
 namespace oceanbase
 {
@@ -158,6 +159,23 @@ public:
       const palf::LogGroupEntry &group_entry,
       const palf::LSN &group_entry_lsn);
 
+  /// Read a log group pruned by server, which is not in the fetched log buf
+  ///
+  /// @param [in]  group           Pruned log group
+  /// @param [in]  redo_arr        Pruned redo array of the fetch log response
+  /// @param [in]  redo_start_idx  Index of the first redo of the group in redo_arr
+  ///
+  /// @note Redo in the group are marked fetched for their trans, progress is updated to the end of the group,
+  /// and the group iterator restarts from the next group.
+  ///
+  /// @retval OB_SUCCESS          success
+  /// @retval OB_LOG_NOT_SYNC     group is not the next group to read
+  /// @retval Other error codes   Failed
+  int read_pruned_group(
+      const obrpc::ObCdcLSFetchLogResp::PrunedGroup &group,
+      const obrpc::ObCdcLSFetchLogResp::PrunedRedoArray &redo_arr,
+      const int64_t redo_start_idx);
+
   /// Offline LS, clear all unexported tasks and issue OFFLINE type tasks
   ///
   /// @retval OB_SUCCESS          success
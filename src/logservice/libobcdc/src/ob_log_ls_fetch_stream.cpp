@@ -24,6 +24,8 @@
 #include "ob_ls_worker.h"                         // IObLSWorker
 #include "ob_log_part_progress_controller.h"      // PartProgressController
 #include "ob_log_trace_id.h"                      // ObLogTraceIdGuard
+#include "ob_log_instance.h"                      // TCTX
+#include "ob_log_tenant.h"                        // ObLogTenantGuard
 
 using namespace oceanbase::common;
 using namespace oceanbase::obrpc;
@@ -40,6 +42,7 @@ int64_t FetchStream::g_blacklist_survival_time = ObLogConfig::default_blacklist_
 int64_t FetchStream::g_check_switch_server_interval = ObLogConfig::default_check_switch_server_interval_min * _MIN_;
 bool FetchStream::g_print_rpc_handle_info = ObLogConfig::default_print_rpc_handle_info;
 bool FetchStream::g_print_stream_dispatch_info = ObLogConfig::default_print_stream_dispatch_info;
+bool FetchStream::g_enable_fetch_log_tablet_filter = ObLogConfig::default_enable_fetch_log_tablet_filter;
 
 const char *FetchStream::print_state(State state)
 {
@@ -255,6 +258,7 @@ void FetchStream::configure(const ObLogConfig &config)
   int64_t check_switch_server_interval_min = config.check_switch_server_interval_min;
   bool print_rpc_handle_info = config.print_rpc_handle_info;
   bool print_stream_dispatch_info = config.print_stream_dispatch_info;
+  bool enable_fetch_log_tablet_filter = config.enable_fetch_log_tablet_filter;
 
   ATOMIC_STORE(&g_rpc_timeout, fetch_log_rpc_timeout_sec * _SEC_);
   LOG_INFO("[CONFIG]", K(fetch_log_rpc_timeout_sec));
@@ -270,6 +274,8 @@ void FetchStream::configure(const ObLogConfig &config)
   LOG_INFO("[CONFIG]", K(print_rpc_handle_info));
   ATOMIC_STORE(&g_print_stream_dispatch_info, print_stream_dispatch_info);
   LOG_INFO("[CONFIG]", K(print_stream_dispatch_info));
+  ATOMIC_STORE(&g_enable_fetch_log_tablet_filter, enable_fetch_log_tablet_filter);
+  LOG_INFO("[CONFIG]", K(enable_fetch_log_tablet_filter));
 }
 
 void FetchStream::do_stat()
@@ -545,11 +551,15 @@ int FetchStream::async_fetch_log_(
 {
   int ret = OB_SUCCESS;
   const int64_t client_progress = ls_fetch_ctx_->get_progress();
+  common::ObSEArray<common::ObTabletID, 16> pruned_tablets;
 
   rpc_send_succeed = false;
 
+  get_pruned_tablets_(pruned_tablets);
+
   // Launch an asynchronous RPC
-  if (OB_FAIL(fetch_log_arpc_.async_fetch_log(req_start_lsn, client_progress, upper_limit_, rpc_send_succeed))) {
+  if (OB_FAIL(fetch_log_arpc_.async_fetch_log(req_start_lsn, client_progress, upper_limit_, pruned_tablets,
+      rpc_send_succeed))) {
     LOG_ERROR("async_fetch_log fail", KR(ret), K(req_start_lsn), K(upper_limit_), K(fetch_log_arpc_));
   } else {
     // Asynchronous RPC execution succeeded
@@ -559,6 +569,33 @@ int FetchStream::async_fetch_log_(
   return ret;
 }
 
+void FetchStream::get_pruned_tablets_(common::ObIArray<common::ObTabletID> &pruned_tablets)
+{
+  int ret = OB_SUCCESS;
+  const TenantLSID &tls_id = ls_fetch_ctx_->get_tls_id();
+  ObLogTenantGuard guard;
+  ObLogTenant *tenant = NULL;
+
+  // Logs of sys LS are not filtered, DDL and MDS of all tables are in them.
+  // The exclude list only has index tablets, whose rows are always dropped by the parser.
+  // Tablets of tables not matched by tb_white_list/tb_black_list are not pruned.
+  if (ATOMIC_LOAD(&g_enable_fetch_log_tablet_filter) && ! tls_id.is_sys_log_stream()) {
+    if (OB_FAIL(TCTX.get_tenant_guard(tls_id.get_tenant_id(), guard))) {
+      LOG_WARN("get tenant_guard failed, fetch log without tablet filter", KR(ret), K(tls_id));
+    } else if (OB_ISNULL(tenant = guard.get_tenant())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("tenant is null, fetch log without tablet filter", KR(ret), K(tls_id));
+    } else if (OB_FAIL(tenant->get_index_tablets(pruned_tablets))) {
+      LOG_WARN("get index tablets failed, fetch log without tablet filter", KR(ret), K(tls_id));
+    }
+
+    if (OB_FAIL(ret)) {
+      // The filter is an optimization only, fetch all logs on failure
+      pruned_tablets.reset();
+    }
+  }
+}
+
 void FetchStream::print_handle_info_(
     FetchLogARpcResult &result,
     const int64_t handle_rpc_time,
@@ -1380,6 +1417,12 @@ int FetchStream::read_log_(
   } else if (OB_ISNULL(ls_fetch_ctx_)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_ERROR("invalid ls_fetch_ctx", KR(ret), K(ls_fetch_ctx_));
+  } else if (! resp.get_pruned_groups().empty()) {
+    if (OB_FAIL(read_log_with_pruned_groups_(resp, stop_flag, kick_out_info, decode_log_entry_time, tsi))) {
+      if (OB_IN_STOP_STATE != ret) {
+        LOG_ERROR("read log with pruned groups failed", KR(ret), K(resp));
+      }
+    }
   } else if (0 == log_cnt) {
     // Ignore 0 logs
     LOG_DEBUG("fetch 0 log", K_(svr), "fetch_status", resp.get_fetch_status());
@@ -1427,6 +1470,86 @@ int FetchStream::read_log_(
   return ret;
 }
 
+int FetchStream::read_log_with_pruned_groups_(
+    const obrpc::ObCdcLSFetchLogResp &resp,
+    volatile bool &stop_flag,
+    KickOutInfo &kick_out_info,
+    int64_t &decode_log_entry_time,
+    TransStatInfo &tsi)
+{
+  int ret = OB_SUCCESS;
+  const char *buf = resp.get_log_entry_buf();
+  const int64_t len = resp.get_pos();
+  const int64_t log_cnt = resp.get_log_num();
+  const ObCdcLSFetchLogResp::PrunedGroupArray &pruned_groups = resp.get_pruned_groups();
+  const ObCdcLSFetchLogResp::PrunedRedoArray &pruned_redos = resp.get_pruned_redos();
+  int64_t seg_start = 0;
+  int64_t redo_idx = 0;
+  int64_t read_log_cnt = 0;
+
+  // Pruned groups split the log buf into segments, segments and pruned groups are read in LSN order:
+  // [seg 0][pruned group 0][seg 1][pruned group 1]...[seg N], where a segment may be empty.
+  for (int64_t group_idx = 0; OB_SUCC(ret) && group_idx <= pruned_groups.count(); ++group_idx) {
+    const bool is_last_seg = (pruned_groups.count() == group_idx);
+    const int64_t seg_end = is_last_seg ? len : pruned_groups.at(group_idx).buf_pos_;
+
+    if (OB_UNLIKELY(seg_end < seg_start || seg_end > len)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_ERROR("invalid buf pos of pruned group", KR(ret), K(group_idx), K(seg_start), K(seg_end), K(resp));
+    } else if (seg_end > seg_start && OB_FAIL(ls_fetch_ctx_->append_log(buf + seg_start, seg_end - seg_start))) {
+      LOG_ERROR("append log to LSFetchCtx failed", KR(ret), KPC(ls_fetch_ctx_), K(seg_start), K(seg_end));
+    }
+
+    // Iterate through all log entries of the segment
+    while (OB_SUCC(ret) && seg_end > seg_start) {
+      int64_t begin_time = get_timestamp();
+      palf::LSN group_start_lsn;
+      palf::LogGroupEntry group_entry;
+
+      if (OB_FAIL(ls_fetch_ctx_->get_next_group_entry(group_entry, group_start_lsn))) {
+        if (OB_ITER_END != ret) {
+          LOG_ERROR("get next_group_entry failed", KR(ret), K_(ls_fetch_ctx), K(resp));
+        }
+      } else {
+        decode_log_entry_time += (get_timestamp() - begin_time);
+        read_log_cnt++;
+
+        if (OB_FAIL(read_group_entry_(group_entry, group_start_lsn, stop_flag, kick_out_info, tsi))) {
+          if (OB_IN_STOP_STATE != ret) {
+            LOG_ERROR("read group entry failed", KR(ret));
+          }
+        } else if (OB_FAIL(ls_fetch_ctx_->update_progress(group_entry, group_start_lsn))) {
+          LOG_ERROR("ls_fetch_ctx_ update_progress failed", KR(ret), K(group_entry), K(group_start_lsn));
+        }
+      }
+    }
+
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    }
+
+    if (OB_FAIL(ret) || is_last_seg) {
+    } else {
+      const ObCdcLSFetchLogResp::PrunedGroup &group = pruned_groups.at(group_idx);
+
+      if (OB_FAIL(ls_fetch_ctx_->read_pruned_group(group, pruned_redos, redo_idx))) {
+        LOG_ERROR("read pruned group failed", KR(ret), K(group), K(redo_idx), KPC(ls_fetch_ctx_));
+      } else {
+        redo_idx += group.redo_cnt_;
+        seg_start = seg_end;
+      }
+    }
+  }
+
+  if (OB_SUCC(ret) && OB_UNLIKELY(read_log_cnt != log_cnt || redo_idx != pruned_redos.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("log count not match", KR(ret), K(read_log_cnt), K(log_cnt), K(redo_idx),
+        "pruned_redo_cnt", pruned_redos.count(), K(resp));
+  }
+
+  return ret;
+}
+
 int FetchStream::fetch_miss_log_direct_(
     const ObIArray<ObCdcLSFetchMissLogReq::MissLogParam> &miss_log_array,
     const int64_t timeout,
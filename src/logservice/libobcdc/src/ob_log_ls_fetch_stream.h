@@ -63,6 +63,7 @@ public:
   static int64_t g_check_switch_server_interval;
   static bool g_print_rpc_handle_info;
   static bool g_print_stream_dispatch_info;
+  static bool g_enable_fetch_log_tablet_filter;
 
   /////////// Fetch log stream status //////////
   // IDLE:        Idle state, not waiting for any asynchronous RPC
@@ -168,6 +169,8 @@ private:
   int async_fetch_log_(
       const palf::LSN &req_start_lsn,
       bool &rpc_send_succeed);
+  // Get tablets whose redo the server can skip, empty if the tablet filter is disabled
+  void get_pruned_tablets_(common::ObIArray<common::ObTabletID> &pruned_tablets);
   struct KickOutInfo;
   void print_handle_info_(
       FetchLogARpcResult &result,
@@ -236,6 +239,13 @@ private:
       int64_t &read_log_time,
       int64_t &decode_log_entry_time,
       TransStatInfo &tsi);
+  // Read the log buf of a response which has log groups pruned by the server
+  int read_log_with_pruned_groups_(
+      const obrpc::ObCdcLSFetchLogResp &resp,
+      volatile bool &stop_flag,
+      KickOutInfo &kick_out_info,
+      int64_t &decode_log_entry_time,
+      TransStatInfo &tsi);
   int fetch_miss_log_direct_(
       const ObIArray<obrpc::ObCdcLSFetchMissLogReq::MissLogParam> &miss_log_array,
       const int64_t timeout,
@@ -233,6 +233,10 @@ public:
   virtual int get_table_info_of_tablet_id(
       const common::ObTabletID &tablet_id,
       ObCDCTableInfo &table_info) const = 0;
+  /// Get tablets of index tables, at most max_count
+  virtual int get_index_tablets(
+      common::ObIArray<common::ObTabletID> &tablets,
+      const int64_t max_count) const = 0;
   virtual int apply_create_tablet_change(const ObCDCTabletChangeInfo &tablet_change_info) = 0;
   virtual int apply_delete_tablet_change(const ObCDCTabletChangeInfo &tablet_change_info) = 0;
 };
@@ -319,6 +323,10 @@ public:
   {
     return tablet_to_table_info_.get_table_info_of_tablet(tablet_id, table_info);
   }
+  virtual int get_index_tablets(common::ObIArray<common::ObTabletID> &tablets, const int64_t max_count) const
+  {
+    return tablet_to_table_info_.get_index_tablets(tablets, max_count);
+  }
 
   virtual int apply_create_tablet_change(const ObCDCTabletChangeInfo &tablet_change_info);
   virtual int apply_delete_tablet_change(const ObCDCTabletChangeInfo &tablet_change_info);
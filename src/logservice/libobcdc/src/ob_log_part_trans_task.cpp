@@ -596,7 +596,13 @@ int MutatorRow::add_column_(
     // convert obj to string if obj2str_helper is valid
     // no deep copy of string required
     // note: currently DML must pass into obj2str_helperd
-    if (NULL != obj2str_helper && ! is_out_row && OB_FAIL(obj2str_helper->obj2str(tenant_id,
+    // note: in binary columnar output, values of non-UDT columns output typed are not converted
+    const bool need_convert = (NULL != obj2str_helper && ! is_out_row)
+        && (NULL == column_schema_info
+            || column_schema_info->is_udt_column()
+            || obj2str_helper->need_convert_dml_value(column_schema_info->get_meta_type().get_type()));
+
+    if (need_convert && OB_FAIL(obj2str_helper->obj2str(tenant_id,
         table_id,
         column_id,
         cv_node->value_,
@@ -2137,6 +2143,7 @@ PartTransTask::PartTransTask() :
     trace_info_(),
     sorted_log_entry_info_(),
     sorted_redo_list_(),
+    memory_redo_size_(0),
     part_tx_fetch_state_(0),
     rollback_list_(),
     ref_cnt_(0),
@@ -2271,6 +2278,7 @@ void PartTransTask::reset()
   trace_info_.reset();
   sorted_log_entry_info_.reset();
   sorted_redo_list_.reset();
+  memory_redo_size_ = 0;
   part_tx_fetch_state_ = 0;
   rollback_list_.reset();
   ref_cnt_ = 0;
@@ -2340,7 +2348,6 @@ int PartTransTask::push_redo_log(
       LOG_ERROR("currently not support big row", KR(ret), K(meta));
     }
 
-    // TODO AUTO mode
     if (OB_SUCC(ret)) {
       palf::LSN store_log_lsn;
       const char *data_buf = NULL;
@@ -2711,8 +2718,10 @@ bool PartTransTask::need_store_data_() const
     bool_ret = false;
   } else if (is_storage_working_mode(working_mode)) {
     bool_ret = true;
-  } else {
-    // TODO AUTO MODE
+  } else if (is_auto_working_mode(working_mode)) {
+    // Redo of a transaction is stored once the redo in memory exceeds the threshold, so that
+    // small transactions are never stored and large transactions are spilled without holding all redo in memory
+    bool_ret = memory_redo_size_ >= TCONF.auto_mode_redo_spill_threshold.get();
   }
 
   return bool_ret;
@@ -2845,6 +2854,8 @@ int PartTransTask::push_dml_redo_on_row_start_(
       } else {
         LOG_ERROR("push node into redo log list fail", KR(ret), K(sorted_redo_list_), KPC(meta_node));
       }
+    } else if (! need_store_data) {
+      memory_redo_size_ += mutator_row_size;
     }
   }
 
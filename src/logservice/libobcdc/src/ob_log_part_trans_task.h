@@ -1180,7 +1180,7 @@ private:
   int alloc_log_entry_node_(const palf::LSN &lsn, LogEntryNode *&log_entry_node);
   // 1. memory mode: all data is in memory,
   // 2. storage mode: all data need be stored
-  // 3. auto mode:
+  // 3. auto mode: data is stored after size of data in memory exceeds auto_mode_redo_spill_threshold
   bool need_store_data_() const;
   // Handling of row start
   int push_redo_on_row_start_(
@@ -1256,6 +1256,7 @@ private:
   // Trans fetche log info
   SortedLogEntryInfo      sorted_log_entry_info_; // sorted log_entry list
   SortedRedoLogList       sorted_redo_list_;      // ordered redo list
+  int64_t                 memory_redo_size_;      // size of redo data in memory, for auto working mode
   // PartTrans fetch_log state
   // part_tx_fetch_state_ & 0x01:      read first record log
   // part_tx_fetch_state_ & 0x01 << 1: read commit info log
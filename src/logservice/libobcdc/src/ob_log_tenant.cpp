@@ -25,6 +25,7 @@
 #include "ob_log_timezone_info_getter.h"                            // ObLogTimeZoneInfoGetter
 
 #include "ob_log_start_schema_matcher.h"                            // ObLogStartSchemaMatcher
+#include "logservice/cdcservice/ob_cdc_req.h"                       // ObCdcLSFetchLogReq
 
 #define STAT(level, tag_str, args...) OBLOG_LOG(level, "[STAT] [TENANT] " tag_str, ##args)
 #define ISTAT(tag_str, args...) STAT(INFO, tag_str, ##args)
@@ -57,7 +58,10 @@ ObLogTenant::ObLogTenant() :
     tz_info_map_version_(OB_INVALID_TIMESTAMP),
     tz_info_map_(NULL),
     tz_info_wrap_(NULL),
-    cf_handle_(NULL)
+    cf_handle_(NULL),
+    index_tablet_lock_(),
+    index_tablet_refresh_tstamp_(OB_INVALID_TIMESTAMP),
+    index_tablet_arr_()
 {
   tenant_name_[0] = '\0';
   global_seq_and_schema_version_.lo = 0;
@@ -204,9 +208,38 @@ void ObLogTenant::reset()
   committer_cur_schema_version_ = OB_INVALID_VERSION;
   committer_next_trans_schema_version_ = OB_INVALID_VERSION;
   cf_handle_ = NULL;
+  index_tablet_refresh_tstamp_ = OB_INVALID_TIMESTAMP;
+  index_tablet_arr_.reset();
   ObMallocAllocator::get_instance()->recycle_tenant_allocator(tenant_id);
 }
 
+int ObLogTenant::get_index_tablets(common::ObIArray<common::ObTabletID> &tablets)
+{
+  int ret = OB_SUCCESS;
+  ObSpinLockGuard guard(index_tablet_lock_);
+  const int64_t cur_tstamp = get_timestamp();
+
+  if (OB_INVALID_TIMESTAMP == index_tablet_refresh_tstamp_
+      || cur_tstamp - index_tablet_refresh_tstamp_ >= INDEX_TABLET_REFRESH_INTERVAL) {
+    index_tablet_arr_.reuse();
+
+    if (OB_FAIL(part_mgr_.get_index_tablets(index_tablet_arr_,
+        obrpc::ObCdcLSFetchLogReq::MAX_PRUNED_TABLET_CNT))) {
+      LOG_ERROR("part_mgr get_index_tablets failed", KR(ret), K_(tenant_id));
+      index_tablet_arr_.reuse();
+    } else {
+      index_tablet_refresh_tstamp_ = cur_tstamp;
+      LOG_DEBUG("refresh index tablets", K_(tenant_id), "index_tablet_count", index_tablet_arr_.count());
+    }
+  }
+
+  if (OB_SUCC(ret) && OB_FAIL(tablets.assign(index_tablet_arr_))) {
+    LOG_ERROR("assign index tablets failed", KR(ret), K_(tenant_id));
+  }
+
+  return ret;
+}
+
 int ObLogTenant::alloc_global_trans_seq_and_schema_version_for_ddl(
     const int64_t base_schema_version,
     int64_t &new_seq,
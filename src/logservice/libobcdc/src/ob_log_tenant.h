@@ -24,6 +24,7 @@
 #include "ob_log_ls_mgr.h"                          // ObLogLSMgr
 #include "ob_log_ref_state.h"                       // RefState
 #include "lib/timezone/ob_timezone_info.h"          // ObTimeZoneInfo
+#include "lib/lock/ob_spin_lock.h"                  // ObSpinLock
 #include <cstdint>
 
 namespace oceanbase
@@ -90,6 +91,7 @@ class ObLogTenant : public TenantValue
 {
   static const int64_t DATA_OP_TIMEOUT = 1 * _SEC_;
   static const int64_t PRINT_INTERVAL = 10 * _SEC_;
+  static const int64_t INDEX_TABLET_REFRESH_INTERVAL = 1 * _SEC_;
 public:
   ObLogTenant();
   ~ObLogTenant();
@@ -248,6 +250,10 @@ public:
     return part_mgr_.get_table_info_of_tablet_id(tablet_id, table_info);
   }
 
+  // Get tablets of index tables, which are carried by fetch log requests to let the server skip their redo.
+  // The tablets are cached and refreshed from PartMgr every INDEX_TABLET_REFRESH_INTERVAL.
+  int get_index_tablets(common::ObIArray<common::ObTabletID> &tablets);
+
 public:
   enum
   {
@@ -347,6 +353,11 @@ private:
 
   void                       *cf_handle_;
 
+  // Cache of index tablets, see get_index_tablets()
+  common::ObSpinLock         index_tablet_lock_;
+  int64_t                    index_tablet_refresh_tstamp_;
+  common::ObSEArray<common::ObTabletID, 16> index_tablet_arr_;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(ObLogTenant);
 };
@@ -46,7 +46,6 @@ const char *print_working_mode(const WorkingMode mode)
   return mode_str;
 }
 
-// TODO support auto mode
 WorkingMode get_working_mode(const char *working_mode_str)
 {
   WorkingMode ret_mode = UNKNOWN_MODE;
@@ -57,6 +56,8 @@ WorkingMode get_working_mode(const char *working_mode_str)
       ret_mode = MEMORY_MODE;
     } else if (0 == strcmp("storage", working_mode_str)) {
       ret_mode = STORAGER_MODE;
+    } else if (0 == strcmp("auto", working_mode_str)) {
+      ret_mode = AUTO_MODE;
     } else {
     }
   }
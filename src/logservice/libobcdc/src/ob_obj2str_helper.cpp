@@ -26,6 +26,7 @@
 #include "sql/engine/expr/ob_expr_res_type_map.h"
 
 #include "ob_log_utils.h"                           // _M_
+#include "ob_log_columnar_batch.h"                  // ObLogColumnarBatch
 
 using namespace oceanbase::common;
 namespace oceanbase
@@ -40,7 +41,8 @@ ObObj2strHelper::ObObj2strHelper() : inited_(false),
                                      enable_hbase_mode_(false),
                                      enable_convert_timestamp_to_unix_timestamp_(false),
                                      enable_backup_mode_(false),
-                                     tenant_mgr_(NULL)
+                                     tenant_mgr_(NULL),
+                                     enable_binary_columnar_output_(false)
 {
 }
 
@@ -105,6 +107,12 @@ void ObObj2strHelper::destroy()
   enable_convert_timestamp_to_unix_timestamp_ = false;
   enable_backup_mode_ = false;
   tenant_mgr_ = NULL;
+  enable_binary_columnar_output_ = false;
+}
+
+bool ObObj2strHelper::need_convert_dml_value(const common::ObObjType obj_type) const
+{
+  return ! (enable_binary_columnar_output_ && ObLogColumnarBatch::is_binary_type(obj_type));
 }
 
 
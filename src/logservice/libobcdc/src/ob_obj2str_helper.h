@@ -61,6 +61,11 @@ public:
        const common::ObCollationType &collation_type,
        const ObTimeZoneInfoWrap *tz_info_wrap) const;
 
+  // In binary columnar output, DML values of types with binary representation are output typed,
+  // and need not be converted to string
+  bool need_convert_dml_value(const common::ObObjType obj_type) const;
+  void set_enable_binary_columnar_output(const bool enable) { enable_binary_columnar_output_ = enable; }
+
 public:
   int init(IObLogTimeZoneInfoGetter &timezone_info_getter,
       ObLogHbaseUtil &hbase_util,
@@ -133,6 +138,7 @@ private:
   bool                          enable_convert_timestamp_to_unix_timestamp_;
   bool                          enable_backup_mode_;
   IObLogTenantMgr               *tenant_mgr_;
+  bool                          enable_binary_columnar_output_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObObj2strHelper);
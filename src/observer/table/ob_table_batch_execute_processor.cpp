@@ -144,6 +144,7 @@ void ObTableBatchExecuteP::reset_ctx()
   need_retry_in_queue_ = false;
   need_rollback_trans_ = false;
   result_.reset();
+  tablet_ids_.reset();
   ObTableApiProcessorBase::reset_ctx();
 }
 
@@ -165,15 +166,41 @@ int ObTableBatchExecuteP::try_process()
   } else if (OB_UNLIKELY(!is_index_supported)) {
     ret = OB_NOT_SUPPORTED;
     LOG_WARN("index type is not supported by table api", K(ret));
+  } else if (OB_FAIL(get_tablet_ids(table_id, tablet_ids_))) {
+    LOG_WARN("fail to get tablet ids", K(ret), K(table_id));
   } else {
+    // the multi_xxx paths share one table ctx bound to a single tablet. A batch of
+    // insert/delete/replace across tablets shares one spec per tablet group in
+    // multi_tablet_write, other batches across tablets are executed by batch_execute,
+    // where each operation routes to its own tablet.
+    const bool is_multi_tablet = tablet_ids_.count() > 1
+                                 && ObTableEntityType::ET_HKV != arg_.entity_type_;
     if (batch_operation.is_readonly()) {
-      if (batch_operation.is_same_properties_names()) {
+      if (batch_operation.is_same_properties_names() && !is_multi_tablet) {
         stat_event_type_ = ObTableProccessType::TABLE_API_MULTI_GET;
         ret = multi_get();
       } else {
         stat_event_type_ = ObTableProccessType::TABLE_API_BATCH_RETRIVE;
         ret = batch_execute(true);
       }
+    } else if (is_multi_tablet) {
+      const ObTableOperationType::Type op_type = batch_operation.at(0).type();
+      if (!batch_operation.is_same_type()) {
+        stat_event_type_ = ObTableProccessType::TABLE_API_BATCH_HYBRID;
+        ret = batch_execute(false);
+      } else if (ObTableOperationType::INSERT == op_type) {
+        stat_event_type_ = ObTableProccessType::TABLE_API_MULTI_INSERT;
+        ret = multi_tablet_write(op_type);
+      } else if (ObTableOperationType::DEL == op_type) {
+        stat_event_type_ = ObTableProccessType::TABLE_API_MULTI_DELETE;
+        ret = multi_tablet_write(op_type);
+      } else if (ObTableOperationType::REPLACE == op_type) {
+        stat_event_type_ = ObTableProccessType::TABLE_API_MULTI_REPLACE;
+        ret = multi_tablet_write(op_type);
+      } else {
+        stat_event_type_ = ObTableProccessType::TABLE_API_BATCH_HYBRID;
+        ret = batch_execute(false);
+      }
     } else if (batch_operation.is_same_type()) {
       switch(batch_operation.at(0).type()) {
         case ObTableOperationType::INSERT:
@@ -662,21 +689,40 @@ int ObTableBatchExecuteP::multi_replace()
   return ret;
 }
 
+int ObTableBatchExecuteP::get_batch_ls_id(const ObIArray<ObTabletID> &tablet_ids, ObLSID &ls_id)
+{
+  int ret = OB_SUCCESS;
+  ObLSID tablet_ls_id;
+  ls_id.reset();
+  if (OB_UNLIKELY(tablet_ids.empty())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("tablet ids is empty", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < tablet_ids.count(); ++i) {
+    if (OB_FAIL(get_ls_id(tablet_ids.at(i), tablet_ls_id))) {
+      LOG_WARN("fail to get ls id", K(ret), K(tablet_ids.at(i)));
+    } else if (0 == i) {
+      ls_id = tablet_ls_id;
+    } else if (ls_id != tablet_ls_id) {
+      // tablets in different log streams, use global snapshot
+      ls_id.reset();
+      break;
+    }
+  }
+  return ret;
+}
+
 int ObTableBatchExecuteP::batch_execute(bool is_readonly)
 {
   int ret = OB_SUCCESS;
   uint64_t table_id = OB_INVALID_ID;
-  ObSEArray<ObTabletID, 1> tablet_ids;
   ObLSID ls_id;
   if (OB_FAIL(get_table_id(arg_.table_name_, arg_.table_id_, table_id))) {
     LOG_WARN("fail to get table id", K(ret));
-  } else if (OB_FAIL(get_tablet_ids(table_id, tablet_ids))) {
+  } else if (tablet_ids_.empty() && OB_FAIL(get_tablet_ids(table_id, tablet_ids_))) {
     LOG_WARN("fail to get tablet id", K(ret));
-  } else if (1 != tablet_ids.count()) {
-    ret = OB_NOT_SUPPORTED;
-    LOG_WARN("should have one tablet", K(ret), K(tablet_ids));
-  } else if (OB_FAIL(get_ls_id(tablet_ids.at(0), ls_id))) {
-    LOG_WARN("fail to get ls id", K(ret));
+  } else if (OB_FAIL(get_batch_ls_id(tablet_ids_, ls_id))) {
+    LOG_WARN("fail to get ls id", K(ret), K_(tablet_ids));
   } else if (OB_FAIL(start_trans(is_readonly, /* is_readonly */
                                  (is_readonly ? sql::stmt::T_SELECT : sql::stmt::T_UPDATE),
                                  arg_.consistency_level_,
@@ -684,7 +730,10 @@ int ObTableBatchExecuteP::batch_execute(bool is_readonly)
                                  ls_id,
                                  get_timeout_ts()))) {
     LOG_WARN("fail to start readonly transaction", K(ret));
-  } else if (OB_FAIL(batch_execute_internal(arg_.batch_operation_, result_))) {
+  } else if (OB_FAIL(batch_execute_internal(arg_.batch_operation_,
+                                            table_id,
+                                            !ls_id.is_valid(), /* group_by_ls */
+                                            result_))) {
     LOG_WARN("fail to execute batch", K(ret));
   }
 
@@ -696,18 +745,174 @@ int ObTableBatchExecuteP::batch_execute(bool is_readonly)
   return ret;
 }
 
+int ObTableBatchExecuteP::get_batch_exec_order(const ObTableBatchOperation &batch_operation,
+                                               uint64_t table_id,
+                                               ObIArray<BatchOpLocation> &exec_order)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObRowkey, 1> rowkeys;
+  ObSEArray<ObTabletID, 1> tablet_ids;
+  for (int64_t i = 0; OB_SUCC(ret) && i < batch_operation.count(); ++i) {
+    BatchOpLocation op_loc;
+    op_loc.idx_ = i;
+    rowkeys.reuse();
+    tablet_ids.reuse();
+    if (OB_FAIL(rowkeys.push_back(const_cast<ObITableEntity&>(batch_operation.at(i).entity()).get_rowkey()))) {
+      LOG_WARN("fail to push back rowkey", K(ret), K(i));
+    } else if (OB_FAIL(get_tablet_by_rowkey(table_id, rowkeys, tablet_ids))) {
+      LOG_WARN("fail to get tablet id", K(ret), K(rowkeys));
+    } else if (OB_UNLIKELY(1 != tablet_ids.count())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("should have one tablet", K(ret), K(tablet_ids));
+    } else if (FALSE_IT(op_loc.tablet_id_ = tablet_ids.at(0))) {
+    } else if (OB_FAIL(get_ls_id(op_loc.tablet_id_, op_loc.ls_id_))) {
+      LOG_WARN("fail to get ls id", K(ret), K(op_loc));
+    } else if (OB_FAIL(exec_order.push_back(op_loc))) {
+      LOG_WARN("fail to push back op location", K(ret), K(op_loc));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    std::sort(exec_order.get_data(), exec_order.get_data() + exec_order.count());
+  }
+  return ret;
+}
+
+int64_t ObTableBatchExecuteP::get_tablet_group_end(const ObIArray<BatchOpLocation> &exec_order,
+                                                   const int64_t start)
+{
+  int64_t end = start + 1;
+  while (end < exec_order.count() && exec_order.at(end).tablet_id_ == exec_order.at(start).tablet_id_) {
+    ++end;
+  }
+  return end;
+}
+
+template<int TYPE>
+int ObTableBatchExecuteP::execute_tablet_group(const ObTableBatchOperation &batch_operation,
+                                               const ObIArray<BatchOpLocation> &exec_order,
+                                               const int64_t start,
+                                               const int64_t end)
+{
+  int ret = OB_SUCCESS;
+  ObTableApiCacheGuard cache_guard;
+  const ObTabletID &tablet_id = exec_order.at(start).tablet_id_;
+  SMART_VAR(table::ObTableCtx, group_tb_ctx, allocator_) {
+    // the table ctx and the spec are bound to the tablet of the group
+    auto get_spec = [&](const int64_t idx, ObTableApiSpec *&spec) -> int {
+      int ret = OB_SUCCESS;
+      if (OB_FAIL(init_single_op_tb_ctx(group_tb_ctx, batch_operation.at(idx), tablet_id))) {
+        LOG_WARN("fail to init table ctx", K(ret), K(tablet_id));
+      } else if (OB_FAIL(group_tb_ctx.init_trans(get_trans_desc(), get_tx_snapshot()))) {
+        LOG_WARN("fail to init trans", K(ret), K(group_tb_ctx));
+      } else if (OB_FAIL(ObTableOpWrapper::get_or_create_spec<TYPE>(group_tb_ctx, cache_guard, spec))) {
+        LOG_WARN("fail to get or create spec", K(ret), K(tablet_id));
+      }
+      return ret;
+    };
+    auto process_op = [&](const int64_t idx, ObTableApiSpec *spec, ObTableOperationResult &op_result) -> int {
+      int ret = OB_SUCCESS;
+      group_tb_ctx.set_entity(&batch_operation.at(idx).entity());
+      ObITableEntity *result_entity = result_.get_entity_factory()->alloc();
+      if (OB_ISNULL(result_entity)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to alloc entity", K(ret), K(idx));
+      } else if (FALSE_IT(op_result.set_entity(*result_entity))) {
+      } else if (OB_FAIL(ObTableOpWrapper::process_op_with_spec(group_tb_ctx, spec, op_result))) {
+        LOG_WARN("fail to process op with spec", K(ret), K(idx), K(tablet_id));
+        table::ObTableApiUtil::replace_ret_code(ret);
+      }
+      return ret;
+    };
+    if (OB_FAIL(process_tablet_group(exec_order, start, end, batch_ops_atomic_,
+                                     get_spec, process_op, result_))) {
+      LOG_WARN("fail to process tablet group", K(ret), K(start), K(end), K(tablet_id));
+    }
+  }
+  return ret;
+}
+
+int ObTableBatchExecuteP::multi_tablet_write(ObTableOperationType::Type op_type)
+{
+  int ret = OB_SUCCESS;
+  uint64_t table_id = OB_INVALID_ID;
+  ObLSID ls_id;
+  ObSEArray<BatchOpLocation, 16> exec_order;
+  const ObTableBatchOperation &batch_operation = arg_.batch_operation_;
+  observer::ObReqTimeGuard req_timeinfo_guard; // 引用cache资源必须加ObReqTimeGuard
+
+  if (OB_FAIL(check_arg2())) {
+    LOG_WARN("fail to check arg", K(ret));
+  } else if (OB_FAIL(get_table_id(arg_.table_name_, arg_.table_id_, table_id))) {
+    LOG_WARN("fail to get table id", K(ret));
+  } else if (OB_FAIL(get_batch_ls_id(tablet_ids_, ls_id))) {
+    LOG_WARN("fail to get ls id", K(ret), K_(tablet_ids));
+  } else if (OB_FAIL(get_batch_exec_order(batch_operation, table_id, exec_order))) {
+    LOG_WARN("fail to get batch execute order", K(ret), K(table_id));
+  } else if (OB_FAIL(result_.prepare_allocate(batch_operation.count()))) {
+    LOG_WARN("fail to prepare allocate result", K(ret), K(batch_operation.count()));
+  } else if (OB_FAIL(start_trans(false, /* is_readonly */
+                                 sql::stmt::T_INSERT,
+                                 arg_.consistency_level_,
+                                 table_id,
+                                 ls_id,
+                                 get_timeout_ts()))) {
+    LOG_WARN("fail to start transaction", K(ret));
+  } else {
+    for (int64_t start = 0, end = 0; OB_SUCC(ret) && start < exec_order.count(); start = end) {
+      end = get_tablet_group_end(exec_order, start);
+      switch (op_type) {
+        case ObTableOperationType::INSERT:
+          ret = execute_tablet_group<TABLE_API_EXEC_INSERT>(batch_operation, exec_order, start, end);
+          break;
+        case ObTableOperationType::DEL:
+          ret = execute_tablet_group<TABLE_API_EXEC_DELETE>(batch_operation, exec_order, start, end);
+          break;
+        case ObTableOperationType::REPLACE:
+          ret = execute_tablet_group<TABLE_API_EXEC_REPLACE>(batch_operation, exec_order, start, end);
+          break;
+        default:
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("unexpected operation type", K(ret), K(op_type));
+          break;
+      }
+      if (OB_FAIL(ret)) {
+        LOG_WARN("fail to execute tablet group", K(ret), K(start), K(end), K(exec_order.at(start)));
+      }
+    }
+  }
+
+  int tmp_ret = ret;
+  if (OB_FAIL(end_trans(OB_SUCCESS != ret, req_, get_timeout_ts()))) {
+    LOG_WARN("fail to end trans");
+  }
+  ret = (OB_SUCCESS == tmp_ret) ? ret : tmp_ret;
+  return ret;
+}
+
 int ObTableBatchExecuteP::batch_execute_internal(const ObTableBatchOperation &batch_operation,
+                                                 uint64_t table_id,
+                                                 bool group_by_ls,
                                                  ObTableBatchOperationResult &result)
 {
   int ret = OB_SUCCESS;
+  ObSEArray<BatchOpLocation, 16> exec_order;
+  if (!group_by_ls) {
+    // execute in request order
+  } else if (OB_FAIL(get_batch_exec_order(batch_operation, table_id, exec_order))) {
+    LOG_WARN("fail to get batch execute order", K(ret), K(table_id));
+  } else if (OB_FAIL(result.prepare_allocate(batch_operation.count()))) {
+    LOG_WARN("fail to prepare allocate result", K(ret), K(batch_operation.count()));
+  }
   // loop: process each op
-  for (int64_t i = 0; OB_SUCC(ret) && i < batch_operation.count(); ++i) {
+  for (int64_t k = 0; OB_SUCC(ret) && k < batch_operation.count(); ++k) {
+    const int64_t i = group_by_ls ? exec_order.at(k).idx_ : k;
+    const ObTabletID tablet_id = group_by_ls ? exec_order.at(k).tablet_id_ : arg_.tablet_id_;
     const ObTableOperation &table_operation = batch_operation.at(i);
     ObTableOperationResult op_result;
     ObITableEntity *result_entity = result.get_entity_factory()->alloc();
 
     SMART_VAR(table::ObTableCtx, op_tb_ctx, allocator_) {
-      if (OB_FAIL(init_single_op_tb_ctx(op_tb_ctx, table_operation))) {
+      if (OB_FAIL(init_single_op_tb_ctx(op_tb_ctx, table_operation, tablet_id))) {
         LOG_WARN("fail to init table ctx for single operation", K(ret));
       }  else if (OB_FAIL(op_tb_ctx.init_trans(get_trans_desc(), get_tx_snapshot()))) {
         LOG_WARN("fail to init trans", K(ret), K(op_tb_ctx));
@@ -750,8 +955,13 @@ int ObTableBatchExecuteP::batch_execute_internal(const ObTableBatchOperation &ba
       }
     }
     if (OB_SUCC(ret)) {
-      if (OB_FAIL(result.push_back(op_result))) {
+      if (group_by_ls) {
+        // results are returned in request order
+        result.at(i) = op_result;
+      } else if (OB_FAIL(result.push_back(op_result))) {
         LOG_WARN("fail to push back result", K(ret));
+      }
+      if (OB_FAIL(ret)) {
       } else if (batch_ops_atomic_ && OB_FAIL(op_result.get_errno())) {
         LOG_WARN("fail to execute one operation when batch execute as atomic", K(ret), K(table_operation));
       }
@@ -764,6 +974,13 @@ int ObTableBatchExecuteP::batch_execute_internal(const ObTableBatchOperation &ba
 
 int ObTableBatchExecuteP::init_single_op_tb_ctx(table::ObTableCtx &ctx,
                                                 const ObTableOperation &table_operation)
+{
+  return init_single_op_tb_ctx(ctx, table_operation, arg_.tablet_id_);
+}
+
+int ObTableBatchExecuteP::init_single_op_tb_ctx(table::ObTableCtx &ctx,
+                                                const ObTableOperation &table_operation,
+                                                const ObTabletID &tablet_id)
 {
   int ret = OB_SUCCESS;
   ctx.set_entity(&table_operation.entity());
@@ -773,7 +990,7 @@ int ObTableBatchExecuteP::init_single_op_tb_ctx(table::ObTableCtx &ctx,
   if (ctx.is_init()) {
     LOG_INFO("tb ctx has been inited", K(ctx));
   } else if (OB_FAIL(ctx.init_common(credential_,
-                                     arg_.tablet_id_,
+                                     tablet_id,
                                      arg_.table_name_,
                                      get_timeout_ts()))) {
     LOG_WARN("fail to init table ctx common part", K(ret), K(arg_.table_name_));
@@ -55,6 +55,8 @@ private:
   int check_arg2() const;
   int get_rowkeys(common::ObIArray<common::ObRowkey> &rowkeys);
   int get_tablet_ids(uint64_t table_id, ObIArray<ObTabletID> &tablet_ids);
+  // @ls_id is invalid if the tablets are in different log streams
+  int get_batch_ls_id(const ObIArray<ObTabletID> &tablet_ids, share::ObLSID &ls_id);
   int multi_get();
   int multi_delete();
   int multi_insert();
@@ -64,11 +66,63 @@ private:
   int htable_mutate_row();
 
   // for batch execute
+  struct BatchOpLocation
+  {
+    BatchOpLocation() : idx_(0), tablet_id_(), ls_id_() {}
+    // operations on the same row are always in one tablet, ordering by (ls_id, tablet_id, idx)
+    // keeps their relative order
+    bool operator<(const BatchOpLocation &other) const
+    {
+      bool bret = false;
+      if (ls_id_ != other.ls_id_) {
+        bret = ls_id_ < other.ls_id_;
+      } else if (tablet_id_ != other.tablet_id_) {
+        bret = tablet_id_ < other.tablet_id_;
+      } else {
+        bret = idx_ < other.idx_;
+      }
+      return bret;
+    }
+    TO_STRING_KV(K_(idx), K_(tablet_id), K_(ls_id));
+    int64_t idx_;
+    common::ObTabletID tablet_id_;
+    share::ObLSID ls_id_;
+  };
   int batch_execute(bool is_readonly);
+  // operations of a batch across log streams are executed grouped by log stream and tablet
+  int get_batch_exec_order(const table::ObTableBatchOperation &batch_operation,
+                           uint64_t table_id,
+                           common::ObIArray<BatchOpLocation> &exec_order);
+  // @return the end of the tablet group starting at @start of the sorted @exec_order
+  static int64_t get_tablet_group_end(const common::ObIArray<BatchOpLocation> &exec_order,
+                                      const int64_t start);
+  // insert/delete/replace of a batch across tablets, each tablet group shares one spec
+  int multi_tablet_write(table::ObTableOperationType::Type op_type);
+  template<int TYPE>
+  int execute_tablet_group(const table::ObTableBatchOperation &batch_operation,
+                           const common::ObIArray<BatchOpLocation> &exec_order,
+                           const int64_t start,
+                           const int64_t end);
+  // runs the tablet group [@start, @end) of the sorted @exec_order. @get_spec(idx, spec) is
+  // called once with the first operation of the group, @process_op(idx, spec, op_result)
+  // executes each operation with that spec, and its result is stored at @result.at(idx).
+  template<typename GetSpec, typename ProcessOp>
+  static int process_tablet_group(const common::ObIArray<BatchOpLocation> &exec_order,
+                                  const int64_t start,
+                                  const int64_t end,
+                                  const bool is_atomic,
+                                  GetSpec &get_spec,
+                                  ProcessOp &process_op,
+                                  table::ObTableBatchOperationResult &result);
   int batch_execute_internal(const table::ObTableBatchOperation &batch_operation,
+                             uint64_t table_id,
+                             bool group_by_ls,
                              table::ObTableBatchOperationResult &result);
   int init_single_op_tb_ctx(table::ObTableCtx &ctx,
                             const table::ObTableOperation &table_operation);
+  int init_single_op_tb_ctx(table::ObTableCtx &ctx,
+                            const table::ObTableOperation &table_operation,
+                            const common::ObTabletID &tablet_id);
   int process_get(table::ObTableCtx &op_tb_ctx, table::ObTableOperationResult &result);
   int execute_htable_delete(const table::ObTableBatchOperation &batch_operation);
   int execute_htable_put(const table::ObTableBatchOperation &batch_operation);
@@ -81,8 +135,43 @@ private:
   table::ObTableCtx tb_ctx_;
   bool need_rollback_trans_;
   bool batch_ops_atomic_;
+  // distinct tablets of the batch
+  common::ObSEArray<common::ObTabletID, 1> tablet_ids_;
 };
 
+template<typename GetSpec, typename ProcessOp>
+int ObTableBatchExecuteP::process_tablet_group(const common::ObIArray<BatchOpLocation> &exec_order,
+                                               const int64_t start,
+                                               const int64_t end,
+                                               const bool is_atomic,
+                                               GetSpec &get_spec,
+                                               ProcessOp &process_op,
+                                               table::ObTableBatchOperationResult &result)
+{
+  int ret = common::OB_SUCCESS;
+  table::ObTableApiSpec *spec = nullptr;
+  if (OB_UNLIKELY(start < 0 || start >= end || end > exec_order.count())) {
+    ret = common::OB_INVALID_ARGUMENT;
+    SERVER_LOG(WARN, "invalid tablet group", K(ret), K(start), K(end), K(exec_order.count()));
+  } else if (OB_FAIL(get_spec(exec_order.at(start).idx_, spec))) {
+    SERVER_LOG(WARN, "fail to get spec", K(ret), K(exec_order.at(start)));
+  }
+  for (int64_t k = start; OB_SUCC(ret) && k < end; ++k) {
+    const int64_t idx = exec_order.at(k).idx_;
+    table::ObTableOperationResult op_result;
+    if (OB_FAIL(process_op(idx, spec, op_result))) {
+      SERVER_LOG(WARN, "fail to process op with spec", K(ret), K(exec_order.at(k)));
+    } else {
+      // results are returned in request order
+      result.at(idx) = op_result;
+      if (is_atomic && OB_FAIL(op_result.get_errno())) {
+        SERVER_LOG(WARN, "fail to execute one operation when batch execute as atomic", K(ret), K(idx));
+      }
+    }
+  }
+  return ret;
+}
+
 } // end namespace observer
 } // end namespace oceanbase
 
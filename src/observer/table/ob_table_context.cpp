@@ -507,6 +507,118 @@ int ObTableCtx::generate_key_range(const ObIArray<ObNewRange> &scan_ranges)
   return ret;
 }
 
+// HBase Get scans the whole row [K, MIN, MIN] ~ [K, MAX, MAX] and the matcher drops the cells
+// of unselected qualifiers or out of the time range. When qualifiers are specified, scan only
+// [K, Q, -max_stamp + 1] ~ [K, Q, -min_stamp] for each qualifier Q instead (T is -timestamp).
+// Only the qualifiers and the time range are pushed down, as key ranges. The filter string is
+// still evaluated by ObHTableFilterOperator on the scanned cells, because the OBKV scan has no
+// pushdown filter exprs to compile it into.
+int ObTableCtx::narrow_htable_key_ranges(const ObHTableFilter &htable_filter)
+{
+  int ret = OB_SUCCESS;
+  static const int64_t HTABLE_ROWKEY_SIZE = 3; // K, Q, T
+  ObArray<sql::ObExprResType> columns_type;
+  ObSEArray<ObString, 16> qualifiers;
+  ObSEArray<ObNewRange, 16> origin_ranges;
+  const bool with_all_time = htable_filter.with_all_time();
+  const int64_t t_start = 1 - htable_filter.get_max_stamp();
+  const int64_t t_end = -htable_filter.get_min_stamp();
+
+  if (is_index_scan_
+      || ObQueryFlag::Forward != scan_order_
+      || htable_filter.get_columns().empty()
+      || (!with_all_time && t_start > t_end)) {
+    // do nothing
+  } else if (OB_FAIL(generate_columns_type(columns_type))) {
+    LOG_WARN("fail to generate columns type", K(ret));
+  } else if (HTABLE_ROWKEY_SIZE != columns_type.count()
+             || !ObCharset::is_bin_sort(columns_type.at(ObHTableConstants::COL_IDX_Q).get_collation_type())) {
+    // not a hbase table, or qualifiers are not in binary order as the column tracker expects
+  } else if (OB_FAIL(qualifiers.assign(htable_filter.get_columns()))) {
+    LOG_WARN("fail to assign qualifiers", K(ret));
+  } else if (OB_FAIL(origin_ranges.assign(key_ranges_))) {
+    LOG_WARN("fail to assign key ranges", K(ret));
+  } else {
+    std::sort(qualifiers.begin(), qualifiers.end());
+    key_ranges_.reuse();
+    for (int64_t i = 0; OB_SUCC(ret) && i < origin_ranges.count(); ++i) {
+      const ObNewRange &range = origin_ranges.at(i);
+      const ObRowkey &start_key = range.get_start_key();
+      const ObRowkey &end_key = range.get_end_key();
+      bool is_single_row = HTABLE_ROWKEY_SIZE == start_key.get_obj_cnt()
+          && HTABLE_ROWKEY_SIZE == end_key.get_obj_cnt()
+          && range.border_flag_.inclusive_start()
+          && range.border_flag_.inclusive_end();
+      if (is_single_row) {
+        const ObObj *start_objs = start_key.get_obj_ptr();
+        const ObObj *end_objs = end_key.get_obj_ptr();
+        const ObObj &k_obj = start_objs[ObHTableConstants::COL_IDX_K];
+        is_single_row = !k_obj.is_min_value() && !k_obj.is_max_value()
+            && k_obj == end_objs[ObHTableConstants::COL_IDX_K]
+            && start_objs[ObHTableConstants::COL_IDX_Q].is_min_value()
+            && start_objs[ObHTableConstants::COL_IDX_T].is_min_value()
+            && end_objs[ObHTableConstants::COL_IDX_Q].is_max_value()
+            && end_objs[ObHTableConstants::COL_IDX_T].is_max_value();
+      }
+      if (!is_single_row) {
+        if (OB_FAIL(key_ranges_.push_back(range))) {
+          LOG_WARN("fail to push back key range", K(ret), K(range));
+        }
+      } else {
+        const ObObj &k_obj = start_key.get_obj_ptr()[ObHTableConstants::COL_IDX_K];
+        for (int64_t j = 0; OB_SUCC(ret) && j < qualifiers.count(); ++j) {
+          ObObj *objs = nullptr;
+          if (j > 0 && qualifiers.at(j) == qualifiers.at(j - 1)) {
+            // duplicated qualifier
+          } else if (OB_ISNULL(objs = static_cast<ObObj*>(allocator_.alloc(
+              sizeof(ObObj) * HTABLE_ROWKEY_SIZE * 2)))) {
+            ret = OB_ALLOCATE_MEMORY_FAILED;
+            LOG_WARN("fail to alloc objs", K(ret));
+          } else {
+            ObObj *start_objs = objs;
+            ObObj *end_objs = objs + HTABLE_ROWKEY_SIZE;
+            start_objs[ObHTableConstants::COL_IDX_K] = k_obj;  // shallow copy
+            end_objs[ObHTableConstants::COL_IDX_K] = k_obj;
+            start_objs[ObHTableConstants::COL_IDX_Q].set_varbinary(qualifiers.at(j));
+            if (with_all_time) {
+              start_objs[ObHTableConstants::COL_IDX_T] = ObObj::make_min_obj();
+              end_objs[ObHTableConstants::COL_IDX_T] = ObObj::make_max_obj();
+            } else {
+              start_objs[ObHTableConstants::COL_IDX_T].set_int(t_start);
+              end_objs[ObHTableConstants::COL_IDX_T].set_int(t_end);
+            }
+            if (OB_FAIL(adjust_column_type(columns_type.at(ObHTableConstants::COL_IDX_Q),
+                                           start_objs[ObHTableConstants::COL_IDX_Q]))) {
+              LOG_WARN("fail to adjust column type", K(ret), K(start_objs[ObHTableConstants::COL_IDX_Q]));
+            } else if (!with_all_time
+                       && OB_FAIL(adjust_column_type(columns_type.at(ObHTableConstants::COL_IDX_T),
+                                                     start_objs[ObHTableConstants::COL_IDX_T]))) {
+              LOG_WARN("fail to adjust column type", K(ret), K(start_objs[ObHTableConstants::COL_IDX_T]));
+            } else {
+              end_objs[ObHTableConstants::COL_IDX_Q] = start_objs[ObHTableConstants::COL_IDX_Q];
+              if (!with_all_time) {
+                end_objs[ObHTableConstants::COL_IDX_T].set_meta_type(start_objs[ObHTableConstants::COL_IDX_T].get_meta());
+              }
+              ObNewRange qualifier_range;
+              qualifier_range.table_id_ = range.table_id_;
+              qualifier_range.start_key_.assign(start_objs, HTABLE_ROWKEY_SIZE);
+              qualifier_range.end_key_.assign(end_objs, HTABLE_ROWKEY_SIZE);
+              qualifier_range.border_flag_.set_inclusive_start();
+              qualifier_range.border_flag_.set_inclusive_end();
+              if (OB_FAIL(key_ranges_.push_back(qualifier_range))) {
+                LOG_WARN("fail to push back key range", K(ret), K(qualifier_range));
+              }
+            }
+          }
+        }
+      }
+    }
+    LOG_DEBUG("narrow htable key ranges", K(ret), K(origin_ranges), K_(key_ranges));
+  }
+
+  return ret;
+}
+
 int ObTableCtx::init_scan(const ObTableQuery &query,
                           const bool &is_wead_read)
 {
@@ -548,6 +660,9 @@ int ObTableCtx::init_scan(const ObTableQuery &query,
     // init key_ranges_
     if (OB_FAIL(generate_key_range(query.get_scan_ranges()))) {
       LOG_WARN("fail to generate key ranges", K(ret));
+    } else if (query.get_htable_filter().is_valid()
+               && OB_FAIL(narrow_htable_key_ranges(query.get_htable_filter()))) {
+      LOG_WARN("fail to narrow htable key ranges", K(ret));
     } else {
       // select_col_ids用schema序
       for (ObTableSchema::const_column_iterator iter = table_schema_->column_begin();
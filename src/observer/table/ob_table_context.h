@@ -268,6 +268,7 @@ private:
   int init_index_info(const common::ObString &index_name);
   int generate_columns_type(common::ObIArray<sql::ObExprResType> &columns_type);
   int generate_key_range(const common::ObIArray<common::ObNewRange> &scan_ranges);
+  int narrow_htable_key_ranges(const ObHTableFilter &htable_filter);
   // for dml
   int init_dml_related_tid();
   // for update
@@ -60,6 +60,15 @@ SQL_MONITOR_STATNAME_DEF(SSTABLE_INSERT_ROW_COUNT, sql_monitor_statname::INT, "s
 SQL_MONITOR_STATNAME_DEF(IO_READ_BYTES, sql_monitor_statname::CAPACITY, "total io bytes read from disk", "total io bytes read from storage")
 SQL_MONITOR_STATNAME_DEF(TOTAL_READ_BYTES, sql_monitor_statname::CAPACITY, "total bytes processed by storage", "total bytes processed by storage, including memtable")
 SQL_MONITOR_STATNAME_DEF(TOTAL_READ_ROW_COUNT, sql_monitor_statname::INT, "total rows processed by storage", "total rows processed by storage, including memtable")
+// skew aware exchange
+SQL_MONITOR_STATNAME_DEF(EXCHANGE_SKEW_VALUE_COUNT, sql_monitor_statname::INT, "skew value count", "popular values detected at runtime by exchange out op")
+SQL_MONITOR_STATNAME_DEF(EXCHANGE_SKEW_MAX_SLICE_ROWS_BEFORE, sql_monitor_statname::INT, "max worker rows by hash", "max rows sent to one worker if rows were hash distributed")
+SQL_MONITOR_STATNAME_DEF(EXCHANGE_SKEW_MAX_SLICE_ROWS_AFTER, sql_monitor_statname::INT, "max worker rows sent", "max rows sent to one worker by skew aware distribution")
+
+// adaptive join method
+SQL_MONITOR_STATNAME_DEF(JOIN_METHOD_CROSSOVER_ROW_COUNT, sql_monitor_statname::INT, "join method crossover row count", "outer (build) row count at which the other join method is expected to be cheaper")
+SQL_MONITOR_STATNAME_DEF(JOIN_METHOD_OUTER_ROW_COUNT, sql_monitor_statname::INT, "outer row count", "outer rows rescanning the inner side of nested loop join")
+SQL_MONITOR_STATNAME_DEF(JOIN_METHOD_SWITCH, sql_monitor_statname::INT, "join method switch", "0: keep join method, 1: switch to hash join, 2: switch to nested loop join, at next hard parse")
 
 //end
 SQL_MONITOR_STATNAME_DEF(MONITOR_STATNAME_END, sql_monitor_statname::INVALID, "monitor end", "monitor stat name end")
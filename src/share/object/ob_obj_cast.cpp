@@ -5894,7 +5894,7 @@ static int string_json(const ObObjType expect_type, ObObjCastParams &params,
     ObJsonOpaque j_opaque(j_text, in.get_type());
     ObJsonString j_string(j_text.ptr(), j_text.length());
     ObJsonNull j_null;
-    ObJsonNode *j_tree = NULL;
+    ObString raw_bin;
     uint32_t parse_flag = ObJsonParser::JSN_RELAXED_FLAG;
     if (expect_type == ObJsonType && j_text.length() == 0 && cast_mode == 0) { // add column json null
       j_base = &j_null;
@@ -5908,7 +5908,8 @@ static int string_json(const ObObjType expect_type, ObObjCastParams &params,
       // consistent with mysql: TINYTEXT, TEXT, MEDIUMTEXT, and LONGTEXT. We want to treat them like strings
       ret = OB_SUCCESS;
       j_base = &j_string;
-    } else if (OB_FAIL(ObJsonParser::get_tree(params.allocator_v2_, j_text, j_tree, parse_flag))) {
+    } else if (OB_FAIL(ObJsonParser::get_bin(params.allocator_v2_, j_text, raw_bin, parse_flag))) {
+      // json text is written to json binary while parsing, no json tree
       if (lib::is_mysql_mode() && CM_IS_IMPLICIT_CAST(cast_mode) && !CM_IS_COLUMN_CONVERT(cast_mode)) {
         ret = OB_SUCCESS;
         j_base = &j_string;
@@ -5922,13 +5923,10 @@ static int string_json(const ObObjType expect_type, ObObjCastParams &params,
           LOG_USER_ERROR(OB_ERR_INVALID_JSON_TEXT_IN_PARAM);  
         }
       }
-    } else {
-      j_base = j_tree;
     }
 
     if (OB_SUCC(ret)) {
-      ObString raw_bin;
-      if (OB_FAIL(j_base->get_raw_binary(raw_bin, params.allocator_v2_))) {
+      if (OB_NOT_NULL(j_base) && OB_FAIL(j_base->get_raw_binary(raw_bin, params.allocator_v2_))) {
         LOG_WARN("fail to get string json binary", K(ret), K(in), K(*j_base));
       } else if (OB_FAIL(set_json_bin_res(&params, &out, raw_bin))) {
         LOG_WARN("fail to fill json bin lob locator", K(ret));
@@ -245,6 +245,11 @@ DEF_CAP(_sort_area_size, OB_TENANT_PARAMETER, "128M", "[2M,]",
 DEF_CAP(_hash_area_size, OB_TENANT_PARAMETER, "100M", "[4M,]",
         "size of maximum memory that could be used by HASH JOIN. Range: [4M,+∞)",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_spill_compression_codec, OB_TENANT_PARAMETER, "none",
+                     common::ObConfigCompressFuncChecker,
+                     "compressor used for blocks dumped by sql operators. "
+                     "Values: none, lz4_1.0, snappy_1.0, zlib_1.0, zstd_1.0, zstd_1.3.8",
+                     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //
 DEF_BOOL(_enable_partition_level_retry, OB_CLUSTER_PARAMETER, "True",
@@ -341,6 +346,9 @@ DEF_BOOL(_mvcc_gc_using_min_txn_snapshot, OB_TENANT_PARAMETER, "True",
 DEF_BOOL(_rowsets_enabled, OB_TENANT_PARAMETER, "True",
          "specifies whether vectorized sql execution engine is activated",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_dml_batch_execution, OB_TENANT_PARAMETER, "False",
+         "specifies whether insert, update and delete operators of vectorized plans run in batch mode",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_rowsets_target_maxsize, OB_TENANT_PARAMETER, "524288", "[262144, 8388608]",
         "the size of the memory reserved for vectorized sql engine. Range: [262144, 8388608]",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -431,6 +439,12 @@ DEF_INT(_enable_hash_join_processor, OB_TENANT_PARAMETER, "7", "[1, 7]",
          "which path to process for hash join, default 7 to auto choose "
          "1: nest loop, 2: recursive, 4: in-memory",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_adaptive_join_crossover_ratio, OB_TENANT_PARAMETER, "100", "[0,)",
+        "how many times the observed outer rows of a nested loop join (build rows of a hash join) "
+        "can be more (less) than estimated before the join method is considered wrong. "
+        "A cached plan running into it in most of its sampled executions is generated again. "
+        "0 : disable the check",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_pushdown_storage_level, OB_TENANT_PARAMETER, "3", "[0, 3]",
         "the level of storage pushdown. Range: [0, 3] "
         "0: disabled, 1:blockscan, 2: blockscan & filter, 3: blockscan & filter & aggregate",
@@ -894,6 +908,17 @@ DEF_INT(micro_block_merge_verify_level, OB_CLUSTER_PARAMETER, "2", "[0,3]",
         "2 : verify encoding and compression algorithm, besides encoding verification, compressed block will be decompressed to ensure data is correct"
         "3 : verify encoding, compression algorithm and lost write protect",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_encoding_planned_encoder_count, OB_CLUSTER_PARAMETER, "0", "[0,16]",
+        "the number of encoders built for each column of an encoded micro block, "
+        "which are chosen by the size estimated from sampled column statistics. "
+        "Smaller value costs less cpu in compaction with a possibly worse compression ratio. "
+        "0 : try all the encoders",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_compaction_compress_thread_count, OB_CLUSTER_PARAMETER, "0", "[0,8]",
+        "the number of tenant threads shared by the macro block writers of major compaction to "
+        "compress and verify micro blocks, while the compaction threads keep encoding the next ones. "
+        "0 : compress micro blocks in the compaction thread",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_INT(_migrate_block_verify_level, OB_CLUSTER_PARAMETER, "1", "[0,2]",
         "specify what kind of verification should be done when migrating macro block. "
@@ -1049,6 +1074,15 @@ DEF_TIME(_backup_task_keep_alive_timeout, OB_CLUSTER_PARAMETER, "10m", "[1s,)",
          "control backup task keep alive timeout"
          "Range: [1s, +∞)",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_backup_io_thread_count, OB_CLUSTER_PARAMETER, "0", "[0,8]",
+        "the number of threads each backup data file uses to upload its buffers, while the backup thread "
+        "keeps filling the next ones. Buffers are uploaded in order by one thread for object storage. "
+        "0 : upload buffers in the backup thread",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_backup_meta_compression, OB_CLUSTER_PARAMETER, "False",
+         "whether to compress index and meta blocks of backup data files with zstd, "
+         "backup sets written with it can not be restored by versions that do not decompress them",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 
 DEF_BOOL(ob_enable_batched_multi_statement, OB_TENANT_PARAMETER, "False",
@@ -1059,6 +1093,11 @@ DEF_BOOL(_enable_dist_data_access_service, OB_TENANT_PARAMETER, "True",
          "enable use das service",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
+DEF_BOOL(_enable_lob_meta_block_cache, OB_TENANT_PARAMETER, "False",
+         "specifies whether lob meta scans keep the read micro blocks in block cache. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+
 DEF_INT(_bloom_filter_ratio, OB_CLUSTER_PARAMETER, "35", "[0, 100]",
         "the px bloom filter false-positive rate.the default value is 1, range: [0,100]",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -1412,6 +1451,11 @@ DEF_BOOL(_px_join_skew_handling, OB_TENANT_PARAMETER, "True",
 DEF_INT(_px_join_skew_minfreq, OB_TENANT_PARAMETER, "30", "[1,100]",
         "sets minimum frequency(%) for skewed value for parallel joins. Range: [1, 100] in integer",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_join_skew_detection, OB_TENANT_PARAMETER, "False",
+        "enables runtime skew detection for hash-hash distributed parallel hash joins, "
+        "the build side samples its rows and waits for the popular values decided by QC. "
+        "Works only when _px_join_skew_handling is enabled. The default value is False.",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_enable_protocol_diagnose, OB_CLUSTER_PARAMETER, "True",
         "enables protocol layer diagnosis. The default value is False.",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
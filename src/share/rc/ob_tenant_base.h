@@ -53,6 +53,7 @@ namespace sql {
 }
 namespace blocksstable {
   class ObSharedMacroBlockMgr;
+  class ObMicroBlockCompressService;
 }
 namespace storage {
   struct ObTenantStorageInfo;
@@ -182,6 +183,7 @@ using ObPartTransCtxObjPool = common::ObServerObjectPool<transaction::ObPartTran
       common::ObTenantIOManager*,                    \
       storage::ObStorageLogger*,                     \
       blocksstable::ObSharedMacroBlockMgr*,          \
+      blocksstable::ObMicroBlockCompressService*,    \
       storage::ObTenantMetaMemMgr*,                  \
       transaction::ObTransService*,                  \
       logservice::coordinator::ObLeaderCoordinator*, \
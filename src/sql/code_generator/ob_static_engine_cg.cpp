@@ -1990,6 +1990,30 @@ int ObStaticEngineCG::generate_spec(ObLogInsert &op,
   UNUSED(in_root_job);
   if (OB_FAIL(generate_insert_with_das(op, spec))) {
     LOG_WARN("generate insert with das failed", K(ret));
+  } else if (OB_FAIL(set_dml_batch_size(op, spec))) {
+    LOG_WARN("set dml batch size failed", K(ret));
+  }
+  return ret;
+}
+
+// Insert, update and delete are not registered as vectorized operators. Their batch path is only
+// enabled by _enable_dml_batch_execution, it checks the rows of a batch in one pass and writes
+// them to the DAS buffer grouped by tablet, see ObTableModifyOp::write_batch_by_tablet().
+int ObStaticEngineCG::set_dml_batch_size(ObLogicalOperator &op, ObTableModifySpec &spec)
+{
+  int ret = OB_SUCCESS;
+  spec.max_batch_size_ = 0;
+  if (OB_ISNULL(phy_plan_) || OB_ISNULL(op.get_plan())
+      || OB_ISNULL(op.get_plan()->get_optimizer_context().get_session_info())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected null", K(ret), KP(phy_plan_), KP(op.get_plan()));
+  } else if (phy_plan_->get_batch_size() > 0) {
+    const uint64_t tenant_id =
+        op.get_plan()->get_optimizer_context().get_session_info()->get_effective_tenant_id();
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id));
+    if (tenant_config.is_valid() && tenant_config->_enable_dml_batch_execution) {
+      spec.max_batch_size_ = phy_plan_->get_batch_size();
+    }
   }
   return ret;
 }
@@ -2251,7 +2275,11 @@ int ObStaticEngineCG::generate_spec(ObLogDelete &op,
 {
   UNUSED(in_root_job);
   int ret = OB_SUCCESS;
-  ret = generate_delete_with_das(op, spec);
+  if (OB_FAIL(generate_delete_with_das(op, spec))) {
+    LOG_WARN("generate delete with das failed", K(ret));
+  } else if (OB_FAIL(set_dml_batch_size(op, spec))) {
+    LOG_WARN("set dml batch size failed", K(ret));
+  }
   return ret;
 }
 
@@ -2312,6 +2340,7 @@ int ObStaticEngineCG::generate_spec(ObLogUpdate &op, ObTableUpdateSpec &spec, co
   int ret = OB_SUCCESS;
   CK(typeid(spec) == typeid(ObTableUpdateSpec));
   OZ(generate_update_with_das(op, spec));
+  OZ(set_dml_batch_size(op, spec));
   return ret;
 }
 
@@ -3002,6 +3031,90 @@ int ObStaticEngineCG::generate_spec(ObLogExchange &op, ObPxDistTransmitSpec &spe
                 spec.dist_hash_funcs_.at(0), *op.get_popular_values(), spec.popular_values_hash_))){
       LOG_WARN("fail generate popular values", K(ret));
     }
+  } else if (ObPQDistributeMethod::HASH == op.get_dist_method()
+             && OB_FAIL(generate_skew_detect_spec(op, spec))) {
+    LOG_WARN("fail to generate skew detect spec", K(ret));
+  }
+  return ret;
+}
+
+// Hash-hash distributed hash join enables runtime skew detection on both exchanges when
+// _px_join_skew_detection is on, see ObPxDistTransmitOp::do_skew_aware_hash_dist(). Only join types which do not
+// output the unmatched probe rows are supported, because the rows of popular values
+// on the probe side are broadcast.
+bool ObStaticEngineCG::is_skew_detect_exchange(const ObLogExchange &op)
+{
+  return op.is_producer()
+      && ObPQDistributeMethod::HASH == op.get_dist_method()
+      && 1 == op.get_hash_dist_exprs().count()
+      && !op.need_null_aware_shuffle()
+      && !const_cast<ObLogExchange &>(op).is_wf_hybrid()
+      && !const_cast<ObLogExchange &>(op).is_rollup_hybrid();
+}
+
+int ObStaticEngineCG::generate_skew_detect_spec(ObLogExchange &op,
+                                                ObPxDistTransmitSpec &spec)
+{
+  int ret = OB_SUCCESS;
+  ObSQLSessionInfo *session = NULL;
+  ObLogicalOperator *cur = op.get_parent();
+  ObLogicalOperator *parent = NULL;
+  spec.skew_detect_role_ = SKEW_DETECT_NONE;
+  spec.skew_detect_build_op_id_ = OB_INVALID_ID;
+  if (OB_ISNULL(op.get_plan())
+      || OB_ISNULL(session = op.get_plan()->get_optimizer_context().get_session_info())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is null", K(ret));
+  } else if (!session->get_px_join_skew_handling()
+             || !session->get_px_join_skew_detection()
+             || !is_skew_detect_exchange(op)
+             || OB_ISNULL(cur)
+             || log_op_def::LOG_EXCHANGE != cur->get_type()) {
+    // do nothing
+  } else {
+    // skip the join filters between the consumer exchange and the join
+    parent = cur->get_parent();
+    while (NULL != parent && log_op_def::LOG_JOIN_FILTER == parent->get_type()) {
+      cur = parent;
+      parent = parent->get_parent();
+    }
+  }
+  if (OB_SUCC(ret) && NULL != parent && log_op_def::LOG_JOIN == parent->get_type()) {
+    ObLogJoin *join = static_cast<ObLogJoin *>(parent);
+    const ObJoinType join_type = join->get_join_type();
+    if (HASH_JOIN != join->get_join_algo()
+        || DistAlgo::DIST_HASH_HASH != join->get_join_distributed_method()
+        || 1 != join->get_equal_join_conditions().count()
+        || (INNER_JOIN != join_type && LEFT_OUTER_JOIN != join_type
+            && LEFT_SEMI_JOIN != join_type && LEFT_ANTI_JOIN != join_type)) {
+      // do nothing
+    } else if (join->get_child(0) == cur) {
+      spec.skew_detect_role_ = SKEW_DETECT_BUILD;
+    } else {
+      // find the producer exchange of the build side
+      ObLogicalOperator *build = join->get_child(0);
+      while (NULL != build && log_op_def::LOG_JOIN_FILTER == build->get_type()) {
+        build = build->get_child(0);
+      }
+      if (NULL != build && log_op_def::LOG_EXCHANGE == build->get_type()
+          && !static_cast<ObLogExchange *>(build)->is_producer()) {
+        build = build->get_child(0);
+      }
+      if (NULL != build && log_op_def::LOG_EXCHANGE == build->get_type()
+          && is_skew_detect_exchange(*static_cast<ObLogExchange *>(build))) {
+        spec.skew_detect_role_ = SKEW_DETECT_PROBE;
+        spec.skew_detect_build_op_id_ = build->get_op_id();
+      }
+    }
+  }
+  if (OB_SUCC(ret) && SKEW_DETECT_BUILD == spec.skew_detect_role_) {
+    // the sampled rows are replayed after the popular values are decided
+    ObSEArray<ObExpr *, 16> sampling_saving_row;
+    OZ(append(sampling_saving_row, spec.get_child()->output_));
+    if (NULL != spec.random_expr_) {
+      OZ(sampling_saving_row.push_back(spec.random_expr_));
+    }
+    OZ(spec.sampling_saving_row_.assign(sampling_saving_row));
   }
   return ret;
 }
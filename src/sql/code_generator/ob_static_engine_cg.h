@@ -430,6 +430,7 @@ private:
                             common::ObIArray<ObExpr *> *not_exist_in_distinct,
                             common::ObIArray<ObExpr *> &output) const;
   int generate_insert_with_das(ObLogInsert &op, ObTableInsertSpec &spec);
+  int set_dml_batch_size(ObLogicalOperator &op, ObTableModifySpec &spec);
 
   int generate_exprs_replace_spk(const ObIArray<ObColumnRefRawExpr*> &index_exprs,
                                  ObIArray<ObExpr *> &access_exprs);
@@ -464,6 +465,10 @@ private:
   int generate_range_dist_spec(ObLogExchange &op,
       ObPxDistTransmitSpec &spec);
 
+  int generate_skew_detect_spec(ObLogExchange &op,
+      ObPxDistTransmitSpec &spec);
+  bool is_skew_detect_exchange(const ObLogExchange &op);
+
   int filter_sort_keys(
       ObLogExchange &op,
       const ObIArray<OrderItem> &old_sort_keys,
@@ -15,6 +15,7 @@
 #include "sql/code_generator/ob_static_engine_cg.h"
 #include "sql/engine/table/ob_table_scan_op.h"
 #include "sql/engine/basic/ob_pushdown_filter.h"
+#include "sql/engine/cmd/ob_load_data_parser.h"
 #include "share/inner_table/ob_inner_table_schema.h"
 namespace oceanbase
 {
@@ -434,13 +435,52 @@ int ObTscCgService::generate_tsc_filter(const ObLogTableScan &op, ObTableScanSpe
     }
   }
   if (OB_SUCC(ret)) {
+    bool is_parquet = false;
     if (OB_FAIL(cg_.generate_rt_exprs(nonpushdown_filters, spec.filters_))) {
       LOG_WARN("generate filter expr failed", K(ret));
+    } else if (nonpushdown_filters.empty()
+               || share::schema::EXTERNAL_TABLE != op.get_table_type()) {
+      // do nothing
+    } else if (OB_FAIL(is_parquet_external_table(op, is_parquet))) {
+      LOG_WARN("check parquet external table failed", K(ret));
+    } else if (is_parquet
+               && OB_FAIL(cg_.generate_rt_exprs(nonpushdown_filters,
+                                                scan_ctdef.pd_expr_spec_.pushdown_filters_))) {
+      // parquet scan only uses the filters to skip row groups by the statistics in files,
+      // they are still evaluated by the table scan operator.
+      LOG_WARN("generate external table pushdown filter failed", K(ret));
     }
   }
   return ret;
 }
 
+int ObTscCgService::is_parquet_external_table(const ObLogTableScan &op, bool &is_parquet)
+{
+  int ret = OB_SUCCESS;
+  const ObTableSchema *table_schema = nullptr;
+  ObSqlSchemaGuard *schema_guard = cg_.opt_ctx_->get_sql_schema_guard();
+  ObExternalFileFormat format;
+  ObArenaAllocator allocator("TscCgFormat");
+  is_parquet = false;
+  if (OB_ISNULL(schema_guard)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("schema guard is null", K(ret));
+  } else if (OB_FAIL(schema_guard->get_table_schema(op.get_table_id(),
+                                                    op.get_ref_table_id(),
+                                                    op.get_stmt(),
+                                                    table_schema))) {
+    LOG_WARN("get table schema failed", K(ret), K(op.get_ref_table_id()));
+  } else if (OB_ISNULL(table_schema)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("table schema is null", K(ret), K(op.get_ref_table_id()));
+  } else if (OB_FAIL(format.load_from_string(table_schema->get_external_file_format(), allocator))) {
+    LOG_WARN("load external file format failed", K(ret));
+  } else {
+    is_parquet = ObExternalFileFormat::PARQUET_FORMAT == format.format_type_;
+  }
+  return ret;
+}
+
 
 int ObTscCgService::generate_pd_storage_flag(const ObLogPlan *log_plan,
                                              const uint64_t ref_table_id,
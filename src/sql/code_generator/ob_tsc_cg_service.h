@@ -65,6 +65,7 @@ private:
   int extract_tsc_access_columns(const ObLogTableScan &op, common::ObIArray<ObRawExpr*> &access_exprs);
   int extract_das_column_ids(const common::ObIArray<ObRawExpr*> &column_exprs, common::ObIArray<uint64_t> &column_ids);
   int generate_geo_access_ctdef(const ObLogTableScan &op, const ObTableSchema &index_schema, ObArray<ObRawExpr*> &access_exprs);
+  int is_parquet_external_table(const ObLogTableScan &op, bool &is_parquet);
 private:
   ObStaticEngineCG &cg_;
 };
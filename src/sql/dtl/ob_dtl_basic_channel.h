@@ -99,6 +99,8 @@ static DtlWriterType msg_writer_map[] =
   CONTROL_WRITER, // DH_SECOND_STAGE_REPORTING_WF_WHOLE_MSG,
   CONTROL_WRITER, // DH_OPT_STATS_GATHER_PIECE_MSG,
   CONTROL_WRITER, // DH_OPT_STATS_GATHER_WHOLE_MSG,
+  CONTROL_WRITER, // DH_SKEW_DETECT_PIECE_MSG,
+  CONTROL_WRITER, // DH_SKEW_DETECT_WHOLE_MSG,
 };
 
 static_assert(ARRAYSIZEOF(msg_writer_map) == ObDtlMsgType::MAX, "invalid ms_writer_map size");
@@ -252,9 +254,16 @@ public:
   {
     register_block_ptr_ = block_ptr;
   }
+  // Rows are unswizzled so that the buffer can be copied or sent by rpc.
+  // A local channel hands the buffer over to the receiver, rows can be kept
+  // swizzled to save the unswizzling and swizzling passes of every row.
+  void set_unswizzling(const bool unswizzling) { unswizzling_ = unswizzling; }
   virtual void write_msg_type(ObDtlLinkedBuffer* buffer)
   {
     buffer->msg_type() = ObDtlMsgType::PX_DATUM_ROW;
+    if (!unswizzling_) {
+      buffer->set_swizzled();
+    }
   }
 private:
   DtlWriterType type_;
@@ -263,6 +272,7 @@ private:
   ObChunkDatumStore::Block** register_block_ptr_;
   ObChunkDatumStore::BlockBufferWrap* register_block_buf_ptr_;
   int write_ret_;
+  bool unswizzling_;
 };
 
 OB_INLINE int ObDtlDatumMsgWriter::write(
@@ -272,7 +282,8 @@ OB_INLINE int ObDtlDatumMsgWriter::write(
   const ObPxNewRow &px_row = static_cast<const ObPxNewRow&>(msg);
   const ObIArray<ObExpr *> *row = px_row.get_exprs();
   if (nullptr != row) {
-    if (OB_FAIL(block_->append_row(*row, eval_ctx, block_->get_buffer(), 0, nullptr, true))) {
+    if (OB_FAIL(block_->append_row(*row, eval_ctx, block_->get_buffer(), 0, nullptr,
+                                   unswizzling_))) {
       if (OB_BUF_NOT_ENOUGH != ret) {
         SQL_DTL_LOG(WARN, "failed to add row", K(ret));
       } else {
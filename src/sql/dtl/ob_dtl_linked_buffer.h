@@ -23,6 +23,9 @@ namespace sql {
 namespace dtl {
 
 #define DTL_BROADCAST (1ULL)
+// rows of the datum block keep absolute pointers, the buffer is handed over by a
+// local channel and must be read in place, never copied or sent by rpc.
+#define DTL_SWIZZLED (1ULL << 1)
 
 struct ObDtlMsgHeader;
 class ObDtlChannel;
@@ -151,7 +154,7 @@ public:
   {}
   ~ObDtlLinkedBuffer() { reset_batch_info(); }
   TO_STRING_KV(K_(size), K_(pos), K_(is_data_msg), K_(seq_no), K_(tenant_id), K_(allocated_chid),
-      K_(is_eof), K_(timeout_ts), K(msg_type_), K_(flags), K(is_bcast()), K_(enable_channel_sync));
+      K_(is_eof), K_(timeout_ts), K(msg_type_), K_(flags), K(is_bcast()), K(is_swizzled()), K_(enable_channel_sync));
 
   ObDtlLinkedBuffer *next() const {
     return reinterpret_cast<ObDtlLinkedBuffer*>(next_);
@@ -264,6 +267,14 @@ public:
     remove_flag(DTL_BROADCAST);
   }
 
+  bool is_swizzled() const {
+    return has_flag(DTL_SWIZZLED);
+  }
+
+  void set_swizzled() {
+    add_flag(DTL_SWIZZLED);
+  }
+
   uint64_t enable_channel_sync() const { return enable_channel_sync_; }
   void set_enable_channel_sync(const bool enable_channel_sync) { enable_channel_sync_ = enable_channel_sync; }
 
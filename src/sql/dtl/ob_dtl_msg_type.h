@@ -50,6 +50,8 @@ enum ObDtlMsgType {
   DH_SECOND_STAGE_REPORTING_WF_WHOLE_MSG,
   DH_OPT_STATS_GATHER_PIECE_MSG,
   DH_OPT_STATS_GATHER_WHOLE_MSG, //40
+  DH_SKEW_DETECT_PIECE_MSG,
+  DH_SKEW_DETECT_WHOLE_MSG,
   MAX
 };
 
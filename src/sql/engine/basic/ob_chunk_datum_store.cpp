@@ -19,6 +19,8 @@
 #include "lib/container/ob_se_array_iterator.h"
 #include "lib/utility/ob_tracepoint.h"
 #include "share/config/ob_server_config.h"
+#include "lib/compress/ob_compressor_pool.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -272,7 +274,9 @@ int ObChunkDatumStore::BlockBufferWrap::append_row(
       ObDatum &in_datum = static_cast<ObDatum&>(exprs.at(i)->locate_expr_datum(*ctx));
       ObDatum *datum = new (&sr->cells()[i])ObDatum();
       // Attension : can't print dst datum after deep_copy_unswizzling
-      if (OB_FAIL(deep_copy_unswizzling(in_datum, datum, head(), max_size, pos))) {
+      if (OB_FAIL(unswizzling_
+                  ? deep_copy_unswizzling(in_datum, datum, head(), max_size, pos)
+                  : datum->deep_copy(in_datum, head(), max_size, pos))) {
         if (OB_BUF_NOT_ENOUGH != ret) {
           LOG_WARN("failed to copy datum", K(ret), K(i), K(pos),
             K(max_size), K(in_datum));
@@ -488,7 +492,7 @@ ObChunkDatumStore::ObChunkDatumStore(common::ObIAllocator *alloc /* = NULL */)
     mem_hold_(0), mem_used_(0), max_hold_mem_(0),
     allocator_(NULL == alloc ? &inner_allocator_ : alloc),
     row_extend_size_(0), callback_(nullptr), batch_ctx_(NULL),
-    tmp_dump_blk_(nullptr)
+    tmp_dump_blk_(nullptr), compressor_(NULL), compress_buf_(NULL), compress_buf_size_(0)
 {
   io_.fd_ = -1;
   io_.dir_id_ = -1;
@@ -519,6 +523,36 @@ int ObChunkDatumStore::init(int64_t mem_limit,
   min_blk_size_ = INT64_MAX;
   io_.fd_ = -1;
   row_extend_size_ = row_extend_size;
+  compressor_ = NULL;
+  if (enable_dump_) {
+    ObCompressorType comp_type = NONE_COMPRESSOR;
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id));
+    if (!tenant_config.is_valid()) {
+      // dump without compression
+    } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor_type(
+                tenant_config->_spill_compression_codec.str(), comp_type))) {
+      LOG_WARN("get compressor type failed", K(ret));
+    } else if (OB_FAIL(set_dump_compressor(comp_type))) {
+      LOG_WARN("set dump compressor failed", K(ret), K(comp_type));
+    }
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::set_dump_compressor(const ObCompressorType type)
+{
+  int ret = OB_SUCCESS;
+  ObCompressor *compressor = NULL;
+  if (OB_UNLIKELY(is_file_open())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("can not change compressor after dumped", K(ret), K(type));
+  } else if (NONE_COMPRESSOR == type || INVALID_COMPRESSOR == type) {
+    compressor_ = NULL;
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(type, compressor))) {
+    LOG_WARN("get compressor failed", K(ret), K(type));
+  } else {
+    compressor_ = compressor;
+  }
   return ret;
 }
 
@@ -553,6 +587,9 @@ void ObChunkDatumStore::reset()
   cur_blk_buffer_ = nullptr;
   free_block(tmp_dump_blk_);
   tmp_dump_blk_ = nullptr;
+  free_blk_mem(compress_buf_, compress_buf_size_);
+  compress_buf_ = NULL;
+  compress_buf_size_ = 0;
   while (!free_list_.is_empty()) {
     Block *item = free_list_.remove_first();
     mem_hold_ -= item->get_buffer()->mem_size();
@@ -765,12 +802,13 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer *item)
                                       item->get_block()->blk_size_);
       tmp_dump_blk_->rows_ = item->get_block()->rows_;
       tmp_dump_blk_->get_buffer()->fast_advance(item->data_size() - BlockBuffer::HEAD_SIZE);
-      if (OB_FAIL(write_file(tmp_dump_blk_->get_buffer()->data(),
-                             tmp_dump_blk_->get_buffer()->capacity()))) {
+      if (OB_FAIL(write_block(tmp_dump_blk_->get_buffer()->data(),
+                              tmp_dump_blk_->get_buffer()->capacity(),
+                              tmp_dump_blk_->get_buffer()->data_size()))) {
         LOG_WARN("write block to file failed");
       }
     }
-  } else if (OB_FAIL(write_file(item->data(), item->capacity()))) {
+  } else if (OB_FAIL(write_block(item->data(), item->capacity(), item->data_size()))) {
     LOG_WARN("write block to file failed");
   }
   if (OB_SUCC(ret)) {
@@ -1997,6 +2035,52 @@ int ObChunkDatumStore::alloc_dir_id()
   return ret;
 }
 
+// Write the block of %size bytes, the first %data_size bytes of which are used.
+// The block is written as is if compression is disabled or doesn't save space,
+// otherwise only the compressed used part is written after a CompressedBlockHead.
+int ObChunkDatumStore::write_block(char *buf, const int64_t size, const int64_t data_size)
+{
+  int ret = OB_SUCCESS;
+  bool compressed = false;
+  int64_t comp_size = 0;
+  if (NULL != compressor_) {
+    const int64_t head_size = sizeof(CompressedBlockHead);
+    int64_t max_overflow_size = 0;
+    if (OB_FAIL(compressor_->get_max_overflow_size(data_size, max_overflow_size))) {
+      LOG_WARN("get max overflow size failed", K(ret), K(data_size));
+    } else if (compress_buf_size_ < head_size + data_size + max_overflow_size) {
+      const int64_t buf_size = next_pow2(head_size + data_size + max_overflow_size);
+      free_blk_mem(compress_buf_, compress_buf_size_);
+      compress_buf_size_ = 0;
+      if (OB_ISNULL(compress_buf_ = static_cast<char *>(alloc_blk_mem(buf_size, false)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret), K(buf_size));
+      } else {
+        compress_buf_size_ = buf_size;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(compressor_->compress(buf, data_size, compress_buf_ + head_size,
+                                             compress_buf_size_ - head_size, comp_size))) {
+      LOG_WARN("compress block failed", K(ret), K(data_size), K_(compress_buf_size));
+    } else if (head_size + comp_size < size) {
+      CompressedBlockHead *head = new (compress_buf_) CompressedBlockHead();
+      head->blk_size_ = static_cast<uint32>(size);
+      head->comp_size_ = static_cast<uint32>(comp_size);
+      compressed = true;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (compressed) {
+    if (OB_FAIL(write_file(compress_buf_, sizeof(CompressedBlockHead) + comp_size))) {
+      LOG_WARN("write compressed block to file failed", K(ret), K(size), K(comp_size));
+    }
+  } else if (OB_FAIL(write_file(buf, size))) {
+    LOG_WARN("write block to file failed", K(ret), K(size));
+  }
+  return ret;
+}
+
 int ObChunkDatumStore::write_file(void *buf, int64_t size)
 {
   int ret = OB_SUCCESS;
@@ -2106,6 +2190,8 @@ int ObChunkDatumStore::aio_read_file(
   } else if (size > 0) {
     this->set_io(size, static_cast<char *>(buf));
     io_.io_desc_.set_wait_event(ObWaitEventIds::ROW_STORE_DISK_READ);
+    // dumped blocks are read sequentially, don't pollute tmp page cache
+    io_.disable_page_cache_ = true;
     if (OB_FAIL(FILE_MANAGER_INSTANCE_V2.aio_pread(io_, offset, handle))) {
       if (OB_ITER_END != ret) {
         LOG_WARN("read form file failed", K(ret), K(io_), K(offset));
@@ -2331,6 +2417,11 @@ void ObChunkDatumStore::free_tmp_dump_blk()
     free_block(tmp_dump_blk_);
     tmp_dump_blk_ = nullptr;
   }
+  if (NULL != compress_buf_) {
+    free_blk_mem(compress_buf_, compress_buf_size_);
+    compress_buf_ = NULL;
+    compress_buf_size_ = 0;
+  }
 }
 
 
@@ -2458,7 +2549,12 @@ int ObChunkDatumStore::Iterator::read_next_blk()
       LOG_WARN("aio wait failed", K(ret));
     }
   }
-  if (OB_SUCC(ret) && !aio_blk_->magic_check()) {
+  if (OB_FAIL(ret)) {
+  } else if (reinterpret_cast<CompressedBlockHead *>(aio_blk_)->magic_check()) {
+    if (OB_FAIL(decompress_aio_blk())) {
+      LOG_WARN("decompress block failed", K(ret));
+    }
+  } else if (!aio_blk_->magic_check()) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("read corrupt data", K(ret), K(aio_blk_->magic_),
              K(store_->file_size_), K(cur_iter_pos_));
@@ -2508,6 +2604,58 @@ int ObChunkDatumStore::Iterator::read_next_blk()
   return ret;
 }
 
+// Replace the loaded compressed block with the decompressed one, and move the read
+// position to the end of the compressed block, which is usually shorter than the prefetch size.
+int ObChunkDatumStore::Iterator::decompress_aio_blk()
+{
+  int ret = OB_SUCCESS;
+  const CompressedBlockHead head = *reinterpret_cast<CompressedBlockHead *>(aio_blk_);
+  const int64_t loaded_len = aio_blk_buf_->capacity();
+  Block *blk = NULL;
+  int64_t data_size = 0;
+  if (OB_ISNULL(store_->compressor_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("read compressed block without compressor", K(ret), K(head));
+  } else if (head.unit_size() > loaded_len) {
+    // compressed block is larger than min block, read the rest
+    if (OB_FAIL(alloc_block(blk, head.unit_size() + sizeof(BlockBuffer)))) {
+      LOG_WARN("alloc block failed", K(ret), K(head));
+    } else {
+      BlockBuffer *blk_buf = blk->get_buffer();
+      MEMCPY(blk, aio_blk_, loaded_len);
+      free_block(aio_blk_, aio_blk_buf_->mem_size());
+      aio_blk_ = blk;
+      aio_blk_buf_ = blk_buf;
+      blk = NULL;
+      if (OB_FAIL(aio_read((char *)aio_blk_ + loaded_len, head.unit_size() - loaded_len))) {
+        LOG_WARN("aio read failed", K(ret));
+      } else if (OB_FAIL(aio_wait())) {
+        LOG_WARN("aio wait failed", K(ret));
+      }
+    }
+  } else {
+    cur_iter_pos_ -= loaded_len - head.unit_size();
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(alloc_block(blk, head.blk_size_ + sizeof(BlockBuffer)))) {
+    LOG_WARN("alloc block failed", K(ret), K(head));
+  } else {
+    BlockBuffer *blk_buf = blk->get_buffer();
+    if (OB_FAIL(store_->compressor_->decompress((char *)aio_blk_ + sizeof(CompressedBlockHead),
+                                                head.comp_size_, (char *)blk,
+                                                blk_buf->capacity(), data_size))) {
+      LOG_WARN("decompress block failed", K(ret), K(head));
+    } else if (OB_UNLIKELY(!blk->magic_check() || blk->blk_size_ != head.blk_size_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("read corrupt data", K(ret), K(head), K(*blk), K(data_size));
+    }
+    free_block(aio_blk_, aio_blk_buf_->mem_size());
+    aio_blk_ = blk;
+    aio_blk_buf_ = blk_buf;
+  }
+  return ret;
+}
+
 int ObChunkDatumStore::Iterator::prefetch_next_blk()
 {
   int ret = OB_SUCCESS;
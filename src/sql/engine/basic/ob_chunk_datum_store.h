@@ -23,6 +23,7 @@
 #include "share/datum/ob_datum.h"
 #include "sql/engine/expr/ob_expr.h"
 #include "storage/blocksstable/ob_tmp_file.h"
+#include "lib/compress/ob_compressor.h"
 #include "sql/engine/basic/ob_sql_mem_callback.h"
 #include "sql/engine/basic/ob_batch_result_holder.h"
 
@@ -482,6 +483,21 @@ public:
     char payload_[0];
   } __attribute__((packed));
 
+  // Head of a compressed block in dumped file, followed by the compressed data of the
+  // whole block (block head included). Has the same layout as the block head, the
+  // reader tells them apart by magic.
+  struct CompressedBlockHead
+  {
+    static const int64_t MAGIC = 0xbc054e02d8536316;
+    CompressedBlockHead() : magic_(MAGIC), blk_size_(0), comp_size_(0) {}
+    inline bool magic_check() const { return MAGIC == magic_; }
+    inline int64_t unit_size() const { return sizeof(CompressedBlockHead) + comp_size_; }
+    TO_STRING_KV(K_(magic), K_(blk_size), K_(comp_size));
+    int64_t magic_;
+    uint32 blk_size_;  /* blk_size_ of the uncompressed block */
+    uint32 comp_size_;
+  } __attribute__((packed));
+
   struct BlockList
   {
   public:
@@ -594,14 +610,17 @@ public:
 
   class BlockBufferWrap : public BlockBuffer {
   public:
-    BlockBufferWrap() : BlockBuffer(), rows_(0) {}
+    BlockBufferWrap() : BlockBuffer(), rows_(0), unswizzling_(true) {}
 
     int append_row(const common::ObIArray<ObExpr*> &exprs,
                    ObEvalCtx *ctx, int64_t row_extend_size);
     void reset() { rows_ = 0; BlockBuffer::reset(); }
+    // keep datum pointers absolute if the block is read in place by a local consumer
+    void set_unswizzling(const bool unswizzling) { unswizzling_ = unswizzling; }
 
   public:
     uint32_t rows_;
+    bool unswizzling_;
   };
 
   class RowIterator
@@ -757,6 +776,7 @@ public:
     inline void set_read_mem_iter_end() { iter_end_flag_ |= MEM_ITER_END; }
     int prefetch_next_blk();
     int read_next_blk();
+    int decompress_aio_blk();
     int aio_read(char *buf, const int64_t size);
     int aio_wait();
     int alloc_block(Block *&blk, const int64_t size);
@@ -902,6 +922,8 @@ public:
   //void set_tenant_id(const uint64_t tenant_id) { tenant_id_ = tenant_id; }
   //void set_mem_ctx_id(const int64_t ctx_id) { ctx_id_ = ctx_id; }
   void set_mem_limit(const int64_t limit) { mem_limit_ = limit; }
+  // compress blocks before dumping, must be set before the first dump
+  int set_dump_compressor(const common::ObCompressorType type);
   void set_dumped(bool dumped) { enable_dump_ = dumped; }
   inline int64_t get_mem_limit() { return mem_limit_; }
   void set_block_size(const int64_t size) { default_block_size_ = size; }
@@ -996,6 +1018,7 @@ private:
     }
   inline int dump_one_block(BlockBuffer *item);
 
+  int write_block(char *buf, const int64_t size, const int64_t data_size);
   int write_file(void *buf, int64_t size);
   int read_file(
       void *buf, const int64_t size, const int64_t offset, blocksstable::ObTmpFileIOHandle &handle,
@@ -1088,6 +1111,9 @@ private:
   ObSqlMemoryCallback *callback_;
   BatchCtx *batch_ctx_;
   Block *tmp_dump_blk_;
+  common::ObCompressor *compressor_; // compressor for dumped blocks, NULL if not compressed
+  char *compress_buf_;
+  int64_t compress_buf_size_;
 
   DISALLOW_COPY_AND_ASSIGN(ObChunkDatumStore);
 };
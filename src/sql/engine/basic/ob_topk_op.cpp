@@ -82,6 +82,45 @@ int ObTopKOp::inner_get_next_row()
   return ret;
 }
 
+// Batch version of ObTopKOp::inner_get_next_row
+int ObTopKOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t batch_cnt = min(max_row_cnt, MY_SPEC.max_batch_size_);
+  const ObBatchRows *child_brs = NULL;
+  clear_evaluated_flag();
+  if (output_count_ > 0 && output_count_ >= topk_final_count_) {
+    brs_.size_ = 0;
+    brs_.end_ = true;
+  } else {
+    if (output_count_ > 0) {
+      batch_cnt = min(batch_cnt, topk_final_count_ - output_count_);
+    }
+    if (OB_FAIL(child_->get_next_batch(batch_cnt, child_brs))) {
+      LOG_WARN("child get next batch failed", K(ret), K(output_count_), K(topk_final_count_));
+    } else if (FALSE_IT(brs_.copy(child_brs))) {
+    } else if (0 == output_count_ && child_brs->size_ > 0
+               && OB_FAIL(get_topk_final_count())) {
+      // topk count depends on row count of child, which is known after child returns rows
+      LOG_WARN("get topk count failed", K(ret));
+    } else if (OB_UNLIKELY(0 == topk_final_count_)) {
+      brs_.size_ = 0;
+      brs_.end_ = true;
+    } else {
+      for (int64_t i = 0; i < brs_.size_; i++) {
+        if (brs_.skip_->at(i)) {
+        } else if (output_count_ < topk_final_count_) {
+          ++output_count_;
+        } else {
+          brs_.skip_->set(i);
+        }
+      }
+      // Don't mark brs_.end_ when topk count reached, end iterating in next round
+    }
+  }
+  return ret;
+}
+
 int ObTopKOp::get_topk_final_count()
 {
   int ret = OB_SUCCESS;
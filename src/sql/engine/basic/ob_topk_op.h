@@ -48,6 +48,7 @@ public:
   virtual int inner_rescan() override;
 
   virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
 
   virtual void destroy() override { ObOperator::destroy(); }
 
@@ -18,6 +18,7 @@
 #include "lib/utility/ob_print_utils.h"
 #include "lib/string/ob_hex_utils_base.h"
 #include "deps/oblib/src/lib/list/ob_dlist.h"
+#include "storage/blocksstable/encoding/ob_encoding_query_util.h"
 
 using namespace oceanbase::sql;
 using namespace oceanbase::common;
@@ -30,6 +31,7 @@ const char INVALID_TERM_CHAR = '\xff';
 
 const char * FORMAT_TYPE_STR[] = {
   "CSV",
+  "PARQUET",
 };
 static_assert(array_elements(FORMAT_TYPE_STR) == ObExternalFileFormat::MAX_FORMAT, "Not enough initializer for ObExternalFileFormat");
 
@@ -58,6 +60,41 @@ int ObCSVGeneralFormat::init_format(const ObDataInFileStruct &format,
 }
 
 
+typedef void (*CSVStructuralIndexFunc)(const char *str, const int64_t len,
+                                       const char *chars, const int64_t char_cnt,
+                                       const bool with_non_ascii, uint64_t *bitmaps);
+extern void csv_build_structural_index_simd(const char *str, const int64_t len,
+                                            const char *chars, const int64_t char_cnt,
+                                            const bool with_non_ascii, uint64_t *bitmaps);
+
+static void csv_build_structural_index_normal(const char *str, const int64_t len,
+                                              const char *chars, const int64_t char_cnt,
+                                              const bool with_non_ascii, uint64_t *bitmaps)
+{
+  for (int64_t block_begin = 0, block_idx = 0; block_begin < len; block_begin += 64, block_idx++) {
+    const int64_t block_len = len - block_begin < 64 ? len - block_begin : 64;
+    uint64_t mask = 0;
+    for (int64_t i = 0; i < block_len; i++) {
+      const char c = str[block_begin + i];
+      bool is_structural = with_non_ascii && 0 != (c & 0x80);
+      for (int64_t j = 0; !is_structural && j < char_cnt; j++) {
+        is_structural = (c == chars[j]);
+      }
+      mask |= static_cast<uint64_t>(is_structural) << i;
+    }
+    bitmaps[block_idx] = mask;
+  }
+}
+
+static CSVStructuralIndexFunc get_csv_structural_index_func()
+{
+  return blocksstable::is_avx512_valid()
+      ? csv_build_structural_index_simd
+      : csv_build_structural_index_normal;
+}
+
+static CSVStructuralIndexFunc csv_build_structural_index = get_csv_structural_index_func();
+
 int ObCSVGeneralParser::init(const ObDataInFileStruct &format,
                              int64_t file_column_nums,
                              ObCollationType file_cs_type)
@@ -105,6 +142,23 @@ int ObCSVGeneralParser::init_opt_variables()
         && !opt_param_.is_same_escape_enclosed_
         && format_.field_enclosed_char_ == INT64_MAX;
 
+    structural_char_cnt_ = 0;
+    structural_chars_[structural_char_cnt_++] = opt_param_.field_term_c_;
+    structural_chars_[structural_char_cnt_++] = opt_param_.line_term_c_;
+    if (format_.field_enclosed_char_ != INT64_MAX) {
+      structural_chars_[structural_char_cnt_++] = static_cast<char>(format_.field_enclosed_char_);
+    }
+    if (format_.field_escaped_char_ != INT64_MAX) {
+      structural_chars_[structural_char_cnt_++] = static_cast<char>(format_.field_escaped_char_);
+    }
+    index_non_ascii_ = (CHARSET_UTF8MB4 == format_.cs_type_
+                        || CHARSET_GBK == format_.cs_type_
+                        || CHARSET_GB18030 == format_.cs_type_
+                        || CHARSET_GB18030_2022 == format_.cs_type_);
+    // scanning byte by byte is faster than building the index without SIMD
+    use_structural_index_ = blocksstable::is_avx512_valid();
+    index_begin_ = nullptr;
+    index_end_ = nullptr;
   }
 
   if (OB_SUCC(ret) && OB_FAIL(fields_per_line_.prepare_allocate(format_.file_column_nums_))) {
@@ -113,6 +167,17 @@ int ObCSVGeneralParser::init_opt_variables()
   return ret;
 }
 
+void ObCSVGeneralParser::build_structural_index(const char *str, const char *end)
+{
+  const int64_t window_size = STRUCTURAL_BLOCK_SIZE * STRUCTURAL_BLOCK_CNT;
+  const int64_t len = end - str < window_size ? end - str : window_size;
+  MEMSET(structural_index_, 0, sizeof(structural_index_));
+  csv_build_structural_index(str, len, structural_chars_, structural_char_cnt_,
+                             index_non_ascii_, structural_index_);
+  index_begin_ = str;
+  index_end_ = str + len;
+}
+
 int ObCSVGeneralParser::handle_irregular_line(int field_idx, int line_no,
                                               ObIArray<LineErrRec> &errors)
 {
@@ -346,6 +411,8 @@ int64_t ObExternalFileFormat::to_string(char *buf, const int64_t buf_len) const
       pos += csv_format_.to_json_kv_string(buf + pos, buf_len - pos);
       pos += origin_file_format_str_.to_json_kv_string(buf + pos, buf_len - pos);
       break;
+    case PARQUET_FORMAT:
+      break;
     default:
       pos = 0;
   }
@@ -389,6 +456,8 @@ int ObExternalFileFormat::load_from_string(const ObString &str, ObIAllocator &al
           OZ (csv_format_.load_from_json_data(format_type_node, allocator));
           OZ (origin_file_format_str_.load_from_json_data(format_type_node, allocator));
           break;
+        case PARQUET_FORMAT:
+          break;
         default:
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("invalid format type", K(ret), K(format_type_str));
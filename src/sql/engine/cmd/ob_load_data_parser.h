@@ -120,7 +120,10 @@ public:
     bool is_simple_format_;
   };
 public:
-  ObCSVGeneralParser() {}
+  ObCSVGeneralParser()
+    : use_structural_index_(false), index_non_ascii_(false), structural_char_cnt_(0),
+      index_begin_(nullptr), index_end_(nullptr)
+  {}
   int init(const ObCSVGeneralFormat &format);
 
   int init(const ObDataInFileStruct &format,
@@ -165,9 +168,16 @@ public:
     return ret;
   }
   common::ObIArray<FieldValue>& get_fields_per_line() { return fields_per_line_; }
+  // the structural index only skips bytes, results are the same with or without it
+  void set_use_structural_index(const bool use_structural_index)
+  {
+    use_structural_index_ = use_structural_index;
+  }
 
 private:
   int init_opt_variables();
+  void build_structural_index(const char *str, const char *end);
+  inline const char *next_structural_char(const char *str, const char *end);
   template<common::ObCharsetType cs_type>
   inline int mbcharlen(const char *ptr, const char *end) {
     UNUSED(ptr);
@@ -244,11 +254,51 @@ private:
   }
 
 protected:
+  // Structural index is the bitmap of bytes the scanner has to stop at: the first bytes of
+  // terminators, the enclosed char, the escaped char, and bytes not in ASCII for multi-byte
+  // charsets (leading bytes of multi-byte chars are never ASCII). Any other byte is a single
+  // byte char the scanner steps over without any action, so it jumps to the next set bit.
+  // Bitmaps are built with SIMD for a window of the buffer at once.
+  static const int64_t STRUCTURAL_BLOCK_SIZE = 64;
+  static const int64_t STRUCTURAL_BLOCK_CNT = 8;
+  static const int64_t MAX_STRUCTURAL_CHAR_CNT = 4;
+
   ObCSVGeneralFormat format_;
   common::ObSEArray<FieldValue, 1> fields_per_line_;
   OptParams opt_param_;
+  bool use_structural_index_;
+  bool index_non_ascii_;
+  int64_t structural_char_cnt_;
+  char structural_chars_[MAX_STRUCTURAL_CHAR_CNT];
+  const char *index_begin_;
+  const char *index_end_;
+  uint64_t structural_index_[STRUCTURAL_BLOCK_CNT];
 };
 
+inline const char *ObCSVGeneralParser::next_structural_char(const char *str, const char *end)
+{
+  const char *pos = str;
+  bool found = false;
+  while (!found && pos < end) {
+    if (OB_UNLIKELY(pos < index_begin_ || pos >= index_end_)) {
+      build_structural_index(pos, end);
+    }
+    const int64_t offset = pos - index_begin_;
+    int64_t block_idx = offset / STRUCTURAL_BLOCK_SIZE;
+    uint64_t mask = structural_index_[block_idx] & (UINT64_MAX << (offset % STRUCTURAL_BLOCK_SIZE));
+    while (0 == mask && ++block_idx < STRUCTURAL_BLOCK_CNT) {
+      mask = structural_index_[block_idx];
+    }
+    if (0 != mask) {
+      pos = index_begin_ + block_idx * STRUCTURAL_BLOCK_SIZE + __builtin_ctzll(mask);
+      found = true;
+    } else {
+      pos = index_end_;
+    }
+  }
+  return found ? pos : end;
+}
+
 
 template<>
 inline int ObCSVGeneralParser::mbcharlen<common::CHARSET_UTF8MB4>(const char *ptr, const char *end) {
@@ -308,6 +358,9 @@ int ObCSVGeneralParser::scan_proto(const char *&str,
   int blank_line_cnt = 0;
   const char *line_begin = str;
   char *escape_buf_pos = escape_buf;
+  // the buffer may be refilled between scans
+  index_begin_ = nullptr;
+  index_end_ = nullptr;
 
   if (NEED_ESCAPED_RESULT) {
     if (escape_buf_end - escape_buf < end - str) {
@@ -390,6 +443,9 @@ int ObCSVGeneralParser::scan_proto(const char *&str,
           if (!is_term) {
             int mb_len = mbcharlen<cs_type>(str, end);
             str += mb_len;
+            if (use_structural_index_ && str < end) {
+              str = next_structural_char(str, end);
+            }
           }
         }
       }
@@ -495,6 +551,7 @@ struct ObExternalFileFormat
   enum FormatType {
     INVALID_FORMAT = -1,
     CSV_FORMAT,
+    PARQUET_FORMAT,
     MAX_FORMAT
   };
 
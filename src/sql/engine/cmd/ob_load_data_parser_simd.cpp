@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace oceanbase
+{
+namespace sql
+{
+// Set bit i of bitmaps[i / 64] if str[i] is one of chars, or is not in ASCII when
+// with_non_ascii is true. char_cnt is at most 4.
+void csv_build_structural_index_simd(const char *str, const int64_t len,
+                                     const char *chars, const int64_t char_cnt,
+                                     const bool with_non_ascii, uint64_t *bitmaps)
+{
+#if defined(__x86_64__)
+  __m512i patterns[4];
+  for (int64_t i = 0; i < char_cnt; i++) {
+    patterns[i] = _mm512_set1_epi8(chars[i]);
+  }
+  int64_t pos = 0;
+  int64_t block_idx = 0;
+  for (; pos + 64 <= len; pos += 64, block_idx++) {
+    const __m512i data = _mm512_loadu_si512(str + pos);
+    __mmask64 mask = with_non_ascii ? _mm512_movepi8_mask(data) : 0;
+    for (int64_t i = 0; i < char_cnt; i++) {
+      mask |= _mm512_cmpeq_epi8_mask(data, patterns[i]);
+    }
+    bitmaps[block_idx] = mask;
+  }
+  if (pos < len) {
+    // masked load never touches bytes beyond len
+    const __mmask64 load_mask = (1ULL << (len - pos)) - 1;
+    const __m512i data = _mm512_maskz_loadu_epi8(load_mask, str + pos);
+    __mmask64 mask = with_non_ascii ? _mm512_movepi8_mask(data) : 0;
+    for (int64_t i = 0; i < char_cnt; i++) {
+      mask |= _mm512_cmpeq_epi8_mask(data, patterns[i]);
+    }
+    bitmaps[block_idx] = mask & load_mask;
+  }
+#else
+  (void)str;
+  (void)len;
+  (void)chars;
+  (void)char_cnt;
+  (void)with_non_ascii;
+  (void)bitmaps;
+  abort();
+#endif
+}
+
+}  // namespace sql
+}  // namespace oceanbase
@@ -130,10 +130,23 @@ OB_INLINE int ObTableDeleteOp::inner_open_with_das()
   int ret = OB_SUCCESS;
   if (OB_FAIL(open_table_for_each())) {
     LOG_WARN("init delete rtdef failed", K(ret), K(MY_SPEC.del_ctdefs_.count()));
+  } else {
+    init_batch_by_tablet();
   }
   return ret;
 }
 
+void ObTableDeleteOp::init_batch_by_tablet()
+{
+  batch_by_tablet_ = MY_SPEC.max_batch_size_ > 0;
+  for (int64_t i = 0; batch_by_tablet_ && i < MY_SPEC.del_ctdefs_.count(); ++i) {
+    const ObTableDeleteSpec::DelCtDefArray &ctdefs = MY_SPEC.del_ctdefs_.at(i);
+    for (int64_t j = 0; batch_by_tablet_ && j < ctdefs.count(); ++j) {
+      batch_by_tablet_ = can_write_batch_by_tablet(*ctdefs.at(j));
+    }
+  }
+}
+
 int ObTableDeleteOp::check_need_exec_single_row()
 {
   int ret = OB_SUCCESS;
@@ -307,6 +320,54 @@ OB_INLINE int ObTableDeleteOp::delete_row_to_das()
   return ret;
 }
 
+int ObTableDeleteOp::process_batch_row()
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.del_ctdefs_.count(); ++i) {
+    const ObTableDeleteSpec::DelCtDefArray &ctdefs = MY_SPEC.del_ctdefs_.at(i);
+    DelRtDefArray &rtdefs = del_rtdefs_.at(i);
+    bool is_skipped = false;
+    for (int64_t j = 0; OB_SUCC(ret) && !is_skipped && j < ctdefs.count(); ++j) {
+      const ObDelCtDef &del_ctdef = *ctdefs.at(j);
+      ObDelRtDef &del_rtdef = rtdefs.at(j);
+      ObDASBatchRow das_row;
+      das_row.table_idx_ = i;
+      das_row.index_idx_ = j;
+      das_row.batch_idx_ = eval_ctx_.get_batch_idx();
+      if (OB_FAIL(ObDMLService::process_delete_row(del_ctdef, del_rtdef, is_skipped, *this))) {
+        LOG_WARN("process delete row failed", K(ret));
+      } else if (OB_UNLIKELY(is_skipped)) {
+        //this row and its global index rows are not written
+      } else if (OB_FAIL(calc_tablet_loc(del_ctdef, del_rtdef, das_row.tablet_loc_))) {
+        LOG_WARN("calc partition key failed", K(ret));
+      } else if (OB_FAIL(das_batch_rows_.push_back(das_row))) {
+        LOG_WARN("store das batch row failed", K(ret));
+      } else {
+        ++del_rtdef.cur_row_num_;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      int64_t delete_rows = is_skipped ? 0 : 1;
+      if (OB_FAIL(merge_implict_cursor(0, 0, delete_rows, 0))) {
+        LOG_WARN("merge implict cursor failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObTableDeleteOp::write_batch_row_to_das(const ObDASBatchRow &das_row)
+{
+  int ret = OB_SUCCESS;
+  const ObDelCtDef &del_ctdef = *(MY_SPEC.del_ctdefs_.at(das_row.table_idx_).at(das_row.index_idx_));
+  ObDelRtDef &del_rtdef = del_rtdefs_.at(das_row.table_idx_).at(das_row.index_idx_);
+  ObChunkDatumStore::StoredRow *stored_row = nullptr;
+  if (OB_FAIL(ObDMLService::delete_row(del_ctdef, del_rtdef, das_row.tablet_loc_, dml_rtctx_, stored_row))) {
+    LOG_WARN("delete row with das failed", K(ret), K(das_row));
+  }
+  return ret;
+}
+
 int ObTableDeleteOp::write_rows_post_proc(int last_errno)
 {
   int ret = last_errno;
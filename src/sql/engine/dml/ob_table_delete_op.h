@@ -94,6 +94,9 @@ protected:
   int check_delete_affected_row();
   virtual int write_row_to_das_buffer() override;
   virtual int check_need_exec_single_row() override;
+  void init_batch_by_tablet();
+  virtual int process_batch_row() override;
+  virtual int write_batch_row_to_das(const ObDASBatchRow &das_row) override;
 protected:
   DelRtDef2DArray del_rtdefs_;  //see the comment of DelCtDef2DArray
   ObErrLogService err_log_service_;
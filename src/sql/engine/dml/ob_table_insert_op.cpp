@@ -132,10 +132,30 @@ OB_INLINE int ObTableInsertOp::inner_open_with_das()
   int ret = OB_SUCCESS;
   if (OB_FAIL(open_table_for_each())) {
     LOG_WARN("open table for each failed", K(ret), K(MY_SPEC.ins_ctdefs_.count()));
+  } else {
+    init_batch_by_tablet();
   }
   return ret;
 }
 
+void ObTableInsertOp::init_batch_by_tablet()
+{
+  batch_by_tablet_ = (PHY_INSERT == MY_SPEC.type_ && MY_SPEC.max_batch_size_ > 0);
+  for (int64_t i = 0; batch_by_tablet_ && i < MY_SPEC.ins_ctdefs_.count(); ++i) {
+    const ObTableInsertSpec::InsCtDefArray &ctdefs = MY_SPEC.ins_ctdefs_.at(i);
+    for (int64_t j = 0; batch_by_tablet_ && j < ctdefs.count(); ++j) {
+      const ObInsCtDef &ins_ctdef = *(ctdefs.at(j));
+      if (!can_write_batch_by_tablet(ins_ctdef)) {
+        batch_by_tablet_ = false;
+      } else if (ins_ctdef.is_heap_table_ && ins_ctdef.is_primary_index_
+                 && (ins_ctdef.new_row_.empty() || !ins_ctdef.new_row_.at(0)->is_batch_result())) {
+        //the hidden pk is set for each row and must be kept until the row is written
+        batch_by_tablet_ = false;
+      }
+    }
+  }
+}
+
 OB_INLINE int ObTableInsertOp::open_table_for_each()
 {
   int ret = OB_SUCCESS;
@@ -312,6 +332,66 @@ OB_INLINE int ObTableInsertOp::insert_row_to_das()
   return ret;
 }
 
+int ObTableInsertOp::process_batch_row()
+{
+  int ret = OB_SUCCESS;
+  ObPhysicalPlanCtx *plan_ctx = GET_PHY_PLAN_CTX(ctx_);
+  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.ins_ctdefs_.count(); ++i) {
+    const ObTableInsertSpec::InsCtDefArray &ctdefs = MY_SPEC.ins_ctdefs_.at(i);
+    InsRtDefArray &rtdefs = ins_rtdefs_.at(i);
+    bool is_skipped = false;
+    for (int64_t j = 0; OB_SUCC(ret) && !is_skipped && j < ctdefs.count(); ++j) {
+      const ObInsCtDef &ins_ctdef = *(ctdefs.at(j));
+      ObInsRtDef &ins_rtdef = rtdefs.at(j);
+      ObDASBatchRow das_row;
+      das_row.table_idx_ = i;
+      das_row.index_idx_ = j;
+      das_row.batch_idx_ = eval_ctx_.get_batch_idx();
+      ++ins_rtdef.cur_row_num_;
+      if (OB_FAIL(ObDMLService::init_heap_table_pk_for_ins(ins_ctdef, eval_ctx_))) {
+        LOG_WARN("fail to init heap table pk to null", K(ret));
+      } else if (OB_FAIL(ObDMLService::process_insert_row(ins_ctdef, ins_rtdef, *this, is_skipped))) {
+        LOG_WARN("process insert row failed", K(ret));
+      } else if (OB_UNLIKELY(is_skipped)) {
+        //this row and its global index rows are not written
+      } else if (OB_FAIL(calc_tablet_loc(ins_ctdef, ins_rtdef, das_row.tablet_loc_))) {
+        LOG_WARN("calc partition key failed", K(ret));
+      } else if (OB_FAIL(ObDMLService::set_heap_table_hidden_pk(ins_ctdef,
+                                                                das_row.tablet_loc_->tablet_id_,
+                                                                eval_ctx_))) {
+        LOG_WARN("set_heap_table_hidden_pk failed", K(ret), KPC(das_row.tablet_loc_));
+      } else if (OB_FAIL(das_batch_rows_.push_back(das_row))) {
+        LOG_WARN("store das batch row failed", K(ret));
+      }
+      if (OB_FAIL(ret)) {
+        record_err_for_load_data(ret, ins_rtdef.cur_row_num_);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      int64_t insert_rows = is_skipped ? 0 : 1;
+      if (OB_FAIL(merge_implict_cursor(insert_rows, 0, 0, 0))) {
+        LOG_WARN("merge implict cursor failed", K(ret));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    plan_ctx->record_last_insert_id_cur_stmt();
+  }
+  return ret;
+}
+
+int ObTableInsertOp::write_batch_row_to_das(const ObDASBatchRow &das_row)
+{
+  int ret = OB_SUCCESS;
+  const ObInsCtDef &ins_ctdef = *(MY_SPEC.ins_ctdefs_.at(das_row.table_idx_).at(das_row.index_idx_));
+  ObInsRtDef &ins_rtdef = ins_rtdefs_.at(das_row.table_idx_).at(das_row.index_idx_);
+  ObChunkDatumStore::StoredRow *stored_row = nullptr;
+  if (OB_FAIL(ObDMLService::insert_row(ins_ctdef, ins_rtdef, das_row.tablet_loc_, dml_rtctx_, stored_row))) {
+    LOG_WARN("insert row with das failed", K(ret), K(das_row));
+  }
+  return ret;
+}
+
 int ObTableInsertOp::write_rows_post_proc(int last_errno)
 {
   int ret = last_errno;
@@ -83,6 +83,9 @@ protected:
   int inner_open_with_das();
   int insert_row_to_das();
   virtual int write_row_to_das_buffer() override;
+  void init_batch_by_tablet();
+  virtual int process_batch_row() override;
+  virtual int write_batch_row_to_das(const ObDASBatchRow &das_row) override;
   virtual int write_rows_post_proc(int last_errno) override;
   int calc_tablet_loc(const ObInsCtDef &ins_ctdef,
                       ObInsRtDef &ins_rtdef,
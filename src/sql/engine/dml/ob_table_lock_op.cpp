@@ -442,19 +442,6 @@ int ObTableLockOp::lock_batch_to_das(const ObBatchRows *child_brs)
   return ret;
 }
 
-OB_INLINE int ObTableLockOp::get_next_batch_from_child(const int64_t max_row_cnt,
-                                                       const ObBatchRows *&child_brs)
-{
-  int ret = OB_SUCCESS;
-  clear_datum_eval_flag();
-  if (OB_FAIL(child_->get_next_batch(max_row_cnt, child_brs))) {
-    LOG_WARN("fail to get next batch", K(ret));
-  } else if (OB_LIKELY(!child_brs->end_ && child_brs->size_ > 0)) {
-    LOG_TRACE("child output row", "row", ROWEXPR2STR(eval_ctx_, child_->get_spec().output_));
-  }
-  return ret;
-}
-
 int ObTableLockOp::inner_close()
 {
   return ObTableModifyOp::inner_close();
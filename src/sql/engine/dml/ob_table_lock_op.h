@@ -113,8 +113,6 @@ public:
   int init_lock_rtdef();
 
 protected:
-  OB_INLINE int get_next_batch_from_child(const int64_t max_row_cnt,
-                                          const ObBatchRows *&child_brs);
   int lock_row_to_das();
   int lock_batch_to_das(const ObBatchRows *child_brs);
   int calc_tablet_loc(const ObLockCtDef &lock_ctdef,
@@ -536,6 +536,8 @@ ObTableModifyOp::ObTableModifyOp(ObExecContext &ctx,
     execute_single_row_(false),
     err_log_rt_def_(),
     dml_modify_rows_(ctx.get_allocator()),
+    batch_by_tablet_(false),
+    das_batch_rows_(),
     saved_session_(NULL)
 {
   obj_print_params_ = CREATE_OBJ_PRINT_PARAM(ctx_.get_my_session());
@@ -1191,5 +1193,148 @@ int ObTableModifyOp::inner_get_next_row()
   }
   return ret;
 }
+
+int ObTableModifyOp::get_next_batch_from_child(const int64_t max_row_cnt,
+                                               const ObBatchRows *&child_brs)
+{
+  int ret = OB_SUCCESS;
+  clear_evaluated_flag();
+  if (OB_FAIL(child_->get_next_batch(max_row_cnt, child_brs))) {
+    LOG_WARN("fail to get next batch", K(ret));
+  } else if (OB_LIKELY(!child_brs->end_ && child_brs->size_ > 0)) {
+    LOG_TRACE("child output batch", "row_cnt", child_brs->size_);
+  }
+  return ret;
+}
+
+int ObTableModifyOp::write_batch_to_das_buffer(const ObBatchRows &child_brs, int64_t &row_count)
+{
+  int ret = OB_SUCCESS;
+  // the das ctx and the rtdefs of the DML operator all reference to eval_ctx_,
+  // so that each row of the batch is written with the batch_idx of eval_ctx_
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  batch_info_guard.set_batch_size(child_brs.size_);
+  (void) brs_.copy(&child_brs);
+  if (batch_by_tablet_) {
+    ret = write_batch_by_tablet(batch_info_guard, child_brs, row_count);
+  } else {
+    ret = write_batch_by_row(batch_info_guard, child_brs, row_count);
+  }
+  return ret;
+}
+
+int ObTableModifyOp::write_batch_by_row(ObEvalCtx::BatchInfoScopeGuard &batch_info_guard,
+                                        const ObBatchRows &child_brs,
+                                        int64_t &row_count)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < child_brs.size_; ++i) {
+    if (child_brs.skip_->at(i)) {
+      continue;
+    }
+    batch_info_guard.set_batch_idx(i);
+    if (OB_FAIL(write_row_to_das_buffer())) {
+      LOG_WARN("write row to das failed", K(ret), K(i));
+    } else if (OB_FAIL(discharge_das_write_buffer())) {
+      LOG_WARN("discharge das write buffer failed", K(ret));
+    } else if (is_error_logging_ && err_log_rt_def_.first_err_ret_ != OB_SUCCESS) {
+      // the row is recorded in the error logging table, not returned
+      brs_.skip_->set(i);
+      err_log_rt_def_.curr_err_log_record_num_++;
+      err_log_rt_def_.reset();
+    } else {
+      row_count++;
+    }
+  }
+  return ret;
+}
+
+//The batch is written in two passes:
+//1. each row of the batch is converted and checked, its tablet locations are calculated
+//   and collected to das_batch_rows_, the datums of the row stay in the batch of the exprs
+//2. the collected rows are written to the DAS Write Buffer ctdef by ctdef and tablet by tablet,
+//   so that the rows of a tablet are appended to its das op together
+//and the DAS Write Buffer is discharged once for the batch
+int ObTableModifyOp::write_batch_by_tablet(ObEvalCtx::BatchInfoScopeGuard &batch_info_guard,
+                                           const ObBatchRows &child_brs,
+                                           int64_t &row_count)
+{
+  int ret = OB_SUCCESS;
+  das_batch_rows_.reuse();
+  for (int64_t i = 0; OB_SUCC(ret) && i < child_brs.size_; ++i) {
+    if (child_brs.skip_->at(i)) {
+      continue;
+    }
+    batch_info_guard.set_batch_idx(i);
+    if (OB_FAIL(process_batch_row())) {
+      LOG_WARN("process batch row failed", K(ret), K(i));
+    } else {
+      row_count++;
+    }
+  }
+  if (OB_SUCC(ret) && das_batch_rows_.count() > 1) {
+    std::sort(das_batch_rows_.begin(), das_batch_rows_.end());
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < das_batch_rows_.count(); ++i) {
+    const ObDASBatchRow &das_row = das_batch_rows_.at(i);
+    batch_info_guard.set_batch_idx(das_row.batch_idx_);
+    if (OB_FAIL(write_batch_row_to_das(das_row))) {
+      LOG_WARN("write batch row to das failed", K(ret), K(das_row));
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(discharge_das_write_buffer())) {
+    LOG_WARN("discharge das write buffer failed", K(ret));
+  }
+  return ret;
+}
+
+int ObTableModifyOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (iter_end_) {
+    LOG_DEBUG("can't get gi task, iter end", K(MY_SPEC.id_), K(iter_end_));
+    brs_.end_ = true;
+    brs_.size_ = 0;
+  } else {
+    int64_t row_count = 0;
+    const ObBatchRows *child_brs = nullptr;
+    while (OB_SUCC(ret)) {
+      if (OB_FAIL(try_check_status())) {
+        LOG_WARN("check status failed", K(ret));
+      } else if (OB_FAIL(get_next_batch_from_child(max_row_cnt, child_brs))) {
+        LOG_WARN("fail to get next batch", K(ret));
+      } else if (OB_FAIL(write_batch_to_das_buffer(*child_brs, row_count))) {
+        LOG_WARN("write batch to das failed", K(ret));
+      } else if (child_brs->end_) {
+        iter_end_ = true;
+        break;
+      } else if (MY_SPEC.is_returning_ && !brs_.skip_->is_all_true(brs_.size_)) {
+        //the returning rows of this batch need to be output
+        break;
+      }
+    }
+
+    if (OB_FAIL(ret)) {
+      record_err_for_load_data(ret, row_count);
+    }
+
+    if (OB_SUCC(ret) && iter_end_ && dml_rtctx_.das_ref_.has_task()) {
+      //DML operator reach iter end,
+      //now submit the remaining rows in the DAS Write Buffer to the storage
+      if (OB_FAIL(submit_all_dml_task())) {
+        LOG_WARN("failed to submit the remaining dml tasks", K(ret));
+      }
+    }
+    //to post process the DML info after writing all data to the storage or returning one batch
+    ret = write_rows_post_proc(ret);
+    if (OB_SUCC(ret) && iter_end_) {
+      brs_.end_ = true;
+      if (!MY_SPEC.is_returning_) {
+        brs_.size_ = 0;
+      }
+    }
+  }
+  return ret;
+}
 }  // namespace sql
 }  // namespace oceanbase
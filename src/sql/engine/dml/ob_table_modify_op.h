@@ -150,6 +150,49 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObTableModifyOpInput);
 };
 
+//A row of the batch collected by the conversion and check pass of the DML operator,
+//it is written to the DAS Write Buffer by the DML ctdef at [table_idx_][index_idx_]
+struct ObDASBatchRow
+{
+  ObDASBatchRow()
+    : table_idx_(0),
+      index_idx_(0),
+      batch_idx_(0),
+      tablet_loc_(nullptr),
+      new_tablet_loc_(nullptr),
+      is_row_changed_(true)
+  { }
+  //the rows of the same ctdef and tablet are written together, in the order of the batch
+  bool operator<(const ObDASBatchRow &other) const
+  {
+    bool bret = false;
+    if (table_idx_ != other.table_idx_) {
+      bret = table_idx_ < other.table_idx_;
+    } else if (index_idx_ != other.index_idx_) {
+      bret = index_idx_ < other.index_idx_;
+    } else if (tablet_loc_->tablet_id_ != other.tablet_loc_->tablet_id_) {
+      bret = tablet_loc_->tablet_id_ < other.tablet_loc_->tablet_id_;
+    } else {
+      bret = batch_idx_ < other.batch_idx_;
+    }
+    return bret;
+  }
+  TO_STRING_KV(K_(table_idx),
+               K_(index_idx),
+               K_(batch_idx),
+               KPC_(tablet_loc),
+               KPC_(new_tablet_loc),
+               K_(is_row_changed));
+  int64_t table_idx_;
+  int64_t index_idx_;
+  int64_t batch_idx_;
+  ObDASTabletLoc *tablet_loc_;
+  //the tablet location of the updated row, only used by update
+  ObDASTabletLoc *new_tablet_loc_;
+  //only used by update
+  bool is_row_changed_;
+};
+
 class ObTableModifyOp: public ObOperator
 {
 public:
@@ -181,6 +224,7 @@ public:
   {
     dml_rtctx_.cleanup();
     trigger_clear_exprs_.reset();
+    das_batch_rows_.reset();
     ObOperator::destroy();
   }
 
@@ -232,11 +276,39 @@ protected:
 
   virtual int inner_rescan() override;
   virtual int inner_get_next_row() override;
+  //Batch mode of the DML operator, the child keeps producing batches and the batch
+  //is written to the DAS Write Buffer by tablet, or row by row with write_row_to_das_buffer()
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
   virtual int check_need_exec_single_row();
   int get_next_row_from_child();
+  int get_next_batch_from_child(const int64_t max_row_cnt, const ObBatchRows *&child_brs);
+  int write_batch_to_das_buffer(const ObBatchRows &child_brs, int64_t &row_count);
+  int write_batch_by_row(ObEvalCtx::BatchInfoScopeGuard &batch_info_guard,
+                         const ObBatchRows &child_brs,
+                         int64_t &row_count);
+  int write_batch_by_tablet(ObEvalCtx::BatchInfoScopeGuard &batch_info_guard,
+                            const ObBatchRows &child_brs,
+                            int64_t &row_count);
+  //the batch can not be written in two passes if the DML operator catches the errors of a row
+  //or has to process the row right after it is written, such as triggers and foreign keys
+  bool can_write_batch_by_tablet(const ObDMLBaseCtDef &dml_ctdef) const
+  {
+    return !is_error_logging_ && !execute_single_row_
+        && !dml_ctdef.has_instead_of_trigger_
+        && dml_ctdef.trig_ctdef_.tg_args_.empty()
+        && dml_ctdef.fk_args_.empty();
+  }
   //Override this interface to complete the write semantics of the DML operator,
   //and write a row to the DAS Write Buffer according to the specific DML behavior
   virtual int write_row_to_das_buffer() { return common::OB_NOT_IMPLEMENT; }
+  //Override these interfaces to write a batch in two passes when batch_by_tablet_ is set:
+  //process_batch_row() converts and checks the current row of the batch and collects
+  //the tablet locations of the row to das_batch_rows_,
+  //write_batch_row_to_das() writes a collected row to the DAS Write Buffer,
+  //the collected rows are sorted to write the rows of a tablet together
+  virtual int process_batch_row() { return common::OB_NOT_IMPLEMENT; }
+  virtual int write_batch_row_to_das(const ObDASBatchRow &das_row)
+  { UNUSED(das_row); return common::OB_NOT_IMPLEMENT; }
   //Override this interface to post process the DML info after
   //writing all data to the storage or returning one row
   //such as: set affected_rows to query context, rewrite some error code
@@ -267,6 +339,9 @@ public:
   ObErrLogRtDef err_log_rt_def_;
   ObSEArray<ObExpr *, 4> trigger_clear_exprs_;
   ObDMLModifyRowsList dml_modify_rows_;
+  //set by the DML operator which writes the batch in two passes, see write_batch_by_tablet()
+  bool batch_by_tablet_;
+  common::ObSEArray<ObDASBatchRow, 16> das_batch_rows_;
 private:
   ObSQLSessionInfo::StmtSavedValue *saved_session_;
   char saved_session_buf_[sizeof(ObSQLSessionInfo::StmtSavedValue)] __attribute__((aligned (16)));;
@@ -203,10 +203,29 @@ OB_INLINE int ObTableUpdateOp::inner_open_with_das()
     LOG_WARN("init update rtdef failed", K(ret), K(MY_SPEC.upd_ctdefs_.count()));
   } else {
     dml_rtctx_.set_pick_del_task_first();
+    init_batch_by_tablet();
   }
   return ret;
 }
 
+void ObTableUpdateOp::init_batch_by_tablet()
+{
+  batch_by_tablet_ = MY_SPEC.max_batch_size_ > 0;
+  for (int64_t i = 0; batch_by_tablet_ && i < MY_SPEC.upd_ctdefs_.count(); ++i) {
+    const ObTableUpdateSpec::UpdCtDefArray &ctdefs = MY_SPEC.upd_ctdefs_.at(i);
+    for (int64_t j = 0; batch_by_tablet_ && j < ctdefs.count(); ++j) {
+      const ObUpdCtDef &upd_ctdef = *ctdefs.at(j);
+      if (!can_write_batch_by_tablet(upd_ctdef)) {
+        batch_by_tablet_ = false;
+      } else if (upd_ctdef.is_heap_table_
+                 && (upd_ctdef.new_row_.empty() || !upd_ctdef.new_row_.at(0)->is_batch_result())) {
+        //the hidden pk is copied for each row and must be kept until the row is written
+        batch_by_tablet_ = false;
+      }
+    }
+  }
+}
+
 OB_INLINE int ObTableUpdateOp::open_table_for_each()
 {
   int ret = OB_SUCCESS;
@@ -389,6 +408,62 @@ OB_INLINE int ObTableUpdateOp::update_row_to_das()
   return ret;
 }
 
+int ObTableUpdateOp::process_batch_row()
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.upd_ctdefs_.count(); ++i) {
+    const ObTableUpdateSpec::UpdCtDefArray &ctdefs = MY_SPEC.upd_ctdefs_.at(i);
+    UpdRtDefArray &rtdefs = upd_rtdefs_.at(i);
+    bool is_skipped = false;
+    for (int64_t j = 0; OB_SUCC(ret) && !is_skipped && j < ctdefs.count(); ++j) {
+      const ObUpdCtDef &upd_ctdef = *ctdefs.at(j);
+      ObUpdRtDef &upd_rtdef = rtdefs.at(j);
+      ObDASBatchRow das_row;
+      das_row.table_idx_ = i;
+      das_row.index_idx_ = j;
+      das_row.batch_idx_ = eval_ctx_.get_batch_idx();
+      ++upd_rtdef.cur_row_num_;
+      if (OB_FAIL(ObDMLService::process_update_row(upd_ctdef, upd_rtdef, is_skipped, *this))) {
+        LOG_WARN("process update row failed", K(ret));
+      } else if (OB_UNLIKELY(is_skipped)) {
+        //this row and its global index rows are not written
+      } else if (OB_FAIL(calc_tablet_loc(upd_ctdef, upd_rtdef,
+                                         das_row.tablet_loc_, das_row.new_tablet_loc_))) {
+        LOG_WARN("calc partition key failed", K(ret));
+      } else if (FALSE_IT(das_row.is_row_changed_ = upd_rtdef.is_row_changed_)) {
+      } else if (OB_FAIL(das_batch_rows_.push_back(das_row))) {
+        LOG_WARN("store das batch row failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      int64_t update_rows = rtdefs.at(0).is_row_changed_ ? 1 : 0;
+      if (OB_FAIL(merge_implict_cursor(0, update_rows, 0, 1))) {
+        LOG_WARN("merge implict cursor failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObTableUpdateOp::write_batch_row_to_das(const ObDASBatchRow &das_row)
+{
+  int ret = OB_SUCCESS;
+  const ObUpdCtDef &upd_ctdef = *(MY_SPEC.upd_ctdefs_.at(das_row.table_idx_).at(das_row.index_idx_));
+  ObUpdRtDef &upd_rtdef = upd_rtdefs_.at(das_row.table_idx_).at(das_row.index_idx_);
+  ObChunkDatumStore::StoredRow *old_row = nullptr;
+  ObChunkDatumStore::StoredRow *new_row = nullptr;
+  ObChunkDatumStore::StoredRow *full_row = nullptr;
+  //is_row_changed_ of the rtdef is left by the last row of the conversion and check pass
+  upd_rtdef.is_row_changed_ = das_row.is_row_changed_;
+  if (OB_FAIL(ObDMLService::update_row(upd_ctdef, upd_rtdef, das_row.tablet_loc_, das_row.new_tablet_loc_,
+                                       dml_rtctx_, old_row, new_row, full_row))) {
+    LOG_WARN("update row with das failed", K(ret), K(das_row));
+  } else {
+    ++upd_rtdef.found_rows_;
+  }
+  return ret;
+}
+
 int ObTableUpdateOp::check_update_affected_row()
 {
   int ret = OB_SUCCESS;
@@ -109,6 +109,9 @@ protected:
   virtual int write_row_to_das_buffer() override;
   virtual int write_rows_post_proc(int last_errno) override;
   virtual int check_need_exec_single_row() override;
+  void init_batch_by_tablet();
+  virtual int process_batch_row() override;
+  virtual int write_batch_row_to_das(const ObDASBatchRow &das_row) override;
 
 protected:
   UpdRtDef2DArray upd_rtdefs_;  //see the comment of UpdCtDef2DArray
@@ -3003,7 +3003,7 @@ static int common_string_json(const ObExpr &expr,
       ObJsonOpaque j_opaque(j_text, in_type);
       ObJsonString j_string(j_text.ptr(), j_text.length());
       ObJsonNull j_null;
-      ObJsonNode *j_tree = NULL;
+      ObString raw_bin;
       bool is_null_res = false;
 
       bool relaxed_json = lib::is_oracle_mode() && !(CM_IS_STRICT_JSON(expr.extra_));
@@ -3024,7 +3024,8 @@ static int common_string_json(const ObExpr &expr,
         j_base = &j_string;
       } else if (lib::is_oracle_mode() && (OB_ISNULL(j_text.ptr()) || j_text.length() == 0)) {
         j_base = &j_null;
-      } else if (OB_FAIL(ObJsonParser::get_tree(&temp_allocator, j_text, j_tree, parse_flag))) {
+      } else if (OB_FAIL(ObJsonParser::get_bin(&temp_allocator, j_text, raw_bin, parse_flag))) {
+        // json text is written to json binary while parsing, no json tree
         if (lib::is_mysql_mode() && CM_IS_IMPLICIT_CAST(expr.extra_) && !CM_IS_COLUMN_CONVERT(expr.extra_)) {
           ret = OB_SUCCESS;
           j_base = &j_string;
@@ -3040,13 +3041,10 @@ static int common_string_json(const ObExpr &expr,
             LOG_USER_ERROR(OB_ERR_INVALID_JSON_TEXT_IN_PARAM);
           }
         }
-      } else {
-        j_base = j_tree;
       }
 
       if (OB_SUCC(ret) && !is_null_res) {
-        ObString raw_bin;
-        if (OB_FAIL(j_base->get_raw_binary(raw_bin, &temp_allocator))) {
+        if (OB_NOT_NULL(j_base) && OB_FAIL(j_base->get_raw_binary(raw_bin, &temp_allocator))) {
           LOG_WARN("fail to get string json binary", K(ret), K(in_type), K(raw_bin));
         } else if (OB_FAIL(common_json_bin(expr, ctx, res_datum, raw_bin))) {
           LOG_WARN("fail to fill json bin lob locator", K(ret));
@@ -349,6 +349,7 @@ int ObExprConcat::cg_expr(ObExprCGCtx &, const ObRawExpr &, ObExpr &expr) const
   }
   if (OB_SUCC(ret)) {
     expr.eval_func_ = &eval_concat;
+    expr.eval_batch_func_ = &eval_concat_batch;
   }
   return ret;
 }
@@ -487,5 +488,81 @@ int ObExprConcat::eval_concat(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_
   return ret;
 }
 
+int ObExprConcat::eval_concat_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                    const ObBitVector &skip, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  bool has_text_param = false;
+  ObDatum *res = expr.locate_batch_datums(ctx);
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  for (int64_t j = 0; OB_SUCC(ret) && j < expr.arg_cnt_; j++) {
+    if (OB_FAIL(expr.args_[j]->eval_batch(ctx, skip, batch_size))) {
+      LOG_WARN("eval param failed", K(ret), K(j));
+    } else if (ob_is_text_tc(expr.args_[j]->datum_meta_.type_)) {
+      has_text_param = true;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (!is_mysql_mode() || has_text_param || ob_is_text_tc(expr.datum_meta_.type_)) {
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    batch_info_guard.set_batch_size(batch_size);
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; i++) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      batch_info_guard.set_batch_idx(i);
+      if (OB_FAIL(eval_concat(expr, ctx, res[i]))) {
+        LOG_WARN("eval concat failed", K(ret), K(i));
+      } else {
+        eval_flags.set(i);
+      }
+    }
+  } else {
+    // mysql mode with varchar params only, same as eval_concat
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; i++) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      int64_t null_cnt = 0;
+      int64_t res_len = 0;
+      for (int64_t j = 0; j < expr.arg_cnt_; j++) {
+        const ObDatum &v = expr.args_[j]->locate_expr_datum(ctx, i);
+        if (v.is_null()) {
+          null_cnt += 1;
+        } else {
+          res_len += v.len_;
+        }
+      }
+      if (res_len > OB_MAX_VARCHAR_LENGTH) {
+        res[i].set_null();
+        ret = OB_SIZE_OVERFLOW;
+        LOG_WARN("size overflow", K(ret), K(res_len));
+      } else if (null_cnt > 0) {
+        res[i].set_null();
+      } else if (1 == expr.arg_cnt_) {
+        res[i].set_datum(expr.args_[0]->locate_expr_datum(ctx, i));
+      } else {
+        char *buf = expr.get_str_res_mem(ctx, res_len, i);
+        if (OB_ISNULL(buf)) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("allocate memory failed", K(ret), K(res_len));
+        } else {
+          int64_t off = 0;
+          for (int64_t j = 0; j < expr.arg_cnt_; j++) {
+            const ObDatum &v = expr.args_[j]->locate_expr_datum(ctx, i);
+            MEMCPY(buf + off, v.ptr_, v.len_);
+            off += v.len_;
+          }
+          res[i].set_string(buf, res_len);
+        }
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 }
 }
@@ -63,6 +63,8 @@ public:
                       ObExpr &rt_expr) const override;
 
   static int eval_concat(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int eval_concat_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                               const ObBitVector &skip, const int64_t batch_size);
 
 private:
   // disallow copy
@@ -1150,7 +1150,13 @@ static ObExpr::EvalBatchFunc g_expr_eval_batch_functions[] = {
   ObExprJoinFilter::eval_in_filter_batch,                             /* 113 */
   calc_sqrt_expr_mysql_in_batch,                                      /* 114 */
   calc_sqrt_expr_oracle_double_in_batch,                              /* 115 */
-  calc_sqrt_expr_oracle_number_in_batch                               /* 116 */
+  calc_sqrt_expr_oracle_number_in_batch,                              /* 116 */
+  ObExprLower::calc_lower_batch,                                      /* 117 */
+  ObExprUpper::calc_upper_batch,                                      /* 118 */
+  ObExprConcat::eval_concat_batch,                                    /* 119 */
+  ObExprTrim::eval_trim_batch,                                        /* 120 */
+  ObExprDateFormat::calc_date_format_batch,                           /* 121 */
+  ObExprRegexpLike::eval_regexp_like_batch                            /* 122 */
 };
 
 REG_SER_FUNC_ARRAY(OB_SFA_SQL_EXPR_EVAL,
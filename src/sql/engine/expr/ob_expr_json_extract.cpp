@@ -173,8 +173,30 @@ int ObExprJsonExtract::eval_json_extract(const ObExpr &expr, ObEvalCtx &ctx, ObD
     } else if (hit_size == 0 || is_null_result) {
       res.set_null();
     } else {
+      ObString raw_str;
+      ObJsonBinBuilder bin_builder(&allocator);
       if (hit_size == 1 && (may_match_many == false)) {
         jb_res = hit[0];
+      } else if (hit[0]->is_bin()) {
+        // hits are positions in json binary, copy them into result array in binary directly,
+        // instead of transforming each hit to json tree
+        if (OB_FAIL(bin_builder.start_array())) {
+          LOG_WARN("fail to start result array", K(ret));
+        }
+        for (int32_t i = 0; OB_SUCC(ret) && i < hit_size; i++) {
+          if (OB_UNLIKELY(!hit[i]->is_bin())) {
+            ret = OB_ERR_UNEXPECTED;
+            LOG_WARN("hit is not json binary", K(ret), K(i));
+          } else if (OB_FAIL(bin_builder.append_binary(*static_cast<ObJsonBin *>(hit[i])))) {
+            LOG_WARN("result array append failed", K(ret), K(i), K(*(hit[i])));
+          }
+        }
+        if (OB_FAIL(ret)) {
+        } else if (OB_FAIL(bin_builder.end_array())) {
+          LOG_WARN("fail to end result array", K(ret), K(hit_size));
+        } else if (OB_FAIL(bin_builder.get_result(raw_str))) {
+          LOG_WARN("fail to get result array binary", K(ret), K(hit_size));
+        }
       } else {
         jb_res = &j_arr_res;
         ObJsonNode *j_node = NULL;
@@ -191,10 +213,9 @@ int ObExprJsonExtract::eval_json_extract(const ObExpr &expr, ObEvalCtx &ctx, ObD
         }
       }
 
-      ObString raw_str;
       if (OB_FAIL(ret)) {
         LOG_WARN("json extarct get results failed", K(ret));
-      } else if (OB_FAIL(jb_res->get_raw_binary(raw_str, &allocator))) {
+      } else if (OB_NOT_NULL(jb_res) && OB_FAIL(jb_res->get_raw_binary(raw_str, &allocator))) {
         LOG_WARN("json extarct get result binary failed", K(ret));
       } else if (OB_FAIL(ObJsonExprHelper::pack_json_str_res(expr, ctx, res, raw_str))) {
         LOG_WARN("fail to pack json result", K(ret));
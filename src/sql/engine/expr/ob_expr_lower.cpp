@@ -321,6 +321,7 @@ int ObExprLower::cg_expr(ObExprCGCtx &op_cg_ctx,
     LOG_WARN("lower expr cg expr failed", K(ret));
   } else {
     rt_expr.eval_func_ = ObExprLower::calc_lower;
+    rt_expr.eval_batch_func_ = ObExprLower::calc_lower_batch;
   }
   return ret;
 }
@@ -334,6 +335,7 @@ int ObExprUpper::cg_expr(ObExprCGCtx &op_cg_ctx,
     LOG_WARN("upper expr cg expr failed", K(ret));
   } else {
     rt_expr.eval_func_ = ObExprUpper::calc_upper;
+    rt_expr.eval_batch_func_ = ObExprUpper::calc_upper_batch;
   }
   return ret;
 }
@@ -458,6 +460,113 @@ int ObExprLowerUpper::calc_common(const ObExpr &expr, ObEvalCtx &ctx,
   return ret;
 }
 
+bool ObExprLowerUpper::is_ascii_case_compatible(const ObCollationType cs_type)
+{
+  // binary collation keeps the case, and collations of other charsets are not verified yet.
+  return CS_TYPE_UTF8MB4_GENERAL_CI == cs_type
+      || CS_TYPE_UTF8MB4_BIN == cs_type
+      || CS_TYPE_UTF8MB4_UNICODE_CI == cs_type
+      || CS_TYPE_GBK_CHINESE_CI == cs_type
+      || CS_TYPE_GBK_BIN == cs_type
+      || CS_TYPE_GB18030_CHINESE_CI == cs_type
+      || CS_TYPE_GB18030_BIN == cs_type
+      || CS_TYPE_LATIN1_SWEDISH_CI == cs_type
+      || CS_TYPE_LATIN1_BIN == cs_type;
+}
+
+bool ObExprLowerUpper::ascii_case_convert(const char *src, const int32_t len,
+                                          char *dst, const bool lower)
+{
+  const uint8_t *s = reinterpret_cast<const uint8_t *>(src);
+  uint8_t *d = reinterpret_cast<uint8_t *>(dst);
+  const uint8_t first = lower ? 'A' : 'a';
+  uint8_t high_bits = 0;
+  for (int32_t i = 0; i < len; ++i) {
+    const uint8_t c = s[i];
+    high_bits |= c;
+    // flip 0x20 of letters to be converted: 'A' (0x41) <-> 'a' (0x61)
+    d[i] = static_cast<uint8_t>(c ^ (static_cast<uint8_t>(static_cast<uint8_t>(c - first) < 26) << 5));
+  }
+  return 0 == (high_bits & 0x80);
+}
+
+int ObExprLowerUpper::calc_common_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                        const ObBitVector &skip, const int64_t batch_size,
+                                        const bool lower)
+{
+  int ret = OB_SUCCESS;
+  const ObCollationType cs_type = expr.datum_meta_.cs_type_;
+  if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, batch_size))) {
+    LOG_WARN("eval text failed", K(ret));
+  } else if (ob_is_text_tc(expr.args_[0]->datum_meta_.type_)) {
+    // lob is converted block by block, calc row by row.
+    ObDatum *res = expr.locate_batch_datums(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    batch_info_guard.set_batch_size(batch_size);
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      batch_info_guard.set_batch_idx(i);
+      if (OB_FAIL(calc_common(expr, ctx, res[i], lower, CS_TYPE_INVALID))) {
+        LOG_WARN("calc lower/upper failed", K(ret), K(i));
+      } else {
+        eval_flags.set(i);
+      }
+    }
+  } else if (OB_UNLIKELY(!ObCharset::is_valid_collation(cs_type))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("charset is null", K(ret), K(cs_type));
+  } else {
+    // charset dispatch is done once for the whole batch
+    ObDatum *res = expr.locate_batch_datums(ctx);
+    ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+    ObDatumVector texts = expr.args_[0]->locate_expr_datumvector(ctx);
+    const uchar multiply = (lower ? ObCharset::get_charset(cs_type)->casedn_multiply
+                                  : ObCharset::get_charset(cs_type)->caseup_multiply);
+    const bool ascii_compatible = is_ascii_case_compatible(cs_type);
+    const bool empty_as_null = is_oracle_mode() && ob_is_string_tc(expr.datum_meta_.type_);
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      const ObDatum *text = texts.at(i);
+      if (text->is_null()) {
+        res[i].set_null();
+      } else if (0 == text->len_) {
+        if (empty_as_null) {
+          res[i].set_null();
+        } else {
+          res[i].set_string(NULL, 0);
+        }
+      } else {
+        const ObString m_text = text->get_string();
+        const int32_t buf_len = m_text.length() * multiply;
+        char *buf = expr.get_str_res_mem(ctx, buf_len, i);
+        int32_t out_len = m_text.length();
+        if (OB_ISNULL(buf)) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_ERROR("alloc memory failed", "size", buf_len);
+        } else if (!ascii_compatible
+                   || !ascii_case_convert(m_text.ptr(), m_text.length(), buf, lower)) {
+          out_len = calc_common_inner(buf, buf_len, m_text, cs_type, lower);
+        }
+        if (OB_FAIL(ret)) {
+        } else if (OB_UNLIKELY(empty_as_null && 0 == out_len)) {
+          res[i].set_null();
+        } else {
+          res[i].set_string(buf, out_len);
+        }
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObExprLowerUpper::calc_nls_common(const ObExpr &expr, ObEvalCtx &ctx,
                                       ObDatum &expr_datum, bool lower)
 {
@@ -526,6 +635,18 @@ int ObExprUpper::calc_upper(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_da
   return calc_common(expr, ctx, expr_datum, false, CS_TYPE_INVALID);
 }
 
+int ObExprLower::calc_lower_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                  const ObBitVector &skip, const int64_t batch_size)
+{
+  return calc_common_batch(expr, ctx, skip, batch_size, true);
+}
+
+int ObExprUpper::calc_upper_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                  const ObBitVector &skip, const int64_t batch_size)
+{
+  return calc_common_batch(expr, ctx, skip, batch_size, false);
+}
+
 int ObExprNlsLower::calc(const ObCollationType cs_type, char *src, int32_t src_len,
                          char *dst, int32_t dst_len, int32_t &out_len) const
 {
@@ -38,6 +38,15 @@ public:
                          ObDatum &expr_datum, bool lower, common::ObCollationType cs_type);
   static int calc_nls_common(const ObExpr &expr, ObEvalCtx &ctx,
                              ObDatum &expr_datum, bool lower);
+  static int calc_common_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                               const ObBitVector &skip, const int64_t batch_size,
+                               const bool lower);
+  // Whether ObCharset::casedn/caseup of @cs_type maps ASCII letters as the C locale does and
+  // keeps other ASCII bytes unchanged, so that ascii_case_convert() can be used.
+  static bool is_ascii_case_compatible(const common::ObCollationType cs_type);
+  // Convert ASCII letters of @src into @dst, return false if @src has non-ASCII byte.
+  // The loop is branch free to be auto vectorized.
+  static bool ascii_case_convert(const char *src, const int32_t len, char *dst, const bool lower);
   int cg_expr_common(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr, ObExpr &rt_expr) const;
   int cg_expr_nls_common(ObExprCGCtx &op_cg_ctx,
                          const ObRawExpr &raw_expr,
@@ -66,6 +75,8 @@ public:
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   static int calc_lower(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int calc_lower_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                              const ObBitVector &skip, const int64_t batch_size);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprLower);
 };
@@ -82,6 +93,8 @@ public:
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   static int calc_upper(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int calc_upper_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                              const ObBitVector &skip, const int64_t batch_size);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprUpper);
 };
@@ -127,6 +127,7 @@ int ObExprRegexpLike::cg_expr(ObExprCGCtx &op_cg_ctx, const ObRawExpr &raw_expr,
       const bool const_pattern = pattern->is_const_expr();
       rt_expr.extra_ = (!const_text && const_pattern) ? 1 : 0;
       rt_expr.eval_func_ = &eval_regexp_like;
+      rt_expr.eval_batch_func_ = &eval_regexp_like_batch;
       LOG_DEBUG("regexp like expr cg", K(const_text), K(const_pattern), K(rt_expr.extra_));
     }
   }
@@ -228,5 +229,129 @@ int ObExprRegexpLike::eval_regexp_like(
   return ret;
 }
 
+// When pattern and match type are the same for all rows, the row path already reuses the
+// compiled regex kept in the expr op ctx, but it still parses the flags, converts the pattern to
+// utf16 and preprocesses it (in ObExprRegexContext::init) for every row, the converted pattern
+// being allocated from the exec ctx allocator. Here these are done once for the batch.
+int ObExprRegexpLike::eval_regexp_like_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                             const ObBitVector &skip, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  const bool reusable = (0 != expr.extra_) && ObExpr::INVALID_EXP_CTX_ID != expr.expr_ctx_id_;
+  ObDatum *res = expr.locate_batch_datums(ctx);
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  for (int64_t i = 0; OB_SUCC(ret) && i < expr.arg_cnt_; ++i) {
+    if (OB_FAIL(expr.args_[i]->eval_batch(ctx, skip, batch_size))) {
+      LOG_WARN("eval args failed", K(ret), K(i));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (!reusable
+             || expr.args_[1]->is_batch_result()
+             || (3 == expr.arg_cnt_ && expr.args_[2]->is_batch_result())
+             || ob_is_text_tc(expr.args_[0]->datum_meta_.type_)) {
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    batch_info_guard.set_batch_size(batch_size);
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      batch_info_guard.set_batch_idx(i);
+      if (OB_FAIL(eval_regexp_like(expr, ctx, res[i]))) {
+        LOG_WARN("eval regexp like failed", K(ret), K(i));
+      } else {
+        eval_flags.set(i);
+      }
+    }
+  } else {
+    ObDatumVector texts = expr.args_[0]->locate_expr_datumvector(ctx);
+    const ObDatum &pattern = expr.args_[1]->locate_expr_datum(ctx, 0);
+    const ObDatum *match_type = (3 == expr.arg_cnt_)
+                                ? &expr.args_[2]->locate_expr_datum(ctx, 0) : NULL;
+    const ObCollationType text_cs_type = expr.args_[0]->datum_meta_.cs_type_;
+    const ObCollationType pattern_cs_type = expr.args_[1]->datum_meta_.cs_type_;
+    const bool need_convert = (CS_TYPE_UTF8MB4_BIN == text_cs_type
+                               || CS_TYPE_UTF8MB4_GENERAL_CI == text_cs_type);
+    const ObCollationType utf16_cs_type = ObCharset::is_bin_sort(text_cs_type)
+                                          ? CS_TYPE_UTF16_BIN : CS_TYPE_UTF16_GENERAL_CI;
+    const bool res_null = pattern.is_null()
+        || (lib::is_mysql_mode() && NULL != match_type && match_type->is_null());
+    ObExprRegexContext *regexp_ctx = NULL;
+    bool prepared = false;
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      if (!prepared) {
+        // same checks as eval_regexp_like, done on the first row to be evaluated
+        uint32_t flags = 0;
+        ObString match_param = (NULL != match_type && !match_type->is_null())
+                               ? match_type->get_string() : ObString();
+        if (OB_UNLIKELY((text_cs_type != CS_TYPE_UTF8MB4_GENERAL_CI &&
+                         text_cs_type != CS_TYPE_UTF8MB4_BIN &&
+                         text_cs_type != CS_TYPE_UTF16_GENERAL_CI &&
+                         text_cs_type != CS_TYPE_UTF16_BIN) ||
+                        (pattern_cs_type != CS_TYPE_UTF8MB4_GENERAL_CI &&
+                         pattern_cs_type != CS_TYPE_UTF8MB4_BIN &&
+                         pattern_cs_type != CS_TYPE_UTF16_GENERAL_CI &&
+                         pattern_cs_type != CS_TYPE_UTF16_BIN))) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("get unexpected error", K(ret), K(expr));
+        } else if (lib::is_mysql_mode() && !pattern.is_null() && pattern.get_string().empty()) {
+          if (NULL == match_type || !match_type->is_null()) {
+            ret = OB_ERR_REGEXP_ERROR;
+            LOG_WARN("empty regex expression", K(ret));
+          }
+        } else if (NULL == (regexp_ctx = static_cast<ObExprRegexContext *>(
+                    ctx.exec_ctx_.get_expr_op_ctx(expr.expr_ctx_id_)))
+                   && OB_FAIL(ctx.exec_ctx_.create_expr_op_ctx(expr.expr_ctx_id_, regexp_ctx))) {
+          LOG_WARN("create expr regex context failed", K(ret), K(expr));
+        } else if (OB_ISNULL(regexp_ctx)) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("NULL context returned", K(ret));
+        } else if (OB_FAIL(ObExprRegexContext::get_regexp_flags(match_param,
+                                                                ObCharset::is_bin_sort(text_cs_type),
+                                                                flags))) {
+          LOG_WARN("fail to get regexp flags", K(ret), K(match_param));
+        } else if (!pattern.is_null() &&
+                   OB_FAIL(regexp_ctx->init(ctx.exec_ctx_.get_allocator(),
+                                            ctx.exec_ctx_.get_my_session(),
+                                            pattern.get_string(), flags, reusable,
+                                            pattern_cs_type))) {
+          LOG_WARN("fail to init regexp", K(pattern), K(flags), K(ret));
+        }
+        prepared = true;
+      }
+      const ObDatum *text = texts.at(i);
+      if (OB_FAIL(ret)) {
+      } else if (res_null || text->is_null()) {
+        res[i].set_null();
+      } else {
+        ObEvalCtx::TempAllocGuard alloc_guard(ctx);
+        ObIAllocator &tmp_alloc = alloc_guard.get_allocator();
+        ObString text_utf16;
+        bool match = false;
+        if (!need_convert) {
+          text_utf16 = text->get_string();
+        } else if (OB_FAIL(ObExprUtil::convert_string_collation(text->get_string(), text_cs_type,
+                                                                text_utf16, utf16_cs_type,
+                                                                tmp_alloc))) {
+          LOG_WARN("convert charset failed", K(ret));
+        }
+        if (OB_FAIL(ret)) {
+        } else if (OB_FAIL(regexp_ctx->match(tmp_alloc, text_utf16, 0, match))) {
+          LOG_WARN("fail to match", K(ret), KPC(text));
+        } else {
+          res[i].set_int32(match);
+        }
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 }
 }
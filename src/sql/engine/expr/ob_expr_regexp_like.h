@@ -35,6 +35,8 @@ public:
   virtual bool need_rt_ctx() const override { return true; }
 
   static int eval_regexp_like(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int eval_regexp_like_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                    const ObBitVector &skip, const int64_t batch_size);
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExprRegexpLike);
 };
@@ -401,6 +401,7 @@ int ObExprTrim::cg_expr(ObExprCGCtx &, const ObRawExpr &, ObExpr &rt_expr) const
   int ret = OB_SUCCESS;
   CK(1 <= rt_expr.arg_cnt_ && rt_expr.arg_cnt_ <= 3);
   rt_expr.eval_func_ = eval_trim;
+  rt_expr.eval_batch_func_ = eval_trim_batch;
   return ret;
 }
 
@@ -866,6 +867,75 @@ int ObExprTrim::eval_trim(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datu
   return ret;
 }
 
+// trim()/ltrim()/rtrim() of one string param trims the default pattern, which is filled once
+// for the whole batch. Others are calculated row by row.
+int ObExprTrim::eval_trim_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                                const ObBitVector &skip, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  ObDatum *res = expr.locate_batch_datums(ctx);
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  for (int64_t j = 0; OB_SUCC(ret) && j < expr.arg_cnt_; j++) {
+    if (OB_FAIL(expr.args_[j]->eval_batch(ctx, skip, batch_size))) {
+      LOG_WARN("eval param failed", K(ret), K(j));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (1 != expr.arg_cnt_ || ob_is_text_tc(expr.args_[0]->datum_meta_.type_)) {
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    batch_info_guard.set_batch_size(batch_size);
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; i++) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      batch_info_guard.set_batch_idx(i);
+      if (OB_FAIL(eval_trim(expr, ctx, res[i]))) {
+        LOG_WARN("eval trim failed", K(ret), K(i));
+      } else {
+        eval_flags.set(i);
+      }
+    }
+  } else {
+    const int64_t trim_type = (T_FUN_SYS_LTRIM == expr.type_ ? TYPE_LTRIM
+                               : (T_FUN_SYS_RTRIM == expr.type_ ? TYPE_RTRIM : TYPE_LRTRIM));
+    const bool empty_as_null = lib::is_oracle_mode();
+    char default_pattern_buffer[8];
+    int64_t out_len = 0;
+    ObString pattern;
+    if (OB_FAIL(fill_default_pattern(default_pattern_buffer,
+                                     sizeof(default_pattern_buffer),
+                                     expr.datum_meta_.cs_type_,
+                                     out_len))) {
+      LOG_WARN("fill default pattern failed", K(ret));
+    } else if (out_len <= 0) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected out length", K(ret), K(out_len));
+    } else {
+      pattern.assign_ptr(default_pattern_buffer, static_cast<int32_t>(out_len));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; i++) {
+      if (skip.at(i) || eval_flags.at(i)) {
+        continue;
+      }
+      const ObDatum &str_datum = expr.args_[0]->locate_expr_datum(ctx, i);
+      ObString output;
+      if (str_datum.is_null()) {
+        res[i].set_null();
+      } else if (OB_FAIL(trim(output, trim_type, pattern, str_datum.get_string()))) {
+        LOG_WARN("do trim failed", K(ret));
+      } else if (output.empty() && empty_as_null) {
+        res[i].set_null();
+      } else {
+        res[i].set_string(output);
+      }
+      if (OB_SUCC(ret)) {
+        eval_flags.set(i);
+      }
+    }
+  }
+  return ret;
+}
+
 // Ltrim start
 ObExprLtrim::ObExprLtrim(ObIAllocator &alloc)
     : ObExprTrim(alloc, T_FUN_SYS_LTRIM, N_LTRIM, (lib::is_oracle_mode()) ? ONE_OR_TWO : 1)
@@ -977,6 +1047,7 @@ int ObExprLtrim::cg_expr(ObExprCGCtx &, const ObRawExpr &, ObExpr &rt_expr) cons
   CK(1 == rt_expr.arg_cnt_ || 2 == rt_expr.arg_cnt_);
   // trim type is detected by expr type in ObExprTrim::eval_trim
   rt_expr.eval_func_ = &ObExprTrim::eval_trim;
+  rt_expr.eval_batch_func_ = &ObExprTrim::eval_trim_batch;
   return ret;
 }
 
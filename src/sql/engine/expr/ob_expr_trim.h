@@ -68,6 +68,8 @@ public:
                       ObExpr &rt_expr) const override;
 
   static int eval_trim(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &expr_datum);
+  static int eval_trim_batch(const ObExpr &expr, ObEvalCtx &ctx,
+                             const ObBitVector &skip, const int64_t batch_size);
 
   // fill ' ' to %buf with specified charset.
   static int fill_default_pattern(char *buf, const int64_t in_len,
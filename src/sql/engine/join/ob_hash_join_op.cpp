@@ -168,6 +168,7 @@ ObHashJoinOp::ObHashJoinOp(ObExecContext &ctx_, const ObOpSpec &spec, ObOpInput
   force_hash_join_spill_(false),
   hash_join_processor_(7),
   tenant_id_(-1),
+  join_method_crossover_ratio_(0),
   input_size_(0),
   total_extra_size_(0),
   predict_row_cnt_(1024),
@@ -417,6 +418,13 @@ int ObHashJoinOp::inner_open()
     init_system_parameters();
     tenant_id_ = session->get_effective_tenant_id();
     first_get_row_ = true;
+    if ((join_method_crossover_ratio_ = get_join_method_crossover_ratio()) > 0) {
+      op_monitor_info_.otherstat_1_id_ = ObSqlMonitorStatIds::JOIN_METHOD_CROSSOVER_ROW_COUNT;
+      op_monitor_info_.otherstat_2_id_ = ObSqlMonitorStatIds::JOIN_METHOD_SWITCH;
+      op_monitor_info_.otherstat_1_value_ = left_->get_spec().rows_ / join_method_crossover_ratio_;
+      op_monitor_info_.otherstat_2_value_ = JMS_KEEP;
+      start_join_method_check();
+    }
     ObTenantConfigGuard tenant_config(TENANT_CONF(session->get_effective_tenant_id()));
     if (tenant_config.is_valid()) {
       force_hash_join_spill_ = tenant_config->_force_hash_join_spill;
@@ -2916,20 +2924,38 @@ void ObHashJoinOp::trace_hash_table_collision(int64_t row_cnt)
     "avg_cnt", ((double)total_cnt/(double)used_bucket_cnt), K(total_cnt),
     K(row_cnt), K(used_bucket_cnt));
   // 记录到虚拟表供查询
-  op_monitor_info_.otherstat_1_value_ = 0;
-  op_monitor_info_.otherstat_2_value_ = 0;
+  if (join_method_crossover_ratio_ <= 0) {
+    // otherwise slot 1 and 2 show the check of join method
+    op_monitor_info_.otherstat_1_value_ = 0;
+    op_monitor_info_.otherstat_2_value_ = 0;
+    op_monitor_info_.otherstat_1_id_ = ObSqlMonitorStatIds::HASH_SLOT_MIN_COUNT;;
+    op_monitor_info_.otherstat_2_id_ = ObSqlMonitorStatIds::HASH_SLOT_MAX_COUNT;
+  }
   op_monitor_info_.otherstat_3_value_ = total_cnt;
   op_monitor_info_.otherstat_4_value_ = nbuckets;
   op_monitor_info_.otherstat_5_value_ = used_bucket_cnt;
   op_monitor_info_.otherstat_6_value_ = row_cnt;
-  op_monitor_info_.otherstat_1_id_ = ObSqlMonitorStatIds::HASH_SLOT_MIN_COUNT;;
-  op_monitor_info_.otherstat_2_id_ = ObSqlMonitorStatIds::HASH_SLOT_MAX_COUNT;
   op_monitor_info_.otherstat_3_id_ = ObSqlMonitorStatIds::HASH_SLOT_TOTAL_COUNT;
   op_monitor_info_.otherstat_4_id_ = ObSqlMonitorStatIds::HASH_BUCKET_COUNT;
   op_monitor_info_.otherstat_5_id_ = ObSqlMonitorStatIds::HASH_NON_EMPTY_BUCKET_COUNT;
   op_monitor_info_.otherstat_6_id_ = ObSqlMonitorStatIds::HASH_ROW_COUNT;
 }
 
+void ObHashJoinOp::check_join_method(const int64_t num_left_rows)
+{
+  // empty build side skips reading the probe side, no need to switch
+  const int64_t crossover_rows = join_method_crossover_ratio_ > 0
+                                 ? left_->get_spec().rows_ / join_method_crossover_ratio_
+                                 : 0;
+  if (num_left_rows > 0 && num_left_rows < crossover_rows
+      && JMS_KEEP == op_monitor_info_.otherstat_2_value_) {
+    op_monitor_info_.otherstat_2_value_ = JMS_TO_NESTED_LOOP_JOIN;
+    report_join_card_misestimate();
+    LOG_TRACE("hash join build rows are far less than estimated", K(num_left_rows),
+              K(crossover_rows), "est_left_rows", left_->get_spec().rows_);
+  }
+}
+
 int ObHashJoinOp::build_hash_table_for_recursive()
 {
   int ret = OB_SUCCESS;
@@ -3647,6 +3673,9 @@ int ObHashJoinOp::recursive_process(bool &need_not_read_right)
   } else if (OB_FAIL(split_partition_and_build_hash_table(num_left_rows))) {
     LOG_WARN("failed to build hash table", K(ret), K(part_level_));
   }
+  if (OB_SUCC(ret) && top_part_level()) {
+    check_join_method(num_left_rows);
+  }
   if (OB_SUCC(ret)
       && !is_shared_
       && ((0 == num_left_rows
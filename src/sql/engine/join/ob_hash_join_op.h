@@ -873,6 +873,8 @@ private:
   int split_partition(int64_t &num_left_rows);
   int prepare_hash_table();
   void trace_hash_table_collision(int64_t row_cnt);
+  // nested loop join is expected to be cheaper when the build rows are far less than estimated
+  void check_join_method(const int64_t num_left_rows);
   int build_hash_table_for_recursive();
   int split_partition_and_build_hash_table(int64_t &num_left_rows);
   int recursive_process(bool &need_not_read_right);
@@ -1161,6 +1163,8 @@ private:
   bool force_hash_join_spill_;
   int8_t hash_join_processor_;
   int64_t tenant_id_;
+  // ratio of estimated to observed build rows to switch join method, 0 means not checked
+  int64_t join_method_crossover_ratio_;
   int64_t input_size_;
   int64_t total_extra_size_;
   int64_t predict_row_cnt_;
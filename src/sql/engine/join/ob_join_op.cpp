@@ -13,6 +13,11 @@
 #define USING_LOG_PREFIX SQL_ENG
 
 #include "sql/engine/join/ob_join_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_physical_plan.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "sql/ob_sql_context.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -111,5 +116,53 @@ int ObJoinOp::get_next_right_row()
   return ret;
 }
 
+int64_t ObJoinOp::get_join_method_crossover_ratio() const
+{
+  int64_t ratio = 0;
+  const ObSQLSessionInfo *session = ctx_.get_my_session();
+  if (OB_ISNULL(spec_.plan_) || OB_ISNULL(session) || OB_ISNULL(ctx_.get_sql_ctx())) {
+    // do nothing
+  } else if (spec_.plan_->is_use_px()) {
+    // px worker sees part of the rows and runs a copy of the plan
+  } else {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session->get_effective_tenant_id()));
+    if (OB_LIKELY(tenant_config.is_valid())) {
+      ratio = tenant_config->_adaptive_join_crossover_ratio;
+    }
+  }
+  return ratio;
+}
+
+bool ObJoinOp::is_plan_cache_hit() const
+{
+  // plan added by this execution (spm evolution included) is not a plan cache hit
+  const ObSqlCtx *sql_ctx = ctx_.get_sql_ctx();
+  return NULL != sql_ctx && sql_ctx->plan_cache_hit_ && !sql_ctx->self_add_plan_;
+}
+
+void ObJoinOp::start_join_method_check()
+{
+  ObPhysicalPlanCtx *plan_ctx = ctx_.get_physical_plan_ctx();
+  if (OB_ISNULL(plan_ctx) || OB_ISNULL(plan_ctx->get_phy_plan())) {
+    // do nothing
+  } else {
+    const_cast<ObPhysicalPlan *>(plan_ctx->get_phy_plan())->inc_join_method_check_times(
+        is_plan_cache_hit());
+  }
+}
+
+void ObJoinOp::report_join_card_misestimate()
+{
+  ObPhysicalPlanCtx *plan_ctx = ctx_.get_physical_plan_ctx();
+  if (OB_ISNULL(plan_ctx) || OB_ISNULL(plan_ctx->get_phy_plan())) {
+    // do nothing
+  } else {
+    const bool plan_cache_hit = is_plan_cache_hit();
+    const_cast<ObPhysicalPlan *>(plan_ctx->get_phy_plan())->report_join_card_misestimate(
+        plan_cache_hit);
+    LOG_TRACE("join cardinality misestimated", K(spec_.id_), K(spec_.type_), K(plan_cache_hit));
+  }
+}
+
 } // namespace sql
 } // namespace oceanbase
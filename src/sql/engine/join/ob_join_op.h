@@ -39,6 +39,14 @@ private:
 class ObJoinOp: public ObOperator
 {
 public:
+  // switch of join method reported to sql plan monitor
+  enum JoinMethodSwitch
+  {
+    JMS_KEEP = 0,
+    JMS_TO_HASH_JOIN = 1,
+    JMS_TO_NESTED_LOOP_JOIN = 2
+  };
+
   ObJoinOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput *input)
     : ObOperator(exec_ctx, spec, input),
       output_row_produced_(false),
@@ -66,6 +74,18 @@ public:
   const ObJoinSpec &get_spec() const
   { return static_cast<const ObJoinSpec &>(spec_); }
 
+protected:
+  // Join method is chosen by optimizer from estimated cardinality, get the ratio of observed
+  // to estimated rows beyond which the other join method is expected to be cheaper.
+  // 0 if the check is disabled or can not be done for this plan.
+  int64_t get_join_method_crossover_ratio() const;
+  // count the check of join method done by this execution in the plan stat
+  void start_join_method_check();
+  // let the cached plan be generated again with the params of its next execution
+  void report_join_card_misestimate();
+private:
+  bool is_plan_cache_hit() const;
+
 public:
   // 记录当前join算子output是否生成，用于结束状态机的while循环
   bool output_row_produced_;
@@ -15,6 +15,7 @@
 #include "sql/engine/join/ob_nested_loop_join_op.h"
 #include "sql/engine/table/ob_table_scan_op.h"
 #include "sql/engine/ob_exec_context.h"
+#include "share/diagnosis/ob_sql_monitor_statname.h"
 
 namespace oceanbase
 {
@@ -41,7 +42,8 @@ ObNestedLoopJoinOp::ObNestedLoopJoinOp(ObExecContext &exec_ctx,
     max_group_size_(OB_MAX_BULK_JOIN_ROWS),
     group_join_buffer_(),
     match_left_batch_end_(false), match_right_batch_end_(false), l_idx_(0),
-    no_match_row_found_(true), need_output_row_(false), left_expr_extend_size_(0)
+    no_match_row_found_(true), need_output_row_(false), left_expr_extend_size_(0),
+    outer_row_cnt_(0), join_method_crossover_row_cnt_(0)
 {
   state_operation_func_[JS_JOIN_END] = &ObNestedLoopJoinOp::join_end_operate;
   state_function_func_[JS_JOIN_END][FT_ITER_GOING] = NULL;
@@ -64,6 +66,8 @@ int ObNestedLoopJoinOp::inner_open()
     LOG_WARN("nlp_op child is null", KP(left_), KP(right_), K(ret));
   } else if (OB_FAIL(ObBasicNestedLoopJoinOp::inner_open())) {
     LOG_WARN("failed to open in base class", K(ret));
+  } else {
+    init_join_method_crossover();
   }
   if (OB_SUCC(ret) && is_vectorized()) {
     if (MY_SPEC.group_rescan_) {
@@ -122,6 +126,33 @@ int ObNestedLoopJoinOp::inner_open()
   }
   return ret;
 }
+
+void ObNestedLoopJoinOp::init_join_method_crossover()
+{
+  int64_t ratio = 0;
+  outer_row_cnt_ = 0;
+  join_method_crossover_row_cnt_ = 0;
+  if (MY_SPEC.rescan_params_.empty()) {
+    // inner side is not driven by outer rows, no index rescan to save
+  } else if ((ratio = get_join_method_crossover_ratio()) > 0) {
+    const int64_t est_outer_rows = std::max(left_->get_spec().rows_, 1L);
+    if (est_outer_rows > INT64_MAX / ratio) {
+      join_method_crossover_row_cnt_ = INT64_MAX;
+    } else if (est_outer_rows * ratio < MIN_JOIN_METHOD_CROSSOVER_ROWS) {
+      join_method_crossover_row_cnt_ = MIN_JOIN_METHOD_CROSSOVER_ROWS;
+    } else {
+      join_method_crossover_row_cnt_ = est_outer_rows * ratio;
+    }
+    op_monitor_info_.otherstat_1_id_ = ObSqlMonitorStatIds::JOIN_METHOD_CROSSOVER_ROW_COUNT;
+    op_monitor_info_.otherstat_2_id_ = ObSqlMonitorStatIds::JOIN_METHOD_OUTER_ROW_COUNT;
+    op_monitor_info_.otherstat_3_id_ = ObSqlMonitorStatIds::JOIN_METHOD_SWITCH;
+    op_monitor_info_.otherstat_1_value_ = join_method_crossover_row_cnt_;
+    op_monitor_info_.otherstat_2_value_ = 0;
+    op_monitor_info_.otherstat_3_value_ = JMS_KEEP;
+    start_join_method_check();
+  }
+}
+
 //NLJ has its own switch_iterator
 int ObNestedLoopJoinOp::switch_iterator()
 {
@@ -177,6 +208,7 @@ int ObNestedLoopJoinOp::inner_rescan()
   int ret = OB_SUCCESS;
   reset_buf_state();
   set_param_null();
+  outer_row_cnt_ = 0;
   if (OB_FAIL(ObBasicNestedLoopJoinOp::inner_rescan())) {
     LOG_WARN("failed to rescan", K(ret));
   }
@@ -280,6 +312,7 @@ int ObNestedLoopJoinOp::join_row_with_semi_join()
   const bool is_anti = (LEFT_ANTI_JOIN == MY_SPEC.join_type_);
   while (OB_SUCC(ret) && OB_SUCC(get_next_left_row())) {
     clear_evaluated_flag();
+    count_outer_row();
     if (OB_FAIL(try_check_status())) {
       LOG_WARN("check status failed", K(ret));
     } else if (OB_FAIL(prepare_rescan_params())) {
@@ -542,6 +575,7 @@ int ObNestedLoopJoinOp::group_read_left_operate()
 int ObNestedLoopJoinOp::read_left_func_going()
 {
   int ret = OB_SUCCESS;
+  count_outer_row();
   if (MY_SPEC.group_rescan_ || MY_SPEC.enable_px_batch_rescan_) {
     // do nothing
     // group nested loop join 已经做过 rescan 了
@@ -800,6 +834,7 @@ int ObNestedLoopJoinOp::rescan_right_op()
   // Adding seperated guards for left/right children can also solve the problem,
   // we don't choose that way due to performance reason.
   batch_info_guard.set_batch_size(left_brs_->size_);
+  count_outer_row();
   if (!MY_SPEC.group_rescan_ && !MY_SPEC.enable_px_batch_rescan_) {
     batch_info_guard.set_batch_idx(l_idx_);
     if (OB_FAIL(rescan_params_batch_one(l_idx_))) {
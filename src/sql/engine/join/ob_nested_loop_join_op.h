@@ -70,6 +70,8 @@ private:
 class ObNestedLoopJoinOp : public ObBasicNestedLoopJoinOp
 {
 public:
+  // don't switch join method for small outer side however it is misestimated
+  static const int64_t MIN_JOIN_METHOD_CROSSOVER_ROWS = 10000;
   enum ObJoinBatchState {
     JS_FILL_LEFT = 0,
     JS_RESCAN_RIGHT_OP,
@@ -167,6 +169,22 @@ private:
   // for refactor vectorized end
 
   bool continue_fetching() { return !(left_brs_->end_ || is_full());}
+
+  // each outer row rescans the inner side, hash join is expected to be cheaper when the
+  // outer rows are far more than estimated.
+  void init_join_method_crossover();
+  OB_INLINE void count_outer_row()
+  {
+    if (join_method_crossover_row_cnt_ > 0) {
+      op_monitor_info_.otherstat_2_value_++;
+      // outer rows are counted again after rescan, report once for each open
+      if (OB_UNLIKELY(++outer_row_cnt_ == join_method_crossover_row_cnt_)
+          && JMS_KEEP == op_monitor_info_.otherstat_3_value_) {
+        op_monitor_info_.otherstat_3_value_ = JMS_TO_HASH_JOIN;
+        report_join_card_misestimate();
+      }
+    }
+  }
 public:
   ObJoinState state_;
   // for bnl join
@@ -206,6 +224,9 @@ public:
   bool need_output_row_;
   int32_t left_expr_extend_size_;
   // for refactor vectorized end
+  // outer rows since open (rescan), 0 crossover means not checked
+  int64_t outer_row_cnt_;
+  int64_t join_method_crossover_row_cnt_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObNestedLoopJoinOp);
 };
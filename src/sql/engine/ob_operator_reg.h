@@ -437,7 +437,7 @@ REGISTER_OPERATOR(ObLogJoin, PHY_MERGE_JOIN, ObMergeJoinSpec, ObMergeJoinOp,
 class ObLogTopk;
 class ObTopKSpec;
 class ObTopKOp;
-REGISTER_OPERATOR(ObLogTopk, PHY_TOPK, ObTopKSpec, ObTopKOp, NOINPUT);
+REGISTER_OPERATOR(ObLogTopk, PHY_TOPK, ObTopKSpec, ObTopKOp, NOINPUT, VECTORIZED_OP);
 
 class ObLogMonitoringDump;
 class ObMonitoringDumpSpec;
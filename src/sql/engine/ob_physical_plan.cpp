@@ -636,6 +636,38 @@ bool ObPhysicalPlan::is_plan_unstable(const int64_t sample_count,
   return bret;
 }
 
+// A plan hit in plan cache was generated with the params of some earlier execution, it is
+// expired to get the join method chosen again with the params of the next execution, when
+// the join cardinality is misestimated in most of the sampled join method checks.
+// The plan generated again fits most executions, so the others can't expire it in turn, and
+// statements with alternating params don't keep generating the plan.
+// A plan misestimated in the execution generating it would get the same join method, it is kept.
+void ObPhysicalPlan::inc_join_method_check_times(const bool is_plan_cache_hit)
+{
+  if (!is_plan_cache_hit || is_expired() || ATOMIC_LOAD(&(stat_.join_card_misestimated_))) {
+    // do nothing
+  } else if (ATOMIC_AAF(&(stat_.join_method_check_times_), 1) > JOIN_CARD_SAMPLE_TIMES) {
+    // most checks of the previous sample are not misestimated, start a new sample
+    ATOMIC_STORE(&(stat_.join_method_check_times_), 1);
+    ATOMIC_STORE(&(stat_.join_card_misestimate_times_), 0);
+  }
+}
+
+void ObPhysicalPlan::report_join_card_misestimate(const bool is_plan_cache_hit)
+{
+  if (!is_plan_cache_hit) {
+    ATOMIC_STORE(&(stat_.join_card_misestimated_), true);
+  } else if (!is_expired() && !ATOMIC_LOAD(&(stat_.join_card_misestimated_))) {
+    const int64_t misestimate_times = ATOMIC_AAF(&(stat_.join_card_misestimate_times_), 1);
+    if (misestimate_times * 2 > JOIN_CARD_SAMPLE_TIMES) {
+      // most checks of the sample are misestimated whatever the others are
+      set_is_expired(true);
+      LOG_INFO("query plan is expired due to join cardinality misestimate",
+               "plan_id", get_plan_id(), K(misestimate_times), K(stat_.execute_times_));
+    }
+  }
+}
+
 int64_t ObPhysicalPlan::get_evo_perf() const {
   int64_t v = 0;
   if (0 == stat_.evolution_stat_.executions_) {
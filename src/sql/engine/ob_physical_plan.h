@@ -149,6 +149,10 @@ public:
                         const int64_t sample_exec_usec);
   bool is_expired() const { return stat_.is_expired_; }
   void set_is_expired(bool expired) { stat_.is_expired_ = expired; }
+  // called by join operators when they start to check the join method in an execution
+  void inc_join_method_check_times(const bool is_plan_cache_hit);
+  // called by join operators when the observed cardinality crosses the crossover of join methods
+  void report_join_card_misestimate(const bool is_plan_cache_hit);
   void inc_large_querys();
   void inc_delayed_large_querys();
   void inc_delayed_px_querys();
@@ -484,6 +488,7 @@ private:
   static const int64_t COMMON_SQL_EXPR_NUM = 256;
   static const int64_t COMMON_PARAM_NUM = 12;
   static const int64_t SAMPLE_TIMES = 10;
+  static const int64_t JOIN_CARD_SAMPLE_TIMES = 10;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObPhysicalPlan);
 private:
@@ -0,0 +1,200 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include "sql/engine/px/datahub/components/ob_dh_skew_detect.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/ob_dfo.h"
+#include "sql/engine/px/ob_px_util.h"
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+#include "sql/engine/px/ob_px_scheduler.h"
+#include "sql/engine/ob_exec_context.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+OB_SERIALIZE_MEMBER(ObSkewValueFreq, hash_val_, cnt_);
+OB_SERIALIZE_MEMBER((ObSkewDetectPieceMsg, ObDatahubPieceMsg),
+                    build_op_id_, dop_, sample_row_cnt_, candidates_);
+OB_SERIALIZE_MEMBER((ObSkewDetectWholeMsg, ObDatahubWholeMsg), popular_values_hash_);
+
+int ObSkewDetectPieceMsgListener::on_message(
+    ObSkewDetectPieceMsgCtx &ctx,
+    common::ObIArray<ObPxSqcMeta *> &sqcs,
+    const ObSkewDetectPieceMsg &pkt)
+{
+  int ret = OB_SUCCESS;
+  if (pkt.op_id_ != ctx.op_id_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected piece msg", K(pkt), K(ctx));
+  } else if (ctx.received_ >= ctx.task_cnt_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("should not receive any more pkt. already get all pkt expected",
+             K(pkt), K(ctx));
+  } else if (OB_FAIL(append(ctx.candidates_, pkt.candidates_))) {
+    LOG_WARN("failed to append candidates", K(pkt), K(ret));
+  } else {
+    ctx.received_++;
+    ctx.total_row_cnt_ += pkt.sample_row_cnt_;
+    ctx.dop_ = std::max(ctx.dop_, pkt.dop_);
+    LOG_TRACE("got a skew detect piece msg", "all_got", ctx.received_, "expected", ctx.task_cnt_);
+  }
+  if (OB_SUCC(ret) && ctx.received_ == ctx.task_cnt_) {
+    if (pkt.is_probe_side()) {
+      if (OB_FAIL(ctx.fetch_popular_values(pkt.build_op_id_))) {
+        LOG_WARN("failed to fetch popular values", K(ret));
+      }
+    } else if (OB_FAIL(ctx.detect_popular_values())) {
+      LOG_WARN("failed to detect popular values", K(ret));
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(ctx.send_whole_msg(sqcs))) {
+      LOG_WARN("fail to send whole msg", K(ret));
+    }
+    IGNORE_RETURN ctx.reset_resource();
+  }
+  return ret;
+}
+
+int ObSkewDetectPieceMsgCtx::detect_popular_values()
+{
+  int ret = OB_SUCCESS;
+  whole_msg_.reset();
+  // the same value may be reported by several workers, add up the counts
+  std::sort(candidates_.begin(), candidates_.end(),
+            [](const ObSkewValueFreq &l, const ObSkewValueFreq &r)
+            { return l.hash_val_ < r.hash_val_; });
+  ObSEArray<ObSkewValueFreq, 16> merged;
+  for (int64_t i = 0; OB_SUCC(ret) && i < candidates_.count(); ++i) {
+    const ObSkewValueFreq &cur = candidates_.at(i);
+    if (!merged.empty() && merged.at(merged.count() - 1).hash_val_ == cur.hash_val_) {
+      merged.at(merged.count() - 1).cnt_ += cur.cnt_;
+    } else if (OB_FAIL(merged.push_back(cur))) {
+      LOG_WARN("failed to push back candidate", K(ret));
+    }
+  }
+  if (OB_FAIL(ret) || probe_fetched_) {
+    // probe side has been told there is no popular value
+  } else {
+    std::sort(merged.begin(), merged.end(),
+              [](const ObSkewValueFreq &l, const ObSkewValueFreq &r)
+              { return l.cnt_ > r.cnt_; });
+    for (int64_t i = 0; OB_SUCC(ret) && i < merged.count()
+         && whole_msg_.popular_values_hash_.count() < MAX_POPULAR_VALUE_COUNT; ++i) {
+      if (!is_popular(merged.at(i).cnt_, total_row_cnt_, dop_, min_freq_)) {
+        break;
+      } else if (OB_FAIL(whole_msg_.popular_values_hash_.push_back(merged.at(i).hash_val_))) {
+        LOG_WARN("failed to push back popular value", K(ret));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    detected_ = true;
+    LOG_TRACE("skew detect done", K_(op_id), K_(total_row_cnt), K_(dop), K_(min_freq),
+              K(merged), K_(whole_msg));
+  }
+  return ret;
+}
+
+int ObSkewDetectPieceMsgCtx::fetch_popular_values(const uint64_t build_op_id)
+{
+  int ret = OB_SUCCESS;
+  ObPieceMsgCtx *piece_ctx = NULL;
+  whole_msg_.reset();
+  if (OB_FAIL(ctx_mgr_.find_piece_ctx(build_op_id, dtl::DH_SKEW_DETECT_PIECE_MSG, piece_ctx))) {
+    if (OB_ENTRY_NOT_EXIST == ret) {
+      // no build side worker asked for the decision, all build rows are hash distributed
+      ret = OB_SUCCESS;
+    } else {
+      LOG_WARN("fail get build side ctx", K(build_op_id), K(ret));
+    }
+  } else {
+    ObSkewDetectPieceMsgCtx *build_ctx = static_cast<ObSkewDetectPieceMsgCtx *>(piece_ctx);
+    if (OB_UNLIKELY(!build_ctx->detected_)) {
+      // build side is not drained yet, hash distribute all rows of both sides. The build side
+      // decides no popular value either, so that the two sides always agree.
+      build_ctx->probe_fetched_ = true;
+      LOG_TRACE("build side skew detection not finished, no popular value", K(*build_ctx));
+    } else if (OB_FAIL(whole_msg_.assign(build_ctx->whole_msg_))) {
+      LOG_WARN("fail to assign whole msg", K(ret));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    detected_ = true;
+  }
+  return ret;
+}
+
+int ObSkewDetectPieceMsgCtx::alloc_piece_msg_ctx(const ObSkewDetectPieceMsg &pkt,
+                                                 ObPxCoordInfo &coord_info,
+                                                 ObExecContext &ctx,
+                                                 int64_t task_cnt,
+                                                 ObPieceMsgCtx *&msg_ctx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(ctx.get_my_session()) ||
+      OB_ISNULL(ctx.get_physical_plan_ctx())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is null or physical plan ctx is null", K(ret));
+  } else {
+    void *buf = ctx.get_allocator().alloc(sizeof(ObSkewDetectPieceMsgCtx));
+    if (OB_ISNULL(buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      msg_ctx = new (buf) ObSkewDetectPieceMsgCtx(pkt.op_id_, task_cnt,
+          ctx.get_physical_plan_ctx()->get_timeout_timestamp(),
+          ctx.get_my_session()->get_effective_tenant_id(),
+          ctx.get_my_session()->get_px_join_skew_minfreq(),
+          coord_info.piece_msg_ctx_mgr_);
+    }
+  }
+  return ret;
+}
+
+int ObSkewDetectPieceMsgCtx::send_whole_msg(common::ObIArray<ObPxSqcMeta *> &sqcs)
+{
+  int ret = OB_SUCCESS;
+  // all piece msg has been received
+  whole_msg_.op_id_ = op_id_;
+  ARRAY_FOREACH_X(sqcs, idx, cnt, OB_SUCC(ret)) {
+    dtl::ObDtlChannel *ch = sqcs.at(idx)->get_qc_channel();
+    if (OB_ISNULL(ch)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null expected", K(ret));
+    } else if (OB_FAIL(ch->send(whole_msg_, timeout_ts_))) {
+      LOG_WARN("fail push data to channel", K(ret));
+    } else if (OB_FAIL(ch->flush(true, false))) {
+      LOG_WARN("fail flush dtl data", K(ret));
+    } else {
+      LOG_DEBUG("dispatched skew detect whole msg",
+                K(idx), K(cnt), K(whole_msg_), K(*ch));
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(ObPxChannelUtil::sqcs_channles_asyn_wait(sqcs))) {
+    LOG_WARN("failed to wait response", K(ret));
+  }
+  return ret;
+}
+
+void ObSkewDetectPieceMsgCtx::reset_resource()
+{
+  // keep whole_msg_ and detected_, the probe side reads them after the build side is done
+  received_ = 0;
+  dop_ = 0;
+  total_row_cnt_ = 0;
+  candidates_.reset();
+}
+
+int ObSkewDetectWholeMsg::assign(const ObSkewDetectWholeMsg &other)
+{
+  return popular_values_hash_.assign(other.popular_values_hash_);
+}
@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef __OB_SQL_ENG_PX_DH_SKEW_DETECT_H__
+#define __OB_SQL_ENG_PX_DH_SKEW_DETECT_H__
+
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+#include "sql/engine/px/datahub/ob_dh_dtl_proc.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/datahub/ob_dh_msg_provider.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+class ObSkewDetectPieceMsg;
+class ObSkewDetectWholeMsg;
+typedef ObPieceMsgP<ObSkewDetectPieceMsg> ObSkewDetectPieceMsgP;
+typedef ObWholeMsgP<ObSkewDetectWholeMsg> ObSkewDetectWholeMsgP;
+class ObSkewDetectPieceMsgListener;
+class ObSkewDetectPieceMsgCtx;
+class ObPxCoordInfo;
+
+/*
+ * Runtime heavy hitter detection for hash-hash distributed joins.
+ *
+ * The transmit op of the build side samples the head of its input, and every
+ * worker reports the hash values which take a large share of its sample.
+ * QC merges the reports and decides the skewed values of the whole DFO.
+ * The transmit op of the probe side is scheduled after the build side is drained,
+ * it reports an empty piece and gets the decision made for the build side,
+ * identified by build_op_id_, so that both sides always agree on the skewed values.
+ */
+struct ObSkewValueFreq
+{
+  OB_UNIS_VERSION(1);
+public:
+  ObSkewValueFreq() : hash_val_(0), cnt_(0) {}
+  ObSkewValueFreq(uint64_t hash_val, int64_t cnt) : hash_val_(hash_val), cnt_(cnt) {}
+  TO_STRING_KV(K_(hash_val), K_(cnt));
+  uint64_t hash_val_;
+  int64_t cnt_;
+};
+
+class ObSkewDetectPieceMsg
+  : public ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_SKEW_DETECT_PIECE_MSG>
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  using PieceMsgListener = ObSkewDetectPieceMsgListener;
+  using PieceMsgCtx = ObSkewDetectPieceMsgCtx;
+public:
+  ObSkewDetectPieceMsg()
+    : build_op_id_(common::OB_INVALID_ID), dop_(0), sample_row_cnt_(0), candidates_() {}
+  ~ObSkewDetectPieceMsg() = default;
+  void reset()
+  {
+    build_op_id_ = common::OB_INVALID_ID;
+    dop_ = 0;
+    sample_row_cnt_ = 0;
+    candidates_.reset();
+  }
+  bool is_probe_side() const { return common::OB_INVALID_ID != build_op_id_; }
+  INHERIT_TO_STRING_KV("meta", ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_SKEW_DETECT_PIECE_MSG>,
+                       K_(op_id), K_(build_op_id), K_(dop), K_(sample_row_cnt), K_(candidates));
+public:
+  // op id of the build side transmit, only set by the probe side
+  uint64_t build_op_id_;
+  // consumer count of the transmit op
+  int64_t dop_;
+  int64_t sample_row_cnt_;
+  common::ObSEArray<ObSkewValueFreq, 8> candidates_;
+};
+
+class ObSkewDetectWholeMsg
+    : public ObDatahubWholeMsg<dtl::ObDtlMsgType::DH_SKEW_DETECT_WHOLE_MSG>
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  using WholeMsgProvider = ObWholeMsgProvider<ObSkewDetectWholeMsg>;
+public:
+  ObSkewDetectWholeMsg() : popular_values_hash_() {}
+  ~ObSkewDetectWholeMsg() = default;
+  int assign(const ObSkewDetectWholeMsg &other);
+  void reset() { popular_values_hash_.reset(); }
+  VIRTUAL_TO_STRING_KV(K_(op_id), K_(popular_values_hash));
+  common::ObSEArray<uint64_t, 8> popular_values_hash_;
+};
+
+class ObSkewDetectPieceMsgCtx : public ObPieceMsgCtx
+{
+public:
+  // keep the broadcast side small, a handful of heavy hitters cover the practical cases
+  static const int64_t MAX_POPULAR_VALUE_COUNT = 16;
+  // a value is popular if its share makes one worker receive at least
+  // SKEW_FACTOR times the average rows, or if its frequency reaches _px_join_skew_minfreq
+  static const int64_t SKEW_FACTOR = 2;
+public:
+  ObSkewDetectPieceMsgCtx(uint64_t op_id, int64_t task_cnt, int64_t timeout_ts,
+                          int64_t tenant_id, int64_t min_freq, ObPieceMsgCtxMgr &ctx_mgr)
+    : ObPieceMsgCtx(op_id, task_cnt, timeout_ts), received_(0), tenant_id_(tenant_id),
+      min_freq_(min_freq), dop_(0), total_row_cnt_(0), detected_(false),
+      probe_fetched_(false), ctx_mgr_(ctx_mgr),
+      whole_msg_(), candidates_() {}
+  ~ObSkewDetectPieceMsgCtx() = default;
+  virtual void destroy()
+  {
+    candidates_.reset();
+  }
+  INHERIT_TO_STRING_KV("meta", ObPieceMsgCtx, K_(received), K_(min_freq), K_(dop),
+                       K_(total_row_cnt), K_(detected), K_(probe_fetched));
+  virtual int send_whole_msg(common::ObIArray<ObPxSqcMeta *> &sqcs) override;
+  virtual void reset_resource() override;
+  static int alloc_piece_msg_ctx(const ObSkewDetectPieceMsg &pkt,
+                                 ObPxCoordInfo &coord_info,
+                                 ObExecContext &ctx,
+                                 int64_t task_cnt,
+                                 ObPieceMsgCtx *&msg_ctx);
+  static bool is_popular(const int64_t cnt, const int64_t total, const int64_t dop,
+                         const int64_t min_freq)
+  {
+    return total > 0 && cnt > 0
+        && (cnt * 100 >= total * min_freq || cnt * dop >= total * SKEW_FACTOR);
+  }
+  // merge samples of the build side and decide the popular values
+  int detect_popular_values();
+  // fetch the popular values decided by the build side
+  int fetch_popular_values(const uint64_t build_op_id);
+public:
+  int64_t received_;
+  int64_t tenant_id_;
+  int64_t min_freq_;
+  int64_t dop_;
+  int64_t total_row_cnt_; // sampled rows of all workers
+  bool detected_; // whole_msg_ holds the final decision
+  // probe side fetched the decision before it was made and got no popular value
+  bool probe_fetched_;
+  ObPieceMsgCtxMgr &ctx_mgr_;
+  ObSkewDetectWholeMsg whole_msg_;
+  common::ObSEArray<ObSkewValueFreq, 16> candidates_; // candidates reported by all workers
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObSkewDetectPieceMsgCtx);
+};
+
+class ObSkewDetectPieceMsgListener
+{
+public:
+  ObSkewDetectPieceMsgListener() = default;
+  ~ObSkewDetectPieceMsgListener() = default;
+  static int on_message(
+      ObSkewDetectPieceMsgCtx &ctx,
+      common::ObIArray<ObPxSqcMeta *> &sqcs,
+      const ObSkewDetectPieceMsg &pkt);
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObSkewDetectPieceMsgListener);
+};
+
+}
+}
+#endif /* __OB_SQL_ENG_PX_DH_SKEW_DETECT_H__ */
+//// end of header file
@@ -29,7 +29,8 @@ namespace sql
 OB_SERIALIZE_MEMBER((ObPxDistTransmitOpInput, ObPxTransmitOpInput));
 
 OB_SERIALIZE_MEMBER((ObPxDistTransmitSpec, ObPxTransmitSpec), dist_exprs_,
-    dist_hash_funcs_, sort_cmp_funs_, sort_collations_, calc_tablet_id_expr_, popular_values_hash_);
+    dist_hash_funcs_, sort_cmp_funs_, sort_collations_, calc_tablet_id_expr_, popular_values_hash_,
+    skew_detect_role_, skew_detect_build_op_id_);
 
 int ObPxDistTransmitOp::inner_open()
 {
@@ -231,6 +232,10 @@ int ObPxDistTransmitOp::do_hash_dist()
     if (OB_FAIL(send_rows(wf_hybrid_slice_id_calc))) {
       LOG_WARN("row wf hybrid distribution failed", K(ret));
     }
+  } else if (SKEW_DETECT_NONE != MY_SPEC.skew_detect_role_) {
+    if (OB_FAIL(do_skew_aware_hash_dist())) {
+      LOG_WARN("skew aware hash distribution failed", K(ret));
+    }
   } else {
     ObHashSliceIdCalc slice_id_calc(
                     ctx_.get_allocator(), task_channels_.count(),
@@ -243,6 +248,226 @@ int ObPxDistTransmitOp::do_hash_dist()
   return ret;
 }
 
+// Hash distribution with runtime heavy hitter detection.
+//
+// The build side samples the head of its input and reports the local heavy hitters,
+// QC merges them and decides the popular values, then the build side sends the rows
+// of popular values randomly, so the hash table of these values is spread over all
+// workers. The probe side follows the decision of the build side and broadcasts the
+// rows of popular values to all workers. The other rows are still hash distributed.
+//
+// The direction is the mirror of the optimizer decided HYBRID_HASH_BROADCAST/RANDOM,
+// because only the build side can be sampled before any row is sent: the probe side
+// is scheduled after the build side is drained.
+int ObPxDistTransmitOp::do_skew_aware_hash_dist()
+{
+  int ret = OB_SUCCESS;
+  ObPxSqcHandler *handler = ctx_.get_sqc_handler();
+  const ObSkewDetectWholeMsg *whole_msg = NULL;
+  ObSkewDetectPieceMsg piece_msg;
+  if (OB_ISNULL(handler)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("skew detection only supported in parallel execution mode", K(ret));
+  } else if (OB_FAIL(build_skew_detect_piece_msg(piece_msg))) {
+    LOG_WARN("fail to build skew detect piece msg", K(ret));
+  } else if (OB_FAIL(handler->get_sqc_proxy().get_dh_msg_sync(MY_SPEC.id_,
+      dtl::DH_SKEW_DETECT_WHOLE_MSG,
+      piece_msg,
+      whole_msg,
+      ctx_.get_physical_plan_ctx()->get_timeout_timestamp()))) {
+    LOG_WARN("fail get skew detect msg", K(ret));
+  } else if (OB_ISNULL(whole_msg)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("whole msg is unexpected", K(ret));
+  } else if (OB_FAIL(skew_popular_values_hash_.assign(whole_msg->popular_values_hash_))) {
+    LOG_WARN("fail to assign popular values", K(ret));
+  } else {
+    LOG_TRACE("skew detect done", K(MY_SPEC.id_), K(MY_SPEC.skew_detect_role_),
+              K(skew_popular_values_hash_));
+  }
+  if (OB_FAIL(ret)) {
+  } else if (skew_popular_values_hash_.empty()) {
+    ObHashSliceIdCalc slice_id_calc(
+                    ctx_.get_allocator(), task_channels_.count(),
+                    MY_SPEC.null_row_dist_method_,
+                    &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_);
+    if (OB_FAIL(send_rows(slice_id_calc))) {
+      LOG_WARN("row distribution failed", K(ret));
+    }
+    set_skew_monitor_info(0, 0, 0);
+  } else if (SKEW_DETECT_BUILD == MY_SPEC.skew_detect_role_) {
+    ObHybridHashRandomSliceIdCalc slice_id_calc(
+        ctx_.get_allocator(), task_channels_.count(),
+        MY_SPEC.null_row_dist_method_,
+        &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_,
+        &skew_popular_values_hash_);
+    if (OB_FAIL(slice_id_calc.enable_slice_rows_stat())) {
+      LOG_WARN("fail to enable slice rows stat", K(ret));
+    } else if (OB_FAIL(send_rows(slice_id_calc))) {
+      LOG_WARN("row distribution failed", K(ret));
+    }
+    set_skew_monitor_info(skew_popular_values_hash_.count(),
+                          slice_id_calc.get_max_hash_slice_rows(),
+                          slice_id_calc.get_max_dist_slice_rows());
+  } else {
+    ObHybridHashBroadcastSliceIdCalc slice_id_calc(
+        ctx_.get_allocator(), task_channels_.count(),
+        MY_SPEC.null_row_dist_method_,
+        &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_,
+        &skew_popular_values_hash_);
+    if (OB_FAIL(slice_id_calc.enable_slice_rows_stat())) {
+      LOG_WARN("fail to enable slice rows stat", K(ret));
+    } else if (OB_FAIL(send_rows(slice_id_calc))) {
+      LOG_WARN("row distribution failed", K(ret));
+    }
+    set_skew_monitor_info(skew_popular_values_hash_.count(),
+                          slice_id_calc.get_max_hash_slice_rows(),
+                          slice_id_calc.get_max_dist_slice_rows());
+  }
+  return ret;
+}
+
+void ObPxDistTransmitOp::set_skew_monitor_info(const int64_t popular_value_cnt,
+                                               const int64_t max_hash_slice_rows,
+                                               const int64_t max_dist_slice_rows)
+{
+  op_monitor_info_.otherstat_4_id_ = ObSqlMonitorStatIds::EXCHANGE_SKEW_VALUE_COUNT;
+  op_monitor_info_.otherstat_4_value_ = popular_value_cnt;
+  op_monitor_info_.otherstat_5_id_ = ObSqlMonitorStatIds::EXCHANGE_SKEW_MAX_SLICE_ROWS_BEFORE;
+  op_monitor_info_.otherstat_5_value_ = max_hash_slice_rows;
+  op_monitor_info_.otherstat_6_id_ = ObSqlMonitorStatIds::EXCHANGE_SKEW_MAX_SLICE_ROWS_AFTER;
+  op_monitor_info_.otherstat_6_value_ = max_dist_slice_rows;
+}
+
+int ObPxDistTransmitOp::build_skew_detect_piece_msg(ObSkewDetectPieceMsg &piece_msg)
+{
+  int ret = OB_SUCCESS;
+  ObPxSQCProxy &proxy = ctx_.get_sqc_handler()->get_sqc_proxy();
+  piece_msg.reset();
+  piece_msg.op_id_ = MY_SPEC.id_;
+  piece_msg.thread_id_ = GETTID();
+  piece_msg.source_dfo_id_ = proxy.get_dfo_id();
+  piece_msg.target_dfo_id_ = proxy.get_dfo_id();
+  piece_msg.dop_ = task_channels_.count();
+  if (SKEW_DETECT_PROBE == MY_SPEC.skew_detect_role_) {
+    // probe side reports nothing, it only fetches the decision of the build side
+    piece_msg.build_op_id_ = MY_SPEC.skew_detect_build_op_id_;
+  } else if (OB_FAIL(sample_skew_detect_rows())) {
+    LOG_WARN("fail to sample rows", K(ret));
+  } else {
+    ObHashSliceIdCalc hash_calc(ctx_.get_allocator(), task_channels_.count(),
+                                MY_SPEC.null_row_dist_method_,
+                                &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_);
+    const int64_t input_rows = sampled_input_rows_.get_row_cnt();
+    ObSEArray<uint64_t, 16> hash_vals;
+    ObEvalCtx::BatchInfoScopeGuard g(eval_ctx_);
+    g.set_batch_size(1);
+    g.set_batch_idx(0);
+    for (int64_t i = 0; OB_SUCC(ret) && i < input_rows; ++i) {
+      clear_evaluated_flag();
+      uint64_t hash_val = 0;
+      const ObRADatumStore::StoredRow *sr = NULL;
+      OZ(sampled_input_rows_.get_row(i, sr));
+      OZ(sr->to_expr(MY_SPEC.sampling_saving_row_, eval_ctx_));
+      OZ(hash_calc.calc_hash_value(eval_ctx_, hash_val));
+      OZ(hash_vals.push_back(hash_val));
+    }
+    if (OB_SUCC(ret)) {
+      std::sort(hash_vals.begin(), hash_vals.end());
+      for (int64_t i = 0, j = 0; OB_SUCC(ret) && i < hash_vals.count(); i = j) {
+        j = i + 1;
+        while (j < hash_vals.count() && hash_vals.at(j) == hash_vals.at(i)) {
+          ++j;
+        }
+        // report the values which are popular enough locally, take twice the local count
+        // to tolerate the sampling error, QC decides on the merged counts.
+        if (ObSkewDetectPieceMsgCtx::is_popular(2 * (j - i), input_rows, piece_msg.dop_,
+                                                ctx_.get_my_session()->get_px_join_skew_minfreq())) {
+          OZ(piece_msg.candidates_.push_back(ObSkewValueFreq(hash_vals.at(i), j - i)));
+        }
+      }
+      piece_msg.sample_row_cnt_ = input_rows;
+    }
+  }
+  return ret;
+}
+
+int ObPxDistTransmitOp::sample_skew_detect_rows()
+{
+  int ret = OB_SUCCESS;
+  int64_t row_count = MY_SPEC.rows_;
+  if (iter_end_) {
+    // do nothing
+  } else if (OB_FAIL(ObPxEstimateSizeUtil::get_px_size(
+          &ctx_, MY_SPEC.px_est_size_factor_, row_count, row_count))) {
+    LOG_WARN("fail to get px size", K(ret));
+  } else if (OB_FAIL(init_sampled_input_rows(
+          std::min(row_count, (int64_t)SKEW_DETECT_SAMPLE_ROW_COUNT)))) {
+    LOG_WARN("fail to init sampled input rows", K(ret));
+  } else if (!is_vectorized()) {
+    int64_t mem_hold = 0;
+    do {
+      OZ(update_sampled_input_rows_mem_bound(mem_hold));
+      OZ(sampled_input_rows_.add_row(MY_SPEC.sampling_saving_row_, &eval_ctx_));
+      if (OB_SUCC(ret) && sampled_input_rows_.get_row_cnt() < SKEW_DETECT_SAMPLE_ROW_COUNT) {
+        ret = inner_get_next_row();
+      }
+    } while (OB_SUCC(ret) && sampled_input_rows_.get_row_cnt() < SKEW_DETECT_SAMPLE_ROW_COUNT);
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      // the current row is stored, backup for restoring the child output after replay
+      OZ(last_row_.shadow_copy(MY_SPEC.sampling_saving_row_, eval_ctx_));
+    }
+  } else {
+    int64_t mem_hold = 0;
+    do {
+      OZ(update_sampled_input_rows_mem_bound(mem_hold));
+      {
+        ObEvalCtx::BatchInfoScopeGuard g(eval_ctx_);
+        g.set_batch_size(brs_.size_);
+        for (int64_t i = 0; OB_SUCC(ret) && i < brs_.size_; i++) {
+          if (brs_.skip_->at(i)) {
+            continue;
+          }
+          g.set_batch_idx(i);
+          OZ(sampled_input_rows_.add_row(MY_SPEC.sampling_saving_row_, &eval_ctx_));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        int64_t cnt = std::min(SKEW_DETECT_SAMPLE_ROW_COUNT - sampled_input_rows_.get_row_cnt(),
+                               MY_SPEC.max_batch_size_);
+        if (cnt > 0) {
+          ret = inner_get_next_batch(cnt);
+        }
+      }
+    } while (OB_SUCC(ret)
+             && sampled_input_rows_.get_row_cnt() < SKEW_DETECT_SAMPLE_ROW_COUNT
+             && !(brs_.end_ && brs_.size_ == 0));
+    if (OB_FAIL(ret)) {
+    } else if (!brs_.end_) {
+      OZ(brs_holder_.save(MY_SPEC.max_batch_size_));
+    } else {
+      brs_.end_ = false;
+    }
+  }
+  if (OB_SUCC(ret) && !iter_end_) {
+    // replay the sampled rows in input order before fetching the rest of the child rows
+    const int64_t rows = sampled_input_rows_.get_row_cnt();
+    sampled_rows2transmit_.reuse();
+    if (rows > 0 && OB_FAIL(sampled_rows2transmit_.push_back(std::make_pair(0L, rows)))) {
+      LOG_WARN("fail to push back", K(ret));
+    } else if (!sampled_rows2transmit_.empty()) {
+      if (MY_SPEC.is_vectorized()) {
+        sampled_input_rows_.set_iteration_age(&sampled_input_rows_it_age_);
+      }
+      cur_transmit_sampled_rows_ = &sampled_rows2transmit_.at(0);
+    }
+    sample_done_ = true;
+  }
+  return ret;
+}
+
 int ObPxDistTransmitOp::do_bc2host_dist()
 {
   int ret = OB_SUCCESS;
@@ -528,7 +753,19 @@ int ObPxDistTransmitOp::build_row_sample_piece_msg(int64_t expected_range_count,
   int64_t row_count = MY_SPEC.rows_;
   OZ(ObPxEstimateSizeUtil::get_px_size(
           &ctx_, MY_SPEC.px_est_size_factor_, row_count, row_count));
+  OZ(init_sampled_input_rows(row_count));
+  if (is_vectorized()) {
+    OZ(add_batch_row_for_piece_msg(*sample_store));
+  } else {
+    OZ(add_row_for_piece_msg(*sample_store));
+  }
+  return ret;
+}
 
+int ObPxDistTransmitOp::init_sampled_input_rows(const int64_t row_count)
+{
+  int ret = OB_SUCCESS;
+  int64_t tenant_id = ctx_.get_my_session()->get_effective_tenant_id();
   lib::ContextParam param;
   param.set_mem_attr(tenant_id, "PxSampleRow", ObCtxIds::WORK_AREA);
   OZ(CURRENT_CONTEXT->CREATE_CONTEXT(mem_context_, param));
@@ -544,10 +781,42 @@ int ObPxDistTransmitOp::build_row_sample_piece_msg(int64_t expected_range_count,
           sql_mem_processor_.get_mem_bound(), tenant_id,
           ObCtxIds::WORK_AREA, "PxSampleRow"));
   sampled_input_rows_.set_io_observer(&io_event_observer_);
-  if (is_vectorized()) {
-    OZ(add_batch_row_for_piece_msg(*sample_store));
+  return ret;
+}
+
+int ObPxDistTransmitOp::update_sampled_input_rows_mem_bound(int64_t &mem_hold)
+{
+  int ret = OB_SUCCESS;
+  // For auto memory manage, ObRADatumStore can not shrink memory used right now,
+  // no need to update memory statistics after dumped
+  if (!sampled_input_rows_.is_file_open()) {
+    bool updated = false;
+    OZ(sql_mem_processor_.update_max_available_mem_size_periodically(
+            &mem_context_->get_malloc_allocator(),
+            [&](int64_t loop_cnt) { return sampled_input_rows_.get_row_cnt() > loop_cnt; },
+            updated));
+    if (OB_SUCC(ret) && updated) {
+      sampled_input_rows_.set_mem_limit(sql_mem_processor_.get_mem_bound());
+    }
+    if (sampled_input_rows_.get_mem_hold() != mem_hold) {
+      mem_hold = sampled_input_rows_.get_mem_hold();
+      // try extend memory bound when used memory close to memory bound.
+      if (GCONF.is_sql_operator_dump_enabled()
+          && mem_hold >= sql_mem_processor_.get_mem_bound() - ObRADatumStore::BIG_BLOCK_SIZE) {
+        bool dumped = false;
+        OZ(sql_mem_processor_.extend_max_memory_size(
+            &mem_context_->get_malloc_allocator(),
+            [&](int64_t mem_bould) { return mem_hold > mem_bould; },
+            dumped, mem_hold));
+        if (OB_SUCC(ret)) {
+          sampled_input_rows_.set_mem_limit(sql_mem_processor_.get_mem_bound());
+        }
+      }
+    }
   } else {
-    OZ(add_row_for_piece_msg(*sample_store));
+    if (profile_.get_number_pass() == 0) {
+      profile_.set_number_pass(1);
+    }
   }
   return ret;
 }
@@ -591,6 +860,24 @@ int ObPxDistTransmitSpec::register_to_datahub(ObExecContext &ctx) const
       }
     }
   }
+  if (OB_SUCC(ret) && SKEW_DETECT_NONE != skew_detect_role_) {
+    void *buf = NULL;
+    if (OB_ISNULL(ctx.get_sqc_handler())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null unexpected", K(ret));
+    } else if (OB_ISNULL(buf = ctx.get_allocator().alloc(
+        sizeof(ObSkewDetectWholeMsg::WholeMsgProvider)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc provider", K(ret));
+    } else {
+      ObSkewDetectWholeMsg::WholeMsgProvider *provider =
+        new (buf)ObSkewDetectWholeMsg::WholeMsgProvider();
+      ObSqcCtx &sqc_ctx = ctx.get_sqc_handler()->get_sqc_ctx();
+      if (OB_FAIL(sqc_ctx.add_whole_msg_provider(id_, dtl::DH_SKEW_DETECT_WHOLE_MSG, *provider))) {
+        LOG_WARN("fail add whole msg provider", K(ret));
+      }
+    }
+  }
   return ret;
 }
 
@@ -605,37 +892,7 @@ int ObPxDistTransmitOp::add_row_for_piece_msg(ObChunkDatumStore &sample_store)
         : INT64_MAX;
     int64_t mem_hold = 0;
     do {
-      // For auto memory manage, ObRADatumStore can not shrink memory used right now,
-      // no need to update memory statistics after dumped
-      if (!sampled_input_rows_.is_file_open()) {
-        bool updated = false;
-        OZ(sql_mem_processor_.update_max_available_mem_size_periodically(
-                &mem_context_->get_malloc_allocator(),
-                [&](int64_t loop_cnt) { return sampled_input_rows_.get_row_cnt() > loop_cnt; },
-                updated));
-        if (OB_SUCC(ret) && updated) {
-          sampled_input_rows_.set_mem_limit(sql_mem_processor_.get_mem_bound());
-        }
-        if (sampled_input_rows_.get_mem_hold() != mem_hold) {
-          mem_hold = sampled_input_rows_.get_mem_hold();
-          // try extend memory bound when used memory close to memory bound.
-          if (GCONF.is_sql_operator_dump_enabled()
-              && mem_hold >= sql_mem_processor_.get_mem_bound() - ObRADatumStore::BIG_BLOCK_SIZE) {
-            bool dumped = false;
-            OZ(sql_mem_processor_.extend_max_memory_size(
-                &mem_context_->get_malloc_allocator(),
-                [&](int64_t mem_bould) { return mem_hold > mem_bould; },
-                dumped, mem_hold));
-            if (OB_SUCC(ret)) {
-              sampled_input_rows_.set_mem_limit(sql_mem_processor_.get_mem_bound());
-            }
-          }
-        }
-      } else {
-        if (profile_.get_number_pass() == 0) {
-          profile_.set_number_pass(1);
-        }
-      }
+      OZ(update_sampled_input_rows_mem_bound(mem_hold));
 
       // add row to sampled input row store.
       OZ(sampled_input_rows_.add_row(MY_SPEC.sampling_saving_row_, &eval_ctx_));
@@ -682,37 +939,7 @@ int ObPxDistTransmitOp::add_batch_row_for_piece_msg(ObChunkDatumStore &sample_st
         : INT64_MAX;
     int64_t mem_hold = 0;
     do {
-      // For auto memory manage, ObRADatumStore can not shrink memory used right now,
-      // no need to update memory statistics after dumped
-      if (!sampled_input_rows_.is_file_open()) {
-        bool updated = false;
-        OZ(sql_mem_processor_.update_max_available_mem_size_periodically(
-                &mem_context_->get_malloc_allocator(),
-                [&](int64_t loop_cnt) { return sampled_input_rows_.get_row_cnt() > loop_cnt; },
-                updated));
-        if (OB_SUCC(ret) && updated) {
-          sampled_input_rows_.set_mem_limit(sql_mem_processor_.get_mem_bound());
-        }
-        if (sampled_input_rows_.get_mem_hold() != mem_hold) {
-          mem_hold = sampled_input_rows_.get_mem_hold();
-          // try extend memory bound when used memory close to memory bound.
-          if (GCONF.is_sql_operator_dump_enabled()
-              && mem_hold >= sql_mem_processor_.get_mem_bound() - ObRADatumStore::BIG_BLOCK_SIZE) {
-            bool dumped = false;
-            OZ(sql_mem_processor_.extend_max_memory_size(
-                &mem_context_->get_malloc_allocator(),
-                [&](int64_t mem_bould) { return mem_hold > mem_bould; },
-                dumped, mem_hold));
-            if (OB_SUCC(ret)) {
-              sampled_input_rows_.set_mem_limit(sql_mem_processor_.get_mem_bound());
-            }
-          }
-        }
-      } else {
-        if (profile_.get_number_pass() == 0) {
-          profile_.set_number_pass(1);
-        }
-      }
+      OZ(update_sampled_input_rows_mem_bound(mem_hold));
 
       // add batch rows to sampled input row store.
       {
@@ -16,6 +16,7 @@
 #include "ob_px_transmit_op.h"
 #include "sql/engine/sort/ob_sort_basic_info.h"
 #include "sql/engine/ob_tenant_sql_memory_manager.h"
+#include "sql/engine/px/datahub/components/ob_dh_skew_detect.h"
 
 namespace oceanbase
 {
@@ -44,7 +45,9 @@ public:
     sort_cmp_funs_(alloc),
     sort_collations_(alloc),
     popular_values_hash_(alloc),
-    calc_tablet_id_expr_(NULL)
+    calc_tablet_id_expr_(NULL),
+    skew_detect_role_(SKEW_DETECT_NONE),
+    skew_detect_build_op_id_(common::OB_INVALID_ID)
   {}
   ~ObPxDistTransmitSpec() {}
   virtual int register_to_datahub(ObExecContext &ctx) const override;
@@ -54,11 +57,15 @@ public:
   ObSortCollations sort_collations_;
   common::ObFixedArray<uint64_t, ObIAllocator> popular_values_hash_; // for hybrid hash distribution
   ObExpr *calc_tablet_id_expr_;   // for slave mapping
+  ObPxSkewDetectRole skew_detect_role_; // for runtime skew detection of hash distribution
+  uint64_t skew_detect_build_op_id_; // build side transmit op id, set for SKEW_DETECT_PROBE
 };
 
 class ObPxDistTransmitOp : public ObPxTransmitOp
 {
 public:
+  // sample the first SKEW_DETECT_SAMPLE_ROW_COUNT input rows for runtime skew detection
+  const static int64_t SKEW_DETECT_SAMPLE_ROW_COUNT = 1024;
   ObPxDistTransmitOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput *input)
   : ObPxTransmitOp(exec_ctx, spec, input),
     mem_context_(NULL),
@@ -87,6 +94,14 @@ private:
   int do_range_dist();
   int do_hybrid_hash_broadcast_dist();
   int do_hybrid_hash_random_dist();
+  int do_skew_aware_hash_dist();
+  int build_skew_detect_piece_msg(ObSkewDetectPieceMsg &piece_msg);
+  int sample_skew_detect_rows();
+  int init_sampled_input_rows(const int64_t row_count);
+  int update_sampled_input_rows_mem_bound(int64_t &mem_hold);
+  void set_skew_monitor_info(const int64_t popular_value_cnt,
+                             const int64_t max_hash_slice_rows,
+                             const int64_t max_dist_slice_rows);
 protected:
 
   // We need to send the stored input rows in random order in FULL_INPUT_SAMPLE mode,
@@ -107,6 +122,9 @@ private:
   ObBatchResultHolder brs_holder_;
 
 
+  // popular values detected at runtime, see do_skew_aware_hash_dist()
+  common::ObSEArray<uint64_t, 8> skew_popular_values_hash_;
+
   // for auto memory manager of %sampled_input_rows_
   lib::MemoryContext mem_context_;
   ObSqlWorkAreaProfile profile_;
@@ -110,6 +110,7 @@ private:
   ObInitChannelPieceMsgP init_channel_piece_msg_proc_;
   ObReportingWFPieceMsgP reporting_wf_piece_msg_proc_;
   ObOptStatsGatherPieceMsgP opt_stats_gather_piece_msg_proc_;
+  ObSkewDetectPieceMsgP skew_detect_piece_msg_proc_;
 };
 
 } // end namespace sql
@@ -128,6 +128,52 @@ int ObGITaskSet::assign(const ObGITaskSet &other)
     LOG_WARN("failed to assign gi_task_set", K(ret));
   } else {
     cur_pos_ = other.cur_pos_;
+    // room for split tasks is not copied, prepare_split_task again if needed
+    split_limit_ = 0;
+    next_split_idx_ = other.next_split_idx_;
+  }
+  return ret;
+}
+
+int ObGITaskSet::prepare_split_task(int64_t max_split_cnt)
+{
+  int ret = OB_SUCCESS;
+  next_split_idx_ = 0;
+  for (int64_t i = 0; i < gi_task_set_.count(); i++) {
+    next_split_idx_ = std::max(next_split_idx_, gi_task_set_.at(i).idx_ + 1);
+  }
+  if (max_split_cnt <= 0) {
+    split_limit_ = 0;
+  } else if (OB_FAIL(gi_task_set_.reserve(gi_task_set_.count() + max_split_cnt))) {
+    LOG_WARN("failed to reserve task set", K(ret), K(max_split_cnt));
+  } else {
+    split_limit_ = gi_task_set_.get_capacity();
+  }
+  return ret;
+}
+
+int ObGITaskSet::split_task(const int64_t pos, const ObIArray<ObNewRange> &ranges)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(pos < 0 || pos >= cur_pos_ || ranges.count() < 2
+                  || gi_task_set_.count() + ranges.count() - 1 > split_limit_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected split task", K(ret), K(pos), K(cur_pos_), K(gi_task_set_.count()),
+             K(ranges.count()), K(split_limit_));
+  } else {
+    // The new tasks get fresh idx, workers iterating the ranges of a fetched task
+    // never take them as part of their task.
+    for (int64_t i = 1; OB_SUCC(ret) && i < ranges.count(); i++) {
+      ObGITaskInfo task_info = gi_task_set_.at(pos);
+      task_info.range_ = ranges.at(i);
+      task_info.idx_ = next_split_idx_++;
+      if (OB_FAIL(gi_task_set_.push_back(task_info))) {
+        LOG_WARN("failed to push back split task", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      gi_task_set_.at(pos).range_ = ranges.at(0);
+    }
   }
   return ret;
 }
@@ -365,6 +411,8 @@ int ObGranulePump::fetch_granule_from_shared_pool(const ObGITaskSet *&res_task_s
                                                   uint64_t tsc_op_id)
 {
   int ret = OB_SUCCESS;
+  ObGITaskSet *split_taskset = nullptr;
+  int64_t split_cnt = 0;
   if (no_more_task_from_shared_pool_) {
     // when worker threads count >> shared task count, it performs better
     ret = OB_ITER_END;
@@ -393,11 +441,23 @@ int ObGranulePump::fetch_granule_from_shared_pool(const ObGITaskSet *&res_task_s
         } else {
           no_more_task_from_shared_pool_ = true;
         }
+      } else if (taskset.can_split_task()
+                 && OB_FAIL(get_split_granule_cnt(taskset, pos, tsc_op_id, split_cnt))) {
+        LOG_WARN("fail to get split granule count", K(ret));
       } else {
+        if (split_cnt > 1) {
+          // the fetched task is owned by this worker now, split it out of lock
+          taskset.reserve_split_room(split_cnt - 1);
+          split_taskset = &taskset;
+        }
         LOG_TRACE("get GI task", K(taskset), K(ret));
       }
     }
   }
+  if (OB_SUCC(ret) && nullptr != split_taskset
+      && OB_FAIL(try_split_granule(*split_taskset, pos, tsc_op_id, split_cnt))) {
+    LOG_WARN("fail to split granule", K(ret));
+  }
   return ret;
 }
 
@@ -624,6 +684,153 @@ int ObGranulePump::add_new_gi_task(ObGranulePumpArgs &args)
                                        random_type,
                                        partition_granule))) {
       LOG_WARN("failed to prepare random gi task", K(ret), K(partition_granule));
+    } else if (ObGITaskSet::GI_RANDOM_NONE == random_type
+               && OB_FAIL(prepare_split_granule(args, partition_granule))) {
+      LOG_WARN("failed to prepare split granule", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObGranulePump::prepare_split_granule(ObGranulePumpArgs &args, bool partition_granule)
+{
+  int ret = OB_SUCCESS;
+  ObIArray<const ObTableScanSpec *> &scan_ops = args.op_info_.get_scan_ops();
+  // Split tasks are appended to the tail of the shared pool, which breaks the
+  // order of the tasks, and partition granule must not be split.
+  const bool can_split = !partition_granule
+                         && !ObGranuleUtil::asc_order(args.gi_attri_flag_)
+                         && !ObGranuleUtil::desc_order(args.gi_attri_flag_)
+                         && !ObGranuleUtil::partition_filter(args.gi_attri_flag_)
+                         && args.parallelism_ > 1;
+  for (int64_t i = 0; OB_SUCC(ret) && can_split && i < scan_ops.count(); ++i) {
+    const ObTableScanSpec *tsc = scan_ops.at(i);
+    ObGITaskArray *taskset_array = nullptr;
+    if (OB_ISNULL(tsc)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("get a null tsc ptr", K(ret));
+    } else if (is_virtual_table(tsc->get_scan_key_id())
+               || tsc->tsc_ctdef_.scan_ctdef_.is_external_table_) {
+      // only tables stored in macro blocks can be split
+    } else if (OB_FAIL(find_taskset_by_tsc_id(tsc->get_id(), taskset_array))) {
+      LOG_WARN("the tsc_op_id do not have task set", K(ret), K(tsc->get_id()));
+    } else if (OB_ISNULL(taskset_array)
+               || taskset_array->count() < OB_GRANULE_SHARED_POOL_POS + 1) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("taskset array is invalid", K(ret), KP(taskset_array));
+    } else if (OB_FAIL(taskset_array->at(OB_GRANULE_SHARED_POOL_POS).prepare_split_task(
+                args.parallelism_ * MAX_SPLIT_GRANULE_CNT_PER_WORKER))) {
+      LOG_WARN("failed to prepare split task", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObGranulePump::find_pump_args_by_tsc_id(uint64_t tsc_op_id,
+                                           const ObGranulePumpArgs *&args,
+                                           const ObTableScanSpec *&tsc)
+{
+  int ret = OB_SUCCESS;
+  args = nullptr;
+  tsc = nullptr;
+  for (int64_t i = 0; nullptr == tsc && i < pump_args_.count(); ++i) {
+    ObIArray<const ObTableScanSpec *> &scan_ops = pump_args_.at(i).op_info_.get_scan_ops();
+    for (int64_t j = 0; nullptr == tsc && j < scan_ops.count(); ++j) {
+      if (OB_NOT_NULL(scan_ops.at(j)) && tsc_op_id == scan_ops.at(j)->get_id()) {
+        args = &pump_args_.at(i);
+        tsc = scan_ops.at(j);
+      }
+    }
+  }
+  if (OB_ISNULL(tsc)) {
+    ret = OB_ENTRY_NOT_EXIST;
+    LOG_WARN("the tsc_op_id do not have pump args", K(ret), K(tsc_op_id));
+  }
+  return ret;
+}
+
+int ObGranulePump::get_split_granule_cnt(const ObGITaskSet &taskset,
+                                         int64_t pos,
+                                         uint64_t tsc_op_id,
+                                         int64_t &split_cnt)
+{
+  int ret = OB_SUCCESS;
+  const ObGranulePumpArgs *args = nullptr;
+  const ObTableScanSpec *tsc = nullptr;
+  split_cnt = 0;
+  if (OB_UNLIKELY(pos < 0 || pos >= taskset.cur_pos_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(pos), K(taskset.cur_pos_));
+  } else if (OB_FAIL(find_pump_args_by_tsc_id(tsc_op_id, args, tsc))) {
+    LOG_WARN("failed to find pump args", K(ret), K(tsc_op_id));
+  } else {
+    const ObGITaskSet::ObGITaskInfo &task = taskset.gi_task_set_.at(pos);
+    // tasks left for the other workers after this one is fetched
+    const int64_t remain_cnt = taskset.gi_task_set_.count() - taskset.cur_pos_;
+    const bool multi_range_task = taskset.cur_pos_ - pos > 1;
+    if (multi_range_task || OB_ISNULL(task.tablet_loc_)) {
+      // only split tasks with one range
+    } else {
+      // one task for the asking worker and one for each worker which may be idle soon
+      split_cnt = std::min(args->parallelism_ - remain_cnt, taskset.get_split_room() + 1);
+    }
+  }
+  return ret;
+}
+
+int ObGranulePump::try_split_granule(ObGITaskSet &taskset,
+                                     int64_t pos,
+                                     uint64_t tsc_op_id,
+                                     int64_t split_cnt)
+{
+  int ret = OB_SUCCESS;
+  const ObGranulePumpArgs *args = nullptr;
+  const ObTableScanSpec *tsc = nullptr;
+  // The task at pos has been fetched by this worker, nobody else touches it.
+  // Walking the storage to split it may be slow, so it is done out of lock_ with
+  // a local allocator, only the split ranges are copied into the task set under lock_.
+  const ObGITaskSet::ObGITaskInfo &task = taskset.gi_task_set_.at(pos);
+  ObArenaAllocator tmp_allocator(ObModIds::OB_SQL_PX);
+  ObSEArray<ObNewRange, 16> split_ranges;
+  if (OB_FAIL(find_pump_args_by_tsc_id(tsc_op_id, args, tsc))) {
+    LOG_WARN("failed to find pump args", K(ret), K(tsc_op_id));
+  } else if (OB_FAIL(ObGranuleUtil::split_range_by_macro_block(tmp_allocator,
+                                                              tsc,
+                                                              *task.tablet_loc_,
+                                                              task.range_,
+                                                              split_cnt,
+                                                              split_ranges))) {
+    // splitting is only an optimization, scan the task as a whole
+    LOG_WARN("failed to split range, ignore", K(ret), K(task));
+    ret = OB_SUCCESS;
+    split_ranges.reuse();
+  }
+  ObLockGuard<ObSpinLock> lock_guard(lock_);
+  taskset.release_split_room(split_cnt - 1);
+  if (OB_FAIL(ret) || split_ranges.count() < 2) {
+    // too few data to split
+  } else if (split_ranges.count() > split_cnt) {
+    // more ranges than the room reserved, scan the task as a whole
+    LOG_TRACE("too many split ranges, ignore", K(split_cnt), K(split_ranges.count()));
+  } else {
+    ObSEArray<ObNewRange, 16> copied_ranges;
+    for (int64_t i = 0; OB_SUCC(ret) && i < split_ranges.count(); ++i) {
+      ObNewRange range;
+      if (OB_FAIL(deep_copy_range(split_allocator_, split_ranges.at(i), range))) {
+        LOG_WARN("failed to deep copy range", K(ret));
+      } else if (OB_FAIL(copied_ranges.push_back(range))) {
+        LOG_WARN("failed to push back range", K(ret));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(taskset.split_task(pos, copied_ranges))) {
+      LOG_WARN("failed to split task", K(ret));
+    } else {
+      // other workers may have seen the pool drained while splitting
+      no_more_task_from_shared_pool_ = false;
+      split_granule_cnt_ += copied_ranges.count() - 1;
+      LOG_TRACE("split granule on demand", K(tsc_op_id), K(pos), K(args->parallelism_),
+                K(copied_ranges), K_(split_granule_cnt));
     }
   }
   return ret;
@@ -670,6 +877,7 @@ void ObGranulePump::destroy()
 {
   gi_task_array_map_.reset();
   pump_args_.reset();
+  split_allocator_.reset();
 }
 
 void ObGranulePump::reset_task_array()
@@ -701,7 +909,8 @@ int64_t ObGranulePump::to_string(char *buf, const int64_t buf_len) const
   J_OBJ_START();
   J_KV(K_(parallelism),
        K_(tablet_size),
-       K_(partition_wise_join));
+       K_(partition_wise_join),
+       K_(split_granule_cnt));
   J_OBJ_END();
   return pos;
 }
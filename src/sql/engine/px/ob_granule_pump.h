@@ -137,8 +137,10 @@ public:
     GI_RANDOM_RANGE,    // a task have only one query range, it can get the best randomness, but it speed more in rescan
   };
 
-  ObGITaskSet() : gi_task_set_(), cur_pos_(0) {}
-  TO_STRING_KV(K(gi_task_set_), K(cur_pos_));
+  ObGITaskSet() : gi_task_set_(), cur_pos_(0), split_limit_(0), split_reserved_cnt_(0),
+                  next_split_idx_(0) {}
+  TO_STRING_KV(K(gi_task_set_), K(cur_pos_), K(split_limit_), K(split_reserved_cnt_),
+               K(next_split_idx_));
   int get_task_at_pos(ObGranuleTaskInfo &info, const int64_t &pos) const;
   int get_next_gi_task_pos(int64_t &pos);
   int get_next_gi_task(ObGranuleTaskInfo &info);
@@ -150,9 +152,26 @@ public:
                         common::ObIArray<ObNewRange> &ss_ranges,
                         common::ObIArray<int64_t> &taskset_idxs,
                         ObGIRandomType random_type);
+  // Reserve room for the tasks split on demand. Workers read the tasks without lock,
+  // so the task array must never be reallocated after tasks are fetched.
+  int prepare_split_task(int64_t max_split_cnt);
+  bool can_split_task() const
+  { return gi_task_set_.count() + split_reserved_cnt_ < split_limit_; }
+  // Room for the tasks split on demand is reserved before the split is done out of lock,
+  // so that concurrent splits never exceed split_limit_.
+  int64_t get_split_room() const
+  { return split_limit_ - gi_task_set_.count() - split_reserved_cnt_; }
+  void reserve_split_room(int64_t cnt) { split_reserved_cnt_ += cnt; }
+  void release_split_room(int64_t cnt) { split_reserved_cnt_ -= cnt; }
+  // split the fetched task at pos into the ranges, the first range replaces the task
+  // and the others are appended as new tasks.
+  int split_task(const int64_t pos, const common::ObIArray<common::ObNewRange> &ranges);
 public:
   common::ObArray<ObGITaskInfo> gi_task_set_;
   int64_t cur_pos_;
+  int64_t split_limit_; // max count of gi_task_set_ with tasks split on demand
+  int64_t split_reserved_cnt_; // room reserved by the splits in progress
+  int64_t next_split_idx_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObGITaskSet);
 };
@@ -326,6 +345,8 @@ class ObGranulePump
 {
 private:
   static const int64_t OB_GRANULE_SHARED_POOL_POS = 0;
+  // room for the tasks split on demand, per worker
+  static const int64_t MAX_SPLIT_GRANULE_CNT_PER_WORKER = 4;
 
   //
   // 《PX的GI详细实现》
@@ -477,7 +498,9 @@ public:
   need_partition_pruning_(false),
   pruning_table_locations_(),
   pump_version_(0),
-  is_taskset_reset_(false)
+  is_taskset_reset_(false),
+  split_allocator_(common::ObModIds::OB_SQL_PX),
+  split_granule_cnt_(0)
   {
   }
 
@@ -571,6 +594,16 @@ private:
 
   int check_can_randomize(ObGranulePumpArgs &args, bool &can_randomize);
 
+  int prepare_split_granule(ObGranulePumpArgs &args, bool partition_granule);
+  int find_pump_args_by_tsc_id(uint64_t tsc_op_id,
+                               const ObGranulePumpArgs *&args,
+                               const ObTableScanSpec *&tsc);
+  int get_split_granule_cnt(const ObGITaskSet &taskset,
+                            int64_t pos,
+                            uint64_t tsc_op_id,
+                            int64_t &split_cnt);
+  int try_split_granule(ObGITaskSet &taskset, int64_t pos, uint64_t tsc_op_id, int64_t split_cnt);
+
 private:
   //TODO::muhang 自旋锁还是阻塞锁，又或者按静态划分任务避免锁竞争？
   common::ObSpinLock lock_;
@@ -589,6 +622,13 @@ private:
   int64_t pump_version_;
 
   bool is_taskset_reset_;
+
+  // Large granules of the shared pool are split by macro block boundaries when
+  // the pool is about to be drained, so that idle workers can take over part of
+  // the remaining data. The split itself walks the storage out of lock_, the
+  // split ranges are copied into split_allocator_ under lock_.
+  common::ObArenaAllocator split_allocator_;
+  int64_t split_granule_cnt_;
 };
 
 }//sql
@@ -542,6 +542,73 @@ int ObGranuleUtil::get_tasks_for_partition(ObIAllocator &allocator,
   return ret;
 }
 
+int ObGranuleUtil::split_range_by_macro_block(ObIAllocator &allocator,
+                                              const ObTableScanSpec *tsc,
+                                              const ObDASTabletLoc &tablet,
+                                              const ObNewRange &range,
+                                              int64_t expected_cnt,
+                                              ObIArray<ObNewRange> &split_ranges)
+{
+  int ret = OB_SUCCESS;
+  ObAccessService *access_service = MTL(ObAccessService *);
+  ObSEArray<ObNewRange, 1> input_ranges;
+  ObSEArray<ObStoreRange, 1> input_store_ranges;
+  ObArrayArray<ObStoreRange> multi_range_split_array;
+  bool need_convert_new_range = false;
+  int64_t range_size = 0;
+  // the same lower bound of task size as split_block_granule
+  const int64_t min_task_access_size = NON_ZERO_VALUE(GCONF.px_task_size >> 20) << 20;
+  split_ranges.reuse();
+  if (OB_ISNULL(access_service) || expected_cnt < 2) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(access_service), K(expected_cnt));
+  } else if (OB_FAIL(input_ranges.push_back(range))) {
+    LOG_WARN("failed to push back range", K(ret));
+  } else if (OB_FAIL(convert_new_range_to_store_range(allocator,
+                                                      tsc,
+                                                      tablet.tablet_id_,
+                                                      input_ranges,
+                                                      input_store_ranges,
+                                                      need_convert_new_range))) {
+    LOG_WARN("failed to convert new range to store range", K(ret));
+  } else if (OB_FAIL(access_service->get_multi_ranges_cost(tablet.ls_id_,
+                                                           tablet.tablet_id_,
+                                                           input_store_ranges,
+                                                           range_size))) {
+    LOG_WARN("failed to get multi ranges cost", K(ret), K(tablet));
+  } else if (FALSE_IT(expected_cnt = min(expected_cnt, range_size / min_task_access_size))) {
+  } else if (expected_cnt < 2) {
+    // too few data, keep the granule as a whole
+  } else if (OB_FAIL(access_service->split_multi_ranges(tablet.ls_id_,
+                                                        tablet.tablet_id_,
+                                                        input_store_ranges,
+                                                        expected_cnt,
+                                                        allocator,
+                                                        multi_range_split_array))) {
+    LOG_WARN("failed to split multi ranges", K(ret), K(tablet), K(expected_cnt));
+  } else if (multi_range_split_array.count() > 1) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < multi_range_split_array.count(); i++) {
+      ObIArray<ObStoreRange> &storage_task_ranges = multi_range_split_array.at(i);
+      ObNewRange new_range;
+      if (1 != storage_task_ranges.count()) {
+        // one input range is expected to be split into one range per task,
+        // keep the granule as a whole otherwise.
+        split_ranges.reuse();
+        break;
+      } else if (FALSE_IT(storage_task_ranges.at(0).to_new_range(new_range))) {
+      } else if (OB_INVALID_INDEX == new_range.table_id_) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("invalid table id", K(ret), K(new_range));
+      } else if (OB_FAIL(split_ranges.push_back(new_range))) {
+        LOG_WARN("failed to push back split range", K(ret));
+      }
+    }
+  }
+  LOG_TRACE("split range by macro block", K(ret), K(tablet), K(range), K(range_size),
+            K(expected_cnt), K(split_ranges));
+  return ret;
+}
+
 int ObGranuleUtil::convert_new_range_to_store_range(ObIAllocator &allocator,
                                                     const ObTableScanSpec *tsc,
                                                     const ObTabletID &tablet_id,
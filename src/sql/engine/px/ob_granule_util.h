@@ -292,6 +292,23 @@ public:
                                 int64_t total_size,
                                 int64_t &total_task_count);
 
+  /**
+   * split one pending granule on demand by macro block boundaries
+   * tsc                        IN  the table scan of the granule, may be null
+   * tablet                     IN  the tablet of the granule
+   * range                      IN  the range of the granule
+   * expected_cnt               IN  the expected count of ranges after splitting
+   *
+   * split_ranges               OUT the ranges after splitting, empty if the granule
+   *                                covers too few data to split
+   */
+  static int split_range_by_macro_block(common::ObIAllocator &allocator,
+                                        const ObTableScanSpec *tsc,
+                                        const ObDASTabletLoc &tablet,
+                                        const common::ObNewRange &range,
+                                        int64_t expected_cnt,
+                                        common::ObIArray<common::ObNewRange> &split_ranges);
+
 private:
   /**
    * calc task count for each partition by the weight of partition data in the total data
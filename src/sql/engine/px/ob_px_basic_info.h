@@ -118,6 +118,13 @@ enum ObPxSampleType
   FULL_INPUT_SAMPLE, // sample the full input rows
   OBJECT_SAMPLE
 };
+// runtime skew detection of hash distributed join, see ObSkewDetectPieceMsg
+enum ObPxSkewDetectRole
+{
+  SKEW_DETECT_NONE,
+  SKEW_DETECT_BUILD, // samples the input and decides the popular values
+  SKEW_DETECT_PROBE, // follows the popular values decided by the build side
+};
 
 
 
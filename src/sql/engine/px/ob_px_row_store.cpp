@@ -190,7 +190,9 @@ int ObReceiveRowReader::add_buffer(dtl::ObDtlLinkedBuffer &buf, bool &transferre
     if (dtl::PX_DATUM_ROW == buf.msg_type()) {
       auto block = reinterpret_cast<ObChunkDatumStore::Block *>(buf.buf());
       rows = block->rows_;
-      if (rows > 0 && OB_FAIL(block->swizzling(NULL))) {
+      if (buf.is_swizzled()) {
+        // handed over by local channel, rows are ready to read
+      } else if (rows > 0 && OB_FAIL(block->swizzling(NULL))) {
         LOG_WARN("block swizzling failed", K(ret));
       }
     } else {
@@ -481,6 +481,14 @@ int ObPxMsgProc::on_piece_msg(
   return proc.on_piece_msg(coord_info_, ctx, pkt);
 }
 
+int ObPxMsgProc::on_piece_msg(
+    ObExecContext &ctx,
+    const ObSkewDetectPieceMsg &pkt)
+{
+  ObDhPieceMsgProc<ObSkewDetectPieceMsg> proc;
+  return proc.on_piece_msg(coord_info_, ctx, pkt);
+}
+
 int ObPxMsgProc::on_eof_row(ObExecContext &ctx)
 {
   int ret = OB_SUCCESS;
@@ -784,6 +792,13 @@ int ObPxTerminateMsgProc::on_piece_msg(
   return common::OB_SUCCESS;
 }
 
+int ObPxTerminateMsgProc::on_piece_msg(
+    ObExecContext &,
+    const ObSkewDetectPieceMsg &)
+{
+  return common::OB_SUCCESS;
+}
+
 int ObPxCoordInfo::init()
 {
   int ret = OB_SUCCESS;
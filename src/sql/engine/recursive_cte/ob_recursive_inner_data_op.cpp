@@ -332,7 +332,8 @@ int ObRecursiveInnerDataOp::try_get_left_rows(bool batch_mode /* = false */)
     } else {
       // never get there
     }
-    if (OB_SUCC(ret)) {
+    // rows are formatted by get_next_batch in batch mode
+    if (OB_SUCC(ret) && !batch_mode) {
       if (OB_FAIL(try_format_output_row())) {//why check does NOT check iter_end
         LOG_WARN("Failed to get next row", K(ret));
       }
@@ -374,8 +375,8 @@ int ObRecursiveInnerDataOp::try_get_right_rows(bool batch_mode /* = false */)
       }
     }
   }
-  // try to get row again
-  if (OB_SUCC(ret)) {
+  // try to get row again, rows are formatted by get_next_batch in batch mode
+  if (OB_SUCC(ret) && !batch_mode) {
     if (OB_FAIL(try_format_output_row())) {
       if (ret != OB_ITER_END) {
         LOG_WARN("Failed to get next row", K(ret));
@@ -428,69 +429,68 @@ int ObRecursiveInnerDataOp::get_next_row()
   return ret;
 }
 
-// Note: keep batch size to one when generating output
-// The reason making output batch size to one is that the parent-child relation
-// or search path is maintained in method search tree and is processed for row
-// iteration. However, maintaining the parent-child relations or search paths
-// during batch iterating make it MUCH MUCH more complicated. And its benefits
-// outweight the overhead of maintaining the parent-child relation.
-// Thus, make recursive union all return output with batch size to 1 so far.
+// Parent-child relations and search paths are maintained in the search method tree and
+// are processed one node at a time: each pump puts one non-cycle node into the fake cte
+// table and runs the right branch for its children. The rows moved into result_output_
+// by a pump are independent of each other and stay alive in stored_row_buf_ until rescan.
+//
+// So the recursive search is pumped until max_row_cnt rows are buffered in result_output_
+// or the search is done, and only then are the buffered rows formatted into the batch.
+// The children never run while the output rows of the current batch are being filled.
 int ObRecursiveInnerDataOp::get_next_batch(const int64_t max_row_cnt,
                                            ObBatchRows &brs)
 {
   int ret = OB_SUCCESS;
-  UNUSED(max_row_cnt);
-  LOG_DEBUG("Entrance of get_next_batch", K(result_output_.empty()), K(state_));
-  if (!result_output_.empty()) {
-    if (OB_FAIL(try_format_output_row())) {
-      LOG_WARN("Format output row failed", K(ret));
-    }// else { } do nothing
-  } else if (RecursiveUnionState::R_UNION_READ_LEFT == state_) {
-    if (is_mysql_mode() && OB_FAIL(check_recursive_depth())) {
-      LOG_WARN("Recursive query abort", K(ret));
-    } else if (OB_FAIL(try_get_left_rows(true))) {
-      if (ret != OB_ITER_END) {
-        LOG_WARN("Get left rows failed", K(ret));
+  int64_t read_rows = 0;
+  LOG_DEBUG("Entrance of get_next_batch", K(result_output_.size()), K(state_));
+  while (OB_SUCC(ret) && result_output_.size() < max_row_cnt
+         && RecursiveUnionState::R_UNION_END != state_) {
+    const int64_t output_cnt = result_output_.size();
+    if (RecursiveUnionState::R_UNION_READ_LEFT == state_) {
+      if (is_mysql_mode() && OB_FAIL(check_recursive_depth())) {
+        LOG_WARN("Recursive query abort", K(ret));
+      } else if (OB_FAIL(try_get_left_rows(true))) {
+        if (ret != OB_ITER_END) {
+          LOG_WARN("Get left rows failed", K(ret));
+        } else {
+          ret = OB_SUCCESS;
+          state_ = RecursiveUnionState::R_UNION_END;
+        }
       } else {
+        state_ = R_UNION_READ_RIGHT;
+      }
+    } else if (RecursiveUnionState::R_UNION_READ_RIGHT == state_) {
+      if (is_mysql_mode() && OB_FAIL(check_recursive_depth())) {
+        LOG_WARN("Recursive query abort", K(ret));
+      } else if (OB_FAIL(try_get_right_rows(true))) {
+        LOG_WARN("Get right rows failed", K(ret));
+      } else if (output_cnt == result_output_.size()) {
+        // no node left in the search method, same as OB_ITER_END of try_format_output_row
         state_ = RecursiveUnionState::R_UNION_END;
       }
     } else {
-      state_ = R_UNION_READ_RIGHT;
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Unexpected state", K(ret), K(state_));
     }
-  } else if (RecursiveUnionState::R_UNION_READ_RIGHT == state_) {
-    if (is_mysql_mode() && OB_FAIL(check_recursive_depth())) {
-      LOG_WARN("Recursive query abort", K(ret));
-    } else if (OB_FAIL(try_get_right_rows(true))) {
-      if (ret != OB_ITER_END) {
-        LOG_WARN("Get right rows failed", K(ret));
+  }
+
+  if (OB_SUCC(ret)) {
+    ObEvalCtx::BatchInfoScopeGuard guard(eval_ctx_);
+    while (OB_SUCC(ret) && read_rows < max_row_cnt && !result_output_.empty()) {
+      guard.set_batch_idx(read_rows);
+      if (OB_FAIL(try_format_output_row())) {
+        LOG_WARN("Format output row failed", K(ret));
       } else {
-        state_ = RecursiveUnionState::R_UNION_END;
+        ++read_rows;
       }
-    } else { }
-  } else if (RecursiveUnionState::R_UNION_END == state_) {
-    brs.size_ = 0;
-    brs.end_ = true;
-    LOG_DEBUG("reach iterator end", K(ret), K(brs));
-  } else {
-    ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("Unexpected state", K(ret), K(state_));
+    }
   }
 
   if (OB_SUCC(ret)) {
-    if (brs.end_) {
-      // do nothing already set in previouse block
-    } else {
-      brs.end_ = false;
-      brs.size_ = 1;
-    }
-  } else if (ret == OB_ITER_END) {
-    brs.end_ = true;
-    brs.size_ = 0;
-    LOG_DEBUG("ret is OB_ITER_END, should NEVER hit here",
-             K(result_output_.empty()), K(ret), K(brs));
-    ret = OB_SUCCESS;
+    brs.size_ = read_rows;
+    brs.end_ = (0 == read_rows && RecursiveUnionState::R_UNION_END == state_);
   }
-  LOG_DEBUG("end of get_next_batch", K(result_output_.empty()), K(ret), K(brs));
+  LOG_DEBUG("end of get_next_batch", K(result_output_.size()), K(ret), K(brs));
   return ret;
 }
 
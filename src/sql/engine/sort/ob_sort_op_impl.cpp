@@ -575,7 +575,8 @@ ObSortOpImpl::ObSortOpImpl(ObMonitorNode &op_monitor_info)
     op_type_(PHY_INVALID), op_id_(UINT64_MAX), exec_ctx_(nullptr), stored_rows_(nullptr),
     io_event_observer_(nullptr), buckets_(NULL), max_bucket_cnt_(0), part_hash_nodes_(NULL),
     max_node_cnt_(0), part_cnt_(0), topn_cnt_(INT64_MAX), outputted_rows_cnt_(0),
-    is_fetch_with_ties_(false), topn_heap_(NULL), ties_array_pos_(0), ties_array_(),
+    is_fetch_with_ties_(false), topn_heap_(NULL), topn_filter_skip_(NULL), topn_filter_cnt_(0),
+    ties_array_pos_(0), ties_array_(),
     last_ties_row_(NULL), rows_(NULL)
 {
 }
@@ -656,6 +657,12 @@ int ObSortOpImpl::init(
                            sizeof(*stored_rows_) * batch_size)))) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
       LOG_WARN("allocate memory failed", K(ret));
+    } else if (is_topn_sort() && batch_size > 0
+               && OB_ISNULL(topn_filter_skip_ = to_bit_vector(
+                       mem_context_->get_malloc_allocator().alloc(
+                           ObBitVector::memory_size(batch_size))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret));
     } else {
       quick_sort_array_.set_block_allocator(
         ModulePageAllocator(mem_context_->get_malloc_allocator(), "SortOpRows"));
@@ -765,6 +772,7 @@ void ObSortOpImpl::reset()
   topn_cnt_ = INT64_MAX;
   outputted_rows_cnt_ = 0;
   is_fetch_with_ties_ = false;
+  topn_filter_cnt_ = 0;
   rows_ = NULL;
   ties_array_pos_ = 0;
   if (0 != ties_array_.count()) {
@@ -789,6 +797,10 @@ void ObSortOpImpl::reset()
       mem_context_->get_malloc_allocator().free(stored_rows_);
       stored_rows_ = NULL;
     }
+    if (NULL != topn_filter_skip_) {
+      mem_context_->get_malloc_allocator().free(topn_filter_skip_);
+      topn_filter_skip_ = NULL;
+    }
     if (NULL != buckets_) {
       mem_context_->get_malloc_allocator().free(buckets_);
       buckets_ = NULL;
@@ -1762,6 +1774,9 @@ int ObSortOpImpl::sort()
       LOG_WARN("dump failed");
     }
   }
+  if (topn_filter_cnt_ > 0) {
+    LOG_TRACE("rows filtered by topn heap top", K_(topn_filter_cnt), K_(topn_cnt));
+  }
 
   if (OB_FAIL(ret)) {
     // do nothing
@@ -2001,17 +2016,26 @@ int ObSortOpImpl::add_heap_sort_batch(const common::ObIArray<ObExpr *> &exprs,
   int ret = OB_SUCCESS;
   int64_t row_count = 0;
   const ObChunkDatumStore::StoredRow *store_row = NULL;
+  const ObBitVector *filtered_skip = &skip;
   ObEvalCtx::BatchInfoScopeGuard batch_info_guard(*eval_ctx_);
   batch_info_guard.set_batch_size(batch_size);
+  if (start_pos > 0) {
+    // rows before start_pos are added already, filter is not applied for partial batch
+  } else if (OB_FAIL(topn_filter_batch(exprs, skip, batch_size, filtered_skip))) {
+    LOG_WARN("failed to filter batch by heap top", K(ret));
+  }
   for (int64_t i = start_pos; OB_SUCC(ret) && i < batch_size; i++) {
     if (skip.at(i)) {
       continue;
     }
+    row_count++;
+    if (filtered_skip->at(i)) {
+      continue;
+    }
     batch_info_guard.set_batch_idx(i);
     if (OB_FAIL(add_heap_sort_row(exprs, store_row))) {
       LOG_WARN("failed to add topn row", K(ret));
     }
-    row_count++;
   }
   if (OB_NOT_NULL(append_row_count)) {
     *append_row_count = row_count;
@@ -2048,6 +2072,50 @@ int ObSortOpImpl::add_heap_sort_batch(const common::ObIArray<ObExpr *> &exprs,
   return ret;
 }
 
+int ObSortOpImpl::topn_filter_batch(const common::ObIArray<ObExpr *> &exprs,
+                                    const ObBitVector &skip,
+                                    const int64_t batch_size,
+                                    const ObBitVector *&filtered_skip)
+{
+  int ret = OB_SUCCESS;
+  filtered_skip = &skip;
+  if (OB_ISNULL(topn_heap_) || OB_ISNULL(topn_filter_skip_)
+      || topn_heap_->count() < topn_cnt_ - outputted_rows_cnt_
+      || topn_heap_->empty() || OB_ISNULL(topn_heap_->top())
+      || batch_size > eval_ctx_->max_batch_size_ || comp_.enable_encode_sortkey_
+      || OB_ISNULL(sort_collations_) || sort_collations_->empty()) {
+    // heap is not full, every row may enter it
+  } else {
+    const ObSortFieldCollation &collation = sort_collations_->at(0);
+    const ObDatum &threshold = topn_heap_->top()->cells()[collation.field_idx_];
+    ObDatumCmpFuncType cmp_func = sort_cmp_funs_->at(0).cmp_func_;
+    ObExpr *key_expr = exprs.at(collation.field_idx_);
+    if (OB_FAIL(key_expr->eval_batch(*eval_ctx_, skip, batch_size))) {
+      LOG_WARN("failed to eval leading sort key", K(ret));
+    } else {
+      ObDatumVector keys = key_expr->locate_expr_datumvector(*eval_ctx_);
+      int64_t filter_cnt = 0;
+      int cmp = 0;
+      topn_filter_skip_->deep_copy(skip, batch_size);
+      for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; i++) {
+        if (skip.at(i)) {
+        } else if (OB_FAIL(cmp_func(*keys.at(i), threshold, cmp))) {
+          LOG_WARN("failed to compare", K(ret));
+        } else if (collation.is_ascending_ ? cmp > 0 : cmp < 0) {
+          // with ties needs rows equal to heap top only, strictly behind rows are useless too
+          topn_filter_skip_->set(i);
+          filter_cnt++;
+        }
+      }
+      if (OB_SUCC(ret)) {
+        filtered_skip = topn_filter_skip_;
+        topn_filter_cnt_ += filter_cnt;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObSortOpImpl::adjust_topn_heap(const common::ObIArray<ObExpr*> &exprs,
                                    const ObChunkDatumStore::StoredRow *&store_row)
 {
@@ -524,6 +524,12 @@ protected:
                           const int64_t batch_size,
                           const uint16_t selector[],
                           const int64_t size);
+  // Rows whose leading sort key is behind the heap top can never enter the top-n, mark them
+  // skipped in %topn_filter_skip_ with one vectorized comparison before touching the heap.
+  int topn_filter_batch(const common::ObIArray<ObExpr *> &exprs,
+                        const ObBitVector &skip,
+                        const int64_t batch_size,
+                        const ObBitVector *&filtered_skip);
   int adjust_topn_heap(const common::ObIArray<ObExpr*> &exprs,
                        const ObChunkDatumStore::StoredRow *&store_row);
   int adjust_topn_heap_with_ties(const common::ObIArray<ObExpr*> &exprs,
@@ -598,6 +604,9 @@ protected:
   bool use_heap_sort_;
   bool is_fetch_with_ties_;
   TopnHeap *topn_heap_;
+  // skip bitmap of batch filtered by the heap top, and count of rows filtered
+  ObBitVector *topn_filter_skip_;
+  int64_t topn_filter_cnt_;
   int64_t ties_array_pos_;
   common::ObArray<SortStoredRow *> ties_array_;
   ObChunkDatumStore::StoredRow *last_ties_row_;
@@ -4,6 +4,7 @@
 
 #define USING_LOG_PREFIX SQL
 #include "ob_external_table_access_service.h"
+#include "ob_parquet_table_row_iter.h"
 
 #include "sql/resolver/ob_resolver_utils.h"
 #include "sql/engine/expr/ob_expr.h"
@@ -243,6 +244,12 @@ int ObExternalTableAccessService::table_scan(
         LOG_WARN("alloc memory failed", K(ret));
       }
       break;
+    case ObExternalFileFormat::PARQUET_FORMAT:
+      if (OB_ISNULL(row_iter = OB_NEWx(ObParquetTableRowIterator, (scan_param.allocator_)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret));
+      }
+      break;
     default:
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("unexpected format", K(ret), "format", param.external_file_format_.format_type_);
@@ -270,6 +277,7 @@ int ObExternalTableAccessService::table_rescan(ObVTableScanParam &param, ObNewRo
   } else {
     switch (param.external_file_format_.format_type_) {
       case ObExternalFileFormat::CSV_FORMAT:
+      case ObExternalFileFormat::PARQUET_FORMAT:
         result->reset();
         break;
       default:
@@ -0,0 +1,679 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/table/ob_parquet_file_meta.h"
+#include "lib/oblog/ob_log_module.h"
+#include "share/ob_errno.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+/*------------------------------ ObParquetThriftReader ------------------------------*/
+
+int ObParquetThriftReader::read_byte(uint8_t &value)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(pos_ >= len_)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("thrift data is truncated", K(ret), K(*this));
+  } else {
+    value = static_cast<uint8_t>(buf_[pos_++]);
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_varint(uint64_t &value)
+{
+  int ret = OB_SUCCESS;
+  uint8_t byte = 0;
+  int64_t shift = 0;
+  value = 0;
+  do {
+    if (OB_FAIL(read_byte(byte))) {
+      LOG_WARN("fail to read varint", K(ret));
+    } else if (OB_UNLIKELY(shift > 63)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("varint is too long", K(ret), K(*this));
+    } else {
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      shift += 7;
+    }
+  } while (OB_SUCC(ret) && (byte & 0x80));
+  return ret;
+}
+
+int ObParquetThriftReader::read_zigzag(int64_t &value)
+{
+  int ret = OB_SUCCESS;
+  uint64_t v = 0;
+  if (OB_FAIL(read_varint(v))) {
+    LOG_WARN("fail to read varint", K(ret));
+  } else {
+    value = static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_field_begin(int16_t &field_id, uint8_t &field_type)
+{
+  int ret = OB_SUCCESS;
+  uint8_t byte = 0;
+  if (OB_FAIL(read_byte(byte))) {
+    LOG_WARN("fail to read field header", K(ret));
+  } else if (FALSE_IT(field_type = byte & 0x0f)) {
+  } else if (T_STOP == field_type) {
+    field_id = 0;
+  } else {
+    const int16_t delta = static_cast<int16_t>(byte >> 4);
+    if (0 != delta) {
+      field_id = static_cast<int16_t>(last_field_id_ + delta);
+    } else {
+      int64_t id = 0;
+      if (OB_FAIL(read_zigzag(id))) {
+        LOG_WARN("fail to read field id", K(ret));
+      } else {
+        field_id = static_cast<int16_t>(id);
+      }
+    }
+    last_field_id_ = field_id;
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_list_begin(uint8_t &elem_type, int64_t &size)
+{
+  int ret = OB_SUCCESS;
+  uint8_t byte = 0;
+  if (OB_FAIL(read_byte(byte))) {
+    LOG_WARN("fail to read list header", K(ret));
+  } else {
+    elem_type = byte & 0x0f;
+    size = byte >> 4;
+    if (15 == size) {
+      uint64_t v = 0;
+      if (OB_FAIL(read_varint(v))) {
+        LOG_WARN("fail to read list size", K(ret));
+      } else if (OB_UNLIKELY(v > static_cast<uint64_t>(len_))) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("invalid list size", K(ret), K(v), K(*this));
+      } else {
+        size = static_cast<int64_t>(v);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_bool(const uint8_t field_type, bool &value)
+{
+  int ret = OB_SUCCESS;
+  if (T_BOOL_TRUE == field_type) {
+    value = true;
+  } else if (T_BOOL_FALSE == field_type) {
+    value = false;
+  } else {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("unexpected field type", K(ret), K(field_type));
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_i32(const uint8_t field_type, int32_t &value)
+{
+  int ret = OB_SUCCESS;
+  int64_t v = 0;
+  if (OB_UNLIKELY(T_I32 != field_type && T_I16 != field_type)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("unexpected field type", K(ret), K(field_type));
+  } else if (OB_FAIL(read_zigzag(v))) {
+    LOG_WARN("fail to read i32", K(ret));
+  } else {
+    value = static_cast<int32_t>(v);
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_i64(const uint8_t field_type, int64_t &value)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(T_I64 != field_type && T_I32 != field_type)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("unexpected field type", K(ret), K(field_type));
+  } else if (OB_FAIL(read_zigzag(value))) {
+    LOG_WARN("fail to read i64", K(ret));
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::read_binary(const uint8_t field_type, ObString &value)
+{
+  int ret = OB_SUCCESS;
+  uint64_t len = 0;
+  if (OB_UNLIKELY(T_BINARY != field_type)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("unexpected field type", K(ret), K(field_type));
+  } else if (OB_FAIL(read_varint(len))) {
+    LOG_WARN("fail to read binary length", K(ret));
+  } else if (OB_UNLIKELY(len > static_cast<uint64_t>(len_ - pos_))) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("binary is truncated", K(ret), K(len), K(*this));
+  } else {
+    value.assign_ptr(buf_ + pos_, static_cast<int32_t>(len));
+    pos_ += len;
+  }
+  return ret;
+}
+
+int ObParquetThriftReader::skip(const uint8_t field_type, const int64_t depth)
+{
+  int ret = OB_SUCCESS;
+  uint8_t byte = 0;
+  uint64_t len = 0;
+  int64_t v = 0;
+  if (OB_UNLIKELY(depth > MAX_NESTED_DEPTH)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("thrift data is nested too deep", K(ret), K(depth));
+  } else {
+    switch (field_type) {
+      case T_BOOL_TRUE:
+      case T_BOOL_FALSE:
+        // value of boolean fields is in the field type
+        break;
+      case T_BYTE:
+        ret = read_byte(byte);
+        break;
+      case T_I16:
+      case T_I32:
+      case T_I64:
+        ret = read_zigzag(v);
+        break;
+      case T_DOUBLE:
+        if (OB_UNLIKELY(pos_ + 8 > len_)) {
+          ret = OB_INVALID_DATA;
+          LOG_WARN("thrift data is truncated", K(ret), K(*this));
+        } else {
+          pos_ += 8;
+        }
+        break;
+      case T_BINARY:
+        if (OB_FAIL(read_varint(len))) {
+        } else if (OB_UNLIKELY(len > static_cast<uint64_t>(len_ - pos_))) {
+          ret = OB_INVALID_DATA;
+          LOG_WARN("binary is truncated", K(ret), K(len), K(*this));
+        } else {
+          pos_ += len;
+        }
+        break;
+      case T_LIST:
+      case T_SET: {
+        uint8_t elem_type = 0;
+        int64_t size = 0;
+        if (OB_FAIL(read_list_begin(elem_type, size))) {
+        } else if (T_BOOL_TRUE == elem_type || T_BOOL_FALSE == elem_type) {
+          // boolean elements take one byte each
+          for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+            ret = read_byte(byte);
+          }
+        } else {
+          for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+            ret = skip(elem_type, depth + 1);
+          }
+        }
+        break;
+      }
+      case T_MAP: {
+        if (OB_FAIL(read_varint(len))) {
+        } else if (len > 0 && OB_FAIL(read_byte(byte))) {
+        } else {
+          const uint8_t types[2] = { static_cast<uint8_t>(byte >> 4), static_cast<uint8_t>(byte & 0x0f) };
+          for (uint64_t i = 0; OB_SUCC(ret) && i < len; i++) {
+            for (int64_t j = 0; OB_SUCC(ret) && j < 2; j++) {
+              if (T_BOOL_TRUE == types[j] || T_BOOL_FALSE == types[j]) {
+                ret = read_byte(byte);
+              } else {
+                ret = skip(types[j], depth + 1);
+              }
+            }
+          }
+        }
+        break;
+      }
+      case T_STRUCT: {
+        int16_t saved_field_id = 0;
+        int16_t field_id = 0;
+        uint8_t type = T_STOP;
+        read_struct_begin(saved_field_id);
+        while (OB_SUCC(ret) && OB_SUCC(read_field_begin(field_id, type)) && T_STOP != type) {
+          ret = skip(type, depth + 1);
+        }
+        read_struct_end(saved_field_id);
+        break;
+      }
+      default:
+        ret = OB_INVALID_DATA;
+        LOG_WARN("unknown thrift type", K(ret), K(field_type), K(*this));
+    }
+  }
+  return ret;
+}
+
+/*------------------------------ metadata ------------------------------*/
+
+const char ObParquetFileMeta::MAGIC[] = "PAR1";
+
+// Call handler for each field of the struct at the current position, the handler must consume
+// the field value, by reading or skipping it.
+template <typename FieldHandler>
+static int parse_struct(ObParquetThriftReader &reader, FieldHandler &&handler)
+{
+  int ret = OB_SUCCESS;
+  int16_t saved_field_id = 0;
+  int16_t field_id = 0;
+  uint8_t field_type = ObParquetThriftReader::T_STOP;
+  reader.read_struct_begin(saved_field_id);
+  while (OB_SUCC(ret)
+         && OB_SUCC(reader.read_field_begin(field_id, field_type))
+         && ObParquetThriftReader::T_STOP != field_type) {
+    ret = handler(field_id, field_type);
+  }
+  reader.read_struct_end(saved_field_id);
+  return ret;
+}
+
+static int parse_statistics(ObParquetThriftReader &reader, ObParquetStatistics &stat)
+{
+  int ret = OB_SUCCESS;
+  ObString min_value;
+  ObString max_value;
+  ret = parse_struct(reader, [&](const int16_t field_id, const uint8_t field_type) -> int {
+    int ret = OB_SUCCESS;
+    switch (field_id) {
+      case 1: ret = reader.read_binary(field_type, stat.max_); break;
+      case 2: ret = reader.read_binary(field_type, stat.min_); break;
+      case 3:
+        ret = reader.read_i64(field_type, stat.null_count_);
+        stat.has_null_count_ = true;
+        break;
+      case 5: ret = reader.read_binary(field_type, max_value); break;
+      case 6: ret = reader.read_binary(field_type, min_value); break;
+      default: ret = reader.skip(field_type);
+    }
+    return ret;
+  });
+  if (OB_SUCC(ret) && NULL != min_value.ptr() && NULL != max_value.ptr()) {
+    // min_value and max_value follow the sort order of the logical type, prefer them
+    stat.min_ = min_value;
+    stat.max_ = max_value;
+  }
+  return ret;
+}
+
+static int parse_timestamp_type(ObParquetThriftReader &reader, ObParquetColumnSchema &column)
+{
+  return parse_struct(reader, [&](const int16_t field_id, const uint8_t field_type) -> int {
+    int ret = OB_SUCCESS;
+    if (2 == field_id) {
+      // TimeUnit is a union of empty structs
+      ret = parse_struct(reader, [&](const int16_t unit_id, const uint8_t unit_type) -> int {
+        if (1 == unit_id) {
+          column.logical_type_ = PARQUET_LOGICAL_TIMESTAMP_MILLIS;
+        } else if (2 == unit_id) {
+          column.logical_type_ = PARQUET_LOGICAL_TIMESTAMP_MICROS;
+        } else if (3 == unit_id) {
+          column.logical_type_ = PARQUET_LOGICAL_TIMESTAMP_NANOS;
+        }
+        return reader.skip(unit_type);
+      });
+    } else {
+      ret = reader.skip(field_type);
+    }
+    return ret;
+  });
+}
+
+static int parse_logical_type(ObParquetThriftReader &reader, ObParquetColumnSchema &column)
+{
+  return parse_struct(reader, [&](const int16_t field_id, const uint8_t field_type) -> int {
+    int ret = OB_SUCCESS;
+    switch (field_id) {
+      case 1:  // STRING
+        column.logical_type_ = PARQUET_LOGICAL_STRING;
+        ret = reader.skip(field_type);
+        break;
+      case 5:  // DECIMAL
+        column.logical_type_ = PARQUET_LOGICAL_DECIMAL;
+        ret = parse_struct(reader, [&](const int16_t sub_id, const uint8_t sub_type) -> int {
+          return 1 == sub_id ? reader.read_i32(sub_type, column.scale_)
+              : (2 == sub_id ? reader.read_i32(sub_type, column.precision_) : reader.skip(sub_type));
+        });
+        break;
+      case 6:  // DATE
+        column.logical_type_ = PARQUET_LOGICAL_DATE;
+        ret = reader.skip(field_type);
+        break;
+      case 8:  // TIMESTAMP
+        ret = parse_timestamp_type(reader, column);
+        break;
+      case 10:  // INTEGER
+        ret = parse_struct(reader, [&](const int16_t sub_id, const uint8_t sub_type) -> int {
+          int ret = OB_SUCCESS;
+          bool is_signed = true;
+          if (2 != sub_id) {
+            ret = reader.skip(sub_type);
+          } else if (OB_SUCC(reader.read_bool(sub_type, is_signed)) && !is_signed) {
+            column.logical_type_ = PARQUET_LOGICAL_UNSIGNED;
+          }
+          return ret;
+        });
+        break;
+      default:
+        ret = reader.skip(field_type);
+    }
+    return ret;
+  });
+}
+
+static ObParquetLogicalType converted_type_to_logical_type(const int32_t converted_type)
+{
+  ObParquetLogicalType type = PARQUET_LOGICAL_NONE;
+  switch (converted_type) {
+    case 0:  type = PARQUET_LOGICAL_STRING; break;            // UTF8
+    case 5:  type = PARQUET_LOGICAL_DECIMAL; break;           // DECIMAL
+    case 6:  type = PARQUET_LOGICAL_DATE; break;              // DATE
+    case 9:  type = PARQUET_LOGICAL_TIMESTAMP_MILLIS; break;  // TIMESTAMP_MILLIS
+    case 10: type = PARQUET_LOGICAL_TIMESTAMP_MICROS; break;  // TIMESTAMP_MICROS
+    case 11:                                                  // UINT_8
+    case 12:                                                  // UINT_16
+    case 13:                                                  // UINT_32
+    case 14: type = PARQUET_LOGICAL_UNSIGNED; break;          // UINT_64
+    default: break;
+  }
+  return type;
+}
+
+static int parse_schema_element(ObParquetThriftReader &reader,
+                                ObParquetColumnSchema &column,
+                                int32_t &num_children)
+{
+  num_children = 0;
+  return parse_struct(reader, [&](const int16_t field_id, const uint8_t field_type) -> int {
+    int ret = OB_SUCCESS;
+    int32_t value = 0;
+    switch (field_id) {
+      case 1:
+        if (OB_SUCC(reader.read_i32(field_type, value))) {
+          column.physical_type_ = static_cast<ObParquetPhysicalType>(value);
+        }
+        break;
+      case 2: ret = reader.read_i32(field_type, column.type_length_); break;
+      case 3:
+        if (OB_SUCC(reader.read_i32(field_type, value))) {
+          column.repetition_ = static_cast<ObParquetRepetition>(value);
+        }
+        break;
+      case 4: ret = reader.read_binary(field_type, column.name_); break;
+      case 5: ret = reader.read_i32(field_type, num_children); break;
+      case 6:
+        // the logical type (field 10) takes precedence over the converted type
+        if (OB_SUCC(reader.read_i32(field_type, value))
+            && PARQUET_LOGICAL_NONE == column.logical_type_) {
+          column.logical_type_ = converted_type_to_logical_type(value);
+        }
+        break;
+      case 7: ret = reader.read_i32(field_type, column.scale_); break;
+      case 8: ret = reader.read_i32(field_type, column.precision_); break;
+      case 10: ret = parse_logical_type(reader, column); break;
+      default: ret = reader.skip(field_type);
+    }
+    return ret;
+  });
+}
+
+static int parse_column_meta(ObParquetThriftReader &reader, ObParquetColumnChunkMeta &chunk)
+{
+  return parse_struct(reader, [&](const int16_t field_id, const uint8_t field_type) -> int {
+    int ret = OB_SUCCESS;
+    int32_t value = 0;
+    switch (field_id) {
+      case 4:
+        if (OB_SUCC(reader.read_i32(field_type, value))) {
+          chunk.codec_ = static_cast<ObParquetCodec>(value);
+        }
+        break;
+      case 5: ret = reader.read_i64(field_type, chunk.num_values_); break;
+      case 7: ret = reader.read_i64(field_type, chunk.total_compressed_size_); break;
+      case 9: ret = reader.read_i64(field_type, chunk.data_page_offset_); break;
+      case 11: ret = reader.read_i64(field_type, chunk.dictionary_page_offset_); break;
+      case 12: ret = parse_statistics(reader, chunk.stat_); break;
+      default: ret = reader.skip(field_type);
+    }
+    return ret;
+  });
+}
+
+static int parse_column_chunk(ObParquetThriftReader &reader, ObParquetColumnChunkMeta &chunk)
+{
+  return parse_struct(reader, [&](const int16_t field_id, const uint8_t field_type) -> int {
+    int ret = OB_SUCCESS;
+    if (1 == field_id) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("column chunk stored in other file is not supported", K(ret));
+    } else if (3 == field_id) {
+      ret = parse_column_meta(reader, chunk);
+    } else {
+      ret = reader.skip(field_type);
+    }
+    return ret;
+  });
+}
+
+static int parse_row_group(ObParquetThriftReader &reader, ObParquetRowGroupMeta &row_group)
+{
+  return parse_struct(reader, [&](const int16_t field_id, const uint8_t field_type) -> int {
+    int ret = OB_SUCCESS;
+    uint8_t elem_type = 0;
+    int64_t size = 0;
+    if (1 == field_id && ObParquetThriftReader::T_LIST == field_type) {
+      if (OB_FAIL(reader.read_list_begin(elem_type, size))) {
+        LOG_WARN("fail to read column chunk list", K(ret));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+        ObParquetColumnChunkMeta chunk;
+        if (OB_FAIL(parse_column_chunk(reader, chunk))) {
+          LOG_WARN("fail to parse column chunk", K(ret), K(i));
+        } else if (OB_FAIL(row_group.columns_.push_back(chunk))) {
+          LOG_WARN("fail to push back column chunk", K(ret));
+        }
+      }
+    } else if (3 == field_id) {
+      ret = reader.read_i64(field_type, row_group.num_rows_);
+    } else {
+      ret = reader.skip(field_type);
+    }
+    return ret;
+  });
+}
+
+void ObParquetFileMeta::reset()
+{
+  for (int64_t i = 0; i < row_groups_.count(); i++) {
+    if (OB_NOT_NULL(row_groups_.at(i))) {
+      row_groups_.at(i)->~ObParquetRowGroupMeta();
+    }
+  }
+  row_groups_.reset();
+  columns_.reset();
+  num_rows_ = 0;
+}
+
+int ObParquetFileMeta::parse_schema(ObParquetThriftReader &reader)
+{
+  int ret = OB_SUCCESS;
+  uint8_t elem_type = 0;
+  int64_t size = 0;
+  if (OB_FAIL(reader.read_list_begin(elem_type, size))) {
+    LOG_WARN("fail to read schema list", K(ret));
+  }
+  // the first element is the root of the schema tree, all others must be its leaves
+  for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+    ObParquetColumnSchema column;
+    int32_t num_children = 0;
+    if (OB_FAIL(parse_schema_element(reader, column, num_children))) {
+      LOG_WARN("fail to parse schema element", K(ret), K(i));
+    } else if (0 == i) {
+      // root
+    } else if (OB_UNLIKELY(num_children > 0 || PARQUET_REPEATED == column.repetition_)) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("nested parquet schema is not supported", K(ret), K(column), K(num_children));
+      LOG_USER_ERROR(OB_NOT_SUPPORTED, "nested parquet schema");
+    } else if (OB_FAIL(columns_.push_back(column))) {
+      LOG_WARN("fail to push back column", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObParquetFileMeta::parse_row_groups(ObParquetThriftReader &reader, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  uint8_t elem_type = 0;
+  int64_t size = 0;
+  if (OB_FAIL(reader.read_list_begin(elem_type, size))) {
+    LOG_WARN("fail to read row group list", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+    void *mem = NULL;
+    ObParquetRowGroupMeta *row_group = NULL;
+    if (OB_ISNULL(mem = allocator.alloc(sizeof(ObParquetRowGroupMeta)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc row group meta", K(ret));
+    } else if (FALSE_IT(row_group = new (mem) ObParquetRowGroupMeta())) {
+    } else if (OB_FAIL(row_groups_.push_back(row_group))) {
+      row_group->~ObParquetRowGroupMeta();
+      LOG_WARN("fail to push back row group", K(ret));
+    } else if (OB_FAIL(parse_row_group(reader, *row_group))) {
+      LOG_WARN("fail to parse row group", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+int ObParquetFileMeta::deserialize(const char *buf, const int64_t len, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  ObParquetThriftReader reader(buf, len);
+  reset();
+  ret = parse_struct(reader, [&](const int16_t field_id, const uint8_t field_type) -> int {
+    int ret = OB_SUCCESS;
+    if (2 == field_id && ObParquetThriftReader::T_LIST == field_type) {
+      ret = parse_schema(reader);
+    } else if (3 == field_id) {
+      ret = reader.read_i64(field_type, num_rows_);
+    } else if (4 == field_id && ObParquetThriftReader::T_LIST == field_type) {
+      ret = parse_row_groups(reader, allocator);
+    } else {
+      ret = reader.skip(field_type);
+    }
+    return ret;
+  });
+  for (int64_t i = 0; OB_SUCC(ret) && i < row_groups_.count(); i++) {
+    if (OB_UNLIKELY(row_groups_.at(i)->columns_.count() != columns_.count())) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("column count of row group mismatches the schema", K(ret), K(i),
+               K(row_groups_.at(i)->columns_.count()), K(columns_.count()));
+    }
+  }
+  return ret;
+}
+
+void ObParquetPageHeader::reset()
+{
+  type_ = PARQUET_DATA_PAGE;
+  uncompressed_page_size_ = 0;
+  compressed_page_size_ = 0;
+  num_values_ = 0;
+  encoding_ = PARQUET_ENCODING_PLAIN;
+  definition_level_encoding_ = PARQUET_ENCODING_RLE;
+  num_nulls_ = 0;
+  definition_levels_byte_length_ = 0;
+  repetition_levels_byte_length_ = 0;
+  is_compressed_ = true;
+}
+
+int ObParquetPageHeader::deserialize(ObParquetThriftReader &reader)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  ret = parse_struct(reader, [&](const int16_t field_id, const uint8_t field_type) -> int {
+    int ret = OB_SUCCESS;
+    int32_t value = 0;
+    switch (field_id) {
+      case 1:
+        if (OB_SUCC(reader.read_i32(field_type, value))) {
+          type_ = static_cast<ObParquetPageType>(value);
+        }
+        break;
+      case 2: ret = reader.read_i32(field_type, uncompressed_page_size_); break;
+      case 3: ret = reader.read_i32(field_type, compressed_page_size_); break;
+      case 5:  // DataPageHeader
+      case 7:  // DictionaryPageHeader, whose fields 1 and 2 are the same with DataPageHeader
+        ret = parse_struct(reader, [&](const int16_t sub_id, const uint8_t sub_type) -> int {
+          int ret = OB_SUCCESS;
+          if (1 == sub_id) {
+            ret = reader.read_i32(sub_type, num_values_);
+          } else if (2 == sub_id) {
+            if (OB_SUCC(reader.read_i32(sub_type, value))) {
+              encoding_ = static_cast<ObParquetEncoding>(value);
+            }
+          } else if (3 == sub_id && 5 == field_id) {
+            if (OB_SUCC(reader.read_i32(sub_type, value))) {
+              definition_level_encoding_ = static_cast<ObParquetEncoding>(value);
+            }
+          } else {
+            ret = reader.skip(sub_type);
+          }
+          return ret;
+        });
+        break;
+      case 8:  // DataPageHeaderV2
+        ret = parse_struct(reader, [&](const int16_t sub_id, const uint8_t sub_type) -> int {
+          int ret = OB_SUCCESS;
+          switch (sub_id) {
+            case 1: ret = reader.read_i32(sub_type, num_values_); break;
+            case 2: ret = reader.read_i32(sub_type, num_nulls_); break;
+            case 4:
+              if (OB_SUCC(reader.read_i32(sub_type, value))) {
+                encoding_ = static_cast<ObParquetEncoding>(value);
+              }
+              break;
+            case 5: ret = reader.read_i32(sub_type, definition_levels_byte_length_); break;
+            case 6: ret = reader.read_i32(sub_type, repetition_levels_byte_length_); break;
+            case 7: ret = reader.read_bool(sub_type, is_compressed_); break;
+            default: ret = reader.skip(sub_type);
+          }
+          return ret;
+        });
+        break;
+      default: ret = reader.skip(field_type);
+    }
+    return ret;
+  });
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
@@ -0,0 +1,258 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_TABLE_OB_PARQUET_FILE_META_H_
+#define OCEANBASE_SQL_ENGINE_TABLE_OB_PARQUET_FILE_META_H_
+
+#include "lib/allocator/ob_allocator.h"
+#include "lib/container/ob_se_array.h"
+#include "lib/string/ob_string.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Metadata of parquet files, see https://github.com/apache/parquet-format.
+// Only the fields used by the external table scan are decoded, others are skipped.
+
+enum ObParquetPhysicalType
+{
+  PARQUET_BOOLEAN = 0,
+  PARQUET_INT32 = 1,
+  PARQUET_INT64 = 2,
+  PARQUET_INT96 = 3,
+  PARQUET_FLOAT = 4,
+  PARQUET_DOUBLE = 5,
+  PARQUET_BYTE_ARRAY = 6,
+  PARQUET_FIXED_LEN_BYTE_ARRAY = 7,
+};
+
+// Logical types we interpret, merged from the converted type and the logical type of the
+// schema element.
+enum ObParquetLogicalType
+{
+  PARQUET_LOGICAL_NONE = 0,
+  PARQUET_LOGICAL_STRING,
+  PARQUET_LOGICAL_DECIMAL,
+  PARQUET_LOGICAL_DATE,
+  PARQUET_LOGICAL_TIMESTAMP_MILLIS,
+  PARQUET_LOGICAL_TIMESTAMP_MICROS,
+  PARQUET_LOGICAL_TIMESTAMP_NANOS,
+  PARQUET_LOGICAL_UNSIGNED,
+};
+
+enum ObParquetRepetition
+{
+  PARQUET_REQUIRED = 0,
+  PARQUET_OPTIONAL = 1,
+  PARQUET_REPEATED = 2,
+};
+
+enum ObParquetEncoding
+{
+  PARQUET_ENCODING_PLAIN = 0,
+  PARQUET_ENCODING_PLAIN_DICTIONARY = 2,
+  PARQUET_ENCODING_RLE = 3,
+  PARQUET_ENCODING_BIT_PACKED = 4,
+  PARQUET_ENCODING_RLE_DICTIONARY = 8,
+};
+
+enum ObParquetCodec
+{
+  PARQUET_CODEC_UNCOMPRESSED = 0,
+  PARQUET_CODEC_SNAPPY = 1,
+  PARQUET_CODEC_GZIP = 2,
+  PARQUET_CODEC_LZO = 3,
+  PARQUET_CODEC_BROTLI = 4,
+  PARQUET_CODEC_LZ4 = 5,
+  PARQUET_CODEC_ZSTD = 6,
+  PARQUET_CODEC_LZ4_RAW = 7,
+};
+
+enum ObParquetPageType
+{
+  PARQUET_DATA_PAGE = 0,
+  PARQUET_INDEX_PAGE = 1,
+  PARQUET_DICTIONARY_PAGE = 2,
+  PARQUET_DATA_PAGE_V2 = 3,
+};
+
+// Reader of the thrift compact protocol, which parquet uses to serialize metadata.
+class ObParquetThriftReader
+{
+public:
+  enum FieldType
+  {
+    T_STOP = 0,
+    T_BOOL_TRUE = 1,
+    T_BOOL_FALSE = 2,
+    T_BYTE = 3,
+    T_I16 = 4,
+    T_I32 = 5,
+    T_I64 = 6,
+    T_DOUBLE = 7,
+    T_BINARY = 8,
+    T_LIST = 9,
+    T_SET = 10,
+    T_MAP = 11,
+    T_STRUCT = 12,
+  };
+  static const int64_t MAX_NESTED_DEPTH = 64;
+
+  ObParquetThriftReader(const char *buf, const int64_t len)
+    : buf_(buf), len_(len), pos_(0), last_field_id_(0) {}
+
+  // field_type is T_STOP at the end of a struct
+  int read_field_begin(int16_t &field_id, uint8_t &field_type);
+  void read_struct_begin(int16_t &saved_field_id) { saved_field_id = last_field_id_; last_field_id_ = 0; }
+  void read_struct_end(const int16_t saved_field_id) { last_field_id_ = saved_field_id; }
+  int read_list_begin(uint8_t &elem_type, int64_t &size);
+  int read_bool(const uint8_t field_type, bool &value);
+  int read_i32(const uint8_t field_type, int32_t &value);
+  int read_i64(const uint8_t field_type, int64_t &value);
+  int read_binary(const uint8_t field_type, common::ObString &value);
+  int skip(const uint8_t field_type, const int64_t depth = 0);
+  int64_t get_pos() const { return pos_; }
+
+  TO_STRING_KV(KP_(buf), K_(len), K_(pos), K_(last_field_id));
+
+private:
+  int read_byte(uint8_t &value);
+  int read_varint(uint64_t &value);
+  int read_zigzag(int64_t &value);
+
+private:
+  const char *buf_;
+  int64_t len_;
+  int64_t pos_;
+  int16_t last_field_id_;
+};
+
+struct ObParquetColumnSchema
+{
+  ObParquetColumnSchema()
+    : physical_type_(PARQUET_BYTE_ARRAY), logical_type_(PARQUET_LOGICAL_NONE),
+      repetition_(PARQUET_OPTIONAL), type_length_(0), scale_(0), precision_(0), name_() {}
+  bool is_optional() const { return PARQUET_OPTIONAL == repetition_; }
+
+  ObParquetPhysicalType physical_type_;
+  ObParquetLogicalType logical_type_;
+  ObParquetRepetition repetition_;
+  int32_t type_length_;
+  int32_t scale_;
+  int32_t precision_;
+  common::ObString name_;
+
+  TO_STRING_KV(K_(physical_type), K_(logical_type), K_(repetition), K_(type_length),
+               K_(scale), K_(precision), K_(name));
+};
+
+struct ObParquetStatistics
+{
+  ObParquetStatistics() : has_null_count_(false), null_count_(0), min_(), max_() {}
+  bool has_min_max() const { return NULL != min_.ptr() && NULL != max_.ptr(); }
+
+  bool has_null_count_;
+  int64_t null_count_;
+  // plain encoded min and max value
+  common::ObString min_;
+  common::ObString max_;
+
+  TO_STRING_KV(K_(has_null_count), K_(null_count), K(min_.length()), K(max_.length()));
+};
+
+struct ObParquetColumnChunkMeta
+{
+  ObParquetColumnChunkMeta()
+    : codec_(PARQUET_CODEC_UNCOMPRESSED), num_values_(0), total_compressed_size_(0),
+      data_page_offset_(0), dictionary_page_offset_(0), stat_() {}
+  // the column chunk starts from the dictionary page if there is one
+  int64_t get_chunk_offset() const
+  {
+    return (dictionary_page_offset_ > 0 && dictionary_page_offset_ < data_page_offset_)
+        ? dictionary_page_offset_ : data_page_offset_;
+  }
+
+  ObParquetCodec codec_;
+  int64_t num_values_;
+  int64_t total_compressed_size_;
+  int64_t data_page_offset_;
+  int64_t dictionary_page_offset_;
+  ObParquetStatistics stat_;
+
+  TO_STRING_KV(K_(codec), K_(num_values), K_(total_compressed_size), K_(data_page_offset),
+               K_(dictionary_page_offset), K_(stat));
+};
+
+struct ObParquetRowGroupMeta
+{
+  ObParquetRowGroupMeta() : num_rows_(0), columns_() {}
+
+  int64_t num_rows_;
+  common::ObSEArray<ObParquetColumnChunkMeta, 16> columns_;
+
+  TO_STRING_KV(K_(num_rows), K_(columns));
+};
+
+// Footer of a parquet file, only flat schemas are supported.
+struct ObParquetFileMeta
+{
+  static const int64_t FOOTER_SIZE = 8;  // 4 bytes metadata length and the "PAR1" magic
+  static const char MAGIC[];
+
+  ObParquetFileMeta() : num_rows_(0), columns_(), row_groups_() {}
+  ~ObParquetFileMeta() { reset(); }
+  void reset();
+  // buf holds the thrift serialized FileMetaData, strings in it are referenced by the meta
+  int deserialize(const char *buf, const int64_t len, common::ObIAllocator &allocator);
+
+  int64_t num_rows_;
+  common::ObSEArray<ObParquetColumnSchema, 16> columns_;
+  common::ObSEArray<ObParquetRowGroupMeta *, 16> row_groups_;
+
+  TO_STRING_KV(K_(num_rows), K_(columns), "row_group_count", row_groups_.count());
+
+private:
+  int parse_schema(ObParquetThriftReader &reader);
+  int parse_row_groups(ObParquetThriftReader &reader, common::ObIAllocator &allocator);
+};
+
+struct ObParquetPageHeader
+{
+  ObParquetPageHeader() { reset(); }
+  void reset();
+  int deserialize(ObParquetThriftReader &reader);
+
+  ObParquetPageType type_;
+  int32_t uncompressed_page_size_;
+  int32_t compressed_page_size_;
+  int32_t num_values_;
+  ObParquetEncoding encoding_;
+  ObParquetEncoding definition_level_encoding_;
+  // data page v2 only
+  int32_t num_nulls_;
+  int32_t definition_levels_byte_length_;
+  int32_t repetition_levels_byte_length_;
+  bool is_compressed_;
+
+  TO_STRING_KV(K_(type), K_(uncompressed_page_size), K_(compressed_page_size), K_(num_values),
+               K_(encoding), K_(definition_level_encoding), K_(num_nulls),
+               K_(definition_levels_byte_length), K_(repetition_levels_byte_length),
+               K_(is_compressed));
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif // OCEANBASE_SQL_ENGINE_TABLE_OB_PARQUET_FILE_META_H_
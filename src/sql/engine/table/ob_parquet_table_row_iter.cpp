@@ -0,0 +1,1585 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+#include "ob_parquet_table_row_iter.h"
+
+#include "common/ob_smart_call.h"
+#include "lib/charset/ob_dtoa.h"
+#include "lib/compress/ob_compressor_pool.h"
+#include "lib/timezone/ob_time_convert.h"
+#include "lib/utility/ob_fast_convert.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "share/external_table/ob_external_table_utils.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+namespace sql
+{
+
+static const int64_t PARQUET_MAX_DECIMAL_BYTES = 16;
+static const int64_t PARQUET_MAX_DECIMAL_SCALE = 38;
+static const int64_t JULIAN_DAY_OF_EPOCH = 2440588;
+static const int64_t PARQUET_USECS_PER_DAY = 86400000000LL;
+
+static bool is_string_physical_type(const ObParquetPhysicalType type)
+{
+  return PARQUET_INT96 == type || PARQUET_BYTE_ARRAY == type || PARQUET_FIXED_LEN_BYTE_ARRAY == type;
+}
+
+static int pread_fully(ObExternalDataAccessDriver &driver, char *buf, const int64_t len,
+                       const int64_t offset)
+{
+  int ret = OB_SUCCESS;
+  int64_t read_len = 0;
+  while (OB_SUCC(ret) && read_len < len) {
+    int64_t cur_len = 0;
+    if (OB_FAIL(driver.pread(buf + read_len, len - read_len, offset + read_len, cur_len))) {
+      LOG_WARN("fail to read file", K(ret), K(len), K(offset), K(read_len));
+    } else if (OB_UNLIKELY(cur_len <= 0)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("unexpected end of parquet file", K(ret), K(len), K(offset), K(read_len));
+    } else {
+      read_len += cur_len;
+    }
+  }
+  return ret;
+}
+
+static int get_parquet_compressor(const ObParquetCodec codec, ObCompressor *&compressor)
+{
+  int ret = OB_SUCCESS;
+  ObCompressorType type = INVALID_COMPRESSOR;
+  compressor = NULL;
+  switch (codec) {
+    case PARQUET_CODEC_UNCOMPRESSED:
+      break;
+    case PARQUET_CODEC_SNAPPY:
+      type = SNAPPY_COMPRESSOR;
+      break;
+    case PARQUET_CODEC_ZSTD:
+      type = ZSTD_1_3_8_COMPRESSOR;
+      break;
+    case PARQUET_CODEC_LZ4_RAW:
+      type = LZ4_191_COMPRESSOR;
+      break;
+    default:
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("parquet codec not supported", K(ret), K(codec));
+      LOG_USER_ERROR(OB_NOT_SUPPORTED, "parquet compression codec other than snappy, zstd and lz4_raw");
+      break;
+  }
+  if (OB_SUCC(ret) && INVALID_COMPRESSOR != type
+      && OB_FAIL(ObCompressorPool::get_instance().get_compressor(type, compressor))) {
+    LOG_WARN("fail to get compressor", K(ret), K(type));
+  }
+  return ret;
+}
+
+void ObParquetRleDecoder::reset()
+{
+  data_ = NULL;
+  end_ = NULL;
+  bit_width_ = 0;
+  rle_left_ = 0;
+  rle_value_ = 0;
+  bp_left_ = 0;
+  bp_data_ = NULL;
+  bp_end_ = NULL;
+  bp_bit_pos_ = 0;
+}
+
+int ObParquetRleDecoder::init(const char *data, const int64_t len, const int64_t bit_width)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_UNLIKELY(len < 0 || bit_width < 0 || bit_width > 32)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid rle data", K(ret), K(len), K(bit_width));
+  } else {
+    data_ = data;
+    end_ = data + len;
+    bit_width_ = bit_width;
+  }
+  return ret;
+}
+
+// A run starts with a ULEB128 header, whose lowest bit tells a bit-packed run of
+// (header >> 1) groups of 8 values, or a RLE run of (header >> 1) repeated values.
+int ObParquetRleDecoder::next_run()
+{
+  int ret = OB_SUCCESS;
+  uint64_t header = 0;
+  bool finished = false;
+  for (int64_t shift = 0; OB_SUCC(ret) && !finished; shift += 7) {
+    if (OB_UNLIKELY(data_ >= end_ || shift > 63)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid rle run header", K(ret), K(shift));
+    } else {
+      const uint8_t byte = static_cast<uint8_t>(*data_++);
+      header |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      finished = 0 == (byte & 0x80);
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (header & 1) {
+    const uint64_t groups = header >> 1;
+    if (OB_UNLIKELY(0 == groups || groups > INT32_MAX)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid bit-packed run", K(ret), K(groups));
+    } else {
+      // the last run may be truncated, values beyond the data are never read
+      const int64_t bytes = MIN(static_cast<int64_t>(groups) * bit_width_, end_ - data_);
+      bp_left_ = static_cast<int64_t>(groups) * 8;
+      bp_data_ = data_;
+      bp_end_ = data_ + bytes;
+      bp_bit_pos_ = 0;
+      data_ += bytes;
+    }
+  } else {
+    const int64_t value_bytes = (bit_width_ + 7) / 8;
+    rle_left_ = static_cast<int64_t>(header >> 1);
+    if (OB_UNLIKELY(0 == rle_left_ || value_bytes > end_ - data_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid rle run", K(ret), K_(rle_left), K(value_bytes));
+    } else {
+      rle_value_ = 0;
+      MEMCPY(&rle_value_, data_, value_bytes);
+      data_ += value_bytes;
+    }
+  }
+  return ret;
+}
+
+int ObParquetRleDecoder::get_batch(uint32_t *values, const int64_t cnt)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t mask = (1ULL << bit_width_) - 1;
+  for (int64_t i = 0; OB_SUCC(ret) && i < cnt; ) {
+    if (rle_left_ > 0) {
+      const int64_t n = MIN(rle_left_, cnt - i);
+      for (int64_t j = 0; j < n; j++) {
+        values[i + j] = rle_value_;
+      }
+      rle_left_ -= n;
+      i += n;
+    } else if (bp_left_ > 0) {
+      const int64_t n = MIN(bp_left_, cnt - i);
+      for (int64_t j = 0; OB_SUCC(ret) && j < n; j++) {
+        const int64_t byte_pos = bp_bit_pos_ >> 3;
+        const int64_t shift = bp_bit_pos_ & 7;
+        const int64_t avail = bp_end_ - bp_data_ - byte_pos;
+        if (0 == bit_width_) {
+          values[i + j] = 0;
+        } else if (OB_UNLIKELY((shift + bit_width_ + 7) / 8 > avail)) {
+          ret = OB_INVALID_DATA;
+          LOG_WARN("bit-packed run truncated", K(ret), K_(bp_bit_pos), K(avail));
+        } else {
+          uint64_t word = 0;
+          MEMCPY(&word, bp_data_ + byte_pos, MIN(avail, static_cast<int64_t>(sizeof(word))));
+          values[i + j] = static_cast<uint32_t>((word >> shift) & mask);
+          bp_bit_pos_ += bit_width_;
+        }
+      }
+      bp_left_ -= n;
+      i += n;
+    } else if (OB_FAIL(next_run())) {
+      LOG_WARN("fail to decode rle run", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObParquetValueBatch::init(const int64_t capacity, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  void *strs_buf = NULL;
+  if (OB_ISNULL(nulls_ = static_cast<bool *>(allocator.alloc(sizeof(bool) * capacity)))
+      || OB_ISNULL(fixed_ = static_cast<int64_t *>(allocator.alloc(sizeof(int64_t) * capacity)))
+      || OB_ISNULL(strs_buf = allocator.alloc(sizeof(ObString) * capacity))
+      || OB_ISNULL(buf_ = static_cast<uint32_t *>(allocator.alloc(sizeof(uint32_t) * capacity)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc memory", K(ret), K(capacity));
+  } else {
+    strs_ = new (strs_buf) ObString[capacity];
+    capacity_ = capacity;
+  }
+  return ret;
+}
+
+void ObParquetColumnReader::reset()
+{
+  schema_ = NULL;
+  allocator_ = NULL;
+  compressor_ = NULL;
+  codec_ = PARQUET_CODEC_UNCOMPRESSED;
+  chunk_buf_ = NULL;
+  chunk_len_ = 0;
+  chunk_pos_ = 0;
+  dict_cnt_ = 0;
+  dict_fixed_ = NULL;
+  dict_strs_ = NULL;
+  page_rows_left_ = 0;
+  encoding_ = PARQUET_ENCODING_PLAIN;
+  has_def_levels_ = false;
+  def_decoder_.reset();
+  value_decoder_.reset();
+  values_ = NULL;
+  values_end_ = NULL;
+  bool_bit_pos_ = 0;
+}
+
+int ObParquetColumnReader::open(ObExternalDataAccessDriver &driver,
+                                const ObParquetColumnSchema &schema,
+                                const ObParquetColumnChunkMeta &chunk,
+                                ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  char *buf = NULL;
+  const int64_t len = chunk.total_compressed_size_;
+  reset();
+  if (OB_UNLIKELY(len <= 0 || chunk.get_chunk_offset() < 0)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid parquet column chunk", K(ret), K(chunk));
+  } else if (OB_FAIL(get_parquet_compressor(chunk.codec_, compressor_))) {
+    LOG_WARN("fail to get compressor", K(ret), K(chunk));
+  } else if (OB_ISNULL(buf = static_cast<char *>(allocator.alloc(len)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc memory", K(ret), K(len));
+  } else if (OB_FAIL(pread_fully(driver, buf, len, chunk.get_chunk_offset()))) {
+    LOG_WARN("fail to read column chunk", K(ret), K(chunk));
+  } else {
+    schema_ = &schema;
+    allocator_ = &allocator;
+    codec_ = chunk.codec_;
+    chunk_buf_ = buf;
+    chunk_len_ = len;
+    chunk_pos_ = 0;
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::decompress(const char *src, const int64_t src_len,
+                                      const int64_t dst_len, const char *&dst)
+{
+  int ret = OB_SUCCESS;
+  if (NULL == compressor_ || 0 == dst_len) {
+    if (OB_UNLIKELY(dst_len > src_len)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid page size", K(ret), K(src_len), K(dst_len));
+    } else {
+      dst = src;
+    }
+  } else {
+    char *buf = NULL;
+    int64_t data_len = 0;
+    if (OB_ISNULL(buf = static_cast<char *>(allocator_->alloc(dst_len)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory", K(ret), K(dst_len));
+    } else if (OB_FAIL(compressor_->decompress(src, src_len, buf, dst_len, data_len))) {
+      LOG_WARN("fail to decompress page", K(ret), K_(codec), K(src_len), K(dst_len));
+    } else if (OB_UNLIKELY(data_len != dst_len)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("decompressed size mismatch", K(ret), K(data_len), K(dst_len));
+    } else {
+      dst = buf;
+    }
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::next_page(int64_t &skip_rows)
+{
+  int ret = OB_SUCCESS;
+  bool found = false;
+  while (OB_SUCC(ret) && !found) {
+    ObParquetPageHeader header;
+    ObParquetThriftReader reader(chunk_buf_ + chunk_pos_, chunk_len_ - chunk_pos_);
+    if (OB_UNLIKELY(chunk_pos_ >= chunk_len_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("unexpected end of parquet column chunk", K(ret), K_(chunk_len));
+    } else if (OB_FAIL(header.deserialize(reader))) {
+      LOG_WARN("fail to deserialize page header", K(ret), K_(chunk_pos));
+    } else if (OB_UNLIKELY(header.compressed_page_size_ < 0 || header.uncompressed_page_size_ < 0
+                           || header.num_values_ < 0
+                           || header.compressed_page_size_ > chunk_len_ - chunk_pos_ - reader.get_pos())) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid page header", K(ret), K(header), K_(chunk_pos), K_(chunk_len));
+    } else {
+      const char *page = chunk_buf_ + chunk_pos_ + reader.get_pos();
+      const int64_t page_len = header.compressed_page_size_;
+      chunk_pos_ += reader.get_pos() + page_len;
+      if (PARQUET_DICTIONARY_PAGE == header.type_) {
+        const char *data = NULL;
+        if (OB_FAIL(decompress(page, page_len, header.uncompressed_page_size_, data))) {
+          LOG_WARN("fail to decompress dictionary page", K(ret), K(header));
+        } else if (OB_FAIL(load_dictionary(header, data, header.uncompressed_page_size_))) {
+          LOG_WARN("fail to load dictionary", K(ret), K(header));
+        }
+      } else if (PARQUET_DATA_PAGE != header.type_ && PARQUET_DATA_PAGE_V2 != header.type_) {
+        // index pages are not used
+      } else if (skip_rows >= header.num_values_) {
+        skip_rows -= header.num_values_;
+      } else if (PARQUET_DATA_PAGE == header.type_) {
+        // definition levels and values are compressed together, levels are prefixed by length
+        const char *data = NULL;
+        const int64_t len = header.uncompressed_page_size_;
+        const char *levels = NULL;
+        uint32_t levels_len = 0;
+        if (OB_FAIL(decompress(page, page_len, len, data))) {
+          LOG_WARN("fail to decompress data page", K(ret), K(header));
+        } else if (!schema_->is_optional()) {
+        } else if (OB_UNLIKELY(PARQUET_ENCODING_RLE != header.definition_level_encoding_)) {
+          ret = OB_NOT_SUPPORTED;
+          LOG_WARN("definition level encoding not supported", K(ret), K(header));
+          LOG_USER_ERROR(OB_NOT_SUPPORTED, "parquet definition level encoding other than rle");
+        } else if (OB_UNLIKELY(len < static_cast<int64_t>(sizeof(levels_len)))) {
+          ret = OB_INVALID_DATA;
+          LOG_WARN("invalid data page", K(ret), K(header));
+        } else {
+          MEMCPY(&levels_len, data, sizeof(levels_len));
+          levels = data + sizeof(levels_len);
+          if (OB_UNLIKELY(levels_len > len - static_cast<int64_t>(sizeof(levels_len)))) {
+            ret = OB_INVALID_DATA;
+            LOG_WARN("invalid definition levels", K(ret), K(levels_len), K(header));
+          }
+        }
+        if (OB_SUCC(ret)) {
+          const int64_t values_offset = NULL == levels ? 0 : sizeof(levels_len) + levels_len;
+          if (OB_FAIL(init_data_page(header, levels, levels_len,
+                                     data + values_offset, len - values_offset))) {
+            LOG_WARN("fail to init data page", K(ret), K(header));
+          } else {
+            found = true;
+          }
+        }
+      } else {
+        // levels of data page v2 are never compressed
+        const int64_t rep_len = header.repetition_levels_byte_length_;
+        const int64_t def_len = header.definition_levels_byte_length_;
+        const char *values = NULL;
+        int64_t values_len = 0;
+        if (OB_UNLIKELY(rep_len < 0 || def_len < 0 || rep_len + def_len > page_len
+                        || rep_len + def_len > header.uncompressed_page_size_)) {
+          ret = OB_INVALID_DATA;
+          LOG_WARN("invalid data page v2", K(ret), K(header));
+        } else if (header.is_compressed_) {
+          values_len = header.uncompressed_page_size_ - rep_len - def_len;
+          ret = decompress(page + rep_len + def_len, page_len - rep_len - def_len, values_len, values);
+        } else {
+          values_len = page_len - rep_len - def_len;
+          values = page + rep_len + def_len;
+        }
+        if (OB_FAIL(ret)) {
+          LOG_WARN("fail to decompress data page", K(ret), K(header));
+        } else if (OB_FAIL(init_data_page(header, schema_->is_optional() ? page + rep_len : NULL,
+                                          def_len, values, values_len))) {
+          LOG_WARN("fail to init data page", K(ret), K(header));
+        } else {
+          found = true;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::init_data_page(const ObParquetPageHeader &header,
+                                          const char *levels, const int64_t levels_len,
+                                          const char *values, const int64_t values_len)
+{
+  int ret = OB_SUCCESS;
+  page_rows_left_ = header.num_values_;
+  encoding_ = header.encoding_;
+  has_def_levels_ = NULL != levels;
+  values_ = values;
+  values_end_ = values + values_len;
+  bool_bit_pos_ = 0;
+  // the max definition level of flat schemas is 1
+  if (has_def_levels_ && OB_FAIL(def_decoder_.init(levels, levels_len, 1))) {
+    LOG_WARN("fail to init definition level decoder", K(ret));
+  } else {
+    switch (encoding_) {
+      case PARQUET_ENCODING_PLAIN:
+        break;
+      case PARQUET_ENCODING_PLAIN_DICTIONARY:
+      case PARQUET_ENCODING_RLE_DICTIONARY:
+        // bit width of the indices, then the indices in the hybrid encoding
+        if (0 == values_len) {
+          ret = value_decoder_.init(values, 0, 0);
+        } else {
+          ret = value_decoder_.init(values + 1, values_len - 1, static_cast<uint8_t>(values[0]));
+        }
+        break;
+      case PARQUET_ENCODING_RLE: {
+        uint32_t len = 0;
+        if (OB_UNLIKELY(PARQUET_BOOLEAN != schema_->physical_type_)) {
+          ret = OB_NOT_SUPPORTED;
+          LOG_WARN("rle encoding of non-boolean values", K(ret), KPC_(schema));
+          LOG_USER_ERROR(OB_NOT_SUPPORTED, "parquet rle encoding of non-boolean values");
+        } else if (0 == values_len) {
+          ret = value_decoder_.init(values, 0, 1);
+        } else if (OB_UNLIKELY(values_len < static_cast<int64_t>(sizeof(len)))) {
+          ret = OB_INVALID_DATA;
+          LOG_WARN("invalid rle values", K(ret), K(values_len));
+        } else {
+          MEMCPY(&len, values, sizeof(len));
+          ret = value_decoder_.init(values + sizeof(len),
+                                    MIN(static_cast<int64_t>(len), values_len - static_cast<int64_t>(sizeof(len))), 1);
+        }
+        break;
+      }
+      default:
+        ret = OB_NOT_SUPPORTED;
+        LOG_WARN("parquet encoding not supported", K(ret), K_(encoding), KPC_(schema));
+        LOG_USER_ERROR(OB_NOT_SUPPORTED, "parquet encoding other than plain, dictionary and rle");
+        break;
+    }
+    if (OB_FAIL(ret)) {
+      LOG_WARN("fail to init data page", K(ret), K(header));
+    }
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::load_dictionary(const ObParquetPageHeader &header,
+                                           const char *buf, const int64_t len)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = header.num_values_;
+  const char *pos = buf;
+  void *mem = NULL;
+  dict_cnt_ = 0;
+  bool_bit_pos_ = 0;
+  if (0 == cnt) {
+  } else if (is_string_physical_type(schema_->physical_type_)) {
+    if (OB_ISNULL(mem = allocator_->alloc(sizeof(ObString) * cnt))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory", K(ret), K(cnt));
+    } else {
+      dict_strs_ = new (mem) ObString[cnt];
+      ret = decode_plain(cnt, pos, buf + len, NULL, dict_strs_);
+    }
+  } else {
+    if (OB_ISNULL(dict_fixed_ = static_cast<int64_t *>(allocator_->alloc(sizeof(int64_t) * cnt)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory", K(ret), K(cnt));
+    } else {
+      ret = decode_plain(cnt, pos, buf + len, dict_fixed_, NULL);
+    }
+  }
+  if (OB_FAIL(ret)) {
+    LOG_WARN("fail to decode dictionary", K(ret), K(header));
+  } else {
+    dict_cnt_ = cnt;
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::decode_plain(const int64_t cnt, const char *&pos, const char *end,
+                                        int64_t *fixed, ObString *strs)
+{
+  int ret = OB_SUCCESS;
+  int64_t value_size = 0;
+  switch (schema_->physical_type_) {
+    case PARQUET_BOOLEAN:
+      // booleans are bit-packed, pos is kept at the start of the values
+      if (OB_UNLIKELY((bool_bit_pos_ + cnt + 7) / 8 > end - pos)) {
+        ret = OB_INVALID_DATA;
+      } else {
+        for (int64_t i = 0; i < cnt; i++, bool_bit_pos_++) {
+          fixed[i] = (static_cast<uint8_t>(pos[bool_bit_pos_ >> 3]) >> (bool_bit_pos_ & 7)) & 1;
+        }
+      }
+      break;
+    case PARQUET_INT32:
+      if (OB_UNLIKELY(cnt * 4 > end - pos)) {
+        ret = OB_INVALID_DATA;
+      } else {
+        for (int64_t i = 0; i < cnt; i++, pos += 4) {
+          int32_t v = 0;
+          MEMCPY(&v, pos, 4);
+          fixed[i] = v;
+        }
+      }
+      break;
+    case PARQUET_INT64:
+    case PARQUET_DOUBLE:
+      if (OB_UNLIKELY(cnt * 8 > end - pos)) {
+        ret = OB_INVALID_DATA;
+      } else {
+        MEMCPY(fixed, pos, cnt * 8);
+        pos += cnt * 8;
+      }
+      break;
+    case PARQUET_FLOAT:
+      if (OB_UNLIKELY(cnt * 4 > end - pos)) {
+        ret = OB_INVALID_DATA;
+      } else {
+        for (int64_t i = 0; i < cnt; i++, pos += 4) {
+          float f = 0;
+          MEMCPY(&f, pos, 4);
+          const double d = f;
+          MEMCPY(fixed + i, &d, sizeof(d));
+        }
+      }
+      break;
+    case PARQUET_INT96:
+    case PARQUET_FIXED_LEN_BYTE_ARRAY:
+      value_size = PARQUET_INT96 == schema_->physical_type_ ? 12 : schema_->type_length_;
+      if (OB_UNLIKELY(value_size <= 0 || cnt * value_size > end - pos)) {
+        ret = OB_INVALID_DATA;
+      } else {
+        for (int64_t i = 0; i < cnt; i++, pos += value_size) {
+          strs[i].assign_ptr(pos, static_cast<int32_t>(value_size));
+        }
+      }
+      break;
+    case PARQUET_BYTE_ARRAY:
+      for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+        uint32_t len = 0;
+        if (OB_UNLIKELY(end - pos < static_cast<int64_t>(sizeof(len)))) {
+          ret = OB_INVALID_DATA;
+        } else {
+          MEMCPY(&len, pos, sizeof(len));
+          pos += sizeof(len);
+          if (OB_UNLIKELY(len > end - pos)) {
+            ret = OB_INVALID_DATA;
+          } else {
+            strs[i].assign_ptr(pos, static_cast<int32_t>(len));
+            pos += len;
+          }
+        }
+      }
+      break;
+    default:
+      ret = OB_INVALID_DATA;
+      break;
+  }
+  if (OB_FAIL(ret)) {
+    LOG_WARN("fail to decode plain values", K(ret), K(cnt), KPC_(schema), K(end - pos));
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::decode_values(const int64_t cnt, ObParquetValueBatch &batch,
+                                         const int64_t offset)
+{
+  int ret = OB_SUCCESS;
+  int64_t *fixed = batch.fixed_ + offset;
+  ObString *strs = batch.strs_ + offset;
+  uint32_t *indices = batch.buf_ + offset;
+  switch (encoding_) {
+    case PARQUET_ENCODING_PLAIN:
+      ret = decode_plain(cnt, values_, values_end_, fixed, strs);
+      break;
+    case PARQUET_ENCODING_PLAIN_DICTIONARY:
+    case PARQUET_ENCODING_RLE_DICTIONARY:
+      if (OB_FAIL(value_decoder_.get_batch(indices, cnt))) {
+        LOG_WARN("fail to decode dictionary indices", K(ret));
+      } else {
+        const bool is_string = is_string_physical_type(schema_->physical_type_);
+        for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+          if (OB_UNLIKELY(indices[i] >= dict_cnt_)) {
+            ret = OB_INVALID_DATA;
+            LOG_WARN("invalid dictionary index", K(ret), K(indices[i]), K_(dict_cnt));
+          } else if (is_string) {
+            strs[i] = dict_strs_[indices[i]];
+          } else {
+            fixed[i] = dict_fixed_[indices[i]];
+          }
+        }
+      }
+      break;
+    case PARQUET_ENCODING_RLE:
+      if (OB_FAIL(value_decoder_.get_batch(indices, cnt))) {
+        LOG_WARN("fail to decode rle booleans", K(ret));
+      } else {
+        for (int64_t i = 0; i < cnt; i++) {
+          fixed[i] = indices[i] & 1;
+        }
+      }
+      break;
+    default:
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected encoding", K(ret), K_(encoding));
+      break;
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::read(const int64_t row_cnt, ObParquetValueBatch &batch)
+{
+  int ret = OB_SUCCESS;
+  const bool is_string = is_string_physical_type(schema_->physical_type_);
+  int64_t no_skip = 0;
+  for (int64_t done = 0; OB_SUCC(ret) && done < row_cnt; ) {
+    if (0 == page_rows_left_) {
+      if (OB_FAIL(next_page(no_skip))) {
+        LOG_WARN("fail to read next page", K(ret));
+      }
+    } else {
+      const int64_t cnt = MIN(row_cnt - done, page_rows_left_);
+      bool *nulls = batch.nulls_ + done;
+      int64_t value_cnt = cnt;
+      if (!has_def_levels_) {
+        MEMSET(nulls, 0, sizeof(bool) * cnt);
+      } else if (OB_FAIL(def_decoder_.get_batch(batch.buf_ + done, cnt))) {
+        LOG_WARN("fail to decode definition levels", K(ret));
+      } else {
+        value_cnt = 0;
+        for (int64_t i = 0; i < cnt; i++) {
+          nulls[i] = 0 == batch.buf_[done + i];
+          value_cnt += !nulls[i];
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_FAIL(decode_values(value_cnt, batch, done))) {
+        LOG_WARN("fail to decode values", K(ret), K(value_cnt));
+      } else {
+        // values are decoded contiguously, move them to their rows from the back
+        int64_t src = done + value_cnt - 1;
+        for (int64_t dst = done + cnt - 1; dst > src; dst--) {
+          if (!batch.nulls_[dst]) {
+            if (is_string) {
+              batch.strs_[dst] = batch.strs_[src];
+            } else {
+              batch.fixed_[dst] = batch.fixed_[src];
+            }
+            src--;
+          }
+        }
+        page_rows_left_ -= cnt;
+        done += cnt;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::skip(const int64_t row_cnt, ObParquetValueBatch &batch)
+{
+  int ret = OB_SUCCESS;
+  int64_t rows_left = row_cnt;
+  while (OB_SUCC(ret) && rows_left > 0) {
+    if (0 == page_rows_left_) {
+      // pages whose rows are all skipped are not decoded
+      if (OB_FAIL(next_page(rows_left))) {
+        LOG_WARN("fail to read next page", K(ret));
+      }
+    } else {
+      const int64_t cnt = MIN(MIN(rows_left, page_rows_left_), batch.capacity_);
+      if (OB_FAIL(read(cnt, batch))) {
+        LOG_WARN("fail to read rows", K(ret), K(cnt));
+      } else {
+        rows_left -= cnt;
+      }
+    }
+  }
+  return ret;
+}
+
+template <typename T>
+static bool is_never_true(const ObItemType op, const T &min, const T &max, const T &value)
+{
+  bool never_true = false;
+  switch (op) {
+    case T_OP_EQ:
+      never_true = value < min || value > max;
+      break;
+    case T_OP_LT:
+      never_true = min >= value;
+      break;
+    case T_OP_LE:
+      never_true = min > value;
+      break;
+    case T_OP_GT:
+      never_true = max <= value;
+      break;
+    case T_OP_GE:
+      never_true = max < value;
+      break;
+    default:
+      break;
+  }
+  return never_true;
+}
+
+static bool decode_stat_value(const ObParquetPhysicalType type, const ObString &str,
+                              int64_t &int_value, double &double_value)
+{
+  bool valid = true;
+  if (PARQUET_BOOLEAN == type && 1 == str.length()) {
+    int_value = static_cast<uint8_t>(str.ptr()[0]) & 1;
+  } else if (PARQUET_INT32 == type && 4 == str.length()) {
+    int32_t v = 0;
+    MEMCPY(&v, str.ptr(), 4);
+    int_value = v;
+  } else if (PARQUET_INT64 == type && 8 == str.length()) {
+    MEMCPY(&int_value, str.ptr(), 8);
+  } else if (PARQUET_FLOAT == type && 4 == str.length()) {
+    float v = 0;
+    MEMCPY(&v, str.ptr(), 4);
+    double_value = v;
+  } else if (PARQUET_DOUBLE == type && 8 == str.length()) {
+    MEMCPY(&double_value, str.ptr(), 8);
+  } else {
+    valid = false;
+  }
+  return valid;
+}
+
+static ObParquetTableRowIterator::DirectType get_direct_type(const ObParquetColumnSchema &schema,
+                                                             const ObDatumMeta &meta)
+{
+  ObParquetTableRowIterator::DirectType type = ObParquetTableRowIterator::DIRECT_NONE;
+  const ObParquetPhysicalType physical_type = schema.physical_type_;
+  const bool no_logical_type = PARQUET_LOGICAL_NONE == schema.logical_type_;
+  switch (meta.type_) {
+    case ObIntType:
+      if (no_logical_type && (PARQUET_INT64 == physical_type || PARQUET_INT32 == physical_type
+                              || PARQUET_BOOLEAN == physical_type)) {
+        type = ObParquetTableRowIterator::DIRECT_INT;
+      }
+      break;
+    case ObInt32Type:
+      if (no_logical_type && (PARQUET_INT32 == physical_type || PARQUET_BOOLEAN == physical_type)) {
+        type = ObParquetTableRowIterator::DIRECT_INT;
+      }
+      break;
+    case ObTinyIntType:
+      if (PARQUET_BOOLEAN == physical_type) {
+        type = ObParquetTableRowIterator::DIRECT_INT;
+      }
+      break;
+    case ObDoubleType:
+      if (meta.scale_ < 0 && (PARQUET_DOUBLE == physical_type || PARQUET_FLOAT == physical_type)) {
+        type = ObParquetTableRowIterator::DIRECT_DOUBLE;
+      }
+      break;
+    case ObFloatType:
+      if (meta.scale_ < 0 && PARQUET_FLOAT == physical_type) {
+        type = ObParquetTableRowIterator::DIRECT_FLOAT;
+      }
+      break;
+    case ObDateType:
+      if (PARQUET_INT32 == physical_type && PARQUET_LOGICAL_DATE == schema.logical_type_) {
+        type = ObParquetTableRowIterator::DIRECT_DATE;
+      }
+      break;
+    case ObDateTimeType:
+      if (PARQUET_INT64 == physical_type && MAX_SCALE_FOR_TEMPORAL == meta.scale_) {
+        if (PARQUET_LOGICAL_TIMESTAMP_MILLIS == schema.logical_type_) {
+          type = ObParquetTableRowIterator::DIRECT_DATETIME_MILLIS;
+        } else if (PARQUET_LOGICAL_TIMESTAMP_MICROS == schema.logical_type_) {
+          type = ObParquetTableRowIterator::DIRECT_DATETIME_MICROS;
+        }
+      }
+      break;
+    default:
+      break;
+  }
+  return type;
+}
+
+// unscaled_value * 10^-scale
+static int format_decimal(const __int128_t unscaled_value, const int64_t scale,
+                          char *buf, const int64_t buf_len, int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  char digits[PARQUET_MAX_DECIMAL_SCALE + 4];
+  int64_t digit_cnt = 0;
+  unsigned __int128 v = unscaled_value < 0 ? -static_cast<unsigned __int128>(unscaled_value)
+                                           : static_cast<unsigned __int128>(unscaled_value);
+  if (OB_UNLIKELY(scale < 0 || scale > PARQUET_MAX_DECIMAL_SCALE)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid decimal scale", K(ret), K(scale));
+  } else {
+    do {
+      digits[digit_cnt++] = static_cast<char>('0' + static_cast<int>(v % 10));
+      v /= 10;
+    } while (v > 0);
+    while (digit_cnt <= scale) {
+      digits[digit_cnt++] = '0';
+    }
+    if (OB_UNLIKELY(pos + digit_cnt + 2 > buf_len)) {
+      ret = OB_SIZE_OVERFLOW;
+      LOG_WARN("buffer not enough", K(ret), K(digit_cnt), K(buf_len));
+    } else {
+      if (unscaled_value < 0) {
+        buf[pos++] = '-';
+      }
+      for (int64_t i = digit_cnt - 1; i >= 0; i--) {
+        buf[pos++] = digits[i];
+        if (i == scale && scale > 0) {
+          buf[pos++] = '.';
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+static int format_parquet_value(const ObParquetColumnSchema &schema, const ObParquetValueBatch &batch,
+                                const int64_t idx, char *buf, const int64_t buf_len, int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  const int64_t v = batch.fixed_[idx];
+  pos = 0;
+  switch (schema.physical_type_) {
+    case PARQUET_BOOLEAN:
+      buf[pos++] = v ? '1' : '0';
+      break;
+    case PARQUET_INT32:
+    case PARQUET_INT64:
+      if (PARQUET_LOGICAL_DECIMAL == schema.logical_type_) {
+        ret = format_decimal(v, schema.scale_, buf, buf_len, pos);
+      } else if (PARQUET_LOGICAL_DATE == schema.logical_type_) {
+        ret = ObTimeConverter::date_to_str(static_cast<int32_t>(v), buf, buf_len, pos);
+      } else if (PARQUET_LOGICAL_TIMESTAMP_MILLIS == schema.logical_type_
+                 || PARQUET_LOGICAL_TIMESTAMP_MICROS == schema.logical_type_
+                 || PARQUET_LOGICAL_TIMESTAMP_NANOS == schema.logical_type_) {
+        const int64_t usec = PARQUET_LOGICAL_TIMESTAMP_MILLIS == schema.logical_type_ ? v * 1000
+            : (PARQUET_LOGICAL_TIMESTAMP_MICROS == schema.logical_type_ ? v : v / 1000);
+        ret = ObTimeConverter::datetime_to_str(usec, NULL, ObString(), MAX_SCALE_FOR_TEMPORAL,
+                                               buf, buf_len, pos);
+      } else {
+        const bool is_unsigned = PARQUET_LOGICAL_UNSIGNED == schema.logical_type_;
+        ObFastFormatInt ffi(PARQUET_INT32 == schema.physical_type_ && is_unsigned
+                            ? static_cast<int64_t>(static_cast<uint32_t>(v)) : v,
+                            is_unsigned);
+        MEMCPY(buf, ffi.ptr(), ffi.length());
+        pos = ffi.length();
+      }
+      break;
+    case PARQUET_FLOAT:
+      pos = ob_gcvt(batch.get_double(idx), OB_GCVT_ARG_FLOAT, static_cast<int>(buf_len - 1), buf, NULL);
+      break;
+    case PARQUET_DOUBLE:
+      pos = ob_gcvt(batch.get_double(idx), OB_GCVT_ARG_DOUBLE, static_cast<int>(buf_len - 1), buf, NULL);
+      break;
+    case PARQUET_INT96: {
+      // nanoseconds of the day and the julian day
+      const ObString &str = batch.strs_[idx];
+      int64_t nanos = 0;
+      int32_t julian_day = 0;
+      MEMCPY(&nanos, str.ptr(), sizeof(nanos));
+      MEMCPY(&julian_day, str.ptr() + sizeof(nanos), sizeof(julian_day));
+      const int64_t usec = (julian_day - JULIAN_DAY_OF_EPOCH) * PARQUET_USECS_PER_DAY + nanos / 1000;
+      ret = ObTimeConverter::datetime_to_str(usec, NULL, ObString(), MAX_SCALE_FOR_TEMPORAL,
+                                             buf, buf_len, pos);
+      break;
+    }
+    case PARQUET_BYTE_ARRAY:
+    case PARQUET_FIXED_LEN_BYTE_ARRAY: {
+      // decimals in big-endian two's complement
+      const ObString &str = batch.strs_[idx];
+      if (OB_UNLIKELY(str.length() <= 0 || str.length() > PARQUET_MAX_DECIMAL_BYTES)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("invalid decimal value", K(ret), K(str.length()));
+      } else {
+        unsigned __int128 u = (str.ptr()[0] & 0x80) ? ~static_cast<unsigned __int128>(0) : 0;
+        for (int64_t i = 0; i < str.length(); i++) {
+          u = (u << 8) | static_cast<uint8_t>(str.ptr()[i]);
+        }
+        ret = format_decimal(static_cast<__int128_t>(u), schema.scale_, buf, buf_len, pos);
+      }
+      break;
+    }
+    default:
+      ret = OB_ERR_UNEXPECTED;
+      break;
+  }
+  if (OB_FAIL(ret)) {
+    LOG_WARN("fail to format parquet value", K(ret), K(schema));
+  }
+  return ret;
+}
+
+ObParquetTableRowIterator::ObParquetTableRowIterator()
+  : allocator_(),
+    file_allocator_(),
+    row_group_allocator_(),
+    text_allocator_(),
+    bit_vector_cache_(NULL),
+    data_access_driver_(),
+    url_(),
+    meta_(),
+    line_number_expr_(NULL),
+    file_id_expr_(NULL),
+    batch_capacity_(0),
+    file_idx_(0),
+    file_opened_(false),
+    cur_file_id_(ObCSVTableRowIterator::MIN_EXTERNAL_TABLE_FILE_ID),
+    start_row_(ObCSVTableRowIterator::MIN_EXTERNAL_TABLE_LINE_NUMBER),
+    end_row_(INT64_MAX),
+    row_group_idx_(0),
+    row_group_first_row_(0),
+    row_group_rows_left_(0),
+    cur_row_number_(ObCSVTableRowIterator::MIN_EXTERNAL_TABLE_LINE_NUMBER)
+{
+}
+
+ObParquetTableRowIterator::~ObParquetTableRowIterator()
+{
+  close_file();
+  for (int64_t i = 0; i < readers_.count(); i++) {
+    if (OB_NOT_NULL(readers_.at(i))) {
+      readers_.at(i)->~ObParquetColumnReader();
+      allocator_.free(readers_.at(i));
+    }
+  }
+  for (int64_t i = 0; i < batches_.count(); i++) {
+    ObParquetValueBatch &batch = batches_.at(i);
+    allocator_.free(batch.nulls_);
+    allocator_.free(batch.fixed_);
+    allocator_.free(batch.strs_);
+    allocator_.free(batch.buf_);
+  }
+  if (OB_NOT_NULL(bit_vector_cache_)) {
+    allocator_.free(bit_vector_cache_);
+  }
+}
+
+int ObParquetTableRowIterator::init_exprs(const storage::ObTableScanParam *scan_param)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(scan_param)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("scan param is null", K(ret));
+  } else if (scan_param->column_ids_.count() != scan_param->output_exprs_->count()) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("column ids not equal to access expr", K(ret));
+  }
+  for (int i = 0; OB_SUCC(ret) && i < scan_param->column_ids_.count(); i++) {
+    ObExpr *cur_expr = scan_param->output_exprs_->at(i);
+    switch (scan_param->column_ids_.at(i)) {
+      case OB_HIDDEN_LINE_NUMBER_COLUMN_ID:
+        line_number_expr_ = cur_expr;
+        break;
+      case OB_HIDDEN_FILE_ID_COLUMN_ID:
+        file_id_expr_ = cur_expr;
+        break;
+      default:
+        OZ (column_exprs_.push_back(cur_expr));
+        break;
+    }
+  }
+  if (OB_SUCC(ret) && column_exprs_.count() != scan_param->ext_column_convert_exprs_->count()) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("column expr not equal to convert convert expr", K(ret),
+             K(column_exprs_), KPC(scan_param->ext_column_convert_exprs_));
+  }
+  // a column may be decoded directly if its value is a file column or a cast of it
+  for (int64_t i = 0; OB_SUCC(ret) && i < column_exprs_.count(); i++) {
+    const ObExpr *convert_expr = scan_param->ext_column_convert_exprs_->at(i);
+    const ObExpr *value_expr = (OB_NOT_NULL(convert_expr) && convert_expr->arg_cnt_ > 4)
+                               ? convert_expr->args_[4] : NULL;
+    if (OB_NOT_NULL(value_expr) && T_FUN_SYS_CAST == value_expr->type_ && value_expr->arg_cnt_ > 0) {
+      value_expr = value_expr->args_[0];
+    }
+    OZ (direct_file_columns_.push_back(find_file_column(value_expr)));
+  }
+  return ret;
+}
+
+int64_t ObParquetTableRowIterator::find_file_column(const ObExpr *expr) const
+{
+  int64_t idx = -1;
+  const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+  for (int64_t i = 0; NULL != expr && -1 == idx && i < file_column_exprs.count(); i++) {
+    if (file_column_exprs.at(i) == expr) {
+      idx = i;
+    }
+  }
+  return idx;
+}
+
+int ObParquetTableRowIterator::init_pushdown_filters(const storage::ObTableScanParam *scan_param)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && OB_NOT_NULL(scan_param->op_filters_)
+                      && i < scan_param->op_filters_->count(); i++) {
+    const ObExpr *filter = scan_param->op_filters_->at(i);
+    PushdownFilter pd_filter;
+    pd_filter.op_ = OB_NOT_NULL(filter) ? filter->type_ : T_INVALID;
+    pd_filter.column_idx_ = -1;
+    pd_filter.const_expr_ = NULL;
+    if ((T_OP_EQ == pd_filter.op_ || T_OP_LT == pd_filter.op_ || T_OP_LE == pd_filter.op_
+         || T_OP_GT == pd_filter.op_ || T_OP_GE == pd_filter.op_) && 2 == filter->arg_cnt_) {
+      for (int64_t j = 0; -1 == pd_filter.column_idx_ && j < column_exprs_.count(); j++) {
+        if (column_exprs_.at(j) == filter->args_[0] && filter->args_[1]->is_const_expr()) {
+          pd_filter.column_idx_ = j;
+          pd_filter.const_expr_ = filter->args_[1];
+        } else if (column_exprs_.at(j) == filter->args_[1] && filter->args_[0]->is_const_expr()) {
+          // const op column, swap to column op const
+          pd_filter.column_idx_ = j;
+          pd_filter.const_expr_ = filter->args_[0];
+          pd_filter.op_ = T_OP_LT == pd_filter.op_ ? T_OP_GT
+              : (T_OP_LE == pd_filter.op_ ? T_OP_GE
+              : (T_OP_GT == pd_filter.op_ ? T_OP_LT
+              : (T_OP_GE == pd_filter.op_ ? T_OP_LE : pd_filter.op_)));
+        }
+      }
+      if (pd_filter.column_idx_ >= 0
+          && direct_file_columns_.at(pd_filter.column_idx_) >= 0
+          && ob_obj_type_class(pd_filter.const_expr_->datum_meta_.type_)
+             == ob_obj_type_class(column_exprs_.at(pd_filter.column_idx_)->datum_meta_.type_)) {
+        OZ (filters_.push_back(pd_filter));
+      }
+    }
+  }
+  LOG_DEBUG("parquet pushdown filters", K(ret), K_(filters));
+  return ret;
+}
+
+int ObParquetTableRowIterator::init(const storage::ObTableScanParam *scan_param)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(scan_param)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("scan param is null", K(ret));
+  } else {
+    allocator_.set_attr(lib::ObMemAttr(scan_param->tenant_id_, "ParquetRowIter"));
+    file_allocator_.set_attr(lib::ObMemAttr(scan_param->tenant_id_, "ParquetMeta"));
+    row_group_allocator_.set_attr(lib::ObMemAttr(scan_param->tenant_id_, "ParquetData"));
+    text_allocator_.set_attr(lib::ObMemAttr(scan_param->tenant_id_, "ParquetText"));
+    batch_capacity_ = MAX(1, scan_param->op_->get_eval_ctx().max_batch_size_);
+    OZ (ObExternalTableRowIterator::init(scan_param));
+    OZ (init_exprs(scan_param));
+    OZ (data_access_driver_.init(scan_param_->external_file_location_, scan_param->external_file_access_info_));
+    const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+    for (int64_t i = 0; OB_SUCC(ret) && i < file_column_exprs.count(); i++) {
+      ObParquetColumnReader *reader = NULL;
+      ObParquetValueBatch batch;
+      if (OB_ISNULL(reader = OB_NEWx(ObParquetColumnReader, (&allocator_)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret));
+      } else if (OB_FAIL(readers_.push_back(reader))) {
+        reader->~ObParquetColumnReader();
+        allocator_.free(reader);
+        LOG_WARN("fail to push back", K(ret));
+      } else if (OB_FAIL(batch.init(batch_capacity_, allocator_))) {
+        LOG_WARN("fail to init value batch", K(ret));
+      } else if (OB_FAIL(batches_.push_back(batch))) {
+        LOG_WARN("fail to push back", K(ret));
+      }
+      OZ (need_texts_.push_back(false));
+      OZ (need_reads_.push_back(false));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_exprs_.count(); i++) {
+      OZ (direct_types_.push_back(DIRECT_NONE));
+    }
+    OZ (init_pushdown_filters(scan_param));
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::read_file_meta(const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  // file: magic, column chunks, metadata, metadata length (4 bytes), magic
+  const int64_t footer_size = ObParquetFileMeta::FOOTER_SIZE;
+  const int64_t magic_size = footer_size - static_cast<int64_t>(sizeof(uint32_t));
+  char footer[ObParquetFileMeta::FOOTER_SIZE];
+  uint32_t meta_len = 0;
+  char *meta_buf = NULL;
+  if (OB_UNLIKELY(file_size < footer_size + magic_size)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("file too small to be a parquet file", K(ret), K(file_size), K_(url));
+  } else if (OB_FAIL(pread_fully(data_access_driver_, footer, footer_size, file_size - footer_size))) {
+    LOG_WARN("fail to read parquet footer", K(ret), K_(url));
+  } else if (OB_UNLIKELY(0 != MEMCMP(footer + sizeof(meta_len), ObParquetFileMeta::MAGIC, magic_size))) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("not a parquet file", K(ret), K_(url));
+  } else {
+    MEMCPY(&meta_len, footer, sizeof(meta_len));
+    if (OB_UNLIKELY(0 == meta_len || meta_len > file_size - footer_size - magic_size)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid parquet metadata length", K(ret), K(meta_len), K(file_size), K_(url));
+    } else if (OB_ISNULL(meta_buf = static_cast<char *>(file_allocator_.alloc(meta_len)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory", K(ret), K(meta_len));
+    } else if (OB_FAIL(pread_fully(data_access_driver_, meta_buf, meta_len,
+                                   file_size - footer_size - meta_len))) {
+      LOG_WARN("fail to read parquet metadata", K(ret), K_(url));
+    } else if (OB_FAIL(meta_.deserialize(meta_buf, meta_len, file_allocator_))) {
+      LOG_WARN("fail to deserialize parquet metadata", K(ret), K_(url));
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::mark_text_file_columns(const ObExpr *expr)
+{
+  int ret = OB_SUCCESS;
+  int64_t idx = -1;
+  if (OB_ISNULL(expr)) {
+  } else if ((idx = find_file_column(expr)) >= 0) {
+    need_texts_.at(idx) = true;
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < expr->arg_cnt_; i++) {
+      OZ (SMART_CALL(mark_text_file_columns(expr->args_[i])));
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::prepare_file_columns()
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+  for (int64_t i = 0; i < file_column_exprs.count(); i++) {
+    need_texts_.at(i) = false;
+    need_reads_.at(i) = false;
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < column_exprs_.count(); i++) {
+    const int64_t file_column_idx = direct_file_columns_.at(i);
+    const int64_t loc_idx = file_column_idx >= 0 ? file_column_exprs.at(file_column_idx)->extra_ - 1 : -1;
+    DirectType type = DIRECT_NONE;
+    if (loc_idx >= 0 && loc_idx < meta_.columns_.count()) {
+      type = get_direct_type(meta_.columns_.at(loc_idx), column_exprs_.at(i)->datum_meta_);
+    }
+    direct_types_.at(i) = type;
+    if (DIRECT_NONE != type) {
+      need_reads_.at(file_column_idx) = true;
+    } else {
+      OZ (mark_text_file_columns(scan_param_->ext_column_convert_exprs_->at(i)));
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < file_column_exprs.count(); i++) {
+    const int64_t loc_idx = file_column_exprs.at(i)->extra_ - 1;
+    // file columns beyond the columns of the file are NULL
+    need_reads_.at(i) = (need_reads_.at(i) || need_texts_.at(i))
+                        && loc_idx >= 0 && loc_idx < meta_.columns_.count();
+  }
+  LOG_DEBUG("prepare parquet file columns", K(ret), K_(direct_types), K_(need_texts), K_(need_reads));
+  return ret;
+}
+
+int ObParquetTableRowIterator::open_next_file()
+{
+  int ret = OB_SUCCESS;
+  ObString location = scan_param_->external_file_location_;
+  int64_t file_size = 0;
+
+  close_file();
+
+  do {
+    ObString file_url;
+    const int64_t task_idx = file_idx_++;
+    url_.reuse();
+    if (task_idx >= scan_param_->key_ranges_.count()) {
+      ret = OB_ITER_END;
+    } else if (OB_FAIL(ObExternalTableUtils::resolve_line_number_range(
+                                                              scan_param_->key_ranges_.at(task_idx),
+                                                              ObExternalTableUtils::LINE_NUMBER,
+                                                              start_row_,
+                                                              end_row_))) {
+      LOG_WARN("failed to resolve range in external table", K(ret));
+    } else {
+      file_url = scan_param_->key_ranges_.at(task_idx).get_start_key().get_obj_ptr()[ObExternalTableUtils::FILE_URL].get_string();
+      cur_file_id_ = scan_param_->key_ranges_.at(task_idx).get_start_key().get_obj_ptr()[ObExternalTableUtils::FILE_ID].get_int();
+      const char *split_char = "/";
+      OZ (url_.append_fmt("%.*s%s%.*s", location.length(), location.ptr(),
+                                        (location.empty() || location[location.length() - 1] == '/') ? "" : split_char,
+                                        file_url.length(), file_url.ptr()));
+      OZ (data_access_driver_.get_file_size(url_.string(), file_size));
+    }
+    LOG_DEBUG("try next file", K(ret), K(url_), K(file_url), K(file_size));
+  } while (OB_SUCC(ret) && 0 >= file_size); //skip empty file
+  OZ (data_access_driver_.open(url_.string()), url_);
+  OZ (read_file_meta(file_size));
+  OZ (prepare_file_columns());
+  if (OB_SUCC(ret)) {
+    file_opened_ = true;
+    row_group_idx_ = 0;
+    row_group_first_row_ = 0;
+    row_group_rows_left_ = 0;
+  }
+
+  LOG_DEBUG("open external file", K(ret), K(url_), K(file_size), K(location), K_(meta));
+
+  return ret;
+}
+
+bool ObParquetTableRowIterator::is_never_true_by_stat(const DirectType type,
+                                                      const ObItemType op,
+                                                      const ObParquetPhysicalType physical_type,
+                                                      const ObParquetStatistics &stat,
+                                                      const int64_t row_cnt,
+                                                      const ObDatum &value)
+{
+  bool never_true = false;
+  int64_t int_min = 0;
+  int64_t int_max = 0;
+  double double_min = 0;
+  double double_max = 0;
+  if (DIRECT_NONE == type || value.is_null()) {
+    // no statistics of the column type in this file
+  } else if (stat.has_null_count_ && stat.null_count_ >= row_cnt) {
+    // compares with NULL are never true
+    never_true = true;
+  } else if (!stat.has_min_max()
+             || !decode_stat_value(physical_type, stat.min_, int_min, double_min)
+             || !decode_stat_value(physical_type, stat.max_, int_max, double_max)) {
+  } else {
+    switch (type) {
+      case DIRECT_INT:
+        never_true = is_never_true(op, int_min, int_max, value.get_int());
+        break;
+      case DIRECT_DATE:
+        never_true = is_never_true(op, int_min, int_max, static_cast<int64_t>(value.get_date()));
+        break;
+      case DIRECT_DATETIME_MILLIS:
+        never_true = is_never_true(op, int_min * 1000, int_max * 1000, value.get_datetime());
+        break;
+      case DIRECT_DATETIME_MICROS:
+        never_true = is_never_true(op, int_min, int_max, value.get_datetime());
+        break;
+      case DIRECT_FLOAT:
+        never_true = is_never_true(op, double_min, double_max, static_cast<double>(value.get_float()));
+        break;
+      case DIRECT_DOUBLE:
+        never_true = is_never_true(op, double_min, double_max, value.get_double());
+        break;
+      default:
+        break;
+    }
+  }
+  return never_true;
+}
+
+int ObParquetTableRowIterator::can_skip_row_group(const ObParquetRowGroupMeta &row_group,
+                                                  bool &can_skip)
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+  can_skip = false;
+  for (int64_t i = 0; OB_SUCC(ret) && !can_skip && i < filters_.count(); i++) {
+    const PushdownFilter &filter = filters_.at(i);
+    const DirectType type = direct_types_.at(filter.column_idx_);
+    ObDatum *value = NULL;
+    if (DIRECT_NONE == type) {
+      // no statistics of the column type in this file
+    } else if (OB_FAIL(filter.const_expr_->eval(eval_ctx, value))) {
+      LOG_WARN("fail to eval const expr", K(ret), K(filter));
+    } else {
+      const int64_t file_column_idx = direct_file_columns_.at(filter.column_idx_);
+      const int64_t loc_idx = file_column_exprs.at(file_column_idx)->extra_ - 1;
+      can_skip = is_never_true_by_stat(type, filter.op_, meta_.columns_.at(loc_idx).physical_type_,
+                                       row_group.columns_.at(loc_idx).stat_, row_group.num_rows_,
+                                       *value);
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::next_row_group()
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+  const ObParquetRowGroupMeta &row_group = *meta_.row_groups_.at(row_group_idx_++);
+  // rows of the row group in the line number range of the task, 1-based
+  const int64_t first_row = row_group_first_row_ + 1;
+  const int64_t start_row = MAX(first_row, start_row_);
+  const int64_t end_row = MIN(row_group_first_row_ + row_group.num_rows_, end_row_);
+  bool can_skip = start_row > end_row;
+  row_group_first_row_ += row_group.num_rows_;
+  if (first_row > end_row_) {
+    // the following row groups are out of the range too
+    row_group_idx_ = meta_.row_groups_.count();
+  } else if (can_skip) {
+  } else if (OB_FAIL(can_skip_row_group(row_group, can_skip))) {
+    LOG_WARN("fail to check row group", K(ret));
+  } else if (!can_skip) {
+    for (int64_t i = 0; i < readers_.count(); i++) {
+      readers_.at(i)->reset();
+    }
+    row_group_allocator_.reuse();
+    for (int64_t i = 0; OB_SUCC(ret) && i < file_column_exprs.count(); i++) {
+      const int64_t loc_idx = file_column_exprs.at(i)->extra_ - 1;
+      if (!need_reads_.at(i)) {
+      } else if (OB_FAIL(readers_.at(i)->open(data_access_driver_,
+                                              meta_.columns_.at(loc_idx),
+                                              row_group.columns_.at(loc_idx),
+                                              row_group_allocator_))) {
+        LOG_WARN("fail to open column reader", K(ret), K(loc_idx), K_(url));
+      } else if (start_row > first_row
+                 && OB_FAIL(readers_.at(i)->skip(start_row - first_row, batches_.at(i)))) {
+        LOG_WARN("fail to skip rows", K(ret), K(start_row), K(first_row), K_(url));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      row_group_rows_left_ = end_row - start_row + 1;
+      cur_row_number_ = start_row;
+    }
+  }
+  LOG_DEBUG("next parquet row group", K(ret), K_(row_group_idx), K(can_skip),
+            K(start_row), K(end_row), K_(url));
+  return ret;
+}
+
+int ObParquetTableRowIterator::next_batch(const int64_t capacity, int64_t &row_cnt)
+{
+  int ret = OB_SUCCESS;
+  row_cnt = 0;
+  while (OB_SUCC(ret) && 0 == row_group_rows_left_) {
+    if (!file_opened_ || row_group_idx_ >= meta_.row_groups_.count()) {
+      if (OB_FAIL(open_next_file())) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("fail to open next file", K(ret));
+        }
+      }
+    } else if (OB_FAIL(next_row_group())) {
+      LOG_WARN("fail to read next row group", K(ret));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    // a batch never crosses row groups
+    row_cnt = MIN(MIN(capacity, batch_capacity_), row_group_rows_left_);
+    for (int64_t i = 0; OB_SUCC(ret) && i < readers_.count(); i++) {
+      if (need_reads_.at(i) && OB_FAIL(readers_.at(i)->read(row_cnt, batches_.at(i)))) {
+        LOG_WARN("fail to read column", K(ret), K(i), K_(url));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::fill_direct_column(const int64_t column_idx, const int64_t row_cnt,
+                                                  const bool is_batch)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+  ObExpr *column_expr = column_exprs_.at(column_idx);
+  const ObParquetValueBatch &batch = batches_.at(direct_file_columns_.at(column_idx));
+  const DirectType type = direct_types_.at(column_idx);
+  ObDatum *datums = is_batch ? column_expr->locate_datums_for_update(eval_ctx, row_cnt)
+                             : &column_expr->locate_datum_for_write(eval_ctx);
+  for (int64_t i = 0; i < row_cnt; i++) {
+    if (batch.nulls_[i]) {
+      datums[i].set_null();
+    } else {
+      switch (type) {
+        case DIRECT_INT:
+          datums[i].set_int(batch.fixed_[i]);
+          break;
+        case DIRECT_FLOAT:
+          datums[i].set_float(static_cast<float>(batch.get_double(i)));
+          break;
+        case DIRECT_DOUBLE:
+          datums[i].set_double(batch.get_double(i));
+          break;
+        case DIRECT_DATE:
+          datums[i].set_date(static_cast<int32_t>(batch.fixed_[i]));
+          break;
+        case DIRECT_DATETIME_MILLIS:
+          datums[i].set_datetime(batch.fixed_[i] * 1000);
+          break;
+        case DIRECT_DATETIME_MICROS:
+          datums[i].set_datetime(batch.fixed_[i]);
+          break;
+        default:
+          break;
+      }
+    }
+  }
+  column_expr->set_evaluated_flag(eval_ctx);
+  return ret;
+}
+
+int ObParquetTableRowIterator::fill_text_file_column(const int64_t file_column_idx,
+                                                     const int64_t row_cnt, const bool is_batch)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+  ObExpr *expr = scan_param_->ext_file_column_exprs_->at(file_column_idx);
+  ObDatum *datums = is_batch ? expr->locate_batch_datums(eval_ctx)
+                             : &expr->locate_datum_for_write(eval_ctx);
+  if (!need_reads_.at(file_column_idx)) {
+    for (int64_t i = 0; i < row_cnt; i++) {
+      datums[i].set_null();
+    }
+  } else {
+    const ObParquetColumnSchema &schema = meta_.columns_.at(expr->extra_ - 1);
+    const ObParquetValueBatch &batch = batches_.at(file_column_idx);
+    const bool is_oracle_mode = lib::is_oracle_mode();
+    if ((PARQUET_BYTE_ARRAY == schema.physical_type_
+         || PARQUET_FIXED_LEN_BYTE_ARRAY == schema.physical_type_)
+        && PARQUET_LOGICAL_DECIMAL != schema.logical_type_) {
+      // strings reference the pages of the row group
+      for (int64_t i = 0; i < row_cnt; i++) {
+        if (batch.nulls_[i] || (batch.strs_[i].empty() && is_oracle_mode)) {
+          datums[i].set_null();
+        } else {
+          datums[i].set_string(batch.strs_[i]);
+        }
+      }
+    } else {
+      char *buf = NULL;
+      if (OB_ISNULL(buf = static_cast<char *>(text_allocator_.alloc(row_cnt * TEXT_BUF_SIZE_PER_VALUE)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to alloc memory", K(ret), K(row_cnt));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; i++, buf += TEXT_BUF_SIZE_PER_VALUE) {
+        int64_t len = 0;
+        if (batch.nulls_[i]) {
+          datums[i].set_null();
+        } else if (OB_FAIL(format_parquet_value(schema, batch, i, buf, TEXT_BUF_SIZE_PER_VALUE, len))) {
+          LOG_WARN("fail to format value", K(ret), K(i));
+        } else {
+          datums[i].set_string(buf, static_cast<int32_t>(len));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::fill_output(const int64_t row_cnt, const bool is_batch)
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+
+  for (int64_t i = 0; OB_SUCC(ret) && i < file_column_exprs.count(); i++) {
+    if (need_texts_.at(i) && OB_FAIL(fill_text_file_column(i, row_cnt, is_batch))) {
+      LOG_WARN("fail to fill file column", K(ret), K(i));
+    } else {
+      file_column_exprs.at(i)->set_evaluated_flag(eval_ctx);
+    }
+  }
+
+  for (int64_t i = 0; OB_SUCC(ret) && i < column_exprs_.count(); i++) {
+    ObExpr *column_expr = column_exprs_.at(i);
+    ObExpr *column_convert_expr = scan_param_->ext_column_convert_exprs_->at(i);
+    if (DIRECT_NONE != direct_types_.at(i)) {
+      OZ (fill_direct_column(i, row_cnt, is_batch));
+    } else if (is_batch) {
+      OZ (column_convert_expr->eval_batch(eval_ctx, *bit_vector_cache_, row_cnt));
+      if (OB_SUCC(ret)) {
+        MEMCPY(column_expr->locate_batch_datums(eval_ctx),
+               column_convert_expr->locate_batch_datums(eval_ctx), sizeof(ObDatum) * row_cnt);
+        column_expr->set_evaluated_flag(eval_ctx);
+      }
+    } else {
+      ObDatum *convert_datum = NULL;
+      OZ (column_convert_expr->eval(eval_ctx, convert_datum));
+      if (OB_SUCC(ret)) {
+        column_expr->locate_datum_for_write(eval_ctx) = *convert_datum;
+        column_expr->set_evaluated_flag(eval_ctx);
+      }
+    }
+  }
+
+  if (OB_SUCC(ret) && OB_NOT_NULL(file_id_expr_)) {
+    ObDatum *datums = is_batch ? file_id_expr_->locate_batch_datums(eval_ctx)
+                               : &file_id_expr_->locate_datum_for_write(eval_ctx);
+    for (int64_t i = 0; i < row_cnt; i++) {
+      datums[i].set_int(cur_file_id_);
+    }
+    file_id_expr_->set_evaluated_flag(eval_ctx);
+  }
+  if (OB_SUCC(ret) && OB_NOT_NULL(line_number_expr_)) {
+    ObDatum *datums = is_batch ? line_number_expr_->locate_batch_datums(eval_ctx)
+                               : &line_number_expr_->locate_datum_for_write(eval_ctx);
+    for (int64_t i = 0; i < row_cnt; i++) {
+      datums[i].set_int(cur_row_number_ + i);
+    }
+    line_number_expr_->set_evaluated_flag(eval_ctx);
+  }
+  if (OB_SUCC(ret)) {
+    row_group_rows_left_ -= row_cnt;
+    cur_row_number_ += row_cnt;
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::get_next_row()
+{
+  int ret = OB_SUCCESS;
+  int64_t row_cnt = 0;
+  text_allocator_.reuse();
+  if (OB_FAIL(next_batch(1, row_cnt))) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("fail to read next row", K(ret));
+    }
+  } else if (OB_FAIL(fill_output(row_cnt, false))) {
+    LOG_WARN("fail to fill output", K(ret));
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::get_next_rows(int64_t &count, int64_t capacity)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+  int64_t row_cnt = 0;
+  count = 0;
+  text_allocator_.reuse();
+  if (OB_ISNULL(bit_vector_cache_)) {
+    void *mem = nullptr;
+    if (OB_ISNULL(mem = allocator_.alloc(ObBitVector::memory_size(eval_ctx.max_batch_size_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc memory for skip", K(ret), K(eval_ctx.max_batch_size_));
+    } else {
+      bit_vector_cache_ = to_bit_vector(mem);
+      bit_vector_cache_->reset(eval_ctx.max_batch_size_);
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(next_batch(capacity, row_cnt))) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("fail to read next batch", K(ret));
+    }
+  } else if (OB_FAIL(fill_output(row_cnt, true))) {
+    LOG_WARN("fail to fill output", K(ret));
+  } else {
+    count = row_cnt;
+  }
+  return ret;
+}
+
+void ObParquetTableRowIterator::close_file()
+{
+  for (int64_t i = 0; i < readers_.count(); i++) {
+    readers_.at(i)->reset();
+  }
+  row_group_allocator_.reset();
+  meta_.reset();
+  file_allocator_.reset();
+  if (data_access_driver_.is_opened()) {
+    data_access_driver_.close();
+  }
+  file_opened_ = false;
+  row_group_idx_ = 0;
+  row_group_first_row_ = 0;
+  row_group_rows_left_ = 0;
+}
+
+void ObParquetTableRowIterator::reset()
+{
+  // reset scan state to initial values for rescan
+  close_file();
+  file_idx_ = 0;
+  cur_file_id_ = ObCSVTableRowIterator::MIN_EXTERNAL_TABLE_FILE_ID;
+  start_row_ = ObCSVTableRowIterator::MIN_EXTERNAL_TABLE_LINE_NUMBER;
+  end_row_ = INT64_MAX;
+  cur_row_number_ = ObCSVTableRowIterator::MIN_EXTERNAL_TABLE_LINE_NUMBER;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
@@ -0,0 +1,232 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_TABLE_OB_PARQUET_TABLE_ROW_ITER_H_
+#define OCEANBASE_SQL_ENGINE_TABLE_OB_PARQUET_TABLE_ROW_ITER_H_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/compress/ob_compressor.h"
+#include "sql/engine/table/ob_external_table_access_service.h"
+#include "sql/engine/table/ob_parquet_file_meta.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Decoder of the RLE / bit-packing hybrid encoding, used by definition levels, dictionary
+// indices and RLE encoded booleans.
+class ObParquetRleDecoder
+{
+public:
+  ObParquetRleDecoder() { reset(); }
+  void reset();
+  int init(const char *data, const int64_t len, const int64_t bit_width);
+  int get_batch(uint32_t *values, const int64_t cnt);
+
+private:
+  int next_run();
+
+private:
+  const char *data_;
+  const char *end_;
+  int64_t bit_width_;
+  int64_t rle_left_;
+  uint32_t rle_value_;
+  int64_t bp_left_;
+  const char *bp_data_;
+  const char *bp_end_;
+  int64_t bp_bit_pos_;
+};
+
+// Decoded values of a column for a batch of rows. Values are stored by physical type:
+// BOOLEAN, INT32 and INT64 as int64 in fixed_, FLOAT and DOUBLE as double in fixed_,
+// INT96, BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY in strs_, which reference the decoded pages.
+struct ObParquetValueBatch
+{
+  ObParquetValueBatch() : nulls_(NULL), fixed_(NULL), strs_(NULL), buf_(NULL), capacity_(0) {}
+  int init(const int64_t capacity, common::ObIAllocator &allocator);
+  double get_double(const int64_t idx) const
+  {
+    double v = 0;
+    MEMCPY(&v, fixed_ + idx, sizeof(v));
+    return v;
+  }
+
+  bool *nulls_;
+  int64_t *fixed_;
+  common::ObString *strs_;
+  uint32_t *buf_;  // levels and dictionary indices
+  int64_t capacity_;
+};
+
+// Reader of one column chunk of a row group. The whole column chunk is read at open,
+// pages are decompressed and decoded on demand.
+class ObParquetColumnReader
+{
+public:
+  ObParquetColumnReader() : schema_(NULL), allocator_(NULL), compressor_(NULL) { reset(); }
+  ~ObParquetColumnReader() { reset(); }
+  void reset();
+  int open(ObExternalDataAccessDriver &driver,
+           const ObParquetColumnSchema &schema,
+           const ObParquetColumnChunkMeta &chunk,
+           common::ObIAllocator &allocator);
+  // decode the next row_cnt rows into batch
+  int read(const int64_t row_cnt, ObParquetValueBatch &batch);
+  // skip the next row_cnt rows, batch is used as the scratch
+  int skip(const int64_t row_cnt, ObParquetValueBatch &batch);
+
+private:
+  // move to the next data page, skip_rows is decreased by the rows of the skipped pages
+  int next_page(int64_t &skip_rows);
+  int decompress(const char *src, const int64_t src_len, const int64_t dst_len, const char *&dst);
+  int init_data_page(const ObParquetPageHeader &header, const char *levels, const int64_t levels_len,
+                     const char *values, const int64_t values_len);
+  int load_dictionary(const ObParquetPageHeader &header, const char *buf, const int64_t len);
+  int decode_plain(const int64_t cnt, const char *&pos, const char *end,
+                   int64_t *fixed, common::ObString *strs);
+  int decode_values(const int64_t cnt, ObParquetValueBatch &batch, const int64_t offset);
+
+private:
+  const ObParquetColumnSchema *schema_;
+  common::ObIAllocator *allocator_;
+  common::ObCompressor *compressor_;
+  ObParquetCodec codec_;
+  const char *chunk_buf_;
+  int64_t chunk_len_;
+  int64_t chunk_pos_;
+  // dictionary
+  int64_t dict_cnt_;
+  int64_t *dict_fixed_;
+  common::ObString *dict_strs_;
+  // current data page
+  int64_t page_rows_left_;
+  ObParquetEncoding encoding_;
+  bool has_def_levels_;
+  ObParquetRleDecoder def_decoder_;
+  ObParquetRleDecoder value_decoder_;  // dictionary indices or RLE booleans
+  const char *values_;
+  const char *values_end_;
+  int64_t bool_bit_pos_;
+};
+
+// Row iterator of parquet external tables.
+//
+// Only the column chunks of file columns referenced by the scan are read. Row groups are
+// skipped by their min/max statistics if a filter of the scan, in form of column compares
+// with const, is never true for them. Filters are still evaluated by the scan operator.
+//
+// Values are decoded into the datums of file column exprs (as text, like CSV files) and
+// converted by the column convert exprs. If the column convert is a cast of a file column
+// whose physical type matches the column type, values are decoded into the column datums
+// directly and the conversion is bypassed.
+class ObParquetTableRowIterator : public ObExternalTableRowIterator
+{
+public:
+  // how a column is produced from a parquet column without conversion
+  enum DirectType
+  {
+    DIRECT_NONE = 0,
+    DIRECT_INT,
+    DIRECT_FLOAT,
+    DIRECT_DOUBLE,
+    DIRECT_DATE,
+    DIRECT_DATETIME_MILLIS,
+    DIRECT_DATETIME_MICROS,
+  };
+  struct PushdownFilter
+  {
+    TO_STRING_KV(K_(op), K_(column_idx), KP_(const_expr));
+    ObItemType op_;           // column op const
+    int64_t column_idx_;      // index in column_exprs_
+    ObExpr *const_expr_;
+  };
+  static const int64_t TEXT_BUF_SIZE_PER_VALUE = 64;
+
+public:
+  ObParquetTableRowIterator();
+  virtual ~ObParquetTableRowIterator();
+  int init(const storage::ObTableScanParam *scan_param) override;
+  int get_next_row() override;
+  int get_next_rows(int64_t &count, int64_t capacity) override;
+
+  virtual int get_next_row(ObNewRow *&row) override {
+    UNUSED(row);
+    return common::OB_ERR_UNEXPECTED;
+  }
+
+  virtual void reset() override;
+  // whether "column op value" is false for all the rows of a row group by the column statistics
+  static bool is_never_true_by_stat(const DirectType type,
+                                    const ObItemType op,
+                                    const ObParquetPhysicalType physical_type,
+                                    const ObParquetStatistics &stat,
+                                    const int64_t row_cnt,
+                                    const ObDatum &value);
+
+private:
+  int init_exprs(const storage::ObTableScanParam *scan_param);
+  int init_pushdown_filters(const storage::ObTableScanParam *scan_param);
+  int64_t find_file_column(const ObExpr *expr) const;
+  int mark_text_file_columns(const ObExpr *expr);
+  int open_next_file();
+  int read_file_meta(const int64_t file_size);
+  int prepare_file_columns();
+  int next_row_group();
+  int can_skip_row_group(const ObParquetRowGroupMeta &row_group, bool &can_skip);
+  int next_batch(const int64_t capacity, int64_t &row_cnt);
+  int fill_output(const int64_t row_cnt, const bool is_batch);
+  int fill_direct_column(const int64_t column_idx, const int64_t row_cnt, const bool is_batch);
+  int fill_text_file_column(const int64_t file_column_idx, const int64_t row_cnt, const bool is_batch);
+  void close_file();
+
+private:
+  common::ObMalloc allocator_;
+  common::ObArenaAllocator file_allocator_;       // metadata of the current file
+  common::ObArenaAllocator row_group_allocator_;  // column chunks of the current row group
+  common::ObArenaAllocator text_allocator_;       // text values of the current batch
+  ObBitVector *bit_vector_cache_;
+  ObExternalDataAccessDriver data_access_driver_;
+  ObSqlString url_;
+  ObParquetFileMeta meta_;
+  // exprs
+  common::ObSEArray<ObExpr*, 16> column_exprs_;
+  ObExpr *line_number_expr_;
+  ObExpr *file_id_expr_;
+  // per column expr: index of the file column it may be directly decoded from, or -1
+  common::ObSEArray<int64_t, 16> direct_file_columns_;
+  // per column expr: direct type in the current file
+  common::ObSEArray<DirectType, 16> direct_types_;
+  // per file column expr
+  common::ObSEArray<ObParquetColumnReader*, 16> readers_;
+  common::ObSEArray<ObParquetValueBatch, 16> batches_;
+  common::ObSEArray<bool, 16> need_texts_;
+  common::ObSEArray<bool, 16> need_reads_;
+  common::ObSEArray<PushdownFilter, 4> filters_;
+  int64_t batch_capacity_;
+  // scan state
+  int64_t file_idx_;
+  bool file_opened_;
+  int64_t cur_file_id_;
+  int64_t start_row_;          // 1-based, inclusive
+  int64_t end_row_;            // 1-based, inclusive
+  int64_t row_group_idx_;
+  int64_t row_group_first_row_;  // 0-based number of the first row of the next row group
+  int64_t row_group_rows_left_;
+  int64_t cur_row_number_;     // 1-based number of the next row
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif // OCEANBASE_SQL_ENGINE_TABLE_OB_PARQUET_TABLE_ROW_ITER_H_
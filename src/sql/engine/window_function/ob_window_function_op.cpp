@@ -34,6 +34,10 @@ using namespace common;
 namespace sql
 {
 const int64_t CHECK_STATUS_INTERVAL = 10000;
+// partition with fewer rows is re-aggregated as before, building the tree is not worthwhile
+const int64_t SEGMENT_TREE_MIN_PART_ROWS = 64;
+// the tree is not dumped, a larger partition is re-aggregated as before
+const int64_t SEGMENT_TREE_MAX_MEM_SIZE = 64L << 20; // 64MB
 OB_SERIALIZE_MEMBER(WinFuncInfo::ExtBound,
                     is_preceding_,
                     is_unbounded_,
@@ -1676,7 +1680,13 @@ int ObWindowFunctionOp::compute(RowsReader &row_reader, WinFuncCell &wf_cell,
               K(row_idx), K(upper_has_null), K(lower_has_null), K(wf_cell));
     if (!upper_has_null && !lower_has_null && Frame::valid_frame(part_frame, new_frame)) {
       Frame::prune_frame(part_frame, new_frame);
-      if (wf_cell.is_aggr()) {
+      if (wf_cell.is_aggr() && static_cast<AggrCell &>(wf_cell).use_seg_tree_) {
+        if (OB_FAIL(compute_by_segment_tree(static_cast<AggrCell &>(wf_cell), new_frame, val))) {
+          LOG_WARN("compute by segment tree failed", K(ret), K(new_frame));
+        } else {
+          last_valid_frame = new_frame;
+        }
+      } else if (wf_cell.is_aggr()) {
         AggrCell *aggr_func = static_cast<AggrCell *>(&wf_cell);
         const ObRADatumStore::StoredRow *cur_row = NULL;
         if (!Frame::same_frame(last_valid_frame, new_frame)) {
@@ -3136,6 +3146,10 @@ int ObWindowFunctionOp::compute_wf_values(const WinFuncCell *end, int64_t &check
   int64_t prev_wf_pby_expr_count = -1; // prev_wf_pby_expr_count transmit to datahub
   for (WinFuncCell *wf = first; OB_SUCC(ret) && wf != end; wf = wf->get_next()) {
     wf->reset_for_restart();
+    if (need_segment_tree(*wf)
+        && OB_FAIL(build_segment_tree(*static_cast<AggrCell *>(wf), check_times))) {
+      LOG_WARN("build segment tree failed", K(ret), KPC(wf));
+    }
     ObDatum result_datum;
     RowsReader row_reader(*input_rows_.cur_);
     if (wf == wf_list_.get_last()) {
@@ -3190,6 +3204,103 @@ int ObWindowFunctionOp::compute_wf_values(const WinFuncCell *end, int64_t &check
   return ret;
 }
 
+bool ObWindowFunctionOp::need_segment_tree(const WinFuncCell &wf_cell) const
+{
+  bool need = false;
+  if (wf_cell.is_aggr()
+      && !MY_SPEC.is_push_down()
+      && input_rows_.cur_->count() - wf_cell.part_first_row_idx_ >= SEGMENT_TREE_MIN_PART_ROWS
+      && ObWindowFunctionSegmentTree::get_fixed_mem_size(
+          input_rows_.cur_->count() - wf_cell.part_first_row_idx_) <= SEGMENT_TREE_MAX_MEM_SIZE) {
+    const WinFuncInfo &wf_info = wf_cell.wf_info_;
+    const ObAggrInfo &aggr_info = wf_info.aggr_info_;
+    // frame head fixed at partition start never slides out rows, incremental aggregation is O(1)
+    const bool is_cumulative = wf_info.upper_.is_unbounded_ && wf_info.upper_.is_preceding_;
+    need = (T_FUN_MAX == aggr_info.get_expr_type() || T_FUN_MIN == aggr_info.get_expr_type())
+           && 1 == aggr_info.param_exprs_.count()
+           && NULL != aggr_info.expr_
+           && NULL != aggr_info.expr_->basic_funcs_
+           && NULL != aggr_info.expr_->basic_funcs_->null_first_cmp_
+           && !ob_is_user_defined_sql_type(aggr_info.expr_->datum_meta_.type_)
+           && !is_cumulative;
+  }
+  return need;
+}
+
+int ObWindowFunctionOp::build_segment_tree(AggrCell &aggr_func, int64_t &check_times)
+{
+  int ret = OB_SUCCESS;
+  const ObAggrInfo &aggr_info = aggr_func.wf_info_.aggr_info_;
+  ObExpr *param_expr = aggr_info.param_exprs_.at(0);
+  ObWindowFunctionSegmentTree &seg_tree = aggr_func.seg_tree_;
+  const int64_t part_begin = aggr_func.part_first_row_idx_;
+  const int64_t part_end = input_rows_.cur_->count();
+  aggr_func.use_seg_tree_ = false;
+  if (OB_ISNULL(param_expr)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("param expr is null", K(ret));
+  } else if (!seg_tree.is_inited()
+             && OB_FAIL(seg_tree.init(T_FUN_MAX == aggr_info.get_expr_type(),
+                                      aggr_info.expr_->basic_funcs_->null_first_cmp_,
+                                      ctx_.get_my_session()->get_effective_tenant_id(),
+                                      SEGMENT_TREE_MAX_MEM_SIZE))) {
+    LOG_WARN("init segment tree failed", K(ret));
+  } else if (OB_FAIL(seg_tree.start_build(part_end - part_begin))) {
+    LOG_WARN("start build segment tree failed", K(ret), K(part_begin), K(part_end));
+  }
+  for (int64_t i = part_begin; OB_SUCC(ret) && i < part_end; ++i) {
+    const ObRADatumStore::StoredRow *row = NULL;
+    ObDatum *param = NULL;
+    if (0 == ++check_times % CHECK_STATUS_INTERVAL && OB_FAIL(ctx_.check_status())) {
+      LOG_WARN("check status failed", K(ret));
+    } else if (OB_FAIL(input_rows_.cur_->get_row(i, row))) {
+      LOG_WARN("failed to get row", K(ret), K(i));
+    } else if (FALSE_IT(clear_evaluated_flag())) {
+    } else if (OB_FAIL(row->to_expr(get_all_expr(), eval_ctx_))) {
+      LOG_WARN("Failed to to_expr", K(ret));
+    } else if (OB_FAIL(param_expr->eval(eval_ctx_, param))) {
+      LOG_WARN("eval param expr failed", K(ret));
+    } else if (OB_FAIL(seg_tree.add_leaf(*param))) {
+      LOG_WARN("add leaf failed", K(ret), K(i));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    if (OB_FAIL(seg_tree.finish_build())) {
+      LOG_WARN("finish build segment tree failed", K(ret));
+    } else {
+      aggr_func.use_seg_tree_ = true;
+      LOG_DEBUG("segment tree built", K(part_begin), K(part_end), K(seg_tree));
+    }
+  } else if (OB_EXCEED_MEM_LIMIT == ret) {
+    // values of the partition are too large, frames are computed by aggr_processor_
+    LOG_TRACE("segment tree exceeds memory limit, fall back to re-aggregation",
+              K(part_begin), K(part_end), K(seg_tree));
+    seg_tree.reuse();
+    ret = OB_SUCCESS;
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::compute_by_segment_tree(AggrCell &aggr_func,
+                                                const Frame &frame,
+                                                ObDatum &val)
+{
+  int ret = OB_SUCCESS;
+  int64_t leaf = -1;
+  const int64_t part_begin = aggr_func.part_first_row_idx_;
+  if (OB_FAIL(aggr_func.seg_tree_.query(frame.head_ - part_begin,
+                                        frame.tail_ - part_begin,
+                                        leaf))) {
+    LOG_WARN("query segment tree failed", K(ret), K(frame), K(part_begin));
+  } else if (leaf < 0) {
+    // all values in frame are NULL
+    val.set_null();
+  } else {
+    val = aggr_func.seg_tree_.get_value(leaf);
+  }
+  return ret;
+}
+
 int ObWindowFunctionOp::calc_part_exprs_hash(
     const common::ObIArray<ObExpr *> *exprs_,
     const ObChunkDatumStore::StoredRow *row_,
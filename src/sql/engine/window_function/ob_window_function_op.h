@@ -25,6 +25,7 @@
 #include "sql/engine/px/datahub/components/ob_dh_winbuf.h"
 #include "sql/engine/px/datahub/components/ob_dh_second_stage_reporting_wf.h"
 #include "sql/engine/basic/ob_chunk_datum_store.h"
+#include "sql/engine/window_function/ob_window_function_segment_tree.h"
 
 namespace oceanbase
 {
@@ -563,7 +564,9 @@ public:
         aggr_processor_(op_.eval_ctx_, aggr_infos, "WindowAggProc", op.get_monitor_info()),
         result_(),
         got_result_(false),
-        remove_type_(wf_info.remove_type_)
+        remove_type_(wf_info.remove_type_),
+        use_seg_tree_(false),
+        seg_tree_()
     {}
     virtual ~AggrCell() { aggr_processor_.destroy(); }
     int trans(const ObRADatumStore::StoredRow &row)
@@ -600,6 +603,7 @@ public:
       aggr_processor_.reuse();
       result_.reset();
       got_result_ = false;
+      use_seg_tree_ = false;
     }
   public:
     bool finish_prepared_;
@@ -607,6 +611,9 @@ public:
     ObDatum result_;
     bool got_result_;
     uint64_t remove_type_;
+    // frames of current partition are computed by seg_tree_ instead of aggr_processor_
+    bool use_seg_tree_;
+    ObWindowFunctionSegmentTree seg_tree_;
   };
 
   class NonAggrCell : public WinFuncCell
@@ -840,6 +847,10 @@ protected:
   int64_t next_nonskip_row_index(int64_t cur_idx, const ObBatchRows &child_brs);
   int get_next_batch_from_child(int64_t batch_size, const ObBatchRows *&child_brs);
   int compute_wf_values(const WinFuncCell *end, int64_t &check_times);
+  // MIN/MAX with sliding frame head is computed by segment tree built over the partition
+  bool need_segment_tree(const WinFuncCell &wf_cell) const;
+  int build_segment_tree(AggrCell &aggr_func, int64_t &check_times);
+  int compute_by_segment_tree(AggrCell &aggr_func, const Frame &frame, common::ObDatum &val);
   int check_wf_same_partition(WinFuncCell *&end);
 
   // for pushdown
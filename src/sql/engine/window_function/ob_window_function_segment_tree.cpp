@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/window_function/ob_window_function_segment_tree.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+int ObWindowFunctionSegmentTree::init(const bool is_max,
+                                      ObDatumCmpFuncType cmp_func,
+                                      const uint64_t tenant_id,
+                                      const int64_t max_mem_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(cmp_func) || OB_UNLIKELY(max_mem_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(cmp_func), K(max_mem_size));
+  } else {
+    is_max_ = is_max;
+    cmp_func_ = cmp_func;
+    max_mem_size_ = max_mem_size;
+    allocator_.set_tenant_id(tenant_id);
+    allocator_.set_ctx_id(ObCtxIds::WORK_AREA);
+    values_ = NULL;
+    nodes_ = NULL;
+    leaf_cnt_ = 0;
+    added_cnt_ = 0;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObWindowFunctionSegmentTree::destroy()
+{
+  values_ = NULL;
+  nodes_ = NULL;
+  leaf_cnt_ = 0;
+  added_cnt_ = 0;
+  cmp_func_ = NULL;
+  max_mem_size_ = 0;
+  allocator_.reset();
+  is_inited_ = false;
+}
+
+void ObWindowFunctionSegmentTree::reuse()
+{
+  values_ = NULL;
+  nodes_ = NULL;
+  leaf_cnt_ = 0;
+  added_cnt_ = 0;
+  allocator_.reset_remain_one_page();
+}
+
+int ObWindowFunctionSegmentTree::start_build(const int64_t leaf_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(leaf_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid leaf count", K(ret), K(leaf_cnt));
+  } else if (FALSE_IT(reuse())) {
+  } else if (get_fixed_mem_size(leaf_cnt) > max_mem_size_) {
+    ret = OB_EXCEED_MEM_LIMIT;
+    LOG_TRACE("segment tree exceeds memory limit", K(ret), K(leaf_cnt), K_(max_mem_size));
+  } else {
+    if (OB_ISNULL(values_ = static_cast<ObDatum *>(
+                allocator_.alloc(sizeof(ObDatum) * leaf_cnt)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc values failed", K(ret), K(leaf_cnt));
+    } else if (OB_ISNULL(nodes_ = static_cast<int64_t *>(
+                allocator_.alloc(sizeof(int64_t) * leaf_cnt * 2)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc nodes failed", K(ret), K(leaf_cnt));
+    } else {
+      leaf_cnt_ = leaf_cnt;
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionSegmentTree::add_leaf(const ObDatum &datum)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(added_cnt_ >= leaf_cnt_)) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_WARN("too many leaves", K(ret), K_(added_cnt), K_(leaf_cnt));
+  } else {
+    ObDatum &value = *new (&values_[added_cnt_]) ObDatum();
+    if (datum.is_null()) {
+      value.set_null();
+      nodes_[leaf_cnt_ + added_cnt_] = -1;
+    } else if (OB_FAIL(value.deep_copy(datum, allocator_))) {
+      LOG_WARN("deep copy datum failed", K(ret), K(datum));
+    } else if (allocator_.used() > max_mem_size_) {
+      ret = OB_EXCEED_MEM_LIMIT;
+      LOG_TRACE("segment tree exceeds memory limit", K(ret), K_(added_cnt), K(*this));
+    } else {
+      nodes_[leaf_cnt_ + added_cnt_] = added_cnt_;
+    }
+    if (OB_SUCC(ret)) {
+      added_cnt_++;
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionSegmentTree::finish_build()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(added_cnt_ != leaf_cnt_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("leaves not all added", K(ret), K_(added_cnt), K_(leaf_cnt));
+  } else {
+    for (int64_t i = leaf_cnt_ - 1; OB_SUCC(ret) && i > 0; --i) {
+      if (OB_FAIL(merge(nodes_[2 * i], nodes_[2 * i + 1], nodes_[i]))) {
+        LOG_WARN("merge failed", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionSegmentTree::query(const int64_t head,
+                                       const int64_t tail,
+                                       int64_t &leaf) const
+{
+  int ret = OB_SUCCESS;
+  leaf = -1;
+  if (OB_UNLIKELY(!is_built())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("tree not built", K(ret), K(*this));
+  } else if (OB_UNLIKELY(head < 0 || tail >= leaf_cnt_ || head > tail)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid range", K(ret), K(head), K(tail), K_(leaf_cnt));
+  } else {
+    // bottom-up traversal of half-open range [l, r) of nodes
+    int64_t l = head + leaf_cnt_;
+    int64_t r = tail + leaf_cnt_ + 1;
+    while (OB_SUCC(ret) && l < r) {
+      if ((l & 1) && OB_FAIL(merge(leaf, nodes_[l++], leaf))) {
+        LOG_WARN("merge failed", K(ret), K(l));
+      } else if ((r & 1) && OB_FAIL(merge(leaf, nodes_[--r], leaf))) {
+        LOG_WARN("merge failed", K(ret), K(r));
+      } else {
+        l >>= 1;
+        r >>= 1;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionSegmentTree::merge(const int64_t left,
+                                       const int64_t right,
+                                       int64_t &leaf) const
+{
+  int ret = OB_SUCCESS;
+  if (left < 0) {
+    leaf = right;
+  } else if (right < 0) {
+    leaf = left;
+  } else {
+    int cmp_ret = 0;
+    if (OB_FAIL(cmp_func_(values_[left], values_[right], cmp_ret))) {
+      LOG_WARN("compare failed", K(ret), K(left), K(right));
+    } else {
+      leaf = (is_max_ ? cmp_ret >= 0 : cmp_ret <= 0) ? left : right;
+    }
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef _OB_WINDOW_FUNCTION_SEGMENT_TREE_H
+#define _OB_WINDOW_FUNCTION_SEGMENT_TREE_H 1
+
+#include "lib/allocator/page_arena.h"
+#include "share/datum/ob_datum.h"
+#include "share/datum/ob_datum_funcs.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Segment tree over the aggregate param values of one partition, used by MIN/MAX window
+// functions whose frame head slides. Those aggregates can not remove the sliding-out rows,
+// so the frame is re-aggregated for most rows, which costs O(frame) per row. With the tree
+// each frame is answered in O(log n) after an O(n) build.
+//
+// Usage:
+//   start_build(n) -> add_leaf() * n -> finish_build() -> query() ...
+//
+// Leaf i is the i-th row of the partition, NULL values are ignored as MIN/MAX do.
+// The tree is allocated in the work area of the tenant and is not dumped, building it fails
+// with OB_EXCEED_MEM_LIMIT above @max_mem_size, the caller falls back to re-aggregation then.
+class ObWindowFunctionSegmentTree
+{
+public:
+  ObWindowFunctionSegmentTree()
+    : is_inited_(false),
+      is_max_(false),
+      cmp_func_(NULL),
+      max_mem_size_(0),
+      allocator_("WfSegTree"),
+      values_(NULL),
+      nodes_(NULL),
+      leaf_cnt_(0),
+      added_cnt_(0)
+  {}
+  ~ObWindowFunctionSegmentTree() { destroy(); }
+
+  int init(const bool is_max,
+           common::ObDatumCmpFuncType cmp_func,
+           const uint64_t tenant_id,
+           const int64_t max_mem_size);
+  void destroy();
+  // release the tree, the memory of one page is kept
+  void reuse();
+
+  // release the tree of last partition and reserve @leaf_cnt leaves
+  int start_build(const int64_t leaf_cnt);
+  // value is deep copied
+  int add_leaf(const common::ObDatum &datum);
+  int finish_build();
+
+  // get the leaf of min (max) value in [head, tail], @leaf is -1 if all values are NULL
+  int query(const int64_t head, const int64_t tail, int64_t &leaf) const;
+  const common::ObDatum &get_value(const int64_t leaf) const { return values_[leaf]; }
+
+  bool is_inited() const { return is_inited_; }
+  int64_t get_leaf_count() const { return leaf_cnt_; }
+  bool is_built() const { return leaf_cnt_ > 0 && added_cnt_ == leaf_cnt_; }
+  int64_t get_mem_used() const { return allocator_.used(); }
+  // memory of the leaves and nodes, without the deep copied values
+  static int64_t get_fixed_mem_size(const int64_t leaf_cnt)
+  {
+    return (sizeof(common::ObDatum) + 2 * sizeof(int64_t)) * leaf_cnt;
+  }
+
+  TO_STRING_KV(K_(is_inited), K_(is_max), K_(max_mem_size), K_(leaf_cnt), K_(added_cnt),
+               "mem_used", allocator_.used());
+
+private:
+  // choose the leaf of min (max) value from @left and @right, -1 stands for empty
+  int merge(const int64_t left, const int64_t right, int64_t &leaf) const;
+
+private:
+  bool is_inited_;
+  bool is_max_;
+  common::ObDatumCmpFuncType cmp_func_;
+  int64_t max_mem_size_;
+  common::ObArenaAllocator allocator_;
+  common::ObDatum *values_;
+  // nodes_[leaf_cnt_ + i] is leaf i, nodes_[i] is the merged leaf of nodes_[2i] and nodes_[2i + 1]
+  int64_t *nodes_;
+  int64_t leaf_cnt_;
+  int64_t added_cnt_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObWindowFunctionSegmentTree);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif // _OB_WINDOW_FUNCTION_SEGMENT_TREE_H
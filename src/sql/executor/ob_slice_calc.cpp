@@ -1416,6 +1416,63 @@ int ObHybridHashSliceIdCalcBase::check_if_popular_value(ObEvalCtx &eval_ctx, boo
   return ret;
 }
 
+int ObHybridHashSliceIdCalcBase::enable_slice_rows_stat()
+{
+  int ret = OB_SUCCESS;
+  const int64_t slice_cnt = hash_calc_.task_cnt_;
+  if (OB_FAIL(hash_slice_rows_.prepare_allocate(slice_cnt))) {
+    LOG_WARN("fail to prepare allocate", K(ret), K(slice_cnt));
+  } else if (OB_FAIL(dist_slice_rows_.prepare_allocate(slice_cnt))) {
+    LOG_WARN("fail to prepare allocate", K(ret), K(slice_cnt));
+  } else {
+    for (int64_t i = 0; i < slice_cnt; ++i) {
+      hash_slice_rows_.at(i) = 0;
+      dist_slice_rows_.at(i) = 0;
+    }
+    collect_slice_rows_ = true;
+  }
+  return ret;
+}
+
+int ObHybridHashSliceIdCalcBase::add_slice_rows_stat(const ObIArray<ObExpr*> &exprs,
+                                                     ObEvalCtx &eval_ctx,
+                                                     const bool is_popular,
+                                                     const int64_t *slice_indexes,
+                                                     const int64_t slice_idx_cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t hash_slice_idx = OB_INVALID_INDEX;
+  if (!collect_slice_rows_) {
+    // do nothing
+  } else if (!is_popular) {
+    // not popular value is hash distributed, slice_indexes is the hash slice
+    hash_slice_idx = slice_idx_cnt > 0 ? slice_indexes[0] : OB_INVALID_INDEX;
+  } else if (OB_FAIL(hash_calc_.get_slice_idx(exprs, eval_ctx, hash_slice_idx))) {
+    LOG_WARN("fail get hash slice idx", K(ret));
+  }
+  if (OB_SUCC(ret) && collect_slice_rows_) {
+    // rows may be dropped or sent to random slice, ignore invalid slice index
+    if (hash_slice_idx >= 0 && hash_slice_idx < hash_slice_rows_.count()) {
+      hash_slice_rows_.at(hash_slice_idx) += 1;
+    }
+    for (int64_t i = 0; i < slice_idx_cnt; ++i) {
+      if (slice_indexes[i] >= 0 && slice_indexes[i] < dist_slice_rows_.count()) {
+        dist_slice_rows_.at(slice_indexes[i]) += 1;
+      }
+    }
+  }
+  return ret;
+}
+
+int64_t ObHybridHashSliceIdCalcBase::get_max_slice_rows(const ObIArray<int64_t> &slice_rows)
+{
+  int64_t max_rows = 0;
+  for (int64_t i = 0; i < slice_rows.count(); ++i) {
+    max_rows = std::max(max_rows, slice_rows.at(i));
+  }
+  return max_rows;
+}
+
 int ObHybridHashRandomSliceIdCalc::get_slice_idx(
       const ObIArray<ObExpr*> &exprs, ObEvalCtx &eval_ctx, int64_t &slice_idx)
 {
@@ -1428,6 +1485,9 @@ int ObHybridHashRandomSliceIdCalc::get_slice_idx(
   } else {
     ret = hash_calc_.get_slice_idx(exprs, eval_ctx, slice_idx);
   }
+  if (OB_SUCC(ret) && collect_slice_rows_) {
+    ret = add_slice_rows_stat(exprs, eval_ctx, is_popular, &slice_idx, 1);
+  }
   return ret;
 }
 
@@ -1444,5 +1504,10 @@ int ObHybridHashBroadcastSliceIdCalc::get_slice_indexes(
   } else {
     ret = hash_calc_.get_slice_indexes(exprs, eval_ctx, slice_idx_array);
   }
+  if (OB_SUCC(ret) && collect_slice_rows_) {
+    ret = add_slice_rows_stat(exprs, eval_ctx, is_popular,
+                              slice_idx_array.empty() ? NULL : &slice_idx_array.at(0),
+                              slice_idx_array.count());
+  }
   return ret;
 }
@@ -705,7 +705,10 @@ public:
                               const ObIArray<uint64_t> *popular_values_hash)
       : hash_calc_(alloc, slice_cnt, null_row_dist_method, dist_exprs, hash_funcs),
         popular_values_hash_(popular_values_hash),
-        use_hash_lookup_(false)
+        use_hash_lookup_(false),
+        collect_slice_rows_(false),
+        hash_slice_rows_(),
+        dist_slice_rows_()
   {
     int ret = OB_SUCCESS;
     if (popular_values_hash && popular_values_hash->count() > 3) {
@@ -731,12 +734,24 @@ public:
       (void) popular_values_map_.destroy();
     }
   }
+  // count rows of each slice under plain hash distribution and under hybrid
+  // distribution, used to show how much the skew is relieved in sql monitor.
+  int enable_slice_rows_stat();
+  int64_t get_max_hash_slice_rows() const { return get_max_slice_rows(hash_slice_rows_); }
+  int64_t get_max_dist_slice_rows() const { return get_max_slice_rows(dist_slice_rows_); }
 protected:
   int check_if_popular_value(ObEvalCtx &eval_ctx, bool &is_popular);
+  int add_slice_rows_stat(const ObIArray<ObExpr*> &exprs, ObEvalCtx &eval_ctx,
+                          const bool is_popular, const int64_t *slice_indexes,
+                          const int64_t slice_idx_cnt);
+  static int64_t get_max_slice_rows(const common::ObIArray<int64_t> &slice_rows);
   ObHashSliceIdCalc hash_calc_;
   const common::ObIArray<uint64_t> *popular_values_hash_;
   common::hash::ObHashSet<uint64_t, common::hash::NoPthreadDefendMode> popular_values_map_;
   bool use_hash_lookup_;
+  bool collect_slice_rows_;
+  common::ObSEArray<int64_t, DEFAULT_CHANNEL_CNT> hash_slice_rows_;
+  common::ObSEArray<int64_t, DEFAULT_CHANNEL_CNT> dist_slice_rows_;
 };
 
 // broadcast side of px hybrid hash send
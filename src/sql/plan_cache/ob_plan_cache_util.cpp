@@ -406,6 +406,8 @@ int ObConfigInfoInPC::load_influence_plan_config()
     bloom_filter_enabled_ = tenant_config->_bloom_filter_enabled;
     px_join_skew_handling_ = tenant_config->_px_join_skew_handling;
     px_join_skew_minfreq_ = static_cast<int8_t>(tenant_config->_px_join_skew_minfreq);
+    px_join_skew_detection_ = tenant_config->_px_join_skew_detection;
+    enable_dml_batch_execution_ = tenant_config->_enable_dml_batch_execution;
     min_cluster_version_ = GET_MIN_CLUSTER_VERSION();
   }
 
@@ -443,7 +445,12 @@ int ObConfigInfoInPC::serialize_configs(char *buf, int buf_len, int64_t &pos)
   } else if (OB_FAIL(databuff_printf(buf, buf_len, pos,
                               "%d,", px_join_skew_minfreq_))) {
     SQL_PC_LOG(WARN, "failed to databuff_printf", K(ret), K(px_join_skew_minfreq_));
-
+  } else if (OB_FAIL(databuff_printf(buf, buf_len, pos,
+                              "%d,", px_join_skew_detection_))) {
+    SQL_PC_LOG(WARN, "failed to databuff_printf", K(ret), K(px_join_skew_detection_));
+  } else if (OB_FAIL(databuff_printf(buf, buf_len, pos,
+                              "%d,", enable_dml_batch_execution_))) {
+    SQL_PC_LOG(WARN, "failed to databuff_printf", K(ret), K(enable_dml_batch_execution_));
   } else if (OB_FAIL(databuff_printf(buf, buf_len, pos,
                                "%lu,", min_cluster_version_))) {
     SQL_PC_LOG(WARN, "failed to databuff_printf", K(ret), K(min_cluster_version_));
@@ -551,6 +551,13 @@ struct ObPlanStat
   ObTableRowCount *table_row_count_first_exec_;
   int64_t access_table_num_;         //plan访问的表的个数，目前只统计whole range扫描的表
   bool is_expired_; // 这个计划是否已经由于数据的表行数变化和执行时间变化而失效
+  // the join cardinality is misestimated even in the execution generating this plan,
+  // so generating it again won't change the join method
+  bool join_card_misestimated_;
+  // join method checks and misestimates of the current sample, see
+  // ObPhysicalPlan::report_join_card_misestimate
+  int64_t join_method_check_times_;
+  int64_t join_card_misestimate_times_;
 
   // check whether plan has stable performance
   bool enable_plan_expiration_;
@@ -643,6 +650,9 @@ struct ObPlanStat
       table_row_count_first_exec_(NULL),
       access_table_num_(0),
       is_expired_(false),
+      join_card_misestimated_(false),
+      join_method_check_times_(0),
+      join_card_misestimate_times_(0),
       enable_plan_expiration_(false),
       first_exec_row_count_(-1),
       sessid_(0),
@@ -717,6 +727,9 @@ struct ObPlanStat
       table_row_count_first_exec_(NULL),
       access_table_num_(0),
       is_expired_(false),
+      join_card_misestimated_(false),
+      join_method_check_times_(0),
+      join_card_misestimate_times_(0),
       enable_plan_expiration_(rhs.enable_plan_expiration_),
       first_exec_row_count_(rhs.first_exec_row_count_),
       sessid_(rhs.sessid_),
@@ -975,6 +988,8 @@ public:
     enable_newsort_(true),
     px_join_skew_handling_(true),
     px_join_skew_minfreq_(30),
+    px_join_skew_detection_(false),
+    enable_dml_batch_execution_(false),
     min_cluster_version_(0),
     is_enable_px_fast_reclaim_(false),
     cluster_config_version_(-1),
@@ -1015,6 +1030,8 @@ public:
   bool enable_newsort_;
   bool px_join_skew_handling_;
   int8_t px_join_skew_minfreq_;
+  bool px_join_skew_detection_;
+  bool enable_dml_batch_execution_;
   uint64_t min_cluster_version_;
   bool is_enable_px_fast_reclaim_;
 
@@ -556,6 +556,7 @@ public:
                                  enable_bloom_filter_(true),
                                  px_join_skew_handling_(true),
                                  px_join_skew_minfreq_(30),
+                                 px_join_skew_detection_(false),
                                  at_type_(ObAuditTrailType::NONE),
                                  sort_area_size_(128*1024*1024),
                                  hash_area_size_(128*1024*1024),
@@ -578,6 +579,7 @@ public:
     int64_t get_print_sample_ppm() const { return ATOMIC_LOAD(&print_sample_ppm_); }
     bool get_px_join_skew_handling() const { return px_join_skew_handling_; }
     int64_t get_px_join_skew_minfreq() const { return px_join_skew_minfreq_; }
+    bool get_px_join_skew_detection() const { return px_join_skew_detection_; }
   private:
     //租户级别配置项缓存session 上，避免每次获取都需要刷新
     bool is_external_consistent_;
@@ -587,6 +589,7 @@ public:
     bool enable_bloom_filter_;
     bool px_join_skew_handling_;
     int64_t px_join_skew_minfreq_;
+    bool px_join_skew_detection_;
     ObAuditTrailType at_type_;
     int64_t sort_area_size_;
     int64_t hash_area_size_;
@@ -1041,6 +1044,11 @@ public:
     cached_tenant_config_info_.refresh();
     return cached_tenant_config_info_.get_px_join_skew_handling();
   }
+  bool get_px_join_skew_detection()
+  {
+    cached_tenant_config_info_.refresh();
+    return cached_tenant_config_info_.get_px_join_skew_detection();
+  }
 
   bool is_enable_sql_extension()
   {
@@ -261,6 +261,233 @@ void ObSimpleBackupStatMgr::reset_stat_list_()
   }
 }
 
+/* ObBackupFileUploadPipeline */
+
+ObBackupFileUploadPipeline::Task::Task()
+    : buffer_("BackupUpload"),
+      offset_(0),
+      ret_(OB_SUCCESS),
+      is_done_(false)
+{}
+
+ObBackupFileUploadPipeline::ObBackupFileUploadPipeline()
+    : is_inited_(false),
+      task_cnt_(0),
+      tasks_(NULL),
+      head_(0),
+      next_(0),
+      written_(0),
+      tail_(0),
+      write_ret_(OB_SUCCESS),
+      io_fd_(),
+      dev_handle_(NULL),
+      cond_(),
+      allocator_("BackupUpload", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID())
+{}
+
+ObBackupFileUploadPipeline::~ObBackupFileUploadPipeline()
+{
+  destroy();
+}
+
+int ObBackupFileUploadPipeline::init(
+    const int64_t thread_cnt, const common::ObIOFd &io_fd, common::ObIODevice &dev_handle)
+{
+  int ret = OB_SUCCESS;
+  void *buf = NULL;
+  const int64_t task_cnt = thread_cnt * TASK_CNT_PER_THREAD;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("upload pipeline init twice", K(ret));
+  } else if (thread_cnt <= 0 || thread_cnt > MAX_THREAD_CNT || !io_fd.is_valid()) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("get invalid args", K(ret), K(thread_cnt), K(io_fd));
+  } else if (OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    LOG_WARN("failed to init thread cond", K(ret));
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(Task) * task_cnt))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc upload tasks", K(ret), K(task_cnt));
+  } else {
+    tasks_ = static_cast<Task *>(buf);
+    for (int64_t i = 0; i < task_cnt; ++i) {
+      new (tasks_ + i) Task();
+    }
+    task_cnt_ = task_cnt;
+    io_fd_ = io_fd;
+    dev_handle_ = &dev_handle;
+    if (OB_FAIL(set_thread_count(thread_cnt))) {
+      LOG_WARN("failed to set thread count", K(ret), K(thread_cnt));
+    } else if (FALSE_IT(set_run_wrapper(MTL_CTX()))) {
+    } else if (OB_FAIL(start())) {
+      LOG_WARN("failed to start upload threads", K(ret), K(thread_cnt));
+    } else {
+      is_inited_ = true;
+    }
+  }
+  if (OB_FAIL(ret) && OB_INIT_TWICE != ret) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObBackupFileUploadPipeline::destroy()
+{
+  share::ObThreadPool::stop();
+  if (is_inited_) {
+    ObThreadCondGuard guard(cond_);
+    cond_.broadcast();
+  }
+  share::ObThreadPool::wait();
+  share::ObThreadPool::destroy();
+  if (OB_NOT_NULL(tasks_)) {
+    for (int64_t i = 0; i < task_cnt_; ++i) {
+      tasks_[i].~Task();
+    }
+    tasks_ = NULL;
+  }
+  task_cnt_ = 0;
+  head_ = 0;
+  next_ = 0;
+  written_ = 0;
+  tail_ = 0;
+  write_ret_ = OB_SUCCESS;
+  io_fd_.reset();
+  dev_handle_ = NULL;
+  cond_.destroy();
+  allocator_.reset();
+  is_inited_ = false;
+}
+
+void ObBackupFileUploadPipeline::run1()
+{
+  lib::set_thread_name("BackupUpload");
+  while (!has_set_stop()) {
+    int ret = OB_SUCCESS;
+    Task *task = NULL;
+    int64_t task_idx = 0;
+    {
+      ObThreadCondGuard guard(cond_);
+      if (next_ < tail_) {
+        task_idx = next_;
+        task = &tasks_[next_ % task_cnt_];
+        ++next_;
+      } else {
+        cond_.wait(WAIT_INTERVAL_MS);
+      }
+    }
+    if (OB_NOT_NULL(task)) {
+      ret = write_task_(task_idx, *task);
+      ObThreadCondGuard guard(cond_);
+      task->ret_ = ret;
+      task->is_done_ = true;
+      cond_.broadcast();
+    }
+  }
+}
+
+// The device writer of a file is not thread safe, e.g. ObStorageFileBaseWriter updates its file
+// length and the appenders of object storage require sequential offsets. So the device writes
+// are serialized in the submission order of tasks, while the backup thread keeps building and
+// submitting the following buffers.
+int ObBackupFileUploadPipeline::write_task_(const int64_t task_idx, Task &task)
+{
+  int ret = OB_SUCCESS;
+  {
+    ObThreadCondGuard guard(cond_);
+    while (task_idx != written_ && !has_set_stop()) {
+      cond_.wait(WAIT_INTERVAL_MS);
+    }
+    if (task_idx != written_) {
+      ret = OB_IN_STOP_STATE;
+      LOG_WARN("upload pipeline is stopped", K(ret), K(task_idx), KPC(this));
+    } else if (OB_FAIL(write_ret_)) {
+      LOG_WARN("previous upload task failed, skip writing", K(ret), K(task_idx), K(task));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    int64_t write_size = 0;
+    const int64_t length = task.buffer_.length();
+    if (OB_FAIL(dev_handle_->pwrite(io_fd_, task.offset_, length, task.buffer_.data(), write_size))) {
+      LOG_WARN("failed to write data buffer", K(ret), K(task));
+    } else if (length != write_size) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("write length not equal buffer length", K(ret), K(task), K(write_size));
+    }
+  }
+  ObThreadCondGuard guard(cond_);
+  if (task_idx == written_) {
+    if (OB_FAIL(ret) && OB_SUCCESS == write_ret_) {
+      write_ret_ = ret;
+    }
+    ++written_;
+    cond_.broadcast();
+  }
+  return ret;
+}
+
+int ObBackupFileUploadPipeline::submit(const int64_t offset, const blocksstable::ObSelfBufferWriter &buffer)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("upload pipeline do not init", K(ret));
+  } else if (offset < 0 || buffer.length() <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("get invalid args", K(ret), K(offset), K(buffer));
+  } else if (is_full() && OB_FAIL(pop_head_())) {
+    LOG_WARN("failed to wait oldest upload task", K(ret), KPC(this));
+  } else {
+    // the file write ctx reuses its buffer right after submit, so copy the buffer
+    Task &task = tasks_[tail_ % task_cnt_];
+    task.buffer_.reuse();
+    task.offset_ = offset;
+    task.ret_ = OB_SUCCESS;
+    task.is_done_ = false;
+    if (OB_FAIL(task.buffer_.write(buffer.data(), buffer.length()))) {
+      LOG_WARN("failed to copy buffer", K(ret), K(buffer));
+    } else {
+      ObThreadCondGuard guard(cond_);
+      ++tail_;
+      cond_.signal();
+    }
+  }
+  return ret;
+}
+
+int ObBackupFileUploadPipeline::wait_all()
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("upload pipeline do not init", K(ret));
+  }
+  while (OB_SUCC(ret) && !is_empty()) {
+    if (OB_FAIL(pop_head_())) {
+      LOG_WARN("failed to wait upload task", K(ret), KPC(this));
+    }
+  }
+  return ret;
+}
+
+int ObBackupFileUploadPipeline::pop_head_()
+{
+  int ret = OB_SUCCESS;
+  ObThreadCondGuard guard(cond_);
+  Task &head_task = tasks_[head_ % task_cnt_];
+  while (!head_task.is_done_ && !has_set_stop()) {
+    cond_.wait(WAIT_INTERVAL_MS);
+  }
+  if (!head_task.is_done_) {
+    ret = OB_IN_STOP_STATE;
+    LOG_WARN("upload pipeline is stopped", K(ret), K(head_task), KPC(this));
+  } else {
+    ret = head_task.ret_;
+    head_task.is_done_ = false;
+    ++head_;
+  }
+  return ret;
+}
+
 /* ObBackupFileWriteCtx */
 
 ObBackupFileWriteCtx::ObBackupFileWriteCtx()
@@ -270,24 +497,28 @@ ObBackupFileWriteCtx::ObBackupFileWriteCtx()
       io_fd_(),
       dev_handle_(NULL),
       data_buffer_("BackupCtx"),
-      bandwidth_throttle_(NULL)
+      bandwidth_throttle_(NULL),
+      upload_pipeline_()
 {}
 
 ObBackupFileWriteCtx::~ObBackupFileWriteCtx()
 {}
 
 int ObBackupFileWriteCtx::open(const int64_t max_file_size, const common::ObIOFd &io_fd,
-    common::ObIODevice &dev_handle, common::ObInOutBandwidthThrottle &bandwidth_throttle)
+    common::ObIODevice &dev_handle, common::ObInOutBandwidthThrottle &bandwidth_throttle,
+    const int64_t io_thread_cnt)
 {
   int ret = OB_SUCCESS;
   if (IS_INIT) {
     ret = OB_INIT_TWICE;
     LOG_WARN("backup data ctx init twice", K(ret));
-  } else if (max_file_size < 0 || !io_fd.is_valid()) {
+  } else if (max_file_size < 0 || !io_fd.is_valid() || io_thread_cnt < 0) {
     ret = OB_INVALID_ARGUMENT;
-    LOG_WARN("get invalid args", K(ret), K(max_file_size), K(io_fd));
+    LOG_WARN("get invalid args", K(ret), K(max_file_size), K(io_fd), K(io_thread_cnt));
   } else if (OB_FAIL(data_buffer_.ensure_space(OB_DEFAULT_MACRO_BLOCK_SIZE))) {
     LOG_WARN("failed to ensure space", K(ret));
+  } else if (io_thread_cnt > 0 && OB_FAIL(upload_pipeline_.init(io_thread_cnt, io_fd, dev_handle))) {
+    LOG_WARN("failed to init upload pipeline", K(ret), K(io_thread_cnt), K(io_fd));
   } else {
     file_size_ = 0;
     max_file_size_ = max_file_size;
@@ -357,6 +588,15 @@ int ObBackupFileWriteCtx::flush_buffer_(const bool is_last_part)
   } else if (OB_ISNULL(dev_handle_)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("dev handle should not be null", K(ret));
+  } else if (upload_pipeline_.is_inited()) {
+    if (0 == data_buffer_.length()) {
+      // do nothing
+    } else if (OB_FAIL(upload_pipeline_.submit(offset, data_buffer_))) {
+      LOG_WARN("failed to submit data buffer", K(ret), K(offset), K(data_buffer_));
+    } else {
+      file_size_ += data_buffer_.length();
+      data_buffer_.reuse();
+    }
   } else if (OB_FAIL(dev_handle_->pwrite(io_fd_, offset, data_buffer_.length(), data_buffer_.data(), write_size))) {
     LOG_WARN("failed to write data buffer", K(ret), K(data_buffer_));
   } else if (data_buffer_.length() != write_size) {
@@ -377,6 +617,9 @@ int ObBackupFileWriteCtx::commit_file_()
     LOG_WARN("dev handle should not be null", K(ret));
   } else if (OB_FAIL(flush_buffer_(true /*is_last_part*/))) {
     LOG_WARN("failed to flush buffer", K(ret));
+  } else if (upload_pipeline_.is_inited() && OB_FAIL(upload_pipeline_.wait_all())) {
+    LOG_WARN("failed to wait upload pipeline", K(ret), K_(upload_pipeline));
+  } else if (FALSE_IT(upload_pipeline_.destroy())) {
   } else if (OB_FAIL(dev_handle_->close(io_fd_))) {
     LOG_WARN("failed to close file", K(ret), K_(io_fd));
   } else {
@@ -400,6 +643,7 @@ ObBackupDataCtx::ObBackupDataCtx()
       meta_index_buffer_node_(),
       file_trailer_(),
       tmp_buffer_("BackupCtx"),
+      compress_buffer_("BackupCtx"),
       bandwidth_throttle_(NULL)
 {}
 
@@ -550,12 +794,24 @@ int ObBackupDataCtx::prepare_file_write_ctx_(
     LOG_WARN("failed to get macro block backup path", K(ret), K(file_id));
   } else if (OB_FAIL(open_file_writer_(backup_path))) {
     LOG_WARN("failed to open file writer", K(ret), K(backup_path));
-  } else if (OB_FAIL(file_write_ctx_.open(data_file_size, io_fd_, *dev_handle_, *bandwidth_throttle_))) {
+  } else if (OB_FAIL(file_write_ctx_.open(
+                 data_file_size, io_fd_, *dev_handle_, *bandwidth_throttle_, get_io_thread_count_()))) {
     LOG_WARN("failed to open file write ctx", K(ret), K(param), K(type), K(backup_path), K(data_file_size), K(file_id));
   }
   return ret;
 }
 
+int64_t ObBackupDataCtx::get_io_thread_count_() const
+{
+  int64_t thread_cnt = GCONF._backup_io_thread_count;
+  const share::ObBackupStorageInfo *storage_info = param_.backup_dest_.get_storage_info();
+  if (thread_cnt > 0 && (OB_ISNULL(storage_info) || OB_STORAGE_FILE != storage_info->device_type_)) {
+    // object storage only appends parts in order
+    thread_cnt = 1;
+  }
+  return thread_cnt;
+}
+
 int ObBackupDataCtx::get_macro_block_backup_path_(const int64_t file_id, share::ObBackupPath &backup_path)
 {
   int ret = OB_SUCCESS;
@@ -804,14 +1060,28 @@ int ObBackupDataCtx::write_index_list_(
   tmp_buffer_.reuse();
   const int64_t header_len = sizeof(ObBackupCommonHeader);
   ObBackupCommonHeader *common_header = NULL;
+  int64_t data_length = 0;
+  const char *block_data = NULL;
+  int64_t block_length = 0;
+  ObCompressorType compressor_type = ObCompressorType::NONE_COMPRESSOR;
   if (index_list.empty()) {
     // do nothing
   } else if (OB_FAIL(tmp_buffer_.advance_zero(header_len))) {
     LOG_WARN("advance failed", K(ret), K(header_len));
   } else if (OB_FAIL(encode_index_to_buffer_<IndexType>(index_list, tmp_buffer_))) {
     LOG_WARN("failed to encode index to buffer", K(ret), K(index_list));
+  } else if (FALSE_IT(data_length = tmp_buffer_.length() - header_len)) {
+  } else if (OB_FAIL(compress_block_data_(
+                 tmp_buffer_.data() + header_len, data_length, block_data, block_length, compressor_type))) {
+    LOG_WARN("failed to compress index block", K(ret), K(data_length));
+  } else if (ObCompressorType::NONE_COMPRESSOR != compressor_type && OB_FAIL(tmp_buffer_.set_pos(header_len))) {
+    LOG_WARN("failed to set pos", K(ret), K(header_len));
+  } else if (ObCompressorType::NONE_COMPRESSOR != compressor_type
+      && OB_FAIL(tmp_buffer_.write(block_data, block_length))) {
+    LOG_WARN("failed to write compressed index block", K(ret), K(block_length));
   } else if (FALSE_IT(common_header = reinterpret_cast<ObBackupCommonHeader *>(tmp_buffer_.data()))) {
-  } else if (OB_FAIL(build_common_header_(index_type, tmp_buffer_.length() - header_len, 0, common_header))) {
+  } else if (OB_FAIL(build_common_header_(
+                 index_type, data_length, block_length, compressor_type, 0, common_header))) {
     LOG_WARN("failed to build common header", K(ret), K(tmp_buffer_));
   } else if (OB_FAIL(common_header->set_checksum(
                  tmp_buffer_.data() + common_header->header_length_, tmp_buffer_.length() - header_len))) {
@@ -833,28 +1103,82 @@ int ObBackupDataCtx::build_common_header_(const ObBackupBlockType &block_type, c
   return build_common_header(block_type, data_length, align_length, common_header);
 }
 
+int ObBackupDataCtx::compress_block_data_(const char *data, const int64_t length, const char *&block_data,
+    int64_t &block_length, common::ObCompressorType &compressor_type)
+{
+  int ret = OB_SUCCESS;
+  common::ObCompressor *compressor = NULL;
+  int64_t max_overflow_size = 0;
+  int64_t zlength = 0;
+  block_data = data;
+  block_length = length;
+  compressor_type = ObCompressorType::NONE_COMPRESSOR;
+  if (OB_ISNULL(data) || length < 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("get invalid args", K(ret), KP(data), K(length));
+  } else if (!GCONF._enable_backup_meta_compression || 0 == length) {
+    // do nothing
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(BLOCK_COMPRESSOR_TYPE, compressor))) {
+    LOG_WARN("failed to get compressor", K(ret));
+  } else if (OB_FAIL(compressor->get_max_overflow_size(length, max_overflow_size))) {
+    LOG_WARN("failed to get max overflow size", K(ret), K(length));
+  } else if (OB_FAIL(compress_buffer_.ensure_space(length + max_overflow_size))) {
+    LOG_WARN("failed to ensure space", K(ret), K(length), K(max_overflow_size));
+  } else if (OB_FAIL(compressor->compress(data, length, compress_buffer_.data(), compress_buffer_.capacity(), zlength))) {
+    LOG_WARN("failed to compress block data", K(ret), K(length));
+  } else if (zlength >= length) {
+    // keep the data uncompressed
+  } else {
+    block_data = compress_buffer_.data();
+    block_length = zlength;
+    compressor_type = BLOCK_COMPRESSOR_TYPE;
+  }
+  return ret;
+}
+
+int ObBackupDataCtx::build_common_header_(const ObBackupBlockType &block_type, const int64_t data_length,
+    const int64_t data_zlength, const common::ObCompressorType compressor_type, const int64_t align_length,
+    ObBackupCommonHeader *&common_header)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(build_common_header(block_type, data_length, align_length, common_header))) {
+    LOG_WARN("failed to build common header", K(ret), K(block_type), K(data_length), K(align_length));
+  } else {
+    common_header->compressor_type_ = compressor_type;
+    common_header->data_zlength_ = data_zlength;
+  }
+  return ret;
+}
+
 int ObBackupDataCtx::write_data_align_(
     const blocksstable::ObBufferReader &reader, const ObBackupBlockType &block_type, const int64_t alignment)
 {
   int ret = OB_SUCCESS;
   tmp_buffer_.reuse();
   const int64_t header_len = sizeof(ObBackupCommonHeader);
-  const int64_t align_size = common::upper_align(header_len + reader.length(), alignment);
-  const int64_t align_length = align_size - reader.length() - header_len;
   ObBackupCommonHeader *common_header = NULL;
+  const char *block_data = reader.data();
+  int64_t block_length = reader.length();
+  ObCompressorType compressor_type = ObCompressorType::NONE_COMPRESSOR;
+  int64_t align_length = 0;
   if (!reader.is_valid()) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("get invalid args", K(ret), K(reader));
+  } else if (BACKUP_BLOCK_META_DATA == block_type
+      && OB_FAIL(compress_block_data_(reader.data(), reader.length(), block_data, block_length, compressor_type))) {
+    LOG_WARN("failed to compress meta data", K(ret), K(reader));
+  } else if (FALSE_IT(align_length = common::upper_align(header_len + block_length, alignment) - block_length - header_len)) {
   } else if (OB_FAIL(tmp_buffer_.advance_zero(header_len))) {
     LOG_WARN("advance failed", K(ret), K(header_len));
-  } else if (OB_FAIL(tmp_buffer_.write(reader.data(), reader.length()))) {
-    LOG_WARN("failed to write data", K(ret), K(reader));
+  } else if (OB_FAIL(tmp_buffer_.write(block_data, block_length))) {
+    LOG_WARN("failed to write data", K(ret), K(reader), K(block_length));
   } else if (OB_FAIL(tmp_buffer_.advance_zero(align_length))) {
     LOG_WARN("failed to advance zero", K(ret), K(align_length));
   } else if (FALSE_IT(common_header = reinterpret_cast<ObBackupCommonHeader *>(tmp_buffer_.data()))) {
-  } else if (OB_FAIL(build_common_header_(block_type, reader.length(), align_length, common_header))) {
+  } else if (OB_FAIL(build_common_header_(
+                 block_type, reader.length(), block_length, compressor_type, align_length, common_header))) {
     LOG_WARN("failed to build common header", K(ret), K(block_type), K(reader), K(align_length));
-  } else if (OB_FAIL(common_header->set_checksum(tmp_buffer_.data() + common_header->header_length_, reader.length()))) {
+  } else if (OB_FAIL(common_header->set_checksum(tmp_buffer_.data() + common_header->header_length_, block_length))) {
     LOG_WARN("failed to set common header checksum", K(ret), K(tmp_buffer_), K(reader), K(*common_header));
   }
   return ret;
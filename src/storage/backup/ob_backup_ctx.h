@@ -20,7 +20,9 @@
 #include "lib/lock/ob_mutex.h"
 #include "lib/lock/ob_thread_cond.h"
 #include "lib/utility/utility.h"
+#include "lib/compress/ob_compressor_pool.h"
 #include "share/ob_ls_id.h"
+#include "share/ob_thread_pool.h"
 #include "share/backup/ob_backup_path.h"
 #include "storage/backup/ob_backup_reader.h"
 #include "storage/backup/ob_backup_data_struct.h"
@@ -128,12 +130,68 @@ int ObSimpleBackupStatMgr::print_missing_items_(const common::ObIArray<T> &missi
   return ret;
 }
 
+// Uploads flushed buffers of a backup file in background threads, so that the backup thread fills the next
+// buffer while the previous ones are being written. Each buffer is written at its own offset, workers write
+// concurrently if there is more than one thread, so use one thread for storage that only appends in order.
+class ObBackupFileUploadPipeline : public share::ObThreadPool
+{
+public:
+  struct Task
+  {
+  public:
+    Task();
+    ~Task() = default;
+    TO_STRING_KV(K_(offset), "length", buffer_.length(), K_(ret), K_(is_done));
+  public:
+    blocksstable::ObSelfBufferWriter buffer_;
+    int64_t offset_;
+    int ret_;
+    bool is_done_;
+  };
+public:
+  static const int64_t MAX_THREAD_CNT = 8;
+  ObBackupFileUploadPipeline();
+  virtual ~ObBackupFileUploadPipeline();
+  int init(const int64_t thread_cnt, const common::ObIOFd &io_fd, common::ObIODevice &dev_handle);
+  void destroy();
+  virtual void run1() override;
+  // following interfaces are only called by the backup thread
+  // copy the buffer into a task, wait for the oldest task if all tasks are in flight
+  int submit(const int64_t offset, const blocksstable::ObSelfBufferWriter &buffer);
+  // wait until all submitted buffers are written
+  int wait_all();
+  OB_INLINE bool is_inited() const { return is_inited_; }
+  OB_INLINE bool is_empty() const { return head_ == tail_; }
+  OB_INLINE bool is_full() const { return tail_ - head_ >= task_cnt_; }
+  TO_STRING_KV(K_(is_inited), K_(task_cnt), K_(head), K_(next), K_(written), K_(tail), K_(write_ret), K_(io_fd));
+private:
+  int pop_head_();
+  int write_task_(const int64_t task_idx, Task &task);
+private:
+  static const int64_t TASK_CNT_PER_THREAD = 2;
+  static const int64_t WAIT_INTERVAL_MS = 10;
+  bool is_inited_;
+  int64_t task_cnt_;
+  Task *tasks_;
+  int64_t head_; // oldest task not popped
+  int64_t next_; // next task to take by an upload thread
+  int64_t written_; // next task to write to the device, device writes are in submission order
+  int64_t tail_; // next task to submit
+  int write_ret_; // first failure of device writes, the following tasks are not written
+  common::ObIOFd io_fd_;
+  common::ObIODevice *dev_handle_;
+  common::ObThreadCond cond_;
+  common::ObArenaAllocator allocator_;
+  DISALLOW_COPY_AND_ASSIGN(ObBackupFileUploadPipeline);
+};
+
 struct ObBackupFileWriteCtx {
 public:
   ObBackupFileWriteCtx();
   virtual ~ObBackupFileWriteCtx();
+  // buffers are written by io_thread_cnt background threads, or by the caller if it is 0
   int open(const int64_t max_file_size, const common::ObIOFd &io_fd, common::ObIODevice &device_handle,
-      common::ObInOutBandwidthThrottle &bandwidth_throttle);
+      common::ObInOutBandwidthThrottle &bandwidth_throttle, const int64_t io_thread_cnt = 0);
   bool is_opened() const
   {
     return is_inited_;
@@ -159,6 +217,7 @@ private:
   common::ObIODevice *dev_handle_;
   blocksstable::ObSelfBufferWriter data_buffer_;
   common::ObInOutBandwidthThrottle *bandwidth_throttle_;
+  ObBackupFileUploadPipeline upload_pipeline_;
   DISALLOW_COPY_AND_ASSIGN(ObBackupFileWriteCtx);
 };
 
@@ -184,6 +243,7 @@ private:
   {
     return GCONF.backup_data_file_size;
   }
+  int64_t get_io_thread_count_() const;
   int open_file_writer_(const share::ObBackupPath &backup_path);
   int prepare_file_write_ctx_(
       const ObLSBackupDataParam &param, const share::ObBackupDataType &type, const int64_t file_id);
@@ -211,6 +271,12 @@ private:
   int write_index_list_(const ObBackupBlockType &index_type, const common::ObIArray<IndexType> &index_list);
   int build_common_header_(const ObBackupBlockType &block_type, const int64_t data_length, const int64_t align_lenght,
       share::ObBackupCommonHeader *&common_header);
+  int build_common_header_(const ObBackupBlockType &block_type, const int64_t data_length, const int64_t data_zlength,
+      const common::ObCompressorType compressor_type, const int64_t align_length,
+      share::ObBackupCommonHeader *&common_header);
+  // compress index or meta data into compress_buffer_, data is kept as is if compression is disabled or useless
+  int compress_block_data_(const char *data, const int64_t length, const char *&block_data, int64_t &block_length,
+      common::ObCompressorType &compressor_type);
   int write_data_align_(
       const blocksstable::ObBufferReader &buffer, const ObBackupBlockType &block_type, const int64_t alignment);
   int check_trailer_(const ObBackupDataFileTrailer &trailer);
@@ -218,6 +284,7 @@ private:
 
 private:
   static const int64_t TMP_FILE_READ_TIMEOUT_MS = 5000;  // 5s
+  static const common::ObCompressorType BLOCK_COMPRESSOR_TYPE = common::ObCompressorType::ZSTD_1_3_8_COMPRESSOR;
 
 public:
   bool is_inited_;
@@ -232,6 +299,7 @@ public:
   ObBackupIndexBufferNode meta_index_buffer_node_;
   ObBackupDataFileTrailer file_trailer_;
   blocksstable::ObSelfBufferWriter tmp_buffer_;
+  blocksstable::ObSelfBufferWriter compress_buffer_;
   common::ObInOutBandwidthThrottle *bandwidth_throttle_;
   DISALLOW_COPY_AND_ASSIGN(ObBackupDataCtx);
 };
@@ -15,6 +15,7 @@
 #include "storage/backup/ob_backup_data_struct.h"
 #include "common/ob_record_header.h"
 #include "lib/ob_errno.h"
+#include "lib/compress/ob_compressor_pool.h"
 #include "lib/oblog/ob_log_module.h"
 #include "storage/backup/ob_backup_task.h"
 #include "storage/blocksstable/ob_logic_macro_id.h"
@@ -1152,6 +1153,40 @@ int build_common_header(const int64_t data_type, const int64_t data_length, cons
   return ret;
 }
 
+int get_backup_block_data(const share::ObBackupCommonHeader &common_header, const char *buf,
+    common::ObIAllocator &allocator, const char *&data, int64_t &data_length)
+{
+  int ret = OB_SUCCESS;
+  const ObCompressorType compressor_type = static_cast<ObCompressorType>(common_header.compressor_type_);
+  common::ObCompressor *compressor = NULL;
+  char *decompress_buf = NULL;
+  int64_t decompress_size = 0;
+  data = NULL;
+  data_length = 0;
+  if (OB_ISNULL(buf)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("get invalid args", K(ret), KP(buf), K(common_header));
+  } else if (!common_header.is_compresssed_data()) {
+    data = buf;
+    data_length = common_header.data_length_;
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(compressor_type, compressor))) {
+    LOG_WARN("failed to get compressor", K(ret), K(common_header));
+  } else if (OB_ISNULL(decompress_buf = static_cast<char *>(allocator.alloc(common_header.data_length_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc decompress buf", K(ret), K(common_header));
+  } else if (OB_FAIL(compressor->decompress(buf, common_header.data_zlength_, decompress_buf,
+                 common_header.data_length_, decompress_size))) {
+    LOG_WARN("failed to decompress block data", K(ret), K(common_header));
+  } else if (decompress_size != common_header.data_length_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("decompress size not match", K(ret), K(decompress_size), K(common_header));
+  } else {
+    data = decompress_buf;
+    data_length = decompress_size;
+  }
+  return ret;
+}
+
 int build_multi_level_index_header(
     const int64_t index_type, const int64_t index_level, ObBackupMultiLevelIndexHeader &header)
 {
@@ -630,6 +630,9 @@ int build_backup_file_header_buffer(const ObBackupFileHeader &file_header, const
     blocksstable::ObBufferReader &buffer_reader);
 int build_common_header(const int64_t data_type, const int64_t data_length, const int64_t align_length,
     share::ObBackupCommonHeader *&common_header);
+// get the data following the common header, which is decompressed into memory of allocator if it is compressed
+int get_backup_block_data(const share::ObBackupCommonHeader &common_header, const char *buf,
+    common::ObIAllocator &allocator, const char *&data, int64_t &data_length);
 int build_multi_level_index_header(
     const int64_t index_type, const int64_t index_level, ObBackupMultiLevelIndexHeader &header);
 
@@ -332,10 +332,14 @@ int ObIBackupIndexIterator::parse_from_index_blocks_impl_(const int64_t offset,
   IndexType index;
   const ObBackupCommonHeader *common_header = NULL;
   int64_t cur_block_end_index = 0;
+  ObArenaAllocator allocator;
   while (OB_SUCC(ret) && buffer_reader.remain() > 0) {
     common_header = NULL;
     int64_t start_pos = buffer_reader.pos();
     int64_t first_index = cur_block_end_index;
+    const char *data = NULL;
+    int64_t data_length = 0;
+    allocator.reuse();
     if (OB_FAIL(buffer_reader.get(common_header))) {
       LOG_WARN("failed to read common header", K(ret));
     } else if (OB_ISNULL(common_header)) {
@@ -343,15 +347,19 @@ int ObIBackupIndexIterator::parse_from_index_blocks_impl_(const int64_t offset,
       LOG_WARN("common header is null", K(ret));
     } else if (OB_FAIL(common_header->check_valid())) {
       LOG_WARN("common header is not valid", K(ret));
-    } else if (common_header->data_length_ > buffer_reader.remain()) {
+    } else if (common_header->data_zlength_ > buffer_reader.remain()) {
       ret = OB_BUF_NOT_ENOUGH;
       LOG_WARN("buffer reader not enough", K(ret));
-    } else if (OB_FAIL(common_header->check_data_checksum(buffer_reader.current(), common_header->data_length_))) {
+    } else if (OB_FAIL(common_header->check_data_checksum(buffer_reader.current(), common_header->data_zlength_))) {
       LOG_WARN("failed to check data checksum", K(ret), K(buffer_reader));
+    } else if (OB_FAIL(get_backup_block_data(*common_header, buffer_reader.current(), allocator, data, data_length))) {
+      LOG_WARN("failed to get backup block data", K(ret), K(*common_header));
+    } else if (OB_FAIL(buffer_reader.advance(common_header->data_zlength_))) {
+      LOG_WARN("buffer reader buf not enough", K(ret), K(*common_header));
     } else {
-      int64_t end_pos = buffer_reader.pos() + common_header->data_length_;
-      for (int64_t i = 0; OB_SUCC(ret) && buffer_reader.pos() < end_pos; ++i) {
-        if (OB_FAIL(buffer_reader.read_serialize(index))) {
+      blocksstable::ObBufferReader block_reader(data, data_length);
+      while (OB_SUCC(ret) && block_reader.remain() > 0) {
+        if (OB_FAIL(block_reader.read_serialize(index))) {
           LOG_WARN("failed to read serialize", K(ret));
         } else if (OB_FAIL(index_list.push_back(index))) {
           LOG_WARN("failed to push back", K(ret), K(index));
@@ -42,6 +42,8 @@ int ObLSBackupRestoreUtil::read_tablet_meta(const common::ObString &path, const
   } else {
     blocksstable::ObBufferReader buffer_reader(buf, meta_index.length_);
     const ObBackupCommonHeader *common_header = NULL;
+    const char *data = NULL;
+    int64_t data_length = 0;
     int64_t pos = 0;
     if (OB_FAIL(buffer_reader.get(common_header))) {
       LOG_WARN("failed to get common_header", K(ret), K(path), K(meta_index), K(buffer_reader));
@@ -55,7 +57,9 @@ int ObLSBackupRestoreUtil::read_tablet_meta(const common::ObString &path, const
       LOG_WARN("buffer_reader not enough", K(ret), K(path), K(meta_index), K(buffer_reader));
     } else if (OB_FAIL(common_header->check_data_checksum(buffer_reader.current(), common_header->data_zlength_))) {
       LOG_WARN("failed to check data checksum", K(ret), K(*common_header), K(path), K(meta_index), K(buffer_reader));
-    } else if (OB_FAIL(tablet_meta.deserialize(buffer_reader.current(), common_header->data_zlength_, pos))) {
+    } else if (OB_FAIL(get_backup_block_data(*common_header, buffer_reader.current(), allocator, data, data_length))) {
+      LOG_WARN("failed to get backup block data", K(ret), K(*common_header), K(path), K(meta_index));
+    } else if (OB_FAIL(tablet_meta.deserialize(data, data_length, pos))) {
       LOG_WARN("failed to read data_header", K(ret), K(*common_header), K(path), K(meta_index), K(buffer_reader));
     } else {
       FLOG_INFO("read tablet meta", K(path), K(meta_index), K(tablet_meta));
@@ -84,6 +88,8 @@ int ObLSBackupRestoreUtil::read_sstable_metas(const common::ObString &path, cons
   } else {
     blocksstable::ObBufferReader buffer_reader(buf, meta_index.length_);
     const ObBackupCommonHeader *common_header = NULL;
+    const char *data = NULL;
+    int64_t data_length = 0;
     if (OB_FAIL(buffer_reader.get(common_header))) {
       LOG_WARN("failed to get common_header", K(ret), K(path), K(meta_index), K(buffer_reader));
     } else if (OB_ISNULL(common_header)) {
@@ -96,10 +102,12 @@ int ObLSBackupRestoreUtil::read_sstable_metas(const common::ObString &path, cons
       LOG_WARN("buffer_reader not enough", K(ret), K(path), K(meta_index), K(buffer_reader));
     } else if (OB_FAIL(common_header->check_data_checksum(buffer_reader.current(), common_header->data_zlength_))) {
       LOG_WARN("failed to check data checksum", K(ret), K(*common_header), K(path), K(meta_index), K(buffer_reader));
+    } else if (OB_FAIL(get_backup_block_data(*common_header, buffer_reader.current(), allocator, data, data_length))) {
+      LOG_WARN("failed to get backup block data", K(ret), K(*common_header), K(path), K(meta_index));
     } else {
       int64_t total_pos = 0;
-      char *tmp_buf = buffer_reader.current();
-      const int64_t total_data_size = common_header->data_zlength_;
+      const char *tmp_buf = data;
+      const int64_t total_data_size = data_length;
       ObBackupSSTableMeta sstable_meta;
       while (OB_SUCC(ret) && total_data_size - total_pos > 0) {
         int64_t pos = 0;
@@ -141,6 +149,8 @@ int ObLSBackupRestoreUtil::read_macro_block_id_mapping_metas(const common::ObStr
   } else {
     blocksstable::ObBufferReader buffer_reader(buf, meta_index.length_);
     const ObBackupCommonHeader *common_header = NULL;
+    const char *data = NULL;
+    int64_t data_length = 0;
     int64_t pos = 0;
     if (OB_FAIL(buffer_reader.get(common_header))) {
       LOG_WARN("failed to get common_header", K(ret), K(path), K(meta_index), K(buffer_reader));
@@ -154,7 +164,9 @@ int ObLSBackupRestoreUtil::read_macro_block_id_mapping_metas(const common::ObStr
       LOG_WARN("buffer_reader not enough", K(ret), K(path), K(meta_index), K(buffer_reader));
     } else if (OB_FAIL(common_header->check_data_checksum(buffer_reader.current(), common_header->data_zlength_))) {
       LOG_WARN("failed to check data checksum", K(ret), K(*common_header), K(path), K(meta_index), K(buffer_reader));
-    } else if (OB_FAIL(id_mappings_meta.deserialize(buffer_reader.current(), common_header->data_zlength_, pos))) {
+    } else if (OB_FAIL(get_backup_block_data(*common_header, buffer_reader.current(), allocator, data, data_length))) {
+      LOG_WARN("failed to get backup block data", K(ret), K(*common_header), K(path), K(meta_index));
+    } else if (OB_FAIL(id_mappings_meta.deserialize(data, data_length, pos))) {
       LOG_WARN("failed to read data_header", K(ret), K(*common_header), K(path), K(meta_index), K(buffer_reader));
     } else {
       for (int64_t i = 0; i < id_mappings_meta.sstable_count_; ++i) {
@@ -29,6 +29,9 @@ int64_t size_array [] = {                \
   sizeof(ObStringPrefix##Item),          \
   sizeof(ObColumnEqual##Item),           \
   sizeof(ObInterColSubStr##Item),        \
+  sizeof(ObTimestampDelta##Item),        \
+  sizeof(ObFloatPacking##Item),          \
+  sizeof(ObSymbolString##Item),          \
 }                                        \
 
 DEF_SIZE_ARRAY(Encoder, encoder_sizes);
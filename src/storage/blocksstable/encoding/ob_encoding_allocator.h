@@ -27,6 +27,9 @@
 #include "ob_string_prefix_encoder.h"
 #include "ob_column_equal_encoder.h"
 #include "ob_inter_column_substring_encoder.h"
+#include "ob_timestamp_delta_encoder.h"
+#include "ob_float_packing_encoder.h"
+#include "ob_symbol_string_encoder.h"
 #include "ob_raw_decoder.h"
 #include "ob_dict_decoder.h"
 #include "ob_rle_decoder.h"
@@ -37,6 +40,9 @@
 #include "ob_string_prefix_decoder.h"
 #include "ob_column_equal_decoder.h"
 #include "ob_inter_column_substring_decoder.h"
+#include "ob_timestamp_delta_decoder.h"
+#include "ob_float_packing_decoder.h"
+#include "ob_symbol_string_decoder.h"
 
 namespace oceanbase
 {
@@ -88,6 +94,9 @@ private:
   Pool str_prefix_pool_;
   Pool column_equal_pool_;
   Pool column_substr_pool_;
+  Pool timestamp_delta_pool_;
+  Pool float_packing_pool_;
+  Pool symbol_string_pool_;
   Pool *pools_[ObColumnHeader::MAX_TYPE];
   int64_t pool_cnt_;
 };
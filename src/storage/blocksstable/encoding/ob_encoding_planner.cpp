@@ -0,0 +1,306 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_encoding_planner.h"
+#include "ob_encoding_hash_util.h"
+#include "ob_symbol_string_encoder.h"
+#include "ob_float_packing_encoder.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+using namespace common;
+
+static OB_INLINE int64_t bit_cnt(const uint64_t v)
+{
+  return 0 == v ? 0 : sizeof(v) * CHAR_BIT - __builtin_clzl(v);
+}
+
+static OB_INLINE int64_t packed_size(const int64_t cnt, const int64_t bits)
+{
+  return (cnt * bits + CHAR_BIT - 1) / CHAR_BIT;
+}
+
+int ObEncodingPlanner::plan(const ObColumnEncodingCtx &cc,
+    const share::schema::ObColDesc &col_desc, const int64_t row_cnt)
+{
+  int ret = OB_SUCCESS;
+  candidate_cnt_ = 0;
+  stat_.reset();
+  if (OB_ISNULL(cc.ht_) || OB_ISNULL(cc.col_datums_) || OB_ISNULL(cc.encoding_ctx_)
+      || OB_UNLIKELY(row_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(cc.ht_), KP(cc.col_datums_),
+        KP(cc.encoding_ctx_), K(row_cnt));
+  } else {
+    const ObObjType type = col_desc.col_type_.get_type();
+    const ObObjTypeClass tc = ob_obj_type_class(type);
+    const ObObjTypeStoreClass sc = get_store_class_map()[tc];
+    const int64_t type_store_size = get_type_size_map()[type];
+    const bool is_integer = ObIntSC == sc || ObUIntSC == sc;
+    const bool is_float = ObFloatTC == tc || ObDoubleTC == tc;
+    const int64_t distinct_cnt = cc.ht_->distinct_cnt();
+    const int64_t value_cnt = row_cnt - cc.null_cnt_ - cc.nope_cnt_;
+    sample(cc, sc, tc, type_store_size);
+
+    // distinct values are stored once and referenced by (distinct count + null + nop) refs
+    int64_t dict_size = 0;
+    if (is_integer) {
+      dict_size = distinct_cnt * ((bit_cnt(cc.max_integer_) + CHAR_BIT - 1) / CHAR_BIT);
+    } else if (cc.fix_data_size_ >= 0) {
+      dict_size = distinct_cnt * cc.fix_data_size_;
+    } else {
+      dict_size = cc.dict_var_data_size_ + distinct_cnt * sizeof(uint32_t);
+    }
+    const int64_t ref_bits = bit_cnt(distinct_cnt + 2);
+    const int64_t ref_size = (ref_bits + CHAR_BIT - 1) / CHAR_BIT;
+    add_candidate(cc, ObColumnHeader::DICT, dict_size + packed_size(row_cnt, ref_bits));
+
+    if (distinct_cnt <= row_cnt / 2) {
+      const int64_t run_cnt = stat_.pair_cnt_ > 0
+          ? MAX(1, row_cnt * stat_.change_cnt_ / stat_.pair_cnt_)
+          : row_cnt;
+      add_candidate(cc, ObColumnHeader::RLE,
+          dict_size + run_cnt * (sizeof(uint16_t) + ref_size));
+      // const stores the most frequent value, others are exceptions
+      int64_t max_cnt = 0;
+      FOREACH(l, *cc.ht_) {
+        max_cnt = MAX(max_cnt, l->size_);
+      }
+      add_candidate(cc, ObColumnHeader::CONST,
+          dict_size + (row_cnt - max_cnt) * (sizeof(uint16_t) + ref_size));
+    }
+
+    if (is_float) {
+      int64_t width = 0 == stat_.xor_bits_
+          ? 0 : bit_cnt(stat_.xor_bits_) - __builtin_ctzl(stat_.xor_bits_);
+      if (stat_.decimal_exponent_ >= 0) {
+        width = MIN(width, bit_cnt(stat_.decimal_range_));
+      }
+      add_candidate(cc, ObColumnHeader::FLOAT_PACKING,
+          packed_size(row_cnt, width) + sizeof(uint64_t));
+    } else if (is_integer) {
+      // one more bit for the sign of the deviation
+      add_candidate(cc, ObColumnHeader::TIMESTAMP_DELTA,
+          packed_size(row_cnt, bit_cnt(stat_.max_deviation_) + 1) + 2 * sizeof(uint64_t));
+    }
+    if (is_integer) {
+      add_candidate(cc, ObColumnHeader::INTEGER_BASE_DIFF,
+          packed_size(row_cnt, bit_cnt(cc.max_integer_ - stat_.min_integer_)) + sizeof(uint64_t));
+    }
+
+    if (is_string_encoding_valid(sc) && value_cnt > 0 && stat_.value_cnt_ > 0) {
+      const int64_t index_size = value_cnt * sizeof(uint16_t);
+      const int64_t avg_prefix_len = stat_.prefix_len_ / stat_.value_cnt_;
+      if (distinct_cnt > row_cnt / 2) {
+        // a symbol table usually saves 1/3 ~ 1/2 of the space for urls, emails and ids
+        add_candidate(cc, ObColumnHeader::SYMBOL_PACKING,
+            cc.var_data_size_ * 3 / 5 + index_size
+            + ObStringSymbolTable::MAX_SYMBOL_CNT * sizeof(ObStringSymbol));
+      }
+      if (cc.fix_data_size_ > 0) {
+        add_candidate(cc, ObColumnHeader::STRING_DIFF,
+            cc.fix_data_size_ + value_cnt * stat_.diff_len_);
+      }
+      add_candidate(cc, ObColumnHeader::STRING_PREFIX,
+          MAX(0, cc.var_data_size_ - value_cnt * avg_prefix_len) + index_size);
+      if (stat_.byte_kind_cnt_ <= (1 << (CHAR_BIT / 2))) {
+        add_candidate(cc, ObColumnHeader::HEX_PACKING, cc.var_data_size_ / 2 + index_size);
+      }
+    }
+    LOG_DEBUG("encoding plan", K(row_cnt), K(distinct_cnt), K(cc), K(*this));
+  }
+  return ret;
+}
+
+void ObEncodingPlanner::sample(const ObColumnEncodingCtx &cc, const ObObjTypeStoreClass sc,
+    const ObObjTypeClass tc, const int64_t type_store_size)
+{
+  const ObColDatums &datums = *cc.col_datums_;
+  const int64_t row_cnt = datums.count();
+  const bool is_integer = ObIntSC == sc || ObUIntSC == sc;
+  const bool is_float = ObFloatTC == tc || ObDoubleTC == tc;
+  const bool is_string = is_string_encoding_valid(sc);
+  const uint64_t integer_mask = is_integer && type_store_size >= 0
+      && type_store_size <= static_cast<int64_t>(sizeof(int64_t))
+      ? INTEGER_MASK_TABLE[type_store_size] : UINT64_MAX;
+
+  // min of the column is exact, computed from the distinct values
+  if (is_integer) {
+    stat_.min_integer_ = cc.max_integer_;
+    FOREACH(l, *cc.ht_) {
+      const uint64_t v = l->header_->datum_->get_uint64() & integer_mask;
+      if (v < stat_.min_integer_) {
+        stat_.min_integer_ = v;
+      }
+    }
+  }
+
+  // the line through the first and last value of the column
+  int64_t first_row = 0;
+  int64_t last_row = row_cnt - 1;
+  if (is_integer && !is_float) {
+    while (first_row < row_cnt
+        && (datums.at(first_row).is_null() || datums.at(first_row).is_nop())) {
+      ++first_row;
+    }
+    while (last_row > first_row
+        && (datums.at(last_row).is_null() || datums.at(last_row).is_nop())) {
+      --last_row;
+    }
+  }
+  const bool has_line = is_integer && !is_float && last_row > first_row;
+  const uint64_t line_base = has_line ? datums.at(first_row).get_uint64() & integer_mask : 0;
+  const double line_slope = has_line
+      ? static_cast<double>(static_cast<int64_t>(
+          (datums.at(last_row).get_uint64() & integer_mask) - line_base))
+        / static_cast<double>(last_row - first_row)
+      : 0;
+
+  bool bytes[1 << CHAR_BIT];
+  MEMSET(bytes, 0, sizeof(bytes));
+  uint64_t float_bits[SAMPLE_WINDOW_CNT * SAMPLE_WINDOW_SIZE];
+  int64_t float_cnt = 0;
+  const ObDatum *first = NULL;
+  // small blocks are sampled entirely
+  int64_t window_cnt = SAMPLE_WINDOW_CNT;
+  int64_t window_size = SAMPLE_WINDOW_SIZE;
+  if (row_cnt <= window_cnt * window_size) {
+    window_cnt = 1;
+    window_size = row_cnt;
+  }
+  const int64_t step = row_cnt / window_cnt;
+  for (int64_t w = 0; w < window_cnt; ++w) {
+    const ObDatum *prev = NULL;
+    const ObDatum *prev_value = NULL;
+    for (int64_t i = w * step; i < w * step + window_size && i < row_cnt; ++i) {
+      const ObDatum &datum = datums.at(i);
+      ++stat_.sample_cnt_;
+      if (NULL != prev) {
+        ++stat_.pair_cnt_;
+        if (!ObDatum::binary_equal(*prev, datum)) {
+          ++stat_.change_cnt_;
+        }
+      }
+      prev = &datum;
+      if (datum.is_null() || datum.is_nop()) {
+        continue;
+      }
+      ++stat_.value_cnt_;
+      if (NULL == first) {
+        first = &datum;
+      }
+      if (is_float) {
+        uint64_t v = 0;
+        uint64_t f = 0;
+        MEMCPY(&v, datum.ptr_, datum.len_ < sizeof(v) ? datum.len_ : sizeof(v));
+        MEMCPY(&f, first->ptr_, first->len_ < sizeof(f) ? first->len_ : sizeof(f));
+        stat_.xor_bits_ |= v ^ f;
+        float_bits[float_cnt++] = v;
+      } else if (has_line) {
+        const int64_t offset = static_cast<int64_t>((datum.get_uint64() & integer_mask) - line_base);
+        const int64_t expect = static_cast<int64_t>(line_slope * static_cast<double>(i - first_row));
+        const uint64_t deviation = offset >= expect
+            ? static_cast<uint64_t>(offset - expect) : static_cast<uint64_t>(expect - offset);
+        stat_.max_deviation_ = MAX(stat_.max_deviation_, deviation);
+      } else if (is_string) {
+        for (int64_t j = 0; j < datum.len_; ++j) {
+          bytes[static_cast<unsigned char>(datum.ptr_[j])] = true;
+        }
+        if (NULL != prev_value) {
+          int64_t len = 0;
+          const int64_t max_len = MIN(datum.len_, prev_value->len_);
+          while (len < max_len && datum.ptr_[len] == prev_value->ptr_[len]) {
+            ++len;
+          }
+          stat_.prefix_len_ += len;
+        }
+        if (cc.fix_data_size_ > 0 && datum.len_ == first->len_) {
+          int64_t diff_len = 0;
+          for (int64_t j = 0; j < datum.len_; ++j) {
+            if (datum.ptr_[j] != first->ptr_[j]) {
+              ++diff_len;
+            }
+          }
+          stat_.diff_len_ = MAX(stat_.diff_len_, diff_len);
+        }
+      }
+      prev_value = &datum;
+    }
+  }
+  for (int64_t i = 0; i < ARRAYSIZEOF(bytes); ++i) {
+    if (bytes[i]) {
+      ++stat_.byte_kind_cnt_;
+    }
+  }
+  stat_.decimal_exponent_ = -1;
+  if (is_float) {
+    sample_decimal(float_bits, float_cnt, sizeof(float) == type_store_size);
+  }
+}
+
+// same as ObFloatPackingEncoder::traverse_decimal() on the sampled values
+void ObEncodingPlanner::sample_decimal(const uint64_t *bits, const int64_t cnt,
+    const bool is_float)
+{
+  const double max_exact_int = static_cast<double>(1L << 52);
+  for (int64_t e = 0; e <= ObFloatPackingHeader::MAX_DECIMAL_EXPONENT
+      && stat_.decimal_exponent_ < 0 && cnt > 0; ++e) {
+    bool exact = true;
+    int64_t min_n = INT64_MAX;
+    int64_t max_n = INT64_MIN;
+    for (int64_t i = 0; exact && i < cnt; ++i) {
+      double v = 0;
+      if (is_float) {
+        float f = 0;
+        MEMCPY(&f, &bits[i], sizeof(f));
+        v = f;
+      } else {
+        MEMCPY(&v, &bits[i], sizeof(v));
+      }
+      const double d = v * ObFloatPackingHeader::POW10[e];
+      if (d > -max_exact_int && d < max_exact_int) {
+        const int64_t n = static_cast<int64_t>(d < 0 ? d - 0.5 : d + 0.5);
+        exact = ObFloatPackingHeader::decimal_to_bits(n, e, is_float) == bits[i];
+        min_n = MIN(min_n, n);
+        max_n = MAX(max_n, n);
+      } else {
+        exact = false;
+      }
+    }
+    if (exact) {
+      stat_.decimal_exponent_ = e;
+      stat_.decimal_range_ = static_cast<uint64_t>(max_n) - static_cast<uint64_t>(min_n);
+    }
+  }
+}
+
+void ObEncodingPlanner::add_candidate(const ObColumnEncodingCtx &cc,
+    const ObColumnHeader::Type type, const int64_t size)
+{
+  if (cc.encoding_ctx_->enable_encoding(type) && !cc.detected_encoders_[type]) {
+    int64_t pos = candidate_cnt_;
+    while (pos > 0 && candidates_[pos - 1].size_ > size) {
+      candidates_[pos] = candidates_[pos - 1];
+      --pos;
+    }
+    candidates_[pos].type_ = type;
+    candidates_[pos].size_ = size;
+    ++candidate_cnt_;
+  }
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_ENCODING_PLANNER_H_
+#define OCEANBASE_ENCODING_OB_ENCODING_PLANNER_H_
+
+#include "lib/container/ob_array_wrap.h"
+#include "share/schema/ob_table_param.h"
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "ob_encoding_util.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// Statistics of a column gathered on a sample of the micro block, the sample is several
+// windows of adjacent rows spread over the block, so runs are still visible.
+struct ObColumnSampleStat
+{
+  int64_t sample_cnt_;       // sampled rows
+  int64_t value_cnt_;        // sampled not null values
+  int64_t pair_cnt_;         // sampled pairs of adjacent rows
+  int64_t change_cnt_;       // sampled pairs of adjacent rows with different values
+  int64_t prefix_len_;       // sum of the common prefix length with the previous value
+  int64_t diff_len_;         // bytes differ from the first value, fixed length strings only
+  int64_t byte_kind_cnt_;    // distinct bytes of strings
+  uint64_t min_integer_;
+  uint64_t xor_bits_;        // bits differ from the first value, float and double only
+  int64_t decimal_exponent_; // smallest exponent making values integers, -1 for not decimals
+  uint64_t decimal_range_;   // range of the scaled integers
+  uint64_t max_deviation_;   // max distance to the line through the first and last value
+
+  ObColumnSampleStat() { reset(); }
+  void reset() { memset(this, 0, sizeof(*this)); }
+
+  TO_STRING_KV(K_(sample_cnt), K_(value_cnt), K_(pair_cnt), K_(change_cnt), K_(prefix_len),
+      K_(diff_len), K_(byte_kind_cnt), K_(min_integer), K_(xor_bits),
+      K_(decimal_exponent), K_(decimal_range), K_(max_deviation));
+};
+
+// Estimate the encoded size of each encoding from the prescan result (distinct count,
+// null count, data size) and a sample of the column, so the micro block encoder only
+// builds the most promising encodings instead of trying all of them.
+//
+// Estimations are rough: they are used to rank the encodings, the encoder always compares
+// the real size of the built encoders. Span column encodings (column equal and inter column
+// substring) depend on other columns and are not estimated.
+class ObEncodingPlanner
+{
+public:
+  struct Candidate
+  {
+    ObColumnHeader::Type type_;
+    int64_t size_;
+
+    TO_STRING_KV(K_(type), K_(size));
+  };
+
+  static const int64_t SAMPLE_WINDOW_CNT = 16;
+  static const int64_t SAMPLE_WINDOW_SIZE = 8;
+
+  ObEncodingPlanner() : candidate_cnt_(0), stat_() {}
+  ~ObEncodingPlanner() {}
+
+  // Candidates are sorted by the estimated size in ascending order, encodings disabled by
+  // the encoder option or already detected for the column are skipped.
+  int plan(const ObColumnEncodingCtx &cc, const share::schema::ObColDesc &col_desc,
+      const int64_t row_cnt);
+
+  int64_t get_candidate_cnt() const { return candidate_cnt_; }
+  const Candidate &get_candidate(const int64_t idx) const { return candidates_[idx]; }
+  const ObColumnSampleStat &get_sample_stat() const { return stat_; }
+
+  TO_STRING_KV(K_(stat), "candidates", common::ObArrayWrap<Candidate>(candidates_, candidate_cnt_));
+
+private:
+  void sample(const ObColumnEncodingCtx &cc, const ObObjTypeStoreClass sc,
+      const ObObjTypeClass tc, const int64_t type_store_size);
+  void sample_decimal(const uint64_t *bits, const int64_t cnt, const bool is_float);
+  void add_candidate(const ObColumnEncodingCtx &cc, const ObColumnHeader::Type type,
+      const int64_t size);
+
+private:
+  Candidate candidates_[ObColumnHeader::MAX_TYPE];
+  int64_t candidate_cnt_;
+  ObColumnSampleStat stat_;
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_ENCODING_OB_ENCODING_PLANNER_H_
@@ -29,6 +29,7 @@ const char* OB_ENCODING_LABEL_ROW_BUFFER = "EncodeRowBuffer";
 const char* OB_ENCODING_LABEL_MULTI_PREFIX_TREE = "EncodeMulPreTree";
 const char* OB_ENCODING_LABEL_PREFIX_TREE_FACTORY = "EncodeTreeFactory";
 const char* OB_ENCODING_LABEL_STRING_DIFF = "EncodeStrDiff";
+const char* OB_ENCODING_LABEL_SYMBOL_STRING = "EncodeSymStr";
 
 uint64_t INTEGER_MASK_TABLE[sizeof(int64_t) + 1] = {
   0x0, 0xff, 0xffff, 0xffffff, 0xffffffff,
@@ -0,0 +1,284 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_float_packing_decoder.h"
+
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+using namespace common;
+const ObColumnHeader::Type ObFloatPackingDecoder::type_;
+
+int ObFloatPackingDecoder::decode(ObColumnDecoderCtx &ctx, common::ObObj &cell, const int64_t row_id,
+    const ObBitStream &bs, const char *data, const int64_t len) const
+{
+  int ret = OB_SUCCESS;
+  uint64_t val = STORED_NOT_EXT;
+  const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_) + ctx.col_header_->length_;
+
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(NULL == data || len < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(data), K(len));
+  } else if (ctx.has_extend_value()) {
+    if (OB_FAIL(ObBitStream::get(col_data, row_id * ctx.micro_block_header_->extend_value_bit_,
+        ctx.micro_block_header_->extend_value_bit_, val))) {
+      LOG_WARN("get extend value failed", K(ret), K(bs), K(ctx));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (STORED_NOT_EXT != val) {
+    set_stored_ext_value(cell, static_cast<ObStoredExtValue>(val));
+  } else {
+    if (cell.get_meta() != ctx.obj_meta_) {
+      cell.set_meta_type(ctx.obj_meta_);
+    }
+    cell.v_.uint64_ = get_value(ctx, col_data, get_data_offset(ctx), row_id);
+  }
+  return ret;
+}
+
+int ObFloatPackingDecoder::update_pointer(const char *old_block, const char *cur_block)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_ISNULL(old_block) || OB_ISNULL(cur_block)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(old_block), KP(cur_block));
+  } else {
+    ObIColumnDecoder::update_pointer(header_, old_block, cur_block);
+  }
+  return ret;
+}
+
+// Internal call, not check parameters for performance
+int ObFloatPackingDecoder::batch_decode(
+    const ObColumnDecoderCtx &ctx,
+    const ObIRowIndex* row_index,
+    const int64_t *row_ids,
+    const char **cell_datas,
+    const int64_t row_cap,
+    common::ObDatum *datums) const
+{
+  UNUSEDx(row_index, cell_datas);
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not inited", K(ret));
+  } else {
+    const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_)
+                                    + ctx.col_header_->length_;
+    const int64_t data_offset = get_data_offset(ctx);
+    const bool has_ext_val = ctx.has_extend_value();
+    uint32_t datum_len = 0;
+    if (has_ext_val && OB_FAIL(set_null_datums_from_fixed_column(
+        ctx, row_ids, row_cap, col_data, datums))) {
+      LOG_WARN("Failed to set null datums from fixed data", K(ret), K(ctx));
+    } else if (OB_FAIL(get_uint_data_datum_len(
+        ObDatum::get_obj_datum_map_type(ctx.obj_meta_.get_type()),
+        datum_len))) {
+      LOG_WARN("Failed to get datum length of int/uint data", K(ret));
+    } else {
+      uint64_t value = 0;
+      for (int64_t i = 0; i < row_cap; ++i) {
+        if (has_ext_val && datums[i].is_null()) {
+          // Skip
+        } else {
+          value = get_value(ctx, col_data, data_offset, row_ids[i]);
+          MEMCPY(const_cast<char *>(datums[i].ptr_), &value, datum_len);
+          datums[i].pack_ = datum_len;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFloatPackingDecoder::pushdown_operator(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    const char* meta_data,
+    const ObIRowIndex* row_index,
+    ObBitmap &result_bitmap) const
+{
+  UNUSEDx(meta_data, row_index);
+  int ret = OB_SUCCESS;
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_) +
+      col_ctx.col_header_->length_;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Float packing decoder not inited", K(ret), K(filter));
+  } else if (OB_UNLIKELY(op_type >= sql::WHITE_OP_MAX
+                         || col_ctx.micro_block_header_->row_count_ != result_bitmap.size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument for pushed down white filter",
+             K(ret), K(op_type), K(result_bitmap.size()));
+  } else if (OB_FAIL(get_is_null_bitmap_from_fixed_column(col_ctx, col_data, result_bitmap))) {
+    LOG_WARN("Failed to get is null bitmap", K(ret), K(col_ctx));
+  } else {
+    switch (op_type) {
+    case sql::WHITE_OP_NU: {
+      break;
+    }
+    case sql::WHITE_OP_NN: {
+      if (OB_FAIL(result_bitmap.bit_not())) {
+        LOG_WARN("Failed to flip bits for result bitmap",
+            K(ret), K(result_bitmap.size()));
+      }
+      break;
+    }
+    case sql::WHITE_OP_EQ:
+    case sql::WHITE_OP_NE:
+    case sql::WHITE_OP_GT:
+    case sql::WHITE_OP_GE:
+    case sql::WHITE_OP_LT:
+    case sql::WHITE_OP_LE: {
+      if (OB_UNLIKELY(filter.get_objs().count() != 1)) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("Invalid filter objs count", K(ret), K(filter));
+      } else if (OB_FAIL(traverse_all_data(parent, col_ctx, col_data, filter, result_bitmap,
+                    [](const ObObj &cur_obj,
+                      const sql::ObWhiteFilterExecutor &filter,
+                      bool &result) -> int {
+                      result = ObObjCmpFuncs::compare_oper_nullsafe(
+                          cur_obj,
+                          filter.get_objs().at(0),
+                          cur_obj.get_collation_type(),
+                          sql::ObPushdownWhiteFilterNode::WHITE_OP_TO_CMP_OP[filter.get_op_type()]);
+                      return OB_SUCCESS;
+                    }))) {
+        LOG_WARN("Failed on comparison operator", K(ret), K(col_ctx));
+      }
+      break;
+    }
+    case sql::WHITE_OP_BT: {
+      if (OB_UNLIKELY(filter.get_objs().count() != 2)) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("Invalid filter objs count", K(ret), K(filter));
+      } else if (OB_FAIL(traverse_all_data(parent, col_ctx, col_data, filter, result_bitmap,
+                    [](const ObObj &cur_obj,
+                      const sql::ObWhiteFilterExecutor &filter,
+                      bool &result) -> int {
+                      result = (cur_obj >= filter.get_objs().at(0))
+                                && (cur_obj <= filter.get_objs().at(1));
+                      return OB_SUCCESS;
+                    }))) {
+        LOG_WARN("Failed on BT operator", K(ret), K(col_ctx));
+      }
+      break;
+    }
+    case sql::WHITE_OP_IN: {
+      if (OB_UNLIKELY(filter.get_objs().count() == 0)) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("Invalid filter objs count", K(ret), K(filter));
+      } else if (OB_FAIL(traverse_all_data(parent, col_ctx, col_data, filter, result_bitmap,
+                    [](const ObObj &cur_obj,
+                      const sql::ObWhiteFilterExecutor &filter,
+                      bool &result) -> int {
+                      int ret = OB_SUCCESS;
+                      if (OB_FAIL(filter.exist_in_obj_set(cur_obj, result))) {
+                        LOG_WARN("Failed to check object in hashset", K(ret), K(cur_obj));
+                      }
+                      return ret;
+                    }))) {
+        LOG_WARN("Failed on IN operator", K(ret), K(col_ctx));
+      }
+      break;
+    }
+    default: {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("Unexpected operation type", K(ret), K(op_type));
+    }
+    }
+  }
+  return ret;
+}
+
+int ObFloatPackingDecoder::traverse_all_data(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    const unsigned char* col_data,
+    const sql::ObWhiteFilterExecutor &filter,
+    ObBitmap &result_bitmap,
+    int (*lambda)(
+        const ObObj &cur_obj,
+        const sql::ObWhiteFilterExecutor &filter,
+        bool &result)) const
+{
+  int ret = OB_SUCCESS;
+  ObObj cur_obj;
+  cur_obj.copy_meta_type(col_ctx.obj_meta_);
+  const int64_t data_offset = get_data_offset(col_ctx);
+  const bool null_value_contained = (result_bitmap.popcnt() > 0);
+  const bool exist_parent_filter = nullptr != parent;
+  for (int64_t row_id = 0;
+       OB_SUCC(ret) && row_id < col_ctx.micro_block_header_->row_count_;
+       ++row_id) {
+    if (exist_parent_filter && parent->can_skip_filter(row_id)) {
+      continue;
+    } else if (null_value_contained && result_bitmap.test(row_id)) {
+      if (OB_FAIL(result_bitmap.set(row_id, false))) {
+        LOG_WARN("Failed to set row with null object to false", K(ret));
+      }
+    } else {
+      cur_obj.v_.uint64_ = get_value(col_ctx, col_data, data_offset, row_id);
+      bool result = false;
+      if (OB_FAIL(lambda(cur_obj, filter, result))) {
+        LOG_WARN("Failed on trying to filter the row", K(ret), K(row_id), K(cur_obj));
+      } else if (result) {
+        if (OB_FAIL(result_bitmap.set(row_id))) {
+          LOG_WARN("Failed to set result bitmap", K(ret), K(row_id), K(filter));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFloatPackingDecoder::get_null_count(
+    const ObColumnDecoderCtx &ctx,
+    const ObIRowIndex *row_index,
+    const int64_t *row_ids,
+    const int64_t row_cap,
+    int64_t &null_count) const
+{
+  int ret = OB_SUCCESS;
+  const char *col_data = reinterpret_cast<const char *>(header_) + ctx.col_header_->length_;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Float packing decoder is not inited", K(ret));
+  } else if (OB_FAIL(ObIColumnDecoder::get_null_count_from_extend_value(
+      ctx,
+      row_index,
+      row_ids,
+      row_cap,
+      col_data,
+      null_count))) {
+    LOG_WARN("Failed to get null count", K(ctx), K(ret));
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_float_packing_encoder.h"
+
+#include "storage/blocksstable/ob_data_buffer.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+using namespace common;
+
+const double ObFloatPackingHeader::POW10[MAX_DECIMAL_EXPONENT + 1] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+  1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+};
+
+const ObColumnHeader::Type ObFloatPackingEncoder::type_;
+
+ObFloatPackingEncoder::ObFloatPackingEncoder()
+  : is_float_(false), type_store_size_(0), mode_(ObFloatPackingHeader::DECIMAL),
+    param_(0), base_(0), header_(NULL)
+{
+}
+
+int ObFloatPackingEncoder::init(
+    const ObColumnEncodingCtx &ctx,
+    const int64_t column_index,
+    const ObConstDatumRowArray &rows)
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_FAIL(ObIColumnEncoder::init(ctx, column_index, rows))) {
+    LOG_WARN("init base column encoder failed",
+        K(ret), K(ctx), K(column_index), "row count", rows.count());
+  } else {
+    const ObObjTypeClass tc = ob_obj_type_class(column_type_.get_type());
+    type_store_size_ = get_type_size_map()[column_type_.get_type()];
+    if (ObFloatTC == tc && sizeof(float) == type_store_size_) {
+      is_float_ = true;
+      column_header_.type_ = type_;
+    } else if (ObDoubleTC == tc && sizeof(double) == type_store_size_) {
+      is_float_ = false;
+      column_header_.type_ = type_;
+    } else {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("not supported type for float packing",
+          K(ret), K(tc), K_(type_store_size), K_(column_index));
+    }
+  }
+  return ret;
+}
+
+void ObFloatPackingEncoder::reuse()
+{
+  ObIColumnEncoder::reuse();
+  is_float_ = false;
+  type_store_size_ = 0;
+  mode_ = ObFloatPackingHeader::DECIMAL;
+  param_ = 0;
+  base_ = 0;
+  header_ = NULL;
+  is_inited_ = false;
+}
+
+void ObFloatPackingEncoder::traverse_decimal(
+    int64_t &exponent, uint64_t &base, uint64_t &max_delta) const
+{
+  const ObColDatums &datums = *ctx_->col_datums_;
+  exponent = -1;
+  // the smallest exponent gives the smallest integers
+  for (int64_t e = 0; e <= ObFloatPackingHeader::MAX_DECIMAL_EXPONENT && exponent < 0; ++e) {
+    bool exact = true;
+    int64_t min_n = INT64_MAX;
+    int64_t max_n = INT64_MIN;
+    for (int64_t i = 0; exact && i < datums.count(); ++i) {
+      const ObDatum &datum = datums.at(i);
+      int64_t n = 0;
+      if (datum.is_null() || datum.is_nop()) {
+      } else if (!to_decimal(get_bits(datum), e, n)) {
+        exact = false;
+      } else {
+        min_n = std::min(min_n, n);
+        max_n = std::max(max_n, n);
+      }
+    }
+    if (exact && min_n <= max_n) {
+      exponent = e;
+      base = static_cast<uint64_t>(min_n);
+      max_delta = static_cast<uint64_t>(max_n) - static_cast<uint64_t>(min_n);
+    }
+  }
+}
+
+void ObFloatPackingEncoder::traverse_xor(
+    int64_t &shift, uint64_t &base, uint64_t &max_delta) const
+{
+  const ObColDatums &datums = *ctx_->col_datums_;
+  bool has_base = false;
+  uint64_t xor_bits = 0;
+  base = 0;
+  for (int64_t i = 0; i < datums.count(); ++i) {
+    const ObDatum &datum = datums.at(i);
+    if (datum.is_null() || datum.is_nop()) {
+    } else if (!has_base) {
+      has_base = true;
+      base = get_bits(datum);
+    } else {
+      xor_bits |= get_bits(datum) ^ base;
+    }
+  }
+  shift = 0 == xor_bits ? 0 : __builtin_ctzl(xor_bits);
+  max_delta = xor_bits >> shift;
+}
+
+int ObFloatPackingEncoder::traverse(bool &suitable)
+{
+  int ret = OB_SUCCESS;
+  suitable = false;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    int64_t exponent = -1;
+    uint64_t decimal_base = 0;
+    uint64_t decimal_delta = 0;
+    int64_t shift = 0;
+    uint64_t xor_base = 0;
+    uint64_t xor_delta = 0;
+    traverse_decimal(exponent, decimal_base, decimal_delta);
+    traverse_xor(shift, xor_base, xor_delta);
+
+    uint64_t max_delta = 0;
+    if (exponent >= 0 && decimal_delta <= xor_delta) {
+      mode_ = ObFloatPackingHeader::DECIMAL;
+      param_ = exponent;
+      base_ = decimal_base;
+      max_delta = decimal_delta;
+    } else {
+      mode_ = ObFloatPackingHeader::XOR;
+      param_ = shift;
+      base_ = xor_base;
+      max_delta = xor_delta;
+    }
+
+    if (0 == xor_delta) {
+      // all values are the same, leave them to const encoder
+    } else {
+      bool bit_packing = false;
+      int64_t delta_size = get_packing_size(bit_packing, max_delta);
+      if (!bit_packing) {
+        delta_size *= CHAR_BIT;
+      }
+      const int64_t orig_size = type_store_size_ * CHAR_BIT;
+      LOG_DEBUG("float packing size", K_(column_index), K_(mode), K_(param),
+          K(delta_size), K(orig_size));
+      if ((orig_size - delta_size) * rows_->count() > sizeof(*header_) * CHAR_BIT) {
+        suitable = true;
+        if (bit_packing) {
+          desc_.bit_packing_length_ = delta_size;
+        } else {
+          desc_.fix_data_length_ = delta_size / CHAR_BIT;
+        }
+        desc_.need_data_store_ = true;
+        desc_.has_null_ = ctx_->null_cnt_ > 0;
+        desc_.has_nope_ = ctx_->nope_cnt_ > 0;
+        desc_.need_extend_value_bit_store_ = desc_.has_null_ || desc_.has_nope_;
+        if (desc_.need_extend_value_bit_store_) {
+          column_header_.set_has_extend_value_attr();
+        }
+        if (desc_.bit_packing_length_ > 0) {
+          column_header_.set_bit_packing_attr();
+        }
+        column_header_.set_fix_lenght_attr();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFloatPackingEncoder::store_meta(ObBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    header_ = reinterpret_cast<ObFloatPackingHeader *>(buf_writer.current());
+    if (OB_FAIL(buf_writer.advance_zero(sizeof(*header_)))) {
+      LOG_WARN("advance meta store size failed", K(ret));
+    } else {
+      header_->version_ = ObFloatPackingHeader::OB_FLOAT_PACKING_HEADER_V1;
+      header_->mode_ = static_cast<uint8_t>(mode_);
+      header_->param_ = static_cast<uint8_t>(param_);
+      header_->base_ = base_;
+      LOG_DEBUG("float packing meta", K(*header_));
+    }
+  }
+  return ret;
+}
+
+int64_t ObFloatPackingEncoder::calc_size() const
+{
+  int64_t size = INT64_MAX;
+  if (is_inited_) {
+    if (desc_.bit_packing_length_ > 0) {
+      size = (rows_->count() * desc_.bit_packing_length_ + CHAR_BIT - 1) / CHAR_BIT;
+    } else {
+      size = rows_->count() * desc_.fix_data_length_;
+    }
+  }
+  return size + sizeof(*header_);
+}
+
+int ObFloatPackingEncoder::store_fix_data(ObBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(!is_valid_fix_encoder())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K_(desc));
+  } else {
+    DeltaGetter getter(*this);
+    FixDataSetter setter(*this);
+    header_->length_ = static_cast<uint8_t>(desc_.bit_packing_length_ > 0
+        ? desc_.bit_packing_length_
+        : desc_.fix_data_length_);
+    if (OB_FAIL(fill_column_store(buf_writer, *ctx_->col_datums_, getter, setter))) {
+      LOG_WARN("fill column store failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_FLOAT_PACKING_ENCODER_H_
+#define OCEANBASE_ENCODING_OB_FLOAT_PACKING_ENCODER_H_
+
+#include "ob_icolumn_encoder.h"
+#include "ob_encoding_util.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+struct ObFloatPackingHeader
+{
+  static constexpr uint8_t OB_FLOAT_PACKING_HEADER_V1 = 0;
+  enum Mode
+  {
+    // value is (base_ + delta) / 10^param_
+    DECIMAL = 0,
+    // value bits are (delta << param_) ^ base_
+    XOR = 1,
+  };
+  // |v * 10^e| must be exactly representable by double
+  static const int64_t MAX_DECIMAL_EXPONENT = 15;
+  static const double POW10[MAX_DECIMAL_EXPONENT + 1];
+
+  uint8_t version_;
+  uint8_t length_;
+  uint8_t mode_;
+  uint8_t param_;
+  uint64_t base_;
+
+  ObFloatPackingHeader()
+    : version_(OB_FLOAT_PACKING_HEADER_V1), length_(0), mode_(DECIMAL), param_(0), base_(0)
+  {
+  }
+
+  // bits of the float (low 32 bits) or double value of scaled integer %n
+  OB_INLINE static uint64_t decimal_to_bits(const int64_t n, const int64_t exponent,
+                                            const bool is_float)
+  {
+    uint64_t bits = 0;
+    const double d = static_cast<double>(n) / POW10[exponent];
+    if (is_float) {
+      const float f = static_cast<float>(d);
+      MEMCPY(&bits, &f, sizeof(f));
+    } else {
+      MEMCPY(&bits, &d, sizeof(d));
+    }
+    return bits;
+  }
+
+  // performance critical, do not check parameters
+  OB_INLINE uint64_t to_bits(const uint64_t delta, const bool is_float) const
+  {
+    return DECIMAL == mode_
+        ? decimal_to_bits(static_cast<int64_t>(base_ + delta), param_, is_float)
+        : (delta << param_) ^ base_;
+  }
+
+  TO_STRING_KV(K_(length), K_(mode), K_(param), K_(base));
+} __attribute__((packed));
+
+// Encoding for FLOAT/DOUBLE columns, e.g. readings of sensors.
+//
+// Most of the values are decimals with a few fraction digits, which are stored as the
+// integers of v * 10^e (the way of ALP), bit packed with the minimum as base.
+// Values which are not decimals fall back to xor with the first value, the leading
+// zeros of similar values and the common trailing zeros are not stored.
+// Both modes keep the values fixed length, so that rows are decoded randomly.
+class ObFloatPackingEncoder : public ObIColumnEncoder
+{
+public:
+  static const ObColumnHeader::Type type_ = ObColumnHeader::FLOAT_PACKING;
+
+  ObFloatPackingEncoder();
+  virtual ~ObFloatPackingEncoder() {}
+
+  virtual int init(
+      const ObColumnEncodingCtx &ctx,
+      const int64_t column_index,
+      const ObConstDatumRowArray &rows) override;
+
+  virtual void reuse() override;
+  virtual int store_meta(ObBufferWriter &buf_writer) override;
+  virtual int store_data(
+      const int64_t row_id, ObBitStream &bs, char *buf, const int64_t len) override
+  {
+    UNUSEDx(row_id, bs, buf, len);
+    return common::OB_NOT_SUPPORTED;
+  }
+
+  virtual int traverse(bool &suitable) override;
+  virtual int64_t calc_size() const override;
+  virtual ObColumnHeader::Type get_type() const { return type_; }
+  virtual int store_fix_data(ObBufferWriter &buf_writer) override;
+
+public:
+  struct DeltaGetter
+  {
+    explicit DeltaGetter(const ObFloatPackingEncoder &encoder) : encoder_(encoder) {}
+    inline int operator()(const int64_t, const common::ObDatum &datum, uint64_t &v)
+    {
+      v = encoder_.delta(datum);
+      return common::OB_SUCCESS;
+    }
+
+    const ObFloatPackingEncoder &encoder_;
+  };
+
+  struct FixDataSetter
+  {
+    explicit FixDataSetter(const ObFloatPackingEncoder &encoder) : encoder_(encoder) {}
+    inline int operator()(
+        const int64_t,
+        const common::ObDatum &datum,
+        char *buf,
+        const int64_t len) const
+    {
+      // performance critical, do not check parameters
+      uint64_t v = encoder_.delta(datum);
+      MEMCPY(buf, &v, len);
+      return common::OB_SUCCESS;
+    }
+
+    const ObFloatPackingEncoder &encoder_;
+  };
+
+private:
+  OB_INLINE uint64_t get_bits(const common::ObDatum &datum) const
+  {
+    uint64_t bits = 0;
+    MEMCPY(&bits, datum.ptr_, is_float_ ? sizeof(float) : sizeof(double));
+    return bits;
+  }
+  OB_INLINE double get_value(const uint64_t bits) const
+  {
+    double v = 0;
+    if (is_float_) {
+      float f = 0;
+      MEMCPY(&f, &bits, sizeof(f));
+      v = f;
+    } else {
+      MEMCPY(&v, &bits, sizeof(v));
+    }
+    return v;
+  }
+  // scaled integer of the value if it round trips with %exponent
+  OB_INLINE bool to_decimal(const uint64_t bits, const int64_t exponent, int64_t &n) const
+  {
+    bool exact = false;
+    const double d = get_value(bits) * ObFloatPackingHeader::POW10[exponent];
+    if (d > -MAX_EXACT_DOUBLE_INT && d < MAX_EXACT_DOUBLE_INT) {
+      n = static_cast<int64_t>(d < 0 ? d - 0.5 : d + 0.5);
+      exact = ObFloatPackingHeader::decimal_to_bits(n, exponent, is_float_) == bits;
+    }
+    return exact;
+  }
+  OB_INLINE uint64_t delta(const common::ObDatum &datum) const
+  {
+    uint64_t v = 0;
+    const uint64_t bits = get_bits(datum);
+    if (ObFloatPackingHeader::DECIMAL == mode_) {
+      int64_t n = 0;
+      to_decimal(bits, param_, n);
+      v = static_cast<uint64_t>(n) - base_;
+    } else {
+      v = (bits ^ base_) >> param_;
+    }
+    return v;
+  }
+  // try the decimal mode, @exponent is -1 if values are not decimals
+  void traverse_decimal(int64_t &exponent, uint64_t &base, uint64_t &max_delta) const;
+  void traverse_xor(int64_t &shift, uint64_t &base, uint64_t &max_delta) const;
+
+private:
+  static constexpr double MAX_EXACT_DOUBLE_INT = static_cast<double>(1L << 52);
+  bool is_float_;
+  int64_t type_store_size_;
+  ObFloatPackingHeader::Mode mode_;
+  int64_t param_;
+  uint64_t base_;
+  // is null before write meta
+  ObFloatPackingHeader *header_;
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_ENCODING_OB_FLOAT_PACKING_ENCODER_H_
@@ -273,7 +273,10 @@ ObIEncodeBlockReader::decode_acquire_func ObIEncodeBlockReader::acquire_funcs_[O
     acquire_decoder<ObHexStringDecoder>,
     acquire_decoder<ObStringPrefixDecoder>,
     acquire_decoder<ObColumnEqualDecoder>,
-    acquire_decoder<ObInterColSubStrDecoder>
+    acquire_decoder<ObInterColSubStrDecoder>,
+    acquire_decoder<ObTimestampDeltaDecoder>,
+    acquire_decoder<ObFloatPackingDecoder>,
+    acquire_decoder<ObSymbolStringDecoder>
 };
 
 ObIEncodeBlockReader::ObIEncodeBlockReader()
@@ -1018,6 +1021,39 @@ int ObMicroBlockDecoder::acquire(
         }
         break;
       }
+      case ObColumnHeader::TIMESTAMP_DELTA: {
+        ObTimestampDeltaDecoder *d = NULL;
+        if (OB_FAIL(allocator.alloc(d))) {
+          LOG_WARN("alloc failed", K(ret));
+        } else if (OB_FAIL(d->init(header, col_header, meta_data))) {
+          LOG_WARN("init timestamp delta decoder failed", K(ret));
+        } else {
+          decoder = d;
+        }
+        break;
+      }
+      case ObColumnHeader::FLOAT_PACKING: {
+        ObFloatPackingDecoder *d = NULL;
+        if (OB_FAIL(allocator.alloc(d))) {
+          LOG_WARN("alloc failed", K(ret));
+        } else if (OB_FAIL(d->init(header, col_header, meta_data))) {
+          LOG_WARN("init float packing decoder failed", K(ret));
+        } else {
+          decoder = d;
+        }
+        break;
+      }
+      case ObColumnHeader::SYMBOL_PACKING: {
+        ObSymbolStringDecoder *d = NULL;
+        if (OB_FAIL(allocator.alloc(d))) {
+          LOG_WARN("alloc failed", K(ret));
+        } else if (OB_FAIL(d->init(header, col_header, meta_data))) {
+          LOG_WARN("init symbol string decoder failed", K(ret));
+        } else {
+          decoder = d;
+        }
+        break;
+      }
       default:
         ret = OB_INNER_STAT_ERROR;
         LOG_WARN("unsupported encoding type", K(ret), "type", col_header.type_);
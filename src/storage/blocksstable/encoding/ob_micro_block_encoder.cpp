@@ -31,6 +31,10 @@
 #include "ob_encoding_hash_util.h"
 #include "ob_string_prefix_encoder.h"
 #include "ob_inter_column_substring_encoder.h"
+#include "ob_timestamp_delta_encoder.h"
+#include "ob_float_packing_encoder.h"
+#include "ob_symbol_string_encoder.h"
+#include "ob_encoding_planner.h"
 
 namespace oceanbase
 {
@@ -70,7 +74,7 @@ int ObMicroBlockEncoder::try_encoder(ObIColumnEncoder *&encoder, const int64_t c
   } else if (OB_UNLIKELY(column_index < 0 || column_index > ctx_.column_cnt_)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("invalid argument", K(ret), K(column_index));
-  } else if (ctx_.encoder_opt_.enable<T>()) {
+  } else if (ctx_.enable_encoding(T::type_)) {
     T *e = alloc_encoder<T>();
     if (NULL == e) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
@@ -99,7 +103,7 @@ ObMicroBlockEncoder::ObMicroBlockEncoder() : ctx_(), header_(NULL),
     row_buf_holder_(blocksstable::OB_ENCODING_LABEL_ROW_BUFFER, OB_MALLOC_MIDDLE_BLOCK_SIZE),
     encoder_allocator_(encoder_sizes, common::ObModIds::OB_ENCODER_ALLOCATOR),
     string_col_cnt_(0), estimate_base_store_size_(0), length_(0),
-    is_inited_(false)
+    encoder_select_time_(0), is_inited_(false)
 {
 }
 
@@ -209,6 +213,7 @@ void ObMicroBlockEncoder::reset()
   col_ctxs_.reset();
   string_col_cnt_ = 0;
   length_ = 0;
+  encoder_select_time_ = 0;
 }
 
 void ObMicroBlockEncoder::reuse()
@@ -239,6 +244,7 @@ void ObMicroBlockEncoder::reuse()
   col_ctxs_.reuse();
   string_col_cnt_ = 0;
   length_ = 0;
+  encoder_select_time_ = 0;
 }
 
 int ObMicroBlockEncoder::calc_and_validate_checksum(const ObDatumRow &row)
@@ -1161,6 +1167,7 @@ int ObMicroBlockEncoder::prescan(const int64_t column_index)
 int ObMicroBlockEncoder::encoder_detection()
 {
   int ret = OB_SUCCESS;
+  const int64_t start_time = ObTimeUtility::current_time();
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
     LOG_WARN("not init", K(ret));
@@ -1200,6 +1207,7 @@ int ObMicroBlockEncoder::encoder_detection()
       free_encoders();
     }
   }
+  encoder_select_time_ += ObTimeUtility::current_time() - start_time;
 
   return ret;
 }
@@ -1253,6 +1261,33 @@ int ObMicroBlockEncoder::fast_encoder_detect(
   return ret;
 }
 
+template <typename T>
+int ObMicroBlockEncoder::try_smaller_encoder(const ObColumnEncodingCtx &cc,
+    const int64_t column_idx, const int64_t acceptable_size,
+    ObIColumnEncoder *&choose, bool &try_more)
+{
+  int ret = OB_SUCCESS;
+  ObIColumnEncoder *e = NULL;
+  if (OB_ISNULL(choose)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(choose));
+  } else if (cc.detected_encoders_[T::type_]) {
+  } else if (OB_FAIL(try_encoder<T>(e, column_idx))) {
+    LOG_WARN("try encoder failed", K(ret), K(column_idx), "type", T::type_);
+  } else if (NULL != e) {
+    const int64_t size = e->calc_size();
+    if (size < choose->calc_size()) {
+      free_encoder(choose);
+      choose = e;
+      try_more = size > acceptable_size;
+    } else {
+      free_encoder(e);
+      e = NULL;
+    }
+  }
+  return ret;
+}
+
 int ObMicroBlockEncoder::try_previous_encoder(ObIColumnEncoder *&e,
     const int64_t column_index, const ObPreviousEncoding &previous)
 {
@@ -1318,6 +1353,18 @@ int ObMicroBlockEncoder::try_encoder(ObIColumnEncoder *&e, const int64_t column_
               : try_span_column_encoder<ObInterColSubStrEncoder>(e, column_index);
         break;
       }
+      case ObColumnHeader::TIMESTAMP_DELTA: {
+        ret = try_encoder<ObTimestampDeltaEncoder>(e, column_index);
+        break;
+      }
+      case ObColumnHeader::FLOAT_PACKING: {
+        ret = try_encoder<ObFloatPackingEncoder>(e, column_index);
+        break;
+      }
+      case ObColumnHeader::SYMBOL_PACKING: {
+        ret = try_encoder<ObSymbolStringEncoder>(e, column_index);
+        break;
+      }
       default:
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("unknown encoding type", K(ret), K(type));
@@ -1510,7 +1557,12 @@ int ObMicroBlockEncoder::choose_encoder(const int64_t column_idx,
     bool try_more = true;
     ObIColumnEncoder *choose = e;
     int64_t acceptable_size = choose->calc_size() / 4;
-    if (OB_FAIL(try_encoder<ObDictEncoder>(e, column_idx))) {
+    if (ctx_.encoder_opt_.planned_encoding_cnt_ > 0) {
+      try_more = false;
+      if (OB_FAIL(choose_planned_encoder(column_idx, cc, choose))) {
+        LOG_WARN("choose planned encoder failed", K(ret), K(column_idx));
+      }
+    } else if (OB_FAIL(try_encoder<ObDictEncoder>(e, column_idx))) {
       LOG_WARN("try dict encoder failed", K(ret), K(column_idx));
     } else if (NULL != e) {
       if (e->calc_size() < choose->calc_size()) {
@@ -1605,6 +1657,20 @@ int ObMicroBlockEncoder::choose_encoder(const int64_t column_idx,
       try_more = false;
     }
 
+    if (OB_SUCC(ret) && try_more) {
+      if (ObFloatTC == tc || ObDoubleTC == tc) {
+        if (OB_FAIL(try_smaller_encoder<ObFloatPackingEncoder>(
+            cc, column_idx, acceptable_size, choose, try_more))) {
+          LOG_WARN("try float packing encoder failed", K(ret), K(column_idx));
+        }
+      } else if (ObIntSC == sc || ObUIntSC == sc) {
+        if (OB_FAIL(try_smaller_encoder<ObTimestampDeltaEncoder>(
+            cc, column_idx, acceptable_size, choose, try_more))) {
+          LOG_WARN("try timestamp delta encoder failed", K(ret), K(column_idx));
+        }
+      }
+    }
+
     if (OB_SUCC(ret) && try_more) {
       // if ((ObIntSC == sc || ObUIntSC == sc) && ObFloatTC != tc && ObDoubleTC != tc) {
       if ((ObIntSC == sc || ObUIntSC == sc)) {
@@ -1625,6 +1691,16 @@ int ObMicroBlockEncoder::choose_encoder(const int64_t column_idx,
       }
     }
 
+    // symbol table is built for high cardinality strings only, others are left to dict
+    if (OB_SUCC(ret) && try_more && cc.ht_->distinct_cnt() > datum_rows_.count() / 2) {
+      if (is_string_encoding_valid(sc)) {
+        if (OB_FAIL(try_smaller_encoder<ObSymbolStringEncoder>(
+            cc, column_idx, acceptable_size, choose, try_more))) {
+          LOG_WARN("try symbol string encoder failed", K(ret), K(column_idx));
+        }
+      }
+    }
+
     bool string_diff_suitable = false;
     if (OB_SUCC(ret) && try_more) {
       if (is_string_encoding_valid(sc) && cc.fix_data_size_ > 0) {
@@ -1709,6 +1785,44 @@ int ObMicroBlockEncoder::choose_encoder(const int64_t column_idx,
   return ret;
 }
 
+int ObMicroBlockEncoder::choose_planned_encoder(const int64_t column_idx,
+    ObColumnEncodingCtx &cc, ObIColumnEncoder *&choose)
+{
+  int ret = OB_SUCCESS;
+  ObIColumnEncoder *e = NULL;
+  ObEncodingPlanner planner;
+  bool try_more = true;
+  const int64_t acceptable_size = choose->calc_size() / 4;
+  if (OB_FAIL(try_previous_encoder(choose, column_idx, acceptable_size, try_more))) {
+    LOG_WARN("try previous encoder failed", K(ret), K(column_idx));
+  } else if (!try_more) {
+  } else if (OB_FAIL(planner.plan(cc, ctx_.col_descs_->at(column_idx), datum_rows_.count()))) {
+    LOG_WARN("plan encoding failed", K(ret), K(column_idx));
+  } else {
+    const int64_t try_cnt = MIN(planner.get_candidate_cnt(), ctx_.encoder_opt_.planned_encoding_cnt_);
+    for (int64_t i = 0; OB_SUCC(ret) && try_more && i < try_cnt; ++i) {
+      const ObEncodingPlanner::Candidate &candidate = planner.get_candidate(i);
+      if (candidate.size_ >= choose->calc_size()) {
+        // candidates are sorted by the estimated size
+        try_more = false;
+      } else if (OB_FAIL(try_encoder(e, column_idx, candidate.type_, cc.last_prefix_length_, -1))) {
+        LOG_WARN("try planned encoder failed", K(ret), K(column_idx), K(candidate));
+      } else if (NULL != e) {
+        if (e->calc_size() < choose->calc_size()) {
+          free_encoder(choose);
+          choose = e;
+          try_more = choose->calc_size() > acceptable_size;
+        } else {
+          free_encoder(e);
+        }
+        e = NULL;
+      }
+    }
+    LOG_DEBUG("choose planned encoder", K(column_idx), K(planner), "type", choose->get_type());
+  }
+  return ret;
+}
+
 void ObMicroBlockEncoder::free_encoders()
 {
   int ret = OB_SUCCESS;
@@ -79,6 +79,7 @@ public:
   virtual int64_t get_column_count() const { return ctx_.column_cnt_;}
   virtual int64_t get_original_size() const { return estimate_size_; }
   virtual void dump_diagnose_info() const override;
+  virtual int64_t get_encoder_select_time() const override { return encoder_select_time_; }
 private:
   int inner_init();
   int reserve_header(const ObMicroBlockEncodingCtx &ctx);
@@ -101,6 +102,9 @@ private:
   int fast_encoder_detect(const int64_t column_idx, const ObColumnEncodingCtx &cc);
   int prescan(const int64_t column_index);
   int choose_encoder(const int64_t column_idx, ObColumnEncodingCtx &column_ctx);
+  // build the encoders with the smallest estimated size only
+  int choose_planned_encoder(const int64_t column_idx, ObColumnEncodingCtx &column_ctx,
+      ObIColumnEncoder *&choose);
   void free_encoders();
 
   template <typename T>
@@ -111,6 +115,10 @@ private:
   // %e may be NULL if encoder not suitable.
   template <typename T>
   int try_encoder(ObIColumnEncoder *&e, const int64_t column_index);
+  // try encoder %T and replace %choose with it if it is smaller
+  template <typename T>
+  int try_smaller_encoder(const ObColumnEncodingCtx &cc, const int64_t column_idx,
+      const int64_t acceptable_size, ObIColumnEncoder *&choose, bool &try_more);
 
   int try_previous_encoder(ObIColumnEncoder *&e,
       const int64_t column_index, const ObPreviousEncoding &previous);
@@ -174,6 +182,7 @@ private:
   int64_t estimate_base_store_size_;
   common::ObArray<ObColumnEncodingCtx> col_ctxs_;
   int64_t length_;
+  int64_t encoder_select_time_;
   bool is_inited_;
 
   DISALLOW_COPY_AND_ASSIGN(ObMicroBlockEncoder);
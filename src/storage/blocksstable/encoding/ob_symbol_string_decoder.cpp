@@ -0,0 +1,393 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_symbol_string_decoder.h"
+
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "ob_bit_stream.h"
+#include "ob_raw_decoder.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+using namespace common;
+const ObColumnHeader::Type ObSymbolStringDecoder::type_;
+
+int ObSymbolStringDecoder::decode(ObColumnDecoderCtx &ctx, common::ObObj &cell, const int64_t row_id,
+    const ObBitStream &bs, const char *data, const int64_t len) const
+{
+  UNUSED(row_id);
+  int ret = OB_SUCCESS;
+  uint64_t val = STORED_NOT_EXT;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(NULL == data || len < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(data), K(len));
+  } else if (ctx.has_extend_value()) {
+    if (OB_FAIL(bs.get(ctx.col_header_->extend_value_index_,
+                       ctx.micro_block_header_->extend_value_bit_, val))) {
+      LOG_WARN("get extend value failed", K(ret), K(bs), K(ctx));
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (STORED_NOT_EXT != val) {
+    set_stored_ext_value(cell, static_cast<ObStoredExtValue>(val));
+  } else {
+    if (cell.get_meta() != ctx.obj_meta_) {
+      cell.set_meta_type(ctx.obj_meta_);
+    }
+    const char *code = NULL;
+    int64_t code_len = 0;
+    char *buf = NULL;
+    if (OB_FAIL(ObRawDecoder::locate_cell_data(code, code_len, data, len,
+            *ctx.micro_block_header_, *ctx.col_header_, *header_))) {
+      LOG_WARN("locate cell data failed", K(ret), K(len), K(ctx), "header", *header_);
+    } else if (OB_ISNULL(buf = static_cast<char *>(ctx.allocator_->alloc(get_buf_size())))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to allocate memory", K(ret), "size", get_buf_size());
+    } else {
+      cell.val_len_ = static_cast<int32_t>(ObStringSymbolTable::decode(header_->symbols_,
+          reinterpret_cast<const unsigned char *>(code), code_len,
+          reinterpret_cast<unsigned char *>(buf)));
+      cell.v_.string_ = buf;
+    }
+  }
+  return ret;
+}
+
+int ObSymbolStringDecoder::update_pointer(const char *old_block, const char *cur_block)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_ISNULL(old_block) || OB_ISNULL(cur_block)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(old_block), KP(cur_block));
+  } else {
+    ObIColumnDecoder::update_pointer(header_, old_block, cur_block);
+  }
+  return ret;
+}
+
+int ObSymbolStringDecoder::locate_code(
+    const ObColumnDecoderCtx &col_ctx,
+    const ObIRowIndex *row_index,
+    const int64_t row_id,
+    const char *&code,
+    int64_t &code_len) const
+{
+  int ret = OB_SUCCESS;
+  const char *row_data = NULL;
+  int64_t row_len = 0;
+  if (OB_FAIL(locate_row_data(col_ctx, row_index, row_id, row_data, row_len))) {
+    LOG_WARN("Failed to read row data from row index", K(ret), KP(row_index), K(row_id));
+  } else if (OB_FAIL(ObRawDecoder::locate_cell_data(code, code_len, row_data, row_len,
+      *col_ctx.micro_block_header_, *col_ctx.col_header_, *header_))) {
+    LOG_WARN("Failed to locate cell data", K(ret), K(row_len), KP(row_data), K(row_id));
+  }
+  return ret;
+}
+
+// Internal call, not check parameters for performance
+int ObSymbolStringDecoder::batch_decode(
+    const ObColumnDecoderCtx &ctx,
+    const ObIRowIndex* row_index,
+    const int64_t *row_ids,
+    const char **cell_datas,
+    const int64_t row_cap,
+    common::ObDatum *datums) const
+{
+  UNUSED(cell_datas);
+  int ret = OB_SUCCESS;
+  const int64_t buf_size = is_inited() ? get_buf_size() : 0;
+  char *buf = NULL;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not init", K(ret));
+  } else if (OB_ISNULL(buf = static_cast<char *>(ctx.allocator_->alloc(buf_size * row_cap)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("Failed to allocate memory", K(ret), K(buf_size), K(row_cap));
+  } else if (ctx.has_extend_value() && OB_FAIL(set_null_datums_from_var_column(
+      ctx, row_index, row_ids, row_cap, datums))) {
+    LOG_WARN("Failed to set null datums from var data", K(ret), K(ctx));
+  } else {
+    const char *code = NULL;
+    int64_t code_len = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_cap; ++i) {
+      if (ctx.has_extend_value() && datums[i].is_null()) {
+        // Skip
+      } else if (OB_FAIL(locate_code(ctx, row_index, row_ids[i], code, code_len))) {
+        LOG_WARN("Failed to locate code", K(ret), K(i), K(ctx));
+      } else {
+        char *str = buf + i * buf_size;
+        datums[i].pack_ = static_cast<uint32_t>(ObStringSymbolTable::decode(header_->symbols_,
+            reinterpret_cast<const unsigned char *>(code), code_len,
+            reinterpret_cast<unsigned char *>(str)));
+        datums[i].ptr_ = str;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObSymbolStringDecoder::pushdown_operator(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    const char* meta_data,
+    const ObIRowIndex* row_index,
+    ObBitmap &result_bitmap) const
+{
+  UNUSED(meta_data);
+  int ret = OB_SUCCESS;
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Symbol string decoder not inited", K(ret), K(filter));
+  } else if (OB_UNLIKELY(op_type >= sql::WHITE_OP_MAX || OB_ISNULL(row_index)
+                         || col_ctx.micro_block_header_->row_count_ != result_bitmap.size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument for pushed down white filter",
+             K(ret), K(op_type), KP(row_index), K(result_bitmap.size()));
+  } else if (OB_FAIL(get_is_null_bitmap_from_var_column(col_ctx, row_index, result_bitmap))) {
+    LOG_WARN("Failed to get isnull bitmap from variable column", K(ret));
+  } else {
+    switch (op_type) {
+    case sql::WHITE_OP_NU: {
+      break;
+    }
+    case sql::WHITE_OP_NN: {
+      if (OB_FAIL(result_bitmap.bit_not())) {
+        LOG_WARN("Failed to flip bits for result bitmap",
+            K(ret), K(result_bitmap.size()));
+      }
+      break;
+    }
+    case sql::WHITE_OP_EQ:
+    case sql::WHITE_OP_NE: {
+      if (OB_UNLIKELY(filter.get_objs().count() != 1)) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("Invalid filter objs count", K(ret), K(filter));
+      } else if (OB_FAIL(equal_operator(parent, col_ctx, filter, row_index, result_bitmap))) {
+        LOG_WARN("Failed on equal operator", K(ret), K(col_ctx));
+      }
+      break;
+    }
+    case sql::WHITE_OP_GT:
+    case sql::WHITE_OP_GE:
+    case sql::WHITE_OP_LT:
+    case sql::WHITE_OP_LE: {
+      if (OB_UNLIKELY(filter.get_objs().count() != 1)) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("Invalid filter objs count", K(ret), K(filter));
+      } else if (OB_FAIL(traverse_all_data(parent, col_ctx, filter, row_index, result_bitmap,
+                    [](const ObObj &cur_obj,
+                      const sql::ObWhiteFilterExecutor &filter,
+                      bool &result) -> int {
+                      result = ObObjCmpFuncs::compare_oper_nullsafe(
+                          cur_obj,
+                          filter.get_objs().at(0),
+                          cur_obj.get_collation_type(),
+                          sql::ObPushdownWhiteFilterNode::WHITE_OP_TO_CMP_OP[filter.get_op_type()]);
+                      return OB_SUCCESS;
+                    }))) {
+        LOG_WARN("Failed on comparison operator", K(ret), K(col_ctx));
+      }
+      break;
+    }
+    case sql::WHITE_OP_BT: {
+      if (OB_UNLIKELY(filter.get_objs().count() != 2)) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("Invalid filter objs count", K(ret), K(filter));
+      } else if (OB_FAIL(traverse_all_data(parent, col_ctx, filter, row_index, result_bitmap,
+                    [](const ObObj &cur_obj,
+                      const sql::ObWhiteFilterExecutor &filter,
+                      bool &result) -> int {
+                      result = (cur_obj >= filter.get_objs().at(0))
+                                && (cur_obj <= filter.get_objs().at(1));
+                      return OB_SUCCESS;
+                    }))) {
+        LOG_WARN("Failed on BT operator", K(ret), K(col_ctx));
+      }
+      break;
+    }
+    case sql::WHITE_OP_IN: {
+      if (OB_UNLIKELY(filter.get_objs().count() == 0)) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("Invalid filter objs count", K(ret), K(filter));
+      } else if (OB_FAIL(traverse_all_data(parent, col_ctx, filter, row_index, result_bitmap,
+                    [](const ObObj &cur_obj,
+                      const sql::ObWhiteFilterExecutor &filter,
+                      bool &result) -> int {
+                      int ret = OB_SUCCESS;
+                      if (OB_FAIL(filter.exist_in_obj_set(cur_obj, result))) {
+                        LOG_WARN("Failed to check object in hashset", K(ret), K(cur_obj));
+                      }
+                      return ret;
+                    }))) {
+        LOG_WARN("Failed on IN operator", K(ret), K(col_ctx));
+      }
+      break;
+    }
+    default: {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("Unexpected operation type", K(ret), K(op_type));
+    }
+    }
+  }
+  return ret;
+}
+
+int ObSymbolStringDecoder::equal_operator(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    const ObIRowIndex *row_index,
+    ObBitmap &result_bitmap) const
+{
+  int ret = OB_SUCCESS;
+  const ObObj &ref_obj = filter.get_objs().at(0);
+  const bool is_eq = sql::WHITE_OP_EQ == filter.get_op_type();
+  if (ObStringSC != get_store_class_map()[col_ctx.obj_meta_.get_type_class()]
+      || ObStringTC != ref_obj.get_type_class()) {
+    // codes are comparable only for plain strings
+    if (OB_FAIL(traverse_all_data(parent, col_ctx, filter, row_index, result_bitmap,
+        [](const ObObj &cur_obj,
+          const sql::ObWhiteFilterExecutor &filter,
+          bool &result) -> int {
+          result = ObObjCmpFuncs::compare_oper_nullsafe(
+              cur_obj,
+              filter.get_objs().at(0),
+              cur_obj.get_collation_type(),
+              sql::ObPushdownWhiteFilterNode::WHITE_OP_TO_CMP_OP[filter.get_op_type()]);
+          return OB_SUCCESS;
+        }))) {
+      LOG_WARN("Failed on equal operator", K(ret), K(col_ctx));
+    }
+  } else {
+    // strings with different bytes may still be equal in collations other than binary,
+    // e.g. case insensitive or pad space, decode and compare them
+    const bool is_binary = CS_TYPE_BINARY == col_ctx.obj_meta_.get_collation_type();
+    const ObString ref_str = ref_obj.get_string();
+    ObStringSymbolTable symbol_table;
+    symbol_table.init(header_->symbols_, header_->symbol_cnt_);
+    unsigned char *ref_code = NULL;
+    char *buf = NULL;
+    int64_t ref_code_len = 0;
+    if (OB_ISNULL(ref_code = static_cast<unsigned char *>(
+        col_ctx.allocator_->alloc(ref_str.length() * 2 + 1)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Failed to allocate memory", K(ret), K(ref_str));
+    } else if (OB_ISNULL(buf = static_cast<char *>(col_ctx.allocator_->alloc(get_buf_size())))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Failed to allocate memory", K(ret), "size", get_buf_size());
+    } else {
+      ref_code_len = symbol_table.encode(
+          reinterpret_cast<const unsigned char *>(ref_str.ptr()), ref_str.length(), ref_code);
+    }
+    ObObj cur_obj;
+    cur_obj.copy_meta_type(col_ctx.obj_meta_);
+    const bool null_value_contained = (result_bitmap.popcnt() > 0);
+    const bool exist_parent_filter = nullptr != parent;
+    const char *code = NULL;
+    int64_t code_len = 0;
+    for (int64_t row_id = 0;
+         OB_SUCC(ret) && row_id < col_ctx.micro_block_header_->row_count_;
+         ++row_id) {
+      if (exist_parent_filter && parent->can_skip_filter(row_id)) {
+        continue;
+      } else if (null_value_contained && result_bitmap.test(row_id)) {
+        if (OB_FAIL(result_bitmap.set(row_id, false))) {
+          LOG_WARN("Failed to set row with null object to false", K(ret));
+        }
+      } else if (OB_FAIL(locate_code(col_ctx, row_index, row_id, code, code_len))) {
+        LOG_WARN("Failed to locate code", K(ret), K(row_id));
+      } else {
+        bool equal = code_len == ref_code_len && 0 == MEMCMP(code, ref_code, code_len);
+        if (!equal && !is_binary) {
+          cur_obj.val_len_ = static_cast<int32_t>(ObStringSymbolTable::decode(header_->symbols_,
+              reinterpret_cast<const unsigned char *>(code), code_len,
+              reinterpret_cast<unsigned char *>(buf)));
+          cur_obj.v_.string_ = buf;
+          equal = ObObjCmpFuncs::compare_oper_nullsafe(cur_obj, ref_obj,
+              cur_obj.get_collation_type(), CO_EQ);
+        }
+        if (equal == is_eq && OB_FAIL(result_bitmap.set(row_id))) {
+          LOG_WARN("Failed to set result bitmap", K(ret), K(row_id), K(filter));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObSymbolStringDecoder::traverse_all_data(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    const ObIRowIndex *row_index,
+    ObBitmap &result_bitmap,
+    int (*lambda)(
+        const ObObj &cur_obj,
+        const sql::ObWhiteFilterExecutor &filter,
+        bool &result)) const
+{
+  int ret = OB_SUCCESS;
+  ObObj cur_obj;
+  cur_obj.copy_meta_type(col_ctx.obj_meta_);
+  const bool null_value_contained = (result_bitmap.popcnt() > 0);
+  const bool exist_parent_filter = nullptr != parent;
+  const char *code = NULL;
+  int64_t code_len = 0;
+  char *buf = NULL;
+  if (OB_ISNULL(buf = static_cast<char *>(col_ctx.allocator_->alloc(get_buf_size())))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("Failed to allocate memory", K(ret), "size", get_buf_size());
+  }
+  for (int64_t row_id = 0;
+       OB_SUCC(ret) && row_id < col_ctx.micro_block_header_->row_count_;
+       ++row_id) {
+    if (exist_parent_filter && parent->can_skip_filter(row_id)) {
+      continue;
+    } else if (null_value_contained && result_bitmap.test(row_id)) {
+      if (OB_FAIL(result_bitmap.set(row_id, false))) {
+        LOG_WARN("Failed to set row with null object to false", K(ret));
+      }
+    } else if (OB_FAIL(locate_code(col_ctx, row_index, row_id, code, code_len))) {
+      LOG_WARN("Failed to locate code", K(ret), K(row_id));
+    } else {
+      cur_obj.val_len_ = static_cast<int32_t>(ObStringSymbolTable::decode(header_->symbols_,
+          reinterpret_cast<const unsigned char *>(code), code_len,
+          reinterpret_cast<unsigned char *>(buf)));
+      cur_obj.v_.string_ = buf;
+      bool result = false;
+      if (OB_FAIL(lambda(cur_obj, filter, result))) {
+        LOG_WARN("Failed on trying to filter the row", K(ret), K(row_id), K(cur_obj));
+      } else if (result) {
+        if (OB_FAIL(result_bitmap.set(row_id))) {
+          LOG_WARN("Failed to set result bitmap", K(ret), K(row_id), K(filter));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_SYMBOL_STRING_DECODER_H_
+#define OCEANBASE_ENCODING_OB_SYMBOL_STRING_DECODER_H_
+
+#include "ob_icolumn_decoder.h"
+#include "ob_encoding_util.h"
+#include "ob_encoding_query_util.h"
+#include "ob_symbol_string_encoder.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+struct ObColumnHeader;
+struct ObSymbolStringHeader;
+
+class ObSymbolStringDecoder : public ObIColumnDecoder
+{
+public:
+  static const ObColumnHeader::Type type_ = ObColumnHeader::SYMBOL_PACKING;
+  ObSymbolStringDecoder() : header_(NULL)
+  {}
+  virtual ~ObSymbolStringDecoder() {}
+
+  OB_INLINE int init(
+      const ObMicroBlockHeader &micro_block_header,
+      const ObColumnHeader &column_header,
+      const char *meta);
+
+  virtual int decode(ObColumnDecoderCtx &ctx, common::ObObj &cell, const int64_t row_id,
+      const ObBitStream &bs, const char *data, const int64_t len) const override;
+
+  virtual int update_pointer(const char *old_block, const char *cur_block) override;
+
+  void reset() { this->~ObSymbolStringDecoder(); new (this) ObSymbolStringDecoder(); }
+  OB_INLINE void reuse() { header_ = NULL; }
+  virtual ObColumnHeader::Type get_type() const override { return type_; }
+  bool is_inited() const { return NULL != header_; }
+
+  virtual int batch_decode(
+      const ObColumnDecoderCtx &ctx,
+      const ObIRowIndex* row_index,
+      const int64_t *row_ids,
+      const char **cell_datas,
+      const int64_t row_cap,
+      common::ObDatum *datums) const override;
+
+  // EQ and NE compare the codes of the filter value encoded by the symbol table of the block,
+  // other operators decode the cells one by one.
+  virtual int pushdown_operator(
+      const sql::ObPushdownFilterExecutor *parent,
+      const ObColumnDecoderCtx &col_ctx,
+      const sql::ObWhiteFilterExecutor &filter,
+      const char* meta_data,
+      const ObIRowIndex* row_index,
+      ObBitmap &result_bitmap) const override;
+
+private:
+  OB_INLINE int64_t get_buf_size() const
+  {
+    return header_->max_string_size_ + ObStringSymbolTable::MAX_SYMBOL_LEN;
+  }
+  int locate_code(
+      const ObColumnDecoderCtx &col_ctx,
+      const ObIRowIndex *row_index,
+      const int64_t row_id,
+      const char *&code,
+      int64_t &code_len) const;
+  int equal_operator(
+      const sql::ObPushdownFilterExecutor *parent,
+      const ObColumnDecoderCtx &col_ctx,
+      const sql::ObWhiteFilterExecutor &filter,
+      const ObIRowIndex *row_index,
+      ObBitmap &result_bitmap) const;
+  int traverse_all_data(
+      const sql::ObPushdownFilterExecutor *parent,
+      const ObColumnDecoderCtx &col_ctx,
+      const sql::ObWhiteFilterExecutor &filter,
+      const ObIRowIndex *row_index,
+      ObBitmap &result_bitmap,
+      int (*lambda)(
+          const common::ObObj &cur_obj,
+          const sql::ObWhiteFilterExecutor &filter,
+          bool &result)) const;
+
+private:
+  const ObSymbolStringHeader *header_;
+};
+
+OB_INLINE int ObSymbolStringDecoder::init(
+    const ObMicroBlockHeader &micro_block_header,
+    const ObColumnHeader &column_header,
+    const char *meta)
+{
+  // performance critical, don't check params, already checked upper layer
+  UNUSEDx(micro_block_header);
+  int ret = common::OB_SUCCESS;
+  if (is_inited()) {
+    ret = common::OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "init twice", K(ret));
+  } else {
+    meta += column_header.offset_;
+    header_ = reinterpret_cast<const ObSymbolStringHeader *>(meta);
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_ENCODING_OB_SYMBOL_STRING_DECODER_H_
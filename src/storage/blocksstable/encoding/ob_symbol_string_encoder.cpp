@@ -0,0 +1,369 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_symbol_string_encoder.h"
+
+#include <algorithm>
+#include "storage/blocksstable/ob_data_buffer.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+using namespace common;
+
+void ObStringSymbolTable::init(const ObStringSymbol *symbols, const int64_t symbol_cnt)
+{
+  symbols_ = symbols;
+  symbol_cnt_ = symbol_cnt;
+  MEMSET(begin_, 0, sizeof(begin_));
+  MEMSET(end_, 0, sizeof(end_));
+  for (int64_t i = symbol_cnt - 1; i >= 0; --i) {
+    const unsigned char c = static_cast<unsigned char>(symbols[i].val_ & 0xFF);
+    if (0 == end_[c]) {
+      end_[c] = static_cast<uint16_t>(i + 1);
+    }
+    begin_[c] = static_cast<uint16_t>(i);
+  }
+}
+
+const ObColumnHeader::Type ObSymbolStringEncoder::type_;
+
+ObSymbolStringEncoder::ObSymbolStringEncoder()
+    : max_string_size_(-1), sum_size_(0), code_size_(0), null_cnt_(0), nope_cnt_(0),
+    sample_step_(1), symbol_cnt_(0), symbol_table_(), codes_(), header_(NULL),
+    allocator_(blocksstable::OB_ENCODING_LABEL_SYMBOL_STRING)
+{
+  MEMSET(symbols_, 0, sizeof(symbols_));
+}
+
+int ObSymbolStringEncoder::init(
+    const ObColumnEncodingCtx &ctx,
+    const int64_t column_index,
+    const ObConstDatumRowArray &rows)
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_FAIL(ObIColumnEncoder::init(ctx, column_index, rows))) {
+    LOG_WARN("init base column encoder failed",
+        K(ret), K(ctx), K(column_index), "row count", rows.count());
+  } else {
+    column_header_.type_ = type_;
+    max_string_size_ = ctx.max_string_size_;
+    const ObObjTypeStoreClass sc = get_store_class_map()[
+        ob_obj_type_class(column_type_.get_type())];
+    if (OB_UNLIKELY(!is_string_encoding_valid(sc))) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("not supported type for symbol string", K(ret), K(sc), K_(column_index));
+    }
+  }
+  return ret;
+}
+
+void ObSymbolStringEncoder::reuse()
+{
+  ObIColumnEncoder::reuse();
+  max_string_size_ = -1;
+  sum_size_ = 0;
+  code_size_ = 0;
+  null_cnt_ = 0;
+  nope_cnt_ = 0;
+  sample_step_ = 1;
+  symbol_cnt_ = 0;
+  MEMSET(symbols_, 0, sizeof(symbols_));
+  symbol_table_.init(symbols_, 0);
+  codes_.reuse();
+  header_ = NULL;
+  allocator_.reuse();
+}
+
+int ObSymbolStringEncoder::traverse(bool &suitable)
+{
+  int ret = OB_SUCCESS;
+  suitable = false;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    const ObColDatums &datums = *ctx_->col_datums_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < datums.count(); ++i) {
+      const ObDatum &datum = datums.at(i);
+      if (datum.is_null()) {
+        null_cnt_++;
+      } else if (datum.is_nop()) {
+        nope_cnt_++;
+      } else if (datum.is_ext()) {
+        ret = OB_NOT_SUPPORTED;
+        LOG_WARN("not supported extend object type",
+            K(ret), K(datum), K_(column_type), K_(column_index));
+      } else {
+        sum_size_ += datum.len_;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (datums.count() - null_cnt_ - nope_cnt_ <= 1 || 0 == sum_size_) {
+      // leave to const, dict or raw encoder
+    } else if (OB_FAIL(build_symbol_table())) {
+      LOG_WARN("build symbol table failed", K(ret), K_(column_index));
+    } else if (OB_FAIL(encode_strings())) {
+      LOG_WARN("encode strings failed", K(ret), K_(column_index));
+    } else if (code_size_ + meta_size() < sum_size_) {
+      suitable = true;
+      desc_.is_var_data_ = true;
+      desc_.need_data_store_ = true;
+      desc_.has_null_ = null_cnt_ > 0;
+      desc_.has_nope_ = nope_cnt_ > 0;
+      desc_.need_extend_value_bit_store_ = desc_.has_null_ || desc_.has_nope_;
+      if (desc_.need_extend_value_bit_store_) {
+        column_header_.set_has_extend_value_attr();
+      }
+    }
+    LOG_DEBUG("symbol string traverse", K_(column_index), K(suitable), K_(symbol_cnt),
+        K_(sum_size), K_(code_size));
+  }
+  return ret;
+}
+
+void ObSymbolStringEncoder::add_candidate(
+    SymbolCandidate *buckets, const uint64_t val, const int64_t len)
+{
+  uint64_t pos = ((val * 0x9E3779B97F4A7C15UL) ^ static_cast<uint64_t>(len))
+      % CANDIDATE_BUCKET_CNT;
+  bool done = false;
+  // linear probing, candidates are dropped when the bucket array is crowded
+  for (int64_t i = 0; !done && i < CANDIDATE_BUCKET_CNT / 4; ++i) {
+    SymbolCandidate &c = buckets[pos];
+    if (0 == c.cnt_) {
+      c.val_ = val;
+      c.len_ = len;
+      c.cnt_ = 1;
+      done = true;
+    } else if (c.val_ == val && c.len_ == len) {
+      c.cnt_++;
+      done = true;
+    } else {
+      pos = (pos + 1) % CANDIDATE_BUCKET_CNT;
+    }
+  }
+}
+
+int ObSymbolStringEncoder::select_symbols(SymbolCandidate *buckets)
+{
+  int ret = OB_SUCCESS;
+  int64_t cnt = 0;
+  for (int64_t i = 0; i < CANDIDATE_BUCKET_CNT; ++i) {
+    // symbol used only once gains nothing
+    if (buckets[i].cnt_ > 1) {
+      buckets[cnt++] = buckets[i];
+    }
+  }
+  std::sort(buckets, buckets + cnt,
+      [](const SymbolCandidate &l, const SymbolCandidate &r) {
+        return l.cnt_ * l.len_ > r.cnt_ * r.len_;
+      });
+  symbol_cnt_ = cnt < ObStringSymbolTable::MAX_SYMBOL_CNT
+      ? cnt : ObStringSymbolTable::MAX_SYMBOL_CNT;
+  for (int64_t i = 0; i < symbol_cnt_; ++i) {
+    symbols_[i].val_ = buckets[i].val_;
+    symbols_[i].len_ = static_cast<uint8_t>(buckets[i].len_);
+  }
+  // group by the first byte and try the longest symbol first
+  std::sort(symbols_, symbols_ + symbol_cnt_,
+      [](const ObStringSymbol &l, const ObStringSymbol &r) {
+        return (l.val_ & 0xFF) < (r.val_ & 0xFF)
+            || ((l.val_ & 0xFF) == (r.val_ & 0xFF) && l.len_ > r.len_);
+      });
+  symbol_table_.init(symbols_, symbol_cnt_);
+  return ret;
+}
+
+int ObSymbolStringEncoder::build_symbol_table()
+{
+  int ret = OB_SUCCESS;
+  const ObColDatums &datums = *ctx_->col_datums_;
+  SymbolCandidate *buckets = NULL;
+  const int64_t buckets_size = sizeof(SymbolCandidate) * CANDIDATE_BUCKET_CNT;
+  if (OB_ISNULL(buckets = static_cast<SymbolCandidate *>(allocator_.alloc(buckets_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc memory failed", K(ret), K(buckets_size));
+  } else {
+    sample_step_ = std::max(1L, sum_size_ / SAMPLE_SIZE);
+    symbol_cnt_ = 0;
+    symbol_table_.init(symbols_, 0);
+    for (int64_t gen = 0; OB_SUCC(ret) && gen < GENERATION_CNT; ++gen) {
+      MEMSET(buckets, 0, buckets_size);
+      for (int64_t i = 0; i < datums.count(); i += sample_step_) {
+        const ObDatum &datum = datums.at(i);
+        if (datum.is_null() || datum.is_nop()) {
+          continue;
+        }
+        const unsigned char *str = reinterpret_cast<const unsigned char *>(datum.ptr_);
+        const int64_t len = datum.len_;
+        int64_t pos = 0;
+        uint64_t prev_val = 0;
+        int64_t prev_len = 0;
+        while (pos < len) {
+          const int64_t code = symbol_table_.match(str + pos, len - pos);
+          const uint64_t cur_val = code >= 0 ? symbols_[code].val_ : str[pos];
+          const int64_t cur_len = code >= 0 ? symbols_[code].len_ : 1;
+          add_candidate(buckets, cur_val, cur_len);
+          if (prev_len > 0 && prev_len + cur_len <= ObStringSymbolTable::MAX_SYMBOL_LEN) {
+            add_candidate(buckets, prev_val | (cur_val << (prev_len * CHAR_BIT)),
+                prev_len + cur_len);
+          }
+          prev_val = cur_val;
+          prev_len = cur_len;
+          pos += cur_len;
+        }
+      }
+      if (OB_FAIL(select_symbols(buckets))) {
+        LOG_WARN("select symbols failed", K(ret), K(gen));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObSymbolStringEncoder::encode_strings()
+{
+  int ret = OB_SUCCESS;
+  const ObColDatums &datums = *ctx_->col_datums_;
+  unsigned char *buf = NULL;
+  const int64_t buf_size = sum_size_ * 2;
+  code_size_ = 0;
+  if (OB_ISNULL(buf = static_cast<unsigned char *>(allocator_.alloc(buf_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc memory failed", K(ret), K(buf_size));
+  } else if (OB_FAIL(codes_.reserve(datums.count()))) {
+    LOG_WARN("reserve codes failed", K(ret), "count", datums.count());
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < datums.count(); ++i) {
+    const ObDatum &datum = datums.at(i);
+    ObString code;
+    if (!datum.is_null() && !datum.is_nop()) {
+      const int64_t len = symbol_table_.encode(
+          reinterpret_cast<const unsigned char *>(datum.ptr_), datum.len_, buf + code_size_);
+      code.assign_ptr(reinterpret_cast<char *>(buf + code_size_), static_cast<int32_t>(len));
+      code_size_ += len;
+    }
+    if (OB_FAIL(codes_.push_back(code))) {
+      LOG_WARN("push back code failed", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+int ObSymbolStringEncoder::store_meta(ObBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    header_ = reinterpret_cast<ObSymbolStringHeader *>(buf_writer.current());
+    const int64_t size = meta_size();
+    if (OB_FAIL(buf_writer.advance_zero(size))) {
+      LOG_WARN("advance meta store size failed", K(ret), K(size));
+    } else {
+      header_->version_ = ObSymbolStringHeader::OB_SYMBOL_STRING_HEADER_V1;
+      header_->max_string_size_ = static_cast<uint32_t>(max_string_size_);
+      header_->symbol_cnt_ = static_cast<uint8_t>(symbol_cnt_);
+      MEMCPY(header_->symbols_, symbols_, symbol_cnt_ * sizeof(ObStringSymbol));
+    }
+  }
+  return ret;
+}
+
+int ObSymbolStringEncoder::store_data(
+    const int64_t row_id, ObBitStream &bs, char *buf, const int64_t len)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_id < 0 || row_id >= rows_->count() || len < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_id), K(len));
+  } else {
+    const ObDatum &datum = rows_->at(row_id).get_datum(column_index_);
+    const ObStoredExtValue ext_val = get_stored_ext_value(datum);
+    if (STORED_NOT_EXT != ext_val) {
+      if (OB_FAIL(bs.set(column_header_.extend_value_index_,
+          extend_value_bit_, static_cast<int64_t>(ext_val)))) {
+        LOG_WARN("store extend value bit failed",
+            K(ret), K_(column_header), K_(extend_value_bit), K(ext_val));
+      }
+    } else {
+      const ObString &code = codes_.at(row_id);
+      MEMCPY(buf, code.ptr(), code.length());
+    }
+  }
+  return ret;
+}
+
+int ObSymbolStringEncoder::set_data_pos(const int64_t offset, const int64_t length)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_ISNULL(header_)) {
+    ret = OB_INNER_STAT_ERROR;
+    LOG_WARN("call set data pos before store meta", K(ret));
+  } else if (offset < 0 || length < 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid data position",
+        K(ret), K(offset), K(length), K(desc_), K_(column_header));
+  } else {
+    header_->offset_ = static_cast<uint32_t>(offset);
+    header_->length_ = static_cast<uint32_t>(length);
+  }
+  return ret;
+}
+
+int ObSymbolStringEncoder::get_var_length(const int64_t row_id, int64_t &length)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_id < 0 || row_id >= codes_.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_id));
+  } else {
+    length = codes_.at(row_id).length();
+  }
+  return ret;
+}
+
+int64_t ObSymbolStringEncoder::calc_size() const
+{
+  int64_t size = INT64_MAX;
+  if (is_inited_) {
+    size = meta_size() + DEF_VAR_INDEX_BYTE * rows_->count() + code_size_;
+  }
+  return size;
+}
+
+int ObSymbolStringEncoder::store_fix_data(ObBufferWriter &buf_writer)
+{
+  UNUSED(buf_writer);
+  return OB_NOT_SUPPORTED;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_SYMBOL_STRING_ENCODER_H_
+#define OCEANBASE_ENCODING_OB_SYMBOL_STRING_ENCODER_H_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_array.h"
+#include "ob_icolumn_encoder.h"
+#include "ob_encoding_util.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// symbol of 1 to 8 bytes, bytes are stored in %val_ in little endian
+struct ObStringSymbol
+{
+  uint64_t val_;
+  uint8_t len_;
+
+  TO_STRING_KV(K_(val), K_(len));
+} __attribute__((packed));
+
+// Symbol table of at most 255 symbols, code 255 escapes the next literal byte.
+// Strings are encoded by the longest symbol matched at each position, the encoding is
+// deterministic, so equal strings have equal codes.
+class ObStringSymbolTable
+{
+public:
+  static const int64_t MAX_SYMBOL_CNT = 255;
+  static const int64_t MAX_SYMBOL_LEN = sizeof(uint64_t);
+  static const unsigned char ESCAPE_CODE = 255;
+
+  ObStringSymbolTable() : symbols_(NULL), symbol_cnt_(0)
+  {
+    MEMSET(begin_, 0, sizeof(begin_));
+    MEMSET(end_, 0, sizeof(end_));
+  }
+
+  // @symbols should be sorted by the first byte, then by length in descending order
+  void init(const ObStringSymbol *symbols, const int64_t symbol_cnt);
+
+  OB_INLINE static uint64_t load(const unsigned char *str, const int64_t len)
+  {
+    uint64_t v = 0;
+    MEMCPY(&v, str, len < MAX_SYMBOL_LEN ? len : MAX_SYMBOL_LEN);
+    return v;
+  }
+  OB_INLINE static uint64_t mask(const int64_t len)
+  {
+    return len >= MAX_SYMBOL_LEN ? UINT64_MAX : (1UL << (len * CHAR_BIT)) - 1;
+  }
+
+  // code of the longest symbol matched at the beginning of %str, -1 for no symbol matched
+  OB_INLINE int64_t match(const unsigned char *str, const int64_t len) const
+  {
+    int64_t code = -1;
+    const uint64_t v = load(str, len);
+    for (int64_t i = begin_[*str]; i < end_[*str] && code < 0; ++i) {
+      if (symbols_[i].len_ <= len && (v & mask(symbols_[i].len_)) == symbols_[i].val_) {
+        code = i;
+      }
+    }
+    return code;
+  }
+
+  // performance critical, do not check parameters.
+  // %buf should have 2 * %len bytes at least, return the encoded length.
+  OB_INLINE int64_t encode(const unsigned char *str, const int64_t len, unsigned char *buf) const
+  {
+    int64_t pos = 0;
+    int64_t out = 0;
+    while (pos < len) {
+      const int64_t code = match(str + pos, len - pos);
+      if (code >= 0) {
+        buf[out++] = static_cast<unsigned char>(code);
+        pos += symbols_[code].len_;
+      } else {
+        buf[out++] = ESCAPE_CODE;
+        buf[out++] = str[pos++];
+      }
+    }
+    return out;
+  }
+
+  // performance critical, do not check parameters.
+  // %buf should have MAX_SYMBOL_LEN more bytes than the decoded string, return the decoded length.
+  OB_INLINE static int64_t decode(const ObStringSymbol *symbols,
+                                  const unsigned char *code, const int64_t code_len,
+                                  unsigned char *buf)
+  {
+    int64_t out = 0;
+    for (int64_t i = 0; i < code_len; ++i) {
+      if (ESCAPE_CODE == code[i]) {
+        buf[out++] = code[++i];
+      } else {
+        // copy the whole word, bytes over the symbol length are overwritten later
+        MEMCPY(buf + out, &symbols[code[i]].val_, MAX_SYMBOL_LEN);
+        out += symbols[code[i]].len_;
+      }
+    }
+    return out;
+  }
+
+private:
+  const ObStringSymbol *symbols_;
+  int64_t symbol_cnt_;
+  // symbols starting with byte c are in [begin_[c], end_[c])
+  uint16_t begin_[1 << CHAR_BIT];
+  uint16_t end_[1 << CHAR_BIT];
+};
+
+struct ObSymbolStringHeader
+{
+  static constexpr uint8_t OB_SYMBOL_STRING_HEADER_V1 = 0;
+  uint8_t version_;
+  uint32_t offset_;
+  uint32_t length_;
+  uint32_t max_string_size_;
+  uint8_t symbol_cnt_;
+  ObStringSymbol symbols_[0];
+
+  void reset() { memset(this, 0, sizeof(*this)); }
+
+  TO_STRING_KV(K_(offset), K_(length), K_(max_string_size), K_(symbol_cnt));
+} __attribute__((packed));
+
+// Encoding for high cardinality short strings, e.g. URLs, emails and device ids, which
+// are not suitable for dict encoding.
+//
+// A static symbol table (the way of FSST) is built from a sample of the column in several
+// generations: each generation encodes the sample with the current table, counts the used
+// symbols and the concatenations of adjacent symbols, and keeps the 255 candidates with the
+// largest gain (count * length). Each cell is stored as the codes of its symbols, so a single
+// row is decoded without decompressing the block, and equality is evaluated on the codes.
+class ObSymbolStringEncoder : public ObIColumnEncoder
+{
+public:
+  static const ObColumnHeader::Type type_ = ObColumnHeader::SYMBOL_PACKING;
+  ObSymbolStringEncoder();
+  virtual ~ObSymbolStringEncoder() {}
+
+  virtual int init(
+      const ObColumnEncodingCtx &ctx,
+      const int64_t column_index,
+      const ObConstDatumRowArray &rows) override;
+
+  virtual int set_data_pos(const int64_t offset, const int64_t length) override;
+  virtual int get_var_length(const int64_t row_id, int64_t &length) override;
+  virtual int store_meta(ObBufferWriter &buf_writer) override;
+  virtual int store_data(
+      const int64_t row_id, ObBitStream &bs, char *buf, const int64_t len) override;
+
+  virtual int traverse(bool &suitable) override;
+  virtual int64_t calc_size() const override;
+  virtual ObColumnHeader::Type get_type() const override { return type_; }
+
+  virtual void reuse() override;
+  virtual int store_fix_data(ObBufferWriter &buf_writer) override;
+
+private:
+  struct SymbolCandidate
+  {
+    uint64_t val_;
+    int64_t len_;
+    int64_t cnt_;
+  };
+  static const int64_t GENERATION_CNT = 5;
+  static const int64_t SAMPLE_SIZE = 16L << 10;
+  static const int64_t CANDIDATE_BUCKET_CNT = 1L << 12;
+
+  int build_symbol_table();
+  void add_candidate(SymbolCandidate *buckets, const uint64_t val, const int64_t len);
+  int select_symbols(SymbolCandidate *buckets);
+  int encode_strings();
+  int64_t meta_size() const
+  {
+    return sizeof(ObSymbolStringHeader) + symbol_cnt_ * sizeof(ObStringSymbol);
+  }
+
+private:
+  int64_t max_string_size_;
+  int64_t sum_size_;
+  int64_t code_size_;
+  int64_t null_cnt_;
+  int64_t nope_cnt_;
+  int64_t sample_step_;
+  int64_t symbol_cnt_;
+  ObStringSymbol symbols_[ObStringSymbolTable::MAX_SYMBOL_CNT];
+  ObStringSymbolTable symbol_table_;
+  // encoded cells, empty for null and nop
+  common::ObArray<common::ObString> codes_;
+  ObSymbolStringHeader *header_;
+  common::ObArenaAllocator allocator_;
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+#endif // OCEANBASE_ENCODING_OB_SYMBOL_STRING_ENCODER_H_
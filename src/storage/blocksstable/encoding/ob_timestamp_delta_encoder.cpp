@@ -0,0 +1,234 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_timestamp_delta_encoder.h"
+
+#include <limits>
+#include "storage/blocksstable/ob_data_buffer.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+using namespace common;
+
+const ObColumnHeader::Type ObTimestampDeltaEncoder::type_;
+
+ObTimestampDeltaEncoder::ObTimestampDeltaEncoder()
+  : store_class_(ObExtendSC), type_store_size_(0), mask_(0), reverse_mask_(0),
+    base_(0), stride_(0), header_(NULL)
+{
+}
+
+int ObTimestampDeltaEncoder::init(
+    const ObColumnEncodingCtx &ctx,
+    const int64_t column_index,
+    const ObConstDatumRowArray &rows)
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_FAIL(ObIColumnEncoder::init(ctx, column_index, rows))) {
+    LOG_WARN("init base column encoder failed",
+        K(ret), K(ctx), K(column_index), "row count", rows.count());
+  } else {
+    const ObObjTypeClass tc = ob_obj_type_class(column_type_.get_type());
+    store_class_ = get_store_class_map()[tc];
+    type_store_size_ = get_type_size_map()[column_type_.get_type()];
+    if ((ObIntSC != store_class_ && ObUIntSC != store_class_)
+        || ObFloatTC == tc || ObDoubleTC == tc || type_store_size_ <= 0) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("not supported type for timestamp delta",
+          K(ret), K_(store_class), K_(type_store_size), K_(column_index));
+    } else {
+      mask_ = INTEGER_MASK_TABLE[type_store_size_];
+      if (ObIntSC == store_class_) {
+        reverse_mask_ = ~mask_;
+      }
+      column_header_.type_ = type_;
+    }
+  }
+  return ret;
+}
+
+void ObTimestampDeltaEncoder::reuse()
+{
+  ObIColumnEncoder::reuse();
+  store_class_ = ObExtendSC;
+  type_store_size_ = 0;
+  mask_ = 0;
+  reverse_mask_ = 0;
+  base_ = 0;
+  stride_ = 0;
+  header_ = NULL;
+  is_inited_ = false;
+}
+
+int ObTimestampDeltaEncoder::traverse(bool &suitable)
+{
+  int ret = OB_SUCCESS;
+  suitable = false;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    const ObColDatums &datums = *ctx_->col_datums_;
+    int64_t first_row = -1;
+    int64_t last_row = -1;
+    uint64_t first_value = 0;
+    uint64_t last_value = 0;
+    // value range, what integer base diff would store
+    int64_t min_int = INT64_MAX;
+    int64_t max_int = INT64_MIN;
+    uint64_t min_uint = UINT64_MAX;
+    uint64_t max_uint = 0;
+    for (int64_t i = 0; i < datums.count(); ++i) {
+      const ObDatum &datum = datums.at(i);
+      if (!datum.is_null() && !datum.is_nop()) {
+        const uint64_t v = get_value(datum);
+        if (first_row < 0) {
+          first_row = i;
+          first_value = v;
+        }
+        last_row = i;
+        last_value = v;
+        min_int = std::min(min_int, static_cast<int64_t>(v));
+        max_int = std::max(max_int, static_cast<int64_t>(v));
+        min_uint = std::min(min_uint, v);
+        max_uint = std::max(max_uint, v);
+      }
+    }
+
+    stride_ = 0;
+    if (last_row > first_row) {
+      stride_ = static_cast<int64_t>(last_value - first_value) / (last_row - first_row);
+    }
+    if (0 == stride_) {
+      // constant or unordered values, leave them to integer base diff
+    } else {
+      base_ = first_value - static_cast<uint64_t>(first_row) * static_cast<uint64_t>(stride_);
+      int64_t min_delta = INT64_MAX;
+      int64_t max_delta = INT64_MIN;
+      for (int64_t i = 0; i < datums.count(); ++i) {
+        const ObDatum &datum = datums.at(i);
+        if (!datum.is_null() && !datum.is_nop()) {
+          const int64_t d = static_cast<int64_t>(delta(i, datum));
+          min_delta = std::min(min_delta, d);
+          max_delta = std::max(max_delta, d);
+        }
+      }
+      // shift the line down so that all stored deltas are non-negative
+      base_ += static_cast<uint64_t>(min_delta);
+      const uint64_t max_stored_delta =
+          static_cast<uint64_t>(max_delta) - static_cast<uint64_t>(min_delta);
+      const uint64_t range = ObIntSC == store_class_
+          ? static_cast<uint64_t>(max_int) - static_cast<uint64_t>(min_int)
+          : max_uint - min_uint;
+
+      bool bit_packing = false;
+      int64_t range_size = get_packing_size(bit_packing, range);
+      if (!bit_packing) {
+        range_size *= CHAR_BIT;
+      }
+      bit_packing = false;
+      int64_t delta_size = get_packing_size(bit_packing, max_stored_delta);
+      if (!bit_packing) {
+        delta_size *= CHAR_BIT;
+      }
+      LOG_DEBUG("timestamp delta size", K_(column_index), K(delta_size), K(range_size),
+          K_(base), K_(stride));
+      if ((range_size - delta_size) * rows_->count() > sizeof(stride_) * CHAR_BIT) {
+        suitable = true;
+        if (bit_packing) {
+          desc_.bit_packing_length_ = delta_size;
+        } else {
+          desc_.fix_data_length_ = delta_size / CHAR_BIT;
+        }
+        desc_.need_data_store_ = true;
+        desc_.has_null_ = ctx_->null_cnt_ > 0;
+        desc_.has_nope_ = ctx_->nope_cnt_ > 0;
+        desc_.need_extend_value_bit_store_ = desc_.has_null_ || desc_.has_nope_;
+        if (desc_.need_extend_value_bit_store_) {
+          column_header_.set_has_extend_value_attr();
+        }
+        if (desc_.bit_packing_length_ > 0) {
+          column_header_.set_bit_packing_attr();
+        }
+        column_header_.set_fix_lenght_attr();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObTimestampDeltaEncoder::store_meta(ObBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    header_ = reinterpret_cast<ObTimestampDeltaHeader *>(buf_writer.current());
+    if (OB_FAIL(buf_writer.advance_zero(sizeof(*header_)))) {
+      LOG_WARN("advance meta store size failed", K(ret));
+    } else {
+      header_->version_ = ObTimestampDeltaHeader::OB_TIMESTAMP_DELTA_HEADER_V1;
+      header_->base_ = base_;
+      header_->stride_ = stride_;
+      LOG_DEBUG("timestamp delta meta", K(*header_));
+    }
+  }
+  return ret;
+}
+
+int64_t ObTimestampDeltaEncoder::calc_size() const
+{
+  int64_t size = INT64_MAX;
+  if (is_inited_) {
+    if (desc_.bit_packing_length_ > 0) {
+      size = (rows_->count() * desc_.bit_packing_length_ + CHAR_BIT - 1) / CHAR_BIT;
+    } else {
+      size = rows_->count() * desc_.fix_data_length_;
+    }
+  }
+  return size + sizeof(*header_);
+}
+
+int ObTimestampDeltaEncoder::store_fix_data(ObBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(!is_valid_fix_encoder())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K_(desc));
+  } else {
+    DeltaGetter getter(*this);
+    FixDataSetter setter(*this);
+    header_->length_ = static_cast<uint8_t>(desc_.bit_packing_length_ > 0
+        ? desc_.bit_packing_length_
+        : desc_.fix_data_length_);
+    if (OB_FAIL(fill_column_store(buf_writer, *ctx_->col_datums_, getter, setter))) {
+      LOG_WARN("fill column store failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_TIMESTAMP_DELTA_ENCODER_H_
+#define OCEANBASE_ENCODING_OB_TIMESTAMP_DELTA_ENCODER_H_
+
+#include "ob_icolumn_encoder.h"
+#include "ob_encoding_util.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// Value of row i is base_ + i * stride_ + delta(i), all in uint64 arithmetic.
+struct ObTimestampDeltaHeader
+{
+  static constexpr uint8_t OB_TIMESTAMP_DELTA_HEADER_V1 = 0;
+  uint8_t version_;
+  uint8_t length_;
+  uint64_t base_;
+  int64_t stride_;
+
+  ObTimestampDeltaHeader()
+    : version_(OB_TIMESTAMP_DELTA_HEADER_V1), length_(0), base_(0), stride_(0)
+  {
+  }
+
+  TO_STRING_KV(K_(length), K_(base), K_(stride));
+} __attribute__((packed));
+
+// Encoding for increasing integers, e.g. DATETIME/TIMESTAMP columns of time series
+// and sequence columns.
+//
+// Rows are sampled at a (nearly) fixed interval, so the delta of delta is close to zero.
+// Instead of chaining the deltas, which breaks random access, we fit the line through
+// the first and last value and store the accumulated delta of delta of each row, which is
+// its distance to the line, bit packed. Any row is decoded in O(1).
+class ObTimestampDeltaEncoder : public ObIColumnEncoder
+{
+public:
+  static const ObColumnHeader::Type type_ = ObColumnHeader::TIMESTAMP_DELTA;
+
+  ObTimestampDeltaEncoder();
+  virtual ~ObTimestampDeltaEncoder() {}
+
+  virtual int init(
+      const ObColumnEncodingCtx &ctx,
+      const int64_t column_index,
+      const ObConstDatumRowArray &rows) override;
+
+  virtual void reuse() override;
+  virtual int store_meta(ObBufferWriter &buf_writer) override;
+  virtual int store_data(
+      const int64_t row_id, ObBitStream &bs, char *buf, const int64_t len) override
+  {
+    UNUSEDx(row_id, bs, buf, len);
+    return common::OB_NOT_SUPPORTED;
+  }
+
+  virtual int traverse(bool &suitable) override;
+  virtual int64_t calc_size() const override;
+  virtual ObColumnHeader::Type get_type() const { return type_; }
+  virtual int store_fix_data(ObBufferWriter &buf_writer) override;
+
+public:
+  struct DeltaGetter
+  {
+    explicit DeltaGetter(const ObTimestampDeltaEncoder &encoder) : encoder_(encoder) {}
+    inline int operator()(const int64_t row_id, const common::ObDatum &datum, uint64_t &v)
+    {
+      v = encoder_.delta(row_id, datum);
+      return common::OB_SUCCESS;
+    }
+
+    const ObTimestampDeltaEncoder &encoder_;
+  };
+
+  struct FixDataSetter
+  {
+    explicit FixDataSetter(const ObTimestampDeltaEncoder &encoder) : encoder_(encoder) {}
+    inline int operator()(
+        const int64_t row_id,
+        const common::ObDatum &datum,
+        char *buf,
+        const int64_t len) const
+    {
+      // performance critical, do not check parameters
+      uint64_t v = encoder_.delta(row_id, datum);
+      MEMCPY(buf, &v, len);
+      return common::OB_SUCCESS;
+    }
+
+    const ObTimestampDeltaEncoder &encoder_;
+  };
+
+private:
+  // value of the datum, sign extended to 64 bits for signed types
+  OB_INLINE uint64_t get_value(const common::ObDatum &datum) const
+  {
+    uint64_t v = datum.get_uint64() & mask_;
+    if (0 != reverse_mask_ && (v & (reverse_mask_ >> 1))) {
+      v |= reverse_mask_;
+    }
+    return v;
+  }
+  OB_INLINE uint64_t delta(const int64_t row_id, const common::ObDatum &datum) const
+  {
+    return get_value(datum) - base_ - static_cast<uint64_t>(row_id) * static_cast<uint64_t>(stride_);
+  }
+
+private:
+  ObObjTypeStoreClass store_class_;
+  int64_t type_store_size_;
+  uint64_t mask_;
+  uint64_t reverse_mask_;
+  uint64_t base_;
+  int64_t stride_;
+  // is null before write meta
+  ObTimestampDeltaHeader *header_;
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_ENCODING_OB_TIMESTAMP_DELTA_ENCODER_H_
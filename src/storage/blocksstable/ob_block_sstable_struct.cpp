@@ -19,6 +19,7 @@
 #include "lib/utility/serialization.h"
 #include "lib/utility/utility.h"
 #include "share/scn.h"
+#include "share/ob_cluster_version.h"
 #include "ob_block_manager.h"
 #include "ob_data_buffer.h"
 #include "share/config/ob_server_config.h"
@@ -37,9 +38,9 @@ namespace blocksstable
 const char *BLOCK_SSTBALE_DIR_NAME = "sstable";
 const char *BLOCK_SSTBALE_FILE_NAME = "block_file";
 
-const bool ObMicroBlockEncoderOpt::ENCODINGS_DEFAULT[ObColumnHeader::MAX_TYPE] = {true, true, true, true, true, true, true, true, true, true};
-const bool ObMicroBlockEncoderOpt::ENCODINGS_NONE[ObColumnHeader::MAX_TYPE] = {false, false, false, false, false, false, false, false, false, false};
-const bool ObMicroBlockEncoderOpt::ENCODINGS_FOR_PERFORMANCE[ObColumnHeader::MAX_TYPE] = {true, true, false, true, false, false, false, false, false, false};
+const bool ObMicroBlockEncoderOpt::ENCODINGS_DEFAULT[ObColumnHeader::MAX_TYPE] = {true, true, true, true, true, true, true, true, true, true, true, true, true};
+const bool ObMicroBlockEncoderOpt::ENCODINGS_NONE[ObColumnHeader::MAX_TYPE] = {false, false, false, false, false, false, false, false, false, false, false, false, false};
+const bool ObMicroBlockEncoderOpt::ENCODINGS_FOR_PERFORMANCE[ObColumnHeader::MAX_TYPE] = {true, true, false, true, false, false, false, false, false, false, false, false, false};
 
 //================================ObStorageEnv======================================
 bool ObStorageEnv::is_valid() const
@@ -80,6 +81,26 @@ bool ObMicroBlockEncodingCtx::is_valid() const
       && (ENCODING_ROW_STORE == row_store_type_ || SELECTIVE_ENCODING_ROW_STORE == row_store_type_);
 }
 
+bool ObMicroBlockEncodingCtx::enable_encoding(const int64_t type) const
+{
+  bool enable = encoder_opt_.enable(type);
+  if (enable) {
+    switch (type) {
+      case ObColumnHeader::TIMESTAMP_DELTA:
+      case ObColumnHeader::FLOAT_PACKING:
+      case ObColumnHeader::SYMBOL_PACKING: {
+        // encodings added in 4.2, not known by the decoders of the lower versions
+        enable = major_working_cluster_version_ >= DATA_VERSION_4_2_0_0;
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+  }
+  return enable;
+}
+
 //======================ObPreviousEncodingArray========================
 template<int64_t max_size>
 int ObPreviousEncodingArray<max_size>::put(const ObPreviousEncoding &prev)
@@ -292,6 +292,9 @@ struct ObColumnHeader
     STRING_PREFIX,
     COLUMN_EQUAL,
     COLUMN_SUBSTR,
+    TIMESTAMP_DELTA,
+    FLOAT_PACKING,
+    SYMBOL_PACKING,
     MAX_TYPE
   };
 
@@ -362,6 +365,9 @@ struct ObMicroBlockEncoderOpt
   bool enable_bit_packing_;
   bool store_sorted_var_len_numbers_dict_;
   const bool *encodings_;
+  // build at most %planned_encoding_cnt_ encodings with the smallest estimated size for each
+  // column, trade compression ratio for less cpu. 0 means trying all the encodings.
+  int64_t planned_encoding_cnt_;
 
   bool &enable(const int64_t type)
   {
@@ -387,6 +393,9 @@ struct ObMicroBlockEncoderOpt
   bool &enable_rle() { return enable(ObColumnHeader::RLE); }
   bool &enable_const() { return enable(ObColumnHeader::CONST); }
   bool &enable_str_prefix() { return enable(ObColumnHeader::STRING_PREFIX); }
+  bool &enable_timestamp_delta() { return enable(ObColumnHeader::TIMESTAMP_DELTA); }
+  bool &enable_float_packing() { return enable(ObColumnHeader::FLOAT_PACKING); }
+  bool &enable_symbol_packing() { return enable(ObColumnHeader::SYMBOL_PACKING); }
 
   const bool &enable_raw() const { return enable(ObColumnHeader::RAW); }
   const bool &enable_dict() const { return enable(ObColumnHeader::DICT); }
@@ -396,11 +405,18 @@ struct ObMicroBlockEncoderOpt
   const bool &enable_rle() const { return enable(ObColumnHeader::RLE); }
   const bool &enable_const() const { return enable(ObColumnHeader::CONST); }
   const bool &enable_str_prefix() const { return enable(ObColumnHeader::STRING_PREFIX); }
+  const bool &enable_timestamp_delta() const { return enable(ObColumnHeader::TIMESTAMP_DELTA); }
+  const bool &enable_float_packing() const { return enable(ObColumnHeader::FLOAT_PACKING); }
+  const bool &enable_symbol_packing() const { return enable(ObColumnHeader::SYMBOL_PACKING); }
 
-  ObMicroBlockEncoderOpt() { set_store_type(ENCODING_ROW_STORE); }
+  ObMicroBlockEncoderOpt() : planned_encoding_cnt_(0) { set_store_type(ENCODING_ROW_STORE); }
 
-  OB_INLINE bool is_valid() const { return enable_raw(); }
-  OB_INLINE void reset() { set_store_type(FLAT_ROW_STORE); }
+  OB_INLINE bool is_valid() const { return enable_raw() && planned_encoding_cnt_ >= 0; }
+  OB_INLINE void reset()
+  {
+    set_store_type(FLAT_ROW_STORE);
+    planned_encoding_cnt_ = 0;
+  }
   OB_INLINE void set_store_type(common::ObRowStoreType store_type) {
     switch (store_type) {
       case SELECTIVE_ENCODING_ROW_STORE:
@@ -424,7 +440,7 @@ struct ObMicroBlockEncoderOpt
 #define KF(f) #f, f()
   TO_STRING_KV(K_(enable_bit_packing), K_(store_sorted_var_len_numbers_dict),
       KF(enable_raw), KF(enable_dict), KF(enable_int_diff), KF(enable_str_diff),
-      KF(enable_hex_pack), KF(enable_rle),KF(enable_const));
+      KF(enable_hex_pack), KF(enable_rle),KF(enable_const), K_(planned_encoding_cnt));
 #undef KF
 };
 
@@ -547,6 +563,8 @@ struct ObMicroBlockEncodingCtx
   {
   }
   bool is_valid() const;
+  // the encoding is enabled and can be read by all the servers of the working data version
+  bool enable_encoding(const int64_t type) const;
   TO_STRING_KV(K_(macro_block_size), K_(micro_block_size), K_(rowkey_column_cnt),
       K_(column_cnt), KP_(col_descs), K_(estimate_block_size), K_(real_block_size),
       K_(micro_block_cnt), K_(encoder_opt), K_(previous_encodings), KP_(column_encodings),
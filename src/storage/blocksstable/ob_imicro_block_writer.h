@@ -112,6 +112,8 @@ public:
   virtual int64_t get_original_size() const = 0;
   virtual void reset() = 0;
   virtual void dump_diagnose_info() const {};
+  // time used to choose column encoders of the current block, encoding format only
+  virtual int64_t get_encoder_select_time() const { return 0; }
   virtual int append_hash_index(ObMicroBlockHashIndexBuilder& hash_index_builder)
   {
     int ret = OB_NOT_SUPPORTED;
@@ -218,6 +218,7 @@ int ObDataStoreDesc::init(
       STORAGE_LOG(WARN, "Failed to make the row store type", K(ret));
     } else if (encoding_enabled()) {
       encoder_opt_.set_store_type(row_store_type_);
+      encoder_opt_.planned_encoding_cnt_ = GCONF._encoding_planned_encoder_count;
     }
 
     if (OB_SUCC(ret) && is_major) {
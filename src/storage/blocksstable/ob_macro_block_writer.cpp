@@ -14,6 +14,7 @@
 
 #include "common/row/ob_row.h"
 #include "lib/compress/ob_compressor_pool.h"
+#include "lib/thread/ob_thread_name.h"
 #include "lib/utility/ob_tracepoint.h"
 #include "share/config/ob_server_config.h"
 #include "share/ob_force_print_log.h"
@@ -348,6 +349,346 @@ void ObMicroBlockAdaptiveSplitter::ObMicroCompressionInfo::update(const int64_t
     }
 }
 
+/**
+ * ---------------------------------------------------------ObMicroBlockCompressPipeline--------------------------------------------------------------
+ */
+ObMicroBlockCompressPipeline::Task::Task()
+  : pipeline_(nullptr),
+    raw_desc_(),
+    micro_block_desc_(),
+    header_(),
+    micro_helper_(),
+    allocator_("MicroCompTask", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID()),
+    block_allocator_("MicroCompTask", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID()),
+    encoder_select_time_(0),
+    ret_(OB_SUCCESS),
+    is_done_(false)
+{
+}
+
+void ObMicroBlockCompressPipeline::Task::reuse()
+{
+  raw_desc_.reset();
+  micro_block_desc_.reset();
+  header_.reset();
+  block_allocator_.reuse();
+  encoder_select_time_ = 0;
+  ret_ = OB_SUCCESS;
+  is_done_ = false;
+}
+
+ObMicroBlockCompressPipeline::ObMicroBlockCompressPipeline()
+  : is_inited_(false),
+    task_cnt_(0),
+    tasks_(nullptr),
+    head_(0),
+    tail_(0),
+    cond_(),
+    allocator_("MicroCompPipe", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID()),
+    service_(nullptr)
+{
+}
+
+ObMicroBlockCompressPipeline::~ObMicroBlockCompressPipeline()
+{
+  destroy();
+}
+
+int ObMicroBlockCompressPipeline::init(
+    const int64_t thread_cnt,
+    ObDataStoreDesc &data_store_desc,
+    ObTableReadInfo &read_info)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  const int64_t task_cnt = thread_cnt * TASK_CNT_PER_THREAD;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "init twice", K(ret));
+  } else if (OB_UNLIKELY(thread_cnt <= 0 || thread_cnt > ObMicroBlockCompressService::MAX_THREAD_CNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid thread count", K(ret), K(thread_cnt));
+  } else if (OB_ISNULL(service_ = MTL(ObMicroBlockCompressService *))) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "compress service is null", K(ret));
+  } else if (OB_FAIL(service_->prepare(thread_cnt))) {
+    STORAGE_LOG(WARN, "failed to prepare compress service", K(ret), K(thread_cnt));
+  } else if (OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    STORAGE_LOG(WARN, "failed to init thread cond", K(ret));
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(Task) * task_cnt))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "failed to alloc compress tasks", K(ret), K(task_cnt));
+  } else {
+    tasks_ = static_cast<Task *>(buf);
+    for (int64_t i = 0; i < task_cnt; ++i) {
+      new (tasks_ + i) Task();
+      tasks_[i].pipeline_ = this;
+    }
+    task_cnt_ = task_cnt;
+    for (int64_t i = 0; OB_SUCC(ret) && i < task_cnt_; ++i) {
+      if (OB_FAIL(tasks_[i].micro_helper_.open(data_store_desc, read_info, tasks_[i].allocator_))) {
+        STORAGE_LOG(WARN, "failed to open micro helper", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      is_inited_ = true;
+    }
+  }
+  if (OB_FAIL(ret) && OB_INIT_TWICE != ret) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObMicroBlockCompressPipeline::destroy()
+{
+  if (is_inited_) {
+    // the workers may still be compressing the submitted tasks
+    ObThreadCondGuard guard(cond_);
+    for (int64_t i = head_; i < tail_; ++i) {
+      while (!tasks_[i % task_cnt_].is_done_) {
+        cond_.wait(WAIT_INTERVAL_MS);
+      }
+    }
+  }
+  if (OB_NOT_NULL(tasks_)) {
+    for (int64_t i = 0; i < task_cnt_; ++i) {
+      tasks_[i].~Task();
+    }
+    tasks_ = nullptr;
+  }
+  task_cnt_ = 0;
+  head_ = 0;
+  tail_ = 0;
+  cond_.destroy();
+  allocator_.reset();
+  service_ = nullptr;
+  is_inited_ = false;
+}
+
+void ObMicroBlockCompressPipeline::process(Task &task)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(task.micro_helper_.compress_encrypt_micro_block(task.micro_block_desc_))) {
+    STORAGE_LOG(WARN, "failed to compress and encrypt micro block", K(ret), K(task));
+  }
+  ObThreadCondGuard guard(cond_);
+  task.ret_ = ret;
+  task.is_done_ = true;
+  cond_.broadcast();
+}
+
+int ObMicroBlockCompressPipeline::submit(
+    const ObMicroBlockDesc &micro_block_desc,
+    const int64_t encoder_select_time)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "not init", K(ret));
+  } else if (OB_UNLIKELY(!micro_block_desc.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid micro block desc", K(ret), K(micro_block_desc));
+  } else if (OB_UNLIKELY(is_full())) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "compress pipeline is full", K(ret), KPC(this));
+  } else {
+    // the micro block writer is reused right after submit, so copy the encoded block,
+    // the header is copied twice since compression updates the header in place
+    Task &task = tasks_[tail_ % task_cnt_];
+    const int64_t header_size = micro_block_desc.header_->header_size_;
+    const int64_t buf_size = header_size + micro_block_desc.buf_size_;
+    char *buf = nullptr;
+    task.reuse();
+    task.raw_desc_ = micro_block_desc;
+    if (OB_ISNULL(buf = static_cast<char *>(task.block_allocator_.alloc(buf_size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      STORAGE_LOG(WARN, "failed to alloc micro block buffer", K(ret), K(buf_size));
+    } else if (OB_FAIL(micro_block_desc.last_rowkey_.deep_copy(task.raw_desc_.last_rowkey_,
+        task.block_allocator_))) {
+      STORAGE_LOG(WARN, "failed to deep copy last rowkey", K(ret), K(micro_block_desc));
+    } else {
+      MEMCPY(buf, micro_block_desc.header_, header_size);
+      MEMCPY(buf + header_size, micro_block_desc.buf_, micro_block_desc.buf_size_);
+      ObMicroBlockHeader *raw_header = reinterpret_cast<ObMicroBlockHeader *>(buf);
+      MEMCPY(&task.header_, buf, ObMicroBlockHeader::COLUMN_CHECKSUM_PTR_OFFSET);
+      if (raw_header->has_column_checksum_) {
+        raw_header->column_checksums_ = reinterpret_cast<int64_t *>(
+            buf + ObMicroBlockHeader::COLUMN_CHECKSUM_PTR_OFFSET);
+        task.header_.column_checksums_ = raw_header->column_checksums_;
+      } else {
+        task.header_.column_checksums_ = nullptr;
+      }
+      task.raw_desc_.header_ = raw_header;
+      task.raw_desc_.buf_ = buf + header_size;
+      task.micro_block_desc_ = task.raw_desc_;
+      task.micro_block_desc_.header_ = &task.header_;
+      task.encoder_select_time_ = encoder_select_time;
+      ++tail_;
+      service_->push(task);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockCompressPipeline::wait_head(Task *&task)
+{
+  int ret = OB_SUCCESS;
+  task = nullptr;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "not init", K(ret));
+  } else if (OB_UNLIKELY(is_empty())) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "compress pipeline is empty", K(ret), KPC(this));
+  } else {
+    ObThreadCondGuard guard(cond_);
+    Task &head_task = tasks_[head_ % task_cnt_];
+    while (!head_task.is_done_) {
+      cond_.wait(WAIT_INTERVAL_MS);
+    }
+    task = &head_task;
+    ret = head_task.ret_;
+  }
+  return ret;
+}
+
+void ObMicroBlockCompressPipeline::pop_head()
+{
+  if (is_inited_ && !is_empty()) {
+    ObThreadCondGuard guard(cond_);
+    tasks_[head_ % task_cnt_].is_done_ = false;
+    ++head_;
+  }
+}
+
+/**
+ * ---------------------------------------------------------ObMicroBlockCompressService--------------------------------------------------------------
+ */
+void ObMicroBlockCompressService::WorkerPool::handle(void *task)
+{
+  ObMicroBlockCompressPipeline::Task *compress_task = static_cast<ObMicroBlockCompressPipeline::Task *>(task);
+  if (OB_NOT_NULL(compress_task) && OB_NOT_NULL(compress_task->pipeline_)) {
+    compress_task->pipeline_->process(*compress_task);
+  }
+}
+
+ObMicroBlockCompressService::ObMicroBlockCompressService()
+  : is_inited_(false),
+    is_stopped_(false),
+    thread_cnt_(0),
+    lock_(),
+    pool_()
+{
+}
+
+ObMicroBlockCompressService::~ObMicroBlockCompressService()
+{
+  destroy();
+}
+
+int ObMicroBlockCompressService::mtl_init(ObMicroBlockCompressService *&service)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(service)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "compress service is null", K(ret));
+  } else if (OB_FAIL(service->init())) {
+    STORAGE_LOG(WARN, "failed to init compress service", K(ret));
+  }
+  return ret;
+}
+
+int ObMicroBlockCompressService::init()
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "init twice", K(ret));
+  } else {
+    is_stopped_ = false;
+    thread_cnt_ = 0;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockCompressService::start()
+{
+  // the workers are started by the first compress pipeline
+  return OB_SUCCESS;
+}
+
+void ObMicroBlockCompressService::stop()
+{
+  lib::ObMutexGuard guard(lock_);
+  is_stopped_ = true;
+  if (thread_cnt_ > 0) {
+    // the tasks left in queue are compressed by the stopping workers
+    pool_.stop();
+  }
+}
+
+void ObMicroBlockCompressService::wait()
+{
+  lib::ObMutexGuard guard(lock_);
+  if (thread_cnt_ > 0) {
+    pool_.wait();
+  }
+}
+
+void ObMicroBlockCompressService::destroy()
+{
+  lib::ObMutexGuard guard(lock_);
+  if (thread_cnt_ > 0) {
+    pool_.destroy();
+  }
+  thread_cnt_ = 0;
+  is_inited_ = false;
+}
+
+int ObMicroBlockCompressService::prepare(const int64_t thread_cnt)
+{
+  int ret = OB_SUCCESS;
+  lib::ObMutexGuard guard(lock_);
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "not init", K(ret));
+  } else if (OB_UNLIKELY(thread_cnt <= 0 || thread_cnt > MAX_THREAD_CNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid thread count", K(ret), K(thread_cnt));
+  } else if (is_stopped_) {
+    ret = OB_IN_STOP_STATE;
+    STORAGE_LOG(WARN, "compress service is stopped", K(ret));
+  } else if (thread_cnt == thread_cnt_) {
+  } else if (0 == thread_cnt_) {
+    pool_.set_run_wrapper(MTL_CTX());
+    if (OB_FAIL(pool_.init(thread_cnt, MAX_TASK_CNT, "MicroCompress", MTL_ID()))) {
+      STORAGE_LOG(WARN, "failed to init compress workers", K(ret), K(thread_cnt));
+    } else {
+      thread_cnt_ = thread_cnt;
+    }
+  } else if (OB_FAIL(pool_.set_thread_count(thread_cnt))) {
+    STORAGE_LOG(WARN, "failed to set compress thread count", K(ret), K(thread_cnt));
+  } else {
+    thread_cnt_ = thread_cnt;
+  }
+  if (OB_SUCC(ret)) {
+    STORAGE_LOG(DEBUG, "prepare compress service", KPC(this));
+  }
+  return ret;
+}
+
+void ObMicroBlockCompressService::push(ObMicroBlockCompressPipeline::Task &task)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(pool_.push(&task))) {
+    // queue is full or the workers are stopped
+    STORAGE_LOG(DEBUG, "compress in the writer thread", K(ret));
+    task.pipeline_->process(task);
+  }
+}
+
 /**
  * ---------------------------------------------------------ObMacroBlockWriter--------------------------------------------------------------
  */
@@ -374,7 +715,8 @@ ObMacroBlockWriter::ObMacroBlockWriter()
    check_datum_row_(),
    callback_(nullptr),
    builder_(NULL),
-   data_block_pre_warmer_()
+   data_block_pre_warmer_(),
+   compress_pipeline_()
 {
   //macro_blocks_, macro_handles_
 }
@@ -386,6 +728,7 @@ ObMacroBlockWriter::~ObMacroBlockWriter()
 
 void ObMacroBlockWriter::reset()
 {
+  compress_pipeline_.destroy();
   data_store_desc_ = nullptr;
   if (OB_NOT_NULL(micro_writer_)) {
     micro_writer_->~ObIMicroBlockWriter();
@@ -493,6 +836,14 @@ int ObMacroBlockWriter::open(
     } else {
       builder_ = nullptr;
     }
+    if (OB_SUCC(ret) && OB_NOT_NULL(builder_) && data_store_desc.is_major_merge()
+        && !data_store_desc.need_prebuild_bloomfilter_) {
+      const int64_t compress_thread_cnt = GCONF._compaction_compress_thread_count;
+      if (compress_thread_cnt > 0
+          && OB_FAIL(compress_pipeline_.init(compress_thread_cnt, data_store_desc, read_info_))) {
+        STORAGE_LOG(WARN, "Failed to init compress pipeline", K(ret), K(compress_thread_cnt));
+      }
+    }
   }
   return ret;
 }
@@ -594,6 +945,8 @@ int ObMacroBlockWriter::append_macro_block(const ObMacroBlockDesc &macro_desc)
 
   if (micro_writer_->get_row_count() > 0 && OB_FAIL(build_micro_block())) {
     LOG_WARN("Fail to build current micro block", K(ret));
+  } else if (OB_FAIL(drain_compress_pipeline())) {
+    LOG_WARN("Fail to drain compress pipeline", K(ret));
   }
 
   if (OB_FAIL(ret)) {
@@ -657,7 +1010,10 @@ int ObMacroBlockWriter::append_micro_block(const ObMicroBlock &micro_block, cons
         STORAGE_LOG(WARN, "build_micro_block failed", K(ret));
       }
     }
-    if (OB_SUCC(ret)) {
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(drain_compress_pipeline())) {
+      STORAGE_LOG(WARN, "Fail to drain compress pipeline", K(ret));
+    } else {
       ObMicroBlockDesc micro_block_desc;
       ObMicroBlockHeader header_for_rewrite;
       if (OB_FAIL(build_micro_block_desc(micro_block, micro_block_desc, header_for_rewrite))) {
@@ -705,6 +1061,8 @@ int ObMacroBlockWriter::close()
     STORAGE_LOG(WARN, "exceptional situation", K(ret), K_(data_store_desc), K_(micro_writer));
   } else if (micro_writer_->get_row_count() > 0 && OB_FAIL(build_micro_block())) {
     STORAGE_LOG(WARN, "macro block writer fail to build current micro block.", K(ret));
+  } else if (OB_FAIL(drain_compress_pipeline())) {
+    STORAGE_LOG(WARN, "macro block writer fail to drain compress pipeline.", K(ret));
   } else {
     ObMacroBlock &current_block = macro_blocks_[current_index_];
     ObMacroBloomFilterCacheWriter &current_bf_writer = bf_cache_writer_[current_index_];
@@ -920,6 +1278,14 @@ int ObMacroBlockWriter::build_micro_block()
     STORAGE_LOG(WARN, "failed to build micro block desc", K(ret));
   } else if (OB_FAIL(build_hash_index_block(micro_block_desc))) {
     STORAGE_LOG(WARN, "Failed to build hash index block", K(ret));
+  } else if (compress_pipeline_.is_inited()) {
+    // compressed and written later in write_compressed_micro_block
+    micro_block_desc.last_rowkey_ = last_key_;
+    if (compress_pipeline_.is_full() && OB_FAIL(write_compressed_micro_block())) {
+      STORAGE_LOG(WARN, "Fail to write compressed micro block", K(ret));
+    } else if (OB_FAIL(compress_pipeline_.submit(micro_block_desc, micro_writer_->get_encoder_select_time()))) {
+      STORAGE_LOG(WARN, "Fail to submit micro block to compress pipeline", K(ret), K(micro_block_desc));
+    }
   } else {
     micro_block_desc.last_rowkey_ = last_key_;
     block_size = micro_block_desc.buf_size_;
@@ -955,6 +1321,12 @@ int ObMacroBlockWriter::build_micro_block()
 #endif
 
   if (OB_SUCC(ret)) {
+    if (OB_NOT_NULL(data_store_desc_->merge_info_) && !compress_pipeline_.is_inited()) {
+      data_store_desc_->merge_info_->original_size_ += block_size;
+      data_store_desc_->merge_info_->compressed_size_ += micro_block_desc.buf_size_;
+      data_store_desc_->merge_info_->new_micro_count_in_new_macro_++;
+      data_store_desc_->merge_info_->encoder_select_time_ += micro_writer_->get_encoder_select_time();
+    }
     micro_writer_->reuse();
     if (data_store_desc_->need_build_hash_index_for_micro_block_) {
       hash_index_builder_.reuse();
@@ -962,14 +1334,62 @@ int ObMacroBlockWriter::build_micro_block()
     if (data_store_desc_->need_prebuild_bloomfilter_ && micro_rowkey_hashs_.count() > 0) {
       micro_rowkey_hashs_.reuse();
     }
-    if (OB_NOT_NULL(data_store_desc_->merge_info_)) {
+  }
+  STORAGE_LOG(DEBUG, "build micro block desc", K(data_store_desc_->tablet_id_), K(micro_block_desc), "lbt", lbt(),
+                                               K(ret), K(tmp_ret));
+  return ret;
+}
+
+int ObMacroBlockWriter::write_compressed_micro_block()
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  ObMicroBlockCompressPipeline::Task *task = nullptr;
+  if (OB_FAIL(compress_pipeline_.wait_head(task))) {
+    STORAGE_LOG(WARN, "failed to compress and encrypt micro block", K(ret), KPC(task));
+  } else {
+    ObMicroBlockDesc &micro_block_desc = task->micro_block_desc_;
+    const int64_t block_size = task->raw_desc_.buf_size_;
+    if (data_block_pre_warmer_.is_valid()
+        && OB_TMP_FAIL(data_block_pre_warmer_.reserve_kvpair(task->raw_desc_))) {
+      if (OB_BUF_NOT_ENOUGH != tmp_ret) {
+        STORAGE_LOG(WARN, "Fail to reserve data block cache value", K(tmp_ret));
+      }
+    }
+
+    if (OB_FAIL(write_micro_block(micro_block_desc))) {
+      STORAGE_LOG(WARN, "fail to write micro block ", K(ret), K(micro_block_desc));
+    } else if (OB_FAIL(micro_block_adaptive_splitter_.update_compression_info(micro_block_desc.row_count_,
+        block_size, micro_block_desc.buf_size_))) {
+      STORAGE_LOG(WARN, "Fail to update_compression_info", K(ret), K(micro_block_desc));
+    }
+    if (OB_FAIL(ret) || !data_block_pre_warmer_.is_valid() || OB_TMP_FAIL(tmp_ret)) {
+    } else if (OB_TMP_FAIL(data_block_pre_warmer_.update_and_put_kvpair(micro_block_desc))) {
+      STORAGE_LOG(WARN, "Fail to build data cache key and put into cache", K(tmp_ret));
+    }
+    data_block_pre_warmer_.reuse();
+
+    if (OB_SUCC(ret) && OB_NOT_NULL(data_store_desc_->merge_info_)) {
       data_store_desc_->merge_info_->original_size_ += block_size;
       data_store_desc_->merge_info_->compressed_size_ += micro_block_desc.buf_size_;
       data_store_desc_->merge_info_->new_micro_count_in_new_macro_++;
+      data_store_desc_->merge_info_->encoder_select_time_ += task->encoder_select_time_;
+    }
+  }
+  if (OB_NOT_NULL(task)) {
+    compress_pipeline_.pop_head();
+  }
+  return ret;
+}
+
+int ObMacroBlockWriter::drain_compress_pipeline()
+{
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(ret) && !compress_pipeline_.is_empty()) {
+    if (OB_FAIL(write_compressed_micro_block())) {
+      STORAGE_LOG(WARN, "Fail to write compressed micro block", K(ret));
     }
   }
-  STORAGE_LOG(DEBUG, "build micro block desc", K(data_store_desc_->tablet_id_), K(micro_block_desc), "lbt", lbt(),
-                                               K(ret), K(tmp_ret));
   return ret;
 }
 
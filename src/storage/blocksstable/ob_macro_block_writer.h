@@ -30,6 +30,9 @@
 #include "ob_bloom_filter_cache.h"
 #include "ob_micro_block_reader_helper.h"
 #include "share/cache/ob_kvcache_pre_warmer.h"
+#include "lib/thread/ob_simple_thread_pool.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "lib/lock/ob_mutex.h"
 
 namespace oceanbase
 {
@@ -124,6 +127,97 @@ private:
   ObMicroCompressionInfo compression_infos_[DEFAULT_MICRO_ROW_COUNT + 1]; //compression_infos_[0] for total compression info
 };
 
+class ObMicroBlockCompressService;
+
+// Compress, encrypt and verify encoded micro blocks on a few worker threads, so the writer
+// thread keeps fusing and encoding rows while the previous micro blocks are compressed.
+// Tasks are submitted and popped in row order by the writer thread only, the workers of
+// the tenant level ObMicroBlockCompressService compress them and mark them done.
+class ObMicroBlockCompressPipeline
+{
+public:
+  struct Task
+  {
+  public:
+    Task();
+    ~Task() = default;
+    void reuse();
+    TO_STRING_KV(KP_(pipeline), K_(raw_desc), K_(micro_block_desc), K_(encoder_select_time),
+                 K_(ret), K_(is_done));
+  public:
+    ObMicroBlockCompressPipeline *pipeline_;
+    ObMicroBlockDesc raw_desc_;          // encoded micro block, used to pre-warm block cache
+    ObMicroBlockDesc micro_block_desc_;  // compressed micro block
+    ObMicroBlockHeader header_;          // header of the compressed micro block
+    ObMicroBlockBufferHelper micro_helper_;
+    common::ObArenaAllocator allocator_;       // for micro helper
+    common::ObArenaAllocator block_allocator_; // for block buffer and last rowkey, reused by task
+    int64_t encoder_select_time_;
+    int ret_;
+    bool is_done_;
+  };
+public:
+  ObMicroBlockCompressPipeline();
+  virtual ~ObMicroBlockCompressPipeline();
+  int init(const int64_t thread_cnt, ObDataStoreDesc &data_store_desc, ObTableReadInfo &read_info);
+  void destroy();
+  // called by the workers of the compress service
+  void process(Task &task);
+  // following interfaces are only called by the writer thread
+  int submit(const ObMicroBlockDesc &micro_block_desc, const int64_t encoder_select_time);
+  int wait_head(Task *&task);
+  void pop_head();
+  OB_INLINE bool is_inited() const { return is_inited_; }
+  OB_INLINE bool is_empty() const { return head_ == tail_; }
+  OB_INLINE bool is_full() const { return tail_ - head_ >= task_cnt_; }
+  TO_STRING_KV(K_(is_inited), K_(task_cnt), K_(head), K_(tail), KP_(service));
+private:
+  static const int64_t TASK_CNT_PER_THREAD = 2;
+  static const int64_t WAIT_INTERVAL_MS = 10;
+  bool is_inited_;
+  int64_t task_cnt_;
+  Task *tasks_;
+  int64_t head_; // oldest task not popped
+  int64_t tail_; // next task to submit
+  common::ObThreadCond cond_;
+  common::ObArenaAllocator allocator_;
+  ObMicroBlockCompressService *service_;
+};
+
+// Tenant level worker threads shared by the compress pipelines of all the macro block writers
+// of the tenant. The workers are started on the first use, and follow the changes of
+// _compaction_compress_thread_count after that.
+class ObMicroBlockCompressService
+{
+public:
+  static const int64_t MAX_THREAD_CNT = 8;
+  ObMicroBlockCompressService();
+  ~ObMicroBlockCompressService();
+  static int mtl_init(ObMicroBlockCompressService *&service);
+  int init();
+  int start();
+  void stop();
+  void wait();
+  void destroy();
+  int prepare(const int64_t thread_cnt);
+  // the task is compressed by the caller if the workers are not available
+  void push(ObMicroBlockCompressPipeline::Task &task);
+  OB_INLINE int64_t get_thread_cnt() const { return thread_cnt_; }
+  TO_STRING_KV(K_(is_inited), K_(is_stopped), K_(thread_cnt));
+private:
+  class WorkerPool : public common::ObSimpleThreadPool
+  {
+  public:
+    virtual void handle(void *task) override;
+  };
+  static const int64_t MAX_TASK_CNT = 1024;
+  bool is_inited_;
+  bool is_stopped_;
+  int64_t thread_cnt_;
+  lib::ObMutex lock_;
+  WorkerPool pool_;
+};
+
 class ObMacroBlockWriter
 {
 public:
@@ -153,7 +247,11 @@ protected:
   virtual int build_micro_block();
   virtual int try_switch_macro_block();
   virtual bool is_keep_freespace() const {return false; }
-  inline bool is_dirty() const { return macro_blocks_[current_index_].is_dirty() || 0 != micro_writer_->get_row_count(); }
+  inline bool is_dirty() const
+  {
+    return macro_blocks_[current_index_].is_dirty() || 0 != micro_writer_->get_row_count()
+        || !compress_pipeline_.is_empty();
+  }
   inline int64_t get_curr_micro_writer_row_count() const { return micro_writer_->get_row_count(); }
   inline int64_t get_macro_data_size() const { return macro_blocks_[current_index_].get_data_size() + micro_writer_->get_block_size(); }
 
@@ -173,6 +271,8 @@ private:
       ObMicroBlockHeader &header);
   int build_micro_block_desc_with_reuse(const ObMicroBlock &micro_block, ObMicroBlockDesc &micro_block_desc);
   int write_micro_block(ObMicroBlockDesc &micro_block_desc);
+  int write_compressed_micro_block();
+  int drain_compress_pipeline();
   int check_micro_block_need_merge(const ObMicroBlock &micro_block, bool &need_merge);
   int merge_micro_block(const ObMicroBlock &micro_block);
   int flush_macro_block(ObMacroBlock &macro_block);
@@ -228,6 +328,7 @@ private:
   ObDataIndexBlockBuilder *builder_;
   ObMicroBlockAdaptiveSplitter micro_block_adaptive_splitter_;
   ObDataBlockCachePreWarmer data_block_pre_warmer_;
+  ObMicroBlockCompressPipeline compress_pipeline_;
 };
 
 }//end namespace blocksstable
@@ -24,7 +24,8 @@ namespace blocksstable
 {
 
 ObTmpFileIOInfo::ObTmpFileIOInfo()
-  : fd_(0), dir_id_(0), size_(0), tenant_id_(OB_INVALID_TENANT_ID), buf_(NULL), io_desc_()
+  : fd_(0), dir_id_(0), size_(0), tenant_id_(OB_INVALID_TENANT_ID), buf_(NULL), io_desc_(),
+    disable_page_cache_(false)
 {
 }
 
@@ -39,6 +40,7 @@ void ObTmpFileIOInfo::reset()
   size_ = 0;
   tenant_id_ = OB_INVALID_TENANT_ID;
   buf_ = NULL;
+  disable_page_cache_ = false;
 }
 
 bool ObTmpFileIOInfo::is_valid() const
@@ -51,6 +53,7 @@ ObTmpFileIOHandle::ObTmpFileIOHandle()
   : is_read_(false),
     has_wait_(false),
     update_offset_in_file_(false),
+    disable_page_cache_(false),
     fd_(OB_INVALID_FD),
     dir_id_(OB_INVALID_ID),
     size_(0),
@@ -74,6 +77,7 @@ int ObTmpFileIOHandle::prepare_read(
     const int64_t read_size,
     const int64_t read_offset,
     const common::ObIOFlag io_flag,
+    const bool disable_page_cache,
     char *read_buf,
     ObTmpFile *file)
 {
@@ -92,6 +96,7 @@ int ObTmpFileIOHandle::prepare_read(
     expect_read_size_ = read_size;
     last_read_offset_ = read_offset;
     io_flag_ = io_flag;
+    disable_page_cache_ = disable_page_cache;
   }
   return ret;
 }
@@ -142,6 +147,7 @@ int ObTmpFileIOHandle::wait(const int64_t timeout_ms)
       io_info.size_ = expect_read_size_;
       io_info.buf_ = buf_;
       io_info.io_desc_ = io_flag_;
+      io_info.disable_page_cache_ = disable_page_cache_;
       while (OB_SUCC(ret) && size_ < expect_read_size_) {
         if (OB_FAIL(file_handle.get_resource_ptr()->once_aio_read_batch(io_info,
                                                     update_offset_in_file_,
@@ -161,6 +167,7 @@ int ObTmpFileIOHandle::wait(const int64_t timeout_ms)
     last_read_offset_ = -1;
     io_flag_.reset();
     update_offset_in_file_ = false;
+    disable_page_cache_ = false;
   }
   return ret;
 }
@@ -232,6 +239,7 @@ void ObTmpFileIOHandle::reset()
   last_read_offset_ = -1;
   io_flag_.reset();
   update_offset_in_file_ = false;
+  disable_page_cache_ = false;
 }
 
 bool ObTmpFileIOHandle::is_valid()
@@ -390,6 +398,7 @@ int ObTmpFileExtent::read(const ObTmpFileIOInfo &io_info, const int64_t offset,
     info.offset_ = start_page_id_ * ObTmpMacroBlock::get_default_page_size() + offset;
     info.size_ = size;
     info.tenant_id_ = io_info.tenant_id_;
+    info.disable_page_cache_ = io_info.disable_page_cache_;
     if (OB_FAIL(OB_TMP_FILE_STORE.read(owner_->get_tenant_id(), info, handle))) {
       STORAGE_LOG(WARN, "fail to read the extent", K(ret), K(info), K(*this));
     } else {
@@ -706,6 +715,7 @@ int ObTmpFile::aio_read_without_lock(const ObTmpFileIOInfo &io_info,
   } else if (OB_FAIL(handle.prepare_read(io_info.size_,
                                          offset,
                                          io_info.io_desc_,
+                                         io_info.disable_page_cache_,
                                          io_info.buf_,
                                          this))){
     STORAGE_LOG(WARN, "fail to prepare read io handle", K(ret), K(io_info), K(offset));
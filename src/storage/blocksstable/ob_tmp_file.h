@@ -34,13 +34,16 @@ public:
   ~ObTmpFileIOInfo();
   void reset();
   bool is_valid() const;
-  TO_STRING_KV(K_(fd), K_(dir_id), K_(size), K_(tenant_id), KP_(buf), K_(io_desc));
+  TO_STRING_KV(K_(fd), K_(dir_id), K_(size), K_(tenant_id), KP_(buf), K_(io_desc),
+      K_(disable_page_cache));
   int64_t fd_;
   int64_t dir_id_;
   int64_t size_;
   uint64_t tenant_id_;
   char *buf_;
   common::ObIOFlag io_desc_;
+  // read from disk directly without filling page cache, for data read sequentially only once.
+  bool disable_page_cache_;
 };
 
 class ObTmpFileIOHandle final
@@ -96,6 +99,7 @@ public:
       const int64_t read_size,
       const int64_t read_offset,
       const common::ObIOFlag io_flag,
+      const bool disable_page_cache,
       char *read_buf,
       ObTmpFile *file);
   int prepare_write(char *write_buf, const int64_t write_size, ObTmpFile *file);
@@ -124,7 +128,7 @@ public:
   OB_INLINE int64_t get_last_read_offset() const { return last_read_offset_; }
 
   TO_STRING_KV(KP_(buf), K_(size), K_(is_read), K_(has_wait), K_(expect_read_size),
-      K_(last_read_offset), K_(io_flag), K_(update_offset_in_file));
+      K_(last_read_offset), K_(io_flag), K_(update_offset_in_file), K_(disable_page_cache));
 
 private:
   int do_wait(const int64_t timeout_ms);
@@ -133,6 +137,7 @@ private:
   bool is_read_;
   bool has_wait_;
   bool update_offset_in_file_;
+  bool disable_page_cache_;
   int64_t fd_;
   int64_t dir_id_;
   int64_t size_;  //has read or to write size.
@@ -189,6 +189,31 @@ int ObTmpPageCache::prefetch(
   return ret;
 }
 
+int ObTmpPageCache::direct_read(
+    const ObTmpBlockIOInfo &info,
+    ObMacroBlockHandle &mb_handle,
+    common::ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  ObTmpDirectReadIOCallback callback;
+  callback.cache_ = this;
+  callback.offset_ = info.offset_;
+  callback.buf_size_ = info.size_;
+  callback.allocator_ = &allocator;
+  if (OB_FAIL(read_io(info, callback, mb_handle))) {
+    if (mb_handle.get_io_handle().is_empty()) {
+      if (OB_FAIL(mb_handle.wait(DEFAULT_IO_WAIT_TIME_MS))) {
+        STORAGE_LOG(WARN, "fail to wait tmp page io", K(ret));
+      } else if (OB_FAIL(read_io(info, callback, mb_handle))) {
+        STORAGE_LOG(WARN, "fail to read tmp page from io", K(ret));
+      }
+    } else {
+      STORAGE_LOG(WARN, "fail to read tmp page from io", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObTmpPageCache::get_cache_page(const ObTmpPageCacheKey &key, ObTmpPageValueHandle &handle)
 {
   int ret = OB_SUCCESS;
@@ -396,6 +421,50 @@ const char *ObTmpPageCache::ObTmpMultiPageIOCallback::get_data()
   return data_buf_;
 }
 
+ObTmpPageCache::ObTmpDirectReadIOCallback::ObTmpDirectReadIOCallback()
+{
+  static_assert(sizeof(*this) <= CALLBACK_BUF_SIZE, "IOCallback buf size not enough");
+}
+
+ObTmpPageCache::ObTmpDirectReadIOCallback::~ObTmpDirectReadIOCallback()
+{
+}
+
+int ObTmpPageCache::ObTmpDirectReadIOCallback::inner_process(const bool is_success)
+{
+  UNUSED(is_success);
+  // data is copied out of io buffer when waiting the handle, io buffer is freed with callback.
+  return OB_SUCCESS;
+}
+
+int64_t ObTmpPageCache::ObTmpDirectReadIOCallback::size() const
+{
+  return sizeof(*this);
+}
+
+int ObTmpPageCache::ObTmpDirectReadIOCallback::inner_deep_copy(char *buf,
+    const int64_t buf_len, ObIOCallback *&callback) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "Invalid argument, ", KP(buf), K(buf_len), K(ret));
+  } else if (OB_ISNULL(allocator_)) {
+    ret = OB_INVALID_DATA;
+    STORAGE_LOG(WARN, "The tmp page io callback is not valid, ", KP_(allocator), K(ret));
+  } else {
+    ObTmpDirectReadIOCallback *pcallback = new (buf) ObTmpDirectReadIOCallback();
+    *pcallback = *this;
+    callback = pcallback;
+  }
+  return ret;
+}
+
+const char *ObTmpPageCache::ObTmpDirectReadIOCallback::get_data()
+{
+  return data_buf_;
+}
+
 int ObTmpPageCache::read_io(const ObTmpBlockIOInfo &io_info, ObITmpPageIOCallback &callback,
     ObMacroBlockHandle &handle)
 {
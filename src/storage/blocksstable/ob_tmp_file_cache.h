@@ -114,6 +114,11 @@ public:
       const common::ObIArray<ObTmpPageIOInfo> &page_io_infos,
       ObMacroBlockHandle &mb_handle,
       common::ObIAllocator &allocator);
+  // read without putting pages into cache
+  int direct_read(
+      const ObTmpBlockIOInfo &info,
+      ObMacroBlockHandle &mb_handle,
+      common::ObIAllocator &allocator);
   int get_cache_page(const ObTmpPageCacheKey &key, ObTmpPageValueHandle &handle);
   int get_page(const ObTmpPageCacheKey &key, ObTmpPageValueHandle &handle);
   int put_page(const ObTmpPageCacheKey &key, const ObTmpPageCacheValue &value);
@@ -167,6 +172,19 @@ public:
     friend class ObTmpPageCache;
     common::ObArray<ObTmpPageIOInfo> page_io_infos_;
   };
+  class ObTmpDirectReadIOCallback final : public ObITmpPageIOCallback
+  {
+  public:
+    ObTmpDirectReadIOCallback();
+    ~ObTmpDirectReadIOCallback();
+    int64_t size() const override;
+    int inner_process(const bool is_success) override;
+    int inner_deep_copy(char *buf, const int64_t buf_len, ObIOCallback *&callback) const override;
+    const char *get_data() override;
+    TO_STRING_KV(KP_(data_buf));
+  private:
+    friend class ObTmpPageCache;
+  };
 private:
   ObTmpPageCache();
   ~ObTmpPageCache();
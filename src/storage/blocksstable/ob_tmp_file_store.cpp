@@ -1132,6 +1132,10 @@ int ObTmpTenantFileStore::read(ObTmpBlockIOInfo &io_info, ObTmpFileIOHandle &han
       if (OB_FAIL(handle.get_block_cache_handles().push_back(block_handle))) {
         STORAGE_LOG(WARN, "Fail to push back into block_handles", K(ret), K(block_handle));
       }
+    } else if (io_info.disable_page_cache_) {
+      if (OB_FAIL(direct_read(block, io_info, handle))) {
+        STORAGE_LOG(WARN, "fail to direct read", K(ret), K(io_info));
+      }
     } else if (OB_SUCC(read_page(block, io_info, handle))) {
       //nothing to do.
     } else {
@@ -1251,6 +1255,35 @@ int ObTmpTenantFileStore::read_page(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io
   return ret;
 }
 
+// Read the pages covering the range in one aligned io, pages are not put into page cache.
+int ObTmpTenantFileStore::direct_read(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io_info,
+    ObTmpFileIOHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  const int64_t page_size = ObTmpMacroBlock::get_default_page_size();
+  const int64_t p_offset = common::lower_align(io_info.offset_, page_size);
+  const int64_t p_end = common::upper_align(io_info.offset_ + io_info.size_, page_size);
+  ObMacroBlockHandle mb_handle;
+  ObTmpBlockIOInfo info(io_info);
+  // just skip header and padding.
+  info.offset_ = p_offset + ObTmpMacroBlock::get_header_padding();
+  info.size_ = p_end - p_offset;
+  info.macro_block_id_ = block->get_macro_block_id();
+  // guarantee read io after the finished write.
+  if (OB_FAIL(wait_write_io_finish_if_need())) {
+    STORAGE_LOG(WARN, "fail to wait previous write io", K(ret));
+  } else if (OB_FAIL(page_cache_->direct_read(info, mb_handle, io_allocator_))) {
+    STORAGE_LOG(WARN, "fail to direct read tmp pages", K(ret), K(info));
+  } else {
+    ObTmpFileIOHandle::ObIOReadHandle read_handle(mb_handle, io_info.buf_,
+        io_info.offset_ - p_offset, io_info.size_);
+    if (OB_FAIL(handle.get_io_handles().push_back(read_handle))) {
+      STORAGE_LOG(WARN, "Fail to push back into read_handles", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObTmpTenantFileStore::wait_write_io_finish_if_need()
 {
   // guarantee read io after the finished write.
@@ -87,14 +87,14 @@ struct ObTmpBlockIOInfo final
 public:
   ObTmpBlockIOInfo()
     : block_id_(0), offset_(0), size_(0), tenant_id_(0),
-      buf_(NULL), io_desc_(), macro_block_id_()  {}
+      buf_(NULL), io_desc_(), macro_block_id_(), disable_page_cache_(false)  {}
   ObTmpBlockIOInfo(const int64_t block_id, const int64_t offset, const int64_t size,
       const uint64_t tenant_id, const MacroBlockId macro_block_id, char *buf,
       const common::ObIOFlag io_desc)
     : block_id_(block_id), offset_(offset), size_(size), tenant_id_(tenant_id),
-      buf_(buf), io_desc_(io_desc), macro_block_id_(macro_block_id) {}
+      buf_(buf), io_desc_(io_desc), macro_block_id_(macro_block_id), disable_page_cache_(false) {}
   TO_STRING_KV(K_(block_id), K_(offset), K_(size), K_(tenant_id), K_(macro_block_id), KP_(buf),
-      K_(io_desc));
+      K_(io_desc), K_(disable_page_cache));
   int64_t block_id_;
   int64_t offset_;
   int64_t size_;
@@ -102,6 +102,7 @@ public:
   char *buf_;
   common::ObIOFlag io_desc_;
   MacroBlockId macro_block_id_;
+  bool disable_page_cache_;
 };
 
 class ObTmpMacroBlock final
@@ -254,6 +255,7 @@ public:
 
 private:
   int read_page(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io_info, ObTmpFileIOHandle &handle);
+  int direct_read(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io_info, ObTmpFileIOHandle &handle);
   int free_extent(ObTmpFileExtent *extent);
   int free_extent(const int64_t block_id, const int32_t start_page_id, const int32_t page_nums);
   int free_macro_block(ObTmpMacroBlock *&t_mblk);
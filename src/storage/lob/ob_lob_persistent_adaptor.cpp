@@ -22,41 +22,72 @@
 #include "share/schema/ob_tenant_schema_service.h"
 #include "storage/tx_storage/ob_access_service.h"
 #include "share/ob_tablet_autoincrement_service.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
 namespace storage
 {
 
-int ObPersistentLobApator::prepare_table_param(
-  const ObLobAccessParam &param,
-  ObTableScanParam &scan_param,
-  bool is_meta)
+ObPersistentLobApator::~ObPersistentLobApator()
+{
+  for (int64_t i = 0; i < TABLE_PARAM_CNT; ++i) {
+    OB_DELETE(ObLobTableParam, "LobTableParam", table_params_[i]);
+  }
+}
+
+int ObPersistentLobApator::build_table_param(
+  const ObIArray<uint64_t> &column_ids,
+  const bool is_meta,
+  ObLobTableParam *&table_param)
 {
   int ret = OB_SUCCESS;
-  void *buf = NULL;
-  ObTableParam *table_param = NULL;
-  HEAP_VAR(ObTableSchema, table_schema, param.allocator_) {
+  // the schema is only needed by convert, its memory is released on return
+  ObArenaAllocator tmp_allocator(ObMemAttr(MTL_ID(), "LobTableSchema"));
+  table_param = NULL;
+  HEAP_VAR(ObTableSchema, table_schema, &tmp_allocator) {
     // FIXME: use convert with ObStorageSchema intead of hard-code schema
-    if (OB_UNLIKELY(scan_param.table_param_ != NULL)) {
-      //do nothing
-    } else if (is_meta && OB_FAIL(share::ObInnerTableSchema::all_column_aux_lob_meta_schema(table_schema))) {
+    if (is_meta && OB_FAIL(share::ObInnerTableSchema::all_column_aux_lob_meta_schema(table_schema))) {
       LOG_WARN("get lob meta schema failed", K(ret));
     } else if (!is_meta && OB_FAIL(share::ObInnerTableSchema::all_column_aux_lob_piece_schema(table_schema))) {
       LOG_WARN("get lob piece schema failed", K(ret));
+    } else if (OB_ISNULL(table_param = OB_NEW(ObLobTableParam, ObMemAttr(MTL_ID(), "LobTableParam")))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Fail to allocate memory", K(ret));
+    } else if (OB_FAIL(table_param->table_param_.convert(table_schema, column_ids))) {
+      LOG_WARN("Fail to convert table param", K(ret));
+      OB_DELETE(ObLobTableParam, "LobTableParam", table_param);
+    }
+  }
+  return ret;
+}
+
+int ObPersistentLobApator::prepare_table_param(
+  const ObLobAccessParam &param,
+  ObTableScanParam &scan_param,
+  bool is_meta)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(param);
+  // column ids of lob meta (piece) scan are always the same, see build_common_scan_param
+  const int64_t idx = (is_meta ? 0 : 2) + (lib::is_oracle_mode() ? 1 : 0);
+  ObLobTableParam *table_param = ATOMIC_LOAD(&table_params_[idx]);
+  if (OB_UNLIKELY(scan_param.table_param_ != NULL)) {
+    //do nothing
+  } else if (OB_NOT_NULL(table_param)) {
+    scan_param.table_param_ = &table_param->table_param_;
+  } else {
+    // build without lock, the first one published wins and the others are dropped
+    ObLobTableParam *new_param = NULL;
+    if (OB_FAIL(build_table_param(scan_param.column_ids_, is_meta, new_param))) {
+      LOG_WARN("build table param failed", K(ret), K(is_meta));
+    } else if (NULL == (table_param = ATOMIC_VCAS(&table_params_[idx], NULL, new_param))) {
+      table_param = new_param;
     } else {
-      // table_schema.set_tablet_id();
-      if (NULL == (buf = param.allocator_->alloc(sizeof(ObTableParam)))) {
-        ret = OB_ALLOCATE_MEMORY_FAILED;
-        LOG_WARN("Fail to allocate memory", K(ret));
-      } else {
-        table_param = new (buf) ObTableParam(*param.allocator_);
-        if (OB_FAIL(table_param->convert(table_schema, scan_param.column_ids_))) {
-          LOG_WARN("Fail to convert table param", K(ret));
-        } else {
-          scan_param.table_param_ = table_param;
-        }
-      }
+      OB_DELETE(ObLobTableParam, "LobTableParam", new_param);
+    }
+    if (OB_SUCC(ret)) {
+      scan_param.table_param_ = &table_param->table_param_;
     }
   }
   return ret;
@@ -829,6 +860,13 @@ int ObPersistentLobApator::build_common_scan_param(
                           false // read_latest
                         );
   query_flag.disable_cache();
+  // lob data is read piece by piece from the micro blocks of lob meta tablet, recently read
+  // blocks may be kept in block cache so that reading the same or adjacent lobs does not go
+  // to disk. It is off by default, large lob scans would wash out the blocks of other data.
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id));
+  if (tenant_config.is_valid() && tenant_config->_enable_lob_meta_block_cache) {
+    query_flag.set_use_block_cache();
+  }
   query_flag.scan_order_ = param.scan_backward_ ? ObQueryFlag::Reverse : ObQueryFlag::Forward;
   scan_param.scan_flag_.flag_ = query_flag.flag_;
   // set column ids
@@ -13,7 +13,10 @@
 #ifndef OCEABASE_STORAGE_OB_LOB_PERSISTENT_ADAPTOR_
 #define OCEABASE_STORAGE_OB_LOB_PERSISTENT_ADAPTOR_
 #include "lib/lock/ob_spin_lock.h"
+#include "lib/allocator/page_arena.h"
 #include "lib/task/ob_timer.h"
+#include "share/rc/ob_tenant_base.h"
+#include "share/schema/ob_table_param.h"
 #include "storage/blocksstable/ob_macro_block_id.h"
 #include "ob_i_lob_adaptor.h"
 #include "common/row/ob_row_iterator.h"
@@ -45,8 +48,22 @@ private:
 
 class ObPersistentLobApator : public ObILobApator
 {
+private:
+  // table param with the allocator owning its memory
+  struct ObLobTableParam
+  {
+    ObLobTableParam()
+      : allocator_(lib::ObMemAttr(MTL_ID(), "LobTableParam")),
+        table_param_(allocator_)
+    {}
+    common::ObArenaAllocator allocator_;
+    share::schema::ObTableParam table_param_;
+  };
 public:
-  ObPersistentLobApator() {}
+  ObPersistentLobApator()
+    : table_params_()
+  {}
+  virtual ~ObPersistentLobApator();
   virtual int scan_lob_meta(const ObLobAccessParam &param,
     ObTableScanParam &scan_param,
     common::ObNewRowIterator *&meta_iter) override;
@@ -91,6 +108,10 @@ private:
       const ObLobAccessParam &param,
       ObTableScanParam &scan_param,
       bool is_meta);
+  int build_table_param(
+      const common::ObIArray<uint64_t> &column_ids,
+      const bool is_meta,
+      ObLobTableParam *&table_param);
   int build_common_scan_param(
       const ObLobAccessParam &param,
       const uint64_t table_id,
@@ -143,6 +164,10 @@ private:
       ObLobPieceInfo& in_row);
 private:
   static const uint64_t LOB_EXPIRE_TIME_US = 3 * 1000 * 1000; // 3s
+  // lob meta and piece tables have hard-coded schema, their table params are built once
+  // for each compat mode and shared by all scans.
+  static const int64_t TABLE_PARAM_CNT = 4; // (meta, piece) * (mysql, oracle)
+  ObLobTableParam *table_params_[TABLE_PARAM_CNT];
 };
 
 
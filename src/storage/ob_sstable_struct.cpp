@@ -129,6 +129,7 @@ ObSSTableMergeInfo::ObSSTableMergeInfo()
       total_row_count_(0),
       incremental_row_count_(0),
       new_flush_data_rate_(0),
+      encoder_select_time_(0),
       is_full_merge_(false),
       progressive_merge_round_(0),
       progressive_merge_num_(0),
@@ -167,6 +168,7 @@ int ObSSTableMergeInfo::add(const ObSSTableMergeInfo &other)
   incremental_row_count_ += other.incremental_row_count_;
   multiplexed_micro_count_in_new_macro_ += other.multiplexed_micro_count_in_new_macro_;
   new_micro_count_in_new_macro_ += other.new_micro_count_in_new_macro_;
+  encoder_select_time_ += other.encoder_select_time_;
 
   if (1 == concurrent_cnt_) {
     // do nothing
@@ -200,6 +202,7 @@ void ObSSTableMergeInfo::reset()
   total_row_count_ = 0;
   incremental_row_count_ = 0;
   new_flush_data_rate_ = 0;
+  encoder_select_time_ = 0;
   is_full_merge_ = false;
   progressive_merge_round_ = 0;
   progressive_merge_num_ = 0;
@@ -122,7 +122,7 @@ public:
                K_(merge_start_time), K_(merge_finish_time), K_(dag_id), K_(occupy_size), K_(new_flush_occupy_size), K_(original_size),
                K_(compressed_size), K_(macro_block_count), K_(multiplexed_macro_block_count),
                K_(new_micro_count_in_new_macro), K_(multiplexed_micro_count_in_new_macro),
-               K_(total_row_count), K_(incremental_row_count), K_(new_flush_data_rate),
+               K_(total_row_count), K_(incremental_row_count), K_(new_flush_data_rate), K_(encoder_select_time),
                K_(is_full_merge), K_(progressive_merge_round), K_(progressive_merge_num),
                K_(concurrent_cnt), K_(parallel_merge_info), K_(filter_statistics), K_(participant_table_str),
                K_(macro_id_list), K_(comment));
@@ -146,6 +146,7 @@ public:
   int64_t total_row_count_;
   int64_t incremental_row_count_;
   int64_t new_flush_data_rate_;
+  int64_t encoder_select_time_; // time used to choose column encoders of encoded micro blocks
   bool is_full_merge_;
   int64_t progressive_merge_round_;
   int64_t progressive_merge_num_;
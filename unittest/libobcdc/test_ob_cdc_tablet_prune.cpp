@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "gtest/gtest.h"
+#include "lib/container/ob_se_array.h"
+#include "logservice/libobcdc/src/ob_cdc_tablet_to_table_info.h"
+
+#define USING_LOG_PREFIX OBLOG
+
+using namespace oceanbase;
+using namespace common;
+using namespace libobcdc;
+using namespace share::schema;
+
+namespace oceanbase
+{
+namespace unittest
+{
+
+static const uint64_t TENANT_ID = 1001;
+
+// The tablets pruned by the server are the index tablets known by the client.
+class TestCDCTabletPrune : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    ASSERT_EQ(OB_SUCCESS, tablet_info_.init(TENANT_ID));
+    add_tablet(200001, 500001, USER_TABLE);
+    add_tablet(200002, 500002, USER_INDEX);
+    add_tablet(200003, 500003, USER_INDEX);
+    add_tablet(200004, 500004, AUX_LOB_META);
+  }
+  virtual void TearDown() { tablet_info_.destroy(); }
+
+  void add_tablet(const int64_t tablet_id, const uint64_t table_id, const ObTableType table_type)
+  {
+    ObCDCTableInfo table_info;
+    table_info.reset(table_id, table_type);
+    ASSERT_EQ(OB_SUCCESS, tablet_info_.insert_tablet_table_info(ObTabletID(tablet_id), table_info));
+  }
+  bool is_pruned(const int64_t tablet_id, const int64_t max_count = 4096)
+  {
+    ObSEArray<ObTabletID, 16> tablets;
+    bool bret = false;
+    EXPECT_EQ(OB_SUCCESS, tablet_info_.get_index_tablets(tablets, max_count));
+    for (int64_t i = 0; ! bret && i < tablets.count(); i++) {
+      bret = (ObTabletID(tablet_id) == tablets.at(i));
+    }
+    return bret;
+  }
+
+protected:
+  TabletToTableInfo tablet_info_;
+};
+
+TEST_F(TestCDCTabletPrune, index_tablets)
+{
+  ObSEArray<ObTabletID, 16> tablets;
+  ASSERT_EQ(OB_SUCCESS, tablet_info_.get_index_tablets(tablets, 4096));
+  ASSERT_EQ(2, tablets.count());
+  // data of tables and lob tablets is output
+  ASSERT_FALSE(is_pruned(200001));
+  ASSERT_TRUE(is_pruned(200002));
+  ASSERT_TRUE(is_pruned(200003));
+  ASSERT_FALSE(is_pruned(200004));
+  // unknown tablets are never pruned
+  ASSERT_FALSE(is_pruned(200005));
+}
+
+TEST_F(TestCDCTabletPrune, tablet_changes)
+{
+  // tablet added: pruned by the next request
+  ASSERT_FALSE(is_pruned(200005));
+  add_tablet(200005, 500005, USER_INDEX);
+  ASSERT_TRUE(is_pruned(200005));
+
+  // tablet dropped: no more pruned, its redo is sent by the server as before
+  ASSERT_EQ(OB_SUCCESS, tablet_info_.remove_tablet_table_info(ObTabletID(200002)));
+  ASSERT_FALSE(is_pruned(200002));
+
+  // tablet moved to another LS: the list is per tenant, the tablet is dropped from the
+  // source LS and created in the dest LS with the same table
+  ASSERT_EQ(OB_SUCCESS, tablet_info_.remove_tablet_table_info(ObTabletID(200003)));
+  add_tablet(200003, 500003, USER_INDEX);
+  ASSERT_TRUE(is_pruned(200003));
+
+  // tablet id reused by a table after the index is dropped
+  ASSERT_EQ(OB_SUCCESS, tablet_info_.remove_tablet_table_info(ObTabletID(200005)));
+  add_tablet(200005, 500006, USER_TABLE);
+  ASSERT_FALSE(is_pruned(200005));
+}
+
+TEST_F(TestCDCTabletPrune, max_count)
+{
+  ObSEArray<ObTabletID, 16> tablets;
+  for (int64_t i = 0; i < 10; i++) {
+    add_tablet(300001 + i, 600001 + i, USER_INDEX);
+  }
+  ASSERT_EQ(OB_SUCCESS, tablet_info_.get_index_tablets(tablets, 5));
+  ASSERT_EQ(5, tablets.count());
+  tablets.reuse();
+  ASSERT_EQ(OB_SUCCESS, tablet_info_.get_index_tablets(tablets, 4096));
+  ASSERT_EQ(12, tablets.count());
+  tablets.reuse();
+  ASSERT_EQ(OB_SUCCESS, tablet_info_.get_index_tablets(tablets, 0));
+  ASSERT_EQ(0, tablets.count());
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  ObLogger &logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_cdc_tablet_prune.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "ob_log_columnar_batch.h"    // ObLogColumnarBatch
+#include "lib/allocator/page_arena.h" // ObArenaAllocator
+#include "lib/time/ob_time_utility.h" // ObTimeUtility
+
+using namespace oceanbase::common;
+namespace oceanbase
+{
+namespace libobcdc
+{
+
+static const int64_t COLUMN_CNT = 8;
+
+// int, int, bigint unsigned, double, double, datetime, date, varchar
+class TestLogColumnarBatch : public ::testing::Test
+{
+public:
+  TestLogColumnarBatch() : allocator_("TestColumnar") {}
+  ~TestLogColumnarBatch() {}
+
+  virtual void SetUp()
+  {
+    row_.table_id_ = 1001;
+    row_.record_type_ = EINSERT;
+    row_.column_cnt_ = COLUMN_CNT;
+    row_.column_types_ = types_;
+    row_.new_values_ = new_values_;
+    row_.old_values_ = old_values_;
+
+    for (int64_t idx = 0; idx < COLUMN_CNT; idx++) {
+      new_values_[idx].obj_ = &objs_[idx];
+      new_values_[idx].str_ = NULL;
+      old_values_[idx].obj_ = NULL;
+      old_values_[idx].str_ = NULL;
+    }
+    types_[0] = ObLogColumnarBatch::get_column_type(ObIntType);
+    types_[1] = ObLogColumnarBatch::get_column_type(ObInt32Type);
+    types_[2] = ObLogColumnarBatch::get_column_type(ObUInt64Type);
+    types_[3] = ObLogColumnarBatch::get_column_type(ObDoubleType);
+    types_[4] = ObLogColumnarBatch::get_column_type(ObFloatType);
+    types_[5] = ObLogColumnarBatch::get_column_type(ObDateTimeType);
+    types_[6] = ObLogColumnarBatch::get_column_type(ObDateType);
+    types_[7] = ObLogColumnarBatch::get_column_type(ObVarcharType);
+  }
+
+  void fill_row(const int64_t seq)
+  {
+    objs_[0].set_int(seq);
+    objs_[1].set_int32(static_cast<int32_t>(seq % 1000));
+    objs_[2].set_uint64(static_cast<uint64_t>(seq) * 3);
+    objs_[3].set_double(static_cast<double>(seq) / 7);
+    objs_[4].set_float(static_cast<float>(seq) / 3);
+    objs_[5].set_datetime(1700000000000000L + seq);
+    objs_[6].set_date(static_cast<int32_t>(19000 + seq % 365));
+    varchar_len_ = snprintf(varchar_buf_, sizeof(varchar_buf_), "name_%ld", seq);
+    objs_[7].set_varchar(varchar_buf_, static_cast<int32_t>(varchar_len_));
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObLogColumnarRow row_;
+  ICDCColumnarBatch::ColumnType types_[COLUMN_CNT];
+  ObLogColumnarValue new_values_[COLUMN_CNT];
+  ObLogColumnarValue old_values_[COLUMN_CNT];
+  ObObj objs_[COLUMN_CNT];
+  char varchar_buf_[64];
+  int64_t varchar_len_;
+};
+
+TEST_F(TestLogColumnarBatch, column_type)
+{
+  EXPECT_EQ(ICDCColumnarBatch::COLUMN_INT64, ObLogColumnarBatch::get_column_type(ObTinyIntType));
+  EXPECT_EQ(ICDCColumnarBatch::COLUMN_INT64, ObLogColumnarBatch::get_column_type(ObTimestampType));
+  EXPECT_EQ(ICDCColumnarBatch::COLUMN_UINT64, ObLogColumnarBatch::get_column_type(ObYearType));
+  EXPECT_EQ(ICDCColumnarBatch::COLUMN_UINT64, ObLogColumnarBatch::get_column_type(ObBitType));
+  EXPECT_EQ(ICDCColumnarBatch::COLUMN_DOUBLE, ObLogColumnarBatch::get_column_type(ObFloatType));
+  EXPECT_EQ(ICDCColumnarBatch::COLUMN_BYTES, ObLogColumnarBatch::get_column_type(ObCharType));
+  EXPECT_EQ(ICDCColumnarBatch::COLUMN_TEXT, ObLogColumnarBatch::get_column_type(ObNumberType));
+  EXPECT_EQ(ICDCColumnarBatch::COLUMN_TEXT, ObLogColumnarBatch::get_column_type(ObLongTextType));
+  EXPECT_EQ(ICDCColumnarBatch::COLUMN_TEXT, ObLogColumnarBatch::get_column_type(ObJsonType));
+  EXPECT_FALSE(ObLogColumnarBatch::is_binary_type(ObNumberType));
+  EXPECT_TRUE(ObLogColumnarBatch::is_binary_type(ObVarcharType));
+}
+
+TEST_F(TestLogColumnarBatch, append)
+{
+  ObLogColumnarBatch batch;
+  ICDCColumnarBatch::ColumnImage image;
+  const int64_t row_cnt = 100;
+
+  ASSERT_EQ(OB_SUCCESS, batch.init(row_, "db", "tb", NULL));
+  for (int64_t seq = 0; seq < row_cnt; seq++) {
+    fill_row(seq);
+    // NULL double value for odd rows, no varchar value for every 10 rows
+    if (1 == seq % 2) {
+      objs_[3].set_null();
+    }
+    new_values_[7].obj_ = (0 == seq % 10) ? NULL : &objs_[7];
+    ASSERT_EQ(OB_SUCCESS, batch.append(row_, seq));
+  }
+
+  EXPECT_EQ(row_cnt, batch.get_row_count());
+  EXPECT_EQ(COLUMN_CNT, batch.get_column_count());
+  EXPECT_STREQ("db", batch.get_db_name());
+  EXPECT_STREQ("tb", batch.get_table_name());
+  EXPECT_EQ(EINSERT, batch.get_record_types()[row_cnt - 1]);
+  EXPECT_EQ(row_cnt - 1, batch.get_row_seqs()[row_cnt - 1]);
+
+  ASSERT_EQ(OB_SUCCESS, batch.get_column_image(0, false, image));
+  EXPECT_EQ(57, static_cast<const int64_t *>(image.fixed_values_)[57]);
+  ASSERT_EQ(OB_SUCCESS, batch.get_column_image(2, false, image));
+  EXPECT_EQ(171U, static_cast<const uint64_t *>(image.fixed_values_)[57]);
+
+  ASSERT_EQ(OB_SUCCESS, batch.get_column_image(3, false, image));
+  EXPECT_EQ(0, (image.null_bitmap_[56 / 8] >> (56 % 8)) & 1);
+  EXPECT_EQ(1, (image.null_bitmap_[57 / 8] >> (57 % 8)) & 1);
+  EXPECT_DOUBLE_EQ(56.0 / 7, static_cast<const double *>(image.fixed_values_)[56]);
+
+  ASSERT_EQ(OB_SUCCESS, batch.get_column_image(5, false, image));
+  EXPECT_EQ(1700000000000057L, static_cast<const int64_t *>(image.fixed_values_)[57]);
+
+  ASSERT_EQ(OB_SUCCESS, batch.get_column_image(7, false, image));
+  EXPECT_EQ(0, (image.present_bitmap_[50 / 8] >> (50 % 8)) & 1);
+  EXPECT_EQ(1, (image.present_bitmap_[57 / 8] >> (57 % 8)) & 1);
+  EXPECT_EQ(image.offsets_[50], image.offsets_[51]);
+  EXPECT_EQ(0, strncmp("name_57", image.data_ + image.offsets_[57], image.offsets_[58] - image.offsets_[57]));
+
+  // old image is empty for INSERT
+  ASSERT_EQ(OB_SUCCESS, batch.get_column_image(0, true, image));
+  EXPECT_EQ(0, image.present_bitmap_[0]);
+
+  // schema changed
+  row_.column_cnt_ = COLUMN_CNT - 1;
+  EXPECT_FALSE(batch.is_compatible(row_));
+  EXPECT_NE(OB_SUCCESS, batch.append(row_, row_cnt));
+}
+
+// Throughput of the string path, which formats each value to string as ObObj2strHelper and
+// copies it into the record, compared with appending typed values into the columnar batch.
+TEST_F(TestLogColumnarBatch, throughput)
+{
+  const int64_t row_cnt = 200000;
+  const int64_t buf_size = 4096;
+  char *buf = static_cast<char *>(allocator_.alloc(buf_size));
+  ObString strs[COLUMN_CNT];
+  int64_t string_path_us = 0;
+  int64_t columnar_path_us = 0;
+  ASSERT_TRUE(NULL != buf);
+
+  {
+    const int64_t start_ts = ObTimeUtility::current_time();
+    for (int64_t seq = 0; seq < row_cnt; seq++) {
+      int64_t pos = 0;
+      fill_row(seq);
+      for (int64_t idx = 0; idx < COLUMN_CNT; idx++) {
+        const int64_t start_pos = pos;
+        ASSERT_EQ(OB_SUCCESS, objs_[idx].print_plain_str_literal(buf, buf_size, pos));
+        strs[idx].assign_ptr(buf + start_pos, static_cast<int32_t>(pos - start_pos));
+      }
+      if (0 == seq % 1024) {
+        allocator_.reuse();
+        buf = static_cast<char *>(allocator_.alloc(buf_size));
+        ASSERT_TRUE(NULL != buf);
+      }
+    }
+    string_path_us = ObTimeUtility::current_time() - start_ts;
+  }
+
+  {
+    ObLogColumnarBatch batch;
+    const int64_t start_ts = ObTimeUtility::current_time();
+    ASSERT_EQ(OB_SUCCESS, batch.init(row_, "db", "tb", NULL));
+    for (int64_t seq = 0; seq < row_cnt; seq++) {
+      fill_row(seq);
+      ASSERT_EQ(OB_SUCCESS, batch.append(row_, seq));
+    }
+    columnar_path_us = ObTimeUtility::current_time() - start_ts;
+    EXPECT_EQ(row_cnt, batch.get_row_count());
+  }
+
+  const double string_rps = static_cast<double>(row_cnt) * 1000000 / std::max(string_path_us, 1L);
+  const double columnar_rps = static_cast<double>(row_cnt) * 1000000 / std::max(columnar_path_us, 1L);
+  fprintf(stdout, "columns=%ld rows=%ld string_path=%.0f records/sec columnar_path=%.0f records/sec\n",
+      COLUMN_CNT, row_cnt, string_rps, columnar_rps);
+  OBLOG_LOG(INFO, "columnar batch throughput", K(row_cnt), K(string_path_us), K(columnar_path_us),
+      K(string_rps), K(columnar_rps));
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  OB_LOGGER.set_log_level("INFO");
+  OB_LOGGER.set_file_name("test_ob_log_columnar_batch.log", true);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "ob_log_file_store_service.h"      // ObLogFileStoreService
+#include "ob_log_config.h"                  // TCONF
+#include "lib/file/file_directory_utils.h"  // FileDirectoryUtils
+
+using namespace oceanbase::common;
+namespace oceanbase
+{
+namespace libobcdc
+{
+static const char *STORE_PATH = "./test_file_store";
+static const int64_t VALUE_SIZE = 1L << 20;
+
+class TestLogFileStoreService : public ::testing::Test
+{
+public:
+  TestLogFileStoreService() : value_buf_(NULL) {}
+  ~TestLogFileStoreService() {}
+
+  virtual void SetUp()
+  {
+    ASSERT_TRUE(TCONF.file_store_segment_size.set_value("16MB"));
+    ASSERT_EQ(OB_SUCCESS, store_service_.init(STORE_PATH));
+    value_buf_ = new char[VALUE_SIZE];
+  }
+
+  virtual void TearDown()
+  {
+    store_service_.destroy();
+    delete [] value_buf_;
+    value_buf_ = NULL;
+  }
+
+  // value i is filled with byte i
+  ObSlice get_value(const int64_t idx)
+  {
+    MEMSET(value_buf_, static_cast<char>(idx), VALUE_SIZE);
+    return ObSlice(value_buf_, VALUE_SIZE);
+  }
+
+  bool check_value(const int64_t idx, const std::string &value)
+  {
+    bool bool_ret = (VALUE_SIZE == value.size());
+
+    for (int64_t pos = 0; bool_ret && pos < VALUE_SIZE; pos += 4096) {
+      bool_ret = (static_cast<char>(idx) == value[pos]);
+    }
+
+    return bool_ret;
+  }
+
+  bool is_segment_exist(const int64_t cf_id, const int64_t segment_id)
+  {
+    bool is_exist = false;
+    std::string path = std::string(STORE_PATH) + "/" + std::to_string(cf_id) + "." + std::to_string(segment_id);
+    EXPECT_EQ(OB_SUCCESS, FileDirectoryUtils::is_exists(path.c_str(), is_exist));
+    return is_exist;
+  }
+
+  static std::string get_key(const int64_t idx)
+  {
+    char key[32];
+    snprintf(key, sizeof(key), "trans_%04ld", idx);
+    return std::string(key);
+  }
+
+protected:
+  ObLogFileStoreService store_service_;
+  char *value_buf_;
+};
+
+TEST_F(TestLogFileStoreService, put_get_del)
+{
+  void *cf = NULL;
+  std::string value;
+  const int64_t value_cnt = 40;
+
+  ASSERT_EQ(OB_SUCCESS, store_service_.create_column_family("1001:tenant", cf));
+  for (int64_t idx = 0; idx < value_cnt; idx++) {
+    ASSERT_EQ(OB_SUCCESS, store_service_.put(cf, get_key(idx), get_value(idx)));
+  }
+
+  // 16 values in each segment
+  EXPECT_TRUE(is_segment_exist(1, 0));
+  EXPECT_TRUE(is_segment_exist(1, 1));
+  EXPECT_TRUE(is_segment_exist(1, 2));
+  EXPECT_FALSE(is_segment_exist(1, 3));
+
+  for (int64_t idx = 0; idx < value_cnt; idx++) {
+    ASSERT_EQ(OB_SUCCESS, store_service_.get(cf, get_key(idx), value));
+    EXPECT_TRUE(check_value(idx, value));
+  }
+
+  // overwrite
+  ASSERT_EQ(OB_SUCCESS, store_service_.put(cf, get_key(3), get_value(100)));
+  ASSERT_EQ(OB_SUCCESS, store_service_.get(cf, get_key(3), value));
+  EXPECT_TRUE(check_value(100, value));
+
+  // sealed segment is removed after all values in it are deleted
+  for (int64_t idx = 0; idx < 16; idx++) {
+    ASSERT_EQ(OB_SUCCESS, store_service_.del(cf, get_key(idx)));
+  }
+  EXPECT_FALSE(is_segment_exist(1, 0));
+  EXPECT_TRUE(is_segment_exist(1, 1));
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, store_service_.get(cf, get_key(0), value));
+
+  // delete [trans_0016, trans_0032)
+  ASSERT_EQ(OB_SUCCESS, store_service_.del_range(cf, get_key(16), get_key(32)));
+  EXPECT_FALSE(is_segment_exist(1, 1));
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, store_service_.get(cf, get_key(31), value));
+  ASSERT_EQ(OB_SUCCESS, store_service_.get(cf, get_key(32), value));
+  EXPECT_TRUE(check_value(32, value));
+
+  ASSERT_EQ(OB_SUCCESS, store_service_.drop_column_family(cf));
+  EXPECT_FALSE(is_segment_exist(1, 2));
+  EXPECT_FALSE(is_segment_exist(1, 3));
+  ASSERT_EQ(OB_SUCCESS, store_service_.destory_column_family(cf));
+}
+
+TEST_F(TestLogFileStoreService, batch_write)
+{
+  void *cf = NULL;
+  std::string value;
+  std::vector<std::string> keys;
+  std::vector<ObSlice> values;
+  std::vector<char *> bufs;
+  const int64_t value_cnt = 8;
+
+  ASSERT_EQ(OB_SUCCESS, store_service_.create_column_family("1002:tenant", cf));
+  for (int64_t idx = 0; idx < value_cnt; idx++) {
+    char *buf = new char[VALUE_SIZE];
+    MEMSET(buf, static_cast<char>(idx), VALUE_SIZE);
+    bufs.push_back(buf);
+    keys.push_back(get_key(idx));
+    values.push_back(ObSlice(buf, VALUE_SIZE));
+  }
+
+  ASSERT_EQ(OB_SUCCESS, store_service_.batch_write(cf, keys, values));
+  for (int64_t idx = 0; idx < value_cnt; idx++) {
+    ASSERT_EQ(OB_SUCCESS, store_service_.get(cf, keys[idx], value));
+    EXPECT_TRUE(check_value(idx, value));
+    delete [] bufs[idx];
+  }
+
+  keys.pop_back();
+  EXPECT_EQ(OB_INVALID_ARGUMENT, store_service_.batch_write(cf, keys, values));
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  OB_LOGGER.set_log_level("INFO");
+  OB_LOGGER.set_file_name("test_ob_log_file_store_service.log", true);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
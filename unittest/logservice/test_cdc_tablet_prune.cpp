@@ -0,0 +1,345 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX CLOG
+#include <gtest/gtest.h>
+#define private public
+#include "logservice/cdcservice/ob_cdc_fetcher.h"
+#include "logservice/palf/log_group_entry.h"
+#undef private
+#include "logservice/cdcservice/ob_cdc_req.h"
+#include "storage/tx/ob_tx_log.h"
+#include "storage/memtable/ob_memtable_mutator.h"
+#include "storage/memtable/ob_memtable_context.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace palf;
+using namespace cdc;
+using namespace obrpc;
+using namespace transaction;
+using namespace memtable;
+
+namespace unittest
+{
+
+static const int64_t TX_ID = 1001;
+static const uint64_t CLUSTER_ID = 1;
+
+// Generate LogEntries of tx log blocks, the rows of a redo are given by their tablet ids.
+class TxLogBuilder
+{
+public:
+  TxLogBuilder() : allocator_("CdcPruneTest"), block_(), entry_no_(0) {}
+
+  void begin()
+  {
+    ObTxLogBlockHeader block_header(CLUSTER_ID, entry_no_++, ObTransID(TX_ID), ObAddr());
+    block_.reset();
+    ASSERT_EQ(OB_SUCCESS, block_.init(TX_ID, block_header));
+  }
+  // a redo whose rows belong to tablet_ids, a negative id appends a table lock
+  void add_redo(const std::vector<int64_t> &tablet_ids, const uint8_t row_flag = ObTransRowFlag::NORMAL_ROW)
+  {
+    ObTxRedoLogTempRef redo_ref;
+    ObTxRedoLog redo_log(redo_ref);
+    ObMutatorWriter writer;
+    ObCLogEncryptInfo encrypt_info;
+    int64_t mutator_size = 0;
+    ASSERT_EQ(OB_SUCCESS, block_.prepare_mutator_buf(redo_log));
+    ASSERT_EQ(OB_SUCCESS, writer.set_buffer(redo_log.get_mutator_buf(), redo_log.get_mutator_size()));
+    for (int64_t i = 0; i < static_cast<int64_t>(tablet_ids.size()); i++) {
+      char row_buf[1024];
+      int64_t pos = 0;
+      int64_t buf_len = sizeof(row_buf);
+      ObObj rowkey_obj;
+      rowkey_obj.set_int(i);
+      ObStoreRowkey rowkey(&rowkey_obj, 1);
+      ObRowData new_row;
+      ObRowData old_row;
+      ObMemtableMutatorRow row(1, rowkey, 1, new_row, old_row, blocksstable::DF_INSERT, 1, 0, 1, 0, i + 1);
+      ObMutatorRowHeader row_header;
+      if (tablet_ids[i] < 0) {
+        row_header.mutator_type_ = MutatorType::MUTATOR_TABLE_LOCK;
+        row_header.tablet_id_ = ObTabletID(-tablet_ids[i]);
+      } else {
+        row_header.tablet_id_ = ObTabletID(tablet_ids[i]);
+      }
+      ASSERT_EQ(OB_SUCCESS, row_header.serialize(row_buf, buf_len, pos));
+      ASSERT_EQ(OB_SUCCESS, row.serialize(row_buf, buf_len, pos, NULL, encrypt_info));
+      ASSERT_EQ(OB_SUCCESS, writer.append_row_buf(row_buf, pos));
+    }
+    ASSERT_EQ(OB_SUCCESS, writer.serialize(row_flag, mutator_size, encrypt_info));
+    ASSERT_EQ(OB_SUCCESS, block_.finish_mutator_buf(redo_log, mutator_size));
+  }
+  void add_commit_info()
+  {
+    ObTxCommitInfoLogTempRef commit_info_ref;
+    ObTxCommitInfoLog commit_info_log(commit_info_ref);
+    ASSERT_EQ(OB_SUCCESS, block_.add_new_log(commit_info_log));
+  }
+  void end(LogEntry &log_entry)
+  {
+    const int64_t len = block_.get_size();
+    char *buf = static_cast<char *>(allocator_.alloc(len));
+    share::SCN scn;
+    ASSERT_TRUE(NULL != buf);
+    MEMCPY(buf, block_.get_buf(), len);
+    ASSERT_EQ(OB_SUCCESS, scn.convert_for_logservice(ObTimeUtility::current_time_ns()));
+    log_entry.reset();
+    ASSERT_EQ(OB_SUCCESS, log_entry.header_.generate_header(buf, len, scn));
+    log_entry.buf_ = buf;
+  }
+  // a LogGroupEntry of the LogEntries
+  void build_group(const std::vector<LogEntry *> &entries, const bool is_padding, LogGroupEntry &group)
+  {
+    int64_t len = 0;
+    for (int64_t i = 0; i < static_cast<int64_t>(entries.size()); i++) {
+      len += entries[i]->get_serialize_size();
+    }
+    char *buf = static_cast<char *>(allocator_.alloc(len + 1));
+    int64_t pos = 0;
+    ASSERT_TRUE(NULL != buf);
+    for (int64_t i = 0; i < static_cast<int64_t>(entries.size()); i++) {
+      ASSERT_EQ(OB_SUCCESS, entries[i]->serialize(buf, len, pos));
+    }
+    group.reset();
+    group.header_.magic_ = LogGroupEntryHeader::MAGIC;
+    group.header_.group_size_ = static_cast<int32_t>(len);
+    group.header_.max_scn_ = entries.empty() ? share::SCN::base_scn() : entries.back()->get_scn();
+    group.header_.flag_ = is_padding ? LogGroupEntryHeader::PADDING_TYPE_MASK : 0;
+    group.buf_ = buf;
+  }
+
+private:
+  ObArenaAllocator allocator_;
+  ObTxLogBlock block_;
+  int64_t entry_no_;
+};
+
+class TestCdcTabletPrune : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    ObSEArray<ObTabletID, 4> tablets;
+    // unsorted on purpose, FetchRunTime sorts them
+    ASSERT_EQ(OB_SUCCESS, tablets.push_back(ObTabletID(200003)));
+    ASSERT_EQ(OB_SUCCESS, tablets.push_back(ObTabletID(200001)));
+    ASSERT_EQ(OB_SUCCESS, tablets.push_back(ObTabletID(200002)));
+    ASSERT_EQ(OB_SUCCESS, frt_.init_pruned_tablets(tablets));
+  }
+  bool is_entry_pruned(LogEntry &entry, ObIArray<ObCdcLSFetchLogResp::PrunedRedo> &redo_arr)
+  {
+    bool is_pruned = false;
+    EXPECT_EQ(OB_SUCCESS, fetcher_.check_log_entry_pruned_(LSN(4096), entry, frt_, redo_arr, is_pruned));
+    return is_pruned;
+  }
+
+protected:
+  ObCdcFetcher fetcher_;
+  FetchRunTime frt_;
+  TxLogBuilder builder_;
+};
+
+TEST_F(TestCdcTabletPrune, pruned_tablets)
+{
+  ASSERT_TRUE(frt_.has_pruned_tablets());
+  ASSERT_TRUE(frt_.is_tablet_pruned(ObTabletID(200001)));
+  ASSERT_TRUE(frt_.is_tablet_pruned(ObTabletID(200003)));
+  ASSERT_FALSE(frt_.is_tablet_pruned(ObTabletID(200004)));
+  ASSERT_FALSE(frt_.is_tablet_pruned(ObTabletID(1)));
+
+  // an empty list prunes nothing
+  FetchRunTime frt;
+  ObSEArray<ObTabletID, 1> empty;
+  ASSERT_EQ(OB_SUCCESS, frt.init_pruned_tablets(empty));
+  ASSERT_FALSE(frt.has_pruned_tablets());
+  ASSERT_FALSE(frt.is_tablet_pruned(ObTabletID(200001)));
+}
+
+TEST_F(TestCdcTabletPrune, redo_decision)
+{
+  ObSEArray<ObCdcLSFetchLogResp::PrunedRedo, 4> redo_arr;
+  LogEntry entry;
+
+  // all rows of pruned tablets
+  builder_.begin();
+  builder_.add_redo({200001, 200002, 200001});
+  builder_.end(entry);
+  ASSERT_TRUE(is_entry_pruned(entry, redo_arr));
+  ASSERT_EQ(1, redo_arr.count());
+  ASSERT_EQ(TX_ID, redo_arr.at(0).tx_id_);
+  ASSERT_EQ(CLUSTER_ID, redo_arr.at(0).cluster_id_);
+  ASSERT_EQ(LSN(4096), redo_arr.at(0).lsn_);
+
+  // a row of a consumed tablet keeps the entry
+  redo_arr.reuse();
+  builder_.begin();
+  builder_.add_redo({200001, 300001});
+  builder_.end(entry);
+  ASSERT_FALSE(is_entry_pruned(entry, redo_arr));
+  ASSERT_EQ(0, redo_arr.count());
+
+  // table locks are always consumed
+  builder_.begin();
+  builder_.add_redo({200001, -200002});
+  builder_.end(entry);
+  ASSERT_FALSE(is_entry_pruned(entry, redo_arr));
+
+  // rows of encrypted or big row mutators can't be checked
+  builder_.begin();
+  builder_.add_redo({200001}, ObTransRowFlag::BIG_ROW_NEW);
+  builder_.end(entry);
+  ASSERT_FALSE(is_entry_pruned(entry, redo_arr));
+
+  // other tx logs keep the transaction boundaries
+  builder_.begin();
+  builder_.add_redo({200001});
+  builder_.add_commit_info();
+  builder_.end(entry);
+  ASSERT_FALSE(is_entry_pruned(entry, redo_arr));
+
+  // the client expects at most one redo in a LogEntry
+  builder_.begin();
+  builder_.add_redo({200001});
+  builder_.add_redo({200002});
+  builder_.end(entry);
+  ASSERT_FALSE(is_entry_pruned(entry, redo_arr));
+  ASSERT_EQ(0, redo_arr.count());
+}
+
+TEST_F(TestCdcTabletPrune, tablet_changes)
+{
+  ObSEArray<ObCdcLSFetchLogResp::PrunedRedo, 4> redo_arr;
+  ObSEArray<ObTabletID, 4> tablets;
+  LogEntry entry;
+  builder_.begin();
+  builder_.add_redo({200004});
+  builder_.end(entry);
+
+  // tablet added after the client built its list: its redo is sent as before
+  ASSERT_FALSE(is_entry_pruned(entry, redo_arr));
+  // the client sends the new tablet in the next request
+  ASSERT_EQ(OB_SUCCESS, tablets.assign(frt_.pruned_tablets_));
+  ASSERT_EQ(OB_SUCCESS, tablets.push_back(ObTabletID(200004)));
+  ASSERT_EQ(OB_SUCCESS, frt_.init_pruned_tablets(tablets));
+  ASSERT_TRUE(is_entry_pruned(entry, redo_arr));
+
+  // tablet dropped: it is no more in the list of the next request
+  redo_arr.reuse();
+  tablets.reuse();
+  ASSERT_EQ(OB_SUCCESS, tablets.push_back(ObTabletID(200001)));
+  ASSERT_EQ(OB_SUCCESS, frt_.init_pruned_tablets(tablets));
+  ASSERT_FALSE(is_entry_pruned(entry, redo_arr));
+
+  // tablet moved to another LS: the list is per tenant, so the decision is the same for the
+  // requests of both LS, and the sys LS is never pruned
+  LogGroupEntry group;
+  std::vector<LogEntry *> entries(1, &entry);
+  builder_.build_group(entries, false, group);
+  ASSERT_EQ(OB_SUCCESS, tablets.push_back(ObTabletID(200004)));
+  ASSERT_EQ(OB_SUCCESS, frt_.init_pruned_tablets(tablets));
+  const share::ObLSID ls_ids[] = {share::ObLSID(1001), share::ObLSID(1002)};
+  for (int64_t i = 0; i < 2; i++) {
+    ObCdcLSFetchLogResp resp;
+    bool is_pruned = false;
+    ASSERT_EQ(OB_SUCCESS, fetcher_.prune_group_entry_(ls_ids[i], LSN(8192), group, frt_, resp, is_pruned));
+    ASSERT_TRUE(is_pruned);
+    ASSERT_EQ(1, resp.get_pruned_groups().count());
+    ASSERT_EQ(1, resp.get_pruned_redos().count());
+    ASSERT_EQ(LSN(8192) + group.get_serialize_size(), resp.get_next_req_lsn());
+  }
+  ObCdcLSFetchLogResp resp;
+  bool is_pruned = true;
+  ASSERT_EQ(OB_SUCCESS, fetcher_.prune_group_entry_(share::SYS_LS, LSN(8192), group, frt_, resp, is_pruned));
+  ASSERT_FALSE(is_pruned);
+  ASSERT_EQ(0, resp.get_pruned_groups().count());
+}
+
+TEST_F(TestCdcTabletPrune, group_decision)
+{
+  LogEntry pruned_entry;
+  LogEntry kept_entry;
+  LogGroupEntry group;
+  builder_.begin();
+  builder_.add_redo({200002});
+  builder_.end(pruned_entry);
+  builder_.begin();
+  builder_.add_redo({300001});
+  builder_.end(kept_entry);
+
+  // a group is pruned only if all its entries are
+  std::vector<LogEntry *> entries;
+  entries.push_back(&pruned_entry);
+  entries.push_back(&pruned_entry);
+  builder_.build_group(entries, false, group);
+  ObCdcLSFetchLogResp resp;
+  bool is_pruned = false;
+  ASSERT_EQ(OB_SUCCESS, fetcher_.prune_group_entry_(share::ObLSID(1001), LSN(0), group, frt_, resp, is_pruned));
+  ASSERT_TRUE(is_pruned);
+  ASSERT_EQ(2, resp.get_pruned_redos().count());
+  ASSERT_EQ(2, resp.get_pruned_groups().at(0).redo_cnt_);
+  ASSERT_EQ(group.get_serialize_size(), resp.get_pruned_groups().at(0).size_);
+
+  entries.push_back(&kept_entry);
+  builder_.build_group(entries, false, group);
+  ASSERT_EQ(OB_SUCCESS, fetcher_.prune_group_entry_(share::ObLSID(1001), LSN(0), group, frt_, resp, is_pruned));
+  ASSERT_FALSE(is_pruned);
+  ASSERT_EQ(1, resp.get_pruned_groups().count());
+
+  // padding groups carry no redo
+  entries.clear();
+  builder_.build_group(entries, true, group);
+  ASSERT_EQ(OB_SUCCESS, fetcher_.prune_group_entry_(share::ObLSID(1001), LSN(0), group, frt_, resp, is_pruned));
+  ASSERT_TRUE(is_pruned);
+  ASSERT_EQ(2, resp.get_pruned_groups().count());
+  ASSERT_EQ(0, resp.get_pruned_groups().at(1).redo_cnt_);
+
+  // nothing is pruned without a list
+  FetchRunTime frt;
+  ObCdcLSFetchLogResp resp2;
+  ASSERT_EQ(OB_SUCCESS, fetcher_.prune_group_entry_(share::ObLSID(1001), LSN(0), group, frt, resp2, is_pruned));
+  ASSERT_FALSE(is_pruned);
+}
+
+TEST_F(TestCdcTabletPrune, serialize)
+{
+  ObCdcLSFetchLogReq req;
+  ObCdcLSFetchLogReq req2;
+  ObSEArray<ObTabletID, 4> tablets;
+  for (int64_t i = 0; i < ObCdcLSFetchLogReq::MAX_PRUNED_TABLET_CNT + 10; i++) {
+    ASSERT_EQ(OB_SUCCESS, tablets.push_back(ObTabletID(200001 + i)));
+  }
+  ASSERT_EQ(OB_SUCCESS, req.set_pruned_tablets(tablets));
+  ASSERT_EQ(ObCdcLSFetchLogReq::MAX_PRUNED_TABLET_CNT, req.get_pruned_tablets().count());
+  const int64_t len = req.get_serialize_size();
+  char *buf = new char[len];
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, req.serialize(buf, len, pos));
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, req2.deserialize(buf, len, pos));
+  ASSERT_EQ(req.get_pruned_tablets().count(), req2.get_pruned_tablets().count());
+  ASSERT_EQ(req.get_pruned_tablets().at(100), req2.get_pruned_tablets().at(100));
+  delete[] buf;
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
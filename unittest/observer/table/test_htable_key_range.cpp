@@ -0,0 +1,299 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "observer/table/ob_table_context.h"
+#include "share/schema/ob_table_schema.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::table;
+using namespace oceanbase::share::schema;
+
+#define CALL(func, ...) func(__VA_ARGS__); ASSERT_FALSE(HasFatalFailure());
+
+// create table htable (K varbinary(1024), Q varbinary(256), T bigint, V varbinary(1024),
+//                      primary key(K, Q, T))
+void fill_htable_column(ObColumnSchemaV2 &column, uint64_t id, const char *name,
+                        uint64_t rowkey_pos, ObObjType type, ObCollationType cs_type)
+{
+  column.set_column_id(id);
+  column.set_column_name(ObString::make_string(name));
+  column.set_rowkey_position(rowkey_pos);
+  column.set_nullable(0 == rowkey_pos);
+  column.set_data_type(type);
+  column.set_collation_type(cs_type);
+  column.set_charset_type(ObCharset::charset_type_by_coll(cs_type));
+  if (ob_is_string_type(type)) {
+    column.set_data_length(1024);
+  }
+}
+
+void create_htable_schema(ObTableSchema &table, ObColumnSchemaV2 *columns,
+                          ObCollationType q_cs_type = CS_TYPE_BINARY)
+{
+  table.set_tenant_id(1);
+  table.set_database_id(1);
+  table.set_table_id(3001);
+  table.set_table_name("htable$family1");
+  table.set_table_type(USER_TABLE);
+  fill_htable_column(columns[0], 16, "K", 1, ObVarcharType, CS_TYPE_BINARY);
+  fill_htable_column(columns[1], 17, "Q", 2, ObVarcharType, q_cs_type);
+  fill_htable_column(columns[2], 18, "T", 3, ObIntType, CS_TYPE_BINARY);
+  fill_htable_column(columns[3], 19, "V", 0, ObVarcharType, CS_TYPE_BINARY);
+  for (int64_t i = 0; i < 4; i++) {
+    ASSERT_EQ(OB_SUCCESS, table.add_column(columns[i]));
+  }
+  ASSERT_EQ(3, table.get_rowkey_column_num());
+}
+
+class TestHTableKeyRange: public ::testing::Test
+{
+public:
+  TestHTableKeyRange() : allocator_() {}
+  virtual ~TestHTableKeyRange() {}
+  virtual void SetUp()
+  {
+    create_htable_schema(table_schema_, columns_);
+  }
+  virtual void TearDown() {}
+
+  void init_ctx(ObTableCtx &ctx, const ObTableSchema &table_schema)
+  {
+    ctx.table_schema_ = &table_schema;
+    ctx.tenant_id_ = table_schema.get_tenant_id();
+    ctx.ref_table_id_ = table_schema.get_table_id();
+    ctx.is_index_scan_ = false;
+    ctx.scan_order_ = ObQueryFlag::Forward;
+  }
+
+  // [K, MIN, MIN] ~ [K, MAX, MAX], the range of a HBase Get
+  void make_row_range(const char *k, ObNewRange &range)
+  {
+    ObObj *objs = static_cast<ObObj *>(allocator_.alloc(sizeof(ObObj) * 6));
+    ASSERT_TRUE(nullptr != objs);
+    objs[0].set_varbinary(ObString::make_string(k));
+    objs[1].set_min_value();
+    objs[2].set_min_value();
+    objs[3].set_varbinary(ObString::make_string(k));
+    objs[4].set_max_value();
+    objs[5].set_max_value();
+    range.table_id_ = table_schema_.get_table_id();
+    range.start_key_.assign(objs, 3);
+    range.end_key_.assign(objs + 3, 3);
+    range.border_flag_.set_inclusive_start();
+    range.border_flag_.set_inclusive_end();
+  }
+
+  // [K1, MIN, MIN] ~ [K2, MAX, MAX], the range of a HBase Scan
+  void make_scan_range(const char *k1, const char *k2, ObNewRange &range)
+  {
+    CALL(make_row_range, k1, range);
+    ObObj *end_objs = const_cast<ObObj *>(range.end_key_.get_obj_ptr());
+    end_objs[0].set_varbinary(ObString::make_string(k2));
+  }
+
+  void check_range(const ObNewRange &range, const char *k, const char *q,
+                   const int64_t t_start, const int64_t t_end, const bool all_time)
+  {
+    const ObObj *start = range.start_key_.get_obj_ptr();
+    const ObObj *end = range.end_key_.get_obj_ptr();
+    ASSERT_EQ(3, range.start_key_.get_obj_cnt());
+    ASSERT_EQ(3, range.end_key_.get_obj_cnt());
+    ASSERT_TRUE(range.border_flag_.inclusive_start());
+    ASSERT_TRUE(range.border_flag_.inclusive_end());
+    ASSERT_EQ(ObString::make_string(k), start[ObHTableConstants::COL_IDX_K].get_varchar());
+    ASSERT_EQ(ObString::make_string(k), end[ObHTableConstants::COL_IDX_K].get_varchar());
+    ASSERT_EQ(ObString::make_string(q), start[ObHTableConstants::COL_IDX_Q].get_varchar());
+    ASSERT_EQ(ObString::make_string(q), end[ObHTableConstants::COL_IDX_Q].get_varchar());
+    if (all_time) {
+      ASSERT_TRUE(start[ObHTableConstants::COL_IDX_T].is_min_value());
+      ASSERT_TRUE(end[ObHTableConstants::COL_IDX_T].is_max_value());
+    } else {
+      ASSERT_EQ(t_start, start[ObHTableConstants::COL_IDX_T].get_int());
+      ASSERT_EQ(t_end, end[ObHTableConstants::COL_IDX_T].get_int());
+    }
+  }
+
+  void check_unchanged(ObTableCtx &ctx, const ObHTableFilter &filter)
+  {
+    ObSEArray<ObNewRange, 4> origin_ranges;
+    ASSERT_EQ(OB_SUCCESS, origin_ranges.assign(ctx.key_ranges_));
+    ASSERT_EQ(OB_SUCCESS, ctx.narrow_htable_key_ranges(filter));
+    ASSERT_EQ(origin_ranges.count(), ctx.key_ranges_.count());
+    for (int64_t i = 0; i < origin_ranges.count(); i++) {
+      ASSERT_TRUE(origin_ranges.at(i) == ctx.key_ranges_.at(i));
+    }
+  }
+
+public:
+  ObArenaAllocator allocator_;
+  ObTableSchema table_schema_;
+  ObColumnSchemaV2 columns_[4];
+private:
+  // disallow copy
+  DISALLOW_COPY_AND_ASSIGN(TestHTableKeyRange);
+};
+
+TEST_F(TestHTableKeyRange, qualifiers)
+{
+  ObTableCtx ctx(allocator_);
+  ObHTableFilter filter;
+  ObNewRange range;
+  init_ctx(ctx, table_schema_);
+  CALL(make_row_range, "row1", range);
+  ASSERT_EQ(OB_SUCCESS, ctx.key_ranges_.push_back(range));
+  filter.set_valid(true);
+  // unordered and duplicated qualifiers, one range per distinct qualifier in binary order
+  ASSERT_EQ(OB_SUCCESS, filter.add_column(ObString::make_string("c")));
+  ASSERT_EQ(OB_SUCCESS, filter.add_column(ObString::make_string("a")));
+  ASSERT_EQ(OB_SUCCESS, filter.add_column(ObString::make_string("b")));
+  ASSERT_EQ(OB_SUCCESS, filter.add_column(ObString::make_string("a")));
+  ASSERT_EQ(OB_SUCCESS, ctx.narrow_htable_key_ranges(filter));
+  ASSERT_EQ(3, ctx.key_ranges_.count());
+  CALL(check_range, ctx.key_ranges_.at(0), "row1", "a", 0, 0, true);
+  CALL(check_range, ctx.key_ranges_.at(1), "row1", "b", 0, 0, true);
+  CALL(check_range, ctx.key_ranges_.at(2), "row1", "c", 0, 0, true);
+
+  // no qualifier, the whole row is scanned
+  ObTableCtx ctx2(allocator_);
+  ObHTableFilter filter2;
+  init_ctx(ctx2, table_schema_);
+  ASSERT_EQ(OB_SUCCESS, ctx2.key_ranges_.push_back(range));
+  filter2.set_valid(true);
+  CALL(check_unchanged, ctx2, filter2);
+}
+
+TEST_F(TestHTableKeyRange, time_range)
+{
+  ObNewRange range;
+  CALL(make_row_range, "row1", range);
+  {
+    // cells with timestamp in [10, 20), T = -timestamp in [-19, -10]
+    ObTableCtx ctx(allocator_);
+    ObHTableFilter filter;
+    init_ctx(ctx, table_schema_);
+    ASSERT_EQ(OB_SUCCESS, ctx.key_ranges_.push_back(range));
+    filter.set_valid(true);
+    ASSERT_EQ(OB_SUCCESS, filter.add_column(ObString::make_string("q1")));
+    ASSERT_EQ(OB_SUCCESS, filter.add_column(ObString::make_string("q2")));
+    ASSERT_EQ(OB_SUCCESS, filter.set_time_range(10, 20));
+    ASSERT_EQ(OB_SUCCESS, ctx.narrow_htable_key_ranges(filter));
+    ASSERT_EQ(2, ctx.key_ranges_.count());
+    CALL(check_range, ctx.key_ranges_.at(0), "row1", "q1", -19, -10, false);
+    CALL(check_range, ctx.key_ranges_.at(1), "row1", "q2", -19, -10, false);
+  }
+  {
+    // single version
+    ObTableCtx ctx(allocator_);
+    ObHTableFilter filter;
+    init_ctx(ctx, table_schema_);
+    ASSERT_EQ(OB_SUCCESS, ctx.key_ranges_.push_back(range));
+    filter.set_valid(true);
+    ASSERT_EQ(OB_SUCCESS, filter.add_column(ObString::make_string("q1")));
+    ASSERT_EQ(OB_SUCCESS, filter.set_timestamp(15));
+    ASSERT_EQ(OB_SUCCESS, ctx.narrow_htable_key_ranges(filter));
+    ASSERT_EQ(1, ctx.key_ranges_.count());
+    CALL(check_range, ctx.key_ranges_.at(0), "row1", "q1", -15, -15, false);
+  }
+  {
+    // open ended, [5, MAX)
+    ObTableCtx ctx(allocator_);
+    ObHTableFilter filter;
+    init_ctx(ctx, table_schema_);
+    ASSERT_EQ(OB_SUCCESS, ctx.key_ranges_.push_back(range));
+    filter.set_valid(true);
+    ASSERT_EQ(OB_SUCCESS, filter.add_column(ObString::make_string("q1")));
+    ASSERT_EQ(OB_SUCCESS, filter.set_time_range(5, INT64_MAX));
+    ASSERT_EQ(OB_SUCCESS, ctx.narrow_htable_key_ranges(filter));
+    ASSERT_EQ(1, ctx.key_ranges_.count());
+    CALL(check_range, ctx.key_ranges_.at(0), "row1", "q1", 1 - INT64_MAX, -5, false);
+  }
+}
+
+TEST_F(TestHTableKeyRange, reversed_scan)
+{
+  ObTableCtx ctx(allocator_);
+  ObHTableFilter filter;
+  ObNewRange range;
+  init_ctx(ctx, table_schema_);
+  // only forward scans are narrowed, reversed scans keep the whole row range
+  ctx.scan_order_ = ObQueryFlag::Reverse;
+  CALL(make_row_range, "row1", range);
+  ASSERT_EQ(OB_SUCCESS, ctx.key_ranges_.push_back(range));
+  filter.set_valid(true);
+  ASSERT_EQ(OB_SUCCESS, filter.add_column(ObString::make_string("a")));
+  ASSERT_EQ(OB_SUCCESS, filter.add_column(ObString::make_string("b")));
+  ASSERT_EQ(OB_SUCCESS, filter.set_time_range(10, 20));
+  CALL(check_unchanged, ctx, filter);
+}
+
+TEST_F(TestHTableKeyRange, not_narrowed)
+{
+  ObNewRange row_range;
+  ObNewRange scan_range;
+  ObHTableFilter filter;
+  CALL(make_row_range, "row1", row_range);
+  CALL(make_scan_range, "row2", "row5", scan_range);
+  filter.set_valid(true);
+  ASSERT_EQ(OB_SUCCESS, filter.add_column(ObString::make_string("a")));
+  {
+    // multi-row scan range is kept, the single row range beside it is narrowed
+    ObTableCtx ctx(allocator_);
+    init_ctx(ctx, table_schema_);
+    ASSERT_EQ(OB_SUCCESS, ctx.key_ranges_.push_back(scan_range));
+    ASSERT_EQ(OB_SUCCESS, ctx.key_ranges_.push_back(row_range));
+    ASSERT_EQ(OB_SUCCESS, ctx.narrow_htable_key_ranges(filter));
+    ASSERT_EQ(2, ctx.key_ranges_.count());
+    ASSERT_TRUE(scan_range == ctx.key_ranges_.at(0));
+    CALL(check_range, ctx.key_ranges_.at(1), "row1", "a", 0, 0, true);
+  }
+  {
+    // index scan
+    ObTableCtx ctx(allocator_);
+    init_ctx(ctx, table_schema_);
+    ctx.is_index_scan_ = true;
+    ASSERT_EQ(OB_SUCCESS, ctx.key_ranges_.push_back(row_range));
+    CALL(check_unchanged, ctx, filter);
+  }
+  {
+    // qualifier not in binary order
+    ObTableSchema ci_schema;
+    ObColumnSchemaV2 ci_columns[4];
+    CALL(create_htable_schema, ci_schema, ci_columns, CS_TYPE_UTF8MB4_GENERAL_CI);
+    ObTableCtx ctx(allocator_);
+    init_ctx(ctx, ci_schema);
+    ASSERT_EQ(OB_SUCCESS, ctx.key_ranges_.push_back(row_range));
+    CALL(check_unchanged, ctx, filter);
+  }
+  {
+    // empty time range
+    ObTableCtx ctx(allocator_);
+    ObHTableFilter empty_filter;
+    init_ctx(ctx, table_schema_);
+    ASSERT_EQ(OB_SUCCESS, ctx.key_ranges_.push_back(row_range));
+    empty_filter.set_valid(true);
+    ASSERT_EQ(OB_SUCCESS, empty_filter.add_column(ObString::make_string("a")));
+    empty_filter.min_stamp_ = 20;
+    empty_filter.max_stamp_ = 20;
+    CALL(check_unchanged, ctx, empty_filter);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  OB_LOGGER.set_file_name("test_htable_key_range.log", true);
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
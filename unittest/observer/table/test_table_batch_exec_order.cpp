@@ -0,0 +1,250 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "observer/table/ob_table_batch_execute_processor.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::share;
+using namespace oceanbase::observer;
+using namespace oceanbase::table;
+
+typedef ObTableBatchExecuteP::BatchOpLocation BatchOpLocation;
+
+class TestTableBatchExecOrder : public ::testing::Test
+{
+public:
+  TestTableBatchExecOrder() {}
+  virtual ~TestTableBatchExecOrder() {}
+  virtual void SetUp() { exec_order_.reset(); }
+  virtual void TearDown() {}
+
+  // the i-th operation of the batch goes to tablet @tablets[i] of log stream @ls_ids[i]
+  void build(const int64_t count, const int64_t *tablets, const int64_t *ls_ids)
+  {
+    for (int64_t i = 0; i < count; i++) {
+      BatchOpLocation op_loc;
+      op_loc.idx_ = i;
+      op_loc.tablet_id_ = ObTabletID(tablets[i]);
+      op_loc.ls_id_ = ObLSID(ls_ids[i]);
+      ASSERT_EQ(OB_SUCCESS, exec_order_.push_back(op_loc));
+    }
+    std::sort(exec_order_.get_data(), exec_order_.get_data() + exec_order_.count());
+  }
+
+  // every operation is executed exactly once, grouped by log stream and tablet, and the
+  // operations of one tablet keep their request order
+  void check_order(const int64_t count)
+  {
+    ASSERT_EQ(count, exec_order_.count());
+    ObSEArray<bool, 16> executed;
+    for (int64_t i = 0; i < count; i++) {
+      ASSERT_EQ(OB_SUCCESS, executed.push_back(false));
+    }
+    for (int64_t k = 0; k < count; k++) {
+      const BatchOpLocation &op_loc = exec_order_.at(k);
+      ASSERT_FALSE(executed.at(op_loc.idx_));
+      executed.at(op_loc.idx_) = true;
+      if (k > 0) {
+        const BatchOpLocation &prev = exec_order_.at(k - 1);
+        ASSERT_LE(prev.ls_id_.id(), op_loc.ls_id_.id());
+        if (prev.ls_id_ == op_loc.ls_id_) {
+          ASSERT_LE(prev.tablet_id_.id(), op_loc.tablet_id_.id());
+          if (prev.tablet_id_ == op_loc.tablet_id_) {
+            ASSERT_LT(prev.idx_, op_loc.idx_);
+          }
+        }
+      }
+    }
+  }
+
+  // @return the number of tablet groups, each group is one tablet
+  int64_t group_count()
+  {
+    int64_t cnt = 0;
+    for (int64_t start = 0, end = 0; start < exec_order_.count(); start = end) {
+      end = ObTableBatchExecuteP::get_tablet_group_end(exec_order_, start);
+      EXPECT_LT(start, end);
+      for (int64_t k = start; k < end; k++) {
+        EXPECT_EQ(exec_order_.at(start).tablet_id_, exec_order_.at(k).tablet_id_);
+      }
+      if (end < exec_order_.count()) {
+        EXPECT_NE(exec_order_.at(start).tablet_id_, exec_order_.at(end).tablet_id_);
+      }
+      cnt++;
+    }
+    return cnt;
+  }
+
+  // runs the tablet groups as multi_tablet_write does. Each group gets a new spec, the spec
+  // used by each operation and the order the operations run in are recorded. The operation
+  // @fail_idx reports @fail_errno in its result.
+  int run_groups(const int64_t count, const bool is_atomic, const int64_t fail_idx, const int fail_errno)
+  {
+    int ret = OB_SUCCESS;
+    get_spec_idxs_.reset();
+    run_idxs_.reset();
+    result_.reset();
+    for (int64_t i = 0; i < MAX_OP_CNT; i++) {
+      op_specs_[i] = nullptr;
+    }
+    auto get_spec = [&](const int64_t idx, ObTableApiSpec *&spec) -> int {
+      spec = reinterpret_cast<ObTableApiSpec *>(&specs_[get_spec_idxs_.count()]);
+      return get_spec_idxs_.push_back(idx);
+    };
+    auto process_op = [&](const int64_t idx, ObTableApiSpec *spec, ObTableOperationResult &op_result) -> int {
+      op_specs_[idx] = spec;
+      op_result.set_affected_rows(idx + 1);
+      op_result.set_errno(fail_idx == idx ? fail_errno : OB_SUCCESS);
+      return run_idxs_.push_back(idx);
+    };
+    ret = result_.prepare_allocate(count);
+    for (int64_t start = 0, end = 0; OB_SUCC(ret) && start < exec_order_.count(); start = end) {
+      end = ObTableBatchExecuteP::get_tablet_group_end(exec_order_, start);
+      ret = ObTableBatchExecuteP::process_tablet_group(exec_order_, start, end, is_atomic,
+                                                       get_spec, process_op, result_);
+    }
+    return ret;
+  }
+
+protected:
+  static const int64_t MAX_OP_CNT = 16;
+  ObSEArray<BatchOpLocation, 16> exec_order_;
+  int64_t specs_[MAX_OP_CNT];
+  ObSEArray<int64_t, 16> get_spec_idxs_;
+  ObSEArray<int64_t, 16> run_idxs_;
+  ObTableApiSpec *op_specs_[MAX_OP_CNT];
+  ObTableBatchOperationResult result_;
+};
+
+#define CALL(func, ...) func(__VA_ARGS__); ASSERT_FALSE(HasFatalFailure());
+
+TEST_F(TestTableBatchExecOrder, single_tablet)
+{
+  const int64_t tablets[] = {200001, 200001, 200001, 200001};
+  const int64_t ls_ids[] = {1001, 1001, 1001, 1001};
+  CALL(build, 4, tablets, ls_ids);
+  CALL(check_order, 4);
+  ASSERT_EQ(1, group_count());
+  for (int64_t k = 0; k < 4; k++) {
+    ASSERT_EQ(k, exec_order_.at(k).idx_);
+  }
+}
+
+TEST_F(TestTableBatchExecOrder, tablets_in_one_ls)
+{
+  // interleaved operations on 3 tablets are executed as 3 groups
+  const int64_t tablets[] = {200003, 200001, 200002, 200001, 200003, 200002, 200001};
+  const int64_t ls_ids[] = {1001, 1001, 1001, 1001, 1001, 1001, 1001};
+  CALL(build, 7, tablets, ls_ids);
+  CALL(check_order, 7);
+  ASSERT_EQ(3, group_count());
+  const int64_t expect[] = {1, 3, 6, 2, 5, 0, 4};
+  for (int64_t k = 0; k < 7; k++) {
+    ASSERT_EQ(expect[k], exec_order_.at(k).idx_);
+  }
+}
+
+TEST_F(TestTableBatchExecOrder, tablets_across_ls)
+{
+  // tablets are grouped under their log stream, not by the tablet id alone
+  const int64_t tablets[] = {200001, 200004, 200002, 200001, 200003, 200004, 200002, 200003};
+  const int64_t ls_ids[] = {1002, 1001, 1002, 1002, 1001, 1001, 1002, 1001};
+  CALL(build, 8, tablets, ls_ids);
+  CALL(check_order, 8);
+  ASSERT_EQ(4, group_count());
+  const int64_t expect[] = {4, 7, 1, 5, 0, 3, 2, 6};
+  for (int64_t k = 0; k < 8; k++) {
+    ASSERT_EQ(expect[k], exec_order_.at(k).idx_);
+  }
+}
+
+TEST_F(TestTableBatchExecOrder, same_row)
+{
+  // insert, delete and insert again of one row are in one tablet and keep their order
+  const int64_t tablets[] = {200002, 200001, 200002, 200001, 200002};
+  const int64_t ls_ids[] = {1001, 1002, 1001, 1002, 1001};
+  CALL(build, 5, tablets, ls_ids);
+  CALL(check_order, 5);
+  ASSERT_EQ(2, group_count());
+  ASSERT_EQ(0, exec_order_.at(0).idx_);
+  ASSERT_EQ(2, exec_order_.at(1).idx_);
+  ASSERT_EQ(4, exec_order_.at(2).idx_);
+  ASSERT_EQ(1, exec_order_.at(3).idx_);
+  ASSERT_EQ(3, exec_order_.at(4).idx_);
+}
+
+TEST_F(TestTableBatchExecOrder, shared_spec_per_tablet_group)
+{
+  // interleaved operations on 3 tablets of 2 log streams
+  const int64_t tablets[] = {200003, 200001, 200002, 200001, 200003, 200002, 200001, 200003, 200002};
+  const int64_t ls_ids[] = {1002, 1001, 1001, 1001, 1002, 1001, 1001, 1002, 1001};
+  const int64_t count = 9;
+  CALL(build, count, tablets, ls_ids);
+  ASSERT_EQ(OB_SUCCESS, run_groups(count, true, -1, OB_SUCCESS));
+  // one spec for each tablet, got with the first operation of the tablet
+  ASSERT_EQ(3, get_spec_idxs_.count());
+  ASSERT_EQ(1, get_spec_idxs_.at(0));
+  ASSERT_EQ(2, get_spec_idxs_.at(1));
+  ASSERT_EQ(0, get_spec_idxs_.at(2));
+  for (int64_t i = 0; i < count; i++) {
+    ASSERT_TRUE(nullptr != op_specs_[i]);
+    for (int64_t j = 0; j < count; j++) {
+      ASSERT_EQ(tablets[i] == tablets[j], op_specs_[i] == op_specs_[j]);
+    }
+  }
+  // operations run grouped by tablet, results are in request order
+  const int64_t expect[] = {1, 3, 6, 2, 5, 8, 0, 4, 7};
+  ASSERT_EQ(count, run_idxs_.count());
+  for (int64_t k = 0; k < count; k++) {
+    ASSERT_EQ(expect[k], run_idxs_.at(k));
+  }
+  ASSERT_EQ(count, result_.count());
+  for (int64_t i = 0; i < count; i++) {
+    ASSERT_EQ(OB_SUCCESS, result_.at(i).get_errno());
+    ASSERT_EQ(i + 1, result_.at(i).get_affected_rows());
+  }
+}
+
+TEST_F(TestTableBatchExecOrder, failed_op_in_tablet_group)
+{
+  const int64_t tablets[] = {200003, 200001, 200002, 200001, 200003, 200002, 200001};
+  const int64_t ls_ids[] = {1001, 1001, 1001, 1001, 1001, 1001, 1001};
+  const int64_t count = 7;
+  CALL(build, count, tablets, ls_ids);
+  // an atomic batch stops at the failed operation
+  ASSERT_EQ(OB_ERR_PRIMARY_KEY_DUPLICATE, run_groups(count, true, 3, OB_ERR_PRIMARY_KEY_DUPLICATE));
+  ASSERT_EQ(1, get_spec_idxs_.count());
+  ASSERT_EQ(2, run_idxs_.count());
+  ASSERT_EQ(1, run_idxs_.at(0));
+  ASSERT_EQ(3, run_idxs_.at(1));
+  ASSERT_EQ(OB_ERR_PRIMARY_KEY_DUPLICATE, result_.at(3).get_errno());
+  ASSERT_TRUE(nullptr == op_specs_[6]);
+  // otherwise the error is only returned in the result of the operation
+  ASSERT_EQ(OB_SUCCESS, run_groups(count, false, 3, OB_ERR_PRIMARY_KEY_DUPLICATE));
+  ASSERT_EQ(3, get_spec_idxs_.count());
+  ASSERT_EQ(count, run_idxs_.count());
+  for (int64_t i = 0; i < count; i++) {
+    ASSERT_EQ(3 == i ? OB_ERR_PRIMARY_KEY_DUPLICATE : OB_SUCCESS, result_.at(i).get_errno());
+    ASSERT_EQ(i + 1, result_.at(i).get_affected_rows());
+  }
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  OB_LOGGER.set_file_name("test_table_batch_exec_order.log", true);
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
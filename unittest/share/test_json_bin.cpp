@@ -1664,6 +1664,233 @@ TEST_F(TestJsonBin, test_double_nan)
       ObJsonInType::JSON_BIN, new_bin));
 }
 
+// parse text to binary through json tree, the way before ObJsonParser::get_bin
+static int get_bin_by_tree(ObIAllocator *allocator, const ObString &j_text, ObString &j_bin)
+{
+  INIT_SUCC(ret);
+  ObJsonNode *j_tree = NULL;
+  ObJsonBin *bin = NULL;
+  void *buf = allocator->alloc(sizeof(ObJsonBin));
+  if (OB_ISNULL(buf)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else if (FALSE_IT(bin = new (buf) ObJsonBin(allocator))) {
+  } else if (OB_FAIL(ObJsonParser::get_tree(allocator, j_text, j_tree))) {
+  } else if (OB_FAIL(bin->parse_tree(j_tree))) {
+  } else {
+    ret = bin->get_raw_binary(j_bin, allocator);
+  }
+  return ret;
+}
+
+static void check_text_to_bin(ObIAllocator *allocator, const char *text)
+{
+  ObString j_text(text);
+  ObString tree_bin;
+  ObString direct_bin;
+  ASSERT_EQ(OB_SUCCESS, get_bin_by_tree(allocator, j_text, tree_bin));
+  ASSERT_EQ(OB_SUCCESS, ObJsonParser::get_bin(allocator, j_text, direct_bin));
+
+  ObJsonBin tree_j_bin(tree_bin.ptr(), tree_bin.length(), allocator);
+  ObJsonBin direct_j_bin(direct_bin.ptr(), direct_bin.length(), allocator);
+  ASSERT_EQ(OB_SUCCESS, tree_j_bin.reset_iter());
+  ASSERT_EQ(OB_SUCCESS, direct_j_bin.reset_iter());
+  ObJsonBuffer tree_str(allocator);
+  ObJsonBuffer direct_str(allocator);
+  ASSERT_EQ(OB_SUCCESS, tree_j_bin.print(tree_str, true));
+  ASSERT_EQ(OB_SUCCESS, direct_j_bin.print(direct_str, true));
+  ASSERT_EQ(std::string(tree_str.ptr(), tree_str.length()), std::string(direct_str.ptr(), direct_str.length()));
+  int res = -1;
+  ASSERT_EQ(OB_SUCCESS, tree_j_bin.compare(direct_j_bin, res));
+  ASSERT_EQ(0, res);
+
+  // obj size of container is the whole binary
+  if (direct_j_bin.json_type() == ObJsonNodeType::J_OBJECT ||
+      direct_j_bin.json_type() == ObJsonNodeType::J_ARRAY) {
+    uint64_t used_size = 0;
+    ASSERT_EQ(OB_SUCCESS, direct_j_bin.get_use_size(used_size));
+    ASSERT_EQ(used_size, direct_bin.length());
+  }
+}
+
+TEST_F(TestJsonBin, text_to_bin_direct)
+{
+  ObArenaAllocator allocator(ObModIds::TEST);
+  check_text_to_bin(&allocator, "null");
+  check_text_to_bin(&allocator, "true");
+  check_text_to_bin(&allocator, "-12345678901");
+  check_text_to_bin(&allocator, "18446744073709551615");
+  check_text_to_bin(&allocator, "1.5e10");
+  check_text_to_bin(&allocator, "\"greeting\"");
+  check_text_to_bin(&allocator, "{}");
+  check_text_to_bin(&allocator, "[]");
+  check_text_to_bin(&allocator, "[\"greeting\", 1.1, 2, -10, 300, -40000, 3000000000, true, false, null]");
+  check_text_to_bin(&allocator, "{\"zz\": 1, \"a\": [1, {\"b\": null, \"aa\": \"x\"}], \"b\": {}, \"\": []}");
+  // the last value wins for duplicate keys
+  check_text_to_bin(&allocator, "{\"a\": 1, \"b\": 2, \"a\": {\"c\": 3}, \"b\": [4]}");
+  check_text_to_bin(&allocator, "[[[[[[[[[[1]]]]]]]]], {\"a\": {\"a\": {\"a\": {\"a\": 1}}}}]");
+
+  // entry size grows with container size
+  std::string large_text("{");
+  for (int64_t i = 0; i < 5000; i++) {
+    if (i > 0) {
+      large_text.append(",");
+    }
+    large_text.append("\"key_" + std::to_string(i) + "\": [" + std::to_string(i * 100) + ", \"value\"]");
+  }
+  large_text.append("}");
+  check_text_to_bin(&allocator, large_text.c_str());
+}
+
+TEST_F(TestJsonBin, text_to_bin_unique_key)
+{
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObString j_text("{\"a\": 1, \"b\": {\"c\": 2, \"c\": 3}}");
+  ObString j_bin;
+  ASSERT_EQ(OB_ERR_DUPLICATE_KEY, ObJsonParser::get_bin(&allocator, j_text, j_bin,
+                                                        ObJsonParser::JSN_UNIQUE_FLAG));
+  ASSERT_EQ(OB_SUCCESS, ObJsonParser::get_bin(&allocator, j_text, j_bin));
+  ASSERT_EQ(OB_ERR_INVALID_JSON_TEXT, ObJsonParser::get_bin(&allocator, ObString("{\"a\": }"), j_bin));
+
+  // binary from get_json_base can be updated as before
+  ObIJsonBase *j_base = NULL;
+  ObIJsonBase *j_new = NULL;
+  ASSERT_EQ(OB_SUCCESS, ObJsonBaseFactory::get_json_base(&allocator, j_text,
+      ObJsonInType::JSON_TREE, ObJsonInType::JSON_BIN, j_base));
+  ASSERT_EQ(OB_SUCCESS, ObJsonBaseFactory::get_json_base(&allocator, ObString("[1, 2]"),
+      ObJsonInType::JSON_TREE, ObJsonInType::JSON_BIN, j_new));
+  ASSERT_EQ(OB_SUCCESS, j_base->object_add(ObString("d"), j_new));
+  ObJsonBuffer j_str(&allocator);
+  ASSERT_EQ(OB_SUCCESS, j_base->print(j_str, true));
+  ASSERT_EQ(std::string("{\"a\": 1, \"b\": {\"c\": 3}, \"d\": [1, 2]}"), std::string(j_str.ptr(), j_str.length()));
+}
+
+TEST_F(TestJsonBin, bin_builder_append_binary)
+{
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObString j_text("[{\"a\": 1, \"b\": \"x\"}, {\"a\": [1, 2]}, {\"a\": 2.5}, {\"a\": -300}, {\"a\": null}]");
+  ObIJsonBase *j_bin = NULL;
+  ASSERT_EQ(OB_SUCCESS, ObJsonBaseFactory::get_json_base(&allocator, j_text,
+      ObJsonInType::JSON_TREE, ObJsonInType::JSON_BIN, j_bin));
+  ObJsonPath j_path(ObString("$[*].a"), &allocator);
+  ASSERT_EQ(OB_SUCCESS, j_path.parse_path());
+  ObJsonBaseVector hit;
+  ASSERT_EQ(OB_SUCCESS, j_bin->seek(j_path, j_path.path_node_cnt(), true, false, hit));
+  ASSERT_EQ(5, hit.size());
+
+  ObJsonBinBuilder builder(&allocator);
+  ObString result;
+  ASSERT_EQ(OB_SUCCESS, builder.start_array());
+  for (int64_t i = 0; i < hit.size(); i++) {
+    ASSERT_TRUE(hit[i]->is_bin());
+    ASSERT_EQ(OB_SUCCESS, builder.append_binary(*static_cast<ObJsonBin *>(hit[i])));
+  }
+  ASSERT_EQ(OB_SUCCESS, builder.end_array());
+  ASSERT_EQ(OB_SUCCESS, builder.get_result(result));
+
+  ObJsonBin res_bin(result.ptr(), result.length(), &allocator);
+  ASSERT_EQ(OB_SUCCESS, res_bin.reset_iter());
+  ObJsonBuffer j_str(&allocator);
+  ASSERT_EQ(OB_SUCCESS, res_bin.print(j_str, true));
+  ASSERT_EQ(std::string("[1, [1, 2], 2.5, -300, null]"), std::string(j_str.ptr(), j_str.length()));
+
+  // builder events out of order
+  builder.reuse();
+  ASSERT_NE(OB_SUCCESS, builder.set_key("a", 1));
+  ASSERT_EQ(OB_SUCCESS, builder.start_object());
+  ASSERT_NE(OB_SUCCESS, builder.append_int(1));
+  ASSERT_NE(OB_SUCCESS, builder.end_array());
+  ASSERT_NE(OB_SUCCESS, builder.get_result(result));
+}
+
+// documents of [count] items, about 100 bytes per item
+static void gen_bench_doc(int64_t count, std::string &doc)
+{
+  doc.assign("{\"id\": 1, \"items\": [");
+  for (int64_t i = 0; i < count; i++) {
+    if (i > 0) {
+      doc.append(", ");
+    }
+    doc.append("{\"name\": \"item_" + std::to_string(i) + "\", \"price\": " + std::to_string(i * 3.5)
+               + ", \"qty\": " + std::to_string(i % 1000) + ", \"tags\": [\"a\", \"b\"], \"ok\": true}");
+  }
+  doc.append("]}");
+}
+
+// Insert throughput of json text to binary, through json tree and in one pass,
+// and extract throughput of multi-hit path, with hits transformed to tree and copied in binary.
+TEST_F(TestJsonBin, text_to_bin_benchmark)
+{
+  const int64_t item_counts[] = {10, 100, 1000};
+  const int64_t total_bytes = 16L << 20;
+  for (int64_t c = 0; c < ARRAYSIZEOF(item_counts); c++) {
+    std::string doc;
+    gen_bench_doc(item_counts[c], doc);
+    ObString j_text(doc.length(), doc.c_str());
+    const int64_t loops = std::max(1L, total_bytes / static_cast<int64_t>(doc.length()));
+    ObArenaAllocator allocator(ObModIds::TEST);
+    ObString j_bin;
+    long tree_ms = 0;
+    long direct_ms = 0;
+
+    long start = getCurrentTime();
+    for (int64_t i = 0; i < loops; i++) {
+      ASSERT_EQ(OB_SUCCESS, get_bin_by_tree(&allocator, j_text, j_bin));
+      allocator.reuse();
+    }
+    tree_ms = std::max(1L, getCurrentTime() - start);
+    start = getCurrentTime();
+    for (int64_t i = 0; i < loops; i++) {
+      ASSERT_EQ(OB_SUCCESS, ObJsonParser::get_bin(&allocator, j_text, j_bin));
+      allocator.reuse();
+    }
+    direct_ms = std::max(1L, getCurrentTime() - start);
+    fprintf(stdout, "[bench] insert doc_size=%ld loops=%ld tree=%.1fMB/s direct=%.1fMB/s\n",
+            doc.length(), loops, (double)doc.length() * loops / 1024 / 1024 * 1000 / tree_ms,
+            (double)doc.length() * loops / 1024 / 1024 * 1000 / direct_ms);
+
+    // extract $.items[*].name
+    ObArenaAllocator bin_allocator(ObModIds::TEST);
+    ASSERT_EQ(OB_SUCCESS, ObJsonParser::get_bin(&bin_allocator, j_text, j_bin));
+    ObJsonPath j_path(ObString("$.items[*].name"), &bin_allocator);
+    ASSERT_EQ(OB_SUCCESS, j_path.parse_path());
+    long tree_extract_ms = 0;
+    long bin_extract_ms = 0;
+    for (int64_t mode = 0; mode < 2; mode++) {
+      start = getCurrentTime();
+      for (int64_t i = 0; i < loops; i++) {
+        ObJsonBin j_base(j_bin.ptr(), j_bin.length(), &allocator);
+        ObJsonBaseVector hit;
+        ObString result;
+        ASSERT_EQ(OB_SUCCESS, j_base.reset_iter());
+        ASSERT_EQ(OB_SUCCESS, j_base.seek(j_path, j_path.path_node_cnt(), true, false, hit));
+        ASSERT_EQ(item_counts[c], hit.size());
+        if (mode == 0) {
+          ObJsonArray j_arr(&allocator);
+          for (int64_t h = 0; h < hit.size(); h++) {
+            ObIJsonBase *jb_node = NULL;
+            ASSERT_EQ(OB_SUCCESS, ObJsonBaseFactory::transform(&allocator, hit[h], ObJsonInType::JSON_TREE, jb_node));
+            ASSERT_EQ(OB_SUCCESS, j_arr.array_append(static_cast<ObJsonNode *>(jb_node)->clone(&allocator)));
+          }
+          ASSERT_EQ(OB_SUCCESS, j_arr.get_raw_binary(result, &allocator));
+        } else {
+          ObJsonBinBuilder builder(&allocator);
+          ASSERT_EQ(OB_SUCCESS, builder.start_array());
+          for (int64_t h = 0; h < hit.size(); h++) {
+            ASSERT_EQ(OB_SUCCESS, builder.append_binary(*static_cast<ObJsonBin *>(hit[h])));
+          }
+          ASSERT_EQ(OB_SUCCESS, builder.end_array());
+          ASSERT_EQ(OB_SUCCESS, builder.get_result(result));
+        }
+        allocator.reuse();
+      }
+      (mode == 0 ? tree_extract_ms : bin_extract_ms) = std::max(1L, getCurrentTime() - start);
+    }
+    fprintf(stdout, "[bench] extract doc_size=%ld hits=%ld tree=%.0f/s binary=%.0f/s\n",
+            doc.length(), item_counts[c], (double)loops * 1000 / tree_extract_ms,
+            (double)loops * 1000 / bin_extract_ms);
+  }
+}
+
 } // namespace common
 } // namespace oceanbase
 
@@ -910,6 +910,39 @@ TEST_F(TestChunkDatumStore, test_only_disk_data)
   rs.reset();
 }
 
+TEST_F(TestChunkDatumStore, test_compressed_disk_data)
+{
+  int64_t cnt = 10000;
+  ObChunkDatumStore raw_rs;
+  ASSERT_EQ(OB_SUCCESS, raw_rs.init(0, tenant_id_, ctx_id_, label_));
+  ASSERT_EQ(OB_SUCCESS, raw_rs.alloc_dir_id());
+  raw_rs.set_mem_limit(1L << 30);
+  CALL(append_rows, raw_rs, cnt);
+  ASSERT_EQ(OB_SUCCESS, raw_rs.dump(false, true));
+  raw_rs.finish_add_row();
+
+  ObChunkDatumStore rs;
+  ObChunkDatumStore::Iterator it;
+  ASSERT_EQ(OB_SUCCESS, rs.init(0, tenant_id_, ctx_id_, label_));
+  ASSERT_EQ(OB_SUCCESS, rs.set_dump_compressor(LZ4_COMPRESSOR));
+  ASSERT_EQ(OB_SUCCESS, rs.alloc_dir_id());
+  rs.set_mem_limit(1L << 30);
+  CALL(append_rows, rs, cnt);
+  ASSERT_EQ(OB_SUCCESS, rs.dump(false, true));
+  // compressor can not be changed after dumped
+  ASSERT_NE(OB_SUCCESS, rs.set_dump_compressor(NONE_COMPRESSOR));
+  rs.finish_add_row();
+  LOG_INFO("compressed file size", K(raw_rs.get_file_size()), K(rs.get_file_size()));
+  ASSERT_LT(rs.get_file_size(), raw_rs.get_file_size());
+
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, 16L << 20);
+  it.reset();
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, ObChunkDatumStore::BLOCK_SIZE);
+  it.reset();
+  rs.reset();
+  raw_rs.reset();
+}
+
 TEST_F(TestChunkDatumStore, test_only_disk_data1)
 {
   int64_t round = 2;
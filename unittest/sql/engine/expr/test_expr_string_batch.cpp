@@ -0,0 +1,633 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "sql/engine/expr/ob_expr_lower.h"
+#include "sql/engine/expr/ob_expr_trim.h"
+#include "sql/engine/expr/ob_expr_concat.h"
+#include "sql/engine/expr/ob_expr_date_format.h"
+#include "sql/engine/expr/ob_expr_regexp_like.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "sql/ob_sql_init.h"
+#include "share/system_variable/ob_system_variable.h"
+#include "lib/timezone/ob_time_convert.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+#define CALL(func, ...) func(__VA_ARGS__); ASSERT_FALSE(HasFatalFailure());
+
+// The batch evaluators of lower/upper, trim, concat, date_format and regexp_like must give the
+// same results as the row evaluators. Each case evaluates two exprs over the same args: one by
+// eval_batch() and the other row by row, and compares the results of rows not skipped.
+class TestExprStringBatch : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 16;
+  static const int64_t MAX_EXPR_CNT = 64;
+  static const int64_t RES_BUF_LEN = 64;
+  static const int64_t BENCH_ROW_CNT = 1000000;
+
+  TestExprStringBatch() : exec_ctx_(alloc_), eval_ctx_(exec_ctx_), skip_(NULL), expr_cnt_(0) {}
+
+  virtual void SetUp() override
+  {
+    ObString tenant_name("test");
+    ASSERT_EQ(OB_SUCCESS, session_.test_init(0, 0, 0, NULL));
+    ASSERT_EQ(OB_SUCCESS, ObPreProcessSysVars::init_sys_var());
+    ASSERT_EQ(OB_SUCCESS, session_.load_default_sys_variable(false, true));
+    ASSERT_EQ(OB_SUCCESS, session_.init_tenant(tenant_name, OB_SYS_TENANT_ID));
+    exec_ctx_.set_my_session(&session_);
+    ASSERT_EQ(OB_SUCCESS, exec_ctx_.create_physical_plan_ctx());
+    ASSERT_EQ(OB_SUCCESS, exec_ctx_.init_expr_op(MAX_EXPR_CNT));
+    eval_ctx_.set_max_batch_size(BATCH_SIZE);
+    eval_ctx_.frames_ = static_cast<char **>(alloc_.alloc(sizeof(char *) * MAX_EXPR_CNT));
+    ASSERT_TRUE(NULL != eval_ctx_.frames_);
+    skip_ = to_bit_vector(alloc_.alloc(ObBitVector::memory_size(BATCH_SIZE)));
+    ASSERT_TRUE(NULL != skip_);
+    skip_->reset(BATCH_SIZE);
+  }
+
+  // Every expr has its own frame, laid out as the code generator does for batch result exprs.
+  ObExpr *new_expr(const ObObjType type, const ObCollationType cs_type, const bool batch_result)
+  {
+    ObExpr *expr = NULL;
+    const int64_t datum_cnt = batch_result ? BATCH_SIZE : 1;
+    const int64_t frame_size = sizeof(ObDatum) * datum_cnt + sizeof(ObEvalInfo)
+        + ObBitVector::memory_size(datum_cnt) + sizeof(ObDynReserveBuf) * datum_cnt
+        + RES_BUF_LEN * datum_cnt;
+    char *frame = static_cast<char *>(alloc_.alloc(frame_size));
+    if (expr_cnt_ < MAX_EXPR_CNT && NULL != frame) {
+      memset(frame, 0, frame_size);
+      eval_ctx_.frames_[expr_cnt_] = frame;
+      expr = new (alloc_.alloc(sizeof(ObExpr))) ObExpr();
+      int64_t pos = 0;
+      expr->frame_idx_ = static_cast<uint32_t>(expr_cnt_++);
+      expr->datum_off_ = static_cast<uint32_t>(pos);
+      pos += sizeof(ObDatum) * datum_cnt;
+      expr->eval_info_off_ = static_cast<uint32_t>(pos);
+      pos += sizeof(ObEvalInfo);
+      expr->eval_flags_off_ = static_cast<uint32_t>(pos);
+      pos += ObBitVector::memory_size(datum_cnt);
+      expr->dyn_buf_header_offset_ = static_cast<uint32_t>(pos);
+      pos += sizeof(ObDynReserveBuf) * datum_cnt;
+      expr->res_buf_off_ = static_cast<uint32_t>(pos);
+      expr->res_buf_len_ = RES_BUF_LEN;
+      expr->batch_result_ = batch_result;
+      expr->batch_idx_mask_ = batch_result ? UINT64_MAX : 0;
+      expr->datum_meta_.type_ = type;
+      expr->datum_meta_.cs_type_ = cs_type;
+      expr->obj_meta_.set_type(type);
+      expr->obj_meta_.set_collation_type(cs_type);
+    }
+    return expr;
+  }
+
+  // Create the batch evaluated and the row evaluated exprs of the same function over @args.
+  void new_func_exprs(const ObExprOperatorType type, const ObObjType res_type,
+                      const ObCollationType cs_type, ObExpr::EvalFunc row_func,
+                      ObExpr::EvalBatchFunc batch_func, ObExpr **args, const int64_t arg_cnt,
+                      ObExpr *&batch_expr, ObExpr *&row_expr)
+  {
+    ObExpr *exprs[2] = { NULL, NULL };
+    for (int64_t i = 0; i < 2; i++) {
+      exprs[i] = new_expr(res_type, cs_type, true);
+      ASSERT_TRUE(NULL != exprs[i]);
+      exprs[i]->type_ = type;
+      exprs[i]->args_ = args;
+      exprs[i]->arg_cnt_ = static_cast<uint32_t>(arg_cnt);
+      exprs[i]->eval_func_ = row_func;
+      exprs[i]->eval_batch_func_ = batch_func;
+      exprs[i]->is_called_in_sql_ = 1;
+    }
+    batch_expr = exprs[0];
+    row_expr = exprs[1];
+  }
+
+  void set_str(ObExpr *expr, const int64_t idx, const char *str)
+  {
+    expr->locate_batch_datums(eval_ctx_)[idx].set_string(str, static_cast<int32_t>(strlen(str)));
+  }
+  void set_null(ObExpr *expr, const int64_t idx)
+  {
+    expr->locate_batch_datums(eval_ctx_)[idx].set_null();
+  }
+  void set_skip(const int64_t idx)
+  {
+    skip_->set(idx);
+  }
+
+  void reset_eval(ObExpr *expr)
+  {
+    expr->get_eval_info(eval_ctx_).clear_evaluated_flag();
+    expr->get_evaluated_flags(eval_ctx_).reset(BATCH_SIZE);
+  }
+
+  // Evaluate @batch_expr by batch and @row_expr row by row, both must succeed with the same
+  // results. Rows in skip_ must be left unevaluated by the batch evaluator.
+  void check_same(ObExpr *batch_expr, ObExpr *row_expr, const int64_t size)
+  {
+    reset_eval(batch_expr);
+    reset_eval(row_expr);
+    ASSERT_EQ(OB_SUCCESS, batch_expr->eval_batch(eval_ctx_, *skip_, size));
+    ObDatum *batch_res = batch_expr->locate_batch_datums(eval_ctx_);
+    const ObBitVector &eval_flags = batch_expr->get_evaluated_flags(eval_ctx_);
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+    batch_info_guard.set_batch_size(size);
+    for (int64_t i = 0; i < size; i++) {
+      if (skip_->at(i)) {
+        ASSERT_FALSE(eval_flags.at(i)) << "row " << i;
+        continue;
+      }
+      ObDatum *row_res = NULL;
+      batch_info_guard.set_batch_idx(i);
+      ASSERT_TRUE(eval_flags.at(i)) << "row " << i;
+      ASSERT_EQ(OB_SUCCESS, row_expr->eval(eval_ctx_, row_res)) << "row " << i;
+      ASSERT_EQ(row_res->is_null(), batch_res[i].is_null()) << "row " << i;
+      if (!row_res->is_null()) {
+        ASSERT_TRUE(ObDatum::binary_equal(*row_res, batch_res[i]))
+            << "row " << i << ": " << std::string(row_res->ptr_, row_res->len_)
+            << " vs " << std::string(batch_res[i].ptr_, batch_res[i].len_);
+      }
+    }
+  }
+
+  // Check the result string of a batch row, NULL @expect stands for a NULL result.
+  void check_res(ObExpr *expr, const int64_t idx, const char *expect)
+  {
+    const ObDatum &res = expr->locate_batch_datums(eval_ctx_)[idx];
+    if (NULL == expect) {
+      ASSERT_TRUE(res.is_null()) << "row " << idx;
+    } else {
+      ASSERT_FALSE(res.is_null()) << "row " << idx;
+      ASSERT_EQ(std::string(expect), std::string(res.ptr_, res.len_)) << "row " << idx;
+    }
+  }
+
+  // Evaluate @batch_expr by eval_batch() and @row_expr row by row over @size rows for
+  // BENCH_ROW_CNT rows, and print the rows per second of both.
+  void bench(const char *name, ObExpr *batch_expr, ObExpr *row_expr, const int64_t size)
+  {
+    const int64_t round_cnt = BENCH_ROW_CNT / size;
+    int64_t time_us[2] = {0, 0};
+    CALL(check_same, batch_expr, row_expr, size);
+    {
+      int ret = OB_SUCCESS;
+      const int64_t start_ts = ObTimeUtility::current_time();
+      for (int64_t r = 0; OB_SUCC(ret) && r < round_cnt; r++) {
+        reset_eval(batch_expr);
+        ret = batch_expr->eval_batch(eval_ctx_, *skip_, size);
+      }
+      time_us[0] = ObTimeUtility::current_time() - start_ts;
+      ASSERT_EQ(OB_SUCCESS, ret);
+    }
+    {
+      int ret = OB_SUCCESS;
+      ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+      batch_info_guard.set_batch_size(size);
+      const int64_t start_ts = ObTimeUtility::current_time();
+      for (int64_t r = 0; OB_SUCC(ret) && r < round_cnt; r++) {
+        reset_eval(row_expr);
+        for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+          ObDatum *res = NULL;
+          batch_info_guard.set_batch_idx(i);
+          ret = row_expr->eval(eval_ctx_, res);
+        }
+      }
+      time_us[1] = ObTimeUtility::current_time() - start_ts;
+      ASSERT_EQ(OB_SUCCESS, ret);
+    }
+    const int64_t row_cnt = round_cnt * size;
+    fprintf(stdout, "%s\trows:%ld\trow by row:%.2fM rows/s\tbatch:%.2fM rows/s\n", name, row_cnt,
+            static_cast<double>(row_cnt) / MAX(time_us[1], 1),
+            static_cast<double>(row_cnt) / MAX(time_us[0], 1));
+  }
+
+  void test_lower_upper(const ObCollationType cs_type, const char **strs, const int64_t cnt);
+
+protected:
+  ObArenaAllocator alloc_;
+  ObSQLSessionInfo session_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  ObBitVector *skip_;
+  int64_t expr_cnt_;
+};
+
+void TestExprStringBatch::test_lower_upper(const ObCollationType cs_type,
+                                           const char **strs, const int64_t cnt)
+{
+  ObExpr *text = new_expr(ObVarcharType, cs_type, true);
+  ASSERT_TRUE(NULL != text);
+  ObExpr **args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *)));
+  args[0] = text;
+  ObExpr *lower_batch = NULL;
+  ObExpr *lower_row = NULL;
+  ObExpr *upper_batch = NULL;
+  ObExpr *upper_row = NULL;
+  CALL(new_func_exprs, T_FUN_SYS_LOWER, ObVarcharType, cs_type, ObExprLower::calc_lower,
+       ObExprLower::calc_lower_batch, args, 1, lower_batch, lower_row);
+  CALL(new_func_exprs, T_FUN_SYS_UPPER, ObVarcharType, cs_type, ObExprUpper::calc_upper,
+       ObExprUpper::calc_upper_batch, args, 1, upper_batch, upper_row);
+  for (int64_t i = 0; i < cnt; i++) {
+    if (NULL == strs[i]) {
+      set_null(text, i);
+    } else {
+      set_str(text, i, strs[i]);
+    }
+  }
+  CALL(check_same, lower_batch, lower_row, cnt);
+  CALL(check_same, upper_batch, upper_row, cnt);
+}
+
+TEST_F(TestExprStringBatch, lower_upper_utf8)
+{
+  const char *strs[] = {
+    "Hello World", "", NULL, "ABCxyz@[`{09", "\xc3\x84pfel", "MIXED \xe4\xb8\xad\xe6\x96\x87 Text",
+    "\xce\xa3\xce\x99\xce\x93\xce\x9c\xce\x91", "0123456789012345678901234567890123456789"
+    "0123456789012345678901234567890123456789ABCDEFGHIJ",
+  };
+  const int64_t cnt = ARRAYSIZEOF(strs);
+  set_skip(2);
+  set_skip(4);
+  CALL(test_lower_upper, CS_TYPE_UTF8MB4_GENERAL_CI, strs, cnt);
+  skip_->reset(BATCH_SIZE);
+  CALL(test_lower_upper, CS_TYPE_UTF8MB4_BIN, strs, cnt);
+  CALL(test_lower_upper, CS_TYPE_BINARY, strs, cnt);
+}
+
+TEST_F(TestExprStringBatch, lower_upper_gbk)
+{
+  // the trail bytes of 0x8141 and 0x8161 are ASCII letters, they must not be converted
+  const char *strs[] = {
+    "x\x81\x41" "a", "ABC", "\x81\x61z", "\xd6\xd0\xce\xc4Ab", NULL, "",
+  };
+  const int64_t cnt = ARRAYSIZEOF(strs);
+  CALL(test_lower_upper, CS_TYPE_GBK_CHINESE_CI, strs, cnt);
+  CALL(test_lower_upper, CS_TYPE_GBK_BIN, strs, cnt);
+
+  ObExpr *text = new_expr(ObVarcharType, CS_TYPE_GBK_BIN, true);
+  ObExpr **args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *)));
+  args[0] = text;
+  ObExpr *upper_batch = NULL;
+  ObExpr *upper_row = NULL;
+  CALL(new_func_exprs, T_FUN_SYS_UPPER, ObVarcharType, CS_TYPE_GBK_BIN, ObExprUpper::calc_upper,
+       ObExprUpper::calc_upper_batch, args, 1, upper_batch, upper_row);
+  set_str(text, 0, "x\x81\x41" "a");
+  set_str(text, 1, "\x81\x61z");
+  CALL(check_same, upper_batch, upper_row, 2);
+  CALL(check_res, upper_batch, 0, "X\x81\x41" "A");
+  CALL(check_res, upper_batch, 1, "\x81\x61Z");
+}
+
+TEST_F(TestExprStringBatch, lower_upper_gb18030)
+{
+  // four bytes characters have ASCII digits as the 2nd and 4th bytes
+  const char *strs[] = {
+    "\x81\x30\x81\x30" "b", "x\x81\x41y", "Ab\x82\x35\x8f\x33", NULL, "", "plain ascii",
+  };
+  const int64_t cnt = ARRAYSIZEOF(strs);
+  set_skip(1);
+  CALL(test_lower_upper, CS_TYPE_GB18030_CHINESE_CI, strs, cnt);
+  skip_->reset(BATCH_SIZE);
+  CALL(test_lower_upper, CS_TYPE_GB18030_BIN, strs, cnt);
+}
+
+TEST_F(TestExprStringBatch, lower_upper_oracle)
+{
+  lib::CompatModeGuard g(lib::Worker::CompatMode::ORACLE);
+  const char *strs[] = { "Abc", "", NULL, "\xc3\x84" };
+  const int64_t cnt = ARRAYSIZEOF(strs);
+  CALL(test_lower_upper, CS_TYPE_UTF8MB4_BIN, strs, cnt);
+  // empty string is NULL in oracle mode
+  ObExpr *text = new_expr(ObVarcharType, CS_TYPE_UTF8MB4_BIN, true);
+  ObExpr **args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *)));
+  args[0] = text;
+  ObExpr *lower_batch = NULL;
+  ObExpr *lower_row = NULL;
+  CALL(new_func_exprs, T_FUN_SYS_LOWER, ObVarcharType, CS_TYPE_UTF8MB4_BIN,
+       ObExprLower::calc_lower, ObExprLower::calc_lower_batch, args, 1, lower_batch, lower_row);
+  set_str(text, 0, "");
+  set_str(text, 1, "ABC");
+  CALL(check_same, lower_batch, lower_row, 2);
+  CALL(check_res, lower_batch, 0, NULL);
+  CALL(check_res, lower_batch, 1, "abc");
+}
+
+TEST_F(TestExprStringBatch, trim)
+{
+  const ObExprOperatorType types[] = { T_FUN_SYS_TRIM, T_FUN_SYS_LTRIM, T_FUN_SYS_RTRIM };
+  const char *expects[][5] = {
+    { "a b", "", NULL, "\xe4\xb8\xad", "x" },
+    { "a b  ", "", NULL, "\xe4\xb8\xad ", "x" },
+    { "  a b", "", NULL, " \xe4\xb8\xad", "x" },
+  };
+  for (int64_t m = 0; m < 2; m++) {
+    lib::CompatModeGuard g(0 == m ? lib::Worker::CompatMode::MYSQL
+                                  : lib::Worker::CompatMode::ORACLE);
+    for (int64_t t = 0; t < ARRAYSIZEOF(types); t++) {
+      ObExpr *str = new_expr(ObVarcharType, CS_TYPE_UTF8MB4_GENERAL_CI, true);
+      ObExpr **args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *)));
+      args[0] = str;
+      ObExpr *trim_batch = NULL;
+      ObExpr *trim_row = NULL;
+      CALL(new_func_exprs, types[t], ObVarcharType, CS_TYPE_UTF8MB4_GENERAL_CI,
+           ObExprTrim::eval_trim, ObExprTrim::eval_trim_batch, args, 1, trim_batch, trim_row);
+      set_str(str, 0, "  a b  ");
+      set_str(str, 1, "    ");
+      set_null(str, 2);
+      set_str(str, 3, " \xe4\xb8\xad ");
+      set_str(str, 4, "x");
+      set_skip(5);
+      CALL(check_same, trim_batch, trim_row, 6);
+      for (int64_t i = 0; i < 5; i++) {
+        // trimmed to empty string is NULL in oracle mode
+        const char *expect = (1 == m && 1 == i) ? NULL : expects[t][i];
+        CALL(check_res, trim_batch, i, expect);
+      }
+      skip_->reset(BATCH_SIZE);
+    }
+  }
+}
+
+TEST_F(TestExprStringBatch, concat)
+{
+  for (int64_t m = 0; m < 2; m++) {
+    lib::CompatModeGuard g(0 == m ? lib::Worker::CompatMode::MYSQL
+                                  : lib::Worker::CompatMode::ORACLE);
+    ObExpr *arg0 = new_expr(ObVarcharType, CS_TYPE_UTF8MB4_BIN, true);
+    ObExpr *arg1 = new_expr(ObVarcharType, CS_TYPE_UTF8MB4_BIN, true);
+    ObExpr **args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *) * 2));
+    args[0] = arg0;
+    args[1] = arg1;
+    ObExpr *concat_batch = NULL;
+    ObExpr *concat_row = NULL;
+    CALL(new_func_exprs, T_OP_CNN, ObVarcharType, CS_TYPE_UTF8MB4_BIN, ObExprConcat::eval_concat,
+         ObExprConcat::eval_concat_batch, args, 2, concat_batch, concat_row);
+    set_str(arg0, 0, "abc");
+    set_str(arg1, 0, "\xe4\xb8\xad");
+    set_str(arg0, 1, "x");
+    set_null(arg1, 1);
+    set_null(arg0, 2);
+    set_null(arg1, 2);
+    set_str(arg0, 3, "");
+    set_str(arg1, 3, "y");
+    // longer than the reserved result buffer
+    set_str(arg0, 4, "0123456789012345678901234567890123456789");
+    set_str(arg1, 4, "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz");
+    set_skip(5);
+    CALL(check_same, concat_batch, concat_row, 6);
+    CALL(check_res, concat_batch, 0, "abc\xe4\xb8\xad");
+    // NULL is empty string in oracle mode
+    CALL(check_res, concat_batch, 1, 0 == m ? NULL : "x");
+    CALL(check_res, concat_batch, 2, NULL);
+    CALL(check_res, concat_batch, 3, "y");
+    skip_->reset(BATCH_SIZE);
+  }
+}
+
+TEST_F(TestExprStringBatch, concat_overflow)
+{
+  const int64_t half_len = OB_MAX_VARCHAR_LENGTH / 2 + 1;
+  char *long_str = static_cast<char *>(alloc_.alloc(half_len + 1));
+  ASSERT_TRUE(NULL != long_str);
+  memset(long_str, 'a', half_len);
+  long_str[half_len] = '\0';
+  ObExpr *arg0 = new_expr(ObVarcharType, CS_TYPE_UTF8MB4_BIN, true);
+  ObExpr *arg1 = new_expr(ObVarcharType, CS_TYPE_UTF8MB4_BIN, true);
+  ObExpr **args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *) * 2));
+  args[0] = arg0;
+  args[1] = arg1;
+  ObExpr *concat_batch = NULL;
+  ObExpr *concat_row = NULL;
+  CALL(new_func_exprs, T_OP_CNN, ObVarcharType, CS_TYPE_UTF8MB4_BIN, ObExprConcat::eval_concat,
+       ObExprConcat::eval_concat_batch, args, 2, concat_batch, concat_row);
+  set_str(arg0, 0, "a");
+  set_str(arg1, 0, "b");
+  set_str(arg0, 1, long_str);
+  set_str(arg1, 1, long_str);
+
+  // the overflow row is skipped
+  set_skip(1);
+  CALL(check_same, concat_batch, concat_row, 2);
+  skip_->reset(BATCH_SIZE);
+
+  // the batch and the row evaluators fail with the same error
+  reset_eval(concat_batch);
+  reset_eval(concat_row);
+  ASSERT_EQ(OB_SIZE_OVERFLOW, concat_batch->eval_batch(eval_ctx_, *skip_, 2));
+  {
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+    batch_info_guard.set_batch_size(2);
+    batch_info_guard.set_batch_idx(1);
+    ObDatum *res = NULL;
+    ASSERT_EQ(OB_SIZE_OVERFLOW, concat_row->eval(eval_ctx_, res));
+  }
+
+  // longer than the oracle varchar in oracle mode
+  lib::CompatModeGuard g(lib::Worker::CompatMode::ORACLE);
+  set_str(arg0, 1, long_str + half_len - OB_MAX_ORACLE_VARCHAR_LENGTH);
+  set_str(arg1, 1, "b");
+  reset_eval(concat_batch);
+  reset_eval(concat_row);
+  ASSERT_EQ(OB_ERR_TOO_LONG_STRING_IN_CONCAT, concat_batch->eval_batch(eval_ctx_, *skip_, 2));
+  {
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+    batch_info_guard.set_batch_size(2);
+    batch_info_guard.set_batch_idx(1);
+    ObDatum *res = NULL;
+    ASSERT_EQ(OB_ERR_TOO_LONG_STRING_IN_CONCAT, concat_row->eval(eval_ctx_, res));
+  }
+}
+
+TEST_F(TestExprStringBatch, date_format)
+{
+  const char *dates[] = {
+    "2024-02-29 13:05:09", "1999-12-31 23:59:59", "2000-01-01 00:00:00", "2024-07-04 08:30:00",
+  };
+  const int64_t date_cnt = ARRAYSIZEOF(dates);
+  ObExpr *date = new_expr(ObDateTimeType, CS_TYPE_BINARY, true);
+  ObExpr *batch_fmt = new_expr(ObVarcharType, CS_TYPE_UTF8MB4_GENERAL_CI, true);
+  ObExpr *const_fmt = new_expr(ObVarcharType, CS_TYPE_UTF8MB4_GENERAL_CI, false);
+  ASSERT_TRUE(NULL != date && NULL != batch_fmt && NULL != const_fmt);
+  ObTimeConvertCtx cvrt_ctx(NULL, false);
+  for (int64_t i = 0; i < date_cnt; i++) {
+    int64_t value = 0;
+    ASSERT_EQ(OB_SUCCESS, ObTimeConverter::str_to_datetime(ObString(dates[i]), cvrt_ctx, value));
+    date->locate_batch_datums(eval_ctx_)[i].set_datetime(value);
+  }
+  set_null(date, date_cnt);
+  date->locate_batch_datums(eval_ctx_)[date_cnt + 1].set_datetime(0);
+  const int64_t cnt = date_cnt + 2;
+  const char *fmts[] = { "%Y-%m-%d", "%W %M %D %Y", "%H:%i:%s %p", "", "%j %U %a %b", "%%%x%v" };
+  for (int64_t i = 0; i < cnt; i++) {
+    set_str(batch_fmt, i, fmts[i % ARRAYSIZEOF(fmts)]);
+  }
+  set_null(batch_fmt, 2);
+  set_skip(1);
+  for (int64_t f = 0; f < 2; f++) {
+    ObExpr **args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *) * 2));
+    args[0] = date;
+    args[1] = (0 == f) ? const_fmt : batch_fmt;
+    ObExpr *format_batch = NULL;
+    ObExpr *format_row = NULL;
+    CALL(new_func_exprs, T_FUN_SYS_DATE_FORMAT, ObVarcharType, CS_TYPE_UTF8MB4_GENERAL_CI,
+         ObExprDateFormat::calc_date_format, ObExprDateFormat::calc_date_format_batch,
+         args, 2, format_batch, format_row);
+    set_str(const_fmt, 0, "%Y-%m-%d %H:%i:%s.%f");
+    CALL(check_same, format_batch, format_row, cnt);
+    if (0 == f) {
+      CALL(check_res, format_batch, 0, "2024-02-29 13:05:09.000000");
+      CALL(check_res, format_batch, date_cnt, NULL);
+    }
+  }
+}
+
+TEST_F(TestExprStringBatch, regexp_like)
+{
+  ObExpr *text = new_expr(ObVarcharType, CS_TYPE_UTF8MB4_GENERAL_CI, true);
+  ObExpr *const_pattern = new_expr(ObVarcharType, CS_TYPE_UTF8MB4_GENERAL_CI, false);
+  ObExpr *batch_pattern = new_expr(ObVarcharType, CS_TYPE_UTF8MB4_GENERAL_CI, true);
+  ASSERT_TRUE(NULL != text && NULL != const_pattern && NULL != batch_pattern);
+  set_str(text, 0, "abc");
+  set_str(text, 1, "ABC");
+  set_str(text, 2, "xyz");
+  set_null(text, 3);
+  set_str(text, 4, "\xe4\xb8\xad\xe6\x96\x87 abc");
+  set_str(text, 5, "");
+  set_str(const_pattern, 0, "^a.c$|\xe6\x96\x87");
+  for (int64_t i = 0; i < 6; i++) {
+    set_str(batch_pattern, i, 0 == i % 2 ? "b" : "^x");
+  }
+  set_skip(2);
+  for (int64_t p = 0; p < 2; p++) {
+    ObExpr **args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *) * 2));
+    args[0] = text;
+    args[1] = (0 == p) ? const_pattern : batch_pattern;
+    ObExpr *like_batch = NULL;
+    ObExpr *like_row = NULL;
+    CALL(new_func_exprs, T_FUN_SYS_REGEXP_LIKE, ObInt32Type, CS_TYPE_BINARY,
+         ObExprRegexpLike::eval_regexp_like, ObExprRegexpLike::eval_regexp_like_batch,
+         args, 2, like_batch, like_row);
+    // the regex is kept in the expr op ctx when the pattern is const
+    like_batch->extra_ = 1;
+    like_batch->expr_ctx_id_ = static_cast<uint32_t>(2 * p);
+    like_row->extra_ = 1;
+    like_row->expr_ctx_id_ = static_cast<uint32_t>(2 * p + 1);
+    CALL(check_same, like_batch, like_row, 6);
+    // evaluated twice with the regex context reused
+    CALL(check_same, like_batch, like_row, 6);
+    if (0 == p) {
+      ASSERT_EQ(1, like_batch->locate_batch_datums(eval_ctx_)[0].get_int32());
+      ASSERT_EQ(1, like_batch->locate_batch_datums(eval_ctx_)[1].get_int32());
+      ASSERT_TRUE(like_batch->locate_batch_datums(eval_ctx_)[3].is_null());
+      ASSERT_EQ(1, like_batch->locate_batch_datums(eval_ctx_)[4].get_int32());
+      ASSERT_EQ(0, like_batch->locate_batch_datums(eval_ctx_)[5].get_int32());
+    }
+  }
+  // NULL pattern
+  set_null(const_pattern, 0);
+  ObExpr **args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *) * 2));
+  args[0] = text;
+  args[1] = const_pattern;
+  ObExpr *like_batch = NULL;
+  ObExpr *like_row = NULL;
+  CALL(new_func_exprs, T_FUN_SYS_REGEXP_LIKE, ObInt32Type, CS_TYPE_BINARY,
+       ObExprRegexpLike::eval_regexp_like, ObExprRegexpLike::eval_regexp_like_batch,
+       args, 2, like_batch, like_row);
+  like_batch->extra_ = 1;
+  like_batch->expr_ctx_id_ = 4;
+  CALL(check_same, like_batch, like_row, 6);
+  ASSERT_TRUE(like_batch->locate_batch_datums(eval_ctx_)[0].is_null());
+}
+
+// Rows per second of the batch and the row evaluators, run with --gtest_also_run_disabled_tests.
+TEST_F(TestExprStringBatch, DISABLED_benchmark)
+{
+  const ObCollationType cs_type = CS_TYPE_UTF8MB4_GENERAL_CI;
+  const char *strs[] = {
+    "  Hello World  ", "ABCxyz@[`{09 abc", "  MIXED \xe4\xb8\xad\xe6\x96\x87 Text", "x123 plain ascii",
+  };
+  ObExpr *str0 = new_expr(ObVarcharType, cs_type, true);
+  ObExpr *str1 = new_expr(ObVarcharType, cs_type, true);
+  ObExpr *date = new_expr(ObDateTimeType, CS_TYPE_BINARY, true);
+  ObExpr *fmt = new_expr(ObVarcharType, cs_type, false);
+  ObExpr *pattern = new_expr(ObVarcharType, cs_type, false);
+  ASSERT_TRUE(NULL != str0 && NULL != str1 && NULL != date && NULL != fmt && NULL != pattern);
+  for (int64_t i = 0; i < BATCH_SIZE; i++) {
+    set_str(str0, i, strs[i % ARRAYSIZEOF(strs)]);
+    set_str(str1, i, strs[(i + 1) % ARRAYSIZEOF(strs)]);
+    date->locate_batch_datums(eval_ctx_)[i].set_datetime(
+        1700000000LL * 1000000 + i * 3600LL * 1000000 + i);
+  }
+  set_str(fmt, 0, "%Y-%m-%d %H:%i:%s");
+  set_str(pattern, 0, "^a.c|x[0-9]+");
+  ObExpr **str_args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *) * 2));
+  ObExpr **date_args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *) * 2));
+  ObExpr **like_args = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *) * 2));
+  ASSERT_TRUE(NULL != str_args && NULL != date_args && NULL != like_args);
+  str_args[0] = str0;
+  str_args[1] = str1;
+  date_args[0] = date;
+  date_args[1] = fmt;
+  like_args[0] = str0;
+  like_args[1] = pattern;
+  ObExpr *batch_expr = NULL;
+  ObExpr *row_expr = NULL;
+
+  CALL(new_func_exprs, T_FUN_SYS_LOWER, ObVarcharType, cs_type, ObExprLower::calc_lower,
+       ObExprLower::calc_lower_batch, str_args, 1, batch_expr, row_expr);
+  CALL(bench, "lower", batch_expr, row_expr, BATCH_SIZE);
+
+  CALL(new_func_exprs, T_FUN_SYS_TRIM, ObVarcharType, cs_type, ObExprTrim::eval_trim,
+       ObExprTrim::eval_trim_batch, str_args, 1, batch_expr, row_expr);
+  CALL(bench, "trim", batch_expr, row_expr, BATCH_SIZE);
+
+  CALL(new_func_exprs, T_OP_CNN, ObVarcharType, cs_type, ObExprConcat::eval_concat,
+       ObExprConcat::eval_concat_batch, str_args, 2, batch_expr, row_expr);
+  CALL(bench, "concat", batch_expr, row_expr, BATCH_SIZE);
+
+  CALL(new_func_exprs, T_FUN_SYS_DATE_FORMAT, ObVarcharType, cs_type,
+       ObExprDateFormat::calc_date_format, ObExprDateFormat::calc_date_format_batch,
+       date_args, 2, batch_expr, row_expr);
+  CALL(bench, "date_format", batch_expr, row_expr, BATCH_SIZE);
+
+  CALL(new_func_exprs, T_FUN_SYS_REGEXP_LIKE, ObInt32Type, CS_TYPE_BINARY,
+       ObExprRegexpLike::eval_regexp_like, ObExprRegexpLike::eval_regexp_like_batch,
+       like_args, 2, batch_expr, row_expr);
+  batch_expr->extra_ = 1;
+  batch_expr->expr_ctx_id_ = 0;
+  row_expr->extra_ = 1;
+  row_expr->expr_ctx_id_ = 1;
+  CALL(bench, "regexp_like", batch_expr, row_expr, BATCH_SIZE);
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::sql::init_sql_factories();
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
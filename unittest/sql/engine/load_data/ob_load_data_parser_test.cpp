@@ -18,6 +18,7 @@
 #include "sql/ob_sql_init.h"
 #include "sql/engine/cmd/ob_load_data_impl.h"
 #include "sql/engine/cmd/ob_load_data_parser.h"
+#include "lib/checksum/ob_crc64.h"
 
 static char *file_path = NULL;
 
@@ -305,6 +306,75 @@ TEST_F(TestParser, general_parser_escape)
 
 }
 
+TEST_F(TestParser, general_parser_structural_index)
+{
+  ObDataInFileStruct file_struct;
+  file_struct.field_term_str_ = ",";
+  file_struct.field_enclosed_str_ = "\"";
+  file_struct.field_enclosed_char_ = '"';
+  const int64_t column_num = 6;
+  const int64_t buf_size = 64L << 20;
+  const char *rows[] = {
+    "1,\"plain enclosed text\",\\N,2023-01-01 12:00:00,3.1415926,short\n",
+    "22,\"enclosed, with \"\"quotes\"\" and \\\\ escapes\",NULL,\"NULL\",-7,\xe4\xb8\xad\xe6\x96\x87\n",
+    "333,a long field without any special character in it at all,,tab\\tand\\nnewline,0,x\n",
+  };
+  char *data = static_cast<char *>(ob_malloc(buf_size, ObNewModIds::TEST));
+  char *escape_buf = static_cast<char *>(ob_malloc(buf_size, ObNewModIds::TEST));
+  ASSERT_TRUE(NULL != data && NULL != escape_buf);
+  int64_t data_len = 0;
+  for (int64_t i = 0; ; i++) {
+    const int64_t row_len = STRLEN(rows[i % 3]);
+    if (data_len + row_len > buf_size) {
+      break;
+    }
+    MEMCPY(data + data_len, rows[i % 3], row_len);
+    data_len += row_len;
+  }
+
+  const ObCollationType cs_types[] = { CS_TYPE_UTF8MB4_BIN, CS_TYPE_BINARY };
+  for (int64_t i = 0; i < 2; i++) {
+    int64_t line_cnt[2] = {0, 0};
+    uint64_t checksum[2] = {0, 0};
+    int64_t time_us[2] = {0, 0};
+    for (int64_t j = 0; j < 2; j++) {
+      ObCSVGeneralParser parser;
+      ASSERT_EQ(OB_SUCCESS, parser.init(file_struct, column_num, cs_types[i]));
+      parser.set_use_structural_index(1 == j);
+      uint64_t &line_checksum = checksum[j];
+      auto handle_one_line = [&line_checksum](ObIArray<ObCSVGeneralParser::FieldValue> &arr) -> int {
+        for (int64_t k = 0; k < arr.count(); k++) {
+          const ObCSVGeneralParser::FieldValue &field = arr.at(k);
+          line_checksum = ob_crc64(line_checksum, &field.flags_, sizeof(field.flags_));
+          line_checksum = ob_crc64(line_checksum, field.ptr_, field.len_);
+        }
+        return OB_SUCCESS;
+      };
+      ObSEArray<ObCSVGeneralParser::LineErrRec, 256> error_msgs;
+      const char *ptr = data;
+      const char *end = data + data_len;
+      const int64_t start_time = ObTimeUtility::current_time();
+      while (ptr < end) {
+        int64_t nrows = 1024;
+        ASSERT_EQ(OB_SUCCESS, (parser.scan<decltype(handle_one_line), true>(ptr, end, nrows,
+                                          escape_buf, escape_buf + buf_size,
+                                          handle_one_line, error_msgs, true)));
+        line_cnt[j] += nrows;
+      }
+      time_us[j] = ObTimeUtility::current_time() - start_time;
+      ASSERT_EQ(0, error_msgs.count());
+    }
+    ASSERT_EQ(line_cnt[0], line_cnt[1]);
+    ASSERT_EQ(checksum[0], checksum[1]);
+    fprintf(stdout, "cs_type:%d\tbytes:%ld\tlines:%ld\tbyte scan:%.2fGB/s\tstructural index:%.2fGB/s\n",
+            cs_types[i], data_len, line_cnt[0],
+            static_cast<double>(data_len) / 1000 / MAX(time_us[0], 1),
+            static_cast<double>(data_len) / 1000 / MAX(time_us[1], 1));
+  }
+  ob_free(data);
+  ob_free(escape_buf);
+}
+
 int main(int argc, char **argv)
 {
   init_sql_factories();
@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "sql/dtl/ob_dtl_basic_channel.h"
+#include "sql/dtl/ob_dtl_linked_buffer.h"
+#include "sql/engine/px/ob_px_row_store.h"
+#include "sql/engine/ob_exec_context.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+using namespace dtl;
+
+#define CALL(func, ...) func(__VA_ARGS__); ASSERT_FALSE(HasFatalFailure());
+
+// A local channel hands the ObDtlLinkedBuffer over to the receiver and the datum rows are kept
+// swizzled (DTL_SWIZZLED). The rows must be read back by ObReceiveRowReader as they were written,
+// after the memory of the sender's exprs is overwritten and released.
+class TestDtlSwizzledBuffer : public ::testing::Test
+{
+public:
+  static const int64_t ROW_CNT = 100;
+  static const int64_t COL_CNT = 2;
+  static const int64_t MAX_EXPR_CNT = 8;
+  static const int64_t BUF_SIZE = 64 * 1024;
+
+  TestDtlSwizzledBuffer()
+    : exec_ctx_(alloc_), eval_ctx_(exec_ctx_), sender_alloc_(), expr_cnt_(0), buffer_(NULL)
+  {}
+
+  virtual void SetUp() override
+  {
+    eval_ctx_.frames_ = static_cast<char **>(alloc_.alloc(sizeof(char *) * MAX_EXPR_CNT));
+    ASSERT_TRUE(NULL != eval_ctx_.frames_);
+    memset(eval_ctx_.frames_, 0, sizeof(char *) * MAX_EXPR_CNT);
+    char *mem = static_cast<char *>(alloc_.alloc(sizeof(ObDtlLinkedBuffer) + BUF_SIZE));
+    ASSERT_TRUE(NULL != mem);
+    buffer_ = new (mem) ObDtlLinkedBuffer(mem + sizeof(ObDtlLinkedBuffer), BUF_SIZE);
+    CALL(new_exprs, sender_alloc_, send_exprs_);
+    CALL(new_exprs, alloc_, recv_exprs_);
+  }
+
+  virtual void TearDown() override
+  {
+    sender_alloc_.reset();
+    alloc_.reset();
+  }
+
+  // Column 0 is a bigint and column 1 a varchar, the frames are allocated from @alloc.
+  void new_exprs(ObIAllocator &alloc, ObSEArray<ObExpr *, COL_CNT> &exprs)
+  {
+    const ObObjType types[COL_CNT] = { ObIntType, ObVarcharType };
+    for (int64_t i = 0; i < COL_CNT; i++) {
+      const int64_t frame_size = sizeof(ObDatum) + sizeof(ObEvalInfo);
+      char *frame = static_cast<char *>(alloc.alloc(frame_size));
+      ASSERT_TRUE(NULL != frame);
+      ASSERT_LT(expr_cnt_, MAX_EXPR_CNT);
+      memset(frame, 0, frame_size);
+      eval_ctx_.frames_[expr_cnt_] = frame;
+      ObExpr *expr = new (alloc.alloc(sizeof(ObExpr))) ObExpr();
+      expr->frame_idx_ = static_cast<uint32_t>(expr_cnt_++);
+      expr->datum_off_ = 0;
+      expr->eval_info_off_ = sizeof(ObDatum);
+      expr->datum_meta_.type_ = types[i];
+      expr->datum_meta_.cs_type_ = CS_TYPE_UTF8MB4_GENERAL_CI;
+      expr->obj_meta_.set_type(types[i]);
+      ASSERT_EQ(OB_SUCCESS, exprs.push_back(expr));
+    }
+  }
+
+  // Row i is (i * 7, "row-<i>-<padding>"), the string is allocated from the sender's allocator.
+  void set_send_row(const int64_t i)
+  {
+    char *str = static_cast<char *>(sender_alloc_.alloc(64));
+    ASSERT_TRUE(NULL != str);
+    const int64_t len = snprintf(str, 64, "row-%ld-%0*ld", i, static_cast<int>(i % 32), i);
+    send_exprs_.at(0)->locate_expr_datum(eval_ctx_).set_int(i * 7);
+    send_exprs_.at(1)->locate_expr_datum(eval_ctx_).set_string(str, static_cast<int32_t>(len));
+  }
+
+  // Overwrite and free everything the sender's exprs point to, as the sender thread
+  // moves on to the next rows and finally releases its memory.
+  void release_sender()
+  {
+    for (int64_t i = 0; i < COL_CNT; i++) {
+      ObDatum &datum = send_exprs_.at(i)->locate_expr_datum(eval_ctx_);
+      if (!datum.is_null() && datum.len_ > 0) {
+        memset(const_cast<char *>(datum.ptr_), 'x', datum.len_);
+      }
+      eval_ctx_.frames_[send_exprs_.at(i)->frame_idx_] = NULL;
+    }
+    send_exprs_.reset();
+    sender_alloc_.reset();
+  }
+
+  void write_rows(const bool unswizzling, const bool vectorized)
+  {
+    ObDtlDatumMsgWriter writer;
+    ObChunkDatumStore::BlockBufferWrap block_buf;
+    writer.set_unswizzling(unswizzling);
+    if (vectorized) {
+      writer.set_register_block_buf_ptr(&block_buf);
+    }
+    ASSERT_EQ(OB_SUCCESS, writer.init(buffer_, OB_SYS_TENANT_ID));
+    for (int64_t i = 0; i < ROW_CNT; i++) {
+      CALL(set_send_row, i);
+      if (vectorized) {
+        ASSERT_EQ(OB_SUCCESS, block_buf.append_row(send_exprs_, &eval_ctx_, 0));
+      } else {
+        ObPxNewRow px_row(send_exprs_);
+        ASSERT_EQ(OB_SUCCESS, writer.write(px_row, &eval_ctx_, false));
+      }
+    }
+    if (vectorized) {
+      ASSERT_EQ(OB_SUCCESS, writer.handle_eof());
+    }
+    ASSERT_EQ(ROW_CNT, writer.rows());
+    writer.write_msg_type(buffer_);
+    ASSERT_EQ(!unswizzling, buffer_->is_swizzled());
+    writer.reset();
+    CALL(release_sender);
+  }
+
+  void read_rows()
+  {
+    ObReceiveRowReader reader;
+    ObSEArray<ObExpr *, 1> dynamic_const_exprs;
+    bool transferred = false;
+    ASSERT_EQ(OB_SUCCESS, reader.add_buffer(*buffer_, transferred));
+    ASSERT_TRUE(transferred);
+    ASSERT_EQ(ROW_CNT, reader.left_rows());
+    char expect[64];
+    for (int64_t i = 0; i < ROW_CNT; i++) {
+      ASSERT_EQ(OB_SUCCESS, reader.get_next_row(recv_exprs_, dynamic_const_exprs, eval_ctx_));
+      const int64_t len = snprintf(expect, sizeof(expect), "row-%ld-%0*ld",
+                                   i, static_cast<int>(i % 32), i);
+      ASSERT_EQ(i * 7, recv_exprs_.at(0)->locate_expr_datum(eval_ctx_).get_int());
+      ASSERT_EQ(ObString(len, expect), recv_exprs_.at(1)->locate_expr_datum(eval_ctx_).get_string());
+    }
+    ASSERT_EQ(OB_ITER_END, reader.get_next_row(recv_exprs_, dynamic_const_exprs, eval_ctx_));
+    ASSERT_FALSE(reader.has_more());
+    // the buffer is owned by the test, not by the DFC memory manager
+    reader.recv_head_ = NULL;
+    reader.recv_tail_ = NULL;
+    reader.iterated_buffers_ = NULL;
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  ObArenaAllocator sender_alloc_;
+  int64_t expr_cnt_;
+  ObDtlLinkedBuffer *buffer_;
+  ObSEArray<ObExpr *, COL_CNT> send_exprs_;
+  ObSEArray<ObExpr *, COL_CNT> recv_exprs_;
+};
+
+// rows written by ObDtlDatumMsgWriter for a local channel
+TEST_F(TestDtlSwizzledBuffer, swizzled_row)
+{
+  CALL(write_rows, false, false);
+  CALL(read_rows);
+}
+
+// rows written by the vectorized transmit through the registered BlockBufferWrap
+TEST_F(TestDtlSwizzledBuffer, swizzled_batch)
+{
+  CALL(write_rows, false, true);
+  CALL(read_rows);
+}
+
+// rpc channels and interm results keep unswizzled rows, swizzled by the receiver
+TEST_F(TestDtlSwizzledBuffer, unswizzled_row)
+{
+  CALL(write_rows, true, false);
+  CALL(read_rows);
+}
+
+TEST_F(TestDtlSwizzledBuffer, unswizzled_batch)
+{
+  CALL(write_rows, true, true);
+  CALL(read_rows);
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
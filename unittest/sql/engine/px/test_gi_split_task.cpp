@@ -0,0 +1,186 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+#define private public
+#include "sql/engine/px/ob_granule_pump.h"
+#include "sql/engine/table/ob_table_scan_op.h"
+#undef private
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObGISplitTaskTest : public ::testing::Test
+{
+public:
+  ObGISplitTaskTest() = default;
+  virtual ~ObGISplitTaskTest() = default;
+  virtual void SetUp() {};
+  virtual void TearDown() {};
+
+  void make_range(int64_t start, int64_t end, ObNewRange &range)
+  {
+    range.table_id_ = 1;
+    objs_[obj_cnt_].set_int(start);
+    objs_[obj_cnt_ + 1].set_int(end);
+    range.start_key_.assign(&objs_[obj_cnt_], 1);
+    range.end_key_.assign(&objs_[obj_cnt_ + 1], 1);
+    range.border_flag_.set_inclusive_start();
+    obj_cnt_ += 2;
+  }
+private:
+  ObObj objs_[64];
+  int64_t obj_cnt_ = 0;
+};
+
+TEST_F(ObGISplitTaskTest, split_task)
+{
+  ObGITaskSet taskset;
+  ObSEArray<ObDASTabletLoc *, 4> tablets;
+  ObSEArray<ObNewRange, 4> ranges;
+  ObSEArray<ObNewRange, 4> ss_ranges;
+  ObSEArray<int64_t, 4> idxs;
+  ObDASTabletLoc tablet_loc;
+  for (int64_t i = 0; i < 2; ++i) {
+    ObNewRange range;
+    make_range(i * 100, (i + 1) * 100, range);
+    ASSERT_EQ(OB_SUCCESS, tablets.push_back(&tablet_loc));
+    ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+    ASSERT_EQ(OB_SUCCESS, idxs.push_back(i));
+  }
+  ASSERT_EQ(OB_SUCCESS, taskset.construct_taskset(tablets, ranges, ss_ranges, idxs,
+                                                  ObGITaskSet::GI_RANDOM_NONE));
+  ASSERT_FALSE(taskset.can_split_task());
+  ASSERT_EQ(OB_SUCCESS, taskset.prepare_split_task(4));
+  ASSERT_TRUE(taskset.can_split_task());
+  ASSERT_LE(6, taskset.split_limit_);
+  ASSERT_EQ(2, taskset.next_split_idx_);
+  const ObGITaskSet::ObGITaskInfo *first_task = &taskset.gi_task_set_.at(0);
+
+  // fetch the first task, the second one can not be split before it is fetched
+  int64_t pos = -1;
+  ASSERT_EQ(OB_SUCCESS, taskset.get_next_gi_task_pos(pos));
+  ASSERT_EQ(0, pos);
+  ObSEArray<ObNewRange, 4> split_ranges;
+  for (int64_t i = 0; i < 3; ++i) {
+    ObNewRange range;
+    make_range(100 + i * 30, 130 + i * 30, range);
+    ASSERT_EQ(OB_SUCCESS, split_ranges.push_back(range));
+  }
+  ASSERT_EQ(OB_ERR_UNEXPECTED, taskset.split_task(1, split_ranges));
+  // fetch the second task and split it into three
+  ASSERT_EQ(OB_SUCCESS, taskset.get_next_gi_task_pos(pos));
+  ASSERT_EQ(1, pos);
+  ASSERT_EQ(OB_SUCCESS, taskset.split_task(pos, split_ranges));
+  // the array is never reallocated, fetched tasks stay valid
+  ASSERT_EQ(first_task, &taskset.gi_task_set_.at(0));
+  ASSERT_EQ(4, taskset.gi_task_set_.count());
+
+  // the fetched tasks still cover one range only
+  ObGranuleTaskInfo info;
+  ASSERT_EQ(OB_SUCCESS, taskset.get_task_at_pos(info, 0));
+  ASSERT_EQ(1, info.ranges_.count());
+  ASSERT_EQ(OB_SUCCESS, taskset.get_task_at_pos(info, 1));
+  ASSERT_EQ(1, info.ranges_.count());
+  ASSERT_EQ(0, info.ranges_.at(0).compare_with_startkey2(split_ranges.at(0)));
+
+  ObSEArray<int64_t, 4> task_idxs;
+  ASSERT_EQ(OB_SUCCESS, task_idxs.push_back(taskset.gi_task_set_.at(pos).idx_));
+  while (OB_SUCCESS == taskset.get_next_gi_task_pos(pos)) {
+    ASSERT_EQ(OB_SUCCESS, taskset.get_task_at_pos(info, pos));
+    ASSERT_EQ(1, info.ranges_.count());
+    ASSERT_EQ(OB_SUCCESS, task_idxs.push_back(taskset.gi_task_set_.at(pos).idx_));
+  }
+  ASSERT_EQ(3, task_idxs.count());
+  ASSERT_EQ(1, task_idxs.at(0));
+  ASSERT_EQ(2, task_idxs.at(1));
+  ASSERT_EQ(3, task_idxs.at(2));
+
+  // no room left for another split
+  taskset.split_limit_ = taskset.gi_task_set_.count();
+  ASSERT_FALSE(taskset.can_split_task());
+  ASSERT_EQ(OB_ERR_UNEXPECTED, taskset.split_task(1, split_ranges));
+}
+
+TEST_F(ObGISplitTaskTest, split_granule_cnt)
+{
+  ObArenaAllocator alloc;
+  ObTableScanSpec tsc1(alloc, PHY_TABLE_SCAN);
+  ObTableScanSpec tsc2(alloc, PHY_TABLE_SCAN);
+  tsc1.id_ = 1;
+  tsc2.id_ = 2;
+  ObGranulePump pump;
+  // two granule iterators with different parallelism in one pump
+  for (int64_t i = 0; i < 2; ++i) {
+    ObGranulePumpArgs args;
+    args.parallelism_ = 0 == i ? 2 : 8;
+    ASSERT_EQ(OB_SUCCESS, args.op_info_.push_back_scan_ops(0 == i ? &tsc1 : &tsc2));
+    ASSERT_EQ(OB_SUCCESS, pump.pump_args_.push_back(args));
+  }
+  const ObGranulePumpArgs *args = nullptr;
+  const ObTableScanSpec *tsc = nullptr;
+  ASSERT_EQ(OB_SUCCESS, pump.find_pump_args_by_tsc_id(2, args, tsc));
+  ASSERT_EQ(&tsc2, tsc);
+  ASSERT_EQ(8, args->parallelism_);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, pump.find_pump_args_by_tsc_id(3, args, tsc));
+
+  ObGITaskSet taskset;
+  ObSEArray<ObDASTabletLoc *, 4> tablets;
+  ObSEArray<ObNewRange, 4> ranges;
+  ObSEArray<ObNewRange, 4> ss_ranges;
+  ObSEArray<int64_t, 4> idxs;
+  ObDASTabletLoc tablet_loc;
+  // task 0 has two ranges, task 1 and task 2 have one
+  for (int64_t i = 0; i < 4; ++i) {
+    ObNewRange range;
+    make_range(i * 100, (i + 1) * 100, range);
+    ASSERT_EQ(OB_SUCCESS, tablets.push_back(&tablet_loc));
+    ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+    ASSERT_EQ(OB_SUCCESS, idxs.push_back(0 == i ? 0 : i - 1));
+  }
+  ASSERT_EQ(OB_SUCCESS, taskset.construct_taskset(tablets, ranges, ss_ranges, idxs,
+                                                  ObGITaskSet::GI_RANDOM_NONE));
+  ASSERT_EQ(OB_SUCCESS, taskset.prepare_split_task(8 * ObGranulePump::MAX_SPLIT_GRANULE_CNT_PER_WORKER));
+  int64_t pos = -1;
+  int64_t split_cnt = 0;
+  // a task with more than one range is never split
+  ASSERT_EQ(OB_SUCCESS, taskset.get_next_gi_task_pos(pos));
+  ASSERT_EQ(0, pos);
+  ASSERT_EQ(OB_SUCCESS, pump.get_split_granule_cnt(taskset, pos, 2, split_cnt));
+  ASSERT_EQ(0, split_cnt);
+  // the parallelism of the scan asking for the task is used
+  ASSERT_EQ(OB_SUCCESS, taskset.get_next_gi_task_pos(pos));
+  ASSERT_EQ(2, pos);
+  ASSERT_EQ(OB_SUCCESS, pump.get_split_granule_cnt(taskset, pos, 1, split_cnt));
+  ASSERT_EQ(1, split_cnt);
+  ASSERT_EQ(OB_SUCCESS, pump.get_split_granule_cnt(taskset, pos, 2, split_cnt));
+  ASSERT_EQ(7, split_cnt);
+  // the room reserved by a split in progress is not given to another one
+  const int64_t room = taskset.get_split_room();
+  taskset.reserve_split_room(room - 2);
+  ASSERT_EQ(OB_SUCCESS, pump.get_split_granule_cnt(taskset, pos, 2, split_cnt));
+  ASSERT_EQ(3, split_cnt);
+  taskset.reserve_split_room(2);
+  ASSERT_FALSE(taskset.can_split_task());
+  taskset.release_split_room(room);
+  ASSERT_EQ(room, taskset.get_split_room());
+  // a task not fetched yet can not be split
+  ASSERT_EQ(OB_INVALID_ARGUMENT, pump.get_split_granule_cnt(taskset, 3, 2, split_cnt));
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "gtest/gtest.h"
+#include "sql/engine/px/datahub/components/ob_dh_skew_detect.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class TestSkewDetect : public ::testing::Test
+{
+public:
+  TestSkewDetect() = default;
+  virtual ~TestSkewDetect() = default;
+  virtual void SetUp() override {}
+  virtual void TearDown() override {}
+public:
+  ObPieceMsgCtxMgr ctx_mgr_;
+};
+
+TEST_F(TestSkewDetect, is_popular)
+{
+  // 8 workers, 1000 rows: 250 rows make one worker receive twice the average rows
+  ASSERT_FALSE(ObSkewDetectPieceMsgCtx::is_popular(249, 1000, 8, 100));
+  ASSERT_TRUE(ObSkewDetectPieceMsgCtx::is_popular(250, 1000, 8, 100));
+  // frequency reaches min_freq
+  ASSERT_TRUE(ObSkewDetectPieceMsgCtx::is_popular(30, 1000, 8, 3));
+  ASSERT_FALSE(ObSkewDetectPieceMsgCtx::is_popular(29, 1000, 8, 3));
+  ASSERT_FALSE(ObSkewDetectPieceMsgCtx::is_popular(0, 1000, 8, 3));
+  ASSERT_FALSE(ObSkewDetectPieceMsgCtx::is_popular(10, 0, 8, 3));
+}
+
+TEST_F(TestSkewDetect, detect_and_fetch)
+{
+  const uint64_t build_op_id = 1;
+  const uint64_t probe_op_id = 2;
+  ObSkewDetectPieceMsgCtx build_ctx(build_op_id, 2, 0, OB_SYS_TENANT_ID, 10, ctx_mgr_);
+  ObSkewDetectPieceMsgCtx probe_ctx(probe_op_id, 2, 0, OB_SYS_TENANT_ID, 10, ctx_mgr_);
+  ASSERT_EQ(OB_SUCCESS, ctx_mgr_.add_piece_ctx(&build_ctx, dtl::DH_SKEW_DETECT_PIECE_MSG));
+
+  // two workers report value 7, only one reports value 9 and 11
+  build_ctx.dop_ = 4;
+  build_ctx.total_row_cnt_ = 2000;
+  ASSERT_EQ(OB_SUCCESS, build_ctx.candidates_.push_back(ObSkewValueFreq(7, 300)));
+  ASSERT_EQ(OB_SUCCESS, build_ctx.candidates_.push_back(ObSkewValueFreq(9, 150)));
+  ASSERT_EQ(OB_SUCCESS, build_ctx.candidates_.push_back(ObSkewValueFreq(7, 400)));
+  ASSERT_EQ(OB_SUCCESS, build_ctx.candidates_.push_back(ObSkewValueFreq(11, 500)));
+
+  ASSERT_EQ(OB_SUCCESS, build_ctx.detect_popular_values());
+  ASSERT_EQ(2, build_ctx.whole_msg_.popular_values_hash_.count());
+  ASSERT_EQ(7, build_ctx.whole_msg_.popular_values_hash_.at(0));
+  ASSERT_EQ(11, build_ctx.whole_msg_.popular_values_hash_.at(1));
+
+  build_ctx.reset_resource();
+  ASSERT_EQ(OB_SUCCESS, probe_ctx.fetch_popular_values(build_op_id));
+  ASSERT_EQ(2, probe_ctx.whole_msg_.popular_values_hash_.count());
+  ASSERT_EQ(7, probe_ctx.whole_msg_.popular_values_hash_.at(0));
+
+  // build side without skew detection, all rows are hash distributed
+  ASSERT_EQ(OB_SUCCESS, probe_ctx.fetch_popular_values(100));
+  ASSERT_EQ(0, probe_ctx.whole_msg_.popular_values_hash_.count());
+}
+
+TEST_F(TestSkewDetect, fetch_before_detect)
+{
+  const uint64_t build_op_id = 1;
+  const uint64_t probe_op_id = 2;
+  ObSkewDetectPieceMsgCtx build_ctx(build_op_id, 2, 0, OB_SYS_TENANT_ID, 10, ctx_mgr_);
+  ObSkewDetectPieceMsgCtx probe_ctx(probe_op_id, 2, 0, OB_SYS_TENANT_ID, 10, ctx_mgr_);
+  ASSERT_EQ(OB_SUCCESS, ctx_mgr_.add_piece_ctx(&build_ctx, dtl::DH_SKEW_DETECT_PIECE_MSG));
+  build_ctx.dop_ = 4;
+  build_ctx.total_row_cnt_ = 2000;
+  ASSERT_EQ(OB_SUCCESS, build_ctx.candidates_.push_back(ObSkewValueFreq(7, 700)));
+
+  // probe side asks before the build side decides, both sides get no popular value
+  ASSERT_EQ(OB_SUCCESS, probe_ctx.fetch_popular_values(build_op_id));
+  ASSERT_TRUE(probe_ctx.detected_);
+  ASSERT_EQ(0, probe_ctx.whole_msg_.popular_values_hash_.count());
+  ASSERT_TRUE(build_ctx.probe_fetched_);
+
+  ASSERT_EQ(OB_SUCCESS, build_ctx.detect_popular_values());
+  ASSERT_TRUE(build_ctx.detected_);
+  ASSERT_EQ(0, build_ctx.whole_msg_.popular_values_hash_.count());
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_skew_detect.log*");
+  OB_LOGGER.set_file_name("test_skew_detect.log", true, false);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,394 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+#define private public
+#define protected public
+
+#include "sql/engine/sort/ob_sort_op_impl.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_physical_plan.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "sql/ob_sql_init.h"
+#include "share/datum/ob_datum_funcs.h"
+#include "share/system_variable/ob_system_variable.h"
+#include "share/ob_simple_mem_limit_getter.h"
+#include "storage/blocksstable/ob_data_file_prepare.h"
+#include "storage/blocksstable/ob_tmp_file.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+using namespace omt;
+
+static ObSimpleMemLimitGetter getter;
+
+#define CALL(func, ...) func(__VA_ARGS__); ASSERT_FALSE(HasFatalFailure());
+
+// Rows are (key, id), key may be NULL. The leading sort key is used by the top-n batch filter,
+// id is the optional second sort key.
+struct TopnRow
+{
+  bool null_;
+  int64_t key_;
+  int64_t id_;
+};
+
+class TestSortTopnBatch : public blocksstable::TestDataFilePrepare
+{
+public:
+  static const int64_t BATCH_SIZE = 16;
+  static const int64_t COLS = 2;
+
+  TestSortTopnBatch()
+    : blocksstable::TestDataFilePrepare(&getter, "TestDisk_sort_topn_batch", 2<<20, 1000),
+      exec_ctx_(alloc_), eval_ctx_(exec_ctx_), skip_(NULL)
+  {
+  }
+
+  virtual void SetUp() override
+  {
+    ASSERT_EQ(OB_SUCCESS, init_tenant_mgr());
+    blocksstable::TestDataFilePrepare::SetUp();
+    ASSERT_EQ(OB_SUCCESS, blocksstable::ObTmpFileManager::get_instance().init());
+    ObString tenant_name("test");
+    ASSERT_EQ(OB_SUCCESS, session_.test_init(0, 0, 0, NULL));
+    ASSERT_EQ(OB_SUCCESS, ObPreProcessSysVars::init_sys_var());
+    ASSERT_EQ(OB_SUCCESS, session_.load_default_sys_variable(false, true));
+    ASSERT_EQ(OB_SUCCESS, session_.init_tenant(tenant_name, OB_SYS_TENANT_ID));
+    exec_ctx_.set_my_session(&session_);
+    ASSERT_EQ(OB_SUCCESS, exec_ctx_.create_physical_plan_ctx());
+    exec_ctx_.get_physical_plan_ctx()->set_timeout_timestamp(
+        ObTimeUtility::current_time() + 600L * 1000 * 1000);
+    eval_ctx_.set_max_batch_size(BATCH_SIZE);
+    init_exprs();
+    skip_ = to_bit_vector(alloc_.alloc(ObBitVector::memory_size(BATCH_SIZE)));
+    ASSERT_TRUE(NULL != skip_);
+  }
+
+  virtual void TearDown() override
+  {
+    blocksstable::ObTmpFileManager::get_instance().destroy();
+    blocksstable::TestDataFilePrepare::TearDown();
+  }
+
+  int init_tenant_mgr()
+  {
+    int ret = OB_SUCCESS;
+    ret = ObTenantConfigMgr::get_instance().add_tenant_config(OB_SYS_TENANT_ID);
+    EXPECT_EQ(OB_SUCCESS, ret);
+    ret = getter.add_tenant(OB_SYS_TENANT_ID,
+                            2L * 1024L * 1024L * 1024L, 4L * 1024L * 1024L * 1024L);
+    EXPECT_EQ(OB_SUCCESS, ret);
+    ret = getter.add_tenant(OB_SERVER_TENANT_ID, 128LL << 30, 128LL << 30);
+    EXPECT_EQ(OB_SUCCESS, ret);
+    oceanbase::lib::set_memory_limit(128LL << 32);
+    return ret;
+  }
+
+  void init_exprs()
+  {
+    int64_t pos = 0;
+    eval_ctx_.frames_ = static_cast<char **>(alloc_.alloc(sizeof(void *)));
+    ASSERT_TRUE(NULL != eval_ctx_.frames_);
+    int64_t frame_size = (sizeof(ObDatum) * BATCH_SIZE + sizeof(ObEvalInfo)) * COLS;
+    eval_ctx_.frames_[0] = static_cast<char *>(alloc_.alloc(frame_size));
+    ASSERT_TRUE(NULL != eval_ctx_.frames_[0]);
+    memset(eval_ctx_.frames_[0], 0, frame_size);
+    for (int64_t i = 0; i < COLS; ++i) {
+      ObExpr *expr = new (alloc_.alloc(sizeof(ObExpr))) ObExpr();
+      ASSERT_EQ(OB_SUCCESS, exprs_.push_back(expr));
+      expr->frame_idx_ = 0;
+      expr->datum_off_ = pos;
+      pos += sizeof(ObDatum) * BATCH_SIZE;
+      expr->eval_info_off_ = pos;
+      pos += sizeof(ObEvalInfo);
+      expr->batch_result_ = true;
+      expr->batch_idx_mask_ = UINT64_MAX;
+      expr->datum_meta_.type_ = ObIntType;
+      expr->obj_meta_.set_int();
+    }
+  }
+
+  void init_sort_keys(const bool is_ascending, const ObCmpNullPos null_pos, const int64_t key_cnt)
+  {
+    sort_collations_.reuse();
+    sort_cmp_funs_.reuse();
+    for (int64_t i = 0; i < key_cnt; i++) {
+      // only the leading key follows %is_ascending, id is always ascending
+      const bool asc = (0 == i) ? is_ascending : true;
+      ObSortFieldCollation collation(static_cast<uint32_t>(i), CS_TYPE_BINARY, asc, null_pos);
+      ObSortCmpFunc cmp_func;
+      cmp_func.cmp_func_ = ObDatumFuncs::get_nullsafe_cmp_func(
+          ObIntType, ObIntType, null_pos, CS_TYPE_BINARY, SCALE_UNKNOWN_YET, false, false);
+      ASSERT_TRUE(NULL != cmp_func.cmp_func_);
+      ASSERT_EQ(OB_SUCCESS, sort_collations_.push_back(collation));
+      ASSERT_EQ(OB_SUCCESS, sort_cmp_funs_.push_back(cmp_func));
+    }
+  }
+
+  // Feed %rows batch by batch, rows with id divisible by %skip_mod are skipped by the child.
+  void add_rows(ObSortOpImpl &sort, const std::vector<TopnRow> &rows, const int64_t skip_mod)
+  {
+    for (int64_t start = 0; start < static_cast<int64_t>(rows.size()); start += BATCH_SIZE) {
+      const int64_t size = std::min(BATCH_SIZE, static_cast<int64_t>(rows.size()) - start);
+      ObDatum *keys = exprs_.at(0)->locate_batch_datums(eval_ctx_);
+      ObDatum *ids = exprs_.at(1)->locate_batch_datums(eval_ctx_);
+      skip_->reset(BATCH_SIZE);
+      for (int64_t i = 0; i < size; i++) {
+        const TopnRow &row = rows.at(start + i);
+        // datums are attached to stored rows by get_next_batch(), point them back to the buffer
+        keys[i].ptr_ = reinterpret_cast<char *>(&key_buf_[i]);
+        ids[i].ptr_ = reinterpret_cast<char *>(&id_buf_[i]);
+        if (row.null_) {
+          keys[i].set_null();
+        } else {
+          keys[i].set_int(row.key_);
+        }
+        ids[i].set_int(row.id_);
+        if (skip_mod > 0 && 0 == row.id_ % skip_mod) {
+          skip_->set(i);
+        }
+      }
+      for (int64_t i = 0; i < COLS; i++) {
+        exprs_.at(i)->get_eval_info(eval_ctx_).evaluated_ = true;
+        exprs_.at(i)->get_eval_info(eval_ctx_).projected_ = true;
+      }
+      int64_t append_cnt = 0;
+      ASSERT_EQ(OB_SUCCESS, sort.add_batch(exprs_, *skip_, size, 0, &append_cnt));
+      // rows filtered by the heap top are consumed too
+      ASSERT_EQ(size - skip_->accumulate_bit_cnt(size), append_cnt);
+    }
+  }
+
+  void get_rows(ObSortOpImpl &sort, std::vector<TopnRow> &rows)
+  {
+    int ret = OB_SUCCESS;
+    rows.clear();
+    while (OB_SUCC(ret)) {
+      int64_t read_rows = 0;
+      if (OB_FAIL(sort.get_next_batch(exprs_, BATCH_SIZE, read_rows))) {
+        ASSERT_EQ(OB_ITER_END, ret);
+      } else {
+        ObDatum *keys = exprs_.at(0)->locate_batch_datums(eval_ctx_);
+        ObDatum *ids = exprs_.at(1)->locate_batch_datums(eval_ctx_);
+        for (int64_t i = 0; i < read_rows; i++) {
+          TopnRow row;
+          row.null_ = keys[i].is_null();
+          row.key_ = row.null_ ? 0 : keys[i].get_int();
+          row.id_ = ids[i].get_int();
+          rows.push_back(row);
+        }
+      }
+    }
+  }
+
+  // Expected result computed by full sort: first %topn rows, plus rows tied with the last one
+  // on the leading key if %with_ties.
+  void expected_rows(const std::vector<TopnRow> &input, const int64_t topn,
+                     const bool is_ascending, const ObCmpNullPos null_pos,
+                     const bool with_ties, const int64_t skip_mod,
+                     std::vector<TopnRow> &rows)
+  {
+    std::vector<TopnRow> sorted;
+    for (int64_t i = 0; i < static_cast<int64_t>(input.size()); i++) {
+      if (skip_mod <= 0 || 0 != input.at(i).id_ % skip_mod) {
+        sorted.push_back(input.at(i));
+      }
+    }
+    auto key = [&](const TopnRow &r) {
+      return r.null_ ? (NULL_LAST == null_pos ? INT64_MAX : INT64_MIN) : r.key_;
+    };
+    std::stable_sort(sorted.begin(), sorted.end(), [&](const TopnRow &l, const TopnRow &r) {
+      const int64_t lk = key(l);
+      const int64_t rk = key(r);
+      return lk != rk ? (is_ascending ? lk < rk : lk > rk) : l.id_ < r.id_;
+    });
+    rows.clear();
+    for (int64_t i = 0; i < static_cast<int64_t>(sorted.size()); i++) {
+      if (i < topn || (with_ties && i > 0 && !rows.empty()
+                       && key(sorted.at(i)) == key(rows.back()))) {
+        rows.push_back(sorted.at(i));
+      } else {
+        break;
+      }
+    }
+  }
+
+  void gen_rows(const int64_t cnt, const int64_t key_range, const int64_t null_mod,
+                std::vector<TopnRow> &rows)
+  {
+    rows.clear();
+    for (int64_t i = 0; i < cnt; i++) {
+      TopnRow row;
+      row.null_ = null_mod > 0 && 0 == i % null_mod;
+      // keys are spread so that later batches hold both better and worse rows than the heap top
+      row.key_ = row.null_ ? 0 : (i * 7919) % key_range;
+      row.id_ = i;
+      rows.push_back(row);
+    }
+  }
+
+  void run_topn(const std::vector<TopnRow> &input, const int64_t topn, const bool is_ascending,
+                const ObCmpNullPos null_pos, const bool with_ties, const int64_t skip_mod,
+                int64_t &filter_cnt)
+  {
+    ObMonitorNode monitor_info;
+    ObSortOpImpl sort(monitor_info);
+    // fetch with ties sorts by the leading key only, ties are output in any order
+    CALL(init_sort_keys, is_ascending, null_pos, with_ties ? 1 : 2);
+    ASSERT_EQ(OB_SUCCESS, sort.init(OB_SYS_TENANT_ID, &sort_collations_, &sort_cmp_funs_,
+                                    &eval_ctx_, &exec_ctx_, false /* enable_encode_sortkey */,
+                                    false /* in_local_order */, false /* need_rewind */,
+                                    0 /* part_cnt */, topn, with_ties));
+    CALL(add_rows, sort, input, skip_mod);
+    filter_cnt = sort.topn_filter_cnt_;
+    ASSERT_EQ(OB_SUCCESS, sort.sort());
+    std::vector<TopnRow> rows;
+    std::vector<TopnRow> expected;
+    CALL(get_rows, sort, rows);
+    CALL(expected_rows, input, topn, is_ascending, null_pos, with_ties, skip_mod, expected);
+    ASSERT_EQ(expected.size(), rows.size());
+    if (with_ties) {
+      // compare the key sequence, and the row set
+      auto by_id = [](const TopnRow &l, const TopnRow &r) { return l.id_ < r.id_; };
+      for (int64_t i = 0; i < static_cast<int64_t>(rows.size()); i++) {
+        ASSERT_EQ(expected.at(i).null_, rows.at(i).null_);
+        ASSERT_EQ(expected.at(i).key_, rows.at(i).key_);
+      }
+      std::sort(rows.begin(), rows.end(), by_id);
+      std::sort(expected.begin(), expected.end(), by_id);
+    }
+    for (int64_t i = 0; i < static_cast<int64_t>(rows.size()); i++) {
+      ASSERT_EQ(expected.at(i).id_, rows.at(i).id_) << "row " << i;
+      ASSERT_EQ(expected.at(i).null_, rows.at(i).null_) << "row " << i;
+      ASSERT_EQ(expected.at(i).key_, rows.at(i).key_) << "row " << i;
+    }
+    sort.reset();
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+  ObSQLSessionInfo session_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  ObSEArray<ObExpr *, COLS> exprs_;
+  ObSEArray<ObSortFieldCollation, COLS> sort_collations_;
+  ObSEArray<ObSortCmpFunc, COLS> sort_cmp_funs_;
+  ObBitVector *skip_;
+  int64_t key_buf_[BATCH_SIZE];
+  int64_t id_buf_[BATCH_SIZE];
+};
+
+TEST_F(TestSortTopnBatch, topn_less_than_batch)
+{
+  std::vector<TopnRow> input;
+  int64_t filter_cnt = 0;
+  // 50 distinct keys for 1000 rows, every key has ties
+  CALL(gen_rows, 1000, 50, 0, input);
+  CALL(run_topn, input, 5, true, NULL_LAST, false, 0, filter_cnt);
+  ASSERT_GT(filter_cnt, 0);
+  CALL(run_topn, input, 5, false, NULL_LAST, false, 0, filter_cnt);
+  ASSERT_GT(filter_cnt, 0);
+  CALL(run_topn, input, 1, true, NULL_FIRST, false, 0, filter_cnt);
+  ASSERT_GT(filter_cnt, 0);
+}
+
+TEST_F(TestSortTopnBatch, topn_larger_than_batch)
+{
+  std::vector<TopnRow> input;
+  int64_t filter_cnt = 0;
+  CALL(gen_rows, 1000, 50, 0, input);
+  CALL(run_topn, input, 3 * BATCH_SIZE + 5, true, NULL_LAST, false, 0, filter_cnt);
+  ASSERT_GT(filter_cnt, 0);
+  CALL(run_topn, input, 3 * BATCH_SIZE + 5, false, NULL_LAST, false, 0, filter_cnt);
+  ASSERT_GT(filter_cnt, 0);
+}
+
+TEST_F(TestSortTopnBatch, heap_not_full)
+{
+  std::vector<TopnRow> input;
+  int64_t filter_cnt = 0;
+  CALL(gen_rows, 100, 50, 0, input);
+  // nothing is filtered before the heap is full
+  CALL(run_topn, input, 100, true, NULL_LAST, false, 0, filter_cnt);
+  ASSERT_EQ(0, filter_cnt);
+  CALL(run_topn, input, 1000, true, NULL_LAST, false, 0, filter_cnt);
+  ASSERT_EQ(0, filter_cnt);
+}
+
+TEST_F(TestSortTopnBatch, ties)
+{
+  std::vector<TopnRow> input;
+  int64_t filter_cnt = 0;
+  // rows equal to the heap top on the leading key must reach the heap, the second key
+  // decides
+  CALL(gen_rows, 1000, 3, 0, input);
+  CALL(run_topn, input, 5, true, NULL_LAST, false, 0, filter_cnt);
+  CALL(run_topn, input, 5, false, NULL_LAST, false, 0, filter_cnt);
+  CALL(run_topn, input, 2 * BATCH_SIZE, true, NULL_LAST, false, 0, filter_cnt);
+  // all keys equal, nothing can be filtered by the leading key
+  CALL(gen_rows, 1000, 1, 0, input);
+  CALL(run_topn, input, 5, true, NULL_LAST, false, 0, filter_cnt);
+  ASSERT_EQ(0, filter_cnt);
+}
+
+TEST_F(TestSortTopnBatch, with_ties)
+{
+  std::vector<TopnRow> input;
+  int64_t filter_cnt = 0;
+  CALL(gen_rows, 1000, 50, 0, input);
+  CALL(run_topn, input, 5, true, NULL_LAST, true, 0, filter_cnt);
+  ASSERT_GT(filter_cnt, 0);
+  CALL(run_topn, input, 5, false, NULL_LAST, true, 0, filter_cnt);
+  ASSERT_GT(filter_cnt, 0);
+  CALL(run_topn, input, 3 * BATCH_SIZE + 5, true, NULL_LAST, true, 0, filter_cnt);
+  ASSERT_GT(filter_cnt, 0);
+  // every row ties with the heap top
+  CALL(gen_rows, 100, 1, 0, input);
+  CALL(run_topn, input, 5, true, NULL_LAST, true, 0, filter_cnt);
+  ASSERT_EQ(0, filter_cnt);
+}
+
+TEST_F(TestSortTopnBatch, null_and_skip)
+{
+  std::vector<TopnRow> input;
+  int64_t filter_cnt = 0;
+  // every 3rd key is NULL, every 5th row is skipped by the child
+  CALL(gen_rows, 1000, 50, 3, input);
+  CALL(run_topn, input, 5, true, NULL_LAST, false, 5, filter_cnt);
+  ASSERT_GT(filter_cnt, 0);
+  CALL(run_topn, input, 5, true, NULL_FIRST, false, 5, filter_cnt);
+  CALL(run_topn, input, 5, false, NULL_LAST, false, 5, filter_cnt);
+  CALL(run_topn, input, 5, false, NULL_FIRST, true, 5, filter_cnt);
+  CALL(run_topn, input, 3 * BATCH_SIZE + 5, true, NULL_FIRST, true, 5, filter_cnt);
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::sql::init_sql_factories();
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_sort_topn_batch.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,676 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "lib/compress/ob_compressor_pool.h"
+#include "share/ob_device_manager.h"
+#include "sql/engine/table/ob_parquet_table_row_iter.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+namespace
+{
+
+// Writer of the thrift compact protocol, only what the test files need.
+class ThriftWriter
+{
+public:
+  ThriftWriter() : last_field_id_(0) {}
+  void write_byte(const uint8_t v) { buf_.push_back(static_cast<char>(v)); }
+  void write_varint(uint64_t v)
+  {
+    while (v >= 0x80) {
+      write_byte(static_cast<uint8_t>(v | 0x80));
+      v >>= 7;
+    }
+    write_byte(static_cast<uint8_t>(v));
+  }
+  void write_zigzag(const int64_t v) { write_varint((static_cast<uint64_t>(v) << 1) ^ (v >> 63)); }
+  void field(const int16_t id, const uint8_t type)
+  {
+    const int16_t delta = id - last_field_id_;
+    if (delta > 0 && delta <= 15) {
+      write_byte(static_cast<uint8_t>(delta << 4 | type));
+    } else {
+      write_byte(type);
+      write_zigzag(id);
+    }
+    last_field_id_ = id;
+  }
+  void i32(const int16_t id, const int32_t v) { field(id, ObParquetThriftReader::T_I32); write_zigzag(v); }
+  void i64(const int16_t id, const int64_t v) { field(id, ObParquetThriftReader::T_I64); write_zigzag(v); }
+  void binary(const int16_t id, const std::string &v)
+  {
+    field(id, ObParquetThriftReader::T_BINARY);
+    write_varint(v.size());
+    buf_.append(v);
+  }
+  void list(const int16_t id, const uint8_t elem_type, const int64_t size)
+  {
+    field(id, ObParquetThriftReader::T_LIST);
+    if (size < 15) {
+      write_byte(static_cast<uint8_t>(size << 4 | elem_type));
+    } else {
+      write_byte(static_cast<uint8_t>(0xf0 | elem_type));
+      write_varint(size);
+    }
+  }
+  void struct_begin(const int16_t id) { field(id, ObParquetThriftReader::T_STRUCT); elem_begin(); }
+  // struct elements of lists have no field header
+  void elem_begin() { saved_ids_.push_back(last_field_id_); last_field_id_ = 0; }
+  void struct_end()
+  {
+    write_byte(ObParquetThriftReader::T_STOP);
+    last_field_id_ = saved_ids_.back();
+    saved_ids_.pop_back();
+  }
+  std::string buf_;
+private:
+  int16_t last_field_id_;
+  std::vector<int16_t> saved_ids_;
+};
+
+std::string to_bytes(const void *v, const int64_t len)
+{
+  return std::string(static_cast<const char *>(v), len);
+}
+
+// RLE / bit-packing hybrid encoded values in bit-packed runs
+std::string bit_pack(const std::vector<uint32_t> &values, const int64_t bit_width)
+{
+  std::string buf;
+  const int64_t groups = (values.size() + 7) / 8;
+  ThriftWriter header;
+  header.write_varint(groups << 1 | 1);
+  buf.append(header.buf_);
+  std::string bits(groups * bit_width, '\0');
+  for (int64_t i = 0; i < static_cast<int64_t>(values.size()); i++) {
+    for (int64_t b = 0; b < bit_width; b++) {
+      const int64_t pos = i * bit_width + b;
+      if ((values[i] >> b) & 1) {
+        bits[pos >> 3] |= static_cast<char>(1 << (pos & 7));
+      }
+    }
+  }
+  buf.append(bits);
+  return buf;
+}
+
+struct ColumnDef
+{
+  ObParquetPhysicalType type_;
+  ObParquetRepetition repetition_;
+  int32_t converted_type_;  // -1 for none
+  const char *name_;
+};
+
+// id BIGINT, score DOUBLE NULL, name VARCHAR NULL (dictionary), flag BOOLEAN, d DATE
+const ColumnDef COLUMNS[] = {
+  {PARQUET_INT64, PARQUET_REQUIRED, -1, "id"},
+  {PARQUET_DOUBLE, PARQUET_OPTIONAL, -1, "score"},
+  {PARQUET_BYTE_ARRAY, PARQUET_OPTIONAL, 0, "name"},
+  {PARQUET_BOOLEAN, PARQUET_REQUIRED, -1, "flag"},
+  {PARQUET_INT32, PARQUET_REQUIRED, 6, "d"},
+};
+const int64_t COLUMN_CNT = sizeof(COLUMNS) / sizeof(COLUMNS[0]);
+const char *DICT[] = {"a", "bb", "ccc"};
+// rows of the row groups, scores of the last row group are all null
+const int64_t ROW_GROUP_ROWS[] = {100, 150, 10};
+const int64_t ROW_GROUP_CNT = sizeof(ROW_GROUP_ROWS) / sizeof(ROW_GROUP_ROWS[0]);
+const int64_t ALL_NULL_SCORE_ROW_GROUP = 2;
+const int64_t DATE_BASE = 19000;
+
+bool score_is_null(const int64_t row, const int64_t row_group)
+{
+  return ALL_NULL_SCORE_ROW_GROUP == row_group || 0 == row % 3;
+}
+double score_of(const int64_t row) { return static_cast<double>(row) * 0.5; }
+bool name_is_null(const int64_t row) { return 0 == row % 5; }
+
+struct ChunkInfo
+{
+  int64_t codec_;
+  int64_t offset_;
+  int64_t dict_offset_;
+  int64_t size_;
+  int64_t null_cnt_;
+  std::string min_;
+  std::string max_;
+};
+
+class TestParquetReader : public ::testing::Test
+{
+public:
+  TestParquetReader() : allocator_("ParquetTest") {}
+  static void SetUpTestCase()
+  {
+    ASSERT_EQ(OB_SUCCESS, ObDeviceManager::get_instance().init_devices_env());
+    char cwd[1024];
+    ASSERT_TRUE(NULL != getcwd(cwd, sizeof(cwd)));
+    path_ = std::string(cwd) + "/test_parquet_reader.parquet";
+    write_file(path_);
+  }
+  static void TearDownTestCase()
+  {
+    unlink(path_.c_str());
+    ObDeviceManager::get_instance().destroy();
+  }
+  virtual void SetUp()
+  {
+    const std::string location = std::string("file://") + path_.substr(0, path_.rfind('/') + 1);
+    url_ = std::string("file://") + path_;
+    ASSERT_EQ(OB_SUCCESS, driver_.init(ObString(location.size(), location.c_str()), ObString()));
+    ASSERT_EQ(OB_SUCCESS, driver_.open(ObString(url_.size(), url_.c_str())));
+    ASSERT_EQ(OB_SUCCESS, read_meta());
+  }
+  virtual void TearDown()
+  {
+    meta_.reset();
+    driver_.close();
+    allocator_.reset();
+  }
+
+  static std::string data_page(const int64_t value_cnt, const int64_t encoding,
+                               const std::string &levels, const std::string &values,
+                               ObCompressor *compressor, std::string &page);
+  static void write_chunk(const int64_t column_idx, const int64_t row_group, const int64_t first_row,
+                          std::string &file, ChunkInfo &chunk);
+  static void write_file(const std::string &path);
+  int read_meta();
+  void read_and_check(const int64_t row_group, const int64_t batch_size);
+
+protected:
+  static std::string path_;
+  std::string url_;
+  ObArenaAllocator allocator_;
+  ObExternalDataAccessDriver driver_;
+  ObParquetFileMeta meta_;
+};
+
+std::string TestParquetReader::path_;
+
+// returns the page header, page is set to the page body
+std::string TestParquetReader::data_page(const int64_t value_cnt, const int64_t encoding,
+                                         const std::string &levels, const std::string &values,
+                                         ObCompressor *compressor, std::string &page)
+{
+  std::string raw;
+  if (!levels.empty()) {
+    const uint32_t len = static_cast<uint32_t>(levels.size());
+    raw.append(to_bytes(&len, sizeof(len)));
+    raw.append(levels);
+  }
+  raw.append(values);
+  page = raw;
+  if (NULL != compressor) {
+    int64_t max_overflow = 0;
+    int64_t compressed_len = 0;
+    EXPECT_EQ(OB_SUCCESS, compressor->get_max_overflow_size(raw.size(), max_overflow));
+    std::string dst(raw.size() + max_overflow, '\0');
+    EXPECT_EQ(OB_SUCCESS, compressor->compress(
+        raw.data(), raw.size(), &dst[0], dst.size(), compressed_len));
+    page = dst.substr(0, compressed_len);
+  }
+  ThriftWriter header;
+  header.elem_begin();
+  header.i32(1, PARQUET_DATA_PAGE);
+  header.i32(2, static_cast<int32_t>(raw.size()));
+  header.i32(3, static_cast<int32_t>(page.size()));
+  header.struct_begin(5);
+  header.i32(1, static_cast<int32_t>(value_cnt));
+  header.i32(2, static_cast<int32_t>(encoding));
+  header.i32(3, PARQUET_ENCODING_RLE);
+  header.i32(4, PARQUET_ENCODING_RLE);
+  header.struct_end();
+  header.struct_end();
+  return header.buf_;
+}
+
+void TestParquetReader::write_chunk(const int64_t column_idx, const int64_t row_group,
+                                    const int64_t first_row, std::string &file, ChunkInfo &chunk)
+{
+  const ColumnDef &column = COLUMNS[column_idx];
+  const int64_t row_cnt = ROW_GROUP_ROWS[row_group];
+  const int64_t chunk_start = file.size();
+  ObCompressor *compressor = NULL;
+  chunk.codec_ = PARQUET_CODEC_UNCOMPRESSED;
+  chunk.dict_offset_ = 0;
+  chunk.null_cnt_ = 0;
+  // the ids of the second row group are compressed and split into two pages
+  std::vector<int64_t> page_rows;
+  if (0 == column_idx && 1 == row_group) {
+    chunk.codec_ = PARQUET_CODEC_SNAPPY;
+    EXPECT_EQ(OB_SUCCESS, ObCompressorPool::get_instance().get_compressor(SNAPPY_COMPRESSOR, compressor));
+    page_rows.push_back(row_cnt / 2);
+    page_rows.push_back(row_cnt - row_cnt / 2);
+  } else {
+    page_rows.push_back(row_cnt);
+  }
+  if (2 == column_idx) {
+    std::string dict;
+    for (int64_t i = 0; i < 3; i++) {
+      const uint32_t len = static_cast<uint32_t>(strlen(DICT[i]));
+      dict.append(to_bytes(&len, sizeof(len)));
+      dict.append(DICT[i]);
+    }
+    ThriftWriter header;
+    header.elem_begin();
+    header.i32(1, PARQUET_DICTIONARY_PAGE);
+    header.i32(2, static_cast<int32_t>(dict.size()));
+    header.i32(3, static_cast<int32_t>(dict.size()));
+    header.struct_begin(7);
+    header.i32(1, 3);
+    header.i32(2, PARQUET_ENCODING_PLAIN_DICTIONARY);
+    header.struct_end();
+    header.struct_end();
+    chunk.dict_offset_ = file.size();
+    file.append(header.buf_);
+    file.append(dict);
+  }
+  chunk.offset_ = file.size();
+  int64_t row = first_row;
+  for (int64_t p = 0; p < static_cast<int64_t>(page_rows.size()); p++) {
+    std::vector<uint32_t> def_levels;
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> bools;
+    std::string values;
+    for (int64_t i = 0; i < page_rows[p]; i++, row++) {
+      bool is_null = false;
+      if (0 == column_idx) {
+        values.append(to_bytes(&row, sizeof(row)));
+      } else if (1 == column_idx) {
+        const double score = score_of(row);
+        is_null = score_is_null(row, row_group);
+        if (!is_null) {
+          values.append(to_bytes(&score, sizeof(score)));
+        }
+      } else if (2 == column_idx) {
+        is_null = name_is_null(row);
+        if (!is_null) {
+          indices.push_back(static_cast<uint32_t>(row % 3));
+        }
+      } else if (3 == column_idx) {
+        bools.push_back(row % 2);
+      } else {
+        const int32_t d = static_cast<int32_t>(DATE_BASE + row);
+        values.append(to_bytes(&d, sizeof(d)));
+      }
+      def_levels.push_back(!is_null);
+      chunk.null_cnt_ += is_null;
+    }
+    if (2 == column_idx) {
+      values.push_back(8);  // bit width of the indices
+      values.append(bit_pack(indices, 8));
+    } else if (3 == column_idx) {
+      // plain booleans are bit-packed without the run header
+      std::string packed = bit_pack(bools, 1);
+      values.append(packed.substr(1));
+    }
+    const std::string levels = PARQUET_OPTIONAL == column.repetition_ ? bit_pack(def_levels, 1) : "";
+    const int64_t encoding = 2 == column_idx ? PARQUET_ENCODING_RLE_DICTIONARY : PARQUET_ENCODING_PLAIN;
+    std::string page;
+    const std::string header = data_page(page_rows[p], encoding, levels, values, compressor, page);
+    file.append(header);
+    file.append(page);
+  }
+  chunk.size_ = file.size() - chunk_start;
+  // statistics of the fixed length columns
+  const int64_t last_row = first_row + row_cnt - 1;
+  if (0 == column_idx) {
+    chunk.min_ = to_bytes(&first_row, sizeof(first_row));
+    chunk.max_ = to_bytes(&last_row, sizeof(last_row));
+  } else if (1 == column_idx && chunk.null_cnt_ < row_cnt) {
+    double min = 0;
+    double max = 0;
+    bool has_value = false;
+    for (int64_t r = first_row; r <= last_row; r++) {
+      if (!score_is_null(r, row_group)) {
+        min = has_value ? std::min(min, score_of(r)) : score_of(r);
+        max = has_value ? std::max(max, score_of(r)) : score_of(r);
+        has_value = true;
+      }
+    }
+    chunk.min_ = to_bytes(&min, sizeof(min));
+    chunk.max_ = to_bytes(&max, sizeof(max));
+  } else if (4 == column_idx) {
+    const int32_t min = static_cast<int32_t>(DATE_BASE + first_row);
+    const int32_t max = static_cast<int32_t>(DATE_BASE + last_row);
+    chunk.min_ = to_bytes(&min, sizeof(min));
+    chunk.max_ = to_bytes(&max, sizeof(max));
+  }
+}
+
+void TestParquetReader::write_file(const std::string &path)
+{
+  std::string file(ObParquetFileMeta::MAGIC);
+  std::vector<std::vector<ChunkInfo> > chunks(ROW_GROUP_CNT, std::vector<ChunkInfo>(COLUMN_CNT));
+  int64_t num_rows = 0;
+  for (int64_t rg = 0; rg < ROW_GROUP_CNT; rg++) {
+    for (int64_t c = 0; c < COLUMN_CNT; c++) {
+      write_chunk(c, rg, num_rows, file, chunks[rg][c]);
+    }
+    num_rows += ROW_GROUP_ROWS[rg];
+  }
+  ThriftWriter meta;
+  meta.elem_begin();
+  meta.i32(1, 1);
+  meta.list(2, ObParquetThriftReader::T_STRUCT, COLUMN_CNT + 1);
+  meta.elem_begin();
+  meta.binary(4, "schema");
+  meta.i32(5, COLUMN_CNT);
+  meta.struct_end();
+  for (int64_t c = 0; c < COLUMN_CNT; c++) {
+    meta.elem_begin();
+    meta.i32(1, COLUMNS[c].type_);
+    meta.i32(3, COLUMNS[c].repetition_);
+    meta.binary(4, COLUMNS[c].name_);
+    if (COLUMNS[c].converted_type_ >= 0) {
+      meta.i32(6, COLUMNS[c].converted_type_);
+    }
+    meta.struct_end();
+  }
+  meta.i64(3, num_rows);
+  meta.list(4, ObParquetThriftReader::T_STRUCT, ROW_GROUP_CNT);
+  for (int64_t rg = 0; rg < ROW_GROUP_CNT; rg++) {
+    meta.elem_begin();
+    meta.list(1, ObParquetThriftReader::T_STRUCT, COLUMN_CNT);
+    int64_t total_size = 0;
+    for (int64_t c = 0; c < COLUMN_CNT; c++) {
+      const ChunkInfo &chunk = chunks[rg][c];
+      meta.elem_begin();
+      meta.i64(2, chunk.offset_);
+      meta.struct_begin(3);
+      meta.i32(1, COLUMNS[c].type_);
+      meta.list(2, ObParquetThriftReader::T_I32, 2);
+      meta.write_zigzag(PARQUET_ENCODING_PLAIN);
+      meta.write_zigzag(PARQUET_ENCODING_RLE);
+      meta.list(3, ObParquetThriftReader::T_BINARY, 1);
+      meta.write_varint(strlen(COLUMNS[c].name_));
+      meta.buf_.append(COLUMNS[c].name_);
+      meta.i32(4, static_cast<int32_t>(chunk.codec_));
+      meta.i64(5, ROW_GROUP_ROWS[rg]);
+      meta.i64(6, chunk.size_);
+      meta.i64(7, chunk.size_);
+      meta.i64(9, chunk.offset_);
+      if (chunk.dict_offset_ > 0) {
+        meta.i64(11, chunk.dict_offset_);
+      }
+      meta.struct_begin(12);
+      meta.i64(3, chunk.null_cnt_);
+      if (!chunk.max_.empty()) {
+        meta.binary(5, chunk.max_);
+        meta.binary(6, chunk.min_);
+      }
+      meta.struct_end();
+      meta.struct_end();
+      meta.struct_end();
+      total_size += chunk.size_;
+    }
+    meta.i64(2, total_size);
+    meta.i64(3, ROW_GROUP_ROWS[rg]);
+    meta.struct_end();
+  }
+  meta.struct_end();
+  const uint32_t meta_len = static_cast<uint32_t>(meta.buf_.size());
+  file.append(meta.buf_);
+  file.append(to_bytes(&meta_len, sizeof(meta_len)));
+  file.append(ObParquetFileMeta::MAGIC);
+  FILE *fp = fopen(path.c_str(), "w");
+  ASSERT_TRUE(NULL != fp);
+  ASSERT_EQ(file.size(), fwrite(file.data(), 1, file.size(), fp));
+  fclose(fp);
+}
+
+int TestParquetReader::read_meta()
+{
+  int ret = OB_SUCCESS;
+  int64_t file_size = 0;
+  int64_t read_size = 0;
+  uint32_t meta_len = 0;
+  char footer[ObParquetFileMeta::FOOTER_SIZE];
+  char *buf = NULL;
+  if (OB_FAIL(driver_.get_file_size(ObString(url_.size(), url_.c_str()), file_size))) {
+    LOG_WARN("fail to get file size", K(ret));
+  } else if (OB_FAIL(driver_.pread(footer, sizeof(footer), file_size - sizeof(footer), read_size))) {
+    LOG_WARN("fail to read footer", K(ret));
+  } else if (FALSE_IT(MEMCPY(&meta_len, footer, sizeof(meta_len)))) {
+  } else if (OB_ISNULL(buf = static_cast<char *>(allocator_.alloc(meta_len)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else if (OB_FAIL(driver_.pread(buf, meta_len, file_size - sizeof(footer) - meta_len, read_size))) {
+    LOG_WARN("fail to read meta", K(ret));
+  } else if (OB_FAIL(meta_.deserialize(buf, meta_len, allocator_))) {
+    LOG_WARN("fail to deserialize meta", K(ret));
+  }
+  return ret;
+}
+
+void TestParquetReader::read_and_check(const int64_t row_group, const int64_t batch_size)
+{
+  int64_t first_row = 0;
+  for (int64_t rg = 0; rg < row_group; rg++) {
+    first_row += ROW_GROUP_ROWS[rg];
+  }
+  const ObParquetRowGroupMeta &meta = *meta_.row_groups_.at(row_group);
+  ObParquetColumnReader readers[COLUMN_CNT];
+  ObParquetValueBatch batches[COLUMN_CNT];
+  for (int64_t c = 0; c < COLUMN_CNT; c++) {
+    ASSERT_EQ(OB_SUCCESS, readers[c].open(driver_, meta_.columns_.at(c), meta.columns_.at(c), allocator_));
+    ASSERT_EQ(OB_SUCCESS, batches[c].init(batch_size, allocator_));
+  }
+  for (int64_t done = 0; done < meta.num_rows_; ) {
+    const int64_t cnt = std::min(batch_size, meta.num_rows_ - done);
+    for (int64_t c = 0; c < COLUMN_CNT; c++) {
+      ASSERT_EQ(OB_SUCCESS, readers[c].read(cnt, batches[c]));
+    }
+    for (int64_t i = 0; i < cnt; i++) {
+      const int64_t row = first_row + done + i;
+      ASSERT_FALSE(batches[0].nulls_[i]);
+      ASSERT_EQ(row, batches[0].fixed_[i]);
+      ASSERT_EQ(score_is_null(row, row_group), batches[1].nulls_[i]) << row;
+      if (!batches[1].nulls_[i]) {
+        ASSERT_EQ(score_of(row), batches[1].get_double(i));
+      }
+      ASSERT_EQ(name_is_null(row), batches[2].nulls_[i]) << row;
+      if (!batches[2].nulls_[i]) {
+        ASSERT_EQ(0, batches[2].strs_[i].compare(DICT[row % 3]));
+      }
+      ASSERT_EQ(row % 2, batches[3].fixed_[i]);
+      ASSERT_EQ(DATE_BASE + row, batches[4].fixed_[i]);
+    }
+    done += cnt;
+  }
+}
+
+TEST_F(TestParquetReader, file_meta)
+{
+  ASSERT_EQ(260, meta_.num_rows_);
+  ASSERT_EQ(COLUMN_CNT, meta_.columns_.count());
+  for (int64_t c = 0; c < COLUMN_CNT; c++) {
+    ASSERT_EQ(COLUMNS[c].type_, meta_.columns_.at(c).physical_type_);
+    ASSERT_EQ(COLUMNS[c].repetition_, meta_.columns_.at(c).repetition_);
+    ASSERT_EQ(0, meta_.columns_.at(c).name_.compare(COLUMNS[c].name_));
+  }
+  ASSERT_EQ(PARQUET_LOGICAL_NONE, meta_.columns_.at(0).logical_type_);
+  ASSERT_EQ(PARQUET_LOGICAL_STRING, meta_.columns_.at(2).logical_type_);
+  ASSERT_EQ(PARQUET_LOGICAL_DATE, meta_.columns_.at(4).logical_type_);
+  ASSERT_EQ(ROW_GROUP_CNT, meta_.row_groups_.count());
+  for (int64_t rg = 0; rg < ROW_GROUP_CNT; rg++) {
+    const ObParquetRowGroupMeta &row_group = *meta_.row_groups_.at(rg);
+    ASSERT_EQ(ROW_GROUP_ROWS[rg], row_group.num_rows_);
+    ASSERT_EQ(COLUMN_CNT, row_group.columns_.count());
+    ASSERT_TRUE(row_group.columns_.at(0).stat_.has_min_max());
+    ASSERT_FALSE(row_group.columns_.at(2).stat_.has_min_max());
+    ASSERT_TRUE(row_group.columns_.at(2).dictionary_page_offset_ > 0);
+    ASSERT_EQ(row_group.columns_.at(2).dictionary_page_offset_,
+              row_group.columns_.at(2).get_chunk_offset());
+  }
+  ASSERT_EQ(PARQUET_CODEC_SNAPPY, meta_.row_groups_.at(1)->columns_.at(0).codec_);
+  const ObParquetStatistics &stat = meta_.row_groups_.at(ALL_NULL_SCORE_ROW_GROUP)->columns_.at(1).stat_;
+  ASSERT_TRUE(stat.has_null_count_);
+  ASSERT_EQ(ROW_GROUP_ROWS[ALL_NULL_SCORE_ROW_GROUP], stat.null_count_);
+  ASSERT_FALSE(stat.has_min_max());
+}
+
+TEST_F(TestParquetReader, truncated_meta)
+{
+  ObParquetFileMeta meta;
+  ObArenaAllocator allocator;
+  const char buf[] = {0x29, 0x3c};  // schema list of 3 structs without elements
+  ASSERT_EQ(OB_INVALID_DATA, meta.deserialize(buf, sizeof(buf), allocator));
+}
+
+TEST_F(TestParquetReader, read_types_and_nulls)
+{
+  // batches smaller than, across and larger than pages
+  const int64_t batch_sizes[] = {1, 7, 64, 256};
+  for (int64_t b = 0; b < 4; b++) {
+    for (int64_t rg = 0; rg < ROW_GROUP_CNT; rg++) {
+      read_and_check(rg, batch_sizes[b]);
+    }
+  }
+}
+
+TEST_F(TestParquetReader, skip_rows)
+{
+  // the ids of row group 1 are in two pages of 75 rows
+  const ObParquetRowGroupMeta &meta = *meta_.row_groups_.at(1);
+  ObParquetColumnReader id_reader;
+  ObParquetColumnReader name_reader;
+  ObParquetValueBatch batch;
+  ASSERT_EQ(OB_SUCCESS, batch.init(16, allocator_));
+  ASSERT_EQ(OB_SUCCESS, id_reader.open(driver_, meta_.columns_.at(0), meta.columns_.at(0), allocator_));
+  ASSERT_EQ(OB_SUCCESS, name_reader.open(driver_, meta_.columns_.at(2), meta.columns_.at(2), allocator_));
+  // skip the whole first page
+  ASSERT_EQ(OB_SUCCESS, id_reader.skip(80, batch));
+  ASSERT_EQ(OB_SUCCESS, id_reader.read(16, batch));
+  for (int64_t i = 0; i < 16; i++) {
+    ASSERT_EQ(180 + i, batch.fixed_[i]);
+  }
+  // skip within the dictionary encoded page
+  ASSERT_EQ(OB_SUCCESS, name_reader.skip(33, batch));
+  ASSERT_EQ(OB_SUCCESS, name_reader.read(16, batch));
+  for (int64_t i = 0; i < 16; i++) {
+    const int64_t row = 133 + i;
+    ASSERT_EQ(name_is_null(row), batch.nulls_[i]);
+    if (!batch.nulls_[i]) {
+      ASSERT_EQ(0, batch.strs_[i].compare(DICT[row % 3]));
+    }
+  }
+}
+
+TEST_F(TestParquetReader, rle_decoder)
+{
+  // rle run of 10 fives, bit-packed run of 8 values, rle run of 3 sevens, bit width 3
+  std::vector<uint32_t> packed_values;
+  for (uint32_t i = 0; i < 8; i++) {
+    packed_values.push_back(i);
+  }
+  std::string buf;
+  buf.push_back(10 << 1);
+  buf.push_back(5);
+  buf.append(bit_pack(packed_values, 3));
+  buf.push_back(3 << 1);
+  buf.push_back(7);
+  ObParquetRleDecoder decoder;
+  uint32_t values[21];
+  ASSERT_EQ(OB_SUCCESS, decoder.init(buf.data(), buf.size(), 3));
+  ASSERT_EQ(OB_SUCCESS, decoder.get_batch(values, 4));
+  ASSERT_EQ(OB_SUCCESS, decoder.get_batch(values + 4, 17));
+  for (int64_t i = 0; i < 10; i++) {
+    ASSERT_EQ(5, values[i]);
+  }
+  for (int64_t i = 0; i < 8; i++) {
+    ASSERT_EQ(i, values[10 + i]);
+  }
+  for (int64_t i = 18; i < 21; i++) {
+    ASSERT_EQ(7, values[i]);
+  }
+  ASSERT_EQ(OB_INVALID_DATA, decoder.get_batch(values, 1));
+}
+
+TEST_F(TestParquetReader, row_group_filter)
+{
+  typedef ObParquetTableRowIterator Iter;
+  char value_buf[16];
+  ObDatum value;
+  value.ptr_ = value_buf;
+  // id: [0, 99], [100, 249], [250, 259]
+  const int64_t id_expects[][5] = {
+    // value, op, skip row groups 0, 1, 2
+    {50, T_OP_EQ, 0, 1, 1},
+    {100, T_OP_LT, 0, 1, 1},
+    {99, T_OP_GT, 1, 0, 0},
+    {250, T_OP_GE, 1, 1, 0},
+    {249, T_OP_LE, 0, 0, 1},
+    {300, T_OP_EQ, 1, 1, 1},
+    {50, T_OP_NE, 0, 0, 0},
+  };
+  for (int64_t i = 0; i < static_cast<int64_t>(sizeof(id_expects) / sizeof(id_expects[0])); i++) {
+    value.set_int(id_expects[i][0]);
+    for (int64_t rg = 0; rg < ROW_GROUP_CNT; rg++) {
+      const ObParquetRowGroupMeta &row_group = *meta_.row_groups_.at(rg);
+      ASSERT_EQ(1 == id_expects[i][2 + rg], Iter::is_never_true_by_stat(
+          Iter::DIRECT_INT, static_cast<ObItemType>(id_expects[i][1]), PARQUET_INT64,
+          row_group.columns_.at(0).stat_, row_group.num_rows_, value)) << i << " " << rg;
+    }
+  }
+  // columns without direct types and null consts never skip
+  for (int64_t rg = 0; rg < ROW_GROUP_CNT; rg++) {
+    const ObParquetRowGroupMeta &row_group = *meta_.row_groups_.at(rg);
+    value.set_int(1000);
+    ASSERT_FALSE(Iter::is_never_true_by_stat(Iter::DIRECT_NONE, T_OP_EQ, PARQUET_INT64,
+                                             row_group.columns_.at(0).stat_, row_group.num_rows_, value));
+    value.set_null();
+    ASSERT_FALSE(Iter::is_never_true_by_stat(Iter::DIRECT_INT, T_OP_EQ, PARQUET_INT64,
+                                             row_group.columns_.at(0).stat_, row_group.num_rows_, value));
+  }
+  // score of the last row group is all null, any compare is false
+  value.set_double(0.5);
+  for (int64_t rg = 0; rg < ROW_GROUP_CNT; rg++) {
+    const ObParquetRowGroupMeta &row_group = *meta_.row_groups_.at(rg);
+    ASSERT_EQ(0 != rg, Iter::is_never_true_by_stat(Iter::DIRECT_DOUBLE, T_OP_EQ, PARQUET_DOUBLE,
+                                                   row_group.columns_.at(1).stat_, row_group.num_rows_, value));
+  }
+  value.set_double(100.0);
+  ASSERT_FALSE(Iter::is_never_true_by_stat(Iter::DIRECT_DOUBLE, T_OP_GE, PARQUET_DOUBLE,
+                                           meta_.row_groups_.at(1)->columns_.at(1).stat_,
+                                           meta_.row_groups_.at(1)->num_rows_, value));
+  ASSERT_TRUE(Iter::is_never_true_by_stat(Iter::DIRECT_DOUBLE, T_OP_GT, PARQUET_DOUBLE,
+                                          meta_.row_groups_.at(0)->columns_.at(1).stat_,
+                                          meta_.row_groups_.at(0)->num_rows_, value));
+  // dates are compared by days
+  value.set_date(static_cast<int32_t>(DATE_BASE + 120));
+  for (int64_t rg = 0; rg < ROW_GROUP_CNT; rg++) {
+    const ObParquetRowGroupMeta &row_group = *meta_.row_groups_.at(rg);
+    ASSERT_EQ(1 != rg, Iter::is_never_true_by_stat(Iter::DIRECT_DATE, T_OP_EQ, PARQUET_INT32,
+                                                   row_group.columns_.at(4).stat_, row_group.num_rows_, value));
+  }
+  // strings have no statistics here
+  value.set_int(0);
+  ASSERT_FALSE(Iter::is_never_true_by_stat(Iter::DIRECT_INT, T_OP_EQ, PARQUET_BYTE_ARRAY,
+                                           meta_.row_groups_.at(0)->columns_.at(2).stat_,
+                                           meta_.row_groups_.at(0)->num_rows_, value));
+}
+
+} // end namespace
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -12,7 +12,9 @@
 
 #include <gtest/gtest.h>
 #include "share/ob_define.h"
+#define private public
 #include "sql/engine/ob_physical_plan.h"
+#undef private
 using namespace oceanbase::common;
 using namespace oceanbase::share::schema;
 namespace oceanbase
@@ -42,6 +44,74 @@ TEST_F(TestPhysicalPlan,  test_get_view_table)
   }
   EXPECT_EQ(VIEW_COUNT, plan.get_dependency_table_size());
 }
+
+// one execution of a plan hit in plan cache with one join checking its join method
+static void exec_join_method_check(ObPhysicalPlan &plan, const bool misestimated,
+                                   const bool is_plan_cache_hit = true)
+{
+  plan.inc_join_method_check_times(is_plan_cache_hit);
+  if (misestimated) {
+    plan.report_join_card_misestimate(is_plan_cache_hit);
+  }
+}
+
+TEST_F(TestPhysicalPlan, test_join_card_misestimate_expire)
+{
+  // most checks of the sample are misestimated
+  ObPhysicalPlan plan;
+  for (int64_t i = 0; i < ObPhysicalPlan::JOIN_CARD_SAMPLE_TIMES / 2; i++) {
+    exec_join_method_check(plan, true);
+    EXPECT_FALSE(plan.is_expired());
+  }
+  exec_join_method_check(plan, true);
+  EXPECT_TRUE(plan.is_expired());
+
+  // misestimated after some good executions
+  ObPhysicalPlan plan2;
+  for (int64_t i = 0; i < 4; i++) {
+    exec_join_method_check(plan2, false);
+  }
+  for (int64_t i = 0; i < ObPhysicalPlan::JOIN_CARD_SAMPLE_TIMES / 2; i++) {
+    exec_join_method_check(plan2, true);
+    EXPECT_FALSE(plan2.is_expired());
+  }
+  exec_join_method_check(plan2, true);
+  EXPECT_TRUE(plan2.is_expired());
+}
+
+TEST_F(TestPhysicalPlan, test_join_card_misestimate_keep)
+{
+  // alternating params, half of the executions are misestimated
+  ObPhysicalPlan plan;
+  for (int64_t i = 0; i < 10 * ObPhysicalPlan::JOIN_CARD_SAMPLE_TIMES; i++) {
+    exec_join_method_check(plan, 0 == i % 2);
+  }
+  EXPECT_FALSE(plan.is_expired());
+
+  // misestimates of a sample are not accumulated into the next one
+  ObPhysicalPlan plan2;
+  for (int64_t i = 0; i < 3 * ObPhysicalPlan::JOIN_CARD_SAMPLE_TIMES; i++) {
+    exec_join_method_check(plan2, i % ObPhysicalPlan::JOIN_CARD_SAMPLE_TIMES
+                                  >= ObPhysicalPlan::JOIN_CARD_SAMPLE_TIMES / 2);
+  }
+  EXPECT_FALSE(plan2.is_expired());
+
+  // misestimated in the execution generating the plan, generating it again won't help
+  ObPhysicalPlan plan3;
+  exec_join_method_check(plan3, true, false);
+  for (int64_t i = 0; i < 10 * ObPhysicalPlan::JOIN_CARD_SAMPLE_TIMES; i++) {
+    exec_join_method_check(plan3, true);
+  }
+  EXPECT_FALSE(plan3.is_expired());
+
+  // not misestimated in the execution generating the plan
+  ObPhysicalPlan plan4;
+  exec_join_method_check(plan4, false, false);
+  for (int64_t i = 0; i <= ObPhysicalPlan::JOIN_CARD_SAMPLE_TIMES / 2; i++) {
+    exec_join_method_check(plan4, true);
+  }
+  EXPECT_TRUE(plan4.is_expired());
+}
 } //namespace sql
 } //namespace oceanbase
 
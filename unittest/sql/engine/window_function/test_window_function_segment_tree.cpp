@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#include "sql/engine/window_function/ob_window_function_segment_tree.h"
+#include "lib/time/ob_time_utility.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+static int int_cmp(const ObDatum &l, const ObDatum &r, int &cmp_ret)
+{
+  cmp_ret = l.get_int() < r.get_int() ? -1 : (l.get_int() > r.get_int() ? 1 : 0);
+  return OB_SUCCESS;
+}
+
+static const int64_t MAX_MEM_SIZE = 64L << 20;
+
+class TestWindowFunctionSegmentTree : public ::testing::Test
+{
+public:
+  TestWindowFunctionSegmentTree() : is_desc_(false) {}
+  ~TestWindowFunctionSegmentTree() {}
+
+  // value of row i, every 7th row is NULL
+  static bool is_null_row(const int64_t i) { return 0 == i % 7; }
+  // descending values move the max of a sliding frame out of it for each row
+  int64_t row_value(const int64_t i) const { return is_desc_ ? 1000000 - i : (i * 7919) % 10007; }
+
+  void build(ObWindowFunctionSegmentTree &tree, const int64_t row_cnt)
+  {
+    ObDatum datum;
+    int64_t value = 0;
+    ASSERT_EQ(OB_SUCCESS, tree.start_build(row_cnt));
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      if (is_null_row(i)) {
+        datum.set_null();
+      } else {
+        value = row_value(i);
+        datum.set_int(value);
+      }
+      ASSERT_EQ(OB_SUCCESS, tree.add_leaf(datum));
+    }
+    ASSERT_EQ(OB_SUCCESS, tree.finish_build());
+  }
+
+  // re-aggregate the frame row by row, as window function does for MIN/MAX when frame head slides
+  int64_t naive_query(const bool is_max, const int64_t head, const int64_t tail, bool &is_null) const
+  {
+    int64_t res = 0;
+    is_null = true;
+    for (int64_t i = head; i <= tail; ++i) {
+      if (!is_null_row(i)) {
+        const int64_t v = row_value(i);
+        if (is_null || (is_max ? v > res : v < res)) {
+          res = v;
+        }
+        is_null = false;
+      }
+    }
+    return res;
+  }
+
+  // MAX of the sliding frames as REMOVE_EXTRENUM does: the rows entering the frame are added,
+  // the frame is re-aggregated only when the row of the max slides out of it.
+  int64_t extrenum_sum(const int64_t row_cnt, const int64_t n) const
+  {
+    int64_t sum = 0;
+    int64_t max_idx = -1;
+    int64_t last_tail = -1;
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      const int64_t head = std::max(0L, i - n);
+      const int64_t tail = std::min(row_cnt - 1, i + n);
+      if (max_idx >= 0 && max_idx < head) {
+        max_idx = -1;
+        last_tail = head - 1;
+      }
+      for (int64_t j = std::max(head, last_tail + 1); j <= tail; ++j) {
+        if (!is_null_row(j) && (max_idx < 0 || row_value(j) >= row_value(max_idx))) {
+          max_idx = j;
+        }
+      }
+      last_tail = tail;
+      sum += max_idx < 0 ? 0 : row_value(max_idx);
+    }
+    return sum;
+  }
+
+protected:
+  bool is_desc_;
+};
+
+TEST_F(TestWindowFunctionSegmentTree, query)
+{
+  const int64_t row_cnt = 1000;
+  for (int64_t k = 0; k < 2; ++k) {
+    const bool is_max = (0 == k);
+    ObWindowFunctionSegmentTree tree;
+    ASSERT_EQ(OB_SUCCESS, tree.init(is_max, int_cmp, OB_SYS_TENANT_ID, MAX_MEM_SIZE));
+    build(tree, row_cnt);
+    ASSERT_EQ(row_cnt, tree.get_leaf_count());
+
+    for (int64_t head = 0; head < row_cnt; head += 13) {
+      for (int64_t tail = head; tail < row_cnt; tail += 17) {
+        int64_t leaf = -1;
+        bool is_null = false;
+        const int64_t expect = naive_query(is_max, head, tail, is_null);
+        ASSERT_EQ(OB_SUCCESS, tree.query(head, tail, leaf));
+        if (is_null) {
+          ASSERT_EQ(-1, leaf);
+        } else {
+          ASSERT_LE(head, leaf);
+          ASSERT_GE(tail, leaf);
+          ASSERT_EQ(expect, tree.get_value(leaf).get_int());
+        }
+      }
+    }
+    // single NULL row
+    int64_t leaf = 0;
+    ASSERT_EQ(OB_SUCCESS, tree.query(7, 7, leaf));
+    ASSERT_EQ(-1, leaf);
+
+    ASSERT_EQ(OB_INVALID_ARGUMENT, tree.query(-1, 3, leaf));
+    ASSERT_EQ(OB_INVALID_ARGUMENT, tree.query(5, row_cnt, leaf));
+    ASSERT_EQ(OB_INVALID_ARGUMENT, tree.query(5, 4, leaf));
+
+    // rebuild for a smaller partition
+    build(tree, 3);
+    ASSERT_EQ(OB_SUCCESS, tree.query(0, 2, leaf));
+    ASSERT_EQ(is_max ? 1 : 2, leaf);
+  }
+}
+
+TEST_F(TestWindowFunctionSegmentTree, build_error)
+{
+  ObWindowFunctionSegmentTree tree;
+  ObDatum datum;
+  int64_t leaf = -1;
+  datum.set_int(1);
+  ASSERT_EQ(OB_NOT_INIT, tree.start_build(10));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, tree.init(true, NULL, OB_SYS_TENANT_ID, MAX_MEM_SIZE));
+  ASSERT_EQ(OB_SUCCESS, tree.init(true, int_cmp, OB_SYS_TENANT_ID, MAX_MEM_SIZE));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, tree.start_build(0));
+  ASSERT_EQ(OB_SUCCESS, tree.start_build(2));
+  ASSERT_EQ(OB_SUCCESS, tree.add_leaf(datum));
+  ASSERT_EQ(OB_ERR_UNEXPECTED, tree.finish_build());
+  ASSERT_EQ(OB_ERR_UNEXPECTED, tree.query(0, 0, leaf));
+  ASSERT_EQ(OB_SUCCESS, tree.add_leaf(datum));
+  ASSERT_EQ(OB_SIZE_OVERFLOW, tree.add_leaf(datum));
+  ASSERT_EQ(OB_SUCCESS, tree.finish_build());
+  ASSERT_EQ(OB_SUCCESS, tree.query(0, 1, leaf));
+  ASSERT_EQ(1, tree.get_value(leaf).get_int());
+}
+
+TEST_F(TestWindowFunctionSegmentTree, mem_limit)
+{
+  ObWindowFunctionSegmentTree tree;
+  const int64_t max_mem_size = ObWindowFunctionSegmentTree::get_fixed_mem_size(100) + 1024;
+  char buf[128];
+  ObDatum datum;
+  MEMSET(buf, 'a', sizeof(buf));
+  datum.set_string(buf, sizeof(buf));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, tree.init(true, int_cmp, OB_SYS_TENANT_ID, 0));
+  ASSERT_EQ(OB_SUCCESS, tree.init(true, int_cmp, OB_SYS_TENANT_ID, max_mem_size));
+  // leaves and nodes exceed the limit
+  ASSERT_EQ(OB_EXCEED_MEM_LIMIT, tree.start_build(200));
+  ASSERT_FALSE(tree.is_built());
+  // deep copied values exceed the limit
+  ASSERT_EQ(OB_SUCCESS, tree.start_build(100));
+  int ret = OB_SUCCESS;
+  int64_t added_cnt = 0;
+  for (; OB_SUCC(ret) && added_cnt < 100; ++added_cnt) {
+    ret = tree.add_leaf(datum);
+  }
+  ASSERT_EQ(OB_EXCEED_MEM_LIMIT, ret);
+  ASSERT_GT(100, added_cnt);
+  // a smaller partition still fits after the tree is released
+  tree.reuse();
+  ASSERT_LE(tree.get_mem_used(), max_mem_size);
+  build(tree, 50);
+  ASSERT_TRUE(tree.is_built());
+  ASSERT_LE(tree.get_mem_used(), max_mem_size);
+}
+
+// MAX() OVER (ROWS BETWEEN n PRECEDING AND n FOLLOWING) of one partition, computed by
+// re-aggregating each frame, by REMOVE_EXTRENUM and by querying the segment tree.
+// REMOVE_EXTRENUM re-aggregates a frame when its max slides out, which is rare for random
+// values and happens for each row for descending values.
+TEST_F(TestWindowFunctionSegmentTree, benchmark)
+{
+  const int64_t row_cnt = 50000;
+  const int64_t frame_sizes[] = { 10, 100, 1000 };
+  ObWindowFunctionSegmentTree tree;
+  ASSERT_EQ(OB_SUCCESS, tree.init(true, int_cmp, OB_SYS_TENANT_ID, MAX_MEM_SIZE));
+
+  for (int64_t d = 0; d < 2; ++d) {
+    is_desc_ = (1 == d);
+    for (int64_t k = 0; k < ARRAYSIZEOF(frame_sizes); ++k) {
+      const int64_t n = frame_sizes[k];
+      int64_t naive_sum = 0;
+      int64_t extrenum_res = 0;
+      int64_t tree_sum = 0;
+      int64_t naive_us = 0;
+      int64_t extrenum_us = 0;
+      int64_t tree_us = 0;
+      {
+        const int64_t start_ts = ObTimeUtility::current_time();
+        for (int64_t i = 0; i < row_cnt; ++i) {
+          bool is_null = false;
+          const int64_t v = naive_query(true, std::max(0L, i - n), std::min(row_cnt - 1, i + n), is_null);
+          naive_sum += is_null ? 0 : v;
+        }
+        naive_us = ObTimeUtility::current_time() - start_ts;
+      }
+      {
+        const int64_t start_ts = ObTimeUtility::current_time();
+        extrenum_res = extrenum_sum(row_cnt, n);
+        extrenum_us = ObTimeUtility::current_time() - start_ts;
+      }
+      {
+        const int64_t start_ts = ObTimeUtility::current_time();
+        build(tree, row_cnt);
+        for (int64_t i = 0; i < row_cnt; ++i) {
+          int64_t leaf = -1;
+          ASSERT_EQ(OB_SUCCESS, tree.query(std::max(0L, i - n), std::min(row_cnt - 1, i + n), leaf));
+          tree_sum += leaf < 0 ? 0 : tree.get_value(leaf).get_int();
+        }
+        tree_us = ObTimeUtility::current_time() - start_ts;
+      }
+      ASSERT_EQ(naive_sum, tree_sum);
+      ASSERT_EQ(naive_sum, extrenum_res);
+      fprintf(stdout, "rows=%ld frame=+-%ld data=%s re-aggregate=%ldus remove_extrenum=%ldus "
+              "segment_tree=%ldus\n",
+              row_cnt, n, is_desc_ ? "desc" : "random", naive_us, extrenum_us, tree_us);
+      LOG_INFO("segment tree benchmark", K(row_cnt), K(n), K_(is_desc), K(naive_us),
+               K(extrenum_us), K(tree_us));
+    }
+  }
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_window_function_segment_tree.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -23,6 +23,8 @@
 #include "test_backup.h"
 #include "share/backup/ob_backup_io_adapter.h"
 #include "storage/blocksstable/ob_logic_macro_id.h"
+#include "share/ob_device_manager.h"
+#include "lib/restore/ob_object_device.h"
 
 using namespace oceanbase;
 using namespace oceanbase::common;
@@ -34,6 +36,36 @@ namespace backup {
 
 static ObSimpleMemLimitGetter getter;
 
+// Delegates to the device of the opened file, and fails the pwrite of sequence error_seq.
+class ObPwriteErrorDevice : public ObObjectDevice
+{
+public:
+  ObPwriteErrorDevice(ObIODevice &device, const int64_t error_seq)
+      : device_(device), error_seq_(error_seq), pwrite_cnt_(0)
+  {}
+  virtual ~ObPwriteErrorDevice() {}
+  virtual int pwrite(const ObIOFd &fd, const int64_t offset, const int64_t size,
+                     const void *buf, int64_t &write_size) override
+  {
+    int ret = OB_SUCCESS;
+    if (ATOMIC_FAA(&pwrite_cnt_, 1) == error_seq_) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("inject pwrite error", K(ret), K(offset), K(size));
+    } else {
+      ret = device_.pwrite(fd, offset, size, buf, write_size);
+    }
+    return ret;
+  }
+  virtual int close(const ObIOFd &fd) override
+  {
+    return device_.close(fd);
+  }
+private:
+  ObIODevice &device_;
+  int64_t error_seq_;
+  int64_t pwrite_cnt_;
+};
+
 class TestBackupCtx : public TestDataFilePrepare {
 public:
   TestBackupCtx();
@@ -54,6 +86,10 @@ private:
       common::ObIArray<ObBackupMacroRangeIndex> &output_list);
   bool cmp_macro_index_(const common::ObIArray<ObBackupMacroRangeIndex> &lhs_list,
       const common::ObIArray<ObBackupMacroRangeIndex> &rhs_list);
+  int64_t get_upload_buffer_len_(const int64_t idx) const;
+  int write_upload_file_(const char *file_name, const int64_t io_thread_cnt, const int64_t error_seq,
+      int64_t &file_size);
+  int read_upload_file_(const char *file_name, common::ObIAllocator &allocator, char *&buf, int64_t &file_size);
 
 protected:
   ObTenantBase tenant_base_;
@@ -400,6 +436,92 @@ bool TestBackupCtx::cmp_macro_index_(const common::ObIArray<ObBackupMacroRangeIn
   return bret;
 }
 
+static const int64_t UPLOAD_BUFFER_CNT = 30;
+
+// about 1MB each, 4 flushed buffers of OB_MAX_BACKUP_MEM_BUF_LEN and the last part in total
+int64_t TestBackupCtx::get_upload_buffer_len_(const int64_t idx) const
+{
+  return 1024 * 1024 + idx * 4099;
+}
+
+// Write the same buffers to file_name, the device fails the pwrite of sequence error_seq.
+int TestBackupCtx::write_upload_file_(const char *file_name, const int64_t io_thread_cnt,
+    const int64_t error_seq, int64_t &file_size)
+{
+  int ret = OB_SUCCESS;
+  char uri[OB_MAX_URI_LENGTH] = "";
+  ObBackupIoAdapter util;
+  ObIODevice *dev_handle = NULL;
+  ObIOFd io_fd;
+  ObArenaAllocator allocator;
+  ObBackupFileWriteCtx write_ctx;
+  file_size = 0;
+  if (OB_FAIL(databuff_printf(uri, sizeof(uri), "%s/%s", test_dir_uri_, file_name))) {
+    LOG_WARN("failed to print uri", K(ret));
+  } else if (OB_FAIL(util.open_with_access_type(dev_handle, io_fd, backup_dest_.get_storage_info(),
+                 uri, OB_STORAGE_ACCESS_RANDOMWRITER))) {
+    LOG_WARN("failed to open file", K(ret), K(uri));
+  } else {
+    ObPwriteErrorDevice error_device(*dev_handle, error_seq);
+    if (OB_FAIL(write_ctx.open(INT64_MAX, io_fd, error_device, throttle_, io_thread_cnt))) {
+      LOG_WARN("failed to open write ctx", K(ret), K(io_thread_cnt));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < UPLOAD_BUFFER_CNT; ++i) {
+      const int64_t len = get_upload_buffer_len_(i);
+      char *buf = static_cast<char *>(allocator.alloc(len));
+      ObBufferReader buffer_reader;
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc buffer", K(ret), K(len));
+      } else {
+        for (int64_t j = 0; j < len; ++j) {
+          buf[j] = static_cast<char>((i * 131 + j * 7) % 256);
+        }
+        buffer_reader.assign(buf, len, len);
+        if (OB_FAIL(write_ctx.append_buffer(buffer_reader, UPLOAD_BUFFER_CNT - 1 == i))) {
+          LOG_WARN("failed to append buffer", K(ret), K(i));
+        }
+        allocator.reuse();
+      }
+    }
+    if (OB_SUCC(ret)) {
+      file_size = write_ctx.get_file_size();
+      ret = write_ctx.close();
+    }
+    if (OB_FAIL(ret)) {
+      write_ctx.upload_pipeline_.destroy();
+      dev_handle->close(io_fd);
+    }
+    ObDeviceManager::get_instance().release_device(dev_handle);
+  }
+  return ret;
+}
+
+int TestBackupCtx::read_upload_file_(const char *file_name, common::ObIAllocator &allocator,
+    char *&buf, int64_t &file_size)
+{
+  int ret = OB_SUCCESS;
+  char uri[OB_MAX_URI_LENGTH] = "";
+  ObBackupIoAdapter util;
+  int64_t read_size = 0;
+  buf = NULL;
+  if (OB_FAIL(databuff_printf(uri, sizeof(uri), "%s/%s", test_dir_uri_, file_name))) {
+    LOG_WARN("failed to print uri", K(ret));
+  } else if (OB_FAIL(util.get_file_length(uri, backup_dest_.get_storage_info(), file_size))) {
+    LOG_WARN("failed to get file length", K(ret), K(uri));
+  } else if (0 == file_size) {
+  } else if (OB_ISNULL(buf = static_cast<char *>(allocator.alloc(file_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc buffer", K(ret), K(file_size));
+  } else if (OB_FAIL(util.read_single_file(uri, backup_dest_.get_storage_info(), buf, file_size, read_size))) {
+    LOG_WARN("failed to read file", K(ret), K(uri));
+  } else if (read_size != file_size) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("read size not match", K(ret), K(read_size), K(file_size));
+  }
+  return ret;
+}
+
 static const int64_t ARRAY_SIZE = 4;
 static const int64_t count_list[ARRAY_SIZE] = {2, 20, 200, 2000};
 
@@ -432,6 +554,65 @@ TEST_F(TestBackupCtx, test_backup_ctx)
   }
 }
 
+TEST_F(TestBackupCtx, test_backup_ctx_with_upload_pipeline_and_compression)
+{
+  int ret = OB_SUCCESS;
+  GCONF._backup_io_thread_count = 4;
+  GCONF._enable_backup_meta_compression = true;
+  for (int64_t i = 0; OB_SUCC(ret) && i < ARRAY_SIZE; ++i) {
+    const int64_t count = count_list[i];
+    const int64_t macro_count = random(0, count);
+    const int64_t meta_count = count - macro_count;
+    EXPECT_EQ(OB_SUCCESS, do_backup_ctx_(macro_count, meta_count));
+  }
+  GCONF._backup_io_thread_count = 0;
+  GCONF._enable_backup_meta_compression = false;
+
+  // the file written by upload threads is byte-identical to the one written synchronously
+  ObArenaAllocator allocator;
+  int64_t sync_size = 0;
+  int64_t upload_size = 0;
+  char *sync_buf = NULL;
+  char *upload_buf = NULL;
+  clean_env_();
+  ObBackupIoAdapter util;
+  ASSERT_EQ(OB_SUCCESS, util.mkdir(test_dir_uri_, backup_dest_.get_storage_info()));
+  ASSERT_EQ(OB_SUCCESS, write_upload_file_("sync_file", 0, -1, sync_size));
+  ASSERT_EQ(OB_SUCCESS, write_upload_file_("upload_file", 4, -1, upload_size));
+  ASSERT_EQ(sync_size, upload_size);
+  ASSERT_EQ(OB_SUCCESS, read_upload_file_("sync_file", allocator, sync_buf, sync_size));
+  ASSERT_EQ(OB_SUCCESS, read_upload_file_("upload_file", allocator, upload_buf, upload_size));
+  ASSERT_EQ(upload_size, sync_size);
+  ASSERT_EQ(0, MEMCMP(sync_buf, upload_buf, sync_size));
+}
+
+TEST_F(TestBackupCtx, test_upload_pipeline_write_error)
+{
+  // all flushed buffers fit in the tasks of 4 threads, the failure of the second write is only
+  // returned when the file is committed, and the following buffers are not written
+  int64_t first_flush_size = 0;
+  for (int64_t i = 0; first_flush_size < OB_MAX_BACKUP_MEM_BUF_LEN; ++i) {
+    first_flush_size += get_upload_buffer_len_(i);
+  }
+  ObArenaAllocator allocator;
+  char *buf = NULL;
+  int64_t file_size = 0;
+  ObBackupIoAdapter util;
+  ASSERT_EQ(OB_SUCCESS, util.mkdir(test_dir_uri_, backup_dest_.get_storage_info()));
+  ASSERT_EQ(OB_IO_ERROR, write_upload_file_("error_file", 4, 1, file_size));
+  ASSERT_EQ(OB_SUCCESS, read_upload_file_("error_file", allocator, buf, file_size));
+  ASSERT_EQ(first_flush_size, file_size);
+  for (int64_t j = 0; j < file_size; j += 4099) {
+    int64_t idx = 0;
+    int64_t pos = j;
+    while (pos >= get_upload_buffer_len_(idx)) {
+      pos -= get_upload_buffer_len_(idx);
+      ++idx;
+    }
+    ASSERT_EQ(static_cast<char>((idx * 131 + pos * 7) % 256), buf[j]);
+  }
+}
+
 }  // namespace backup
 }  // namespace oceanbase
 
@@ -29,6 +29,7 @@
 #include "lib/string/ob_sql_string.h"
 #include "../ob_row_generate.h"
 #include "common/rowkey/ob_rowkey.h"
+#include "share/ob_cluster_version.h"
 
 namespace oceanbase
 {
@@ -185,7 +186,8 @@ void TestColumnDecoder::SetUp()
     set_column_type_integer();
   } else if (column_encoding_type_ == ObColumnHeader::Type::HEX_PACKING
       || column_encoding_type_ == ObColumnHeader::Type::STRING_DIFF
-      || column_encoding_type_ == ObColumnHeader::Type::STRING_PREFIX) {
+      || column_encoding_type_ == ObColumnHeader::Type::STRING_PREFIX
+      || column_encoding_type_ == ObColumnHeader::Type::SYMBOL_PACKING) {
     set_column_type_string();
   } else {
     set_column_type_default();
@@ -256,6 +258,9 @@ void TestColumnDecoder::SetUp()
   ctx_.column_cnt_ = column_cnt_ + extra_rowkey_cnt_;
   ctx_.col_descs_ = &col_descs_;
   ctx_.row_store_type_ = common::ENCODING_ROW_STORE;
+  if (ObColumnHeader::Type::SYMBOL_PACKING == column_encoding_type_) {
+    ctx_.major_working_cluster_version_ = DATA_VERSION_4_2_0_0;
+  }
 
   if (!is_retro_) {
     int64_t *column_encodings = reinterpret_cast<int64_t *>(allocator_.alloc(sizeof(int64_t) * ctx_.column_cnt_));
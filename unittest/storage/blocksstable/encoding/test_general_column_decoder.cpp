@@ -81,6 +81,13 @@ public:
   virtual ~TestStringPrefixDecoder() {}
 };
 
+class TestSymbolStringDecoder : public TestColumnDecoder
+{
+public:
+  TestSymbolStringDecoder() : TestColumnDecoder(ObColumnHeader::Type::SYMBOL_PACKING) {}
+  virtual ~TestSymbolStringDecoder() {}
+};
+
 TEST_F(TestIntBaseDiffDecoder, filter_pushdown_comaprison_neg_test)
 {
   filter_pushdown_comaprison_neg_test();
@@ -96,6 +103,11 @@ TEST_F(TestHexDecoder, basic_filter_pushdown_op_test_eq_ne_nu_nn)
   basic_filter_pushdown_eq_ne_nu_nn_test();
 }
 
+TEST_F(TestSymbolStringDecoder, basic_filter_pushdown_op_test_eq_ne_nu_nn)
+{
+  basic_filter_pushdown_eq_ne_nu_nn_test();
+}
+
 TEST_F(TestDictDecoder, batch_decode_to_datum_condense_test)
 {
   batch_decode_to_datum_test(true);
@@ -131,6 +143,11 @@ TEST_F(TestStringPrefixDecoder, batch_decode_to_datum_test)
   batch_decode_to_datum_test();
 }
 
+TEST_F(TestSymbolStringDecoder, batch_decode_to_datum_test)
+{
+  batch_decode_to_datum_test();
+}
+
 // TEST_F(TestDictDecoder, batch_decode_perf_test)
 // {
 //   batch_get_row_perf_test();
@@ -225,6 +225,246 @@ TEST_F(TestDictLargeVarchar, test_dict_large_varchar)
   ASSERT_TRUE(ObDatum::binary_equal(row.storage_datums_[3], read_row.storage_datums_[3]));
 }
 
+static ObObjType test_time_series_col_types[4] = {ObIntType, ObDateTimeType, ObDoubleType, ObFloatType};
+class TestTimeSeriesEncoding : public TestIColumnEncoder
+{
+public:
+  static const int64_t ROW_CNT = 1000;
+  TestTimeSeriesEncoding() : TestIColumnEncoder(false)
+  {
+    rowkey_cnt_ = 1;
+    column_cnt_ = 4;
+    col_types_ = reinterpret_cast<ObObjType *>(allocator_.alloc(sizeof(ObObjType) * column_cnt_));
+    for (int64_t i = 0; i < column_cnt_; ++i) {
+      col_types_[i] = test_time_series_col_types[i];
+    }
+  }
+  virtual ~TestTimeSeriesEncoding()
+  {
+    allocator_.free(col_types_);
+  }
+
+  // sampled every second with jitter, decimal readings
+  void generate_row(const int64_t i, ObDatumRow &row)
+  {
+    row.storage_datums_[0].set_int(i);
+    if (i % 100 == 99) {
+      row.storage_datums_[1].set_null();
+    } else {
+      row.storage_datums_[1].set_datetime(1650000000000000L + i * 1000000L + (i * 7919) % 1000);
+    }
+    row.storage_datums_[2].set_double(static_cast<double>(2000 + (i * 37) % 500) / 100.0);
+    row.storage_datums_[3].set_float(static_cast<float>((i * 13) % 1000) / 10.0f);
+  }
+
+  void build(ObMicroBlockEncoder &encoder, char *&buf, int64_t &size)
+  {
+    ObDatumRow row;
+    ASSERT_EQ(OB_SUCCESS, row.init(allocator_, column_cnt_));
+    ASSERT_EQ(OB_SUCCESS, encoder.init(ctx_));
+    for (int64_t i = 0; i < ROW_CNT; ++i) {
+      generate_row(i, row);
+      ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+    }
+    ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+  }
+};
+
+TEST_F(TestTimeSeriesEncoding, test_time_series_encoding)
+{
+  // not used before all the servers can decode them
+  ctx_.major_working_cluster_version_ = DATA_VERSION_4_1_0_0;
+  ObMicroBlockEncoder baseline_encoder;
+  char *baseline_buf = nullptr;
+  int64_t baseline_size = 0;
+  build(baseline_encoder, baseline_buf, baseline_size);
+  for (int64_t j = 1; j < column_cnt_; ++j) {
+    ASSERT_NE(ObColumnHeader::TIMESTAMP_DELTA, baseline_encoder.encoders_.at(j)->get_type());
+    ASSERT_NE(ObColumnHeader::FLOAT_PACKING, baseline_encoder.encoders_.at(j)->get_type());
+  }
+
+  ctx_.major_working_cluster_version_ = DATA_VERSION_4_2_0_0;
+  ObMicroBlockEncoder encoder;
+  char *buf = nullptr;
+  int64_t size = 0;
+  build(encoder, buf, size);
+  ASSERT_EQ(ObColumnHeader::TIMESTAMP_DELTA, encoder.encoders_.at(1)->get_type());
+  ASSERT_EQ(ObColumnHeader::FLOAT_PACKING, encoder.encoders_.at(2)->get_type());
+  ASSERT_EQ(ObColumnHeader::FLOAT_PACKING, encoder.encoders_.at(3)->get_type());
+  ASSERT_LT(size, baseline_size);
+
+  ObMicroBlockData micro_data(buf, size);
+  ObMicroBlockDecoder decoder;
+  ObDatumRow row;
+  ObDatumRow read_row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, column_cnt_));
+  ASSERT_EQ(OB_SUCCESS, read_row.init(column_cnt_));
+  ASSERT_EQ(OB_SUCCESS, decoder.init(micro_data, read_info_));
+  const int64_t begin = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row(i, read_row));
+  }
+  const int64_t cost = ObTimeUtility::current_time() - begin;
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    generate_row(i, row);
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row(i, read_row));
+    for (int64_t j = 0; j < column_cnt_; ++j) {
+      ASSERT_TRUE(ObDatum::binary_equal(row.storage_datums_[j], read_row.storage_datums_[j]))
+          << "row: " << i << " column: " << j;
+    }
+  }
+  LOG_INFO("time series encoding", K(size), K(baseline_size), K(cost));
+}
+
+TEST_F(TestTimeSeriesEncoding, test_planned_encoding)
+{
+  ctx_.major_working_cluster_version_ = DATA_VERSION_4_2_0_0;
+  ObMicroBlockEncoder full_encoder;
+  char *full_buf = nullptr;
+  int64_t full_size = 0;
+  build(full_encoder, full_buf, full_size);
+
+  // only build the encoder with the smallest estimated size
+  ctx_.encoder_opt_.planned_encoding_cnt_ = 1;
+  ObMicroBlockEncoder encoder;
+  char *buf = nullptr;
+  int64_t size = 0;
+  build(encoder, buf, size);
+  for (int64_t j = 1; j < column_cnt_; ++j) {
+    ASSERT_EQ(full_encoder.encoders_.at(j)->get_type(), encoder.encoders_.at(j)->get_type())
+        << "column: " << j;
+  }
+  ASSERT_LE(size, full_size * 11 / 10);
+  ASSERT_GT(encoder.get_encoder_select_time(), 0);
+
+  ObMicroBlockData micro_data(buf, size);
+  ObMicroBlockDecoder decoder;
+  ObDatumRow row;
+  ObDatumRow read_row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, column_cnt_));
+  ASSERT_EQ(OB_SUCCESS, read_row.init(column_cnt_));
+  ASSERT_EQ(OB_SUCCESS, decoder.init(micro_data, read_info_));
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    generate_row(i, row);
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row(i, read_row));
+    for (int64_t j = 0; j < column_cnt_; ++j) {
+      ASSERT_TRUE(ObDatum::binary_equal(row.storage_datums_[j], read_row.storage_datums_[j]))
+          << "row: " << i << " column: " << j;
+    }
+  }
+  LOG_INFO("planned encoding", K(size), K(full_size),
+      "full_select_time", full_encoder.get_encoder_select_time(),
+      "select_time", encoder.get_encoder_select_time());
+}
+
+static ObObjType test_symbol_string_col_types[2] = {ObIntType, ObVarcharType};
+class TestSymbolStringEncoding : public TestIColumnEncoder
+{
+public:
+  static const int64_t ROW_CNT = 500;
+  TestSymbolStringEncoding() : TestIColumnEncoder(false)
+  {
+    rowkey_cnt_ = 1;
+    column_cnt_ = 2;
+    col_types_ = reinterpret_cast<ObObjType *>(allocator_.alloc(sizeof(ObObjType) * column_cnt_));
+    for (int64_t i = 0; i < column_cnt_; ++i) {
+      col_types_[i] = test_symbol_string_col_types[i];
+    }
+  }
+  virtual ~TestSymbolStringEncoding()
+  {
+    allocator_.free(col_types_);
+  }
+
+  // distinct urls sharing host, path and parameter names
+  void generate_row(const int64_t i, ObDatumRow &row)
+  {
+    row.storage_datums_[0].set_int(i);
+    if (i % 50 == 49) {
+      row.storage_datums_[1].set_null();
+    } else {
+      char *url = static_cast<char *>(allocator_.alloc(128));
+      const int64_t len = snprintf(url, 128, "https://www.example.com/item/%ld?ref=mail&user=%ld",
+          (i * 7919) % 100000, i);
+      row.storage_datums_[1].set_string(url, static_cast<int32_t>(len));
+    }
+  }
+};
+
+TEST_F(TestSymbolStringEncoding, test_symbol_string_encoding)
+{
+  ctx_.major_working_cluster_version_ = DATA_VERSION_4_2_0_0;
+  ctx_.column_encodings_ = static_cast<int64_t *>(allocator_.alloc(sizeof(int64_t) * column_cnt_));
+  ctx_.column_encodings_[0] = ObColumnHeader::Type::RAW;
+  ctx_.column_encodings_[1] = ObColumnHeader::Type::SYMBOL_PACKING;
+  ObMicroBlockEncoder encoder;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(ctx_));
+
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, column_cnt_));
+  int64_t raw_size = 0;
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    generate_row(i, row);
+    raw_size += row.storage_datums_[1].len_;
+    ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+  }
+  char *buf = nullptr;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+  ObIColumnEncoder *e = encoder.encoders_.at(1);
+  ASSERT_EQ(ObColumnHeader::SYMBOL_PACKING, e->get_type());
+  const int64_t encoded_size = e->calc_size();
+  LOG_INFO("symbol string encoding", K(raw_size), K(encoded_size), K(size));
+  ASSERT_LT(encoded_size, raw_size / 2);
+
+  ObMicroBlockData micro_data(buf, size);
+  ObMicroBlockDecoder decoder;
+  ObDatumRow read_row;
+  ASSERT_EQ(OB_SUCCESS, read_row.init(column_cnt_));
+  ASSERT_EQ(OB_SUCCESS, decoder.init(micro_data, read_info_));
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    generate_row(i, row);
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row(i, read_row));
+    ASSERT_TRUE(ObDatum::binary_equal(row.storage_datums_[1], read_row.storage_datums_[1]))
+        << "row: " << i;
+  }
+
+  // strings out of the block are still encoded and decoded with the symbol table
+  const ObSymbolStringEncoder *symbol_encoder = static_cast<const ObSymbolStringEncoder *>(e);
+  const char *str = "https://www.example.org/\xff\x01?ref=mail";
+  const int64_t len = strlen(str);
+  unsigned char code[128];
+  unsigned char decoded[128];
+  const int64_t code_len = symbol_encoder->symbol_table_.encode(
+      reinterpret_cast<const unsigned char *>(str), len, code);
+  ASSERT_EQ(len, ObStringSymbolTable::decode(symbol_encoder->symbols_, code, code_len, decoded));
+  ASSERT_EQ(0, MEMCMP(str, decoded, len));
+}
+
+TEST_F(TestSymbolStringEncoding, test_symbol_string_data_version)
+{
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, column_cnt_));
+  // not used before all the servers can decode it
+  ctx_.major_working_cluster_version_ = DATA_VERSION_4_1_0_0;
+  ASSERT_FALSE(ctx_.enable_encoding(ObColumnHeader::SYMBOL_PACKING));
+  ObMicroBlockEncoder old_encoder;
+  ASSERT_EQ(OB_SUCCESS, old_encoder.init(ctx_));
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    generate_row(i, row);
+    ASSERT_EQ(OB_SUCCESS, old_encoder.append_row(row));
+  }
+  char *buf = nullptr;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, old_encoder.build_block(buf, size));
+  ASSERT_NE(ObColumnHeader::SYMBOL_PACKING, old_encoder.encoders_.at(1)->get_type());
+
+  ctx_.major_working_cluster_version_ = DATA_VERSION_4_2_0_0;
+  ASSERT_TRUE(ctx_.enable_encoding(ObColumnHeader::SYMBOL_PACKING));
+  ctx_.encoder_opt_.set_store_type(SELECTIVE_ENCODING_ROW_STORE);
+  ASSERT_FALSE(ctx_.enable_encoding(ObColumnHeader::SYMBOL_PACKING));
+}
+
 class TestEncodingRowBufHolder : public ::testing::Test
 {
 public:
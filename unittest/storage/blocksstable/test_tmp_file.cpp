@@ -1761,6 +1761,55 @@ TEST_F(TestTmpFile, test_tmp_file_sync)
   ObTmpFileManager::get_instance().remove(fd);
 }
 
+TEST_F(TestTmpFile, test_direct_read)
+{
+  int ret = OB_SUCCESS;
+  int64_t dir = -1;
+  int64_t fd = -1;
+  ObTmpFileIOInfo io_info;
+  ObTmpFileIOHandle handle;
+  ret = ObTmpFileManager::get_instance().alloc_dir(dir);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ret = ObTmpFileManager::get_instance().open(fd, dir);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  int64_t write_size = 64 * 1024;
+  char *write_buf = (char *)malloc(write_size);
+  for (int64_t i = 0; i < write_size; ++i) {
+    write_buf[i] = static_cast<char>(i % 251);
+  }
+  char *read_buf = (char *)malloc(write_size);
+  io_info.fd_ = fd;
+  io_info.tenant_id_ = 1;
+  io_info.io_desc_.set_group_id(THIS_WORKER.get_group_id());
+  io_info.io_desc_.set_wait_event(2);
+  io_info.buf_ = write_buf;
+  io_info.size_ = write_size;
+  const int64_t timeout_ms = 5000;
+  ret = ObTmpFileManager::get_instance().write(io_info, timeout_ms);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  // flush data to disk, read it back without page cache
+  ASSERT_EQ(OB_SUCCESS, ObTmpFileManager::get_instance().sync(fd, timeout_ms));
+
+  io_info.buf_ = read_buf;
+  io_info.disable_page_cache_ = true;
+  io_info.size_ = 30000;
+  ret = ObTmpFileManager::get_instance().pread(io_info, 100, timeout_ms, handle);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(30000, handle.get_data_size());
+  ASSERT_EQ(0, memcmp(handle.get_buffer(), write_buf + 100, handle.get_data_size()));
+
+  io_info.size_ = write_size;
+  ret = ObTmpFileManager::get_instance().aio_pread(io_info, 0, handle);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(OB_SUCCESS, handle.wait(timeout_ms));
+  ASSERT_EQ(write_size, handle.get_data_size());
+  ASSERT_EQ(0, memcmp(handle.get_buffer(), write_buf, write_size));
+
+  free(write_buf);
+  free(read_buf);
+  ObTmpFileManager::get_instance().remove(fd);
+}
+
 TEST_F(TestTmpFile, test_tmp_file_sync_same_block)
 {
   int ret = OB_SUCCESS;